@@ -10,6 +10,16 @@
 f32v3 normal_tex_encode(const f32v3 normal) { return normal * 0.5 + 0.5; }
 f32v3 normal_tex_decode(const f32v3 normal) { return normalize(normal * 2.0 - 1.0); }
 
+/**
+ * Decode a tangent space normal from only its x and y components, z is reconstructed from the fact
+ * that the normal is unit length and points out of the surface.
+ * NOTE: Normal-maps can be stored as two channel textures (BC5) that do not contain a z component.
+ */
+f32v3 normal_tex_decode_xy(const f32v2 normalXY) {
+  const f32v2 xy = normalXY * 2.0 - 1.0;
+  return normalize(f32v3(xy, sqrt(max(0.0, 1.0 - dot(xy, xy)))));
+}
+
 /**
  * Sample a cubemap.
  */
@@ -36,7 +46,7 @@ f32v3 texture_normal(const f32v3 textureSample, const f32v3 normalRef, const f32
   const f32v3 normal    = normalize(normalRef);
   const f32v3 bitangent = normalize(cross(tangent, normal) * tangentRef.w);
   const f32m3 rotMatrix = f32m3(tangent, bitangent, normal);
-  return rotMatrix * normal_tex_decode(textureSample.xyz);
+  return rotMatrix * normal_tex_decode_xy(textureSample.xy);
 }
 
 #endif // INCLUDE_TEXTURE
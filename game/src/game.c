@@ -192,7 +192,8 @@ static void game_music_play(
   EcsEntityId  assetEntities[asset_query_max_results];
   const u32    assetCount = asset_query(world, assets, assetPattern, assetEntities);
 
-  if (assetCount && snd_object_new(soundMixer, &game->musicHandle) == SndResult_Success) {
+  const u8 priority = SndPriority_Music;
+  if (assetCount && snd_object_new(soundMixer, priority, &game->musicHandle) == SndResult_Success) {
     const u32 assetIndex = (u32)rng_sample_range(g_rng, 0, assetCount);
     snd_object_set_asset(soundMixer, game->musicHandle, assetEntities[assetIndex]);
     snd_object_set_looping(soundMixer, game->musicHandle);
@@ -203,7 +204,7 @@ static void game_sound_play(
     EcsWorld* world, SndMixerComp* soundMixer, AssetManagerComp* assets, const String id) {
 
   SndObjectId sndHandle;
-  if (snd_object_new(soundMixer, &sndHandle) == SndResult_Success) {
+  if (snd_object_new(soundMixer, SndPriority_Interface, &sndHandle) == SndResult_Success) {
     snd_object_set_asset(soundMixer, sndHandle, asset_lookup(world, assets, id));
   }
 }
@@ -1520,7 +1521,8 @@ ecs_module_init(game_module) {
   ecs_order(GameUpdateSys, GameOrder_StateUpdate);
 }
 
-static CliId g_optAssets, g_optWindow, g_optWidth, g_optHeight, g_optLevel, g_optDev;
+static CliId g_optAssets, g_optAssetCache, g_optRecordLoadOrder, g_optWindow, g_optWidth,
+    g_optHeight, g_optLevel, g_optDev;
 
 AppType app_ecs_configure(CliApp* app) {
   cli_app_register_desc(app, string_lit("Volo RTS Demo"));
@@ -1529,6 +1531,19 @@ AppType app_ecs_configure(CliApp* app) {
   cli_register_desc(app, g_optAssets, string_lit("Path to asset directory / pack file."));
   cli_register_validator(app, g_optAssets, cli_validate_file);
 
+  g_optAssetCache = cli_register_flag(app, '\0', string_lit("asset-cache"), CliOptionFlags_Value);
+  cli_register_desc(
+      app,
+      g_optAssetCache,
+      string_lit("Url of a shared asset cache server ('http[s]://host[:port][/prefix]')."));
+
+  g_optRecordLoadOrder =
+      cli_register_flag(app, '\0', string_lit("record-load-order"), CliOptionFlags_None);
+  cli_register_desc(
+      app,
+      g_optRecordLoadOrder,
+      string_lit("Record the per-level asset load order next to the pack file (for prefetching)."));
+
   g_optWindow = cli_register_flag(app, 'w', string_lit("window"), CliOptionFlags_None);
   cli_register_desc(app, g_optWindow, string_lit("Start the game in windowed mode."));
 
@@ -1585,10 +1600,14 @@ void app_ecs_register(EcsDef* def, const CliInvocation* invoc) {
 }
 
 static AssetManagerComp* game_init_assets(EcsWorld* world, const CliInvocation* invoc) {
-  AssetManagerFlags flags = AssetManagerFlags_DelayUnload;
+  AssetManagerFlags flags = AssetManagerFlags_DelayUnload | AssetManagerFlags_Streaming;
   if (cli_parse_provided(invoc, g_optDev)) {
     flags |= AssetManagerFlags_DevSupport;
   }
+  if (cli_parse_provided(invoc, g_optRecordLoadOrder)) {
+    flags |= AssetManagerFlags_RecordLoadOrder;
+  }
+  const String remoteCache  = cli_read_string(invoc, g_optAssetCache, string_empty);
   const String overridePath = cli_read_string(invoc, g_optAssets, string_empty);
   if (!string_is_empty(overridePath)) {
     const FileInfo overrideInfo = file_stat_path_sync(overridePath);
@@ -1596,7 +1615,8 @@ static AssetManagerComp* game_init_assets(EcsWorld* world, const CliInvocation*
     case FileType_Regular:
       return asset_manager_create_pack(world, flags, overridePath);
     case FileType_Directory:
-      return asset_manager_create_fs(world, flags | AssetManagerFlags_TrackChanges, overridePath);
+      flags |= AssetManagerFlags_TrackChanges;
+      return asset_manager_create_fs_remote(world, flags, overridePath, remoteCache);
     default:
       log_e("Asset directory / pack file not found", log_param("path", fmt_path(overridePath)));
       return null;
@@ -1608,7 +1628,8 @@ static AssetManagerComp* game_init_assets(EcsWorld* world, const CliInvocation*
   }
   const String pathFsDefault = string_lit("assets");
   if (file_stat_path_sync(pathFsDefault).type == FileType_Directory) {
-    return asset_manager_create_fs(world, flags | AssetManagerFlags_TrackChanges, pathFsDefault);
+    flags |= AssetManagerFlags_TrackChanges;
+    return asset_manager_create_fs_remote(world, flags, pathFsDefault, remoteCache);
   }
   log_e("No asset source found");
   return null;
@@ -3,98 +3,98 @@
 
 // clang-format off
 enum {
-  GameId_Back = 1137858108, // Back
-  GameId_CameraPanBackward = 1537695709, // CameraPanBackward
-  GameId_CameraPanCursor = 738650744, // CameraPanCursor
-  GameId_CameraPanForward = 4178040762, // CameraPanForward
-  GameId_CameraPanLeft = 719002654, // CameraPanLeft
-  GameId_CameraPanRight = 1561855215, // CameraPanRight
-  GameId_CameraReset = 476230800, // CameraReset
-  GameId_CameraRotate = 3858704105, // CameraRotate
-  GameId_Dev = 2547616407, // Dev
-  GameId_DevFreeCamera = 3019337394, // DevFreeCamera
-  GameId_Edit = 2684623067, // Edit
-  GameId_Fullscreen = 2447595539, // Fullscreen
-  GameId_Game = 2551442255, // Game
-  GameId_Order = 3068264324, // Order
-  GameId_OrderStop = 3674266003, // OrderStop
-  GameId_Pause = 152424741, // Pause
-  GameId_PlacementAccept = 4005290086, // PlacementAccept
-  GameId_PlacementCancel = 4274203696, // PlacementCancel
-  GameId_PlacementRotateLeft = 1622780714, // PlacementRotateLeft
-  GameId_PlacementRotateRight = 3062273, // PlacementRotateRight
-  GameId_Quit = 1165054792, // Quit
-  GameId_SaveLevel = 3882009144, // SaveLevel
-  GameId_Select = 414324572, // Select
-  GameId_minimap = 3582479288, // minimap
-  GameId_EffectIndicatorMove = 1884579441, // EffectIndicatorMove
-  GameId_EffectIndicatorAttack = 3489365775, // EffectIndicatorAttack
-  GameId_HUD_CAMERA_RESET_TOOLTIP = 1607900573, // HUD_CAMERA_RESET_TOOLTIP
-  GameId_HUD_FACTION_ENEMY = 2203697841, // HUD_FACTION_ENEMY
-  GameId_HUD_FACTION_PLAYER = 1256886660, // HUD_FACTION_PLAYER
-  GameId_HUD_INFO_APPLY = 128001717, // HUD_INFO_APPLY
-  GameId_HUD_INFO_COUNT = 3249677947, // HUD_INFO_COUNT
-  GameId_HUD_INFO_DAMAGE = 1157208214, // HUD_INFO_DAMAGE
-  GameId_HUD_INFO_FACTION = 1594735432, // HUD_INFO_FACTION
-  GameId_HUD_INFO_HEALTH = 946959593, // HUD_INFO_HEALTH
-  GameId_HUD_INFO_NAME = 37096145, // HUD_INFO_NAME
-  GameId_HUD_INFO_RANGE = 1906234363, // HUD_INFO_RANGE
-  GameId_HUD_INFO_READY = 3823852948, // HUD_INFO_READY
-  GameId_HUD_INFO_SIZE = 3342356734, // HUD_INFO_SIZE
-  GameId_HUD_INFO_SPEED = 496009118, // HUD_INFO_SPEED
-  GameId_HUD_INFO_STATUS = 2074011941, // HUD_INFO_STATUS
-  GameId_HUD_INFO_TIME = 572267351, // HUD_INFO_TIME
-  GameId_HUD_ORDER_STOP_TOOLTIP = 446685756, // HUD_ORDER_STOP_TOOLTIP
-  GameId_HUD_PAUSE_TOOLTIP = 3446584280, // HUD_PAUSE_TOOLTIP
-  GameId_MENU_BACK_TOOLTIP = 1843020653, // MENU_BACK_TOOLTIP
-  GameId_MENU_EDIT_CAMERA_TOOLTIP = 3766357330, // MENU_EDIT_CAMERA_TOOLTIP
-  GameId_MENU_EDIT_CURRENT_TOOLTIP = 3101303790, // MENU_EDIT_CURRENT_TOOLTIP
-  GameId_MENU_EDIT_CURRENT = 95856603, // MENU_EDIT_CURRENT
-  GameId_MENU_EDIT_DISCARD_TOOLTIP = 3661835958, // MENU_EDIT_DISCARD_TOOLTIP
-  GameId_MENU_EDIT_PLAY_TOOLTIP = 336085858, // MENU_EDIT_PLAY_TOOLTIP
-  GameId_MENU_EDIT_SAVE_TOOLTIP = 3483598101, // MENU_EDIT_SAVE_TOOLTIP
-  GameId_MENU_EDIT_STOP_TOOLTIP = 781316700, // MENU_EDIT_STOP_TOOLTIP
-  GameId_MENU_EDIT_TOOLTIP = 4159101443, // MENU_EDIT_TOOLTIP
-  GameId_MENU_EDIT = 1502354570, // MENU_EDIT
-  GameId_MENU_CREDITS = 3792052770, // MENU_CREDITS
-  GameId_MENU_CREDITS_TOOLTIP = 2306442851, // MENU_CREDITS_TOOLTIP
-  GameId_MENU_FULLSCREEN_TOOLTIP = 4269598279, // MENU_FULLSCREEN_TOOLTIP
-  GameId_MENU_FULLSCREEN = 1037751862, // MENU_FULLSCREEN
-  GameId_MENU_LEVEL_EDIT_TOOLTIP = 3298346241, // MENU_LEVEL_EDIT_TOOLTIP
-  GameId_MENU_LEVEL_PLAY_TOOLTIP = 3213762006, // MENU_LEVEL_PLAY_TOOLTIP
-  GameId_MENU_LEVEL_REFRESH_TOOLTIP = 2276615808, // MENU_LEVEL_REFRESH_TOOLTIP
-  GameId_MENU_LOCALE_TOOLTIP = 2587768720, // MENU_LOCALE_TOOLTIP
-  GameId_MENU_LOCALE = 1290906617, // MENU_LOCALE
-  GameId_MENU_MAINMENU_TOOLTIP = 1349258692, // MENU_MAINMENU_TOOLTIP
-  GameId_MENU_MAINMENU = 1588607175, // MENU_MAINMENU
-  GameId_MENU_PAUSED = 2693054634, // MENU_PAUSED
-  GameId_MENU_VICTORY = 1972271005, // MENU_VICTORY
-  GameId_MENU_DEFEAT = 706013735, // MENU_DEFEAT
-  GameId_MENU_STAT_TIME = 1941493553, // MENU_STAT_TIME
-  GameId_MENU_STAT_COMPLETED = 1847071091, // MENU_STAT_COMPLETED
-  GameId_MENU_STAT_FAILED = 984041386, // MENU_STAT_FAILED
-  GameId_MENU_STAT_KILLS = 385855598, // MENU_STAT_KILLS
-  GameId_MENU_STAT_LOSSES = 1880606614, // MENU_STAT_LOSSES
-  GameId_MENU_TITLE = 3698982987, // MENU_TITLE
-  GameId_MENU_PLAY_TOOLTIP = 2142978416, // MENU_PLAY_TOOLTIP
-  GameId_MENU_PLAY = 780844014, // MENU_PLAY
-  GameId_MENU_LIMITER_TOOLTIP = 2109766105, // MENU_LIMITER_TOOLTIP
-  GameId_MENU_LIMITER = 2744553746, // MENU_LIMITER
-  GameId_MENU_QUALITY_TOOLTIP = 437957388, // MENU_QUALITY_TOOLTIP
-  GameId_MENU_QUALITY = 1091247432, // MENU_QUALITY
-  GameId_MENU_QUIT_TOOLTIP = 2496337463, // MENU_QUIT_TOOLTIP
-  GameId_MENU_QUIT = 2245847522, // MENU_QUIT
-  GameId_MENU_RESTART_TOOLTIP = 3791721535, // MENU_RESTART_TOOLTIP
-  GameId_MENU_RESTART = 2102305553, // MENU_RESTART
-  GameId_MENU_RESUME_TOOLTIP = 58368637, // MENU_RESUME_TOOLTIP
-  GameId_MENU_RESUME = 2019070089, // MENU_RESUME
-  GameId_MENU_UI_SCALE_TOOLTIP = 4042229478, // MENU_UI_SCALE_TOOLTIP
-  GameId_MENU_UI_SCALE = 2770251482, // MENU_UI_SCALE
-  GameId_MENU_VOLUME_TOOLTIP = 125507927, // MENU_VOLUME_TOOLTIP
-  GameId_MENU_VOLUME = 3359586045, // MENU_VOLUME
-  GameId_MENU_EXPOSURE_TOOLTIP = 2173488434, // MENU_EXPOSURE_TOOLTIP
-  GameId_MENU_EXPOSURE = 3826153770, // MENU_EXPOSURE
-  GameId_MENU_VSYNC_TOOLTIP = 2251287788, // MENU_VSYNC_TOOLTIP
-  GameId_MENU_VSYNC = 3352857890, // MENU_VSYNC
+  GameId_Back = 2939000879, // Back
+  GameId_CameraPanBackward = 2267250746, // CameraPanBackward
+  GameId_CameraPanCursor = 1382971913, // CameraPanCursor
+  GameId_CameraPanForward = 3717282293, // CameraPanForward
+  GameId_CameraPanLeft = 2740468102, // CameraPanLeft
+  GameId_CameraPanRight = 809673587, // CameraPanRight
+  GameId_CameraReset = 1004463302, // CameraReset
+  GameId_CameraRotate = 1239696672, // CameraRotate
+  GameId_Dev = 372164667, // Dev
+  GameId_DevFreeCamera = 3556728688, // DevFreeCamera
+  GameId_Edit = 2124619372, // Edit
+  GameId_Fullscreen = 915317999, // Fullscreen
+  GameId_Game = 3984334978, // Game
+  GameId_Order = 598257909, // Order
+  GameId_OrderStop = 963737599, // OrderStop
+  GameId_Pause = 779693205, // Pause
+  GameId_PlacementAccept = 4035563957, // PlacementAccept
+  GameId_PlacementCancel = 1775824881, // PlacementCancel
+  GameId_PlacementRotateLeft = 3080997450, // PlacementRotateLeft
+  GameId_PlacementRotateRight = 894950874, // PlacementRotateRight
+  GameId_Quit = 1027401267, // Quit
+  GameId_SaveLevel = 1739953082, // SaveLevel
+  GameId_Select = 908604378, // Select
+  GameId_minimap = 1303195414, // minimap
+  GameId_EffectIndicatorMove = 2248975660, // EffectIndicatorMove
+  GameId_EffectIndicatorAttack = 2154611988, // EffectIndicatorAttack
+  GameId_HUD_CAMERA_RESET_TOOLTIP = 2757372681, // HUD_CAMERA_RESET_TOOLTIP
+  GameId_HUD_FACTION_ENEMY = 1034224962, // HUD_FACTION_ENEMY
+  GameId_HUD_FACTION_PLAYER = 1576076362, // HUD_FACTION_PLAYER
+  GameId_HUD_INFO_APPLY = 322147099, // HUD_INFO_APPLY
+  GameId_HUD_INFO_COUNT = 1163718509, // HUD_INFO_COUNT
+  GameId_HUD_INFO_DAMAGE = 1237097934, // HUD_INFO_DAMAGE
+  GameId_HUD_INFO_FACTION = 4149670051, // HUD_INFO_FACTION
+  GameId_HUD_INFO_HEALTH = 1500675733, // HUD_INFO_HEALTH
+  GameId_HUD_INFO_NAME = 1076285215, // HUD_INFO_NAME
+  GameId_HUD_INFO_RANGE = 3942858532, // HUD_INFO_RANGE
+  GameId_HUD_INFO_READY = 476109645, // HUD_INFO_READY
+  GameId_HUD_INFO_SIZE = 145927292, // HUD_INFO_SIZE
+  GameId_HUD_INFO_SPEED = 923436143, // HUD_INFO_SPEED
+  GameId_HUD_INFO_STATUS = 1708549332, // HUD_INFO_STATUS
+  GameId_HUD_INFO_TIME = 2715937458, // HUD_INFO_TIME
+  GameId_HUD_ORDER_STOP_TOOLTIP = 577731907, // HUD_ORDER_STOP_TOOLTIP
+  GameId_HUD_PAUSE_TOOLTIP = 329604235, // HUD_PAUSE_TOOLTIP
+  GameId_MENU_BACK_TOOLTIP = 1213583042, // MENU_BACK_TOOLTIP
+  GameId_MENU_EDIT_CAMERA_TOOLTIP = 1687396810, // MENU_EDIT_CAMERA_TOOLTIP
+  GameId_MENU_EDIT_CURRENT_TOOLTIP = 1058189111, // MENU_EDIT_CURRENT_TOOLTIP
+  GameId_MENU_EDIT_CURRENT = 729428087, // MENU_EDIT_CURRENT
+  GameId_MENU_EDIT_DISCARD_TOOLTIP = 2737873543, // MENU_EDIT_DISCARD_TOOLTIP
+  GameId_MENU_EDIT_PLAY_TOOLTIP = 3411630776, // MENU_EDIT_PLAY_TOOLTIP
+  GameId_MENU_EDIT_SAVE_TOOLTIP = 1438818910, // MENU_EDIT_SAVE_TOOLTIP
+  GameId_MENU_EDIT_STOP_TOOLTIP = 1708957176, // MENU_EDIT_STOP_TOOLTIP
+  GameId_MENU_EDIT_TOOLTIP = 148639883, // MENU_EDIT_TOOLTIP
+  GameId_MENU_EDIT = 4123083863, // MENU_EDIT
+  GameId_MENU_CREDITS = 4064270034, // MENU_CREDITS
+  GameId_MENU_CREDITS_TOOLTIP = 2278092028, // MENU_CREDITS_TOOLTIP
+  GameId_MENU_FULLSCREEN_TOOLTIP = 1018483392, // MENU_FULLSCREEN_TOOLTIP
+  GameId_MENU_FULLSCREEN = 4072461554, // MENU_FULLSCREEN
+  GameId_MENU_LEVEL_EDIT_TOOLTIP = 993941001, // MENU_LEVEL_EDIT_TOOLTIP
+  GameId_MENU_LEVEL_PLAY_TOOLTIP = 699746676, // MENU_LEVEL_PLAY_TOOLTIP
+  GameId_MENU_LEVEL_REFRESH_TOOLTIP = 3823681876, // MENU_LEVEL_REFRESH_TOOLTIP
+  GameId_MENU_LOCALE_TOOLTIP = 2133217332, // MENU_LOCALE_TOOLTIP
+  GameId_MENU_LOCALE = 119762151, // MENU_LOCALE
+  GameId_MENU_MAINMENU_TOOLTIP = 2464400732, // MENU_MAINMENU_TOOLTIP
+  GameId_MENU_MAINMENU = 3066571231, // MENU_MAINMENU
+  GameId_MENU_PAUSED = 456598595, // MENU_PAUSED
+  GameId_MENU_VICTORY = 576316931, // MENU_VICTORY
+  GameId_MENU_DEFEAT = 3319776585, // MENU_DEFEAT
+  GameId_MENU_STAT_TIME = 210502259, // MENU_STAT_TIME
+  GameId_MENU_STAT_COMPLETED = 727562784, // MENU_STAT_COMPLETED
+  GameId_MENU_STAT_FAILED = 3226504635, // MENU_STAT_FAILED
+  GameId_MENU_STAT_KILLS = 2466473329, // MENU_STAT_KILLS
+  GameId_MENU_STAT_LOSSES = 3245166213, // MENU_STAT_LOSSES
+  GameId_MENU_TITLE = 3437410117, // MENU_TITLE
+  GameId_MENU_PLAY_TOOLTIP = 4067681724, // MENU_PLAY_TOOLTIP
+  GameId_MENU_PLAY = 2914023493, // MENU_PLAY
+  GameId_MENU_LIMITER_TOOLTIP = 2081571188, // MENU_LIMITER_TOOLTIP
+  GameId_MENU_LIMITER = 3499991122, // MENU_LIMITER
+  GameId_MENU_QUALITY_TOOLTIP = 1767564688, // MENU_QUALITY_TOOLTIP
+  GameId_MENU_QUALITY = 4218223678, // MENU_QUALITY
+  GameId_MENU_QUIT_TOOLTIP = 1776378408, // MENU_QUIT_TOOLTIP
+  GameId_MENU_QUIT = 2514452919, // MENU_QUIT
+  GameId_MENU_RESTART_TOOLTIP = 682994497, // MENU_RESTART_TOOLTIP
+  GameId_MENU_RESTART = 1794291696, // MENU_RESTART
+  GameId_MENU_RESUME_TOOLTIP = 3278729652, // MENU_RESUME_TOOLTIP
+  GameId_MENU_RESUME = 1541926828, // MENU_RESUME
+  GameId_MENU_UI_SCALE_TOOLTIP = 3138041028, // MENU_UI_SCALE_TOOLTIP
+  GameId_MENU_UI_SCALE = 2471187453, // MENU_UI_SCALE
+  GameId_MENU_VOLUME_TOOLTIP = 418976928, // MENU_VOLUME_TOOLTIP
+  GameId_MENU_VOLUME = 4251332109, // MENU_VOLUME
+  GameId_MENU_EXPOSURE_TOOLTIP = 3345013459, // MENU_EXPOSURE_TOOLTIP
+  GameId_MENU_EXPOSURE = 2607509403, // MENU_EXPOSURE
+  GameId_MENU_VSYNC_TOOLTIP = 812836473, // MENU_VSYNC_TOOLTIP
+  GameId_MENU_VSYNC = 4118943530, // MENU_VSYNC
 };
 // clang-format on
@@ -13,8 +13,15 @@
  * 0.0 = Well into the glyph.
  * 0.5 = Precisely on the border of the glyph.
  * 1.0 = Well outside the glyph.
+ *
+ * Fonts can optionally be marked as 'dynamic', characters of dynamic fonts are rasterized on first
+ * use (on a background thread) into the free atlas slots. When the atlas is full the least recently
+ * used dynamic glyphs are evicted. Modified atlas regions are reported through an
+ * AssetTextureDirtyComp on the asset entity.
  */
 
+typedef struct sAssetFontTexDynamic AssetFontTexDynamic;
+
 typedef struct {
   Unicode cp;
   u8      variation;
@@ -30,6 +37,7 @@ ecs_comp_extern_public(AssetFontTexComp) {
   f32 baseline;                             // How far glyphs can extend below the rectangle.
   f32 border;                               // Size of the sdf border.
   HeapArray_t(AssetFontTexChar) characters; // Sorted on the unicode codepoint.
+  AssetFontTexDynamic* dynamic;             // Optional, on-demand glyph cache (not serialized).
 };
 
 extern DataMeta g_assetFontTexBundleMeta;
@@ -38,5 +46,14 @@ extern DataMeta g_assetFontTexMeta;
 
 /**
  * Get a character based on a unicode codepoint.
+ * NOTE: For dynamic fonts missing characters are queued to be rasterized, until then the fallback
+ * character is returned.
  */
 const AssetFontTexChar* asset_fonttex_lookup(const AssetFontTexComp*, Unicode, u8 variation);
+
+/**
+ * Get the generation of the font characters; changes whenever glyphs of a dynamic font are added or
+ * evicted. Can be used to invalidate data that was derived from the character metrics.
+ * NOTE: Always returns zero for non-dynamic fonts.
+ */
+u32 asset_fonttex_generation(const AssetFontTexComp*);
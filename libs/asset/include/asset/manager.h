@@ -9,13 +9,20 @@ typedef struct {
 } AssetMemRecord;
 
 typedef enum {
-  AssetManagerFlags_None          = 0,
-  AssetManagerFlags_DevSupport    = 1 << 0, // Load dev-only data (eg human readable strings).
-  AssetManagerFlags_TrackChanges  = 1 << 1,
-  AssetManagerFlags_DelayUnload   = 1 << 2,
-  AssetManagerFlags_PortableCache = 1 << 3, // Supports a cache from a different asset directory.
+  AssetManagerFlags_None            = 0,
+  AssetManagerFlags_DevSupport      = 1 << 0, // Load dev-only data (eg human readable strings).
+  AssetManagerFlags_TrackChanges    = 1 << 1,
+  AssetManagerFlags_DelayUnload     = 1 << 2,
+  AssetManagerFlags_PortableCache   = 1 << 3, // Supports a cache from a different asset directory.
+  AssetManagerFlags_Streaming       = 1 << 4, // Decode assets on background threads (off-frame).
+  AssetManagerFlags_RecordLoadOrder = 1 << 5, // Record the per-level load order (pack files only).
 } AssetManagerFlags;
 
+typedef enum {
+  AssetPriority_Normal,
+  AssetPriority_High, // Needed as soon as possible, for example visible on screen.
+} AssetPriority;
+
 /**
  * The AssetManager is responsible for loading and unloaded assets.
  */
@@ -56,8 +63,18 @@ bool asset_path_by_id(const AssetManagerComp*, String id, DynString* out);
  */
 AssetManagerComp* asset_manager_create_fs(EcsWorld*, AssetManagerFlags, String rootPath);
 
+/**
+ * Create a asset-manager (on the global entity) that loads assets from the file-system and shares
+ * its import cache with other machines through a remote Http cache.
+ * Remote cache url format: 'http[s]://host[:port][/prefix]'.
+ */
+AssetManagerComp* asset_manager_create_fs_remote(
+    EcsWorld*, AssetManagerFlags, String rootPath, String remoteCacheUrl);
+
 /**
  * Create a asset-manager (on the global entity) that loads assets from a pack file.
+ * NOTE: Uses the load-order stored at '{filePath}.order' (if any) to prefetch the regions that a
+ * level needs; the order is recorded when 'AssetManagerFlags_RecordLoadOrder' is set.
  */
 AssetManagerComp* asset_manager_create_pack(EcsWorld*, AssetManagerFlags, String filePath);
 
@@ -95,6 +112,13 @@ void asset_acquire(EcsWorld*, EcsEntityId assetEntity);
  */
 void asset_release(EcsWorld*, EcsEntityId assetEntity);
 
+/**
+ * Hint the manager about the importance of an asset that is currently loading.
+ * Only affects the order in which streaming loads are processed on the background threads.
+ * NOTE: The hint takes effect in the next frame and is cleared when the asset finishes loading.
+ */
+void asset_priority_hint(EcsWorld*, EcsEntityId assetEntity, AssetPriority);
+
 /**
  * Request the given asset to be reloaded.
  * NOTE: Unload is delayed until all systems release the asset.
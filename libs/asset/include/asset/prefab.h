@@ -77,6 +77,7 @@ typedef struct {
   AssetRef assets[asset_prefab_sounds_max]; // Random asset will be selected when spawned.
   f32      gainMin, gainMax;
   f32      pitchMin, pitchMax;
+  u8       priority; // Higher priority sounds are preferred when there are too many sounds.
   bool     looping;
   bool     persistent; // Pre-load the asset and keep it in memory.
 } AssetPrefabTraitSound;
@@ -2,11 +2,17 @@
 #include "data/registry.h"
 #include "ecs/module.h"
 
+typedef enum {
+  AssetSoundFormat_i16,   // i16[frameCount * channelCount], Interleaved channel samples (LRLRLR).
+  AssetSoundFormat_Adpcm, // Ima adpcm blocks, see 'core/adpcm.h' for the block layout.
+} AssetSoundFormat;
+
 ecs_comp_extern_public(AssetSoundComp) {
-  u8      frameChannels;
-  u32     frameCount;
-  u32     frameRate;
-  DataMem sampleData; // f32[frameCount * channelCount], Interleaved channel samples (LRLRLR).
+  AssetSoundFormat format;
+  u8               frameChannels;
+  u32              frameCount;
+  u32              frameRate;
+  DataMem          sampleData; // Encoded samples, layout depends on the format.
 };
 
 extern DataMeta g_assetSoundMeta;
@@ -13,6 +13,8 @@ typedef enum {
   AssetTextureFormat_Bc1, // RGB  4x4 block compression.
   AssetTextureFormat_Bc3, // RGBA 4x4 block compression.
   AssetTextureFormat_Bc4, // R    4x4 block compression.
+  AssetTextureFormat_Bc5, // RG   4x4 block compression.
+  AssetTextureFormat_Bc7, // RGBA 4x4 block compression (high quality).
 
   AssetTextureFormat_Count,
 } AssetTextureFormat;
@@ -26,6 +28,8 @@ typedef enum {
   AssetTextureFlags_Alpha        = 1 << 4, // Alpha channel is in use.
   AssetTextureFlags_Lossless     = 1 << 5, // Texture should not be compressed.
   AssetTextureFlags_BroadcastR   = 1 << 6, // Broadcast the r channel to rgba.
+  AssetTextureFlags_HighQuality  = 1 << 7, // Prefer higher quality (but slower) compression.
+  AssetTextureFlags_NormalMap    = 1 << 8, // Tangent space normals; z is reconstructed from xy.
 } AssetTextureFlags;
 
 ecs_comp_extern_public(AssetTextureComp) {
@@ -35,6 +39,13 @@ ecs_comp_extern_public(AssetTextureComp) {
   DataMem            pixelData;
 };
 
+/**
+ * Indicates that a region of the (mip 0) pixel data was modified after the texture was loaded.
+ * Consumers that keep a copy of the texture (for example the renderer) should update the region and
+ * remove the component afterwards; multiple modifications are merged into a single region.
+ */
+ecs_comp_extern_public(AssetTextureDirtyComp) { u32 x, y, width, height; };
+
 extern DataMeta g_assetTexMeta;
 extern DataMeta g_assetTexArrayDefMeta;
 extern DataMeta g_assetTexProcDefMeta;
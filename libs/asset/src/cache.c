@@ -1,5 +1,6 @@
 #include "core/alloc.h"
 #include "core/array.h"
+#include "core/bits.h"
 #include "core/diag.h"
 #include "core/dynstring.h"
 #include "core/file.h"
@@ -7,6 +8,7 @@
 #include "core/path.h"
 #include "core/stringtable.h"
 #include "core/thread.h"
+#include "core/time.h"
 #include "data/read.h"
 #include "data/utils.h"
 #include "data/write.h"
@@ -14,9 +16,55 @@
 #include "trace/tracer.h"
 
 #include "cache.h"
+#include "cache_remote.h"
+#include "checksum_index.h"
 
-static const String g_assetCachePath    = string_static(".cache");
-static const String g_assetCacheRegName = string_static("registry.blob");
+static const String g_assetCachePath        = string_static(".cache");
+static const String g_assetCacheRegName     = string_static("registry.blob");
+static const String g_assetCacheJournalName = string_static("registry.journal");
+
+/**
+ * Amount of journal records after which the registry is compacted (rewritten in full).
+ */
+#define asset_cache_compact_threshold 512
+
+/**
+ * Maximum amount of blob files that are written (and kept open) before syncing them together.
+ */
+#define asset_cache_blob_sync_max 64
+
+/**
+ * Interval at which the writer thread performs maintenance of the checksum index when idle.
+ */
+#define asset_cache_maintain_interval time_second
+
+/**
+ * Cache persistence.
+ *
+ * Blobs are written on a background thread. Queued writes to the same id are coalesced, and the
+ * writer persists all queued writes as a single batch:
+ * 1. The blobs are written to temporary files which are then synced to disk together, renamed to
+ *    their final names and the cache directory is synced (to persist the renames).
+ * 2. The registry entries of the batch are appended to the journal, which is synced once.
+ * 3. Once the journal grows too large, the registry is compacted into a new snapshot (written
+ *    atomically) and the journal is cleared.
+ *
+ * The journal only references blobs that are already on disk. A crash can at worst leave a new
+ * blob next to an old registry entry. That entry fails validation: its source mod-time, checksum
+ * or loader hash is older than the asset that produced the new blob. Torn journal records are
+ * detected by their checksum and discarded when the registry is opened.
+ *
+ * Optionally a remote (shared) cache is used as a second tier: local misses are looked up in the
+ * remote cache and newly written blobs are uploaded by the writer thread. Remote records contain
+ * the registry entry followed by the blob, the entry is validated using checksums (like portable
+ * caches) as the modification times are not meaningful across machines.
+ * Remote lookups are performed on a separate fetch thread: 'asset_cache_prepare()' queues a fetch
+ * for local misses and reports the lookup as not ready until the fetch has completed. Fetched
+ * entries are installed in the local registry, so the following lookup either hits locally or
+ * misses and the asset is imported from source as normal.
+ */
+
+#define asset_cache_remote_magic 0x31524356 // 'VCR1'
 
 typedef struct {
   u32 typeNameHash; // Hash of the type's name.
@@ -47,18 +95,53 @@ typedef struct {
   DynArray entries; // AssetCacheEntry[], sorted on idHash.
 } AssetCacheRegistry;
 
+typedef enum {
+  AssetCacheFetch_Queued,
+  AssetCacheFetch_Running,
+  AssetCacheFetch_Done,
+} AssetCacheFetchState;
+
+typedef struct {
+  String               id; // Interned in the global string-table.
+  StringHash           idHash;
+  u32                  loaderHash;
+  AssetCacheFetchState state;
+} AssetCacheFetch;
+
+typedef struct {
+  Mem             blob; // Owned copy of the blob data.
+  AssetCacheEntry entry;
+  bool            failed;
+  bool            committed;  // Entry is present in the in-memory registry.
+  bool            fromRemote; // Blob was fetched from the remote cache; only needs journaling.
+} AssetCacheWrite;
+
 struct sAssetCache {
-  Allocator*         alloc;
-  bool               error;
-  AssetCacheFlags    flags;
-  String             rootPath;
-  AssetCacheRegistry reg;
-  ThreadMutex        regMutex;
-  bool               regDirty;
-  File*              regFile;
+  Allocator*          alloc;
+  bool                error;
+  AssetCacheFlags     flags;
+  String              rootPath;
+  AssetCacheRegistry  reg;
+  ThreadMutex         regMutex;  // Protects the registry, the write queues and the fetches.
+  AssetCacheRemote*   remote;    // Optional remote cache tier.
+  AssetChecksumIndex* checksums; // Source file checksums.
+  File*               journalFile;
+  u32                 journalCount; // Records appended since the last compaction.
+
+  ThreadCondition writeWakeCondition, writeDoneCondition;
+  ThreadHandle    writeThread;
+  bool            writeShutdown;
+  DynArray        writeQueue; // AssetCacheWrite[], writes that are waiting to be processed.
+  DynArray        writeBatch; // AssetCacheWrite[], writes that are currently being processed.
+
+  ThreadCondition fetchWakeCondition;
+  ThreadHandle    fetchThread;
+  bool            fetchShutdown;
+  DynArray        fetches; // AssetCacheFetch[], remote lookups that are queued, running or done.
 };
 
-DataMeta g_assetCacheMeta;
+DataMeta        g_assetCacheMeta;
+static DataMeta g_assetCacheEntryMeta;
 
 static i8 cache_compare_entry(const void* a, const void* b) {
   const AssetCacheEntry* entryA = a;
@@ -84,38 +167,60 @@ static bool cache_ensure_dir(AssetCache* c) {
   return true;
 }
 
-static bool cache_reg_save(AssetCache* c) {
-  bool result = true;
+static String cache_tmp_path_scratch(const String path) {
+  return fmt_write_scratch("{}.tmp", fmt_text(path));
+}
+
+/**
+ * Write a file that is fully persisted before it replaces the file at the given path.
+ */
+static FileResult cache_write_durable(const String path, const String data) {
+  const String tmpPath = cache_tmp_path_scratch(path);
 
+  File*      file;
+  FileResult res;
+  if ((res = file_create(g_allocHeap, tmpPath, FileMode_Create, FileAccess_Write, &file))) {
+    return res;
+  }
+  if (!(res = file_write_sync(file, data))) {
+    res = file_sync(file);
+  }
+  file_destroy(file);
+  if (!res) {
+    res = file_rename(tmpPath, path);
+  }
+  if (!res) {
+    res = file_sync_dir(path_parent(path));
+  } else {
+    file_delete_sync(tmpPath);
+  }
+  return res;
+}
+
+/**
+ * Pre-condition: cache->regMutex is held by this thread.
+ */
+static bool cache_reg_save(AssetCache* c) {
   DynString blobBuffer = dynstring_create(c->alloc, 256);
   data_write_bin(g_dataReg, &blobBuffer, g_assetCacheMeta, mem_var(c->reg));
 
-  FileResult fileRes;
-  if ((fileRes = file_resize_sync(c->regFile, 0))) {
-    log_w(
-        "Failed to clear asset cache registry file",
-        log_param("error", fmt_text(file_result_str(fileRes))));
-    result = false;
-  }
-  if ((fileRes = file_write_sync(c->regFile, dynstring_view(&blobBuffer)))) {
+  const String path = path_build_scratch(c->rootPath, g_assetCachePath, g_assetCacheRegName);
+  const FileResult fileRes = cache_write_durable(path, dynstring_view(&blobBuffer));
+  if (fileRes) {
     log_w(
         "Failed to write asset cache registry",
         log_param("error", fmt_text(file_result_str(fileRes))));
-    result = false;
   }
-
   dynstring_destroy(&blobBuffer);
-  return result;
+  return fileRes == FileResult_Success;
 }
 
 static bool cache_reg_open(AssetCache* c) {
-  diag_assert(!c->regFile);
-
   const String path = path_build_scratch(c->rootPath, g_assetCachePath, g_assetCacheRegName);
-  const FileAccessFlags access = FileAccess_Read | FileAccess_Write;
 
+  File*      file;
   FileResult fileRes;
-  fileRes = file_create(c->alloc, path, FileMode_Open, access, &c->regFile);
+  fileRes = file_create(c->alloc, path, FileMode_Open, FileAccess_Read, &file);
   if (fileRes == FileResult_NotFound) {
     return false;
   }
@@ -128,14 +233,13 @@ static bool cache_reg_open(AssetCache* c) {
   }
 
   String data;
-  fileRes = file_map(c->regFile, 0 /* offset */, 0 /* size */, FileHints_Prefetch, &data);
+  fileRes = file_map(file, 0 /* offset */, 0 /* size */, FileHints_Prefetch, &data);
   if (UNLIKELY(fileRes != FileResult_Success)) {
     log_w(
         "Failed to map asset cache registry",
         log_param("path", fmt_path(path)),
         log_param("error", fmt_text(file_result_str(fileRes))));
-    file_destroy(c->regFile);
-    c->regFile = null;
+    file_destroy(file);
     return false;
   }
 
@@ -147,8 +251,8 @@ static bool cache_reg_open(AssetCache* c) {
         "Failed to read asset cache registry",
         log_param("path", fmt_path(path)),
         log_param("error", fmt_text(readRes.errorMsg)));
-    file_destroy(c->regFile);
-    c->regFile = null;
+    file_unmap(file, data);
+    file_destroy(file);
     return false;
   }
 
@@ -158,30 +262,15 @@ static bool cache_reg_open(AssetCache* c) {
       log_param("size", fmt_size(data.size)),
       log_param("entries", fmt_int(c->reg.entries.size)));
 
-  file_unmap(c->regFile, data);
+  file_unmap(file, data);
+  file_destroy(file);
   return true;
 }
 
 static bool cache_reg_create(AssetCache* c) {
-  diag_assert(!c->regFile);
-
-  const String path = path_build_scratch(c->rootPath, g_assetCachePath, g_assetCacheRegName);
-  const FileAccessFlags access = FileAccess_Read | FileAccess_Write;
-
-  FileResult fileRes;
-  fileRes = file_create(c->alloc, path, FileMode_Create, access, &c->regFile);
-  if (UNLIKELY(fileRes != FileResult_Success)) {
-    log_e(
-        "Failed to create asset cache registry",
-        log_param("path", fmt_path(path)),
-        log_param("error", fmt_text(file_result_str(fileRes))));
-    return false;
-  }
-
   c->reg = (AssetCacheRegistry){
       .entries = dynarray_create_t(c->alloc, AssetCacheEntry, 32),
   };
-
   return cache_reg_save(c);
 }
 
@@ -219,18 +308,372 @@ static const AssetCacheEntry* cache_reg_get(AssetCache* c, const StringHash idHa
   return dynarray_search_binary(&c->reg.entries, cache_compare_entry, &key);
 }
 
+/**
+ * Insert or replace the registry entry; takes ownership of the entry's dependencies.
+ * Pre-condition: cache->regMutex is held by this thread.
+ */
+static void cache_reg_commit(AssetCache* c, const AssetCacheEntry* entry) {
+  AssetCacheEntry* res = cache_reg_add(c, entry->id, entry->idHash);
+  if (res->dependencies.count) {
+    // Cleanup the old dependencies.
+    alloc_free_array_t(c->alloc, res->dependencies.values, res->dependencies.count);
+  }
+  *res = *entry;
+}
+
+/**
+ * Journal records are framed as: [u32 payload size] [u32 payload crc32] [payload].
+ */
+static void cache_journal_write_record(DynString* out, const AssetCacheEntry* entry) {
+  const usize headerOffset = out->size;
+  dynstring_push(out, 8);
+  data_write_bin(g_dataReg, out, g_assetCacheEntryMeta, mem_create(entry, sizeof(AssetCacheEntry)));
+
+  const Mem payload = mem_consume(dynstring_view(out), headerOffset + 8);
+  Mem       header  = mem_slice(dynstring_view(out), headerOffset, 8);
+  header            = mem_write_le_u32(header, (u32)payload.size);
+  header            = mem_write_le_u32(header, bits_crc_32(0, payload));
+}
+
+/**
+ * Replay the journal records on top of the registry snapshot.
+ * NOTE: Stops at the first invalid record (for example torn by a crash) and truncates the journal.
+ */
+static void cache_journal_replay(AssetCache* c) {
+  DynString data = dynstring_create(c->alloc, 4 * usize_kibibyte);
+  if (file_read_to_end_sync(c->journalFile, &data)) {
+    goto Ret;
+  }
+
+  Mem remaining = dynstring_view(&data);
+  while (remaining.size >= 8) {
+    u32 payloadSize, payloadCrc;
+    Mem payload = mem_consume_le_u32(remaining, &payloadSize);
+    payload     = mem_consume_le_u32(payload, &payloadCrc);
+    if (payload.size < payloadSize) {
+      break; // Truncated record.
+    }
+    payload = mem_slice(payload, 0, payloadSize);
+    if (bits_crc_32(0, payload) != payloadCrc) {
+      break; // Corrupt record.
+    }
+    AssetCacheEntry entry;
+    DataReadResult  readRes;
+    data_read_bin(
+        g_dataReg,
+        payload,
+        c->alloc,
+        g_assetCacheEntryMeta,
+        DataReadFlags_None,
+        mem_var(entry),
+        &readRes);
+    if (UNLIKELY(readRes.error)) {
+      break; // Incompatible record.
+    }
+    cache_reg_commit(c, &entry);
+    remaining = mem_consume(remaining, 8 + payloadSize);
+    ++c->journalCount;
+  }
+
+  if (remaining.size) {
+    log_w("Discarding invalid asset cache journal data", log_param("size", fmt_size(remaining.size)));
+    file_resize_sync(c->journalFile, data.size - remaining.size);
+  }
+
+Ret:
+  dynstring_destroy(&data);
+}
+
+static bool cache_journal_open(AssetCache* c) {
+  const String path = path_build_scratch(c->rootPath, g_assetCachePath, g_assetCacheJournalName);
+  const FileAccessFlags access = FileAccess_Read | FileAccess_Write;
+
+  const FileResult res = file_create(c->alloc, path, FileMode_Append, access, &c->journalFile);
+  if (UNLIKELY(res != FileResult_Success)) {
+    log_e(
+        "Failed to open asset cache journal",
+        log_param("path", fmt_path(path)),
+        log_param("error", fmt_text(file_result_str(res))));
+    return false;
+  }
+  cache_journal_replay(c);
+  return true;
+}
+
+/**
+ * Rewrite the registry snapshot and clear the journal.
+ * Pre-condition: cache->regMutex is held by this thread.
+ */
+static void cache_compact(AssetCache* c) {
+  if (cache_reg_save(c)) {
+    file_resize_sync(c->journalFile, 0);
+    c->journalCount = 0;
+  }
+}
+
+/**
+ * Create a copy of the entry's dependency array.
+ */
+static AssetCacheDependency* cache_deps_dup(AssetCache* c, const AssetCacheEntry* entry) {
+  const usize count = entry->dependencies.count;
+  if (!count) {
+    return null;
+  }
+  AssetCacheDependency* deps = alloc_array_t(c->alloc, AssetCacheDependency, count);
+  mem_cpy(
+      mem_create(deps, sizeof(AssetCacheDependency) * count),
+      mem_create(entry->dependencies.values, sizeof(AssetCacheDependency) * count));
+  return deps;
+}
+
+static u64 cache_remote_key(const String id, const u32 sourceChecksum, const u32 loaderHash) {
+  // NOTE: Values are written in a fixed byte order as keys are shared between machines.
+  u8  vals[12];
+  Mem valsMem = mem_var(vals);
+  valsMem     = mem_write_le_u32(valsMem, asset_cache_remote_magic);
+  valsMem     = mem_write_le_u32(valsMem, sourceChecksum);
+  valsMem     = mem_write_le_u32(valsMem, loaderHash);
+  return bits_hash_64_combine(bits_hash_64(id), bits_hash_64(mem_var(vals)));
+}
+
+/**
+ * Remote records are framed as: [u32 magic] [u32 entry size] [registry entry] [blob].
+ */
+static void cache_remote_record_write(DynString* out, const AssetCacheEntry* entry, const Mem blob) {
+  const usize headerOffset = out->size;
+  dynstring_push(out, 8);
+  data_write_bin(g_dataReg, out, g_assetCacheEntryMeta, mem_create(entry, sizeof(AssetCacheEntry)));
+
+  const usize entrySize = out->size - headerOffset - 8;
+  Mem         header    = mem_slice(dynstring_view(out), headerOffset, 8);
+  header                = mem_write_le_u32(header, asset_cache_remote_magic);
+  header                = mem_write_le_u32(header, (u32)entrySize);
+
+  dynstring_append(out, blob);
+}
+
+static void cache_write_destroy(AssetCache* c, AssetCacheWrite* write) {
+  if (mem_valid(write->blob)) {
+    alloc_free(c->alloc, write->blob);
+  }
+  if (write->entry.dependencies.count) {
+    AssetCacheDependency* deps = write->entry.dependencies.values;
+    alloc_free_array_t(c->alloc, deps, write->entry.dependencies.count);
+  }
+}
+
+/**
+ * Pre-condition: cache->regMutex is held by this thread.
+ */
+static bool cache_write_pending(AssetCache* c, const StringHash idHash) {
+  DynArray* queues[] = {&c->writeQueue, &c->writeBatch};
+  for (u32 i = 0; i != array_elems(queues); ++i) {
+    dynarray_for_t(queues[i], AssetCacheWrite, write) {
+      if (write->entry.idHash == idHash && !write->committed) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+static void cache_write_blob_fail(AssetCacheWrite* write, const String path, const FileResult res) {
+  log_w(
+      "Failed to write asset cache blob",
+      log_param("path", fmt_path(path)),
+      log_param("error", fmt_text(file_result_str(res))));
+  write->failed = true;
+}
+
+/**
+ * Write the blobs of the given writes durably.
+ * All blobs are written to temporary files first and then synced together, this lets the device
+ * persist them in a single go instead of waiting for each file individually.
+ */
+static void cache_write_blobs(AssetCache* c, AssetCacheWrite* writes, const usize count) {
+  File* files[asset_cache_blob_sync_max] = {0};
+  diag_assert(count <= asset_cache_blob_sync_max);
+
+  // Write the blobs to temporary files.
+  for (usize i = 0; i != count; ++i) {
+    AssetCacheWrite* write = &writes[i];
+    if (write->fromRemote) {
+      continue; // Blob was already written when it was fetched.
+    }
+    const String tmpPath = cache_tmp_path_scratch(cache_blob_path_scratch(c, write->entry.idHash));
+    FileResult   res;
+    if ((res = file_create(c->alloc, tmpPath, FileMode_Create, FileAccess_Write, &files[i]))) {
+      cache_write_blob_fail(write, tmpPath, res);
+      continue;
+    }
+    if ((res = file_write_sync(files[i], write->blob))) {
+      cache_write_blob_fail(write, tmpPath, res);
+    }
+  }
+
+  // Sync the temporary files to the device.
+  for (usize i = 0; i != count; ++i) {
+    if (!files[i]) {
+      continue;
+    }
+    FileResult res;
+    if (!writes[i].failed && (res = file_sync(files[i]))) {
+      cache_write_blob_fail(&writes[i], cache_blob_path_scratch(c, writes[i].entry.idHash), res);
+    }
+    file_destroy(files[i]);
+  }
+
+  // Replace the old blobs.
+  bool renamed = false;
+  for (usize i = 0; i != count; ++i) {
+    if (!files[i]) {
+      continue;
+    }
+    const String blobPath = cache_blob_path_scratch(c, writes[i].entry.idHash);
+    const String tmpPath  = cache_tmp_path_scratch(blobPath);
+    FileResult   res;
+    if (!writes[i].failed && (res = file_rename(tmpPath, blobPath))) {
+      cache_write_blob_fail(&writes[i], blobPath, res);
+    }
+    if (writes[i].failed) {
+      file_delete_sync(tmpPath);
+    } else {
+      renamed = true;
+    }
+  }
+
+  // Persist the renames; until then the journal should not reference the new blobs.
+  if (renamed) {
+    const String     dirPath = path_build_scratch(c->rootPath, g_assetCachePath);
+    const FileResult dirRes  = file_sync_dir(dirPath);
+    if (UNLIKELY(dirRes != FileResult_Success)) {
+      for (usize i = 0; i != count; ++i) {
+        if (files[i] && !writes[i].failed) {
+          cache_write_blob_fail(&writes[i], dirPath, dirRes);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Persist the current write batch.
+ * NOTE: Called on the writer thread without holding the registry mutex; the batch is not modified
+ * by other threads while its being processed.
+ */
+static void cache_write_batch(AssetCache* c) {
+  // Write the blobs.
+  AssetCacheWrite* writes = dynarray_begin_t(&c->writeBatch, AssetCacheWrite);
+  for (usize i = 0; i < c->writeBatch.size; i += asset_cache_blob_sync_max) {
+    const usize count = math_min(c->writeBatch.size - i, asset_cache_blob_sync_max);
+    cache_write_blobs(c, writes + i, count);
+  }
+
+  // Append the registry entries to the journal.
+  DynString journalBuffer = dynstring_create(c->alloc, 1024);
+  dynarray_for_t(&c->writeBatch, AssetCacheWrite, write) {
+    if (!write->failed) {
+      cache_journal_write_record(&journalBuffer, &write->entry);
+    }
+  }
+  if (journalBuffer.size) {
+    FileResult journalRes = file_write_sync(c->journalFile, dynstring_view(&journalBuffer));
+    if (!journalRes) {
+      journalRes = file_sync(c->journalFile);
+    }
+    if (UNLIKELY(journalRes != FileResult_Success)) {
+      log_w(
+          "Failed to write asset cache journal",
+          log_param("error", fmt_text(file_result_str(journalRes))));
+    }
+  }
+  dynstring_destroy(&journalBuffer);
+
+  // Commit the entries to the in-memory registry.
+  thread_mutex_lock(c->regMutex);
+  dynarray_for_t(&c->writeBatch, AssetCacheWrite, write) {
+    if (write->failed) {
+      continue;
+    }
+    if (!write->committed) {
+      cache_reg_commit(c, &write->entry);
+      // NOTE: The registry took ownership of the dependencies; keep a copy for the upload.
+      write->entry.dependencies.values = cache_deps_dup(c, &write->entry);
+      write->committed                 = true;
+    }
+    ++c->journalCount;
+  }
+  if (c->journalCount >= asset_cache_compact_threshold) {
+    cache_compact(c);
+  }
+  thread_mutex_unlock(c->regMutex);
+
+  // Share the new blobs with the remote cache.
+  if (c->remote) {
+    DynString recordBuffer = dynstring_create(c->alloc, 64 * usize_kibibyte);
+    dynarray_for_t(&c->writeBatch, AssetCacheWrite, write) {
+      if (write->failed || write->fromRemote) {
+        continue;
+      }
+      dynstring_clear(&recordBuffer);
+      cache_remote_record_write(&recordBuffer, &write->entry, write->blob);
+      const u64 key = cache_remote_key(
+          write->entry.id, write->entry.sourceChecksum, write->entry.sourceLoaderHash);
+      asset_cache_remote_put(c->remote, key, dynstring_view(&recordBuffer));
+    }
+    dynstring_destroy(&recordBuffer);
+  }
+
+  thread_mutex_lock(c->regMutex);
+  dynarray_for_t(&c->writeBatch, AssetCacheWrite, write) { cache_write_destroy(c, write); }
+  dynarray_clear(&c->writeBatch);
+  thread_mutex_unlock(c->regMutex);
+}
+
+static void cache_writer_thread(void* data) {
+  AssetCache* c = data;
+
+  thread_mutex_lock(c->regMutex);
+  for (;;) {
+    if (!c->writeQueue.size) {
+      thread_cond_broadcast(c->writeDoneCondition);
+      if (c->writeShutdown) {
+        break;
+      }
+      thread_cond_wait_timeout(c->writeWakeCondition, c->regMutex, asset_cache_maintain_interval);
+      if (!c->writeQueue.size && !c->writeShutdown) {
+        thread_mutex_unlock(c->regMutex);
+        asset_checksum_index_maintain(c->checksums);
+        thread_mutex_lock(c->regMutex);
+      }
+      continue;
+    }
+    // Take all queued writes as a single batch.
+    const DynArray batch = c->writeBatch;
+    c->writeBatch        = c->writeQueue;
+    c->writeQueue        = batch;
+
+    thread_mutex_unlock(c->regMutex);
+    cache_write_batch(c);
+    thread_mutex_lock(c->regMutex);
+  }
+  thread_mutex_unlock(c->regMutex);
+}
+
 static bool cache_reg_validate_file(
     const AssetCache* c, const String id, const TimeReal modTime, const u32 checksum) {
 
-  const String sourcePath = path_build_scratch(c->rootPath, id);
   if (c->flags & AssetCacheFlags_Portable) {
     /**
      * For portable caches we cannot rely on the modification timestamp as it could be produced on a
-     * different directory (potentially on a different machine), instead we compute a checksum.
+     * different directory (potentially on a different machine), instead we compare checksums.
      */
     u32 sourceChecksum = 0;
-    if (file_crc_32_path_sync(sourcePath, &sourceChecksum) || sourceChecksum != checksum) {
-      return false; // Source file cannot be read or has been modified.
+    if (asset_checksum_index_path(c->checksums, id, &sourceChecksum)) {
+      return false; // Source file cannot be read.
+    }
+    if (sourceChecksum != checksum) {
+      return false; // Source file has been modified.
     }
     return true;
   }
@@ -239,7 +682,7 @@ static bool cache_reg_validate_file(
    * For non-portable caches we use the modification timestamp to detect changes (which is allot
    * faster as it doesn't require loading the whole file).
    */
-  const FileInfo sourceInfo = file_stat_path_sync(sourcePath);
+  const FileInfo sourceInfo = file_stat_path_sync(path_build_scratch(c->rootPath, id));
   if (sourceInfo.type != FileType_Regular) {
     return false; // Source file has been deleted.
   }
@@ -298,6 +741,184 @@ static bool cache_meta_resolve(const DataReg* reg, const AssetCacheMeta* cacheMe
   return true;
 }
 
+/**
+ * Validate a file against a remote record using its checksum.
+ * NOTE: Updates the mod-time to the one of the local file.
+ */
+static bool cache_remote_validate_file(
+    const AssetCache* c, const String id, const u32 checksum, TimeReal* outModTime) {
+  const String   path = path_build_scratch(c->rootPath, id);
+  const FileInfo info = file_stat_path_sync(path);
+  if (info.type != FileType_Regular) {
+    return false;
+  }
+  u32 localChecksum;
+  if (asset_checksum_index_path(c->checksums, id, &localChecksum) || localChecksum != checksum) {
+    return false;
+  }
+  *outModTime = info.modTime;
+  return true;
+}
+
+/**
+ * Lookup the asset in the remote cache and install it in the local cache.
+ * NOTE: Called on the fetch thread without holding the registry mutex.
+ * NOTE: Loader hashes of the dependencies are validated when the entry is looked up.
+ */
+static bool cache_remote_fetch(
+    AssetCache* c, const String id, const StringHash idHash, const u32 loaderHash) {
+  const String   sourcePath = path_build_scratch(c->rootPath, id);
+  const FileInfo sourceInfo = file_stat_path_sync(sourcePath);
+  if (sourceInfo.type != FileType_Regular) {
+    return false; // Only assets with source files can be shared.
+  }
+  u32 sourceChecksum;
+  if (asset_checksum_index_path(c->checksums, id, &sourceChecksum)) {
+    return false;
+  }
+
+  bool            success = false;
+  AssetCacheEntry entry   = {0};
+  DynString       record  = dynstring_create(c->alloc, 64 * usize_kibibyte);
+  const u64       key     = cache_remote_key(id, sourceChecksum, loaderHash);
+  if (!asset_cache_remote_get(c->remote, key, &record)) {
+    goto Ret; // Remote miss.
+  }
+
+  // Decode the record.
+  u32 magic = 0, entrySize = 0;
+  Mem data  = dynstring_view(&record);
+  if (data.size >= 8) {
+    data = mem_consume_le_u32(data, &magic);
+    data = mem_consume_le_u32(data, &entrySize);
+  }
+  if (magic != asset_cache_remote_magic || data.size < entrySize) {
+    log_w("Malformed remote asset cache record", log_param("id", fmt_text(id)));
+    goto Ret;
+  }
+  const Mem      entryData = mem_slice(data, 0, entrySize);
+  const Mem      blob      = mem_consume(data, entrySize);
+  DataReadResult readRes;
+  data_read_bin(
+      g_dataReg,
+      entryData,
+      c->alloc,
+      g_assetCacheEntryMeta,
+      DataReadFlags_None,
+      mem_var(entry),
+      &readRes);
+  if (UNLIKELY(readRes.error)) {
+    log_w(
+        "Malformed remote asset cache record",
+        log_param("id", fmt_text(id)),
+        log_param("error", fmt_text(readRes.errorMsg)));
+    goto Ret; // NOTE: On failure the reader frees any partially read data.
+  }
+
+  // Validate the record against the local sources.
+  if (entry.idHash != idHash || !string_eq(entry.id, id)) {
+    goto Ret; // Key collision.
+  }
+  if (entry.sourceChecksum != sourceChecksum || entry.sourceLoaderHash != loaderHash) {
+    goto Ret; // Key collision.
+  }
+  DataMeta blobMeta;
+  if (!cache_meta_resolve(g_dataReg, &entry.meta, &blobMeta)) {
+    goto Ret; // Incompatible format.
+  }
+  entry.sourceModTime = sourceInfo.modTime;
+  heap_array_for_t(entry.dependencies, AssetCacheDependency, dep) {
+    if (!cache_remote_validate_file(c, dep->id, dep->checksum, &dep->modTime)) {
+      goto Ret; // Dependency file is different.
+    }
+  }
+
+  // Install the blob in the local cache.
+  const String     blobPath = cache_blob_path_scratch(c, idHash);
+  const FileResult blobRes  = cache_write_durable(blobPath, blob);
+  if (UNLIKELY(blobRes != FileResult_Success)) {
+    log_w(
+        "Failed to write asset cache blob",
+        log_param("path", fmt_path(blobPath)),
+        log_param("error", fmt_text(file_result_str(blobRes))));
+    goto Ret;
+  }
+  success = true;
+
+  log_d("Asset fetched from remote cache", log_param("id", fmt_text(id)));
+
+  // Add the entry to the registry and queue it to be journaled.
+  thread_mutex_lock(c->regMutex);
+  {
+    AssetCacheWrite write = {.entry = entry, .committed = true, .fromRemote = true};
+    write.entry.dependencies.values = cache_deps_dup(c, &entry);
+
+    cache_reg_commit(c, &entry);
+    entry = (AssetCacheEntry){0}; // Ownership was transferred to the registry.
+
+    *dynarray_push_t(&c->writeQueue, AssetCacheWrite) = write;
+    thread_cond_signal(c->writeWakeCondition);
+  }
+  thread_mutex_unlock(c->regMutex);
+
+Ret:
+  if (entry.dependencies.count) {
+    alloc_free_array_t(c->alloc, entry.dependencies.values, entry.dependencies.count);
+  }
+  dynstring_destroy(&record);
+  return success;
+}
+
+/**
+ * Pre-condition: cache->regMutex is held by this thread.
+ */
+static AssetCacheFetch* cache_fetch_get(AssetCache* c, const StringHash idHash) {
+  dynarray_for_t(&c->fetches, AssetCacheFetch, fetch) {
+    if (fetch->idHash == idHash) {
+      return fetch;
+    }
+  }
+  return null;
+}
+
+/**
+ * Pre-condition: cache->regMutex is held by this thread.
+ */
+static AssetCacheFetch* cache_fetch_next(AssetCache* c) {
+  dynarray_for_t(&c->fetches, AssetCacheFetch, fetch) {
+    if (fetch->state == AssetCacheFetch_Queued) {
+      return fetch;
+    }
+  }
+  return null;
+}
+
+static void cache_fetch_thread(void* data) {
+  AssetCache* c = data;
+
+  thread_mutex_lock(c->regMutex);
+  while (!c->fetchShutdown) {
+    AssetCacheFetch* fetch = cache_fetch_next(c);
+    if (!fetch) {
+      thread_cond_wait(c->fetchWakeCondition, c->regMutex);
+      continue;
+    }
+    fetch->state = AssetCacheFetch_Running;
+
+    const String     id         = fetch->id;
+    const StringHash idHash     = fetch->idHash;
+    const u32        loaderHash = fetch->loaderHash;
+
+    thread_mutex_unlock(c->regMutex);
+    cache_remote_fetch(c, id, idHash, loaderHash);
+    thread_mutex_lock(c->regMutex);
+
+    // NOTE: Lookup the fetch again as the array could have been resized while fetching.
+    cache_fetch_get(c, idHash)->state = AssetCacheFetch_Done;
+  }
+  thread_mutex_unlock(c->regMutex);
+}
+
 void asset_data_init_cache(void) {
   // clang-format off
   data_reg_struct_t(g_dataReg, AssetCacheMeta);
@@ -326,20 +947,33 @@ void asset_data_init_cache(void) {
   data_reg_field_t(g_dataReg, AssetCacheRegistry, entries, t_AssetCacheEntry, .container = DataContainer_DynArray);
   // clang-format on
 
-  g_assetCacheMeta = data_meta_t(t_AssetCacheRegistry);
+  g_assetCacheMeta      = data_meta_t(t_AssetCacheRegistry);
+  g_assetCacheEntryMeta = data_meta_t(t_AssetCacheEntry);
 }
 
-AssetCache*
-asset_cache_create(Allocator* alloc, const String rootPath, const AssetCacheFlags flags) {
+AssetCache* asset_cache_create(
+    Allocator*            alloc,
+    const String          rootPath,
+    const AssetCacheFlags flags,
+    AssetChecksumIndex*   checksums,
+    const String          remoteUrl) {
   diag_assert(!string_is_empty(rootPath));
+  diag_assert(checksums);
 
   AssetCache* c = alloc_alloc_t(alloc, AssetCache);
 
   *c = (AssetCache){
-      .alloc    = alloc,
-      .flags    = flags,
-      .rootPath = string_dup(alloc, rootPath),
-      .regMutex = thread_mutex_create(alloc),
+      .alloc              = alloc,
+      .flags              = flags,
+      .rootPath           = string_dup(alloc, rootPath),
+      .checksums          = checksums,
+      .regMutex           = thread_mutex_create(alloc),
+      .writeWakeCondition = thread_cond_create(alloc),
+      .writeDoneCondition = thread_cond_create(alloc),
+      .writeQueue         = dynarray_create_t(alloc, AssetCacheWrite, 64),
+      .writeBatch         = dynarray_create_t(alloc, AssetCacheWrite, 64),
+      .fetchWakeCondition = thread_cond_create(alloc),
+      .fetches            = dynarray_create_t(alloc, AssetCacheFetch, 16),
   };
 
   if (UNLIKELY(!cache_ensure_dir(c))) {
@@ -350,20 +984,64 @@ asset_cache_create(Allocator* alloc, const String rootPath, const AssetCacheFlag
     c->error = true;
     goto Ret;
   }
+  if (UNLIKELY(!cache_journal_open(c))) {
+    c->error = true;
+    goto Ret;
+  }
+
+  const ThreadPriority threadPrio = ThreadPriority_Low;
+  c->writeThread = thread_start(cache_writer_thread, c, string_lit("volo_cache"), threadPrio);
+
+  if (!string_is_empty(remoteUrl)) {
+    c->remote = asset_cache_remote_create(alloc, remoteUrl);
+  }
+  if (c->remote) {
+    const String fetchThreadName = string_lit("volo_cache_get");
+    c->fetchThread = thread_start(cache_fetch_thread, c, fetchThreadName, threadPrio);
+  }
 
 Ret:
   return c;
 }
 
 void asset_cache_destroy(AssetCache* c) {
-  if (c->regDirty && !c->error) {
-    cache_reg_save(c);
+  if (c->fetchThread) {
+    // Signal the fetcher to shutdown; queued (but not yet started) fetches are abandoned.
+    thread_mutex_lock(c->regMutex);
+    c->fetchShutdown = true;
+    thread_cond_signal(c->fetchWakeCondition);
+    thread_mutex_unlock(c->regMutex);
+
+    thread_join(c->fetchThread);
   }
-  if (c->regFile) {
-    file_destroy(c->regFile);
+  if (c->writeThread) {
+    // Signal the writer to shutdown; it will persist the remaining writes before exiting.
+    thread_mutex_lock(c->regMutex);
+    c->writeShutdown = true;
+    thread_cond_signal(c->writeWakeCondition);
+    thread_mutex_unlock(c->regMutex);
+
+    thread_join(c->writeThread);
+  }
+  if (c->remote) {
+    asset_cache_remote_destroy(c->remote);
   }
+  if (c->journalFile) {
+    if (c->journalCount) {
+      cache_compact(c);
+    }
+    file_destroy(c->journalFile);
+  }
+  diag_assert(!c->writeQueue.size && !c->writeBatch.size);
+  dynarray_destroy(&c->writeQueue);
+  dynarray_destroy(&c->writeBatch);
+  dynarray_destroy(&c->fetches);
+
   data_destroy(g_dataReg, c->alloc, g_assetCacheMeta, mem_var(c->reg));
   thread_mutex_destroy(c->regMutex);
+  thread_cond_destroy(c->writeWakeCondition);
+  thread_cond_destroy(c->writeDoneCondition);
+  thread_cond_destroy(c->fetchWakeCondition);
 
   string_free(c->alloc, c->rootPath);
   alloc_free_t(c->alloc, c);
@@ -374,10 +1052,8 @@ void asset_cache_flush(AssetCache* c) {
     return;
   }
   thread_mutex_lock(c->regMutex);
-  {
-    if (c->regDirty && cache_reg_save(c)) {
-      c->regDirty = false;
-    }
+  while (c->writeQueue.size || c->writeBatch.size) {
+    thread_cond_wait(c->writeDoneCondition, c->regMutex);
   }
   thread_mutex_unlock(c->regMutex);
 }
@@ -395,17 +1071,6 @@ void asset_cache_set(
   const StringHash     idHash    = string_hash(source->id);
   const AssetCacheMeta cacheMeta = cache_meta_create(g_dataReg, blobMeta);
 
-  // Save the blob to disk.
-  const String     blobPath     = cache_blob_path_scratch(c, idHash);
-  const FileResult blobWriteRes = file_write_to_path_atomic(blobPath, blob);
-  if (UNLIKELY(blobWriteRes != FileResult_Success)) {
-    log_w(
-        "Failed to write asset cache blob",
-        log_param("path", fmt_path(blobPath)),
-        log_param("error", fmt_text(file_result_str(blobWriteRes))));
-    return;
-  }
-
   // Initialize the dependency array.
   AssetCacheDependency* cacheDependencies = null;
   if (depCount) {
@@ -421,24 +1086,84 @@ void asset_cache_set(
     }
   }
 
-  // Add an entry to the registry.
+  const AssetCacheWrite write = {
+      .blob = blob.size ? alloc_dup(c->alloc, blob, 1) : mem_empty,
+      .entry =
+          {
+              .id                  = stringtable_intern(g_stringtable, source->id),
+              .idHash              = idHash,
+              .meta                = cacheMeta,
+              .sourceModTime       = source->modTime,
+              .sourceChecksum      = source->checksum,
+              .sourceLoaderHash    = source->loaderHash,
+              .dependencies.values = cacheDependencies,
+              .dependencies.count  = depCount,
+          },
+  };
+
+  // Queue the write; replaces any queued (but not yet started) write for the same asset.
   thread_mutex_lock(c->regMutex);
   {
-    AssetCacheEntry* entry  = cache_reg_add(c, source->id, idHash);
-    entry->meta             = cacheMeta;
-    entry->sourceModTime    = source->modTime;
-    entry->sourceChecksum   = source->checksum;
-    entry->sourceLoaderHash = source->loaderHash;
-    if (entry->dependencies.count) {
-      // Cleanup the old dependencies.
-      alloc_free_array_t(c->alloc, entry->dependencies.values, entry->dependencies.count);
+    AssetCacheWrite* queued = null;
+    dynarray_for_t(&c->writeQueue, AssetCacheWrite, other) {
+      if (other->entry.idHash == idHash) {
+        queued = other;
+        break;
+      }
+    }
+    if (queued) {
+      cache_write_destroy(c, queued);
+    } else {
+      queued = dynarray_push_t(&c->writeQueue, AssetCacheWrite);
     }
-    entry->dependencies.values = cacheDependencies;
-    entry->dependencies.count  = depCount;
+    *queued = write;
+    thread_cond_signal(c->writeWakeCondition);
+  }
+  thread_mutex_unlock(c->regMutex);
+}
 
-    c->regDirty = true;
+bool asset_cache_prepare(
+    AssetCache* c, const String id, const AssetRepoLoaderHasher loaderHasher) {
+  if (UNLIKELY(c->error) || !c->remote) {
+    return true; // No remote to fetch from; lookups are local only.
   }
+  const StringHash idHash = string_hash(id);
+
+  bool ready = true;
+  thread_mutex_lock(c->regMutex);
+  {
+    AssetCacheFetch* fetch = cache_fetch_get(c, idHash);
+    if (fetch) {
+      if (fetch->state == AssetCacheFetch_Done) {
+        // Fetch has completed (either installing the entry locally or missing); consume it.
+        dynarray_remove_ptr(&c->fetches, fetch);
+      } else {
+        ready = false;
+      }
+      goto Done;
+    }
+    if (!asset_cache_remote_available(c->remote)) {
+      goto Done; // Remote is unreachable; avoid paying the timeout for every lookup.
+    }
+    if (cache_write_pending(c, idHash)) {
+      goto Done; // Entry is currently being written locally.
+    }
+    const AssetCacheEntry* entry = cache_reg_get(c, idHash);
+    if (entry && cache_reg_validate(c, entry, loaderHasher)) {
+      goto Done; // Valid local entry.
+    }
+    *dynarray_push_t(&c->fetches, AssetCacheFetch) = (AssetCacheFetch){
+        .id         = stringtable_intern(g_stringtable, id),
+        .idHash     = idHash,
+        .loaderHash = loaderHasher.computeHash(loaderHasher.ctx, id),
+        .state      = AssetCacheFetch_Queued,
+    };
+    thread_cond_signal(c->fetchWakeCondition);
+    ready = false;
+  }
+Done:
   thread_mutex_unlock(c->regMutex);
+  return ready;
 }
 
 bool asset_cache_get(
@@ -458,7 +1183,7 @@ bool asset_cache_get(
   thread_mutex_lock(c->regMutex);
   {
     const AssetCacheEntry* entry = cache_reg_get(c, idHash);
-    if (entry) {
+    if (entry && !cache_write_pending(c, idHash)) {
       diag_assert_msg(string_eq(entry->id, id), "Asset id hash collision detected");
 
       if (!cache_meta_resolve(g_dataReg, &entry->meta, &out->meta)) {
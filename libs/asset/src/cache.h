@@ -2,6 +2,7 @@
 #include "core/string.h"
 #include "data/registry.h"
 
+#include "checksum_index.h"
 #include "repo.h"
 
 typedef struct sAssetCache AssetCache;
@@ -13,12 +14,25 @@ typedef enum {
 
 extern DataMeta g_assetCacheMeta;
 
-AssetCache* asset_cache_create(Allocator*, String rootPath, AssetCacheFlags);
+/**
+ * Create a cache in the '{rootPath}/.cache' directory.
+ * Source checksums are retrieved through the given checksum index (which has to outlive the cache).
+ * Optionally a remote cache url ('http[s]://host[:port][/prefix]') can be provided to share cache
+ * entries between machines.
+ */
+AssetCache* asset_cache_create(
+    Allocator*, String rootPath, AssetCacheFlags, AssetChecksumIndex*, String remoteUrl);
 void        asset_cache_destroy(AssetCache*);
-void        asset_cache_flush(AssetCache*);
 
 /**
- * Save the given blob in the cache.
+ * Block until all queued writes have been persisted.
+ */
+void asset_cache_flush(AssetCache*);
+
+/**
+ * Queue the given blob to be saved in the cache.
+ * NOTE: Writes are performed on a background thread; until the write has been persisted lookups
+ * for the same id will miss.
  * NOTE: Overwrites any existing blobs with the same id.
  */
 void asset_cache_set(
@@ -37,9 +51,19 @@ typedef struct {
   u32      sourceChecksum;
 } AssetCacheRecord;
 
+/**
+ * Prepare a lookup of the given id.
+ * Returns false while the entry is being fetched from the remote cache, in which case the lookup
+ * should be retried later. Once the fetch has completed the entry is either available locally or
+ * the lookup misses (and the asset should be imported from source).
+ * NOTE: Always returns true when no remote cache is configured.
+ */
+bool asset_cache_prepare(AssetCache*, String id, AssetRepoLoaderHasher);
+
 /**
  * Lookup a cache record containing with the given id.
  * Returns true when a compatible cache entry was found.
+ * NOTE: Only looks up local entries, use 'asset_cache_prepare()' to fetch entries from the remote.
  * NOTE: When successful the caller is responsible for destroying the blob file handle.
  */
 bool asset_cache_get(AssetCache*, String id, AssetRepoLoaderHasher, AssetCacheRecord* out);
@@ -0,0 +1,194 @@
+#include "core/alloc.h"
+#include "core/diag.h"
+#include "core/dynstring.h"
+#include "core/format.h"
+#include "core/thread.h"
+#include "core/time.h"
+#include "log/logger.h"
+#include "net/http.h"
+#include "net/init.h"
+#include "net/rest.h"
+#include "net/result.h"
+#include "trace/tracer.h"
+
+#include "cache_remote.h"
+
+#define asset_cache_remote_workers 2
+#define asset_cache_remote_requests 16
+#define asset_cache_remote_timeout time_seconds(5)
+
+struct sAssetCacheRemote {
+  Allocator* alloc;
+  NetRest*   rest;
+  String     host, prefix;
+  i32        unavailable; // Set (atomically) once the remote has failed to respond.
+};
+
+static bool remote_url_parse(
+    const String url, NetHttpFlags* outFlags, String* outHost, String* outPrefix) {
+  String rem;
+  if (string_starts_with(url, string_lit("http://"))) {
+    *outFlags = NetHttpFlags_None;
+    rem       = string_consume(url, 7);
+  } else if (string_starts_with(url, string_lit("https://"))) {
+    *outFlags = NetHttpFlags_Tls;
+    rem       = string_consume(url, 8);
+  } else {
+    return false; // Unsupported scheme.
+  }
+  const usize pathStart = string_find_first(rem, string_lit("/"));
+  if (sentinel_check(pathStart)) {
+    *outHost   = rem;
+    *outPrefix = string_empty;
+  } else {
+    *outHost   = string_slice(rem, 0, pathStart);
+    *outPrefix = string_consume(rem, pathStart);
+  }
+  while (string_ends_with(*outPrefix, string_lit("/"))) {
+    *outPrefix = string_slice(*outPrefix, 0, outPrefix->size - 1);
+  }
+  return !string_is_empty(*outHost);
+}
+
+static String remote_key_str_scratch(const u64 key) {
+  return fmt_write_scratch("{}", fmt_int(key, .base = 16, .minDigits = 16));
+}
+
+static String remote_uri_scratch(const AssetCacheRemote* r, const u64 key) {
+  return fmt_write_scratch("{}/{}.blob", fmt_text(r->prefix), fmt_text(remote_key_str_scratch(key)));
+}
+
+static NetHttpEtag remote_etag(const u64 key) {
+  const String keyStr = remote_key_str_scratch(key);
+  NetHttpEtag  res    = {.length = (u8)keyStr.size};
+  mem_cpy(mem_create(res.data, keyStr.size), keyStr);
+  return res;
+}
+
+static void remote_mark_unavailable(AssetCacheRemote* r, const NetResult result) {
+  if (thread_atomic_exchange_i32(&r->unavailable, 1) == 0) {
+    log_w(
+        "Remote asset cache unavailable",
+        log_param("host", fmt_text(r->host)),
+        log_param("error", fmt_text(net_result_str(result))));
+  }
+}
+
+/**
+ * Wait for the given request to finish.
+ * NOTE: Requests that exceed the timeout are abandoned and the remote is marked as unavailable; the
+ * request slot is reclaimed when the rest session is destroyed.
+ */
+static NetResult remote_wait(AssetCacheRemote* r, const NetRestId id) {
+  if (sentinel_check(id)) {
+    return NetResult_RestBusy; // No free request slots; treat as a miss.
+  }
+  if (!net_rest_wait(r->rest, id, asset_cache_remote_timeout)) {
+    remote_mark_unavailable(r, NetResult_TryAgain);
+    return NetResult_TryAgain;
+  }
+  const NetResult result = net_rest_result(r->rest, id);
+  switch (result) {
+  case NetResult_Success:
+  case NetResult_HttpNotModified:
+  case NetResult_HttpNotFound:
+    break;
+  default:
+    remote_mark_unavailable(r, result);
+    break;
+  }
+  return result;
+}
+
+AssetCacheRemote* asset_cache_remote_create(Allocator* alloc, const String url) {
+  NetHttpFlags httpFlags;
+  String       host, prefix;
+  if (!remote_url_parse(url, &httpFlags, &host, &prefix)) {
+    log_e("Malformed remote asset cache url", log_param("url", fmt_text(url)));
+    return null;
+  }
+
+  net_init(); // NOTE: Paired with the teardown in 'asset_cache_remote_destroy()'.
+
+  AssetCacheRemote* r = alloc_alloc_t(alloc, AssetCacheRemote);
+
+  *r = (AssetCacheRemote){
+      .alloc  = alloc,
+      .host   = string_dup(alloc, host),
+      .prefix = string_maybe_dup(alloc, prefix),
+      .rest   = net_rest_create(
+          alloc, asset_cache_remote_workers, asset_cache_remote_requests, httpFlags),
+  };
+
+  log_i(
+      "Remote asset cache created",
+      log_param("host", fmt_text(r->host)),
+      log_param("prefix", fmt_text(r->prefix)),
+      log_param("tls", fmt_bool(httpFlags & NetHttpFlags_Tls)));
+
+  return r;
+}
+
+void asset_cache_remote_destroy(AssetCacheRemote* r) {
+  net_rest_destroy(r->rest);
+  string_free(r->alloc, r->host);
+  string_maybe_free(r->alloc, r->prefix);
+  alloc_free_t(r->alloc, r);
+
+  net_teardown();
+}
+
+bool asset_cache_remote_available(AssetCacheRemote* r) {
+  return thread_atomic_load_i32(&r->unavailable) == 0;
+}
+
+bool asset_cache_remote_get(AssetCacheRemote* r, const u64 key, DynString* out) {
+  if (!asset_cache_remote_available(r)) {
+    return false;
+  }
+  trace_begin("asset_cache_remote_get", TraceColor_Blue);
+
+  bool            success = false;
+  const NetRestId id      = net_rest_get(r->rest, r->host, remote_uri_scratch(r, key), null, null);
+  if (remote_wait(r, id) == NetResult_Success) {
+    dynstring_append(out, net_rest_data(r->rest, id));
+    success = true;
+  }
+  net_rest_release(r->rest, id);
+
+  trace_end();
+  return success;
+}
+
+void asset_cache_remote_put(AssetCacheRemote* r, const u64 key, const String data) {
+  if (!asset_cache_remote_available(r)) {
+    return;
+  }
+  trace_begin("asset_cache_remote_put", TraceColor_Blue);
+
+  const String uri = string_dup(g_allocHeap, remote_uri_scratch(r, key));
+
+  /**
+   * Records are immutable (content-addressed) so there's no need to upload records that already
+   * exist; the key is used as the ETag to check for the record without downloading it.
+   */
+  const NetHttpEtag etag     = remote_etag(key);
+  const NetRestId   headId   = net_rest_head(r->rest, r->host, uri, null, &etag);
+  const NetResult   headRes  = remote_wait(r, headId);
+  const bool        needsPut = headRes == NetResult_HttpNotFound;
+  net_rest_release(r->rest, headId);
+
+  if (needsPut) {
+    const NetRestId putId = net_rest_put(r->rest, r->host, uri, null, data);
+    if (remote_wait(r, putId) == NetResult_Success) {
+      log_d(
+          "Remote asset cache record uploaded",
+          log_param("key", fmt_text(remote_key_str_scratch(key))),
+          log_param("size", fmt_size(data.size)));
+    }
+    net_rest_release(r->rest, putId);
+  }
+
+  string_free(g_allocHeap, uri);
+  trace_end();
+}
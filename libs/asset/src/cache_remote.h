@@ -0,0 +1,40 @@
+#pragma once
+#include "core/string.h"
+
+/**
+ * Remote (shared) asset cache tier that is accessed over Http.
+ *
+ * Records are content-addressed: the key is derived from the asset id, the source checksum and the
+ * loader hash, which makes records valid on any machine that has the same source data.
+ * NOTE: Keys are 64 bit as the store is shared; 32 bit keys would collide at around 2^16 records.
+ * Layout on the server: 'GET|HEAD|PUT {prefix}/{key}.blob', where the key is also used as the ETag.
+ *
+ * NOTE: Has to be created and destroyed on the main-thread as it initializes the network subsystem.
+ * NOTE: Api is thread-safe.
+ */
+typedef struct sAssetCacheRemote AssetCacheRemote;
+
+/**
+ * Create a remote cache for the given url ('http[s]://host[:port][/prefix]').
+ * NOTE: Returns null if the url is malformed.
+ */
+AssetCacheRemote* asset_cache_remote_create(Allocator*, String url);
+void              asset_cache_remote_destroy(AssetCacheRemote*);
+
+/**
+ * Check if the remote is (still) available.
+ * NOTE: Once a request fails or times out the remote is considered unreachable for the rest of the
+ * session, this avoids paying the timeout on every subsequent lookup.
+ */
+bool asset_cache_remote_available(AssetCacheRemote*);
+
+/**
+ * Synchronously fetch the record with the given key.
+ * NOTE: Returns false on a miss or when the remote is unavailable.
+ */
+bool asset_cache_remote_get(AssetCacheRemote*, u64 key, DynString* out);
+
+/**
+ * Synchronously upload a record with the given key, unless the remote already has it.
+ */
+void asset_cache_remote_put(AssetCacheRemote*, u64 key, String data);
@@ -0,0 +1,365 @@
+#include "core/alloc.h"
+#include "core/bits.h"
+#include "core/diag.h"
+#include "core/dynarray.h"
+#include "core/dynstring.h"
+#include "core/path.h"
+#include "core/stringtable.h"
+#include "core/thread.h"
+#include "core/time.h"
+#include "data/read.h"
+#include "data/utils.h"
+#include "data/write.h"
+#include "log/logger.h"
+#include "trace/tracer.h"
+
+#include "checksum_index.h"
+
+static const String g_checksumIndexPath = string_static(".cache/checksums.blob");
+
+/**
+ * Files that were modified less then this duration before being checksummed are not indexed.
+ * Protects against a file being modified again within the resolution of the modification-time
+ * without changing its size; such files are checksummed again the next time.
+ */
+#define asset_checksum_index_racy_duration time_second
+
+/**
+ * Modified indices are saved at most once per interval, this limits the amount of lost entries when
+ * the application is not shutdown gracefully.
+ */
+#define asset_checksum_index_save_interval time_seconds(30)
+
+/**
+ * The statistics are logged once no checksums have been requested for this duration, which usually
+ * means the initial asset load has finished.
+ */
+#define asset_checksum_index_settle time_seconds(2)
+
+typedef struct {
+  String     id;
+  StringHash idHash; // NOTE: Not persisted.
+  u64        fileId; // Inode / file-index; zero if unknown.
+  u64        size;
+  TimeReal   modTime;
+  u32        checksum; // crc32 (ISO 3309).
+} AssetChecksumEntry;
+
+typedef struct {
+  DynArray entries; // AssetChecksumEntry[], sorted on idHash.
+} AssetChecksumRegistry;
+
+struct sAssetChecksumIndex {
+  Allocator*            alloc;
+  String                rootPath;
+  ThreadMutex           mutex; // Protects the registry, the counters and the timestamps.
+  AssetChecksumRegistry reg;
+  bool                  dirty, statsLogged;
+  u32                   countHashed, countIndexed;
+  TimeSteady            lastRequest, lastSave;
+};
+
+DataMeta g_assetChecksumIndexMeta;
+
+static i8 checksum_compare_entry(const void* a, const void* b) {
+  const AssetChecksumEntry* entryA = a;
+  const AssetChecksumEntry* entryB = b;
+  return compare_stringhash(&entryA->idHash, &entryB->idHash);
+}
+
+static bool checksum_entry_valid(const AssetChecksumEntry* entry, const FileInfo* info) {
+  return entry->fileId == info->id && entry->size == info->size && entry->modTime == info->modTime;
+}
+
+/**
+ * Pre-condition: index->mutex is held by this thread.
+ */
+static void checksum_track(AssetChecksumIndex* idx, const bool indexed) {
+  if (indexed) {
+    ++idx->countIndexed;
+  } else {
+    ++idx->countHashed;
+  }
+  idx->lastRequest = time_steady_clock();
+}
+
+static bool checksum_racy(const FileInfo* info) {
+  return time_real_duration(info->modTime, time_real_clock()) < asset_checksum_index_racy_duration;
+}
+
+/**
+ * Lookup the checksum for the given file.
+ * Pre-condition: index->mutex is held by this thread.
+ */
+static bool checksum_lookup(
+    AssetChecksumIndex* idx, const String id, const FileInfo* info, u32* out) {
+  const AssetChecksumEntry  key = {.idHash = string_hash(id)};
+  const AssetChecksumEntry* entry =
+      dynarray_search_binary(&idx->reg.entries, checksum_compare_entry, &key);
+  if (entry && string_eq(entry->id, id) && checksum_entry_valid(entry, info)) {
+    *out = entry->checksum;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * Pre-condition: index->mutex is held by this thread.
+ */
+static void
+checksum_store(AssetChecksumIndex* idx, const String id, const FileInfo* info, const u32 checksum) {
+  const StringHash         idHash = string_hash(id);
+  const AssetChecksumEntry key    = {.idHash = idHash};
+  AssetChecksumEntry*      entry =
+      dynarray_find_or_insert_sorted(&idx->reg.entries, checksum_compare_entry, &key);
+
+  *entry = (AssetChecksumEntry){
+      .id       = stringtable_intern(g_stringtable, id),
+      .idHash   = idHash,
+      .fileId   = info->id,
+      .size     = info->size,
+      .modTime  = info->modTime,
+      .checksum = checksum,
+  };
+  idx->dirty = true;
+}
+
+static void checksum_open(AssetChecksumIndex* idx) {
+  const String path = path_build_scratch(idx->rootPath, g_checksumIndexPath);
+
+  File*      file;
+  FileResult fileRes = file_create(idx->alloc, path, FileMode_Open, FileAccess_Read, &file);
+  if (fileRes != FileResult_Success) {
+    return; // No index yet (or not accessible); start with an empty index.
+  }
+  String data;
+  fileRes = file_map(file, 0 /* offset */, 0 /* size */, FileHints_Prefetch, &data);
+  if (UNLIKELY(fileRes != FileResult_Success)) {
+    file_destroy(file);
+    return;
+  }
+
+  AssetChecksumRegistry reg;
+  DataReadResult        readRes;
+  data_read_bin(
+      g_dataReg,
+      data,
+      idx->alloc,
+      g_assetChecksumIndexMeta,
+      DataReadFlags_None,
+      mem_var(reg),
+      &readRes);
+
+  if (LIKELY(!readRes.error)) {
+    dynarray_destroy(&idx->reg.entries);
+    idx->reg = reg;
+
+    // NOTE: Id hashes are not persisted; compute them and sort the entries on them.
+    dynarray_for_t(&idx->reg.entries, AssetChecksumEntry, entry) {
+      entry->idHash = string_hash(entry->id);
+    }
+    dynarray_sort(&idx->reg.entries, checksum_compare_entry);
+
+    log_i(
+        "Opened asset checksum index",
+        log_param("path", fmt_path(path)),
+        log_param("size", fmt_size(data.size)),
+        log_param("entries", fmt_int(idx->reg.entries.size)));
+  } else {
+    log_w(
+        "Failed to read asset checksum index",
+        log_param("path", fmt_path(path)),
+        log_param("error", fmt_text(readRes.errorMsg)));
+  }
+
+  file_unmap(file, data);
+  file_destroy(file);
+}
+
+/**
+ * Pre-condition: index->mutex is held by this thread.
+ */
+static void checksum_serialize(AssetChecksumIndex* idx, DynString* out) {
+  data_write_bin(g_dataReg, out, g_assetChecksumIndexMeta, mem_var(idx->reg));
+  idx->dirty    = false;
+  idx->lastSave = time_steady_clock();
+}
+
+static void checksum_save(AssetChecksumIndex* idx, DynString* blobBuffer) {
+  const String path = path_build_scratch(idx->rootPath, g_checksumIndexPath);
+
+  FileResult fileRes = file_create_dir_sync(path_parent(path));
+  if (fileRes == FileResult_Success || fileRes == FileResult_AlreadyExists) {
+    fileRes = file_write_to_path_atomic(path, dynstring_view(blobBuffer));
+  }
+  if (UNLIKELY(fileRes != FileResult_Success)) {
+    log_w(
+        "Failed to write asset checksum index",
+        log_param("path", fmt_path(path)),
+        log_param("error", fmt_text(file_result_str(fileRes))));
+  }
+}
+
+/**
+ * Pre-condition: index->mutex is held by this thread.
+ */
+static void checksum_log_stats(AssetChecksumIndex* idx) {
+  log_i(
+      "Asset checksum index stats",
+      log_param("hashed", fmt_int(idx->countHashed)),
+      log_param("indexed", fmt_int(idx->countIndexed)),
+      log_param("entries", fmt_int(idx->reg.entries.size)));
+  idx->statsLogged = true;
+}
+
+void asset_data_init_checksum(void) {
+  // clang-format off
+  data_reg_struct_t(g_dataReg, AssetChecksumEntry);
+  data_reg_field_t(g_dataReg, AssetChecksumEntry, id, data_prim_t(String), .flags = DataFlags_Intern);
+  data_reg_field_t(g_dataReg, AssetChecksumEntry, fileId, data_prim_t(u64));
+  data_reg_field_t(g_dataReg, AssetChecksumEntry, size, data_prim_t(u64));
+  data_reg_field_t(g_dataReg, AssetChecksumEntry, modTime, data_prim_t(i64));
+  data_reg_field_t(g_dataReg, AssetChecksumEntry, checksum, data_prim_t(u32));
+
+  data_reg_struct_t(g_dataReg, AssetChecksumRegistry);
+  data_reg_field_t(g_dataReg, AssetChecksumRegistry, entries, t_AssetChecksumEntry, .container = DataContainer_DynArray);
+  // clang-format on
+
+  g_assetChecksumIndexMeta = data_meta_t(t_AssetChecksumRegistry);
+}
+
+AssetChecksumIndex* asset_checksum_index_create(Allocator* alloc, const String rootPath) {
+  diag_assert(!string_is_empty(rootPath));
+
+  AssetChecksumIndex* idx = alloc_alloc_t(alloc, AssetChecksumIndex);
+
+  *idx = (AssetChecksumIndex){
+      .alloc    = alloc,
+      .rootPath = string_dup(alloc, rootPath),
+      .mutex    = thread_mutex_create(alloc),
+      .reg      = {.entries = dynarray_create_t(alloc, AssetChecksumEntry, 64)},
+      .lastSave = time_steady_clock(),
+  };
+
+  checksum_open(idx);
+  return idx;
+}
+
+void asset_checksum_index_destroy(AssetChecksumIndex* idx) {
+  if (!idx->statsLogged && (idx->countHashed || idx->countIndexed)) {
+    checksum_log_stats(idx);
+  }
+  if (idx->dirty) {
+    DynString blobBuffer = dynstring_create(idx->alloc, 4 * usize_kibibyte);
+    checksum_serialize(idx, &blobBuffer);
+    checksum_save(idx, &blobBuffer);
+    dynstring_destroy(&blobBuffer);
+  }
+  data_destroy(g_dataReg, idx->alloc, g_assetChecksumIndexMeta, mem_var(idx->reg));
+  thread_mutex_destroy(idx->mutex);
+  string_free(idx->alloc, idx->rootPath);
+  alloc_free_t(idx->alloc, idx);
+}
+
+u32 asset_checksum_index_data(
+    AssetChecksumIndex* idx, const String id, const FileInfo* info, const String data) {
+  u32 checksum;
+  thread_mutex_lock(idx->mutex);
+  const bool found = checksum_lookup(idx, id, info, &checksum);
+  if (found) {
+    checksum_track(idx, true /* indexed */);
+  }
+  thread_mutex_unlock(idx->mutex);
+  if (found) {
+    return checksum;
+  }
+
+  trace_begin("asset_checksum", TraceColor_Blue);
+  checksum = bits_crc_32(0, data);
+  trace_end();
+
+  thread_mutex_lock(idx->mutex);
+  checksum_track(idx, false /* indexed */);
+  if (!checksum_racy(info)) {
+    checksum_store(idx, id, info, checksum);
+  }
+  thread_mutex_unlock(idx->mutex);
+  return checksum;
+}
+
+FileResult asset_checksum_index_path(AssetChecksumIndex* idx, const String id, u32* out) {
+  const String path = path_build_scratch(idx->rootPath, id);
+
+  File*      file;
+  FileResult res;
+  if ((res = file_create(g_allocScratch, path, FileMode_Open, FileAccess_Read, &file))) {
+    return res;
+  }
+  const FileInfo info = file_stat_sync(file);
+
+  thread_mutex_lock(idx->mutex);
+  const bool found = checksum_lookup(idx, id, &info, out);
+  if (found) {
+    checksum_track(idx, true /* indexed */);
+  }
+  thread_mutex_unlock(idx->mutex);
+
+  if (!found && !(res = file_crc_32_sync(file, out))) {
+    thread_mutex_lock(idx->mutex);
+    checksum_track(idx, false /* indexed */);
+    if (!checksum_racy(&info)) {
+      checksum_store(idx, id, &info, *out);
+    }
+    thread_mutex_unlock(idx->mutex);
+  }
+  file_destroy(file);
+  return res;
+}
+
+void asset_checksum_index_invalidate(AssetChecksumIndex* idx, const String id) {
+  const AssetChecksumEntry key = {.idHash = string_hash(id)};
+
+  thread_mutex_lock(idx->mutex);
+  AssetChecksumEntry* entry =
+      dynarray_search_binary(&idx->reg.entries, checksum_compare_entry, &key);
+  if (entry) {
+    const usize index = entry - dynarray_begin_t(&idx->reg.entries, AssetChecksumEntry);
+    dynarray_remove(&idx->reg.entries, index, 1);
+    idx->dirty = true;
+  }
+  thread_mutex_unlock(idx->mutex);
+}
+
+AssetChecksumIndexStats asset_checksum_index_stats(AssetChecksumIndex* idx) {
+  thread_mutex_lock(idx->mutex);
+  const AssetChecksumIndexStats res = {
+      .hashed  = idx->countHashed,
+      .indexed = idx->countIndexed,
+      .entries = (u32)idx->reg.entries.size,
+  };
+  thread_mutex_unlock(idx->mutex);
+  return res;
+}
+
+void asset_checksum_index_maintain(AssetChecksumIndex* idx) {
+  const TimeSteady now        = time_steady_clock();
+  DynString        blobBuffer = dynstring_create(idx->alloc, 0);
+
+  thread_mutex_lock(idx->mutex);
+  const bool requested = idx->countHashed || idx->countIndexed;
+  const bool settled   = time_steady_duration(idx->lastRequest, now) >= asset_checksum_index_settle;
+  if (requested && settled && !idx->statsLogged) {
+    checksum_log_stats(idx);
+  }
+  const bool save =
+      idx->dirty && time_steady_duration(idx->lastSave, now) >= asset_checksum_index_save_interval;
+  if (save) {
+    checksum_serialize(idx, &blobBuffer);
+  }
+  thread_mutex_unlock(idx->mutex);
+
+  if (save) {
+    checksum_save(idx, &blobBuffer); // NOTE: Written outside of the lock to avoid stalling lookups.
+  }
+  dynstring_destroy(&blobBuffer);
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "core/file.h"
+#include "core/string.h"
+#include "data/registry.h"
+
+/**
+ * Persistent index of source file checksums.
+ *
+ * Maps the (id, file-id, size, modification-time) of a source file to its crc32 (ISO 3309)
+ * checksum, which allows skipping the checksum computation (reading the whole file) for files that
+ * have not changed since the last time they were checksummed.
+ * Stored as '{rootPath}/.cache/checksums.blob' next to the cache registry.
+ *
+ * NOTE: Api is thread-safe.
+ */
+typedef struct sAssetChecksumIndex AssetChecksumIndex;
+
+typedef struct {
+  u32 hashed;  // Amount of checksums that were computed.
+  u32 indexed; // Amount of checksums that were retrieved from the index.
+  u32 entries;
+} AssetChecksumIndexStats;
+
+extern DataMeta g_assetChecksumIndexMeta;
+
+/**
+ * Open (or create) the checksum index in the '{rootPath}/.cache' directory.
+ * Should be destroyed using 'asset_checksum_index_destroy()'.
+ */
+AssetChecksumIndex* asset_checksum_index_create(Allocator*, String rootPath);
+
+/**
+ * Destroy the index.
+ * NOTE: Persists the index when it has been modified.
+ */
+void asset_checksum_index_destroy(AssetChecksumIndex*);
+
+/**
+ * Retrieve the checksum of an opened file; 'data' is only read when the index has no valid entry.
+ */
+u32 asset_checksum_index_data(AssetChecksumIndex*, String id, const FileInfo*, String data);
+
+/**
+ * Retrieve the checksum of the file with the given id (relative to the root path).
+ */
+FileResult asset_checksum_index_path(AssetChecksumIndex*, String id, u32* out);
+
+/**
+ * Remove the entry for the given id, for example because the file was reported as modified.
+ */
+void asset_checksum_index_invalidate(AssetChecksumIndex*, String id);
+
+/**
+ * Retrieve statistics about the index usage.
+ */
+AssetChecksumIndexStats asset_checksum_index_stats(AssetChecksumIndex*);
+
+/**
+ * Periodic maintenance; persists the index (at most once per interval) when it has been modified
+ * and logs the statistics once the initial burst of checksum requests has settled.
+ * NOTE: Performs file io, should be called from a background thread.
+ */
+void asset_checksum_index_maintain(AssetChecksumIndex*);
@@ -278,6 +278,7 @@ void asset_data_init(const bool devSupport) {
     asset_data_init_arraytex();
     asset_data_init_atlas();
     asset_data_init_cache();
+    asset_data_init_checksum();
     asset_data_init_decal();
     asset_data_init_fonttex();
     asset_data_init_graphic();
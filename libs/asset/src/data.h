@@ -5,6 +5,7 @@
 void asset_data_init_arraytex(void);
 void asset_data_init_atlas(void);
 void asset_data_init_cache(void);
+void asset_data_init_checksum(void);
 void asset_data_init_decal(void);
 void asset_data_init_fonttex(void);
 void asset_data_init_graphic(void);
@@ -495,7 +495,7 @@ bool asset_import_eval(
     ctx.prog   = script->program;
     ctx.progId = script->assetId;
 
-    const ScriptProgResult evalRes = script_prog_eval(script->program, null, binder, &ctx);
+    const ScriptProgResult evalRes = script_prog_eval(script->program, null, null, binder, &ctx);
     if (UNLIKELY(evalRes.panic.kind)) {
       const String msg            = script_panic_scratch(&evalRes.panic, ScriptPanicOutput_Default);
       const String scriptRangeStr = fmt_write_scratch(
@@ -25,6 +25,8 @@ static void import_init_enum_flags(void) {
   ENUM_PUSH(&g_importTextureFlags, Linear);
   ENUM_PUSH(&g_importTextureFlags, Mips);
   ENUM_PUSH(&g_importTextureFlags, BroadcastR);
+  ENUM_PUSH(&g_importTextureFlags, HighQuality);
+  ENUM_PUSH(&g_importTextureFlags, NormalMap);
 
 #undef ENUM_PUSH
 }
@@ -76,18 +78,6 @@ static f32 import_texture_clamp01(const f32 val) {
   return val;
 }
 
-typedef struct {
-  AssetImportTextureFlags flags;
-  AssetImportTextureFlip  flip;
-  u32                     width, height, layers;
-  u32                     mips; // 0 indicates maximum number of mips.
-  u32                     channels;
-  AssetTextureType        type;
-  Mem                     data;
-  u32                     dataWidth, dataHeight, dataChannels;
-  AssetTextureType        dataType;
-} AssetImportTexture;
-
 static ScriptVal import_eval_pow2_test(AssetImportContext* ctx, ScriptBinderCall* call) {
   (void)ctx;
   const f64 val = script_arg_num(call, 0);
@@ -364,7 +354,7 @@ void asset_data_init_import_texture(const bool devSupport) {
   script_binder_filter_set(binder, string_lit("import/texture/*.script"));
 
   // clang-format off
-  static const String g_flagsDoc     = string_static("Supported flags:\n\n-`Lossless`\n\n-`Linear`\n\n-`Mips`\n\n-`BroadcastR`");
+  static const String g_flagsDoc     = string_static("Supported flags:\n\n-`Lossless`\n\n-`Linear`\n\n-`Mips`\n\n-`BroadcastR`\n\n-`HighQuality`\n\n-`NormalMap`");
   static const String g_pixelTypeDoc = string_static("Supported types:\n\n-`u8`\n\n-`u16`\n\n-`f32`");
   {
     const String       name   = string_lit("pow2_test");
@@ -534,13 +524,29 @@ bool asset_import_texture(
     const AssetImportTextureFlip  importFlip,
     AssetTextureComp*             out) {
 
-  Mem  outMem       = data;
-  bool outMemOwning = false;
-  bool success      = false;
+  AssetImportTexture import;
+  if (!asset_import_texture_eval(
+          env, id, data, width, height, channels, type, importFlags, importFlip, &import)) {
+    return false;
+  }
+  return asset_import_texture_apply(&import, out);
+}
+
+bool asset_import_texture_eval(
+    const AssetImportEnvComp*     env,
+    const String                  id,
+    const Mem                     data,
+    const u32                     width,
+    const u32                     height,
+    const u32                     channels,
+    const AssetTextureType        type,
+    const AssetImportTextureFlags importFlags,
+    const AssetImportTextureFlip  importFlip,
+    AssetImportTexture*           out) {
 
   diag_assert(data.size == width * height * channels * import_texture_type_size(type));
 
-  AssetImportTexture ctx = {
+  *out = (AssetImportTexture){
       .flags        = importFlags,
       .flip         = importFlip,
       .width        = width,
@@ -554,57 +560,83 @@ bool asset_import_texture(
       .dataChannels = channels,
       .dataType     = type,
   };
-  if (!asset_import_eval(env, g_assetScriptImportTextureBinder, id, &ctx)) {
-    goto Ret;
-  }
+  return asset_import_eval(env, g_assetScriptImportTextureBinder, id, out);
+}
+
+bool asset_import_texture_apply(const AssetImportTexture* ctx, AssetTextureComp* out) {
+  const Mem              data     = ctx->data;
+  const u32              width    = ctx->dataWidth;
+  const u32              height   = ctx->dataHeight;
+  const u32              channels = ctx->dataChannels;
+  const AssetTextureType type     = ctx->dataType;
+
+  Mem  outMem       = data;
+  bool outMemOwning = false;
+  bool success      = false;
 
   // Apply resize.
-  if (ctx.width != width || ctx.height != height || ctx.channels != channels || ctx.type != type) {
-    const u32   dstPixelCount = ctx.width * ctx.height;
-    const usize dstTypeSize   = import_texture_type_size(ctx.type);
+  if (ctx->width != width || ctx->height != height || ctx->channels != channels ||
+      ctx->type != type) {
+    const u32   dstPixelCount = ctx->width * ctx->height;
+    const usize dstTypeSize   = import_texture_type_size(ctx->type);
 
-    outMem = alloc_alloc(g_allocHeap, dstPixelCount * ctx.channels * dstTypeSize, dstTypeSize);
+    outMem = alloc_alloc(g_allocHeap, dstPixelCount * ctx->channels * dstTypeSize, dstTypeSize);
     outMemOwning = true;
 
     asset_texture_convert(
-        data, width, height, channels, type, outMem, ctx.width, ctx.height, ctx.channels, ctx.type);
+        data,
+        width,
+        height,
+        channels,
+        type,
+        outMem,
+        ctx->width,
+        ctx->height,
+        ctx->channels,
+        ctx->type);
   }
 
   // Apply flip.
-  if (ctx.flip & AssetImportTextureFlip_Y) {
-    asset_texture_flip_y(outMem, ctx.width, ctx.height, ctx.channels, ctx.type);
+  if (ctx->flip & AssetImportTextureFlip_Y) {
+    asset_texture_flip_y(outMem, ctx->width, ctx->height, ctx->channels, ctx->type);
   }
 
   AssetTextureFlags outFlags = 0;
-  if (ctx.flags & AssetImportTextureFlags_Mips) {
+  if (ctx->flags & AssetImportTextureFlags_Mips) {
     outFlags |= AssetTextureFlags_GenerateMips;
   }
-  if (ctx.flags & AssetImportTextureFlags_Linear) {
+  if (ctx->flags & AssetImportTextureFlags_Linear) {
     // Explicitly linear.
-  } else if (ctx.channels >= 3 && ctx.type == AssetTextureType_u8) {
+  } else if (ctx->channels >= 3 && ctx->type == AssetTextureType_u8) {
     outFlags |= AssetTextureFlags_Srgb;
   }
-  if (ctx.flags & AssetImportTextureFlags_Lossless) {
+  if (ctx->flags & AssetImportTextureFlags_Lossless) {
     outFlags |= AssetTextureFlags_Lossless;
   }
-  if (ctx.flags & AssetImportTextureFlags_BroadcastR) {
+  if (ctx->flags & AssetImportTextureFlags_BroadcastR) {
     outFlags |= AssetTextureFlags_BroadcastR;
   }
+  if (ctx->flags & AssetImportTextureFlags_HighQuality) {
+    outFlags |= AssetTextureFlags_HighQuality;
+  }
+  if (ctx->flags & AssetImportTextureFlags_NormalMap) {
+    outFlags |= AssetTextureFlags_NormalMap;
+  }
 
-  if (outFlags & AssetTextureFlags_Srgb && ctx.channels < 3) {
+  if (outFlags & AssetTextureFlags_Srgb && ctx->channels < 3) {
     goto Ret;
   }
 
   // Output texture.
   *out = asset_texture_create(
       outMem,
-      ctx.width,
-      ctx.height,
-      ctx.channels,
-      ctx.layers,
+      ctx->width,
+      ctx->height,
+      ctx->channels,
+      ctx->layers,
       1 /* mipsSrc */,
-      ctx.mips,
-      ctx.type,
+      ctx->mips,
+      ctx->type,
       outFlags);
 
   success = true;
@@ -3,11 +3,13 @@
 #include "loader_texture.h"
 
 typedef enum {
-  AssetImportTextureFlags_None       = 0,
-  AssetImportTextureFlags_Lossless   = 1 << 0,
-  AssetImportTextureFlags_Linear     = 1 << 1,
-  AssetImportTextureFlags_Mips       = 1 << 2,
-  AssetImportTextureFlags_BroadcastR = 1 << 3,
+  AssetImportTextureFlags_None        = 0,
+  AssetImportTextureFlags_Lossless    = 1 << 0,
+  AssetImportTextureFlags_Linear      = 1 << 1,
+  AssetImportTextureFlags_Mips        = 1 << 2,
+  AssetImportTextureFlags_BroadcastR  = 1 << 3,
+  AssetImportTextureFlags_HighQuality = 1 << 4,
+  AssetImportTextureFlags_NormalMap   = 1 << 5,
 } AssetImportTextureFlags;
 
 typedef enum {
@@ -15,6 +17,21 @@ typedef enum {
   AssetImportTextureFlip_Y    = 1 << 0,
 } AssetImportTextureFlip;
 
+typedef struct {
+  AssetImportTextureFlags flags;
+  AssetImportTextureFlip  flip;
+  u32                     width, height, layers;
+  u32                     mips; // 0 indicates maximum number of mips.
+  u32                     channels;
+  AssetTextureType        type;
+  Mem                     data;
+  u32                     dataWidth, dataHeight, dataChannels;
+  AssetTextureType        dataType;
+} AssetImportTexture;
+
+/**
+ * Import a texture; evaluates the import scripts and then applies the result.
+ */
 bool asset_import_texture(
     const AssetImportEnvComp*,
     String id,
@@ -26,3 +43,22 @@ bool asset_import_texture(
     AssetImportTextureFlags,
     AssetImportTextureFlip,
     AssetTextureComp* out);
+
+/**
+ * Split version of 'asset_import_texture()' to allow applying the (expensive) import on a different
+ * thread; only the script evaluation requires access to the import environment.
+ * NOTE: The data is referenced by the output import and has to stay alive until it's applied.
+ */
+bool asset_import_texture_eval(
+    const AssetImportEnvComp*,
+    String id,
+    Mem    data /* NOTE: May be modified during the import process. */,
+    u32    width,
+    u32    height,
+    u32    channels,
+    AssetTextureType,
+    AssetImportTextureFlags,
+    AssetImportTextureFlip,
+    AssetImportTexture* out);
+
+bool asset_import_texture_apply(const AssetImportTexture*, AssetTextureComp* out);
@@ -60,6 +60,9 @@ static u32 asset_script_prog_hash(const ScriptProgram* prog) {
   for (u32 i = 0; i != prog->literals.count; ++i) {
     hash = bits_hash_32_combine(hash, script_hash(prog->literals.values[i]));
   }
+  for (u32 i = 0; i != prog->memKeys.count; ++i) {
+    hash = bits_hash_32_combine(hash, prog->memKeys.values[i]);
+  }
   return hash;
 }
 
@@ -163,6 +166,7 @@ void asset_data_init_script(void) {
   data_reg_field_t(g_dataReg, ScriptProgram, code, data_prim_t(DataMem), .flags = DataFlags_ExternalMemory);
   data_reg_field_t(g_dataReg, ScriptProgram, binderHash, data_prim_t(u64));
   data_reg_field_t(g_dataReg, ScriptProgram, literals, t_ScriptVal, .container = DataContainer_HeapArray);
+  data_reg_field_t(g_dataReg, ScriptProgram, memKeys, data_prim_t(u32), .container = DataContainer_HeapArray);
   data_reg_field_t(g_dataReg, ScriptProgram, locations, t_ScriptProgramLoc, .container = DataContainer_HeapArray);
 
   data_reg_enum_t(g_dataReg, AssetScriptDomain);
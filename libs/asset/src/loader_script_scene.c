@@ -37,6 +37,7 @@ void asset_data_init_script_scene(const bool devSupport) {
   static const String g_healthStatsDoc     = string_static("Supported stats:\n\n-`DealtDamage`\n\n-`DealtHealing`\n\n-`Kills`");
   static const String g_targetExcludeDoc   = string_static("Supported options:\n\n-`Unreachable`\n\n-`Obscured`");
   static const String g_clockDoc           = string_static("Supported clocks:\n\n-`LevelTime` (default)\n\n-`Time`\n\n-`RealTime`\n\n-`Delta`\n\n-`RealDelta`\n\n-`Ticks`");
+  static const String g_wakeEventDoc       = string_static("Supported wake events:\n\n-`Damage`\n\n-`TargetChange`\n\n-`Arrival`");
   static const String g_navLayerDoc        = string_static("Supported layers:\n\n-`Normal` (default)\n\n-`Large`");
   static const String g_navFindTypeDoc     = string_static("Supported types:\n\n-`ClosestCell` (default)\n\n-`UnblockedCell`\n\n-`FreeCell`");
   static const String g_markerTypeDoc      = string_static("Supported types:\n\n-`Info`\n\n-`Danger`\n\n-`Goal`");
@@ -154,6 +155,16 @@ void asset_data_init_script_scene(const bool devSupport) {
     };
     bind(binder, name, doc, ret, args, array_elems(args));
   }
+  {
+    const String       name   = string_lit("sleep");
+    const String       doc    = fmt_write_scratch("Suspend evaluation of the current script for the given duration; can be used to evaluate scripts at a lower rate than the frame-rate.\n\n*Note*: The wake-time is staggered per entity to spread the evaluations over the frames.\n\n*Note*: Has to be called every evaluation; the script is evaluated every frame otherwise.\n\n*Note*: Changing properties of the entity (for example through 'tell') wakes the script.\n\n{}", fmt_text(g_wakeEventDoc));
+    const ScriptMask   ret    = script_mask_null;
+    const ScriptSigArg args[] = {
+        {string_lit("duration"), script_mask_time},
+        {string_lit("wakeEvents"), script_mask_str | script_mask_null, ScriptSigArgFlags_Multi},
+    };
+    bind(binder, name, doc, ret, args, array_elems(args));
+  }
   {
     const String       name   = string_lit("set");
     const String       doc    = string_lit("Change or query if the target entity is contained in the given set.");
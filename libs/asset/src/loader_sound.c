@@ -55,7 +55,12 @@ ecs_module_init(asset_sound_module) {
 
 void asset_data_init_sound(void) {
   // clang-format off
+  data_reg_enum_t(g_dataReg, AssetSoundFormat);
+  data_reg_const_t(g_dataReg, AssetSoundFormat, i16);
+  data_reg_const_t(g_dataReg, AssetSoundFormat, Adpcm);
+
   data_reg_struct_t(g_dataReg, AssetSoundComp);
+  data_reg_field_t(g_dataReg, AssetSoundComp, format, t_AssetSoundFormat);
   data_reg_field_t(g_dataReg, AssetSoundComp, frameChannels, data_prim_t(u8), .flags = DataFlags_NotEmpty);
   data_reg_field_t(g_dataReg, AssetSoundComp, frameCount, data_prim_t(u32), .flags = DataFlags_NotEmpty);
   data_reg_field_t(g_dataReg, AssetSoundComp, frameRate, data_prim_t(u32), .flags = DataFlags_NotEmpty);
@@ -1,6 +1,8 @@
 #include "asset/sound.h"
+#include "core/adpcm.h"
 #include "core/alloc.h"
 #include "core/array.h"
+#include "core/diag.h"
 #include "core/dynarray.h"
 #include "ecs/entity.h"
 #include "ecs/world.h"
@@ -13,11 +15,14 @@
  * Only a single continuous block of LPCM (linear pulse-code modulation) samples are supported.
  * Wav: https://en.wikipedia.org/wiki/WAV
  * Riff: https://en.wikipedia.org/wiki/Resource_Interchange_File_Format
+ *
+ * Samples are stored as 16 bit pcm, long sounds (eg. music) are compressed to 4 bit ima adpcm.
  */
 
 #define wav_channels_max 2
 #define wav_frames_min 64
 #define wav_frames_max (1024 * 1024 * 64)
+#define wav_adpcm_seconds_min 10
 
 typedef struct {
   String tag;
@@ -173,40 +178,57 @@ wav_read_frame_count(const WavFormat format, DynArray* chunks, u32* outFrameCoun
   *outFrameCount = (u32)chunk->data.size / format.frameSize;
 }
 
-static void wav_read_samples(
-    const WavFormat format,
-    DynArray*       chunks,
-    const u32       frameCount,
-    f32*            outSamples,
-    WavError*       err) {
+static AssetSoundFormat wav_sound_format(const WavFormat format, const u32 frameCount) {
+  const bool isLong = frameCount >= format.frameRate * wav_adpcm_seconds_min;
+  return isLong ? AssetSoundFormat_Adpcm : AssetSoundFormat_i16;
+}
+
+static Mem wav_read_samples(
+    const WavFormat        format,
+    DynArray*              chunks,
+    const u32              frameCount,
+    const AssetSoundFormat soundFormat,
+    WavError*              err) {
   WavChunk* chunk = wav_chunk(chunks, string_lit("data"));
   if (UNLIKELY(!chunk)) {
     *err = WavError_DataChunkMissing;
-    return;
+    return mem_empty;
   }
   if (format.sampleDepth != 16) {
     *err = WavError_SampleDepthUnsupported;
-    return;
+    return mem_empty;
   }
-  static const f32 g_i16MaxInv = 1.0f / i16_max;
   // Assumes the host system is using little-endian byte-order and 2's complement integers.
-  i16*      data        = chunk->data.ptr;
-  const u32 sampleCount = frameCount * format.channels;
-  for (u32 i = 0; i != sampleCount; ++i) {
-    outSamples[i] = (f32)data[i] * g_i16MaxInv;
+  const i16* data = chunk->data.ptr;
+  switch (soundFormat) {
+  case AssetSoundFormat_i16: {
+    const usize size = sizeof(i16) * frameCount * format.channels;
+    const Mem   res  = alloc_alloc(g_allocHeap, size, alignof(i16));
+    mem_cpy(res, mem_create(data, size));
+    return res;
+  }
+  case AssetSoundFormat_Adpcm: {
+    const usize size = adpcm_block_size(format.channels) * adpcm_block_count(frameCount);
+    const Mem   res  = alloc_alloc(g_allocHeap, size, 1);
+    adpcm_encode(data, frameCount, format.channels, res);
+    return res;
+  }
   }
+  diag_crash();
 }
 
 static void wav_load_succeed(
-    EcsWorld*         world,
-    const EcsEntityId entity,
-    const WavFormat   format,
-    const u32         frameCount,
-    const Mem         sampleMem) {
+    EcsWorld*              world,
+    const EcsEntityId      entity,
+    const WavFormat        format,
+    const u32              frameCount,
+    const AssetSoundFormat soundFormat,
+    const Mem              sampleMem) {
   AssetSoundComp* soundComp = ecs_world_add_t(
       world,
       entity,
       AssetSoundComp,
+      .format        = soundFormat,
       .frameChannels = (u8)format.channels,
       .frameCount    = frameCount,
       .frameRate     = format.frameRate,
@@ -271,14 +293,14 @@ void asset_load_sound_wav(
     asset_mark_load_failure(world, entity, id, wav_error_str(err), (i32)err);
     goto End;
   }
-  sampleMem = alloc_alloc(g_allocHeap, sizeof(f32) * frameCount * format.channels, alignof(f32));
-  wav_read_samples(format, &chunks, frameCount, sampleMem.ptr, &err);
+  const AssetSoundFormat soundFormat = wav_sound_format(format, frameCount);
+  sampleMem = wav_read_samples(format, &chunks, frameCount, soundFormat, &err);
   if (err) {
     asset_mark_load_failure(world, entity, id, wav_error_str(err), (i32)err);
     goto End;
   }
 
-  wav_load_succeed(world, entity, format, frameCount, sampleMem);
+  wav_load_succeed(world, entity, format, frameCount, soundFormat, sampleMem);
   sampleMem = mem_empty; // Moved into the result component, which will take ownership.
 
 End:
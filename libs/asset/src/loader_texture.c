@@ -12,6 +12,9 @@
 #include "ecs/utils.h"
 #include "ecs/view.h"
 #include "ecs/world.h"
+#include "jobs/executor.h"
+#include "jobs/graph.h"
+#include "jobs/scheduler.h"
 
 #include "import.h"
 #include "loader_texture.h"
@@ -69,6 +72,7 @@ DataMeta g_assetTexMeta;
 
 ecs_comp_define(AssetTextureComp);
 ecs_comp_define(AssetTextureSourceComp);
+ecs_comp_define(AssetTextureDirtyComp);
 
 static void ecs_destruct_texture_comp(void* data) {
   AssetTextureComp* comp = data;
@@ -80,6 +84,18 @@ static void ecs_destruct_texture_source_comp(void* data) {
   asset_repo_close(comp->src);
 }
 
+static void ecs_combine_texture_dirty(void* dataA, void* dataB) {
+  AssetTextureDirtyComp* compA = dataA;
+  AssetTextureDirtyComp* compB = dataB;
+
+  const u32 maxX = math_max(compA->x + compA->width, compB->x + compB->width);
+  const u32 maxY = math_max(compA->y + compA->height, compB->y + compB->height);
+  compA->x       = math_min(compA->x, compB->x);
+  compA->y       = math_min(compA->y, compB->y);
+  compA->width   = maxX - compA->x;
+  compA->height  = maxY - compA->y;
+}
+
 static u32 tex_type_size(const AssetTextureType type) {
   switch (type) {
   case AssetTextureType_u8:
@@ -120,6 +136,8 @@ static bool tex_format_bc4x4(const AssetTextureFormat format) {
   case AssetTextureFormat_Bc1:
   case AssetTextureFormat_Bc3:
   case AssetTextureFormat_Bc4:
+  case AssetTextureFormat_Bc5:
+  case AssetTextureFormat_Bc7:
     return true;
   default:
     return false;
@@ -137,6 +155,8 @@ static u32 tex_format_channels(const AssetTextureFormat format) {
       [AssetTextureFormat_Bc1]      = 3,
       [AssetTextureFormat_Bc3]      = 4,
       [AssetTextureFormat_Bc4]      = 1,
+      [AssetTextureFormat_Bc5]      = 2,
+      [AssetTextureFormat_Bc7]      = 4,
   };
   return g_channels[format];
 }
@@ -152,6 +172,8 @@ static usize tex_format_stride(const AssetTextureFormat format) {
       [AssetTextureFormat_Bc1]      = sizeof(Bc1Block),
       [AssetTextureFormat_Bc3]      = sizeof(Bc3Block),
       [AssetTextureFormat_Bc4]      = sizeof(Bc4Block),
+      [AssetTextureFormat_Bc5]      = sizeof(Bc5Block),
+      [AssetTextureFormat_Bc7]      = sizeof(Bc7Block),
   };
   return g_stride[format];
 }
@@ -301,13 +323,25 @@ static AssetTextureFormat tex_format_pick(
     const u32              height,
     const u32              channels,
     const bool             hasAlpha,
-    const bool             lossless) {
+    const bool             lossless,
+    const bool             highQuality,
+    const bool             normalMap) {
   switch (type) {
   case AssetTextureType_u8: {
     const bool compress = !lossless && tex_can_compress_u8(width, height);
     if (channels <= 1) {
       return compress ? AssetTextureFormat_Bc4 : AssetTextureFormat_u8_r;
     }
+    if (channels == 2 || (compress && normalMap)) {
+      /**
+       * Normal maps only store x and y, z is reconstructed when sampling (the normals are unit
+       * length and point out of the surface). Gives two independent (higher quality) channels.
+       */
+      return compress ? AssetTextureFormat_Bc5 : AssetTextureFormat_u8_rgba;
+    }
+    if (compress && highQuality) {
+      return AssetTextureFormat_Bc7;
+    }
     if (channels <= 3 || !hasAlpha) {
       return compress ? AssetTextureFormat_Bc1 : AssetTextureFormat_u8_rgba;
     }
@@ -389,6 +423,12 @@ static usize tex_bc_encode_block(const Bc0Block* b, const AssetTextureFormat fmt
   case AssetTextureFormat_Bc4:
     bc4_encode(b, (Bc4Block*)outPtr);
     return sizeof(Bc4Block);
+  case AssetTextureFormat_Bc5:
+    bc5_encode(b, (Bc5Block*)outPtr);
+    return sizeof(Bc5Block);
+  case AssetTextureFormat_Bc7:
+    bc7_encode(b, (Bc7Block*)outPtr);
+    return sizeof(Bc7Block);
   default:
     diag_crash();
   }
@@ -442,38 +482,196 @@ static void tex_load_u8(
   diag_assert(mem_from_to(in.ptr, inPtr).size == in.size);
 }
 
+#define tex_compress_mips_max 16
+#define tex_compress_task_blocks_min 1024 // Minimum amount of blocks to encode per task.
+#define tex_compress_mip_tasks_max 64     // Maximum amount of tasks per mip level.
+
+/**
+ * Block compression is split into tasks that each encode a band of block rows (of all layers).
+ * When the job system is available the tasks are executed in parallel, and when generating mips a
+ * band of mip N+1 only depends on the bands of mip N that it down-samples from.
+ */
+typedef struct {
+  AssetTextureComp* tex;
+  const u8*         in;
+  u32               inChannels, inMips;
+  Bc0Block*         blocks; // Extracted blocks of all mips; only needed when generating mips.
+  usize             inOffset[tex_compress_mips_max];
+  usize             outOffset[tex_compress_mips_max];
+  usize             blockOffset[tex_compress_mips_max];
+} TexCompressCtx;
+
+typedef struct {
+  const TexCompressCtx* ctx;
+  u32                   mip, rowBegin, rowEnd; // Row indices span all layers.
+} TexCompressTask;
+
+static u32 tex_blocks_x(const AssetTextureComp* tex, const u32 mip) {
+  return math_max((tex->width >> mip) / 4, 1);
+}
+
+static u32 tex_blocks_y(const AssetTextureComp* tex, const u32 mip) {
+  return math_max((tex->height >> mip) / 4, 1);
+}
+
+static void tex_compress_downsample(
+    const Bc0Block* src, const u32 srcCountX, const u32 srcCountY, const u32 x, const u32 y,
+    Bc0Block* out) {
+  for (u32 pY = 0; pY != 4; ++pY) {
+    for (u32 pX = 0; pX != 4; ++pX) {
+      // Fill the 4x4 block by down-sampling from 4 blocks of the previous mip.
+      const u32       srcBlockY = math_min(y * 2 + (pY >= 2), srcCountY - 1);
+      const u32       srcBlockX = math_min(x * 2 + (pX >= 2), srcCountX - 1);
+      const Bc0Block* srcBlock  = &src[srcBlockY * srcCountX + srcBlockX];
+      const u32       srcX      = (pX % 2) * 2;
+      const u32       srcY      = (pY % 2) * 2;
+
+      const BcColor8888 c0 = srcBlock->colors[srcY * 4 + srcX];
+      const BcColor8888 c1 = srcBlock->colors[srcY * 4 + srcX + 1];
+      const BcColor8888 c2 = srcBlock->colors[(srcY + 1) * 4 + srcX];
+      const BcColor8888 c3 = srcBlock->colors[(srcY + 1) * 4 + srcX + 1];
+
+      out->colors[pY * 4 + pX] = tex_bc0_color_avg(c0, c1, c2, c3);
+    }
+  }
+}
+
+static void tex_compress_task(const void* data) {
+  const TexCompressTask*  task = data;
+  const TexCompressCtx*   ctx  = task->ctx;
+  const AssetTextureComp* tex  = ctx->tex;
+
+  const u32   mip       = task->mip;
+  const u32   mipWidth  = math_max(tex->width >> mip, 1);
+  const u32   mipHeight = math_max(tex->height >> mip, 1);
+  const u32   countX    = tex_blocks_x(tex, mip);
+  const u32   countY    = tex_blocks_y(tex, mip);
+  const usize stride    = tex_format_stride(tex->format);
+
+  u8* restrict outPtr = bits_ptr_offset(
+      tex->pixelData.ptr, ctx->outOffset[mip] + (usize)task->rowBegin * countX * stride);
+
+  Bc0Block block;
+  for (u32 row = task->rowBegin; row != task->rowEnd; ++row) {
+    const u32 layer = row / countY;
+    const u32 y     = row % countY;
+    Bc0Block* store = ctx->blocks ? &ctx->blocks[ctx->blockOffset[mip] + row * countX] : null;
+
+    for (u32 x = 0; x != countX; ++x) {
+      Bc0Block* b = store ? &store[x] : &block;
+      if (mip < ctx->inMips) {
+        const usize inLayerOffset = (usize)layer * mipWidth * mipHeight * ctx->inChannels;
+        const usize inRowOffset   = (usize)y * mipWidth * 4 * ctx->inChannels;
+        const u8*   inPtr         = ctx->in + ctx->inOffset[mip] + inLayerOffset + inRowOffset;
+        bc0_extract(inPtr + x * 4 * ctx->inChannels, ctx->inChannels, mipWidth, b);
+      } else {
+        const u32       srcCountX = tex_blocks_x(tex, mip - 1);
+        const u32       srcCountY = tex_blocks_y(tex, mip - 1);
+        const usize     srcLayer  = (usize)layer * srcCountX * srcCountY;
+        const Bc0Block* src       = &ctx->blocks[ctx->blockOffset[mip - 1] + srcLayer];
+        tex_compress_downsample(src, srcCountX, srcCountY, x, y, b);
+      }
+      outPtr += tex_bc_encode_block(b, tex->format, outPtr);
+    }
+  }
+}
+
+static void tex_compress(const TexCompressCtx* ctx) {
+  const AssetTextureComp* tex  = ctx->tex;
+  const u32               mips = tex->mipsData;
+  diag_assert(mips <= tex_compress_mips_max);
+
+  u32 bandRows[tex_compress_mips_max], bandCount[tex_compress_mips_max];
+  u32 taskFirst[tex_compress_mips_max], taskCount = 0;
+  for (u32 mip = 0; mip != mips; ++mip) {
+    const u32 rows     = tex_blocks_y(tex, mip) * tex->layers;
+    const u32 blocks   = tex_blocks_x(tex, mip) * rows;
+    const u32 bandsMax = math_min(rows, tex_compress_mip_tasks_max);
+    const u32 bands    = math_max(math_min(blocks / tex_compress_task_blocks_min, bandsMax), 1);
+
+    bandRows[mip]  = (rows + bands - 1) / bands;
+    bandCount[mip] = (rows + bandRows[mip] - 1) / bandRows[mip];
+    taskFirst[mip] = taskCount;
+    taskCount += bandCount[mip];
+  }
+
+  if (!g_jobsIsWorker || g_jobsWorkerCount <= 1 || taskCount <= 1) {
+    // Execute serially; the tasks are ordered such that dependencies are always satisfied.
+    for (u32 mip = 0; mip != mips; ++mip) {
+      const u32 rows = tex_blocks_y(tex, mip) * tex->layers;
+      for (u32 band = 0; band != bandCount[mip]; ++band) {
+        const u32 rowBegin = band * bandRows[mip];
+        const u32 rowEnd   = math_min(rowBegin + bandRows[mip], rows);
+        tex_compress_task(&(TexCompressTask){ctx, mip, rowBegin, rowEnd});
+      }
+    }
+    return;
+  }
+
+  JobGraph* graph = jobs_graph_create(g_allocHeap, string_lit("TextureCompress"), taskCount);
+  for (u32 mip = 0; mip != mips; ++mip) {
+    const u32 countY = tex_blocks_y(tex, mip);
+    const u32 rows   = countY * tex->layers;
+    for (u32 band = 0; band != bandCount[mip]; ++band) {
+      const u32 rowBegin = band * bandRows[mip];
+      const u32 rowEnd   = math_min(rowBegin + bandRows[mip], rows);
+
+      const TexCompressTask taskData = {ctx, mip, rowBegin, rowEnd};
+      const JobTaskId       task     = jobs_graph_add_task(
+          graph,
+          string_lit("compress"),
+          tex_compress_task,
+          mem_var(taskData),
+          JobTaskFlags_BorrowName);
+      diag_assert(task == taskFirst[mip] + band);
+
+      if (mip < ctx->inMips) {
+        continue; // Source mip; no dependencies.
+      }
+      // Depend on the bands of the previous mip that contain the rows we down-sample from.
+      const u32 srcCountY   = tex_blocks_y(tex, mip - 1);
+      const u32 srcRowFirst = (rowBegin / countY) * srcCountY +
+                              math_min((rowBegin % countY) * 2, srcCountY - 1);
+      const u32 srcRowLast = ((rowEnd - 1) / countY) * srcCountY +
+                             math_min(((rowEnd - 1) % countY) * 2 + 1, srcCountY - 1);
+      const u32 srcBandFirst = srcRowFirst / bandRows[mip - 1];
+      const u32 srcBandLast  = srcRowLast / bandRows[mip - 1];
+      for (u32 srcBand = srcBandFirst; srcBand <= srcBandLast; ++srcBand) {
+        jobs_graph_task_depend(graph, (JobTaskId)(taskFirst[mip - 1] + srcBand), task);
+      }
+    }
+  }
+  jobs_scheduler_wait_help(jobs_scheduler_run(graph, g_allocHeap));
+  jobs_graph_destroy(graph);
+}
+
 static void tex_load_u8_compress(
     AssetTextureComp* tex,
     const Mem         in,
     const u32         inChannels,
     const u32         inLayers,
     const u32         inMips) {
+  (void)inLayers;
 
   diag_assert(inLayers == tex->layers);
+  diag_assert(inMips == tex->mipsData);
   diag_assert(tex_format_bc4x4(tex->format));
   diag_assert(!(tex->flags & AssetTextureFlags_Lossless));
   diag_assert(bits_aligned(tex->width, 4));
   diag_assert(bits_aligned(tex->height, 4));
-
-  const u8* restrict inPtr = in.ptr;
   diag_assert(in.size == tex_pixel_count(tex->width, tex->height, inLayers, inMips) * inChannels);
 
-  u8* restrict outPtr = tex->pixelData.ptr;
-
-  Bc0Block block;
+  TexCompressCtx ctx = {
+      .tex        = tex,
+      .in         = in.ptr,
+      .inChannels = inChannels,
+      .inMips     = inMips,
+  };
   for (u32 mip = 0; mip != inMips; ++mip) {
-    const u32 mipWidth  = math_max(tex->width >> mip, 1);
-    const u32 mipHeight = math_max(tex->height >> mip, 1);
-    for (u32 l = 0; l != inLayers; ++l) {
-      for (u32 y = 0; y < mipHeight; y += 4, inPtr += mipWidth * 4 * inChannels) {
-        for (u32 x = 0; x < mipWidth; x += 4) {
-          bc0_extract(inPtr + x * inChannels, inChannels, mipWidth, &block);
-          outPtr += tex_bc_encode_block(&block, tex->format, outPtr);
-        }
-      }
-    }
+    ctx.inOffset[mip]  = tex_pixel_count(tex->width, tex->height, inLayers, mip) * inChannels;
+    ctx.outOffset[mip] = tex_format_size(tex->format, tex->width, tex->height, inLayers, mip);
   }
-  diag_assert(mem_from_to(in.ptr, inPtr).size == in.size);
+  tex_compress(&ctx);
 }
 
 static void tex_load_u8_compress_gen_mips(
@@ -482,6 +680,7 @@ static void tex_load_u8_compress_gen_mips(
     const u32         inChannels,
     const u32         inLayers,
     const u32         inMips) {
+  (void)inLayers;
   (void)inMips;
 
   diag_assert(inMips <= 1); // Cannot both generate mips and have source mips.
@@ -490,66 +689,27 @@ static void tex_load_u8_compress_gen_mips(
   diag_assert(!(tex->flags & AssetTextureFlags_Lossless));
   diag_assert(bits_aligned(tex->width, 4) && bits_ispow2(tex->width));
   diag_assert(bits_aligned(tex->height, 4) && bits_ispow2(tex->height));
-
-  const u8* restrict inPtr = in.ptr;
   diag_assert(in.size == tex_pixel_count(tex->width, tex->height, inLayers, inMips) * inChannels);
 
-  u8* restrict outPtr = tex->pixelData.ptr;
-
-  const u32   layerBlockCount = (tex->width / 4) * (tex->height / 4);
-  const usize blockBufferSize = inLayers * layerBlockCount * sizeof(Bc0Block);
-  const Mem   blockBuffer     = alloc_alloc(g_allocHeap, blockBufferSize, alignof(Bc0Block));
-
-  Bc0Block* blockPtr = blockBuffer.ptr;
-
-  // Extract 4x4 blocks from the source data and encode mip0.
-  for (u32 l = 0; l != inLayers; ++l) {
-    for (u32 y = 0; y < tex->height; y += 4, inPtr += tex->width * 4 * inChannels) {
-      for (u32 x = 0; x < tex->width; x += 4, ++blockPtr) {
-        bc0_extract(inPtr + x * inChannels, inChannels, tex->width, blockPtr);
-        outPtr += tex_bc_encode_block(blockPtr, tex->format, outPtr);
-      }
-    }
+  TexCompressCtx ctx = {
+      .tex        = tex,
+      .in         = in.ptr,
+      .inChannels = inChannels,
+      .inMips     = 1,
+  };
+  usize blockCount = 0;
+  for (u32 mip = 0; mip != tex->mipsData; ++mip) {
+    ctx.outOffset[mip]   = tex_format_size(tex->format, tex->width, tex->height, inLayers, mip);
+    ctx.blockOffset[mip] = blockCount;
+    blockCount += tex_blocks_x(tex, mip) * tex_blocks_y(tex, mip) * inLayers;
   }
+  const Mem blockBuffer =
+      alloc_alloc(g_allocHeap, blockCount * sizeof(Bc0Block), alignof(Bc0Block));
+  ctx.blocks = blockBuffer.ptr;
 
-  // Down-sample and encode the other mips.
-  for (u32 mip = 1; mip < tex->mipsMax; ++mip) {
-    blockPtr              = blockBuffer.ptr; // Reset the block pointer to the beginning.
-    const u32 blockCountX = math_max((tex->width >> mip) / 4, 1);
-    const u32 blockCountY = math_max((tex->height >> mip) / 4, 1);
-    for (u32 l = 0; l != inLayers; ++l) {
-      for (u32 blockY = 0; blockY != blockCountY; ++blockY) {
-        for (u32 blockX = 0; blockX != blockCountX; ++blockX) {
-          Bc0Block block;
-          // Fill the 4x4 block by down-sampling from 4 blocks of the previous mip.
-          for (u32 y = 0; y != 4; ++y) {
-            for (u32 x = 0; x != 4; ++x) {
-              const u32       srcBlockY = blockY * 2 + (y >= 2);
-              const u32       srcBlockX = blockX * 2 + (x >= 2);
-              const Bc0Block* src       = &blockPtr[srcBlockY * blockCountX * 2 + srcBlockX];
-              const u32       srcX      = (x % 2) * 2;
-              const u32       srcY      = (y % 2) * 2;
-
-              const BcColor8888 c0 = src->colors[srcY * 4 + srcX];
-              const BcColor8888 c1 = src->colors[srcY * 4 + srcX + 1];
-              const BcColor8888 c2 = src->colors[(srcY + 1) * 4 + srcX];
-              const BcColor8888 c3 = src->colors[(srcY + 1) * 4 + srcX + 1];
-
-              block.colors[y * 4 + x] = tex_bc0_color_avg(c0, c1, c2, c3);
-            }
-          }
-          // Save the down-sampled block for use in the next mip.
-          blockPtr[blockY * blockCountX + blockX] = block;
-          // Encode and output this block.
-          outPtr += tex_bc_encode_block(&block, tex->format, outPtr);
-        }
-      }
-      blockPtr += layerBlockCount;
-    }
-  }
+  tex_compress(&ctx);
 
   alloc_free(g_allocHeap, blockBuffer);
-  diag_assert(mem_from_to(in.ptr, inPtr).size == in.size);
 }
 
 static void tex_load_u16(
@@ -658,12 +818,14 @@ ecs_system_define(UnloadTextureAssetSys) {
     const EcsEntityId entity = ecs_view_entity(itr);
     ecs_world_remove_t(world, entity, AssetTextureComp);
     ecs_utils_maybe_remove_t(world, entity, AssetTextureSourceComp);
+    ecs_utils_maybe_remove_t(world, entity, AssetTextureDirtyComp);
   }
 }
 
 ecs_module_init(asset_texture_module) {
   ecs_register_comp(AssetTextureComp, .destructor = ecs_destruct_texture_comp);
   ecs_register_comp(AssetTextureSourceComp, .destructor = ecs_destruct_texture_source_comp);
+  ecs_register_comp(AssetTextureDirtyComp, .combinator = ecs_combine_texture_dirty);
 
   ecs_register_view(UnloadView);
 
@@ -682,6 +844,8 @@ void asset_data_init_tex(void) {
   data_reg_const_t(g_dataReg, AssetTextureFormat, Bc1);
   data_reg_const_t(g_dataReg, AssetTextureFormat, Bc3);
   data_reg_const_t(g_dataReg, AssetTextureFormat, Bc4);
+  data_reg_const_t(g_dataReg, AssetTextureFormat, Bc5);
+  data_reg_const_t(g_dataReg, AssetTextureFormat, Bc7);
 
   data_reg_enum_multi_t(g_dataReg, AssetTextureFlags);
   data_reg_const_t(g_dataReg, AssetTextureFlags, Srgb);
@@ -691,6 +855,8 @@ void asset_data_init_tex(void) {
   data_reg_const_t(g_dataReg, AssetTextureFlags, Alpha);
   data_reg_const_t(g_dataReg, AssetTextureFlags, Lossless);
   data_reg_const_t(g_dataReg, AssetTextureFlags, BroadcastR);
+  data_reg_const_t(g_dataReg, AssetTextureFlags, HighQuality);
+  data_reg_const_t(g_dataReg, AssetTextureFlags, NormalMap);
 
   data_reg_struct_t(g_dataReg, AssetTextureComp);
   data_reg_field_t(g_dataReg, AssetTextureComp, format, t_AssetTextureFormat);
@@ -743,6 +909,11 @@ String asset_texture_format_str(const AssetTextureFormat format) {
       [AssetTextureFormat_u16_rgba] = string_static("u16-rgba"),
       [AssetTextureFormat_f32_r]    = string_static("f32-r"),
       [AssetTextureFormat_f32_rgba] = string_static("f32-rgba"),
+      [AssetTextureFormat_Bc1]      = string_static("bc1"),
+      [AssetTextureFormat_Bc3]      = string_static("bc3"),
+      [AssetTextureFormat_Bc4]      = string_static("bc4"),
+      [AssetTextureFormat_Bc5]      = string_static("bc5"),
+      [AssetTextureFormat_Bc7]      = string_static("bc7"),
   };
   return g_names[format];
 }
@@ -807,13 +978,18 @@ GeoColor asset_texture_at(const AssetTextureComp* t, const u32 layer, const usiz
     goto Ret;
   case AssetTextureFormat_Bc1:
   case AssetTextureFormat_Bc3:
-  case AssetTextureFormat_Bc4: {
+  case AssetTextureFormat_Bc4:
+  case AssetTextureFormat_Bc5:
+  case AssetTextureFormat_Bc7: {
     const usize pixelX = index % t->width, pixelY = index / t->width;
     const usize blockX = pixelX / 4, blockY = pixelY / 4;
     const usize blockIndex   = blockY * (t->width / 4) + blockX;
     const usize indexInBlock = (pixelY % 4) * 4 + (pixelX % 4);
 
+    // NOTE: Single and dual channel formats only write the channels they contain.
     Bc0Block blockBc0;
+    array_for_t(blockBc0.colors, BcColor8888, color) { *color = (BcColor8888){0, 0, 0, 255}; }
+
     switch (t->format) {
     case AssetTextureFormat_Bc1:
       bc1_decode((const Bc1Block*)pixelsMip0 + blockIndex, &blockBc0);
@@ -821,6 +997,12 @@ GeoColor asset_texture_at(const AssetTextureComp* t, const u32 layer, const usiz
     case AssetTextureFormat_Bc3:
       bc3_decode((const Bc3Block*)pixelsMip0 + blockIndex, &blockBc0);
       break;
+    case AssetTextureFormat_Bc5:
+      bc5_decode((const Bc5Block*)pixelsMip0 + blockIndex, &blockBc0);
+      break;
+    case AssetTextureFormat_Bc7:
+      bc7_decode((const Bc7Block*)pixelsMip0 + blockIndex, &blockBc0);
+      break;
     case AssetTextureFormat_Bc4:
     default:
       bc4_decode((const Bc4Block*)pixelsMip0 + blockIndex, &blockBc0);
@@ -846,6 +1028,11 @@ GeoColor asset_texture_at(const AssetTextureComp* t, const u32 layer, const usiz
   UNREACHABLE
 
 Ret:
+  if (t->flags & AssetTextureFlags_NormalMap && t->format == AssetTextureFormat_Bc5) {
+    // Reconstruct the z component of the (unit length) normal from the stored x and y.
+    const f32 x = res.r * 2.0f - 1.0f, y = res.g * 2.0f - 1.0f;
+    res.b       = math_sqrt_f32(math_max(0.0f, 1.0f - x * x - y * y)) * 0.5f + 0.5f;
+  }
   if (t->flags & AssetTextureFlags_BroadcastR) {
     res.g = res.r;
     res.b = res.r;
@@ -1015,7 +1202,9 @@ AssetTextureComp asset_texture_create(
   }
 
   const bool alpha    = tex_has_alpha(in, width, height, channels, layers, mipsSrc, type);
-  const bool lossless = (flags & AssetTextureFlags_Lossless) != 0;
+  const bool lossless    = (flags & AssetTextureFlags_Lossless) != 0;
+  const bool highQuality = (flags & AssetTextureFlags_HighQuality) != 0;
+  const bool normalMap   = (flags & AssetTextureFlags_NormalMap) != 0;
 
   if (layers > 1 && !(flags & AssetTextureFlags_CubeMap)) {
     flags |= AssetTextureFlags_Array;
@@ -1035,7 +1224,8 @@ AssetTextureComp asset_texture_create(
     flags &= ~AssetTextureFlags_GenerateMips;
   }
 
-  const AssetTextureFormat format = tex_format_pick(type, width, height, channels, alpha, lossless);
+  const AssetTextureFormat format =
+      tex_format_pick(type, width, height, channels, alpha, lossless, highQuality, normalMap);
   const bool               compress = tex_format_bc4x4(format);
   if (!compress) {
     flags |= AssetTextureFlags_Lossless;
@@ -5,6 +5,7 @@
 #include "core/diag.h"
 #include "core/dynarray.h"
 #include "core/math.h"
+#include "core/thread.h"
 #include "core/utf8.h"
 #include "data/read.h"
 #include "data/utils.h"
@@ -12,6 +13,7 @@
 #include "ecs/utils.h"
 #include "ecs/view.h"
 #include "ecs/world.h"
+#include "log/logger.h"
 
 #include "import.h"
 #include "loader_texture.h"
@@ -20,11 +22,15 @@
 
 /**
  * FontTexture - Generates a sdf texture atlas and a character mapping based on a font file.
+ *
+ * Characters of dynamic fonts are rasterized on first use by a background worker and committed into
+ * the free (or least recently used) atlas slots by 'FontTexDynamicUpdateSys'.
  */
 
 #define fonttex_max_chars 1024
 #define fonttex_max_size (1024 * 16)
 #define fonttex_max_fonts 100
+#define fonttex_dynamic_keep_ticks 3 // Minimum ticks a dynamic glyph stays resident after use.
 
 typedef enum {
   FontTexGenFlags_IncludeGlyph0 = 1 << 0, // Aka the '.notdef' glyph or the 'missing glyph'.
@@ -36,6 +42,7 @@ typedef struct {
   EcsEntityId asset;
   f32         yOffset;
   f32         spacing;
+  bool        dynamic; // Rasterize characters on first use.
   String      characters;
 } FontTexDefFont;
 
@@ -61,8 +68,55 @@ ecs_comp_define(AssetFontTexComp);
 
 ecs_comp_define(AssetFontTexLoadComp) { FontTexDef def; };
 
+typedef struct {
+  Unicode cp;
+  u8      variation;
+} FontTexGlyphKey;
+
+typedef struct {
+  AssetFontComp data; // Owned copy of the source font.
+  u8            variation;
+  f32           yOffset;
+  f32           spacing;
+} FontTexDynamicFont;
+
+typedef struct {
+  FontTexGlyphKey  key;
+  bool             found; // False when none of the dynamic fonts contain the character.
+  AssetFontTexChar ch;
+  Mem              pixels; // Sdf values of size glyphSize * glyphSize, empty if no glyph is needed.
+} FontTexGlyphResult;
+
+struct sAssetFontTexDynamic {
+  u32                 size, glyphSize, border;
+  FontTexDynamicFont* fonts;
+  u32                 fontCount;
+  DynArray            characters; // AssetFontTexChar[], backing memory of the comp characters.
+  u32                 generation; // Incremented whenever the characters change.
+
+  u32  tick;
+  u16  slotBegin, slotEnd; // Atlas slots that are available for dynamic glyphs.
+  u32* slotLastUse;        // u32[slotEnd], tick of the last use (0 = free); accessed atomically.
+  bool fullWarned;
+
+  ThreadMutex     mutex;
+  ThreadCondition wakeCondition;
+  ThreadHandle    worker;
+  bool            shutdown;
+  DynArray        pending; // FontTexGlyphKey[], sorted; requested but not yet committed.
+  DynArray        queue;   // FontTexGlyphKey[], waiting to be rasterized.
+  DynArray        results; // FontTexGlyphResult[], rasterized but not yet committed.
+};
+
+static void fonttex_dynamic_destroy(AssetFontTexDynamic*);
+
 static void ecs_destruct_fonttex_comp(void* data) {
   AssetFontTexComp* comp = data;
+  if (comp->dynamic) {
+    fonttex_dynamic_destroy(comp->dynamic); // NOTE: Owns the character memory.
+    comp->characters.values = null;
+    comp->characters.count  = 0;
+  }
   data_destroy(
       g_dataReg, g_allocHeap, g_assetFontTexMeta, mem_create(comp, sizeof(AssetFontTexComp)));
 }
@@ -83,6 +137,7 @@ typedef enum {
   FontTexError_TooManyCharacters,
   FontTexError_TooManyGlyphs,
   FontTexError_InvalidUtf8,
+  FontTexError_NoCharacters,
 
   FontTexError_Count,
 } FontTexError;
@@ -99,11 +154,22 @@ static String fonttex_error_str(const FontTexError err) {
       string_static("FontTex specifies more characters then are supported"),
       string_static("FontTex requires more glyphs then fit at the requested size"),
       string_static("FontTex specifies invalid utf8"),
+      string_static("FontTex specifies a non-dynamic font without characters"),
   };
   ASSERT(array_elems(g_msgs) == FontTexError_Count, "Incorrect number of fonttex-error messages");
   return g_msgs[err];
 }
 
+static i8 fonttex_compare_glyph_key(const void* a, const void* b) {
+  const FontTexGlyphKey* keyA   = a;
+  const FontTexGlyphKey* keyB   = b;
+  const i8               result = keyA->cp < keyB->cp ? -1 : keyA->cp > keyB->cp ? 1 : 0;
+  if (LIKELY(result != 0)) {
+    return result;
+  }
+  return keyA->variation < keyB->variation ? -1 : keyA->variation > keyB->variation ? 1 : 0;
+}
+
 static i8 fonttex_compare_char_cp(const void* a, const void* b) {
   const AssetFontTexChar* charA  = a;
   const AssetFontTexChar* charB  = b;
@@ -131,13 +197,13 @@ static u32 fonttex_lookup_chars(
     out[index++] = (FontTexDefChar){.cp = 0, .glyph = asset_font_missing(font)};
   }
 
-  do {
-    Unicode cp;
-    chars = utf8_cp_read(chars, &cp);
+  while (chars.size) {
     if (UNLIKELY(index >= fonttex_max_chars)) {
       *err = FontTexError_TooManyCharacters;
       return 0;
     }
+    Unicode cp;
+    chars = utf8_cp_read(chars, &cp);
     if (UNLIKELY(!cp)) {
       *err = FontTexError_InvalidUtf8;
       return 0;
@@ -148,29 +214,34 @@ static u32 fonttex_lookup_chars(
       return 0;
     }
     out[index++] = (FontTexDefChar){.cp = cp, .glyph = glyph};
-
-  } while (chars.size);
+  }
 
   *err = FontTexError_None;
   return index;
 }
 
+static u32 fonttex_glyph_x(const u32 size, const u32 glyphSize, const u32 index) {
+  return index * glyphSize % size;
+}
+
+static u32 fonttex_glyph_y(const u32 size, const u32 glyphSize, const u32 index) {
+  return index * glyphSize / size * glyphSize;
+}
+
+/**
+ * Write the sdf of the given glyph to a square of glyphSize pixels.
+ * NOTE: 'outStride' is the amount of pixels between the rows of the output.
+ */
 static void fonttex_generate_glyph(
-    const FontTexDef*     def,
+    const u32             glyphSize,
+    const u32             borderPixels,
     const AssetFontComp*  font,
     const AssetFontGlyph* glyph,
-    const u32             index,
-    u8*                   out) {
-
-  const u32 texY = index * def->glyphSize / def->size * def->glyphSize;
-  const u32 texX = index * def->glyphSize % def->size;
-
-  diag_assert(texY + def->glyphSize <= def->size);
-  diag_assert(texX + def->glyphSize <= def->size);
+    u8*                   out,
+    const usize           outStride) {
 
-  const u32 glyphSize    = def->glyphSize;
   const f32 invGlyphSize = 1.0f / glyphSize;
-  const f32 border       = def->border * invGlyphSize / glyph->size;
+  const f32 border       = borderPixels * invGlyphSize / glyph->size;
   const f32 invBorder    = 1.0f / border;
   const f32 scale        = 1.0f + border * 2.0f;
 
@@ -184,13 +255,28 @@ static void fonttex_generate_glyph(
       const f32 borderFrac = math_clamp_f32(dist * invBorder, -1.0f, 1.0f);
       const u8  value      = (u8)((borderFrac * 0.5f + 0.5f) * 255.999f);
 
-      const usize texPixelY                  = texY + glyphPixelY;
-      const usize texPixelX                  = texX + glyphPixelX;
-      out[texPixelY * def->size + texPixelX] = value;
+      out[glyphPixelY * outStride + glyphPixelX] = value;
     }
   }
 }
 
+static void fonttex_generate_glyph_atlas(
+    const FontTexDef*     def,
+    const AssetFontComp*  font,
+    const AssetFontGlyph* glyph,
+    const u32             index,
+    u8*                   outAtlas) {
+
+  const u32 texY = fonttex_glyph_y(def->size, def->glyphSize, index);
+  const u32 texX = fonttex_glyph_x(def->size, def->glyphSize, index);
+
+  diag_assert(texY + def->glyphSize <= def->size);
+  diag_assert(texX + def->glyphSize <= def->size);
+
+  u8* out = outAtlas + texY * def->size + texX;
+  fonttex_generate_glyph(def->glyphSize, def->border, font, glyph, out, def->size);
+}
+
 typedef struct {
   const AssetFontComp* data;
   u8                   variation;
@@ -230,14 +316,27 @@ static void fonttex_generate_font(
         *err = FontTexError_TooManyGlyphs;
         return;
       }
-      fonttex_generate_glyph(def, font.data, inputChars[i].glyph, (*nextGlyphIndex)++, outPixels);
+      const u32 index = (*nextGlyphIndex)++;
+      fonttex_generate_glyph_atlas(def, font.data, inputChars[i].glyph, index, outPixels);
+    }
+  }
+}
+
+static bool fonttex_is_dynamic(const FontTexDef* def) {
+  heap_array_for_t(def->fonts, FontTexDefFont, font) {
+    if (font->dynamic) {
+      return true;
     }
   }
+  return false;
 }
 
 static AssetTextureFlags fonttex_output_flags(const FontTexDef* def) {
   AssetTextureFlags flags = 0;
-  if (def->lossless) {
+  /**
+   * Dynamic glyphs are written directly into the pixel data, which requires an uncompressed format.
+   */
+  if (def->lossless || fonttex_is_dynamic(def)) {
     flags |= AssetTextureFlags_Lossless;
   }
   return flags;
@@ -249,6 +348,7 @@ static void fonttex_generate(
     const u32                     fontCount,
     AssetFontTexComp*             outFontTex,
     AssetTextureComp*             outTexture,
+    u16*                          outGlyphCount,
     FontTexError*                 err) {
 
   Mem pixelMem = alloc_alloc(g_allocHeap, def->size * def->size, 1);
@@ -285,6 +385,7 @@ static void fonttex_generate(
       .characters.values = dynarray_copy_as_new(&chars, g_allocHeap),
       .characters.count  = chars.size,
   };
+  *outGlyphCount = nextGlyphIndex;
   *outTexture = asset_texture_create(
       pixelMem,
       def->size,
@@ -303,6 +404,325 @@ Ret:
   alloc_free(g_allocHeap, pixelMem);
 }
 
+static void* fonttex_array_dup(const void* values, const usize size, const usize align) {
+  return size ? alloc_dup(g_allocHeap, mem_create(values, size), align).ptr : null;
+}
+
+static void fonttex_array_free(void* values, const usize size) {
+  alloc_maybe_free(g_allocHeap, mem_create(values, size));
+}
+
+#define fonttex_heap_array_dup(_ARRAY_, _TYPE_)                                                    \
+  fonttex_array_dup((_ARRAY_).values, sizeof(_TYPE_) * (_ARRAY_).count, alignof(_TYPE_))
+
+static AssetFontComp fonttex_font_clone(const AssetFontComp* font) {
+  AssetFontComp res;
+  res.characters.values = fonttex_heap_array_dup(font->characters, AssetFontChar);
+  res.characters.count  = font->characters.count;
+  res.points.values     = fonttex_heap_array_dup(font->points, AssetFontPoint);
+  res.points.count      = font->points.count;
+  res.segments.values   = fonttex_heap_array_dup(font->segments, AssetFontSegment);
+  res.segments.count    = font->segments.count;
+  res.glyphs.values     = fonttex_heap_array_dup(font->glyphs, AssetFontGlyph);
+  res.glyphs.count      = font->glyphs.count;
+  return res;
+}
+
+static void fonttex_font_free(AssetFontComp* font) {
+  fonttex_array_free(font->characters.values, sizeof(AssetFontChar) * font->characters.count);
+  fonttex_array_free(font->points.values, sizeof(AssetFontPoint) * font->points.count);
+  fonttex_array_free(font->segments.values, sizeof(AssetFontSegment) * font->segments.count);
+  fonttex_array_free(font->glyphs.values, sizeof(AssetFontGlyph) * font->glyphs.count);
+}
+
+/**
+ * Rasterize the glyph for the given key.
+ * NOTE: Invoked on the dynamic worker thread; only accesses immutable dynamic data.
+ */
+static FontTexGlyphResult fonttex_dynamic_rasterize(AssetFontTexDynamic* dyn, FontTexGlyphKey key) {
+  FontTexGlyphResult res = {.key = key};
+  for (u32 i = 0; i != dyn->fontCount; ++i) {
+    const FontTexDynamicFont* font = &dyn->fonts[i];
+    if (font->variation != key.variation) {
+      continue;
+    }
+    const AssetFontGlyph* glyph = asset_font_lookup(&font->data, key.cp);
+    if (glyph == asset_font_missing(&font->data)) {
+      continue;
+    }
+    res.found = true;
+    res.ch    = (AssetFontTexChar){
+        .cp         = key.cp,
+        .variation  = key.variation,
+        .glyphIndex = sentinel_u16, // Assigned when committed to the atlas.
+        .size       = glyph->size,
+        .offsetX    = glyph->offsetX,
+        .offsetY    = glyph->offsetY + font->yOffset,
+        .advance    = glyph->advance + font->spacing,
+    };
+    if (glyph->segmentCount) {
+      res.pixels = alloc_alloc(g_allocHeap, dyn->glyphSize * dyn->glyphSize, 1);
+      fonttex_generate_glyph(
+          dyn->glyphSize, dyn->border, &font->data, glyph, res.pixels.ptr, dyn->glyphSize);
+    }
+    break;
+  }
+  return res;
+}
+
+static void fonttex_dynamic_worker(void* data) {
+  AssetFontTexDynamic* dyn = data;
+
+  thread_mutex_lock(dyn->mutex);
+  while (!dyn->shutdown) {
+    if (!dyn->queue.size) {
+      thread_cond_wait(dyn->wakeCondition, dyn->mutex);
+      continue;
+    }
+    const FontTexGlyphKey key = *dynarray_at_t(&dyn->queue, 0, FontTexGlyphKey);
+    dynarray_remove(&dyn->queue, 0, 1);
+    thread_mutex_unlock(dyn->mutex);
+
+    const FontTexGlyphResult result = fonttex_dynamic_rasterize(dyn, key);
+
+    thread_mutex_lock(dyn->mutex);
+    *dynarray_push_t(&dyn->results, FontTexGlyphResult) = result;
+  }
+  thread_mutex_unlock(dyn->mutex);
+}
+
+static void fonttex_dynamic_sync_chars(AssetFontTexComp* comp) {
+  comp->characters.values = dynarray_begin_t(&comp->dynamic->characters, AssetFontTexChar);
+  comp->characters.count  = comp->dynamic->characters.size;
+}
+
+/**
+ * Create the dynamic glyph cache and transfer the ownership of the characters to it.
+ */
+static AssetFontTexDynamic* fonttex_dynamic_create(
+    const FontTexDef*             def,
+    const FontTexDefResolvedFont* fonts,
+    const u32                     fontCount,
+    const u16                     glyphCount,
+    AssetFontTexComp*             fonttex) {
+  const u32 glyphsPerDim = def->size / def->glyphSize;
+  const u32 slotEnd      = math_min(glyphsPerDim * glyphsPerDim, u16_max);
+
+  AssetFontTexDynamic* dyn = alloc_alloc_t(g_allocHeap, AssetFontTexDynamic);
+
+  *dyn = (AssetFontTexDynamic){
+      .size          = def->size,
+      .glyphSize     = def->glyphSize,
+      .border        = def->border,
+      .characters    = dynarray_create_t(g_allocHeap, AssetFontTexChar, fonttex->characters.count),
+      .tick          = 1,
+      .slotBegin     = glyphCount,
+      .slotEnd       = (u16)slotEnd,
+      .slotLastUse   = alloc_array_t(g_allocHeap, u32, slotEnd),
+      .mutex         = thread_mutex_create(g_allocHeap),
+      .wakeCondition = thread_cond_create(g_allocHeap),
+      .pending       = dynarray_create_t(g_allocHeap, FontTexGlyphKey, 64),
+      .queue         = dynarray_create_t(g_allocHeap, FontTexGlyphKey, 64),
+      .results       = dynarray_create_t(g_allocHeap, FontTexGlyphResult, 64),
+  };
+  mem_set(mem_create(dyn->slotLastUse, sizeof(u32) * slotEnd), 0);
+
+  for (u32 i = 0; i != fontCount; ++i) {
+    dyn->fontCount += def->fonts.values[i].dynamic ? 1 : 0;
+  }
+  dyn->fonts = alloc_array_t(g_allocHeap, FontTexDynamicFont, dyn->fontCount);
+  for (u32 i = 0, dynIndex = 0; i != fontCount; ++i) {
+    if (def->fonts.values[i].dynamic) {
+      dyn->fonts[dynIndex++] = (FontTexDynamicFont){
+          .data      = fonttex_font_clone(fonts[i].data),
+          .variation = fonts[i].variation,
+          .yOffset   = fonts[i].yOffset,
+          .spacing   = fonts[i].spacing,
+      };
+    }
+  }
+
+  // Move the characters into the (growable) dynamic storage.
+  const usize charCount = fonttex->characters.count;
+  mem_cpy(
+      dynarray_push(&dyn->characters, charCount),
+      mem_create(fonttex->characters.values, sizeof(AssetFontTexChar) * charCount));
+  alloc_free_array_t(g_allocHeap, fonttex->characters.values, charCount);
+  fonttex->dynamic           = dyn;
+  fonttex_dynamic_sync_chars(fonttex);
+
+  const ThreadPriority threadPrio = ThreadPriority_Low;
+  dyn->worker = thread_start(fonttex_dynamic_worker, dyn, string_lit("volo_glyph"), threadPrio);
+  return dyn;
+}
+
+static void fonttex_dynamic_destroy(AssetFontTexDynamic* dyn) {
+  // Signal the worker to shutdown.
+  thread_mutex_lock(dyn->mutex);
+  dyn->shutdown = true;
+  thread_cond_broadcast(dyn->wakeCondition);
+  thread_mutex_unlock(dyn->mutex);
+
+  thread_join(dyn->worker);
+
+  dynarray_for_t(&dyn->results, FontTexGlyphResult, result) {
+    if (mem_valid(result->pixels)) {
+      alloc_free(g_allocHeap, result->pixels);
+    }
+  }
+  for (u32 i = 0; i != dyn->fontCount; ++i) {
+    fonttex_font_free(&dyn->fonts[i].data);
+  }
+  alloc_free_array_t(g_allocHeap, dyn->fonts, dyn->fontCount);
+  alloc_free_array_t(g_allocHeap, dyn->slotLastUse, dyn->slotEnd);
+
+  thread_mutex_destroy(dyn->mutex);
+  thread_cond_destroy(dyn->wakeCondition);
+  dynarray_destroy(&dyn->characters);
+  dynarray_destroy(&dyn->pending);
+  dynarray_destroy(&dyn->queue);
+  dynarray_destroy(&dyn->results);
+  alloc_free_t(g_allocHeap, dyn);
+}
+
+static bool fonttex_dynamic_covers(const AssetFontTexDynamic* dyn, const u8 variation) {
+  for (u32 i = 0; i != dyn->fontCount; ++i) {
+    if (dyn->fonts[i].variation == variation) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void fonttex_dynamic_request(AssetFontTexDynamic* dyn, const FontTexGlyphKey key) {
+  thread_mutex_lock(dyn->mutex);
+  if (!dynarray_search_binary(&dyn->pending, fonttex_compare_glyph_key, &key)) {
+    FontTexGlyphKey* entry =
+        dynarray_insert_sorted_t(&dyn->pending, FontTexGlyphKey, fonttex_compare_glyph_key, &key);
+    *entry = key;
+    *dynarray_push_t(&dyn->queue, FontTexGlyphKey) = key;
+    thread_cond_signal(dyn->wakeCondition);
+  }
+  thread_mutex_unlock(dyn->mutex);
+}
+
+static void fonttex_dynamic_touch(AssetFontTexDynamic* dyn, const AssetFontTexChar* ch) {
+  if (ch->glyphIndex < dyn->slotBegin || ch->glyphIndex >= dyn->slotEnd) {
+    return; // Not a dynamic glyph.
+  }
+  u32* lastUse = &dyn->slotLastUse[ch->glyphIndex];
+  if (thread_atomic_load_u32(lastUse) != dyn->tick) {
+    thread_atomic_store_u32(lastUse, dyn->tick);
+  }
+}
+
+/**
+ * Find a slot for a new dynamic glyph; evicts the least recently used glyph if the atlas is full.
+ * NOTE: Returns sentinel_u16 if all slots have been used recently.
+ */
+static u16 fonttex_dynamic_slot_acquire(AssetFontTexDynamic* dyn) {
+  u16 best        = sentinel_u16;
+  u32 bestLastUse = u32_max;
+  for (u16 slot = dyn->slotBegin; slot != dyn->slotEnd; ++slot) {
+    if (dyn->slotLastUse[slot] < bestLastUse) {
+      best        = slot;
+      bestLastUse = dyn->slotLastUse[slot];
+    }
+  }
+  if (sentinel_check(best)) {
+    return sentinel_u16; // No dynamic slots available.
+  }
+  if (bestLastUse && bestLastUse + fonttex_dynamic_keep_ticks > dyn->tick) {
+    return sentinel_u16; // All slots are in use.
+  }
+  if (bestLastUse) {
+    // Evict all characters that reference the slot.
+    for (usize i = dyn->characters.size; i-- != 0;) {
+      if (dynarray_at_t(&dyn->characters, i, AssetFontTexChar)->glyphIndex == best) {
+        dynarray_remove(&dyn->characters, i, 1);
+      }
+    }
+  }
+  dyn->slotLastUse[best] = dyn->tick;
+  return best;
+}
+
+static const AssetFontTexChar* fonttex_find(
+    const AssetFontTexComp* comp, Unicode cp, u8 variation, const AssetFontTexChar** outFallback);
+
+typedef struct {
+  u32 minX, minY, maxX, maxY;
+} FontTexRect;
+
+/**
+ * Commit the rasterized glyphs into the atlas.
+ */
+static void fonttex_dynamic_commit(
+    AssetFontTexComp* comp, AssetTextureComp* texture, FontTexRect* dirty, bool* outDirty) {
+  AssetFontTexDynamic* dyn = comp->dynamic;
+  diag_assert(texture->format == AssetTextureFormat_u8_r);
+  diag_assert(texture->width == dyn->size && texture->height == dyn->size);
+
+  u8* atlasPixels = asset_texture_data(texture).ptr;
+
+  thread_mutex_lock(dyn->mutex);
+  dynarray_for_t(&dyn->results, FontTexGlyphResult, result) {
+    FontTexGlyphKey* pendingKey =
+        dynarray_search_binary(&dyn->pending, fonttex_compare_glyph_key, &result->key);
+    diag_assert(pendingKey);
+    dynarray_remove_ptr(&dyn->pending, pendingKey);
+
+    AssetFontTexChar ch;
+    if (result->found) {
+      ch = result->ch;
+    } else {
+      /**
+       * None of the dynamic fonts contain this character; store a copy of the fallback character so
+       * we don't keep requesting it.
+       */
+      const AssetFontTexChar* fallback = null;
+      fonttex_find(comp, result->key.cp, result->key.variation, &fallback);
+      ch           = *fallback;
+      ch.cp        = result->key.cp;
+      ch.variation = result->key.variation;
+    }
+    if (mem_valid(result->pixels)) {
+      const u16 slot = fonttex_dynamic_slot_acquire(dyn);
+      if (sentinel_check(slot)) {
+        if (!dyn->fullWarned) {
+          log_w("Dynamic font atlas full", log_param("slots", fmt_int(dyn->slotEnd)));
+          dyn->fullWarned = true;
+        }
+        alloc_free(g_allocHeap, result->pixels);
+        continue; // Will be requested again on the next use.
+      }
+      const u32 texX = fonttex_glyph_x(dyn->size, dyn->glyphSize, slot);
+      const u32 texY = fonttex_glyph_y(dyn->size, dyn->glyphSize, slot);
+      for (u32 y = 0; y != dyn->glyphSize; ++y) {
+        u8* rowOut = atlasPixels + (texY + y) * dyn->size + texX;
+        mem_cpy(
+            mem_create(rowOut, dyn->glyphSize),
+            mem_create(bits_ptr_offset(result->pixels.ptr, y * dyn->glyphSize), dyn->glyphSize));
+      }
+      alloc_free(g_allocHeap, result->pixels);
+
+      dirty->minX   = math_min(dirty->minX, texX);
+      dirty->minY   = math_min(dirty->minY, texY);
+      dirty->maxX   = math_max(dirty->maxX, texX + dyn->glyphSize);
+      dirty->maxY   = math_max(dirty->maxY, texY + dyn->glyphSize);
+      *outDirty     = true;
+      ch.glyphIndex = slot;
+    }
+    AssetFontTexChar* entry =
+        dynarray_insert_sorted_t(&dyn->characters, AssetFontTexChar, fonttex_compare_char_cp, &ch);
+    *entry = ch;
+    fonttex_dynamic_sync_chars(comp); // Inserting can re-allocate the characters.
+    ++dyn->generation;
+  }
+  dynarray_clear(&dyn->results);
+  thread_mutex_unlock(dyn->mutex);
+}
+
 ecs_view_define(ManagerView) { ecs_access_write(AssetManagerComp); }
 
 ecs_view_define(LoadView) {
@@ -360,16 +780,30 @@ ecs_system_define(FontTexLoadAssetSys) {
     }
 
     FontTexBundle bundle;
-    fonttex_generate(&load->def, fonts, fontCount, &bundle.fonttex, &bundle.texture, &err);
+    u16           glyphCount;
+    fonttex_generate(
+        &load->def, fonts, fontCount, &bundle.fonttex, &bundle.texture, &glyphCount, &err);
     if (UNLIKELY(err)) {
       goto Error;
     }
 
-    *ecs_world_add_t(world, entity, AssetFontTexComp) = bundle.fonttex;
-    *ecs_world_add_t(world, entity, AssetTextureComp) = bundle.texture;
-    asset_mark_load_success(world, entity);
+    if (fonttex_is_dynamic(&load->def)) {
+      /**
+       * Dynamic fonttex assets are not cached as they need the source fonts at runtime.
+       */
+      bundle.fonttex.dynamic =
+          fonttex_dynamic_create(&load->def, fonts, fontCount, glyphCount, &bundle.fonttex);
+      *ecs_world_add_t(world, entity, AssetFontTexComp) = bundle.fonttex;
+      *ecs_world_add_t(world, entity, AssetTextureComp) = bundle.texture;
+      asset_mark_load_success(world, entity);
+    } else {
+      bundle.fonttex.dynamic                            = null;
+      *ecs_world_add_t(world, entity, AssetFontTexComp) = bundle.fonttex;
+      *ecs_world_add_t(world, entity, AssetTextureComp) = bundle.texture;
+      asset_mark_load_success(world, entity);
 
-    asset_cache(world, entity, g_assetFontTexBundleMeta, mem_var(bundle));
+      asset_cache(world, entity, g_assetFontTexBundleMeta, mem_var(bundle));
+    }
 
     goto Cleanup;
 
@@ -389,6 +823,41 @@ ecs_system_define(FontTexLoadAssetSys) {
   }
 }
 
+ecs_view_define(DynamicView) {
+  ecs_access_with(AssetLoadedComp);
+  ecs_access_write(AssetFontTexComp);
+  ecs_access_write(AssetTextureComp);
+}
+
+/**
+ * Commit the glyphs that were rasterized on-demand into the atlas.
+ */
+ecs_system_define(FontTexDynamicUpdateSys) {
+  EcsView* dynamicView = ecs_world_view_t(world, DynamicView);
+  for (EcsIterator* itr = ecs_view_itr(dynamicView); ecs_view_walk(itr);) {
+    AssetFontTexComp* fonttex = ecs_view_write_t(itr, AssetFontTexComp);
+    if (!fonttex->dynamic) {
+      continue;
+    }
+    ++fonttex->dynamic->tick;
+
+    FontTexRect dirty = {.minX = u32_max, .minY = u32_max};
+    bool        isDirty = false;
+    fonttex_dynamic_commit(fonttex, ecs_view_write_t(itr, AssetTextureComp), &dirty, &isDirty);
+
+    if (isDirty) {
+      ecs_world_add_t(
+          world,
+          ecs_view_entity(itr),
+          AssetTextureDirtyComp,
+          .x      = dirty.minX,
+          .y      = dirty.minY,
+          .width  = dirty.maxX - dirty.minX,
+          .height = dirty.maxY - dirty.minY);
+    }
+  }
+}
+
 ecs_view_define(FontTexUnloadView) {
   ecs_access_with(AssetFontTexComp);
   ecs_access_without(AssetLoadedComp);
@@ -412,11 +881,13 @@ ecs_module_init(asset_texture_font_module) {
   ecs_register_view(ManagerView);
   ecs_register_view(LoadView);
   ecs_register_view(FontView);
+  ecs_register_view(DynamicView);
   ecs_register_view(FontTexUnloadView);
 
   ecs_register_system(
       FontTexLoadAssetSys, ecs_view_id(ManagerView), ecs_view_id(LoadView), ecs_view_id(FontView));
 
+  ecs_register_system(FontTexDynamicUpdateSys, ecs_view_id(DynamicView));
   ecs_register_system(FontTexUnloadAssetSys, ecs_view_id(FontTexUnloadView));
 }
 
@@ -427,7 +898,8 @@ void asset_data_init_fonttex(void) {
   data_reg_field_t(g_dataReg, FontTexDefFont, variation, data_prim_t(u8), .flags = DataFlags_Opt);
   data_reg_field_t(g_dataReg, FontTexDefFont, yOffset, data_prim_t(f32), .flags = DataFlags_Opt);
   data_reg_field_t(g_dataReg, FontTexDefFont, spacing, data_prim_t(f32), .flags = DataFlags_Opt);
-  data_reg_field_t(g_dataReg, FontTexDefFont, characters, data_prim_t(String), .flags = DataFlags_NotEmpty);
+  data_reg_field_t(g_dataReg, FontTexDefFont, dynamic, data_prim_t(bool), .flags = DataFlags_Opt);
+  data_reg_field_t(g_dataReg, FontTexDefFont, characters, data_prim_t(String), .flags = DataFlags_Opt);
 
   data_reg_struct_t(g_dataReg, FontTexDef);
   data_reg_field_t(g_dataReg, FontTexDef, size, data_prim_t(u32), .flags = DataFlags_NotEmpty);
@@ -502,6 +974,12 @@ void asset_load_tex_font(
     errMsg = fonttex_error_str(FontTexError_TooManyFonts);
     goto Error;
   }
+  heap_array_for_t(def.fonts, FontTexDefFont, font) {
+    if (UNLIKELY(!font->dynamic && string_is_empty(font->characters))) {
+      errMsg = fonttex_error_str(FontTexError_NoCharacters);
+      goto Error;
+    }
+  }
 
   ecs_world_add_t(world, entity, AssetFontTexLoadComp, .def = def);
   asset_repo_close(src);
@@ -542,6 +1020,8 @@ void asset_load_tex_font_bin(
     return;
   }
 
+  bundle.fonttex.dynamic = null; // Dynamic fonttex assets are never cached.
+
   *ecs_world_add_t(world, entity, AssetFontTexComp) = bundle.fonttex;
   *ecs_world_add_t(world, entity, AssetTextureComp) = bundle.texture;
   ecs_world_add_t(world, entity, AssetTextureSourceComp, .src = src);
@@ -549,15 +1029,23 @@ void asset_load_tex_font_bin(
   asset_mark_load_success(world, entity);
 }
 
-const AssetFontTexChar*
-asset_fonttex_lookup(const AssetFontTexComp* comp, const Unicode cp, const u8 variation) {
+/**
+ * Find the character with the given codepoint and variation.
+ * NOTE: Returns null if there's no exact match, the fallback is then written to 'outFallback'.
+ */
+static const AssetFontTexChar* fonttex_find(
+    const AssetFontTexComp*  comp,
+    const Unicode            cp,
+    const u8                 variation,
+    const AssetFontTexChar** outFallback) {
 
   /**
    * Binary scan to find a character with a matching code-point.
    * Looks for a character with the same variation otherwise variation 0 is returned.
    */
-  const AssetFontTexChar* begin      = comp->characters.values;
-  const AssetFontTexChar* end        = comp->characters.values + comp->characters.count;
+  const AssetFontTexChar* first      = comp->characters.values;
+  const AssetFontTexChar* begin      = first;
+  const AssetFontTexChar* end        = first + comp->characters.count;
   const AssetFontTexChar* matchingCp = null;
   while (begin < end) {
     const usize             elems  = end - begin;
@@ -576,12 +1064,40 @@ asset_fonttex_lookup(const AssetFontTexComp* comp, const Unicode cp, const u8 va
   }
   if (matchingCp) {
     /**
-     * Preferred variation was not found, walk backwards to variation 0 and return that.
+     * Preferred variation was not found, walk backwards to the lowest variation and return that.
      */
-    for (; matchingCp->variation; --matchingCp)
+    for (; matchingCp->variation && matchingCp != first && matchingCp[-1].cp == cp; --matchingCp)
       ;
-    return matchingCp;
+    *outFallback = matchingCp;
+    return null;
   }
   // Return the 'missing' character, is guaranteed to exist.
-  return &comp->characters.values[0];
+  *outFallback = &first[0];
+  return null;
+}
+
+const AssetFontTexChar*
+asset_fonttex_lookup(const AssetFontTexComp* comp, const Unicode cp, const u8 variation) {
+  const AssetFontTexChar* fallback = null;
+  const AssetFontTexChar* res      = fonttex_find(comp, cp, variation, &fallback);
+  if (!comp->dynamic) {
+    return res ? res : fallback;
+  }
+  if (!res) {
+    /**
+     * Request the character to be rasterized; when only the variation is missing we only request
+     * it if there's a dynamic font for the variation as otherwise the fallback is the best match.
+     */
+    const bool missingCp = fallback == &comp->characters.values[0] && fallback->cp != cp;
+    if (missingCp || fonttex_dynamic_covers(comp->dynamic, variation)) {
+      fonttex_dynamic_request(comp->dynamic, (FontTexGlyphKey){.cp = cp, .variation = variation});
+    }
+    res = fallback;
+  }
+  fonttex_dynamic_touch(comp->dynamic, res);
+  return res;
+}
+
+u32 asset_fonttex_generation(const AssetFontTexComp* comp) {
+  return comp->dynamic ? comp->dynamic->generation : 0;
 }
@@ -5,10 +5,12 @@
 #include "core/dynstring.h"
 #include "core/math.h"
 #include "core/zlib.h"
+#include "data/utils.h"
 #include "ecs/entity.h"
 #include "ecs/world.h"
 #include "log/logger.h"
 
+#include "import.h"
 #include "import_texture.h"
 #include "loader_texture.h"
 #include "manager.h"
@@ -539,36 +541,193 @@ static AssetTextureType png_tex_type(const PngType type) {
   }
 }
 
+typedef struct {
+  String                  id;
+  AssetSource*            src;
+  PngHeader               header;
+  PngType                 type;
+  PngChannels             channels;
+  u32                     sampleBits;
+  AssetImportTextureFlags importFlags;
+  AssetImportTextureFlip  importFlip;
+  PngError                err;
+  DynString               buffer;
+  AssetImportTexture      import;
+  AssetTextureComp        tex;
+  bool                    texValid;
+} PngLoad;
+
+static void png_load_destroy(PngLoad* load) {
+  if (load->texValid) {
+    data_destroy(g_dataReg, g_allocHeap, g_assetTexMeta, mem_var(load->tex));
+  }
+  dynarray_destroy(&load->buffer);
+  asset_repo_close(load->src);
+}
+
+/**
+ * Decode the pixel data.
+ * NOTE: Executed on a background streaming thread.
+ */
+static void png_load_decode(void* ctx) {
+  PngLoad*          load     = ctx;
+  const PngHeader*  header   = &load->header;
+  const PngChannels channels = load->channels;
+  const PngType     type     = load->type;
+
+  PngChunk  chunks[png_max_chunks];
+  const u32 chunkCount = png_read_chunks(load->src->data, chunks, &load->err);
+  diag_assert(!load->err); // Chunks are validated before starting the decode.
+
+  /**
+   * NOTE: For indexed images a sample refers to an index into the palette for other images types it
+   * refers to an actual pixel.
+   */
+  const u32   sampleBytes         = math_max(1, bits_to_bytes(load->sampleBits));
+  const u32   sampleScanlineBytes = math_max(1, bits_to_bytes(header->width * load->sampleBits));
+  const usize sampleTotalBytes    = header->height * sampleScanlineBytes;
+
+  const usize filterTotalBytes = header->height * sizeof(u8);
+  const usize inputTotalBytes  = sampleTotalBytes + filterTotalBytes;
+  const usize pixelTotalBytes  = header->width * header->height * channels * type;
+
+  dynstring_reserve(&load->buffer, math_max(inputTotalBytes, pixelTotalBytes));
+
+  png_read_data(chunks, chunkCount, &load->buffer, &load->err);
+  if (UNLIKELY(load->err)) {
+    return;
+  }
+  if (UNLIKELY(load->buffer.size != inputTotalBytes)) {
+    load->err = PngError_DataUnexpectedSize;
+    return;
+  }
+
+  png_filter_decode(header, sampleBytes, sampleScanlineBytes, &load->buffer, &load->err);
+  if (UNLIKELY(load->err)) {
+    return;
+  }
+  diag_assert(load->buffer.size == sampleTotalBytes);
+
+  if (header->colorType == 3 /* indexed color */) {
+    png_palette_decode(header, chunks, chunkCount, &load->buffer, &load->err);
+    if (UNLIKELY(load->err)) {
+      return;
+    }
+  } else if (header->bitDepth < 8) {
+    png_bit_expand(header, channels, &load->buffer);
+  }
+  diag_assert(load->buffer.size == pixelTotalBytes);
+}
+
+/**
+ * Apply the import (conversion and block compression).
+ * NOTE: Executed on a background streaming thread.
+ */
+static void png_load_import(void* ctx) {
+  PngLoad* load  = ctx;
+  load->texValid = asset_import_texture_apply(&load->import, &load->tex);
+}
+
+static void png_load_import_finish(
+    EcsWorld*                 world,
+    const AssetImportEnvComp* importEnv,
+    const EcsEntityId         entity,
+    void*                     ctx,
+    const bool                cancelled) {
+  (void)importEnv;
+  PngLoad* load = ctx;
+  if (cancelled) {
+    goto Ret;
+  }
+  if (UNLIKELY(!load->texValid)) {
+    png_load_fail(world, entity, load->id, PngError_ImportFailed);
+    goto Ret;
+  }
+
+  *ecs_world_add_t(world, entity, AssetTextureComp) = load->tex;
+  asset_cache(world, entity, g_assetTexMeta, mem_var(load->tex));
+  asset_mark_load_success(world, entity);
+  load->texValid = false; // Ownership of the texture data has been transferred to the world.
+
+Ret:
+  png_load_destroy(load);
+}
+
+static void png_load_decode_finish(
+    EcsWorld*                 world,
+    const AssetImportEnvComp* importEnv,
+    const EcsEntityId         entity,
+    void*                     ctx,
+    const bool                cancelled) {
+  PngLoad* load = ctx;
+  if (cancelled) {
+    png_load_destroy(load);
+    return;
+  }
+  if (UNLIKELY(load->err)) {
+    png_load_fail(world, entity, load->id, load->err);
+    png_load_destroy(load);
+    return;
+  }
+  if (!asset_import_ready(importEnv, load->id)) {
+    /**
+     * Import environment is being reloaded; retry next frame.
+     * NOTE: Cannot happen without streaming as then the load is started in the same frame.
+     */
+    asset_stream(world, entity, null, png_load_decode_finish, mem_create(load, sizeof(PngLoad)));
+    return;
+  }
+
+  if (!asset_import_texture_eval(
+          importEnv,
+          load->id,
+          dynstring_view(&load->buffer),
+          load->header.width,
+          load->header.height,
+          load->channels,
+          png_tex_type(load->type),
+          load->importFlags,
+          load->importFlip,
+          &load->import)) {
+    png_load_fail(world, entity, load->id, PngError_ImportFailed);
+    png_load_destroy(load);
+    return;
+  }
+
+  // Apply the import on a background thread; only the script evaluation needs the import env.
+  asset_stream(
+      world, entity, png_load_import, png_load_import_finish, mem_create(load, sizeof(PngLoad)));
+}
+
 void asset_load_tex_png(
     EcsWorld*                 world,
     const AssetImportEnvComp* importEnv,
     const String              id,
     const EcsEntityId         entity,
     AssetSource*              src) {
-
-  DynString buffer = dynstring_create(g_allocHeap, 0);
+  (void)importEnv;
 
   PngError  err = PngError_None;
   PngChunk  chunks[png_max_chunks];
   const u32 chunkCount = png_read_chunks(src->data, chunks, &err);
   if (UNLIKELY(err)) {
     png_load_fail(world, entity, id, err);
-    goto Ret;
+    goto Error;
   }
   if (UNLIKELY(!chunkCount || !png_chunk_match(&chunks[0], string_lit("IHDR")))) {
     png_load_fail(world, entity, id, PngError_HeaderChunkMissing);
-    goto Ret;
+    goto Error;
   }
   if (UNLIKELY(!chunkCount || !png_chunk_match(&chunks[chunkCount - 1], string_lit("IEND")))) {
     png_load_fail(world, entity, id, PngError_EndChunkMissing);
-    goto Ret;
+    goto Error;
   }
 
   PngHeader header;
   png_read_header(&chunks[0], &header, &err);
   if (UNLIKELY(err)) {
     png_load_fail(world, entity, id, err);
-    goto Ret;
+    goto Error;
   }
   PngType     type;
   PngChannels channels;
@@ -583,6 +742,7 @@ void asset_load_tex_png(
     sampleBits = header.bitDepth;
     if (UNLIKELY((sampleBits > 1) && (!bits_ispow2(sampleBits) || sampleBits > 8))) {
       png_load_fail(world, entity, id, PngError_InvalidIndexBitDepth);
+      goto Error;
     }
   } else {
     type       = png_type(&header);
@@ -591,76 +751,33 @@ void asset_load_tex_png(
   }
   if (UNLIKELY(!type)) {
     png_load_fail(world, entity, id, PngError_UnsupportedBitDepth);
-    goto Ret;
+    goto Error;
   }
   if (UNLIKELY(!channels)) {
     png_load_fail(world, entity, id, PngError_UnsupportedColorType);
-    goto Ret;
+    goto Error;
   }
   if (UNLIKELY(!header.width || !header.height)) {
     png_load_fail(world, entity, id, PngError_UnsupportedSize);
-    goto Ret;
+    goto Error;
   }
   if (UNLIKELY(header.width > png_max_width || header.height > png_max_height)) {
     png_load_fail(world, entity, id, PngError_UnsupportedSize);
-    goto Ret;
+    goto Error;
   }
   if (UNLIKELY(header.compressionMethod)) {
     png_load_fail(world, entity, id, PngError_UnsupportedCompression);
-    goto Ret;
+    goto Error;
   }
   if (UNLIKELY(header.filterMethod)) {
     png_load_fail(world, entity, id, PngError_UnsupportedFilter);
-    goto Ret;
+    goto Error;
   }
   if (UNLIKELY(header.interlaceMethod)) {
     png_load_fail(world, entity, id, PngError_UnsupportedInterlacing);
-    goto Ret;
+    goto Error;
   }
 
-  /**
-   * NOTE: For indexed images a sample refers to an index into the palette for other images types it
-   * refers to an actual pixel.
-   */
-  const u32   sampleBytes         = math_max(1, bits_to_bytes(sampleBits));
-  const u32   sampleScanlineBytes = math_max(1, bits_to_bytes(header.width * sampleBits));
-  const usize sampleTotalBytes    = header.height * sampleScanlineBytes;
-
-  const usize filterTotalBytes = header.height * sizeof(u8);
-  const usize inputTotalBytes  = sampleTotalBytes + filterTotalBytes;
-  const usize pixelTotalBytes  = header.width * header.height * channels * type;
-
-  dynstring_reserve(&buffer, math_max(inputTotalBytes, pixelTotalBytes));
-
-  png_read_data(chunks, chunkCount, &buffer, &err);
-  if (UNLIKELY(err)) {
-    png_load_fail(world, entity, id, err);
-    goto Ret;
-  }
-
-  if (UNLIKELY(buffer.size != inputTotalBytes)) {
-    png_load_fail(world, entity, id, PngError_DataUnexpectedSize);
-    goto Ret;
-  }
-
-  png_filter_decode(&header, sampleBytes, sampleScanlineBytes, &buffer, &err);
-  if (UNLIKELY(err)) {
-    png_load_fail(world, entity, id, err);
-    goto Ret;
-  }
-  diag_assert(buffer.size == sampleTotalBytes);
-
-  if (header.colorType == 3 /* indexed color */) {
-    png_palette_decode(&header, chunks, chunkCount, &buffer, &err);
-    if (UNLIKELY(err)) {
-      png_load_fail(world, entity, id, err);
-      goto Ret;
-    }
-  } else if (header.bitDepth < 8) {
-    png_bit_expand(&header, channels, &buffer);
-  }
-  diag_assert(buffer.size == pixelTotalBytes);
-
   AssetImportTextureFlags importFlags = AssetImportTextureFlags_Mips;
   if (png_is_linear(chunks, chunkCount)) {
     importFlags |= AssetImportTextureFlags_Linear;
@@ -672,27 +789,24 @@ void asset_load_tex_png(
    */
   importFlip |= AssetImportTextureFlip_Y;
 
-  AssetTextureComp tex;
-  if (!asset_import_texture(
-          importEnv,
-          id,
-          dynstring_view(&buffer),
-          header.width,
-          header.height,
-          channels,
-          png_tex_type(type),
-          importFlags,
-          importFlip,
-          &tex)) {
-    png_load_fail(world, entity, id, PngError_ImportFailed);
-    goto Ret;
-  }
-
-  *ecs_world_add_t(world, entity, AssetTextureComp) = tex;
-  asset_cache(world, entity, g_assetTexMeta, mem_var(tex));
-  asset_mark_load_success(world, entity);
+  /**
+   * Decode the pixel data on a background thread.
+   * NOTE: The source is kept open until the load finishes as the chunks reference its data.
+   */
+  PngLoad load = {
+      .id          = id,
+      .src         = src,
+      .header      = header,
+      .type        = type,
+      .channels    = channels,
+      .sampleBits  = sampleBits,
+      .importFlags = importFlags,
+      .importFlip  = importFlip,
+      .buffer      = dynstring_create(g_allocHeap, 0),
+  };
+  asset_stream(world, entity, png_load_decode, png_load_decode_finish, mem_var(load));
+  return;
 
-Ret:
-  dynarray_destroy(&buffer);
+Error:
   asset_repo_close(src);
 }
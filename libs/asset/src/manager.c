@@ -4,8 +4,10 @@
 #include "core/diag.h"
 #include "core/dynarray.h"
 #include "core/dynstring.h"
+#include "core/math.h"
 #include "core/path.h"
 #include "core/stringtable.h"
+#include "core/thread.h"
 #include "core/time.h"
 #include "data/write.h"
 #include "ecs/entity.h"
@@ -23,6 +25,7 @@
 #define VOLO_ASSET_LOGGING 0
 
 #define asset_num_load_tasks 2
+#define asset_num_stream_workers_max 4
 #define asset_id_max_size 256
 
 /**
@@ -52,6 +55,7 @@ ecs_comp_define(AssetManagerComp) {
   AssetManagerFlags flags;
   TimeDuration      loadingBudget; // Max loading time (per task) for each frame (0 is inf).
   DynArray          lookup;        // AssetEntry[], kept sorted on the idHash.
+  AssetStreamer*    streamer;      // Null if streaming is not enabled.
 };
 
 ecs_comp_define(AssetComp) {
@@ -103,6 +107,8 @@ ecs_comp_define(AssetCacheRequestComp) {
 
 ecs_comp_define(AssetReloadRequestComp);
 
+ecs_comp_define(AssetPriorityComp) { AssetPriority priority; };
+
 ecs_comp_define(AssetExtLoadComp) {
   u32         count;
   AssetFormat format;
@@ -169,6 +175,9 @@ static void asset_dep_mark(const AssetDepStorage* storage, EcsWorld* world, cons
 
 static void ecs_destruct_manager_comp(void* data) {
   AssetManagerComp* comp = data;
+  if (comp->streamer) {
+    asset_streamer_destroy(comp->streamer); // NOTE: Has to be destroyed before the repo.
+  }
   asset_repo_destroy(comp->repo);
   dynarray_destroy(&comp->lookup);
 }
@@ -210,6 +219,12 @@ static void ecs_combine_asset_ext_load(void* dataA, void* dataB) {
   }
 }
 
+static void ecs_combine_asset_priority(void* dataA, void* dataB) {
+  AssetPriorityComp* compA = dataA;
+  AssetPriorityComp* compB = dataB;
+  compA->priority          = math_max(compA->priority, compB->priority);
+}
+
 static void ecs_destruct_cache_request_comp(void* data) {
   AssetCacheRequestComp* comp = data;
   alloc_free(g_allocHeap, comp->blobMem);
@@ -221,13 +236,19 @@ static i8 asset_compare_entry(const void* a, const void* b) {
 
 static AssetManagerComp*
 asset_manager_create_internal(EcsWorld* world, AssetRepo* repo, const AssetManagerFlags flags) {
+  AssetStreamer* streamer = null;
+  if (flags & AssetManagerFlags_Streaming) {
+    const u32 workerCount = math_clamp_i32(g_threadCoreCount / 2, 1, asset_num_stream_workers_max);
+    streamer              = asset_streamer_create(g_allocHeap, workerCount);
+  }
   return ecs_world_add_t(
       world,
       ecs_world_global(world),
       AssetManagerComp,
-      .repo   = repo,
-      .flags  = flags,
-      .lookup = dynarray_create_t(g_allocHeap, AssetEntry, 128));
+      .repo     = repo,
+      .flags    = flags,
+      .lookup   = dynarray_create_t(g_allocHeap, AssetEntry, 128),
+      .streamer = streamer);
 }
 
 static EcsEntityId asset_entity_create(EcsWorld* world, StringTable* stringTable, const String id) {
@@ -250,6 +271,7 @@ static u32 asset_manager_loader_hash(const void* ctx, const String assetId) {
 
 typedef enum {
   AssetLoadResult_Started,
+  AssetLoadResult_Pending,
   AssetLoadResult_Missing,
   AssetLoadResult_Unsupported,
 } AssetLoadResult;
@@ -258,6 +280,8 @@ static String asset_manager_load_result_str(const AssetLoadResult res) {
   switch (res) {
   case AssetLoadResult_Started:
     return string_lit("Started");
+  case AssetLoadResult_Pending:
+    return string_lit("Pending");
   case AssetLoadResult_Missing:
     return string_lit("Source not found");
   case AssetLoadResult_Unsupported:
@@ -279,6 +303,9 @@ static AssetLoadResult asset_manager_load(
       .computeHash = asset_manager_loader_hash,
   };
 
+  if (!asset_repo_prepare(manager->repo, asset->id, loaderHasher)) {
+    return AssetLoadResult_Pending; // Repository is still retrieving the asset; retry later.
+  }
   AssetSource* source = asset_repo_open(manager->repo, asset->id, loaderHasher);
   if (!source) {
     return AssetLoadResult_Missing;
@@ -415,14 +442,18 @@ ecs_system_define(AssetUpdateDirtySys) {
         trace_begin_msg("asset_manager_load", TraceColor_Blue, "{}", fmt_text(assetFileName));
         {
           const AssetLoadResult res = asset_manager_load(world, man, importEnv, assetComp, entity);
-          if (res == AssetLoadResult_Started) {
+          if (res == AssetLoadResult_Pending) {
+            // Load cannot start yet; the asset stays dirty so the load is retried next update.
+            assetComp->flags &= ~AssetFlags_Loading;
+          } else if (res == AssetLoadResult_Started) {
             loadingBudget -= time_steady_duration(loadStart, time_steady_clock());
             ecs_utils_maybe_remove_t(world, entity, AssetInstantUnloadComp);
+            ecs_utils_maybe_remove_t(world, entity, AssetChangedComp);
           } else {
             const String error = asset_manager_load_result_str(res);
             asset_mark_load_failure(world, entity, assetComp->id, error, (i32)res);
+            ecs_utils_maybe_remove_t(world, entity, AssetChangedComp);
           }
-          ecs_utils_maybe_remove_t(world, entity, AssetChangedComp);
         }
         trace_end();
       }
@@ -435,6 +466,9 @@ ecs_system_define(AssetUpdateDirtySys) {
        */
       assetComp->flags &= ~AssetFlags_Loading;
       assetComp->flags |= AssetFlags_Failed;
+      if (man->streamer) {
+        asset_streamer_forget(man->streamer, entity);
+      }
       goto AssetUpdateDone;
     }
     if (assetComp->flags & AssetFlags_Loading && ecs_world_has_t(world, entity, AssetLoadedComp)) {
@@ -443,6 +477,18 @@ ecs_system_define(AssetUpdateDirtySys) {
        */
       assetComp->flags &= ~AssetFlags_Loading;
       assetComp->flags |= AssetFlags_Loaded;
+      if (man->streamer) {
+        asset_streamer_forget(man->streamer, entity);
+      }
+      goto AssetUpdateDone;
+    }
+    const bool loadingUnused = assetComp->flags & AssetFlags_Loading && !assetComp->refCount;
+    if (loadingUnused && man->streamer && asset_streamer_cancel(man->streamer, entity)) {
+      /**
+       * Asset was released while it had outstanding streaming work; cancel the work.
+       * NOTE: The loading flag is cleared once the cancelled request is finished (see stream sys).
+       * NOTE: Assets that are loading without streaming work continue to load as normal.
+       */
       goto AssetUpdateDone;
     }
 
@@ -536,6 +582,60 @@ ecs_system_define(AssetReloadRequestSys) {
   }
 }
 
+ecs_view_define(AssetStreamView) { ecs_access_write(AssetComp); }
+
+ecs_view_define(AssetPriorityView) {
+  ecs_access_read(AssetComp);
+  ecs_access_read(AssetPriorityComp);
+}
+
+ecs_system_define(AssetStreamSys) {
+  EcsView*     globalView = ecs_world_view_t(world, GlobalUpdateView);
+  EcsIterator* globalItr  = ecs_view_maybe_at(globalView, ecs_world_global(world));
+  if (!globalItr) {
+    return; // Global dependencies not initialized.
+  }
+  const AssetManagerComp*   man       = ecs_view_read_t(globalItr, AssetManagerComp);
+  const AssetImportEnvComp* importEnv = ecs_view_read_t(globalItr, AssetImportEnvComp);
+
+  // Apply priority hints.
+  EcsView* priorityView = ecs_world_view_t(world, AssetPriorityView);
+  for (EcsIterator* itr = ecs_view_itr(priorityView); ecs_view_walk(itr);) {
+    const EcsEntityId        entity       = ecs_view_entity(itr);
+    const AssetComp*         assetComp    = ecs_view_read_t(itr, AssetComp);
+    const AssetPriorityComp* priorityComp = ecs_view_read_t(itr, AssetPriorityComp);
+    if (man->streamer && !(assetComp->flags & AssetFlags_LoadedOrFailed)) {
+      asset_streamer_prioritize(man->streamer, entity, priorityComp->priority);
+    }
+    ecs_world_remove_t(world, entity, AssetPriorityComp);
+  }
+
+  if (!man->streamer) {
+    return;
+  }
+
+  // Finish the completed streaming requests.
+  const TimeDuration budget    = man->loadingBudget > 0 ? man->loadingBudget : time_hour;
+  const TimeSteady   startTime = time_steady_clock();
+  EcsIterator*       assetItr  = ecs_view_itr(ecs_world_view_t(world, AssetStreamView));
+
+  AssetStreamResult res;
+  while (asset_streamer_finish(man->streamer, world, importEnv, &res)) {
+    if (res.cancelled && ecs_view_maybe_jump(assetItr, res.asset)) {
+      /**
+       * Load was cancelled; reset the asset so the load is restarted when it's acquired again.
+       */
+      AssetComp* assetComp = ecs_view_write_t(assetItr, AssetComp);
+      assetComp->flags &= ~AssetFlags_Loading;
+      asset_streamer_forget(man->streamer, res.asset);
+      ecs_world_add_t(world, res.asset, AssetDirtyComp);
+    }
+    if (time_steady_duration(startTime, time_steady_clock()) >= budget) {
+      break; // Continue next frame.
+    }
+  }
+}
+
 ecs_view_define(AssetLoadExtView) {
   ecs_access_write(AssetComp);
   ecs_access_read(AssetExtLoadComp);
@@ -680,6 +780,7 @@ ecs_module_init(asset_manager_module) {
       .combinator = ecs_combine_asset_dependency);
   ecs_register_comp(AssetCacheRequestComp, .destructor = ecs_destruct_cache_request_comp);
   ecs_register_comp_empty(AssetReloadRequestComp);
+  ecs_register_comp(AssetPriorityComp, .combinator = ecs_combine_asset_priority);
   ecs_register_comp(AssetExtLoadComp, .combinator = ecs_combine_asset_ext_load);
 
   ecs_register_view(GlobalUpdateView);
@@ -698,6 +799,13 @@ ecs_module_init(asset_manager_module) {
 
   ecs_register_system(AssetReloadRequestSys, ecs_register_view(AssetReloadView));
 
+  ecs_register_system(
+      AssetStreamSys,
+      ecs_view_id(GlobalUpdateView),
+      ecs_register_view(AssetStreamView),
+      ecs_register_view(AssetPriorityView));
+  ecs_order(AssetStreamSys, AssetOrder_Update);
+
   ecs_register_system(AssetLoadExtSys, ecs_register_view(AssetLoadExtView));
   ecs_order(AssetLoadExtSys, AssetOrder_Update);
 
@@ -725,8 +833,16 @@ bool asset_path_by_id(const AssetManagerComp* manager, const String id, DynStrin
 
 AssetManagerComp*
 asset_manager_create_fs(EcsWorld* world, const AssetManagerFlags flags, const String rootPath) {
+  return asset_manager_create_fs_remote(world, flags, rootPath, string_empty);
+}
+
+AssetManagerComp* asset_manager_create_fs_remote(
+    EcsWorld*               world,
+    const AssetManagerFlags flags,
+    const String            rootPath,
+    const String            remoteCacheUrl) {
   const bool portableCache = (flags & AssetManagerFlags_PortableCache) != 0;
-  AssetRepo* repo          = asset_repo_create_fs(rootPath, portableCache);
+  AssetRepo* repo          = asset_repo_create_fs(rootPath, portableCache, remoteCacheUrl);
   if (UNLIKELY(!repo)) {
     return null;
   }
@@ -735,7 +851,8 @@ asset_manager_create_fs(EcsWorld* world, const AssetManagerFlags flags, const St
 
 AssetManagerComp*
 asset_manager_create_pack(EcsWorld* world, const AssetManagerFlags flags, const String filePath) {
-  AssetRepo* repo = asset_repo_create_pack(filePath);
+  const bool recordLoadOrder = (flags & AssetManagerFlags_RecordLoadOrder) != 0;
+  AssetRepo* repo            = asset_repo_create_pack(filePath, recordLoadOrder);
   if (UNLIKELY(!repo)) {
     return null;
   }
@@ -785,6 +902,11 @@ void asset_release(EcsWorld* world, const EcsEntityId asset) {
   ecs_world_add_t(world, asset, AssetDirtyComp, .numRelease = 1);
 }
 
+void asset_priority_hint(
+    EcsWorld* world, const EcsEntityId assetEntity, const AssetPriority priority) {
+  ecs_world_add_t(world, assetEntity, AssetPriorityComp, .priority = priority);
+}
+
 void asset_reload_request(EcsWorld* world, const EcsEntityId assetEntity) {
   ecs_utils_maybe_add_t(world, assetEntity, AssetReloadRequestComp);
 }
@@ -938,3 +1060,25 @@ void asset_cache(
       .blobSize = blobBuffer.size,
       .blobMem  = blobBuffer.data);
 }
+
+void asset_stream(
+    EcsWorld*                world,
+    const EcsEntityId        asset,
+    const AssetStreamRoutine routine,
+    const AssetStreamFinish  finish,
+    const Mem                ctx) {
+  EcsView*     globalView = ecs_world_view_t(world, GlobalUpdateView);
+  EcsIterator* globalItr  = ecs_view_at(globalView, ecs_world_global(world));
+
+  const AssetManagerComp* man = ecs_view_read_t(globalItr, AssetManagerComp);
+  if (man->streamer) {
+    asset_streamer_push(man->streamer, asset, routine, finish, ctx);
+    return;
+  }
+  // Streaming not enabled; execute synchronously.
+  if (routine) {
+    routine(ctx.ptr);
+  }
+  const AssetImportEnvComp* importEnv = ecs_view_read_t(globalItr, AssetImportEnvComp);
+  finish(world, importEnv, asset, ctx.ptr, false /* cancelled */);
+}
@@ -3,6 +3,7 @@
 
 #include "format.h"
 #include "forward.h"
+#include "stream.h"
 
 /**
  * Register a dependency between the two assets.
@@ -49,3 +50,17 @@ void asset_mark_external_load(
  * The cached data will be used for the next load provided the source asset hasn't changed.
  */
 void asset_cache(EcsWorld*, EcsEntityId asset, DataMeta, Mem data);
+
+/**
+ * Execute a (heavy) part of an asset load on the background streaming threads.
+ * 'routine' is invoked on a background thread (if the manager supports streaming) after which
+ * 'finish' is invoked on the main-thread; 'finish' is allowed to call 'asset_stream()' again to
+ * queue the next stage of the load.
+ * When the manager doesn't support streaming both callbacks are invoked synchronously.
+ * NOTE: The context memory is copied and is freed after 'finish' is invoked.
+ * NOTE: When an asset is released before finishing the load the finish is invoked as cancelled, it
+ * should then only free its resources and not modify the asset; afterwards the manager restarts
+ * the load if the asset is acquired again.
+ * Pre-condition: Called from an asset loader or from a stream finish callback.
+ */
+void asset_stream(EcsWorld*, EcsEntityId asset, AssetStreamRoutine, AssetStreamFinish, Mem ctx);
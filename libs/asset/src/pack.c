@@ -36,6 +36,7 @@
 #define asset_pack_file_align 16
 
 DataMeta g_assetPackMeta;
+DataMeta g_assetPackLoadOrderMeta;
 
 struct sAssetPacker {
   Allocator* alloc;
@@ -411,9 +412,17 @@ void asset_data_init_pack(void) {
   data_reg_struct_t(g_dataReg, AssetPackHeader);
   data_reg_field_t(g_dataReg, AssetPackHeader, entries, t_AssetPackEntry, .container = DataContainer_DynArray);
   data_reg_field_t(g_dataReg, AssetPackHeader, regions, t_AssetPackRegion, .container = DataContainer_DynArray);
+
+  data_reg_struct_t(g_dataReg, AssetPackLevelOrder);
+  data_reg_field_t(g_dataReg, AssetPackLevelOrder, level, data_prim_t(String), .flags = DataFlags_Intern);
+  data_reg_field_t(g_dataReg, AssetPackLevelOrder, assets, data_prim_t(String), .container = DataContainer_DynArray, .flags = DataFlags_Intern);
+
+  data_reg_struct_t(g_dataReg, AssetPackLoadOrder);
+  data_reg_field_t(g_dataReg, AssetPackLoadOrder, levels, t_AssetPackLevelOrder, .container = DataContainer_DynArray);
   // clang-format on
 
-  g_assetPackMeta = data_meta_t(t_AssetPackHeader);
+  g_assetPackMeta          = data_meta_t(t_AssetPackHeader);
+  g_assetPackLoadOrderMeta = data_meta_t(t_AssetPackLoadOrder);
 }
 
 i8 asset_pack_compare_entry(const void* a, const void* b) {
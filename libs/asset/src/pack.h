@@ -22,6 +22,21 @@ typedef struct {
   DynArray regions; // AssetPackRegion[]
 } AssetPackHeader;
 
+/**
+ * Order in which assets were opened after loading a level, recorded during a profiling run and
+ * used to prefetch the pack regions that a level is going to need.
+ * NOTE: Stores asset ids (instead of regions) to remain valid when the pack is rebuilt.
+ */
+typedef struct {
+  String   level;  // Id of the level asset.
+  DynArray assets; // String[], asset ids in the order they were first opened.
+} AssetPackLevelOrder;
+
+typedef struct {
+  DynArray levels; // AssetPackLevelOrder[].
+} AssetPackLoadOrder;
+
 extern DataMeta g_assetPackMeta;
+extern DataMeta g_assetPackLoadOrderMeta;
 
 i8 asset_pack_compare_entry(const void* a, const void* b);
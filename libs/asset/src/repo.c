@@ -37,6 +37,13 @@ bool asset_repo_stat(
   return false;
 }
 
+bool asset_repo_prepare(AssetRepo* repo, const String id, const AssetRepoLoaderHasher hasher) {
+  if (repo->prepare) {
+    return repo->prepare(repo, id, hasher);
+  }
+  return true;
+}
+
 AssetSource* asset_repo_open(AssetRepo* repo, const String id, const AssetRepoLoaderHasher hasher) {
   return repo->open(repo, id, hasher);
 }
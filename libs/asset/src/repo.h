@@ -55,6 +55,7 @@ typedef enum {
 struct sAssetRepo {
   bool (*path)(AssetRepo*, String id, DynString* out);
   bool (*stat)(AssetRepo*, String id, AssetRepoLoaderHasher, AssetInfo* out);
+  bool (*prepare)(AssetRepo*, String id, AssetRepoLoaderHasher);
   AssetSource* (*open)(AssetRepo*, String id, AssetRepoLoaderHasher);
   bool (*save)(AssetRepo*, String id, String data);
   void (*destroy)(AssetRepo*);
@@ -84,15 +85,41 @@ struct sAssetSource {
 
 String asset_repo_query_result_str(AssetRepoQueryResult);
 
-AssetRepo* asset_repo_create_fs(String rootPath, bool portableCache);
-AssetRepo* asset_repo_create_pack(String filePath);
+AssetRepo* asset_repo_create_fs(String rootPath, bool portableCache, String remoteCacheUrl);
+AssetRepo* asset_repo_create_pack(String filePath, bool recordLoadOrder);
 AssetRepo* asset_repo_create_mem(const AssetMemRecord* records, usize recordCount);
 void       asset_repo_destroy(AssetRepo*);
 
+typedef struct {
+  u32  maps, evictions, prefetches;
+  u64  residentSize; // Size of the mapped regions that are not referenced.
+  bool prefetching;  // Regions of a level are being prefetched.
+} AssetRepoPackStats;
+
+/**
+ * Region residency statistics of a pack repository.
+ * Pre-condition: Repository was created using 'asset_repo_create_pack()'.
+ */
+AssetRepoPackStats asset_repo_pack_stats(AssetRepo*);
+
+/**
+ * Override the maximum size of the resident (mapped but unreferenced) regions.
+ * Pre-condition: Repository was created using 'asset_repo_create_pack()'.
+ */
+void asset_repo_pack_budget_set(AssetRepo*, u64 budget);
+
 bool         asset_repo_path(AssetRepo* repo, String id, DynString* out);
 bool         asset_repo_stat(AssetRepo*, String id, AssetRepoLoaderHasher, AssetInfo* out);
 AssetSource* asset_repo_open(AssetRepo*, String id, AssetRepoLoaderHasher);
 void         asset_repo_close(AssetSource*);
+
+/**
+ * Prepare opening the given asset.
+ * Returns false while the repository is still retrieving the asset (for example from a remote
+ * cache), in which case opening should be retried later.
+ */
+bool asset_repo_prepare(AssetRepo*, String id, AssetRepoLoaderHasher);
+
 bool         asset_repo_save(AssetRepo*, String id, String data);
 bool         asset_repo_save_supported(const AssetRepo*);
 
@@ -1,5 +1,4 @@
 #include "core/alloc.h"
-#include "core/bits.h"
 #include "core/dynstring.h"
 #include "core/file.h"
 #include "core/file_iterator.h"
@@ -9,14 +8,16 @@
 #include "trace/tracer.h"
 
 #include "cache.h"
+#include "checksum_index.h"
 #include "repo.h"
 
 typedef struct {
-  AssetRepo    api;
-  String       rootPath;
-  FileMonitor* monitor;
-  AssetCache*  cache;
-  Allocator*   sourceAlloc; // Allocator for AssetSourceFs objects.
+  AssetRepo           api;
+  String              rootPath;
+  FileMonitor*        monitor;
+  AssetChecksumIndex* checksums;
+  AssetCache*         cache;
+  Allocator*          sourceAlloc; // Allocator for AssetSourceFs objects.
 } AssetRepoFs;
 
 typedef struct {
@@ -61,6 +62,13 @@ static bool asset_source_fs_stat(
   return true;
 }
 
+static bool asset_source_fs_prepare(
+    AssetRepo* repo, const String id, const AssetRepoLoaderHasher loaderHasher) {
+  AssetRepoFs* repoFs = (AssetRepoFs*)repo;
+
+  return asset_cache_prepare(repoFs->cache, id, loaderHasher);
+}
+
 static void asset_source_fs_close(AssetSource* src) {
   AssetSourceFs* srcFs = (AssetSourceFs*)src;
   file_destroy(srcFs->file);
@@ -136,7 +144,7 @@ static AssetSource* asset_source_fs_open_normal(AssetRepoFs* repoFs, const Strin
               .data     = data,
               .format   = asset_format_from_ext(path_extension(id)),
               .flags    = AssetInfoFlags_None,
-              .checksum = bits_crc_32(0, data),
+              .checksum = asset_checksum_index_data(repoFs->checksums, id, &fileInfo, data),
               .modTime  = fileInfo.modTime,
               .close    = asset_source_fs_close,
           },
@@ -194,6 +202,7 @@ static bool asset_repo_fs_changes_poll(AssetRepo* repo, u64* outUserData) {
 
   FileMonitorEvent evt;
   if (file_monitor_poll(repoFs->monitor, &evt)) {
+    asset_checksum_index_invalidate(repoFs->checksums, evt.path);
     *outUserData = evt.userData;
     return true;
   }
@@ -313,7 +322,6 @@ static void asset_repo_fs_cache(
   AssetRepoFs* repoFs = (AssetRepoFs*)repo;
 
   asset_cache_set(repoFs->cache, blob, blobMeta, source, deps, depCount);
-  asset_cache_flush(repoFs->cache); // NOTE: We could batch flushes to be more efficient.
 }
 
 static usize asset_repo_fs_cache_deps(
@@ -331,12 +339,14 @@ static void asset_repo_fs_destroy(AssetRepo* repo) {
   string_free(g_allocHeap, repoFs->rootPath);
   file_monitor_destroy(repoFs->monitor);
   asset_cache_destroy(repoFs->cache);
+  asset_checksum_index_destroy(repoFs->checksums); // NOTE: Used by the cache; destroy after it.
   alloc_block_destroy(repoFs->sourceAlloc);
 
   alloc_free_t(g_allocHeap, repoFs);
 }
 
-AssetRepo* asset_repo_create_fs(const String rootPath, const bool portableCache) {
+AssetRepo* asset_repo_create_fs(
+    const String rootPath, const bool portableCache, const String remoteCacheUrl) {
   if (file_stat_path_sync(rootPath).type != FileType_Directory) {
     log_e("Assets directory not found", log_param("path", fmt_path(rootPath)));
     return null;
@@ -347,12 +357,14 @@ AssetRepo* asset_repo_create_fs(const String rootPath, const bool portableCache)
   if (portableCache) {
     cacheFlags |= AssetCacheFlags_Portable;
   }
+  AssetChecksumIndex* checksums = asset_checksum_index_create(g_allocHeap, rootPath);
 
   *repo = (AssetRepoFs){
       .api =
           {
               .path         = asset_source_fs_path,
               .stat         = asset_source_fs_stat,
+              .prepare      = asset_source_fs_prepare,
               .open         = asset_source_fs_open,
               .save         = asset_repo_fs_save,
               .destroy      = asset_repo_fs_destroy,
@@ -365,14 +377,16 @@ AssetRepo* asset_repo_create_fs(const String rootPath, const bool portableCache)
       .sourceAlloc = alloc_block_create(g_allocHeap, sizeof(AssetSourceFs), alignof(AssetSourceFs)),
       .rootPath    = string_dup(g_allocHeap, rootPath),
       .monitor     = file_monitor_create(g_allocHeap, rootPath, FileMonitorFlags_None),
-      .cache       = asset_cache_create(g_allocHeap, rootPath, cacheFlags),
+      .checksums   = checksums,
+      .cache = asset_cache_create(g_allocHeap, rootPath, cacheFlags, checksums, remoteCacheUrl),
   };
 
   log_i(
       "Asset repository created",
       log_param("type", fmt_text_lit("file-system")),
       log_param("root", fmt_path(rootPath)),
-      log_param("portable-cache", fmt_bool(portableCache)));
+      log_param("portable-cache", fmt_bool(portableCache)),
+      log_param("remote-cache", fmt_text(remoteCacheUrl)));
 
   return (AssetRepo*)repo;
 }
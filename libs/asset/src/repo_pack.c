@@ -1,11 +1,16 @@
 #include "core/alloc.h"
 #include "core/bits.h"
+#include "core/compare.h"
 #include "core/diag.h"
 #include "core/dynarray.h"
+#include "core/dynstring.h"
 #include "core/file.h"
+#include "core/format.h"
+#include "core/stringtable.h"
 #include "core/thread.h"
 #include "data/read.h"
 #include "data/utils.h"
+#include "data/write.h"
 #include "log/logger.h"
 
 #include "pack.h"
@@ -17,19 +22,52 @@
 
 #define asset_pack_header_size (usize_mebibyte)
 
+/**
+ * Regions that are no longer referenced stay mapped (resident) until the total size of the resident
+ * regions exceeds the budget, at which point the least recently used regions are unmapped until the
+ * size drops below the low watermark (three quarters of the budget). The hysteresis avoids
+ * thrashing map / unmap when assets of the same region are repeatedly loaded and unloaded.
+ */
+#define asset_pack_resident_budget (256 * usize_mebibyte)
+#define asset_pack_evict_max 16
+
+/**
+ * Mapping (and validating) regions is done without holding the file mutex, threads that need a
+ * region that is being mapped wait for it to complete.
+ */
 typedef struct {
   String mapping;
   i32    refCount;
   u32    mapCounter;
+  u64    lastUse;    // Use tick of the last release; protected by the file mutex.
+  bool   resident;   // Mapped while not referenced; protected by the file mutex.
+  bool   mapPending; // Region is being mapped; protected by the file mutex.
 } AssetRegionState;
 
 typedef struct {
   AssetRepo         api;
   File*             file;
   ThreadMutex       fileMutex;
+  ThreadCondition   mapCondition; // Signaled when a pending region mapping completes.
   AssetRegionState* regions;
   AssetPackHeader   header;
   Allocator*        sourceAlloc; // Allocator for AssetSourcePack objects.
+
+  // Region residency, protected by the file mutex.
+  u64 useTick, residentSize, residentBudget;
+  u32 evictCounter, prefetchCounter;
+
+  // Load-order recording and prefetching, protected by the order mutex.
+  ThreadMutex        orderMutex;
+  ThreadCondition    prefetchWake;
+  ThreadHandle       prefetchThread;
+  bool               prefetchShutdown, orderRecord;
+  String             orderPath;
+  AssetPackLoadOrder order;
+  u32                orderRecordLevel; // Index of the level that is being recorded.
+  DynArray           orderRecordSeen;  // StringHash[], assets recorded for the current level.
+  u32                prefetchLevel;    // Index of the level that is being prefetched.
+  u32                prefetchCursor;
 } AssetRepoPack;
 
 typedef struct {
@@ -64,6 +102,94 @@ static const AssetPackEntry* asset_repo_pack_find(AssetRepoPack* pack, const Str
   return entry;
 }
 
+/**
+ * Map (and optionally validate) the given region.
+ * NOTE: Called without holding the file mutex; the region is marked as pending by the caller.
+ */
+static String asset_repo_pack_map(AssetRepoPack* repo, const u16 region) {
+  const AssetPackRegion* info = dynarray_at_t(&repo->header.regions, region, AssetPackRegion);
+  if (!info->size) {
+    diag_crash_msg("Corrupt pack file");
+  }
+  String mapping;
+  if (file_map(repo->file, info->offset, info->size, FileHints_Prefetch, &mapping)) {
+    diag_crash_msg("Failed to map pack region");
+  }
+#if VOLO_ASSET_PACK_LOGGING
+  log_d(
+      "Asset pack region mapped",
+      log_param("region", fmt_int(region)),
+      log_param("size", fmt_size(mapping.size)));
+#endif
+#if VOLO_ASSET_PACK_VALIDATE
+  if (UNLIKELY(bits_crc_32(0, mapping) != info->checksum)) {
+    diag_crash_msg("Pack region checksum failed");
+  }
+#endif
+  return mapping;
+}
+
+/**
+ * Complete a pending region mapping and wake up the threads waiting for it.
+ * Pre-condition: repo->fileMutex is held by this thread.
+ */
+static void
+asset_repo_pack_map_complete(AssetRepoPack* repo, const u16 region, const String mapping) {
+  AssetRegionState* state = repo->regions + region;
+  diag_assert(state->mapPending);
+  state->mapping    = mapping;
+  state->mapPending = false;
+  ++state->mapCounter;
+  thread_cond_broadcast(repo->mapCondition);
+}
+
+static void asset_repo_pack_unmap(AssetRepoPack* repo, const String* mappings, const u32 count) {
+  for (u32 i = 0; i != count; ++i) {
+    if (file_unmap(repo->file, mappings[i])) {
+      diag_crash_msg("Failed to unmap pack region");
+    }
+  }
+}
+
+/**
+ * Evict the least recently used resident regions until the resident size drops below the target.
+ * The mappings of the evicted regions are written to the output array and should be unmapped by the
+ * caller after releasing the file mutex; returns the amount of evicted regions.
+ * Pre-condition: repo->fileMutex is held by this thread.
+ */
+static u32 asset_repo_pack_evict(
+    AssetRepoPack* repo, const u64 targetSize, String out[PARAM_ARRAY_SIZE(asset_pack_evict_max)]) {
+  const u32 regionCount = (u32)repo->header.regions.size;
+  u32       outCount    = 0;
+  while (repo->residentSize > targetSize && outCount != asset_pack_evict_max) {
+    u32 lruRegion = sentinel_u32;
+    u64 lruTick   = u64_max;
+    for (u32 i = 0; i != regionCount; ++i) {
+      AssetRegionState* state = repo->regions + i;
+      if (!state->resident || thread_atomic_load_i32(&state->refCount)) {
+        continue; // Not resident or being re-acquired.
+      }
+      if (state->lastUse < lruTick) {
+        lruRegion = i;
+        lruTick   = state->lastUse;
+      }
+    }
+    if (sentinel_check(lruRegion)) {
+      break; // All resident regions are being re-acquired.
+    }
+    AssetRegionState* state = repo->regions + lruRegion;
+    out[outCount++]         = state->mapping;
+    state->mapping          = string_empty;
+    state->resident         = false;
+    repo->residentSize -= out[outCount - 1].size;
+    ++repo->evictCounter;
+#if VOLO_ASSET_PACK_LOGGING
+    log_d("Asset pack region evicted", log_param("region", fmt_int(lruRegion)));
+#endif
+  }
+  return outCount;
+}
+
 static String asset_repo_pack_acquire(AssetRepoPack* repo, const u16 region) {
   if (UNLIKELY(region >= repo->header.regions.size)) {
     diag_crash_msg("Corrupt pack file");
@@ -73,27 +199,20 @@ static String asset_repo_pack_acquire(AssetRepoPack* repo, const u16 region) {
 
   if (!prevRefCount || string_is_empty(state->mapping)) {
     thread_mutex_lock(repo->fileMutex);
+    while (state->mapPending) {
+      thread_cond_wait(repo->mapCondition, repo->fileMutex); // Being mapped by another thread.
+    }
     if (string_is_empty(state->mapping)) {
-      const AssetPackRegion* info = dynarray_at_t(&repo->header.regions, region, AssetPackRegion);
-      if (!info->size) {
-        diag_crash_msg("Corrupt pack file");
-      }
-      if (file_map(repo->file, info->offset, info->size, FileHints_Prefetch, &state->mapping)) {
-        diag_crash_msg("Failed to map pack region");
-      }
-      ++state->mapCounter;
-#if VOLO_ASSET_PACK_LOGGING
-      log_d(
-          "Asset pack region mapped",
-          log_param("region", fmt_int(region)),
-          log_param("size", fmt_size(state->mapping.size)),
-          log_param("counter", fmt_int(state->mapCounter)));
-#endif
-#if VOLO_ASSET_PACK_VALIDATE
-      if (UNLIKELY(bits_crc_32(0, state->mapping) != info->checksum)) {
-        diag_crash_msg("Pack region checksum failed");
-      }
-#endif
+      state->mapPending = true;
+      thread_mutex_unlock(repo->fileMutex);
+
+      const String mapping = asset_repo_pack_map(repo, region);
+
+      thread_mutex_lock(repo->fileMutex);
+      asset_repo_pack_map_complete(repo, region, mapping);
+    } else if (state->resident) {
+      state->resident = false; // Region was still mapped; no need to map it again.
+      repo->residentSize -= state->mapping.size;
     }
     thread_mutex_unlock(repo->fileMutex);
   }
@@ -106,19 +225,209 @@ static void asset_repo_pack_release(AssetRepoPack* repo, const u16 region) {
   diag_assert_msg(prevRefCount, "Pack region double release");
 
   if (prevRefCount == 1) {
+    String toUnmap[asset_pack_evict_max];
+    u32    toUnmapCount = 0;
+
     thread_mutex_lock(repo->fileMutex);
-    if (!thread_atomic_load_i32(&state->refCount) && !string_is_empty(state->mapping)) {
-      const String toUnmap = state->mapping;
-      state->mapping       = string_empty;
-      if (file_unmap(repo->file, toUnmap)) {
-        diag_crash_msg("Failed to unmap pack region");
+    const bool mapped = !string_is_empty(state->mapping);
+    if (!thread_atomic_load_i32(&state->refCount) && mapped && !state->resident) {
+      state->resident = true;
+      state->lastUse  = ++repo->useTick;
+      repo->residentSize += state->mapping.size;
+      if (repo->residentSize > repo->residentBudget) {
+        const u64 residentLow = repo->residentBudget / 4 * 3;
+        toUnmapCount          = asset_repo_pack_evict(repo, residentLow, toUnmap);
       }
-#if VOLO_ASSET_PACK_LOGGING
-      log_d("Asset pack region unmapped", log_param("region", fmt_int(region)));
-#endif
     }
     thread_mutex_unlock(repo->fileMutex);
+
+    asset_repo_pack_unmap(repo, toUnmap, toUnmapCount);
+  }
+}
+
+/**
+ * Map the region containing the given asset as a resident (unreferenced) region.
+ * NOTE: Returns false when the residency budget is exhausted.
+ */
+static bool asset_repo_pack_prefetch(AssetRepoPack* repo, const String id) {
+  const AssetPackEntry* entry = asset_repo_pack_find(repo, id);
+  if (!entry || entry->region >= repo->header.regions.size) {
+    return true; // Asset is no longer part of the pack; skip it.
+  }
+  const u16              region = entry->region;
+  const AssetPackRegion* info   = dynarray_at_t(&repo->header.regions, region, AssetPackRegion);
+  AssetRegionState*      state  = repo->regions + region;
+
+  bool budgetLeft = true;
+  thread_mutex_lock(repo->fileMutex);
+  if (string_is_empty(state->mapping) && !state->mapPending) {
+    // NOTE: Never evict regions to make room for speculative prefetches.
+    if (repo->residentSize + info->size > repo->residentBudget) {
+      budgetLeft = false;
+    } else {
+      state->mapPending = true;
+      repo->residentSize += info->size; // Reserve the budget while mapping.
+      thread_mutex_unlock(repo->fileMutex);
+
+      const String mapping = asset_repo_pack_map(repo, region);
+
+      thread_mutex_lock(repo->fileMutex);
+      asset_repo_pack_map_complete(repo, region, mapping);
+      state->resident = true;
+      state->lastUse  = ++repo->useTick;
+      ++repo->prefetchCounter;
+    }
+  }
+  thread_mutex_unlock(repo->fileMutex);
+  return budgetLeft;
+}
+
+static void asset_repo_pack_prefetch_thread(void* data) {
+  AssetRepoPack* repo = data;
+
+  thread_mutex_lock(repo->orderMutex);
+  while (!repo->prefetchShutdown) {
+    if (sentinel_check(repo->prefetchLevel)) {
+      thread_cond_wait(repo->prefetchWake, repo->orderMutex);
+      continue;
+    }
+    const AssetPackLevelOrder* level =
+        dynarray_at_t(&repo->order.levels, repo->prefetchLevel, AssetPackLevelOrder);
+    if (repo->prefetchCursor >= level->assets.size) {
+      repo->prefetchLevel = sentinel_u32; // Finished prefetching the level.
+      continue;
+    }
+    // NOTE: Asset ids are interned so they remain valid after releasing the lock.
+    const String assetId = *dynarray_at_t(&level->assets, repo->prefetchCursor++, String);
+    thread_mutex_unlock(repo->orderMutex);
+
+    const bool budgetLeft = asset_repo_pack_prefetch(repo, assetId);
+
+    thread_mutex_lock(repo->orderMutex);
+    if (!budgetLeft) {
+      repo->prefetchLevel = sentinel_u32;
+    }
+  }
+  thread_mutex_unlock(repo->orderMutex);
+}
+
+static u32 asset_repo_pack_order_find(AssetRepoPack* repo, const String level) {
+  for (u32 i = 0; i != repo->order.levels.size; ++i) {
+    if (string_eq(dynarray_at_t(&repo->order.levels, i, AssetPackLevelOrder)->level, level)) {
+      return i;
+    }
+  }
+  return sentinel_u32;
+}
+
+/**
+ * Pre-condition: repo->orderMutex is held by this thread.
+ */
+static void asset_repo_pack_order_record(AssetRepoPack* repo, const AssetPackEntry* entry) {
+  const bool isLevel = entry->format == AssetFormat_Level;
+  if (isLevel) {
+    // Start a new recording for the level; replaces any previous recording of the same level.
+    u32 levelIndex = asset_repo_pack_order_find(repo, entry->id);
+    if (sentinel_check(levelIndex)) {
+      levelIndex = (u32)repo->order.levels.size;
+
+      *dynarray_push_t(&repo->order.levels, AssetPackLevelOrder) = (AssetPackLevelOrder){
+          .level  = stringtable_intern(g_stringtable, entry->id),
+          .assets = dynarray_create_t(g_allocHeap, String, 256),
+      };
+    } else {
+      dynarray_clear(&dynarray_at_t(&repo->order.levels, levelIndex, AssetPackLevelOrder)->assets);
+    }
+    repo->orderRecordLevel = levelIndex;
+    dynarray_clear(&repo->orderRecordSeen);
+    return;
+  }
+  if (sentinel_check(repo->orderRecordLevel)) {
+    return; // No level loaded yet.
+  }
+  const StringHash idHash = entry->idHash;
+  DynArray*        seen   = &repo->orderRecordSeen;
+  if (dynarray_search_binary(seen, compare_stringhash, &idHash)) {
+    return; // Already recorded for this level.
+  }
+  *dynarray_insert_sorted_t(seen, StringHash, compare_stringhash, &idHash) = idHash;
+
+  AssetPackLevelOrder* level =
+      dynarray_at_t(&repo->order.levels, repo->orderRecordLevel, AssetPackLevelOrder);
+  *dynarray_push_t(&level->assets, String) = entry->id; // NOTE: Pack entry ids are interned.
+}
+
+static void asset_repo_pack_order_open(AssetRepoPack* repo, const AssetPackEntry* entry) {
+  thread_mutex_lock(repo->orderMutex);
+  if (repo->orderRecord) {
+    asset_repo_pack_order_record(repo, entry);
+  } else if (repo->prefetchThread && entry->format == AssetFormat_Level) {
+    const u32 levelIndex = asset_repo_pack_order_find(repo, entry->id);
+    if (!sentinel_check(levelIndex)) {
+      repo->prefetchLevel  = levelIndex;
+      repo->prefetchCursor = 0;
+      thread_cond_signal(repo->prefetchWake);
+    }
+  }
+  thread_mutex_unlock(repo->orderMutex);
+}
+
+static void asset_repo_pack_order_load(AssetRepoPack* repo) {
+  File* file;
+  if (file_create(g_allocHeap, repo->orderPath, FileMode_Open, FileAccess_Read, &file)) {
+    return; // No load-order recorded for this pack.
+  }
+  String data;
+  if (file_map(file, 0 /* offset */, 0 /* size */, FileHints_Prefetch, &data)) {
+    file_destroy(file);
+    return;
   }
+  AssetPackLoadOrder order;
+  DataReadResult     readRes;
+  data_read_bin(
+      g_dataReg,
+      data,
+      g_allocHeap,
+      g_assetPackLoadOrderMeta,
+      DataReadFlags_None,
+      mem_var(order),
+      &readRes);
+
+  if (LIKELY(!readRes.error)) {
+    data_destroy(g_dataReg, g_allocHeap, g_assetPackLoadOrderMeta, mem_var(repo->order));
+    repo->order = order;
+    log_i(
+        "Asset pack load-order loaded",
+        log_param("path", fmt_path(repo->orderPath)),
+        log_param("levels", fmt_int(order.levels.size)));
+  } else {
+    log_w(
+        "Failed to read asset pack load-order",
+        log_param("path", fmt_path(repo->orderPath)),
+        log_param("error", fmt_text(readRes.errorMsg)));
+  }
+  file_unmap(file, data);
+  file_destroy(file);
+}
+
+static void asset_repo_pack_order_save(AssetRepoPack* repo) {
+  DynString blobBuffer = dynstring_create(g_allocHeap, 4 * usize_kibibyte);
+  data_write_bin(g_dataReg, &blobBuffer, g_assetPackLoadOrderMeta, mem_var(repo->order));
+
+  const String     blob    = dynstring_view(&blobBuffer);
+  const FileResult fileRes = file_write_to_path_atomic(repo->orderPath, blob);
+  if (fileRes == FileResult_Success) {
+    log_i(
+        "Asset pack load-order saved",
+        log_param("path", fmt_path(repo->orderPath)),
+        log_param("levels", fmt_int(repo->order.levels.size)));
+  } else {
+    log_w(
+        "Failed to write asset pack load-order",
+        log_param("path", fmt_path(repo->orderPath)),
+        log_param("error", fmt_text(file_result_str(fileRes))));
+  }
+  dynstring_destroy(&blobBuffer);
 }
 
 static bool asset_source_pack_stat(
@@ -155,6 +464,8 @@ asset_source_pack_open(AssetRepo* repo, const String id, const AssetRepoLoaderHa
     log_w("File missing from pack file", log_param("id", fmt_text(id)));
     return null;
   }
+  asset_repo_pack_order_open(repoPack, entry);
+
   const String regionMem = asset_repo_pack_acquire(repoPack, entry->region);
   if (UNLIKELY((entry->offset + entry->size) > regionMem.size)) {
     diag_crash_msg("Corrupt pack file");
@@ -195,8 +506,33 @@ static AssetRepoQueryResult asset_repo_pack_query(
 static void asset_repo_pack_destroy(AssetRepo* repo) {
   AssetRepoPack* repoPack = (AssetRepoPack*)repo;
 
-  file_destroy(repoPack->file);
+  if (repoPack->prefetchThread) {
+    thread_mutex_lock(repoPack->orderMutex);
+    repoPack->prefetchShutdown = true;
+    thread_cond_signal(repoPack->prefetchWake);
+    thread_mutex_unlock(repoPack->orderMutex);
+    thread_join(repoPack->prefetchThread);
+  }
+  if (repoPack->orderRecord) {
+    asset_repo_pack_order_save(repoPack);
+  }
+
+  const AssetRepoPackStats stats = asset_repo_pack_stats(repo);
+  log_i(
+      "Asset pack residency stats",
+      log_param("maps", fmt_int(stats.maps)),
+      log_param("evictions", fmt_int(stats.evictions)),
+      log_param("prefetches", fmt_int(stats.prefetches)),
+      log_param("resident", fmt_size(stats.residentSize)));
+
+  file_destroy(repoPack->file); // NOTE: Also unmaps all regions that are still mapped.
   thread_mutex_destroy(repoPack->fileMutex);
+  thread_cond_destroy(repoPack->mapCondition);
+  thread_mutex_destroy(repoPack->orderMutex);
+  thread_cond_destroy(repoPack->prefetchWake);
+  string_free(g_allocHeap, repoPack->orderPath);
+  data_destroy(g_dataReg, g_allocHeap, g_assetPackLoadOrderMeta, mem_var(repoPack->order));
+  dynarray_destroy(&repoPack->orderRecordSeen);
   alloc_free_array_t(g_allocHeap, repoPack->regions, repoPack->header.regions.size);
   data_destroy(g_dataReg, g_allocHeap, g_assetPackMeta, mem_var(repoPack->header));
 
@@ -235,7 +571,7 @@ static bool asset_repo_pack_read_header(File* file, const String filePath, Asset
   return true;
 }
 
-AssetRepo* asset_repo_create_pack(const String filePath) {
+AssetRepo* asset_repo_create_pack(const String filePath, const bool recordLoadOrder) {
   File*      file;
   FileResult fileRes;
   if ((fileRes = file_create(g_allocHeap, filePath, FileMode_Open, FileAccess_Read, &file))) {
@@ -256,7 +592,8 @@ AssetRepo* asset_repo_create_pack(const String filePath) {
     file_destroy(file);
     return null;
   }
-  AssetRepoPack* repo = alloc_alloc_t(g_allocHeap, AssetRepoPack);
+  AssetRepoPack* repo      = alloc_alloc_t(g_allocHeap, AssetRepoPack);
+  const String   orderPath = fmt_write_scratch("{}.order", fmt_text(filePath));
 
   const u32         regionCount = (u32)header.regions.size;
   AssetRegionState* regions     = alloc_array_t(g_allocHeap, AssetRegionState, regionCount);
@@ -270,12 +607,22 @@ AssetRepo* asset_repo_create_pack(const String filePath) {
               .destroy = asset_repo_pack_destroy,
               .query   = asset_repo_pack_query,
           },
-      .file      = file,
-      .fileMutex = thread_mutex_create(g_allocHeap),
-      .regions   = regions,
-      .header    = header,
+      .file           = file,
+      .fileMutex      = thread_mutex_create(g_allocHeap),
+      .mapCondition   = thread_cond_create(g_allocHeap),
+      .regions        = regions,
+      .header         = header,
+      .residentBudget = asset_pack_resident_budget,
       .sourceAlloc =
           alloc_block_create(g_allocHeap, sizeof(AssetSourcePack), alignof(AssetSourcePack)),
+      .orderMutex       = thread_mutex_create(g_allocHeap),
+      .prefetchWake     = thread_cond_create(g_allocHeap),
+      .orderRecord      = recordLoadOrder,
+      .orderPath        = string_dup(g_allocHeap, orderPath),
+      .order            = {.levels = dynarray_create_t(g_allocHeap, AssetPackLevelOrder, 8)},
+      .orderRecordLevel = sentinel_u32,
+      .orderRecordSeen  = dynarray_create_t(g_allocHeap, StringHash, 256),
+      .prefetchLevel    = sentinel_u32,
   };
 
   log_i(
@@ -289,5 +636,44 @@ AssetRepo* asset_repo_create_pack(const String filePath) {
   asset_repo_pack_acquire(repo, 0 /* small assets region */);
 #endif
 
+  if (!recordLoadOrder) {
+    asset_repo_pack_order_load(repo);
+  }
+  if (repo->order.levels.size) {
+    const String         threadName = string_lit("volo_prefetch");
+    const ThreadPriority threadPrio = ThreadPriority_Low;
+    const ThreadRoutine  routine    = asset_repo_pack_prefetch_thread;
+    repo->prefetchThread            = thread_start(routine, repo, threadName, threadPrio);
+  }
+
   return (AssetRepo*)repo;
 }
+
+AssetRepoPackStats asset_repo_pack_stats(AssetRepo* repo) {
+  diag_assert(repo->destroy == asset_repo_pack_destroy);
+  AssetRepoPack* repoPack = (AssetRepoPack*)repo;
+
+  AssetRepoPackStats res = {0};
+  thread_mutex_lock(repoPack->fileMutex);
+  for (u32 i = 0; i != repoPack->header.regions.size; ++i) {
+    res.maps += repoPack->regions[i].mapCounter;
+  }
+  res.evictions    = repoPack->evictCounter;
+  res.prefetches   = repoPack->prefetchCounter;
+  res.residentSize = repoPack->residentSize;
+  thread_mutex_unlock(repoPack->fileMutex);
+
+  thread_mutex_lock(repoPack->orderMutex);
+  res.prefetching = !sentinel_check(repoPack->prefetchLevel);
+  thread_mutex_unlock(repoPack->orderMutex);
+  return res;
+}
+
+void asset_repo_pack_budget_set(AssetRepo* repo, const u64 budget) {
+  diag_assert(repo->destroy == asset_repo_pack_destroy);
+  AssetRepoPack* repoPack = (AssetRepoPack*)repo;
+
+  thread_mutex_lock(repoPack->fileMutex);
+  repoPack->residentBudget = budget;
+  thread_mutex_unlock(repoPack->fileMutex);
+}
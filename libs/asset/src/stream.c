@@ -0,0 +1,317 @@
+#include "core/alloc.h"
+#include "core/bits.h"
+#include "core/diag.h"
+#include "core/dynarray.h"
+#include "core/format.h"
+#include "core/math.h"
+#include "core/thread.h"
+#include "ecs/entity.h"
+
+#include "stream.h"
+
+#define stream_ctx_align 16
+
+typedef struct {
+  EcsEntityId        asset;
+  AssetStreamRoutine routine;
+  AssetStreamFinish  finish;
+  Mem                ctx;
+  AssetPriority      priority;
+  u64                seq; // Used to process requests with equal priorities in first-in first-out.
+  bool               cancelled;
+} AssetStreamRequest;
+
+typedef struct {
+  EcsEntityId   asset;
+  AssetPriority priority;
+} AssetStreamHint;
+
+struct sAssetStreamer {
+  Allocator* alloc;
+
+  ThreadMutex     workerMutex;
+  ThreadCondition workerWakeCondition;
+  ThreadHandle*   workerThreads;
+  bool            workerShutdown;
+  u32             workerCount;
+
+  u64      nextSeq;
+  DynArray pending;  // AssetStreamRequest*[].
+  DynArray running;  // AssetStreamRequest*[].
+  DynArray finished; // AssetStreamRequest*[].
+  DynArray hints;    // AssetStreamHint[], kept sorted on the asset.
+};
+
+static i8 stream_compare_hint(const void* a, const void* b) {
+  const EcsEntityId* assetA = field_ptr(a, AssetStreamHint, asset);
+  const EcsEntityId* assetB = field_ptr(b, AssetStreamHint, asset);
+  return ecs_compare_entity(assetA, assetB);
+}
+
+static AssetPriority stream_hint(AssetStreamer* s, const EcsEntityId asset) {
+  const AssetStreamHint  tgt  = {.asset = asset};
+  const AssetStreamHint* hint = dynarray_search_binary(&s->hints, stream_compare_hint, &tgt);
+  return hint ? hint->priority : AssetPriority_Normal;
+}
+
+static bool stream_request_before(const AssetStreamRequest* a, const AssetStreamRequest* b) {
+  if (a->priority != b->priority) {
+    return a->priority > b->priority;
+  }
+  return a->seq < b->seq;
+}
+
+/**
+ * Take the highest priority pending request and mark it as running.
+ * NOTE: Has to be called while holding the worker mutex.
+ */
+static AssetStreamRequest* stream_take(AssetStreamer* s) {
+  if (!s->pending.size) {
+    return null;
+  }
+  AssetStreamRequest** pending = dynarray_begin_t(&s->pending, AssetStreamRequest*);
+  usize                best    = 0;
+  for (usize i = 1; i != s->pending.size; ++i) {
+    if (stream_request_before(pending[i], pending[best])) {
+      best = i;
+    }
+  }
+  AssetStreamRequest* req = pending[best];
+  dynarray_remove(&s->pending, best, 1);
+  *dynarray_push_t(&s->running, AssetStreamRequest*) = req;
+  return req;
+}
+
+static void stream_running_remove(AssetStreamer* s, const AssetStreamRequest* req) {
+  for (usize i = 0; i != s->running.size; ++i) {
+    if (*dynarray_at_t(&s->running, i, AssetStreamRequest*) == req) {
+      dynarray_remove_unordered(&s->running, i, 1);
+      return;
+    }
+  }
+  diag_crash_msg("Stream request is not running");
+}
+
+static void stream_worker_thread(void* data) {
+  AssetStreamer* s = data;
+
+  thread_mutex_lock(s->workerMutex);
+  while (!s->workerShutdown) {
+    AssetStreamRequest* req = stream_take(s);
+    if (!req) {
+      thread_cond_wait(s->workerWakeCondition, s->workerMutex);
+      continue;
+    }
+    thread_mutex_unlock(s->workerMutex);
+
+    req->routine(req->ctx.ptr);
+
+    thread_mutex_lock(s->workerMutex);
+    stream_running_remove(s, req);
+    *dynarray_push_t(&s->finished, AssetStreamRequest*) = req;
+  }
+  thread_mutex_unlock(s->workerMutex);
+}
+
+static Mem stream_ctx_dup(AssetStreamer* s, const Mem ctx) {
+  if (!ctx.size) {
+    return mem_empty;
+  }
+  const Mem res = alloc_alloc(s->alloc, bits_align(ctx.size, stream_ctx_align), stream_ctx_align);
+  mem_cpy(res, ctx);
+  return res;
+}
+
+static void stream_request_destroy(AssetStreamer* s, AssetStreamRequest* req) {
+  if (mem_valid(req->ctx)) {
+    alloc_free(s->alloc, req->ctx);
+  }
+  alloc_free_t(s->alloc, req);
+}
+
+AssetStreamer* asset_streamer_create(Allocator* alloc, u32 workerCount) {
+  workerCount = math_max(1, workerCount);
+
+  AssetStreamer* s = alloc_alloc_t(alloc, AssetStreamer);
+
+  *s = (AssetStreamer){
+      .alloc = alloc,
+
+      .workerMutex         = thread_mutex_create(g_allocHeap),
+      .workerWakeCondition = thread_cond_create(g_allocHeap),
+      .workerThreads       = alloc_array_t(alloc, ThreadHandle, workerCount),
+      .workerCount         = workerCount,
+
+      .pending  = dynarray_create_t(alloc, AssetStreamRequest*, 64),
+      .running  = dynarray_create_t(alloc, AssetStreamRequest*, workerCount),
+      .finished = dynarray_create_t(alloc, AssetStreamRequest*, 64),
+      .hints    = dynarray_create_t(alloc, AssetStreamHint, 64),
+  };
+
+  // Spawn workers.
+  for (u32 i = 0; i != workerCount; ++i) {
+    const String         threadName = fmt_write_scratch("volo_stream_{}", fmt_int(i));
+    const ThreadPriority threadPrio = ThreadPriority_Low;
+    s->workerThreads[i] = thread_start(stream_worker_thread, (void*)s, threadName, threadPrio);
+  }
+
+  return s;
+}
+
+void asset_streamer_destroy(AssetStreamer* s) {
+  // Signal workers to shutdown.
+  thread_mutex_lock(s->workerMutex);
+  s->workerShutdown = true;
+  thread_cond_broadcast(s->workerWakeCondition);
+  thread_mutex_unlock(s->workerMutex);
+
+  // Wait for workers to shutdown.
+  for (u32 i = 0; i != s->workerCount; ++i) {
+    thread_join(s->workerThreads[i]);
+  }
+  diag_assert(!s->running.size);
+
+  // Cancel all outstanding requests.
+  DynArray* queues[] = {&s->finished, &s->pending};
+  for (u32 i = 0; i != 2; ++i) {
+    for (usize j = 0; j != queues[i]->size; ++j) {
+      AssetStreamRequest* req = *dynarray_at_t(queues[i], j, AssetStreamRequest*);
+      req->finish(null, null, req->asset, req->ctx.ptr, true /* cancelled */);
+      stream_request_destroy(s, req);
+    }
+    dynarray_destroy(queues[i]);
+  }
+  dynarray_destroy(&s->running);
+  dynarray_destroy(&s->hints);
+
+  // Cleanup worker data.
+  thread_mutex_destroy(s->workerMutex);
+  thread_cond_destroy(s->workerWakeCondition);
+  alloc_free_array_t(s->alloc, s->workerThreads, s->workerCount);
+
+  alloc_free_t(s->alloc, s);
+}
+
+void asset_streamer_push(
+    AssetStreamer*           s,
+    const EcsEntityId        asset,
+    const AssetStreamRoutine routine,
+    const AssetStreamFinish  finish,
+    const Mem                ctx) {
+  diag_assert(finish);
+
+  AssetStreamRequest* req = alloc_alloc_t(s->alloc, AssetStreamRequest);
+  *req                    = (AssetStreamRequest){
+      .asset   = asset,
+      .routine = routine,
+      .finish  = finish,
+      .ctx     = stream_ctx_dup(s, ctx),
+  };
+
+  thread_mutex_lock(s->workerMutex);
+  if (routine) {
+    req->priority                                       = stream_hint(s, asset);
+    req->seq                                            = s->nextSeq++;
+    *dynarray_push_t(&s->pending, AssetStreamRequest*) = req;
+    thread_cond_signal(s->workerWakeCondition);
+  } else {
+    // Nothing to execute in the background; directly mark it as finished.
+    *dynarray_push_t(&s->finished, AssetStreamRequest*) = req;
+  }
+  thread_mutex_unlock(s->workerMutex);
+}
+
+void asset_streamer_prioritize(
+    AssetStreamer* s, const EcsEntityId asset, const AssetPriority priority) {
+  thread_mutex_lock(s->workerMutex);
+  {
+    const AssetStreamHint tgt = {.asset = asset};
+    AssetStreamHint* hint = dynarray_find_or_insert_sorted(&s->hints, stream_compare_hint, &tgt);
+    hint->asset           = asset;
+    hint->priority        = priority;
+
+    for (usize i = 0; i != s->pending.size; ++i) {
+      AssetStreamRequest* req = *dynarray_at_t(&s->pending, i, AssetStreamRequest*);
+      if (req->asset == asset) {
+        req->priority = priority;
+      }
+    }
+  }
+  thread_mutex_unlock(s->workerMutex);
+}
+
+void asset_streamer_forget(AssetStreamer* s, const EcsEntityId asset) {
+  thread_mutex_lock(s->workerMutex);
+  {
+    const AssetStreamHint  tgt  = {.asset = asset};
+    const AssetStreamHint* hint = dynarray_search_binary(&s->hints, stream_compare_hint, &tgt);
+    if (hint) {
+      const usize index = hint - dynarray_begin_t(&s->hints, AssetStreamHint);
+      dynarray_remove(&s->hints, index, 1);
+    }
+  }
+  thread_mutex_unlock(s->workerMutex);
+}
+
+bool asset_streamer_cancel(AssetStreamer* s, const EcsEntityId asset) {
+  bool found = false;
+  thread_mutex_lock(s->workerMutex);
+  {
+    // Pending requests are directly moved to the finished queue.
+    for (usize i = s->pending.size; i-- != 0;) {
+      AssetStreamRequest* req = *dynarray_at_t(&s->pending, i, AssetStreamRequest*);
+      if (req->asset == asset) {
+        found          = true;
+        req->cancelled = true;
+        dynarray_remove(&s->pending, i, 1);
+        *dynarray_push_t(&s->finished, AssetStreamRequest*) = req;
+      }
+    }
+    // Running and finished requests are marked as cancelled.
+    DynArray* queues[] = {&s->running, &s->finished};
+    for (u32 i = 0; i != 2; ++i) {
+      for (usize j = 0; j != queues[i]->size; ++j) {
+        AssetStreamRequest* req = *dynarray_at_t(queues[i], j, AssetStreamRequest*);
+        if (req->asset == asset) {
+          found          = true;
+          req->cancelled = true;
+        }
+      }
+    }
+  }
+  thread_mutex_unlock(s->workerMutex);
+  return found;
+}
+
+bool asset_streamer_finish(
+    AssetStreamer*            s,
+    EcsWorld*                 world,
+    const AssetImportEnvComp* importEnv,
+    AssetStreamResult*        out) {
+  AssetStreamRequest* req = null;
+  thread_mutex_lock(s->workerMutex);
+  if (s->finished.size) {
+    req = *dynarray_at_t(&s->finished, 0, AssetStreamRequest*);
+    dynarray_remove(&s->finished, 0, 1);
+  }
+  thread_mutex_unlock(s->workerMutex);
+
+  if (!req) {
+    return false;
+  }
+  /**
+   * NOTE: The cancelled flag can no longer change as the request is no longer in any of the queues.
+   */
+  req->finish(world, importEnv, req->asset, req->ctx.ptr, req->cancelled);
+
+  *out = (AssetStreamResult){.asset = req->asset, .cancelled = req->cancelled};
+  stream_request_destroy(s, req);
+  return true;
+}
+
+u32 asset_streamer_count(AssetStreamer* s) {
+  thread_mutex_lock(s->workerMutex);
+  const u32 res = (u32)(s->pending.size + s->running.size + s->finished.size);
+  thread_mutex_unlock(s->workerMutex);
+  return res;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "asset/manager.h"
+#include "ecs/module.h"
+
+#include "forward.h"
+
+/**
+ * Routine that is executed on one of the background streaming threads.
+ * NOTE: Cannot access the ecs world; should only work on the data in the given context.
+ */
+typedef void (*AssetStreamRoutine)(void* ctx);
+
+/**
+ * Callback that is executed on the main-thread once the routine has completed.
+ * Responsible for freeing any resources that are referenced by the context.
+ * NOTE: When cancelled the world and import-env can be null (in case the manager is destroyed).
+ */
+typedef void (*AssetStreamFinish)(
+    EcsWorld*, const AssetImportEnvComp*, EcsEntityId asset, void* ctx, bool cancelled);
+
+typedef struct {
+  EcsEntityId asset;
+  bool        cancelled;
+} AssetStreamResult;
+
+/**
+ * Pool of low-priority background threads that execute the heavy (io / decoding) parts of asset
+ * loads. Requests are executed in priority order (first-in first-out for equal priorities) and the
+ * results are queued until they are finished on the main-thread.
+ * NOTE: Api is thread-safe.
+ */
+typedef struct sAssetStreamer AssetStreamer;
+
+/**
+ * Create a new streamer with the given amount of worker threads.
+ * Should be destroyed using 'asset_streamer_destroy()'.
+ */
+AssetStreamer* asset_streamer_create(Allocator*, u32 workerCount);
+
+/**
+ * Destroy the streamer.
+ * NOTE: Finish callbacks are invoked (as cancelled) for all outstanding requests.
+ */
+void asset_streamer_destroy(AssetStreamer*);
+
+/**
+ * Queue a routine to be executed for the given asset.
+ * NOTE: The context memory is copied into the streamer and freed after the finish callback.
+ */
+void asset_streamer_push(
+    AssetStreamer*, EcsEntityId asset, AssetStreamRoutine, AssetStreamFinish, Mem ctx);
+
+/**
+ * Set (or clear) the priority hint of an asset.
+ * NOTE: Applies both to currently queued and future requests for the asset.
+ */
+void asset_streamer_prioritize(AssetStreamer*, EcsEntityId asset, AssetPriority);
+void asset_streamer_forget(AssetStreamer*, EcsEntityId asset);
+
+/**
+ * Cancel all outstanding requests for the given asset.
+ * Returns true if the asset had any outstanding (queued, running or finished) requests.
+ * NOTE: Already running routines are completed but their results are marked as cancelled.
+ */
+bool asset_streamer_cancel(AssetStreamer*, EcsEntityId asset);
+
+/**
+ * Invoke the finish callback for the oldest finished request.
+ * NOTE: Returns false if no requests have finished.
+ */
+bool asset_streamer_finish(
+    AssetStreamer*, EcsWorld*, const AssetImportEnvComp*, AssetStreamResult* out);
+
+/**
+ * Query the amount of outstanding (queued, running or finished) requests.
+ */
+u32 asset_streamer_count(AssetStreamer*);
@@ -1,6 +1,12 @@
 #include "app/check.h"
+#include "net/init.h"
 
 void app_check_init(CheckDef* check) {
+  net_init(); // NOTE: Used by the remote cache tests.
+
+  register_spec(check, cache);
+  register_spec(check, cache_remote);
+  register_spec(check, checksum_index);
   register_spec(check, loader_font_ttf);
   register_spec(check, loader_graphic);
   register_spec(check, loader_inputmap);
@@ -17,9 +23,11 @@ void app_check_init(CheckDef* check) {
   register_spec(check, loader_texture_font);
   register_spec(check, loader_texture_png);
   register_spec(check, loader_texture_ppm);
+  register_spec(check, loader_texture_proc);
   register_spec(check, loader_texture_tga);
   register_spec(check, loader_weapon);
   register_spec(check, manager);
+  register_spec(check, repo_pack);
 }
 
-void app_check_teardown(void) {}
+void app_check_teardown(void) { net_teardown(); }
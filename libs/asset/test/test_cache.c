@@ -0,0 +1,215 @@
+#include "asset/data.h"
+#include "check/spec.h"
+#include "core/alloc.h"
+#include "core/diag.h"
+#include "core/dynstring.h"
+#include "core/file.h"
+#include "core/format.h"
+#include "core/path.h"
+
+#include "cache.h"
+#include "checksum_index.h"
+#include "utils.h"
+
+static const String g_testCacheRegName     = string_static("registry.blob");
+static const String g_testCacheJournalName = string_static("registry.journal");
+static const u32    g_testCacheLoaderHash  = 42;
+
+static u32 test_cache_loader_hash(const void* ctx, const String assetId) {
+  (void)ctx;
+  (void)assetId;
+  return g_testCacheLoaderHash;
+}
+
+static const AssetRepoLoaderHasher g_testCacheLoaderHasher = {
+    .computeHash = test_cache_loader_hash,
+};
+
+static String test_cache_file_path(Allocator* alloc, const String rootPath, const String name) {
+  return string_dup(alloc, path_build_scratch(rootPath, string_lit(".cache"), name));
+}
+
+static String test_cache_file_read(Allocator* alloc, const String path) {
+  File* file;
+  if (file_create(g_allocHeap, path, FileMode_Open, FileAccess_Read, &file)) {
+    return string_empty;
+  }
+  DynString buffer = dynstring_create(g_allocHeap, 1024);
+  file_read_to_end_sync(file, &buffer);
+  file_destroy(file);
+
+  const String res = string_maybe_dup(alloc, dynstring_view(&buffer));
+  dynstring_destroy(&buffer);
+  return res;
+}
+
+static String test_cache_source_id(const u32 index) {
+  return fmt_write_scratch("source_{}.raw", fmt_int(index));
+}
+
+static void test_cache_source_write(const String rootPath, const String id) {
+  const String path = path_build_scratch(rootPath, id);
+  if (file_write_to_path_sync(path, id)) {
+    diag_crash_msg("Failed to write test source file");
+  }
+}
+
+static void test_cache_set(AssetCache* c, const String rootPath, const String id) {
+  const AssetRepoDep source = {
+      .id         = id,
+      .modTime    = file_stat_path_sync(path_build_scratch(rootPath, id)).modTime,
+      .loaderHash = g_testCacheLoaderHash,
+  };
+  const Mem blob = id; // Use the id as the blob content.
+  asset_cache_set(c, blob, data_meta_t(data_prim_t(String)), &source, null, 0);
+}
+
+static bool test_cache_get(AssetCache* c, const String id, String* outBlob, Allocator* alloc) {
+  AssetCacheRecord record;
+  if (!asset_cache_get(c, id, g_testCacheLoaderHasher, &record)) {
+    return false;
+  }
+  DynString buffer = dynstring_create(g_allocHeap, 64);
+  file_read_to_end_sync(record.blobFile, &buffer);
+  file_destroy(record.blobFile);
+
+  *outBlob = string_dup(alloc, dynstring_view(&buffer));
+  dynstring_destroy(&buffer);
+  return true;
+}
+
+spec(cache) {
+
+  Allocator* alloc = null;
+  String     rootPath;
+
+  setup() {
+    asset_data_init(false /* devSupport */);
+
+    alloc    = alloc_chunked_create(g_allocHeap, alloc_bump_create, 64 * usize_kibibyte);
+    rootPath = asset_test_dir_create(alloc);
+  }
+
+  it("replays the journal on top of the registry snapshot") {
+    const String id = string_lit("a.raw");
+    test_cache_source_write(rootPath, id);
+
+    AssetChecksumIndex* checksums = asset_checksum_index_create(g_allocHeap, rootPath);
+    AssetCache*         c = asset_cache_create(g_allocHeap, rootPath, 0, checksums, string_empty);
+
+    const String regPath     = test_cache_file_path(alloc, rootPath, g_testCacheRegName);
+    const String journalPath = test_cache_file_path(alloc, rootPath, g_testCacheJournalName);
+    const String regEmpty    = test_cache_file_read(alloc, regPath);
+
+    test_cache_set(c, rootPath, id);
+    asset_cache_flush(c);
+
+    const String journal = test_cache_file_read(alloc, journalPath);
+    check(!string_is_empty(journal));
+
+    asset_cache_destroy(c); // NOTE: Compacts the journal into the registry.
+
+    // Simulate a crash before compaction by restoring the empty registry and the journal.
+    check_eq_int(file_write_to_path_sync(regPath, regEmpty), FileResult_Success);
+    check_eq_int(file_write_to_path_sync(journalPath, journal), FileResult_Success);
+
+    c = asset_cache_create(g_allocHeap, rootPath, 0, checksums, string_empty);
+
+    String blob;
+    check(test_cache_get(c, id, &blob, alloc));
+    check_eq_string(blob, id);
+    check(!test_cache_get(c, string_lit("b.raw"), &blob, alloc));
+
+    asset_cache_destroy(c);
+    asset_checksum_index_destroy(checksums);
+  }
+
+  it("discards a torn trailing journal record") {
+    const String id = string_lit("a.raw");
+    test_cache_source_write(rootPath, id);
+
+    AssetChecksumIndex* checksums = asset_checksum_index_create(g_allocHeap, rootPath);
+    AssetCache*         c = asset_cache_create(g_allocHeap, rootPath, 0, checksums, string_empty);
+
+    const String regPath     = test_cache_file_path(alloc, rootPath, g_testCacheRegName);
+    const String journalPath = test_cache_file_path(alloc, rootPath, g_testCacheJournalName);
+    const String regEmpty    = test_cache_file_read(alloc, regPath);
+
+    test_cache_set(c, rootPath, id);
+    asset_cache_flush(c);
+
+    const String journal = test_cache_file_read(alloc, journalPath);
+    asset_cache_destroy(c);
+
+    // Simulate a crash while appending a record: a header that claims more data than is present.
+    const String tornRecord  = string_lit("\x40\x00\x00\x00\x12\x34\x56\x78partial");
+    const String journalTorn = string_combine(alloc, journal, tornRecord);
+
+    check_eq_int(file_write_to_path_sync(regPath, regEmpty), FileResult_Success);
+    check_eq_int(file_write_to_path_sync(journalPath, journalTorn), FileResult_Success);
+
+    c = asset_cache_create(g_allocHeap, rootPath, 0, checksums, string_empty);
+
+    // The valid record is preserved and the torn record is truncated from the journal.
+    String blob;
+    check(test_cache_get(c, id, &blob, alloc));
+    check_eq_string(blob, id);
+    check_eq_int(file_stat_path_sync(journalPath).size, journal.size);
+
+    asset_cache_destroy(c);
+    asset_checksum_index_destroy(checksums);
+  }
+
+  it("compacts the journal into the registry snapshot") {
+    static const u32 g_entryCount = 600; // NOTE: More than the compaction threshold.
+    for (u32 i = 0; i != g_entryCount; ++i) {
+      test_cache_source_write(rootPath, test_cache_source_id(i));
+    }
+
+    AssetChecksumIndex* checksums = asset_checksum_index_create(g_allocHeap, rootPath);
+    AssetCache*         c = asset_cache_create(g_allocHeap, rootPath, 0, checksums, string_empty);
+
+    const String regPath     = test_cache_file_path(alloc, rootPath, g_testCacheRegName);
+    const String journalPath = test_cache_file_path(alloc, rootPath, g_testCacheJournalName);
+    const String regEmpty    = test_cache_file_read(alloc, regPath);
+
+    for (u32 i = 0; i != g_entryCount; ++i) {
+      test_cache_set(c, rootPath, test_cache_source_id(i));
+    }
+    asset_cache_flush(c);
+
+    const String reg     = test_cache_file_read(alloc, regPath);
+    const String journal = test_cache_file_read(alloc, journalPath);
+    check(reg.size > regEmpty.size);
+
+    asset_cache_destroy(c);
+
+    // Restore the files as they were before shutdown; the entries are split over both files.
+    check_eq_int(file_write_to_path_sync(regPath, reg), FileResult_Success);
+    check_eq_int(file_write_to_path_sync(journalPath, journal), FileResult_Success);
+
+    c = asset_cache_create(g_allocHeap, rootPath, 0, checksums, string_empty);
+
+    u32 hits = 0;
+    for (u32 i = 0; i != g_entryCount; ++i) {
+      const String id = test_cache_source_id(i);
+      String       blob;
+      if (test_cache_get(c, id, &blob, g_allocScratch) && string_eq(blob, id)) {
+        ++hits;
+      }
+    }
+    check_eq_int(hits, g_entryCount);
+
+    asset_cache_destroy(c);
+
+    // Shutdown compacts the remaining journal records.
+    check_eq_int(file_stat_path_sync(journalPath).size, 0);
+
+    asset_checksum_index_destroy(checksums);
+  }
+
+  teardown() {
+    asset_test_dir_destroy(rootPath);
+    alloc_chunked_destroy(alloc);
+  }
+}
@@ -0,0 +1,425 @@
+#include "asset/data.h"
+#include "check/spec.h"
+#include "core/alloc.h"
+#include "core/diag.h"
+#include "core/dynarray.h"
+#include "core/dynstring.h"
+#include "core/file.h"
+#include "core/format.h"
+#include "core/path.h"
+#include "core/thread.h"
+#include "core/time.h"
+#include "net/addr.h"
+#include "net/result.h"
+#include "net/socket.h"
+
+#include "cache.h"
+#include "checksum_index.h"
+#include "utils.h"
+
+/**
+ * Minimal stand-in for a remote cache server.
+ * Stores records in memory and supports the subset of Http that the remote cache uses:
+ * 'GET', 'HEAD' (with 'If-None-Match') and 'PUT' over keep-alive connections.
+ */
+
+#define test_remote_max_connections 8
+
+typedef struct {
+  String uri, etag, data;
+} TestRemoteRecord;
+
+typedef struct {
+  u32 reqGet, reqHead, reqPut, respNotModified, respNotFound;
+} TestRemoteStats;
+
+typedef struct {
+  ThreadMutex     mutex;
+  NetSocket*      listener;
+  ThreadHandle    acceptThread;
+  ThreadHandle    conThreads[test_remote_max_connections];
+  u32             conCount;
+  bool            shutdown;
+  DynArray        records; // TestRemoteRecord[]
+  TestRemoteStats stats;
+} TestRemote;
+
+typedef struct {
+  TestRemote* remote;
+  NetSocket*  socket;
+} TestRemoteCon;
+
+static TestRemoteRecord* test_remote_record(TestRemote* r, const String uri) {
+  dynarray_for_t(&r->records, TestRemoteRecord, record) {
+    if (string_eq(record->uri, uri)) {
+      return record;
+    }
+  }
+  return null;
+}
+
+static void test_remote_respond(
+    NetSocket*   socket,
+    const u32    status,
+    const String reason,
+    const String etag,
+    const String body) {
+  DynString buffer = dynstring_create(g_allocHeap, 256 + body.size);
+  fmt_write(&buffer, "HTTP/1.1 {} {}\r\n", fmt_int(status), fmt_text(reason));
+  fmt_write(&buffer, "Content-Length: {}\r\n", fmt_int(body.size));
+  if (!string_is_empty(etag)) {
+    fmt_write(&buffer, "ETag: \"{}\"\r\n", fmt_text(etag));
+  }
+  dynstring_append(&buffer, string_lit("\r\n"));
+  dynstring_append(&buffer, body);
+  net_socket_write_sync(socket, dynstring_view(&buffer));
+  dynstring_destroy(&buffer);
+}
+
+static void test_remote_handle(
+    TestRemote*  r,
+    NetSocket*   socket,
+    const String method,
+    const String uri,
+    const String ifNoneMatch,
+    const String body) {
+  thread_mutex_lock(r->mutex);
+  TestRemoteRecord* record = test_remote_record(r, uri);
+  if (string_eq(method, string_lit("GET"))) {
+    ++r->stats.reqGet;
+    if (record) {
+      test_remote_respond(socket, 200, string_lit("OK"), record->etag, record->data);
+    } else {
+      ++r->stats.respNotFound;
+      test_remote_respond(socket, 404, string_lit("Not Found"), string_empty, string_empty);
+    }
+  } else if (string_eq(method, string_lit("HEAD"))) {
+    ++r->stats.reqHead;
+    const bool etagMatch =
+        record && string_eq(ifNoneMatch, fmt_write_scratch("\"{}\"", fmt_text(record->etag)));
+    if (etagMatch) {
+      ++r->stats.respNotModified;
+      test_remote_respond(socket, 304, string_lit("Not Modified"), record->etag, string_empty);
+    } else if (record) {
+      test_remote_respond(socket, 200, string_lit("OK"), record->etag, string_empty);
+    } else {
+      ++r->stats.respNotFound;
+      test_remote_respond(socket, 404, string_lit("Not Found"), string_empty, string_empty);
+    }
+  } else if (string_eq(method, string_lit("PUT"))) {
+    ++r->stats.reqPut;
+    if (!record) {
+      record  = dynarray_push_t(&r->records, TestRemoteRecord);
+      *record = (TestRemoteRecord){
+          .uri  = string_dup(g_allocHeap, uri),
+          .etag = string_dup(g_allocHeap, path_stem(uri)),
+      };
+    } else {
+      string_maybe_free(g_allocHeap, record->data);
+    }
+    record->data = string_maybe_dup(g_allocHeap, body);
+    test_remote_respond(socket, 201, string_lit("Created"), record->etag, string_empty);
+  } else {
+    test_remote_respond(socket, 405, string_lit("Method Not Allowed"), string_empty, string_empty);
+  }
+  thread_mutex_unlock(r->mutex);
+}
+
+static String test_remote_header(const String headers, const String name) {
+  const usize start = string_find_first(headers, fmt_write_scratch("\r\n{}:", fmt_text(name)));
+  if (sentinel_check(start)) {
+    return string_empty;
+  }
+  const String value = string_consume(headers, start + name.size + 3);
+  return string_trim_whitespace(string_slice(value, 0, string_find_first(value, string_lit("\r"))));
+}
+
+static void test_remote_con_thread(void* data) {
+  TestRemoteCon* con    = data;
+  DynString      buffer = dynstring_create(g_allocHeap, 4 * usize_kibibyte);
+  for (;;) {
+    // Parse the request header.
+    const usize headerEnd = string_find_first(dynstring_view(&buffer), string_lit("\r\n\r\n"));
+    if (sentinel_check(headerEnd)) {
+      if (net_socket_read_sync(con->socket, &buffer) != NetResult_Success) {
+        break; // Connection closed.
+      }
+      continue;
+    }
+    const String headers = string_slice(dynstring_view(&buffer), 0, headerEnd + 2);
+    const usize  methodEnd = string_find_first(headers, string_lit(" "));
+    const String method    = string_slice(headers, 0, methodEnd);
+    const String uriStart  = string_consume(headers, methodEnd + 1);
+    const String uri = string_slice(uriStart, 0, string_find_first(uriStart, string_lit(" ")));
+
+    u64 contentLength = 0;
+    format_read_u64(test_remote_header(headers, string_lit("Content-Length")), &contentLength, 10);
+
+    // Wait for the request body.
+    const usize requestSize = headerEnd + 4 + contentLength;
+    if (buffer.size < requestSize) {
+      if (net_socket_read_sync(con->socket, &buffer) != NetResult_Success) {
+        break; // Connection closed.
+      }
+      continue;
+    }
+    const String body        = string_slice(dynstring_view(&buffer), headerEnd + 4, contentLength);
+    const String ifNoneMatch = test_remote_header(headers, string_lit("If-None-Match"));
+    test_remote_handle(con->remote, con->socket, method, uri, ifNoneMatch, body);
+
+    dynstring_erase_chars(&buffer, 0, requestSize);
+  }
+  dynstring_destroy(&buffer);
+  net_socket_destroy(con->socket);
+  alloc_free_t(g_allocHeap, con);
+}
+
+static void test_remote_accept_thread(void* data) {
+  TestRemote* r = data;
+  for (;;) {
+    NetSocket* socket = net_socket_accept_sync(r->listener, g_allocHeap);
+
+    const bool valid = net_socket_status(socket) == NetResult_Success;
+
+    thread_mutex_lock(r->mutex);
+    const bool shutdown = r->shutdown || !valid;
+    const bool accept   = !shutdown && r->conCount != test_remote_max_connections;
+    if (accept) {
+      TestRemoteCon* con = alloc_alloc_t(g_allocHeap, TestRemoteCon);
+      *con               = (TestRemoteCon){.remote = r, .socket = socket};
+
+      const String         name = string_lit("volo_remote_con");
+      const ThreadPriority prio = ThreadPriority_Normal;
+      r->conThreads[r->conCount++] = thread_start(test_remote_con_thread, con, name, prio);
+    }
+    thread_mutex_unlock(r->mutex);
+
+    if (!accept) {
+      net_socket_destroy(socket);
+    }
+    if (shutdown) {
+      break;
+    }
+  }
+}
+
+static TestRemote* test_remote_start(void) {
+  TestRemote* r = alloc_alloc_t(g_allocHeap, TestRemote);
+
+  const NetEndpoint endpoint = {.addr = net_addr_loopback(NetAddrType_V4), .port = 0};
+
+  *r = (TestRemote){
+      .mutex    = thread_mutex_create(g_allocHeap),
+      .listener = net_socket_listen_sync(g_allocHeap, endpoint),
+      .records  = dynarray_create_t(g_allocHeap, TestRemoteRecord, 8),
+  };
+  if (net_socket_status(r->listener) != NetResult_Success) {
+    diag_crash_msg("Failed to start the test remote cache server");
+  }
+  const String         threadName = string_lit("volo_remote");
+  const ThreadPriority threadPrio = ThreadPriority_Normal;
+  r->acceptThread = thread_start(test_remote_accept_thread, r, threadName, threadPrio);
+  return r;
+}
+
+/**
+ * Stop the server.
+ * NOTE: Clients have to be disconnected before stopping as connections are served until closed.
+ */
+static void test_remote_stop(TestRemote* r) {
+  thread_mutex_lock(r->mutex);
+  r->shutdown = true;
+  thread_mutex_unlock(r->mutex);
+
+  // Wake the accept thread by connecting to it.
+  net_socket_destroy(net_socket_connect_sync(g_allocHeap, *net_socket_local(r->listener)));
+  thread_join(r->acceptThread);
+
+  for (u32 i = 0; i != r->conCount; ++i) {
+    thread_join(r->conThreads[i]);
+  }
+  dynarray_for_t(&r->records, TestRemoteRecord, record) {
+    string_free(g_allocHeap, record->uri);
+    string_free(g_allocHeap, record->etag);
+    string_maybe_free(g_allocHeap, record->data);
+  }
+  dynarray_destroy(&r->records);
+  net_socket_destroy(r->listener);
+  thread_mutex_destroy(r->mutex);
+  alloc_free_t(g_allocHeap, r);
+}
+
+static TestRemoteStats test_remote_stats(TestRemote* r) {
+  thread_mutex_lock(r->mutex);
+  const TestRemoteStats res = r->stats;
+  thread_mutex_unlock(r->mutex);
+  return res;
+}
+
+static String test_remote_url_scratch(const NetEndpoint* endpoint) {
+  return fmt_write_scratch("http://127.0.0.1:{}/cache", fmt_int(endpoint->port));
+}
+
+static u32 test_remote_loader_hash(const void* ctx, const String assetId) {
+  (void)ctx;
+  (void)assetId;
+  return 42;
+}
+
+static const AssetRepoLoaderHasher g_testRemoteLoaderHasher = {
+    .computeHash = test_remote_loader_hash,
+};
+
+static void test_remote_source_write(const String rootPath, const String id, const String data) {
+  if (file_write_to_path_sync(path_build_scratch(rootPath, id), data)) {
+    diag_crash_msg("Failed to write test source file");
+  }
+}
+
+static void test_remote_set(AssetCache* c, const String rootPath, const String id) {
+  const String path     = path_build_scratch(rootPath, id);
+  u32          checksum = 0;
+  if (file_crc_32_path_sync(path, &checksum)) {
+    diag_crash_msg("Failed to checksum test source file");
+  }
+  const AssetRepoDep source = {
+      .id         = id,
+      .modTime    = file_stat_path_sync(path).modTime,
+      .checksum   = checksum,
+      .loaderHash = test_remote_loader_hash(null, id),
+  };
+  const Mem blob = id; // Use the id as the blob content.
+  asset_cache_set(c, blob, data_meta_t(data_prim_t(String)), &source, null, 0);
+}
+
+static bool test_remote_prepare(AssetCache* c, const String id) {
+  const TimeSteady start = time_steady_clock();
+  while (!asset_cache_prepare(c, id, g_testRemoteLoaderHasher)) {
+    if (time_steady_duration(start, time_steady_clock()) > time_seconds(30)) {
+      return false; // Fetch did not complete in time.
+    }
+    thread_sleep(time_millisecond);
+  }
+  return true;
+}
+
+static bool test_remote_get(AssetCache* c, const String id, String* outBlob) {
+  AssetCacheRecord record;
+  if (!asset_cache_get(c, id, g_testRemoteLoaderHasher, &record)) {
+    return false;
+  }
+  DynString buffer = dynstring_create(g_allocScratch, 256);
+  file_read_to_end_sync(record.blobFile, &buffer);
+  file_destroy(record.blobFile);
+
+  *outBlob = dynstring_view(&buffer);
+  return true;
+}
+
+spec(cache_remote) {
+
+  Allocator*  alloc = null;
+  TestRemote* remote;
+  String      remoteUrl, rootPathA, rootPathB;
+
+  setup() {
+    asset_data_init(false /* devSupport */);
+
+    alloc     = alloc_chunked_create(g_allocHeap, alloc_bump_create, 16 * usize_kibibyte);
+    remote    = test_remote_start();
+    remoteUrl = string_dup(alloc, test_remote_url_scratch(net_socket_local(remote->listener)));
+    rootPathA = asset_test_dir_create(alloc);
+    rootPathB = asset_test_dir_create(alloc);
+  }
+
+  it("uploads new entries unless the remote already has them") {
+    test_remote_source_write(rootPathA, string_lit("a.raw"), string_lit("Hello"));
+
+    AssetChecksumIndex* checksums = asset_checksum_index_create(g_allocHeap, rootPathA);
+    AssetCache*         c = asset_cache_create(g_allocHeap, rootPathA, 0, checksums, remoteUrl);
+
+    test_remote_set(c, rootPathA, string_lit("a.raw"));
+    asset_cache_flush(c);
+
+    // Remote did not have the record: Etag check misses and the record is uploaded.
+    check_eq_int(test_remote_stats(remote).reqHead, 1);
+    check_eq_int(test_remote_stats(remote).respNotFound, 1);
+    check_eq_int(test_remote_stats(remote).reqPut, 1);
+
+    test_remote_set(c, rootPathA, string_lit("a.raw"));
+    asset_cache_flush(c);
+
+    // Remote already has the record: Etag check matches and the upload is skipped.
+    check_eq_int(test_remote_stats(remote).reqHead, 2);
+    check_eq_int(test_remote_stats(remote).respNotModified, 1);
+    check_eq_int(test_remote_stats(remote).reqPut, 1);
+
+    asset_cache_destroy(c);
+    asset_checksum_index_destroy(checksums);
+  }
+
+  it("fetches entries from the remote on a local miss") {
+    test_remote_source_write(rootPathA, string_lit("a.raw"), string_lit("Hello"));
+    test_remote_source_write(rootPathB, string_lit("a.raw"), string_lit("Hello"));
+    test_remote_source_write(rootPathB, string_lit("b.raw"), string_lit("World"));
+
+    // Populate the remote from a cache on a different directory.
+    AssetChecksumIndex* checksumsA = asset_checksum_index_create(g_allocHeap, rootPathA);
+    AssetCache*         cA = asset_cache_create(g_allocHeap, rootPathA, 0, checksumsA, remoteUrl);
+    test_remote_set(cA, rootPathA, string_lit("a.raw"));
+    asset_cache_destroy(cA);
+    asset_checksum_index_destroy(checksumsA);
+
+    AssetChecksumIndex* checksumsB = asset_checksum_index_create(g_allocHeap, rootPathB);
+    AssetCache*         cB = asset_cache_create(g_allocHeap, rootPathB, 0, checksumsB, remoteUrl);
+
+    String blob;
+    check(!test_remote_get(cB, string_lit("a.raw"), &blob)); // Lookups are local only.
+
+    // Remote hit: the entry is installed in the local cache.
+    check(!asset_cache_prepare(cB, string_lit("a.raw"), g_testRemoteLoaderHasher));
+    check(test_remote_prepare(cB, string_lit("a.raw")));
+    check(test_remote_get(cB, string_lit("a.raw"), &blob));
+    check_eq_string(blob, string_lit("a.raw"));
+    check_eq_int(test_remote_stats(remote).reqGet, 1);
+
+    // Valid local entry: no remote lookup needed.
+    check(asset_cache_prepare(cB, string_lit("a.raw"), g_testRemoteLoaderHasher));
+    check_eq_int(test_remote_stats(remote).reqGet, 1);
+
+    // Remote miss: lookup falls back to importing the source.
+    check(test_remote_prepare(cB, string_lit("b.raw")));
+    check(!test_remote_get(cB, string_lit("b.raw"), &blob));
+    check_eq_int(test_remote_stats(remote).reqGet, 2);
+
+    asset_cache_destroy(cB);
+    asset_checksum_index_destroy(checksumsB);
+  }
+
+  it("stops fetching once the remote is unreachable") {
+    test_remote_source_write(rootPathA, string_lit("a.raw"), string_lit("Hello"));
+    test_remote_source_write(rootPathA, string_lit("b.raw"), string_lit("World"));
+
+    // Find an unused port by opening (and closing) a listening socket.
+    const NetEndpoint endpoint = {.addr = net_addr_loopback(NetAddrType_V4), .port = 0};
+    NetSocket*        listener = net_socket_listen_sync(g_allocHeap, endpoint);
+    const String      url = string_dup(alloc, test_remote_url_scratch(net_socket_local(listener)));
+    net_socket_destroy(listener);
+
+    AssetChecksumIndex* checksums = asset_checksum_index_create(g_allocHeap, rootPathA);
+    AssetCache*         c         = asset_cache_create(g_allocHeap, rootPathA, 0, checksums, url);
+
+    check(test_remote_prepare(c, string_lit("a.raw")));
+    check(asset_cache_prepare(c, string_lit("b.raw"), g_testRemoteLoaderHasher));
+
+    asset_cache_destroy(c);
+    asset_checksum_index_destroy(checksums);
+  }
+
+  teardown() {
+    test_remote_stop(remote);
+    asset_test_dir_destroy(rootPathA);
+    asset_test_dir_destroy(rootPathB);
+    alloc_chunked_destroy(alloc);
+  }
+}
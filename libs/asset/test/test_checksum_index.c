@@ -0,0 +1,175 @@
+#include "asset/data.h"
+#include "check/spec.h"
+#include "core/alloc.h"
+#include "core/bits.h"
+#include "core/file.h"
+#include "core/path.h"
+#include "core/time.h"
+
+#include "checksum_index.h"
+#include "utils.h"
+
+static FileInfo test_checksum_info(const String data, const u64 fileId, const TimeDuration age) {
+  return (FileInfo){
+      .size    = data.size,
+      .type    = FileType_Regular,
+      .modTime = time_real_offset(time_real_clock(), -age),
+      .id      = fileId,
+  };
+}
+
+spec(checksum_index) {
+
+  static const TimeDuration g_ageStable = time_minutes(10); // Well outside the racy duration.
+
+  Allocator* alloc = null;
+  String     rootPath;
+
+  setup() {
+    asset_data_init(false /* devSupport */);
+
+    alloc    = alloc_chunked_create(g_allocHeap, alloc_bump_create, 16 * usize_kibibyte);
+    rootPath = asset_test_dir_create(alloc);
+  }
+
+  it("computes the checksum of unindexed files") {
+    AssetChecksumIndex* idx  = asset_checksum_index_create(g_allocHeap, rootPath);
+    const String        data = string_lit("Hello World");
+    const FileInfo      info = test_checksum_info(data, 1, g_ageStable);
+
+    const u32 checksum = asset_checksum_index_data(idx, string_lit("a.raw"), &info, data);
+    check_eq_int(checksum, bits_crc_32(0, data));
+
+    const AssetChecksumIndexStats stats = asset_checksum_index_stats(idx);
+    check_eq_int(stats.hashed, 1);
+    check_eq_int(stats.indexed, 0);
+    check_eq_int(stats.entries, 1);
+
+    asset_checksum_index_destroy(idx);
+  }
+
+  it("retrieves the checksum of indexed files without reading their data") {
+    AssetChecksumIndex* idx  = asset_checksum_index_create(g_allocHeap, rootPath);
+    const String        id   = string_lit("a.raw");
+    const String        data = string_lit("Hello World");
+    const FileInfo      info = test_checksum_info(data, 1, g_ageStable);
+
+    const u32 checksum = asset_checksum_index_data(idx, id, &info, data);
+
+    // NOTE: Different data with the same file info; the indexed checksum is returned.
+    const String dataOther = string_lit("Hello Other");
+    check_eq_int(asset_checksum_index_data(idx, id, &info, dataOther), checksum);
+
+    const AssetChecksumIndexStats stats = asset_checksum_index_stats(idx);
+    check_eq_int(stats.hashed, 1);
+    check_eq_int(stats.indexed, 1);
+
+    asset_checksum_index_destroy(idx);
+  }
+
+  it("does not index files that were modified within the racy duration") {
+    AssetChecksumIndex* idx  = asset_checksum_index_create(g_allocHeap, rootPath);
+    const String        id   = string_lit("a.raw");
+    const String        data = string_lit("Hello World");
+    const FileInfo      info = test_checksum_info(data, 1, 0 /* age */);
+
+    asset_checksum_index_data(idx, id, &info, data);
+    asset_checksum_index_data(idx, id, &info, data);
+
+    const AssetChecksumIndexStats stats = asset_checksum_index_stats(idx);
+    check_eq_int(stats.hashed, 2);
+    check_eq_int(stats.indexed, 0);
+    check_eq_int(stats.entries, 0);
+
+    asset_checksum_index_destroy(idx);
+  }
+
+  it("validates the file-id, size and modification time of indexed entries") {
+    AssetChecksumIndex* idx  = asset_checksum_index_create(g_allocHeap, rootPath);
+    const String        id   = string_lit("a.raw");
+    const String        data = string_lit("Hello World");
+    const FileInfo      info = test_checksum_info(data, 1, g_ageStable);
+
+    asset_checksum_index_data(idx, id, &info, data);
+
+    const String dataOther = string_lit("Hello Other");
+    const u32    crcOther  = bits_crc_32(0, dataOther);
+
+    FileInfo infoOtherId = info;
+    infoOtherId.id       = 2;
+    check_eq_int(asset_checksum_index_data(idx, id, &infoOtherId, dataOther), crcOther);
+
+    FileInfo infoOtherSize = info;
+    infoOtherSize.size     = data.size + 1;
+    check_eq_int(asset_checksum_index_data(idx, id, &infoOtherSize, dataOther), crcOther);
+
+    FileInfo infoOtherModTime = info;
+    infoOtherModTime.modTime  = time_real_offset(info.modTime, -time_second);
+    check_eq_int(asset_checksum_index_data(idx, id, &infoOtherModTime, dataOther), crcOther);
+
+    const AssetChecksumIndexStats stats = asset_checksum_index_stats(idx);
+    check_eq_int(stats.hashed, 4);
+    check_eq_int(stats.indexed, 0);
+    check_eq_int(stats.entries, 1);
+
+    asset_checksum_index_destroy(idx);
+  }
+
+  it("recomputes the checksum of invalidated files") {
+    AssetChecksumIndex* idx  = asset_checksum_index_create(g_allocHeap, rootPath);
+    const String        id   = string_lit("a.raw");
+    const String        data = string_lit("Hello World");
+    const FileInfo      info = test_checksum_info(data, 1, g_ageStable);
+
+    asset_checksum_index_data(idx, id, &info, data);
+    asset_checksum_index_invalidate(idx, id);
+    check_eq_int(asset_checksum_index_stats(idx).entries, 0);
+
+    const String dataOther = string_lit("Hello Other");
+    check_eq_int(asset_checksum_index_data(idx, id, &info, dataOther), bits_crc_32(0, dataOther));
+
+    const AssetChecksumIndexStats stats = asset_checksum_index_stats(idx);
+    check_eq_int(stats.hashed, 2);
+    check_eq_int(stats.indexed, 0);
+
+    asset_checksum_index_destroy(idx);
+  }
+
+  it("persists the index") {
+    const String   id   = string_lit("a.raw");
+    const String   data = string_lit("Hello World");
+    const FileInfo info = test_checksum_info(data, 1, g_ageStable);
+
+    AssetChecksumIndex* idx      = asset_checksum_index_create(g_allocHeap, rootPath);
+    const u32           checksum = asset_checksum_index_data(idx, id, &info, data);
+    asset_checksum_index_destroy(idx);
+
+    idx = asset_checksum_index_create(g_allocHeap, rootPath);
+    check_eq_int(asset_checksum_index_stats(idx).entries, 1);
+    check_eq_int(asset_checksum_index_data(idx, id, &info, string_empty), checksum);
+    check_eq_int(asset_checksum_index_stats(idx).indexed, 1);
+    asset_checksum_index_destroy(idx);
+  }
+
+  it("computes the checksum of files by their id") {
+    const String id   = string_lit("a.raw");
+    const String data = string_lit("Hello World");
+    const String path = path_build_scratch(rootPath, id);
+    check_eq_int(file_write_to_path_sync(path, data), FileResult_Success);
+
+    AssetChecksumIndex* idx = asset_checksum_index_create(g_allocHeap, rootPath);
+
+    u32 checksum = 0;
+    check_eq_int(asset_checksum_index_path(idx, id, &checksum), FileResult_Success);
+    check_eq_int(checksum, bits_crc_32(0, data));
+
+    check(asset_checksum_index_path(idx, string_lit("b.raw"), &checksum) != FileResult_Success);
+
+    asset_checksum_index_destroy(idx);
+  }
+
+  teardown() {
+    asset_test_dir_destroy(rootPath);
+    alloc_chunked_destroy(alloc);
+  }
+}
@@ -32,7 +32,7 @@ static const struct {
         .objects =
             {
                 {
-                    .prefab   = 1470434201,
+                    .prefab   = 865527488,
                     .faction  = AssetLevelFaction_A,
                     .position = {.x = 42},
                     .rotation = {0},
@@ -64,8 +64,8 @@ static const struct {
                               "]}"),
         .prefabs =
             {
-                {.name = string_static("UnitA")},
                 {.name = string_static("UnitB")},
+                {.name = string_static("UnitA")},
             },
         .prefabCount = 2,
     },
@@ -6,6 +6,8 @@
 #include "core/alloc.h"
 #include "core/array.h"
 #include "core/base64.h"
+#include "core/thread.h"
+#include "core/time.h"
 #include "ecs/utils.h"
 #include "ecs/world.h"
 
@@ -52,6 +54,34 @@ static const AssetMemRecord g_testData[] = {
     },
 };
 
+static const AssetMemRecord g_testDynamicData[] = {
+    {
+        .id   = string_static("dynamic.fonttex"),
+        .data = string_static("{"
+                              "  \"size\": 32,"
+                              "  \"glyphSize\": 16,"
+                              "  \"border\": 2,"
+                              "  \"baseline\": 0.3,"
+                              "  \"fonts\": [{ \"id\": \"font.ttf\", \"dynamic\": true}]"
+                              "}"),
+    },
+    {
+        .id   = string_static("dynamic-evict.fonttex"),
+        .data = string_static("{"
+                              "  \"size\": 32,"
+                              "  \"glyphSize\": 16,"
+                              "  \"border\": 2,"
+                              "  \"baseline\": 0.3,"
+                              "  \"fonts\": ["
+                              "    { \"id\": \"font.ttf\", \"dynamic\": true},"
+                              "    { \"id\": \"font.ttf\", \"variation\": 1, \"dynamic\": true},"
+                              "    { \"id\": \"font.ttf\", \"variation\": 2, \"dynamic\": true},"
+                              "    { \"id\": \"font.ttf\", \"variation\": 3, \"dynamic\": true}"
+                              "  ]"
+                              "}"),
+    },
+};
+
 static const AssetMemRecord g_errorTestData[] = {
     {
         .id   = string_static("no-font.fonttex"),
@@ -116,9 +146,34 @@ ecs_view_define(AssetView) {
   ecs_access_read(AssetTextureComp);
 }
 
+ecs_view_define(AssetDirtyView) { ecs_access_read(AssetTextureDirtyComp); }
+
 ecs_module_init(loader_texture_font_test_module) {
   ecs_register_view(ManagerView);
   ecs_register_view(AssetView);
+  ecs_register_view(AssetDirtyView);
+}
+
+/**
+ * Lookup the given characters until all of them are rasterized.
+ */
+static bool test_fonttex_resolve(
+    EcsWorld* world, EcsRunner* runner, const EcsEntityId asset, const Unicode cp, const u8 vars) {
+  for (u32 i = 0; i != 1000; ++i) {
+    const AssetFontTexComp* ftx = ecs_utils_read_t(world, AssetView, asset, AssetFontTexComp);
+
+    bool resolved = true;
+    for (u8 variation = 0; variation != vars; ++variation) {
+      const AssetFontTexChar* ch = asset_fonttex_lookup(ftx, cp, variation);
+      resolved &= ch->cp == cp && ch->variation == variation;
+    }
+    if (resolved) {
+      return true;
+    }
+    ecs_run_sync(runner);
+    thread_sleep(time_millisecond);
+  }
+  return false;
 }
 
 spec(loader_texture_font) {
@@ -200,6 +255,113 @@ spec(loader_texture_font) {
     check(!ecs_world_has_t(world, asset, AssetTextureComp));
   }
 
+  it("can rasterize characters of dynamic fonts on demand") {
+    const AssetMemRecord records[] = {
+        {.id = string_lit("font.ttf"), .data = testFontData},
+        g_testDynamicData[0],
+    };
+    asset_manager_create_mem(world, AssetManagerFlags_None, records, array_elems(records));
+    ecs_world_flush(world);
+
+    EcsEntityId asset;
+    {
+      AssetManagerComp* manager = ecs_utils_write_first_t(world, ManagerView, AssetManagerComp);
+      asset                     = asset_lookup(world, manager, string_lit("dynamic.fonttex"));
+    }
+    asset_acquire(world, asset);
+    asset_test_wait(runner);
+
+    check_require(ecs_world_has_t(world, asset, AssetLoadedComp));
+    {
+      const AssetFontTexComp* ftx = ecs_utils_read_t(world, AssetView, asset, AssetFontTexComp);
+      check_eq_int(ftx->characters.count, 1); // Only the 'missing' character is pre-generated.
+      check_eq_int(asset_fonttex_lookup(ftx, 0x31, 0)->cp, 0);
+    }
+
+    check_require(test_fonttex_resolve(world, runner, asset, 0x31 /* digit one */, 1));
+    check_require(test_fonttex_resolve(world, runner, asset, 0x41 /* not in the font */, 1));
+
+    const AssetFontTexComp* ftx = ecs_utils_read_t(world, AssetView, asset, AssetFontTexComp);
+    const AssetTextureComp* tex = ecs_utils_read_t(world, AssetView, asset, AssetTextureComp);
+    check_eq_int(tex->format, AssetTextureFormat_u8_r);
+
+    const AssetFontTexChar* chOne = asset_fonttex_lookup(ftx, 0x31, 0);
+    check_eq_int(chOne->glyphIndex, 1);
+
+    const AssetFontTexChar* chMissing = asset_fonttex_lookup(ftx, 0x41, 0);
+    check_eq_int(chMissing->glyphIndex, 0); // Uses the 'missing' glyph.
+
+    const AssetTextureDirtyComp* dirty =
+        ecs_utils_read_t(world, AssetDirtyView, asset, AssetTextureDirtyComp);
+    check_eq_int(dirty->x, 16);
+    check_eq_int(dirty->y, 0);
+    check_eq_int(dirty->width, 16);
+    check_eq_int(dirty->height, 16);
+
+    // Verify that the glyph was written to the atlas.
+    const u8* pixels      = asset_texture_data(tex).ptr;
+    bool      glyphPixels = false;
+    for (u32 y = 0; y != 16; ++y) {
+      for (u32 x = 16; x != 32; ++x) {
+        glyphPixels |= pixels[y * 32 + x] != 255; // 255 = Maximum distance away from a glyph.
+      }
+    }
+    check(glyphPixels);
+  }
+
+  it("evicts the least recently used dynamic glyphs when the atlas is full") {
+    const AssetMemRecord records[] = {
+        {.id = string_lit("font.ttf"), .data = testFontData},
+        g_testDynamicData[1],
+    };
+    asset_manager_create_mem(world, AssetManagerFlags_None, records, array_elems(records));
+    ecs_world_flush(world);
+
+    EcsEntityId asset;
+    {
+      AssetManagerComp* manager = ecs_utils_write_first_t(world, ManagerView, AssetManagerComp);
+      asset                     = asset_lookup(world, manager, string_lit("dynamic-evict.fonttex"));
+    }
+    asset_acquire(world, asset);
+    asset_test_wait(runner);
+    asset_test_wait(runner); // Acquiring the four fonts takes additional ticks.
+    check_require(ecs_world_has_t(world, asset, AssetLoadedComp));
+
+    // Fill all three dynamic slots (slot 0 contains the 'missing' glyph).
+    check_require(test_fonttex_resolve(world, runner, asset, 0x31, 3));
+
+    asset_test_wait(runner); // Let the glyphs become unused.
+
+    // Requesting the fourth variation evicts one of the unused glyphs.
+    const AssetFontTexComp* ftx = ecs_utils_read_t(world, AssetView, asset, AssetFontTexComp);
+    asset_fonttex_lookup(ftx, 0x31, 3);
+
+    bool resident[4] = {0};
+    for (u32 i = 0; i != 1000; ++i) {
+      ecs_run_sync(runner);
+      ftx = ecs_utils_read_t(world, AssetView, asset, AssetFontTexComp);
+      heap_array_for_t(ftx->characters, AssetFontTexChar, ch) {
+        if (ch->cp == 0x31 && ch->variation == 3) {
+          resident[3] = true;
+        }
+      }
+      if (resident[3]) {
+        break;
+      }
+      thread_sleep(time_millisecond);
+    }
+    check_require(resident[3]);
+
+    u32 residentCount = 0;
+    heap_array_for_t(ftx->characters, AssetFontTexChar, ch) {
+      if (ch->cp == 0x31) {
+        check(ch->glyphIndex >= 1 && ch->glyphIndex <= 3);
+        ++residentCount;
+      }
+    }
+    check_eq_int(residentCount, 3);
+  }
+
   it("fails when loading invalid fonttex files") {
     AssetMemRecord records[array_elems(g_errorTestData) + 1] = {
         {.id = string_lit("font.ttf"), .data = testFontData},
@@ -5,6 +5,8 @@
 #include "core/alloc.h"
 #include "core/array.h"
 #include "core/base64.h"
+#include "core/thread.h"
+#include "core/time.h"
 #include "ecs/utils.h"
 #include "ecs/world.h"
 
@@ -171,10 +173,29 @@ static const struct {
 
 ecs_view_define(ManagerView) { ecs_access_write(AssetManagerComp); }
 ecs_view_define(AssetView) { ecs_access_read(AssetTextureComp); }
+ecs_view_define(AssetStateView) { ecs_access_read(AssetComp); }
 
 ecs_module_init(loader_texture_png_test_module) {
   ecs_register_view(ManagerView);
   ecs_register_view(AssetView);
+  ecs_register_view(AssetStateView);
+}
+
+static bool test_asset_loading(EcsWorld* world, const EcsEntityId asset) {
+  return asset_is_loading(ecs_utils_read_t(world, AssetStateView, asset, AssetComp));
+}
+
+/**
+ * Streaming loads are completed on background threads; tick until the asset is no longer loading.
+ */
+static void test_wait_streaming(EcsRunner* runner, EcsWorld* world, const EcsEntityId asset) {
+  static const u32 g_maxTicks = 1000;
+  asset_test_wait(runner);
+  for (u32 i = 0; i != g_maxTicks && test_asset_loading(world, asset); ++i) {
+    thread_sleep(time_millisecond);
+    ecs_run_sync(runner);
+  }
+  asset_test_wait(runner);
 }
 
 spec(loader_texture_png) {
@@ -254,6 +275,76 @@ spec(loader_texture_png) {
     string_free(g_allocHeap, record.data);
   }
 
+  it("can load png images on the streaming threads") {
+    AssetMemRecord records[array_elems(g_testData)];
+    for (usize i = 0; i != array_elems(g_testData); ++i) {
+      records[i] = (AssetMemRecord){
+          .id   = g_testData[i].id,
+          .data = string_dup(g_allocHeap, base64_decode_scratch(g_testData[i].base64Data)),
+      };
+    }
+    const AssetManagerFlags flags = AssetManagerFlags_Streaming;
+    asset_manager_create_mem(world, flags, records, array_elems(g_testData));
+    ecs_world_flush(world);
+
+    EcsEntityId assets[array_elems(g_testData)];
+    for (usize i = 0; i != array_elems(g_testData); ++i) {
+      AssetManagerComp* manager = ecs_utils_write_first_t(world, ManagerView, AssetManagerComp);
+      assets[i]                 = asset_lookup(world, manager, records[i].id);
+      asset_acquire(world, assets[i]);
+    }
+    asset_priority_hint(world, assets[0], AssetPriority_High);
+
+    for (usize i = 0; i != array_elems(g_testData); ++i) {
+      test_wait_streaming(runner, world, assets[i]);
+
+      check_require(ecs_world_has_t(world, assets[i], AssetLoadedComp));
+      const AssetTextureComp* tex = ecs_utils_read_t(world, AssetView, assets[i], AssetTextureComp);
+      check_eq_int(tex->format, g_testData[i].format);
+      for (usize p = 0; p != g_testData[i].pixelCount; ++p) {
+        const GeoColor pixel = asset_texture_at(tex, 0, p);
+        check_eq_float(pixel.r, g_testData[i].pixels[p].r, 1e-2);
+        check_eq_float(pixel.a, g_testData[i].pixels[p].a, 1e-2);
+      }
+    }
+
+    array_for_t(records, AssetMemRecord, rec) { string_free(g_allocHeap, rec->data); }
+  }
+
+  it("can cancel streaming png loads by releasing the asset") {
+    const AssetMemRecord record = {
+        .id   = string_lit("tex.png"),
+        .data = string_dup(g_allocHeap, base64_decode_scratch(g_testData[0].base64Data)),
+    };
+    asset_manager_create_mem(world, AssetManagerFlags_Streaming, &record, 1);
+    ecs_world_flush(world);
+
+    EcsEntityId asset;
+    {
+      AssetManagerComp* manager = ecs_utils_write_first_t(world, ManagerView, AssetManagerComp);
+      asset                     = asset_lookup(world, manager, string_lit("tex.png"));
+    }
+    asset_acquire(world, asset);
+    ecs_run_sync(runner);
+    ecs_run_sync(runner);
+    check(test_asset_loading(world, asset));
+
+    // Release while loading; load is either cancelled or (when already finished) unloaded.
+    asset_release(world, asset);
+    test_wait_streaming(runner, world, asset);
+    check(!ecs_world_has_t(world, asset, AssetLoadedComp));
+    check(!ecs_world_has_t(world, asset, AssetFailedComp));
+    check(!ecs_world_has_t(world, asset, AssetTextureComp));
+
+    // Re-acquiring restarts the load.
+    asset_acquire(world, asset);
+    test_wait_streaming(runner, world, asset);
+    check(ecs_world_has_t(world, asset, AssetLoadedComp));
+    check(ecs_world_has_t(world, asset, AssetTextureComp));
+
+    string_free(g_allocHeap, record.data);
+  }
+
   it("fails when loading invalid png files") {
     AssetMemRecord records[array_elems(g_errorTestData)];
     for (usize i = 0; i != array_elems(g_errorTestData); ++i) {
@@ -0,0 +1,104 @@
+#include "asset/manager.h"
+#include "asset/register.h"
+#include "asset/texture.h"
+#include "check/spec.h"
+#include "core/alloc.h"
+#include "core/bc.h"
+#include "core/math.h"
+#include "ecs/utils.h"
+#include "ecs/world.h"
+
+#include "utils.h"
+
+static const AssetMemRecord g_testCheckerRecord = {
+    .id   = string_static("checker.proctex"),
+    .data = string_static("{"
+                          "  \"type\": \"Checker\","
+                          "  \"channels\": \"One\","
+                          "  \"mipmaps\": true,"
+                          "  \"size\": 256,"
+                          "  \"frequency\": 2,"
+                          "  \"power\": 1,"
+                          "  \"seed\": 1"
+                          "}"),
+};
+
+static Bc0Block test_tex_block_bc4(const AssetTextureComp* tex, const u32 mip, const u32 index) {
+  usize offset = 0;
+  for (u32 m = 0; m != mip; ++m) {
+    const u32 blocksX = math_max((tex->width >> m) / 4, 1);
+    const u32 blocksY = math_max((tex->height >> m) / 4, 1);
+    offset += blocksX * blocksY * sizeof(Bc4Block);
+  }
+  const Bc4Block* blocks = (const Bc4Block*)((const u8*)asset_texture_data(tex).ptr + offset);
+
+  Bc0Block res;
+  bc4_decode(&blocks[index], &res);
+  return res;
+}
+
+ecs_view_define(ManagerView) { ecs_access_write(AssetManagerComp); }
+ecs_view_define(AssetView) { ecs_access_read(AssetTextureComp); }
+
+ecs_module_init(loader_texture_proc_test_module) {
+  ecs_register_view(ManagerView);
+  ecs_register_view(AssetView);
+}
+
+spec(loader_texture_proc) {
+
+  EcsDef*    def    = null;
+  EcsWorld*  world  = null;
+  EcsRunner* runner = null;
+
+  setup() {
+    def = ecs_def_create(g_allocHeap);
+    asset_register(def, &(AssetRegisterContext){0});
+    ecs_register_module(def, loader_texture_proc_test_module);
+
+    world  = ecs_world_create(g_allocHeap, def);
+    runner = ecs_runner_create(g_allocHeap, world, EcsRunnerFlags_None);
+  }
+
+  it("can compress procedural textures with generated mips") {
+    asset_manager_create_mem(world, AssetManagerFlags_None, &g_testCheckerRecord, 1);
+    ecs_world_flush(world);
+
+    EcsEntityId asset;
+    {
+      AssetManagerComp* manager = ecs_utils_write_first_t(world, ManagerView, AssetManagerComp);
+      asset                     = asset_lookup(world, manager, g_testCheckerRecord.id);
+    }
+    asset_acquire(world, asset);
+
+    asset_test_wait(runner);
+
+    check_require(ecs_world_has_t(world, asset, AssetLoadedComp));
+    const AssetTextureComp* tex = ecs_utils_read_t(world, AssetView, asset, AssetTextureComp);
+    check_eq_int(tex->format, AssetTextureFormat_Bc4);
+    check_eq_int(tex->mipsData, 9);
+
+    // The checker cells are 64 pixels wide; 16 blocks on mip 0.
+    check_eq_int(test_tex_block_bc4(tex, 0, 0).colors[0].r, 0);
+    check_eq_int(test_tex_block_bc4(tex, 0, 16).colors[0].r, 255);
+    check_eq_int(test_tex_block_bc4(tex, 0, 64 * 16).colors[0].r, 255);
+    check_eq_int(test_tex_block_bc4(tex, 0, 64 * 16 + 16).colors[0].r, 0);
+
+    // The cells are 4 pixels on mip 4; 1 block.
+    check_eq_int(test_tex_block_bc4(tex, 4, 0).colors[0].r, 0);
+    check_eq_int(test_tex_block_bc4(tex, 4, 1).colors[0].r, 255);
+
+    // Mips smaller then a cell average to gray.
+    for (u32 mip = 7; mip != 9; ++mip) {
+      const Bc0Block block = test_tex_block_bc4(tex, mip, 0);
+      check_eq_float(block.colors[0].r, 127, 2);
+      check_eq_float(block.colors[15].r, 127, 2);
+    }
+  }
+
+  teardown() {
+    ecs_runner_destroy(runner);
+    ecs_world_destroy(world);
+    ecs_def_destroy(def);
+  }
+}
@@ -258,7 +258,7 @@ spec(manager) {
 
     check(results[0] != results[1]);
     check(results[0] == entityA || results[0] == entityB);
-    check(results[1] == entityA || results[0] == entityB);
+    check(results[1] == entityA || results[1] == entityB);
   }
 
   it("fails to find any assets with an empty pattern") {
@@ -0,0 +1,199 @@
+#include "asset/data.h"
+#include "check/spec.h"
+#include "core/alloc.h"
+#include "core/array.h"
+#include "core/diag.h"
+#include "core/dynstring.h"
+#include "core/file.h"
+#include "core/format.h"
+#include "core/path.h"
+#include "core/thread.h"
+#include "core/time.h"
+#include "data/utils.h"
+#include "data/write.h"
+
+#include "pack.h"
+#include "repo.h"
+#include "utils.h"
+
+#define test_pack_header_size (usize_mebibyte)
+#define test_pack_region_size (64 * usize_kibibyte)
+
+static const String g_testPackLevel    = string_static("test.level");
+static const String g_testPackAssets[] = {
+    string_static("a.raw"),
+    string_static("b.raw"),
+    string_static("c.raw"),
+    string_static("d.raw"),
+};
+
+/**
+ * Write a pack with the level in the small-assets region (0) and every asset in its own region.
+ */
+static void test_pack_write(const String path) {
+  const u32 regionCount = 1 + array_elems(g_testPackAssets);
+  const u64 fileSize    = test_pack_header_size + regionCount * test_pack_region_size;
+
+  AssetPackHeader header = {
+      .entries = dynarray_create_t(g_allocHeap, AssetPackEntry, regionCount),
+      .regions = dynarray_create_t(g_allocHeap, AssetPackRegion, regionCount),
+  };
+  DynString buffer = dynstring_create(g_allocHeap, fileSize);
+  mem_set(dynstring_push(&buffer, fileSize), 0);
+
+  for (u32 region = 0; region != regionCount; ++region) {
+    const String id     = region ? g_testPackAssets[region - 1] : g_testPackLevel;
+    const u64    offset = test_pack_header_size + region * test_pack_region_size;
+    mem_cpy(mem_slice(dynstring_view(&buffer), offset, id.size), id); // Use the id as the content.
+
+    *dynarray_push_t(&header.regions, AssetPackRegion) = (AssetPackRegion){
+        .offset = offset,
+        .size   = test_pack_region_size,
+    };
+    const AssetPackEntry entry = {
+        .id     = id,
+        .idHash = string_hash(id),
+        .format = region ? AssetFormat_Raw : AssetFormat_Level,
+        .region = (u16)region,
+        .size   = (u32)id.size,
+    };
+    *dynarray_insert_sorted_t(&header.entries, AssetPackEntry, asset_pack_compare_entry, &entry) =
+        entry;
+  }
+
+  DynString headerBuffer = dynstring_create(g_allocHeap, usize_kibibyte);
+  data_write_bin(g_dataReg, &headerBuffer, g_assetPackMeta, mem_var(header));
+  diag_assert(headerBuffer.size <= test_pack_header_size);
+  mem_cpy(dynstring_view(&buffer), dynstring_view(&headerBuffer));
+
+  if (file_write_to_path_sync(path, dynstring_view(&buffer))) {
+    diag_crash_msg("Failed to write test pack file");
+  }
+  dynstring_destroy(&headerBuffer);
+  dynstring_destroy(&buffer);
+  dynarray_destroy(&header.entries);
+  dynarray_destroy(&header.regions);
+}
+
+static void test_pack_write_order(const String packPath, const String* assets, const u32 count) {
+  AssetPackLoadOrder   order = {.levels = dynarray_create_t(g_allocHeap, AssetPackLevelOrder, 1)};
+  AssetPackLevelOrder* level = dynarray_push_t(&order.levels, AssetPackLevelOrder);
+
+  level->level  = g_testPackLevel;
+  level->assets = dynarray_create_t(g_allocHeap, String, count);
+  for (u32 i = 0; i != count; ++i) {
+    *dynarray_push_t(&level->assets, String) = assets[i];
+  }
+  DynString buffer = dynstring_create(g_allocHeap, usize_kibibyte);
+  data_write_bin(g_dataReg, &buffer, g_assetPackLoadOrderMeta, mem_var(order));
+
+  const String orderPath = fmt_write_scratch("{}.order", fmt_text(packPath));
+  if (file_write_to_path_sync(orderPath, dynstring_view(&buffer))) {
+    diag_crash_msg("Failed to write test pack order file");
+  }
+  dynstring_destroy(&buffer);
+  dynarray_destroy(&level->assets);
+  dynarray_destroy(&order.levels);
+}
+
+static void test_pack_load(AssetRepo* repo, const String id) {
+  AssetSource* src = asset_repo_open(repo, id, (AssetRepoLoaderHasher){0});
+  if (!src || !string_eq(src->data, id)) {
+    diag_crash_msg("Failed to load asset from test pack: {}", fmt_text(id));
+  }
+  asset_repo_close(src);
+}
+
+spec(repo_pack) {
+
+  Allocator* alloc = null;
+  String     rootPath;
+  String     packPath;
+
+  setup() {
+    asset_data_init(false /* devSupport */);
+
+    alloc    = alloc_chunked_create(g_allocHeap, alloc_bump_create, 16 * usize_kibibyte);
+    rootPath = asset_test_dir_create(alloc);
+    packPath = string_dup(alloc, path_build_scratch(rootPath, string_lit("test.pack")));
+    test_pack_write(packPath);
+  }
+
+  it("keeps released regions resident") {
+    AssetRepo* repo = asset_repo_create_pack(packPath, false /* recordLoadOrder */);
+    check_require(repo);
+
+    test_pack_load(repo, string_lit("a.raw"));
+    const AssetRepoPackStats stats = asset_repo_pack_stats(repo);
+    check_eq_int(stats.residentSize, test_pack_region_size);
+
+    test_pack_load(repo, string_lit("a.raw"));
+    check_eq_int(asset_repo_pack_stats(repo).maps, stats.maps); // Not mapped again.
+
+    asset_repo_destroy(repo);
+  }
+
+  it("evicts the least recently used regions when exceeding the residency budget") {
+    AssetRepo* repo = asset_repo_create_pack(packPath, false /* recordLoadOrder */);
+    check_require(repo);
+    asset_repo_pack_budget_set(repo, test_pack_region_size * 5 / 2);
+
+    test_pack_load(repo, string_lit("a.raw"));
+    test_pack_load(repo, string_lit("b.raw"));
+    check_eq_int(asset_repo_pack_stats(repo).evictions, 0);
+
+    // Exceeds the budget; regions are evicted until the size drops below the low watermark.
+    test_pack_load(repo, string_lit("c.raw"));
+
+    const AssetRepoPackStats stats = asset_repo_pack_stats(repo);
+    check_eq_int(stats.evictions, 2);
+    check_eq_int(stats.residentSize, test_pack_region_size);
+
+    test_pack_load(repo, string_lit("c.raw")); // Most recently used; still resident.
+    check_eq_int(asset_repo_pack_stats(repo).maps, stats.maps);
+
+    test_pack_load(repo, string_lit("a.raw")); // Least recently used; was evicted.
+    check_eq_int(asset_repo_pack_stats(repo).maps, stats.maps + 1);
+
+    asset_repo_destroy(repo);
+  }
+
+  it("prefetches the regions of a level in the recorded order") {
+    const String order[] = {string_lit("c.raw"), string_lit("a.raw"), string_lit("b.raw")};
+    test_pack_write_order(packPath, order, array_elems(order));
+
+    AssetRepo* repo = asset_repo_create_pack(packPath, false /* recordLoadOrder */);
+    check_require(repo);
+    asset_repo_pack_budget_set(repo, test_pack_region_size * 2); // Only fits two regions.
+
+    test_pack_load(repo, g_testPackLevel); // Starts prefetching the level's assets.
+
+    const TimeSteady start = time_steady_clock();
+    while (asset_repo_pack_stats(repo).prefetching) {
+      if (time_steady_duration(start, time_steady_clock()) > time_seconds(5)) {
+        break;
+      }
+      thread_sleep(time_millisecond);
+    }
+    const AssetRepoPackStats stats = asset_repo_pack_stats(repo);
+    check(!stats.prefetching);
+    check_eq_int(stats.prefetches, 2);
+    check_eq_int(stats.residentSize, test_pack_region_size * 2);
+
+    // The first two assets in the recorded order are resident, the last one did not fit.
+    test_pack_load(repo, string_lit("c.raw"));
+    test_pack_load(repo, string_lit("a.raw"));
+    check_eq_int(asset_repo_pack_stats(repo).maps, stats.maps);
+
+    test_pack_load(repo, string_lit("b.raw"));
+    check_eq_int(asset_repo_pack_stats(repo).maps, stats.maps + 1);
+    check_eq_int(asset_repo_pack_stats(repo).prefetches, 2);
+
+    asset_repo_destroy(repo);
+  }
+
+  teardown() {
+    asset_test_dir_destroy(rootPath);
+    alloc_chunked_destroy(alloc);
+  }
+}
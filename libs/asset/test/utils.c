@@ -1,3 +1,10 @@
+#include "core/alloc.h"
+#include "core/diag.h"
+#include "core/file.h"
+#include "core/file_iterator.h"
+#include "core/path.h"
+#include "core/rng.h"
+
 #include "utils.h"
 
 void asset_test_wait(EcsRunner* runner) {
@@ -6,3 +13,29 @@ void asset_test_wait(EcsRunner* runner) {
     ecs_run_sync(runner);
   }
 }
+
+String asset_test_dir_create(Allocator* alloc) {
+  const String dirName = path_name_random_scratch(g_rng, string_lit("volo"), string_empty);
+  const String dirPath = path_build_scratch(g_pathTempDir, dirName);
+
+  const FileResult res = file_create_dir_sync(dirPath);
+  if (res != FileResult_Success) {
+    diag_crash_msg("Failed to create test directory ({})", fmt_text(file_result_str(res)));
+  }
+  return string_dup(alloc, dirPath);
+}
+
+void asset_test_dir_destroy(const String path) {
+  FileIterator*     itr = file_iterator_create(g_allocHeap, path);
+  FileIteratorEntry entry;
+  while (file_iterator_next(itr, &entry) == FileIteratorResult_Found) {
+    const String entryPath = path_build_scratch(path, entry.name);
+    if (entry.type == FileType_Directory) {
+      asset_test_dir_destroy(entryPath);
+    } else {
+      file_delete_sync(entryPath);
+    }
+  }
+  file_iterator_destroy(itr);
+  file_delete_dir_sync(path);
+}
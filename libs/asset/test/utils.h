@@ -1,4 +1,5 @@
 #pragma once
+#include "core/string.h"
 #include "ecs/runner.h"
 
 /**
@@ -6,3 +7,14 @@
  * process requests.
  */
 void asset_test_wait(EcsRunner*);
+
+/**
+ * Create a new (uniquely named) directory in the temp directory.
+ * NOTE: Returned path is allocated in the given allocator.
+ */
+String asset_test_dir_create(Allocator*);
+
+/**
+ * Delete the given directory including all of its content.
+ */
+void asset_test_dir_destroy(String path);
@@ -0,0 +1,40 @@
+#pragma once
+#include "core/forward.h"
+
+/**
+ * IMA ADPCM (Adaptive Differential Pulse-Code Modulation) sound compression.
+ * Compresses 16 bit samples to 4 bits per sample.
+ * https://en.wikipedia.org/wiki/Adaptive_differential_pulse-code_modulation
+ *
+ * Samples are stored in blocks of 'adpcm_block_frames' frames that can be decoded independently.
+ * Within a block the channels are stored sequentially, each channel starts with a header:
+ * - i16: Predictor, the first sample of the block (uncompressed).
+ * - u8:  Step index.
+ * - u8:  Padding.
+ * Followed by the remaining samples as 4 bit codes (low nibble first).
+ */
+
+#define adpcm_block_frames 256
+#define adpcm_block_channel_size (4 + (adpcm_block_frames / 2))
+
+/**
+ * Size (in bytes) of the blocks required to store the given amount of frames.
+ */
+usize adpcm_block_size(u32 channels);
+u32   adpcm_block_count(u32 frameCount);
+
+/**
+ * Encode interleaved 16 bit samples.
+ * NOTE: The last block is padded with silence.
+ *
+ * Pre-condition: out.size >= adpcm_block_size(channels) * adpcm_block_count(frameCount).
+ */
+void adpcm_encode(const i16* samples, u32 frameCount, u32 channels, Mem out);
+
+/**
+ * Decode a single block to interleaved normalized (-1 to 1) samples.
+ *
+ * Pre-condition: block.size >= adpcm_block_size(channels).
+ * Pre-condition: out has room for 'adpcm_block_frames * channels' samples.
+ */
+void adpcm_decode_block(Mem block, u32 channels, f32* out);
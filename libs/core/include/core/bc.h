@@ -44,6 +44,18 @@ typedef struct {
 
 ASSERT(sizeof(Bc4Block) == 8, "Unexpected bc4 block size");
 
+typedef struct {
+  Bc4Block red, green;
+} Bc5Block;
+
+ASSERT(sizeof(Bc5Block) == 16, "Unexpected bc5 block size");
+
+typedef struct {
+  u64 data[2]; // Variable layout bit-stream, see the BC7 specification.
+} Bc7Block;
+
+ASSERT(sizeof(Bc7Block) == 16, "Unexpected bc7 block size");
+
 /**
  * Extract / scanout a single 4x4 BC0 (aka raw pixels) block.
  * Pre-condition: Width (and also height) input pixels have to be multiples of 4.
@@ -69,3 +81,17 @@ void bc3_decode(const Bc3Block* restrict in, Bc0Block* restrict out);
  */
 void bc4_encode(const Bc0Block* restrict in, Bc4Block* restrict out);
 void bc4_decode(const Bc4Block* restrict in, Bc0Block* restrict out);
+
+/**
+ * Encode / decode a single 4x4 BC5 (RG) block.
+ */
+void bc5_encode(const Bc0Block* restrict in, Bc5Block* restrict out);
+void bc5_decode(const Bc5Block* restrict in, Bc0Block* restrict out);
+
+/**
+ * Encode / decode a single 4x4 BC7 (RGBA) block.
+ * NOTE: Only mode 6 (single subset, 7777.1 endpoints with 4 bit indices) is supported; blocks
+ * using different modes decode to zero.
+ */
+void bc7_encode(const Bc0Block* restrict in, Bc7Block* restrict out);
+void bc7_decode(const Bc7Block* restrict in, Bc0Block* restrict out);
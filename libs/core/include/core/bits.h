@@ -169,7 +169,9 @@ u64 bits_nextpow2_64(u64);
 u32 bits_hash_32(Mem);
 u32 bits_hash_32_val(u32);
 u32 bits_hash_32_combine(u32 x, u32 y);
+u64 bits_hash_64(Mem);
 u64 bits_hash_64_val(u64);
+u64 bits_hash_64_combine(u64 x, u64 y);
 
 /**
  * Compute the CRC32 (Cyclic Redundancy Check) of the input data.
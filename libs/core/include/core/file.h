@@ -73,6 +73,7 @@ typedef struct sFileInfo {
   usize    size;
   FileType type;
   TimeReal accessTime, modTime;
+  u64      id; // Identifier of the file on its volume (inode / file-index); zero if unknown.
 } FileInfo;
 
 /**
@@ -175,8 +176,21 @@ FileResult file_seek_sync(File*, usize position);
  */
 FileResult file_resize_sync(File*, usize size);
 
+/**
+ * Synchronously flush the file content to the storage device.
+ * NOTE: Blocks until the device reports that the data has been persisted.
+ */
+FileResult file_sync(File*);
+
+/**
+ * Synchronously flush the directory entries (for example a new or renamed file) to the device.
+ * NOTE: Not needed on all platforms, returns success when directories cannot be synced.
+ */
+FileResult file_sync_dir(String path);
+
 /**
  * Synchronously retrieve information about a file.
+ * NOTE: The file id is not available on all platforms when querying by path.
  */
 FileInfo file_stat_sync(File*);
 FileInfo file_stat_path_sync(String path);
@@ -110,6 +110,19 @@ simd_vec_x_merge(const SimdVec a, const SimdVec b, const SimdVec c, const SimdVe
   return _mm_unpacklo_ps(tmpA, tmpB);         // a.x, b.x, c.x, d.x.
 }
 
+/**
+ * Interleave the lower (x, y) or upper (z, w) components of two vectors.
+ * lo: a.x, b.x, a.y, b.y.
+ * hi: a.z, b.z, a.w, b.w.
+ */
+MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_interleave_lo(const SimdVec a, const SimdVec b) {
+  return _mm_unpacklo_ps(a, b);
+}
+
+MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_interleave_hi(const SimdVec a, const SimdVec b) {
+  return _mm_unpackhi_ps(a, b);
+}
+
 MAYBE_UNUSED INLINE_HINT static SimdVec
 simd_vec_set(const f32 a, const f32 b, const f32 c, const f32 d) {
   return _mm_set_ps(d, c, b, a);
@@ -222,6 +235,10 @@ MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_greater_eq_u16(const SimdVec a,
       _mm_castps_si128(a), _mm_max_epu16(_mm_castps_si128(a), _mm_castps_si128(b))));
 }
 
+MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_eq(const SimdVec a, const SimdVec b) {
+  return _mm_cmpeq_ps(a, b);
+}
+
 MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_eq_u8(const SimdVec a, const SimdVec b) {
   return _mm_castsi128_ps(_mm_cmpeq_epi8(_mm_castps_si128(a), _mm_castps_si128(b)));
 }
@@ -348,6 +365,13 @@ MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_f16_to_f32(const SimdVec vec) {
   return _mm_cvtph_ps(_mm_castps_si128(vec));
 }
 
+/**
+ * Convert four signed 32 bit integers to 32 bit floating point values.
+ */
+MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_i32_to_f32(const SimdVec vec) {
+  return _mm_cvtepi32_ps(_mm_castps_si128(vec));
+}
+
 MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_abs(const SimdVec vec) {
   return _mm_andnot_ps(simd_vec_sign_mask(), vec);
 }
@@ -34,6 +34,79 @@ void sort_quicksort(u8* begin, u8* end, u16 stride, CompareFunc);
  */
 void sort_bubblesort(u8* begin, u8* end, u16 stride, CompareFunc);
 
+/**
+ * Sort elements according to the given compare function using a (bottom-up) merge sort.
+ * NOTE: The sort is stable, meaning order of equal elements is preserved.
+ * Pre-condition: scratch.size >= (end - begin).
+ * Pre-condition: stride <= 128.
+ */
+#define sort_mergesort_t(_BEGIN_, _END_, _TYPE_, _COMPARE_FUNC_, _SCRATCH_)                        \
+  sort_mergesort((u8*)(_BEGIN_), (u8*)(_END_), sizeof(_TYPE_), (_COMPARE_FUNC_), (_SCRATCH_))
+
+/**
+ * Sort elements according to the given compare function using a (bottom-up) merge sort.
+ * NOTE: The sort is stable, meaning order of equal elements is preserved.
+ * Pre-condition: scratch.size >= (end - begin).
+ * Pre-condition: stride <= 128.
+ */
+void sort_mergesort(u8* begin, u8* end, u16 stride, CompareFunc, Mem scratch);
+
+/**
+ * Radix sorting routines.
+ * Sort elements on an unsigned integer key that is stored inside the element, the rest of the
+ * element is moved along as the payload. Elements are sorted one byte of the key at a time (least
+ * significant first) so the cost is linear in the element count; passes where all keys have the
+ * same byte are skipped.
+ */
+
+typedef enum {
+  SortRadixFlags_None       = 0,
+  SortRadixFlags_Descending = 1 << 0, // Sort from the highest to the lowest key.
+} SortRadixFlags;
+
+/**
+ * Sort elements on the given (unsigned integer) key field.
+ * NOTE: The sort is stable, meaning order of equal elements is preserved.
+ * Pre-condition: scratch.size >= (end - begin).
+ * Pre-condition: (end - begin) / stride <= u32_max.
+ */
+#define sort_radix_u16_t(_BEGIN_, _END_, _TYPE_, _KEY_FIELD_, _FLAGS_, _SCRATCH_)                  \
+  sort_radix_u16(                                                                                  \
+      (u8*)(_BEGIN_),                                                                              \
+      (u8*)(_END_),                                                                                \
+      sizeof(_TYPE_),                                                                              \
+      offsetof(_TYPE_, _KEY_FIELD_),                                                               \
+      (_FLAGS_),                                                                                   \
+      (_SCRATCH_))
+
+#define sort_radix_u32_t(_BEGIN_, _END_, _TYPE_, _KEY_FIELD_, _FLAGS_, _SCRATCH_)                  \
+  sort_radix_u32(                                                                                  \
+      (u8*)(_BEGIN_),                                                                              \
+      (u8*)(_END_),                                                                                \
+      sizeof(_TYPE_),                                                                              \
+      offsetof(_TYPE_, _KEY_FIELD_),                                                               \
+      (_FLAGS_),                                                                                   \
+      (_SCRATCH_))
+
+#define sort_radix_u64_t(_BEGIN_, _END_, _TYPE_, _KEY_FIELD_, _FLAGS_, _SCRATCH_)                  \
+  sort_radix_u64(                                                                                  \
+      (u8*)(_BEGIN_),                                                                              \
+      (u8*)(_END_),                                                                                \
+      sizeof(_TYPE_),                                                                              \
+      offsetof(_TYPE_, _KEY_FIELD_),                                                               \
+      (_FLAGS_),                                                                                   \
+      (_SCRATCH_))
+
+/**
+ * Sort elements on the (unsigned integer) key at 'keyOffset' bytes into each element.
+ * NOTE: The sort is stable, meaning order of equal elements is preserved.
+ * Pre-condition: scratch.size >= (end - begin).
+ * Pre-condition: (end - begin) / stride <= u32_max.
+ */
+void sort_radix_u16(u8* begin, u8* end, u16 stride, u16 keyOffset, SortRadixFlags, Mem scratch);
+void sort_radix_u32(u8* begin, u8* end, u16 stride, u16 keyOffset, SortRadixFlags, Mem scratch);
+void sort_radix_u64(u8* begin, u8* end, u16 stride, u16 keyOffset, SortRadixFlags, Mem scratch);
+
 /**
  * Index based sorting routines.
  * Instead of operating directly on memory it operates on indices and leaves the memory operations
@@ -23,6 +23,11 @@ StringTable* stringtable_create(Allocator*);
  * Destroy a StringTable instance.
  */
 void stringtable_destroy(StringTable*);
+
+/**
+ * Remove all strings from the table.
+ * NOTE: Not thread-safe, previously returned strings are invalidated.
+ */
 void stringtable_reset(StringTable*);
 
 /**
@@ -33,14 +38,14 @@ u32 stringtable_count(const StringTable*);
 /**
  * Lookup a String by hash.
  * NOTE: If the hash has not been added to the table an empty String is returned.
- * NOTE: Thread-safe.
+ * NOTE: Thread-safe and lock-free.
  */
 String stringtable_lookup(const StringTable*, StringHash);
 
 /**
  * Add the given string to the StringTable.
  * NOTE: This is a no-op if the string is already in the table.
- * NOTE: Thread-safe.
+ * NOTE: Thread-safe, only takes a lock when the string was not in the table yet.
  * Pre-condition: string.size <= 512
  */
 StringHash stringtable_add(StringTable*, String);
@@ -49,7 +54,7 @@ StringHash stringtable_add(StringTable*, String);
  * Store a copy of the given string in the StringTable, the returned pointer is stable throughout
  * the table's lifetime.
  * NOTE: Strings are deduplicated: returns an existing string if one matches.
- * NOTE: Thread-safe.
+ * NOTE: Thread-safe, only takes a lock when the string was not in the table yet.
  * Pre-condition: string.size <= 512
  */
 String stringtable_intern(StringTable*, String);
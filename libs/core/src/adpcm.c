@@ -0,0 +1,144 @@
+#include "core/adpcm.h"
+#include "core/diag.h"
+#include "core/math.h"
+
+ASSERT((adpcm_block_frames % 2) == 0, "Adpcm block needs an even amount of frames");
+
+static const i8 g_adpcmIndexTable[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8,
+};
+
+static const i16 g_adpcmStepTable[89] = {
+    7,     8,     9,     10,    11,    12,    13,    14,    16,    17,    19,    21,    23,
+    25,    28,    31,    34,    37,    41,    45,    50,    55,    60,    66,    73,    80,
+    88,    97,    107,   118,   130,   143,   157,   173,   190,   209,   230,   253,   279,
+    307,   337,   371,   408,   449,   494,   544,   598,   658,   724,   796,   876,   963,
+    1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,  2272,  2499,  2749,  3024,  3327,
+    3660,  4026,  4428,  4871,  5358,  5894,  6484,  7132,  7845,  8630,  9493,  10442, 11487,
+    12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+
+typedef struct {
+  i32 predictor;
+  i32 stepIndex;
+} AdpcmState;
+
+static void adpcm_state_update(AdpcmState* state, const u8 code) {
+  const i32 step = g_adpcmStepTable[state->stepIndex];
+
+  i32 diff = step >> 3;
+  if (code & 1) {
+    diff += step >> 2;
+  }
+  if (code & 2) {
+    diff += step >> 1;
+  }
+  if (code & 4) {
+    diff += step;
+  }
+  state->predictor += (code & 8) ? -diff : diff;
+  state->predictor = math_clamp_i32(state->predictor, i16_min, i16_max);
+  state->stepIndex = math_clamp_i32(state->stepIndex + g_adpcmIndexTable[code], 0, 88);
+}
+
+static u8 adpcm_encode_sample(AdpcmState* state, const i16 sample) {
+  i32 step = g_adpcmStepTable[state->stepIndex];
+  i32 diff = sample - state->predictor;
+  u8  code = 0;
+  if (diff < 0) {
+    code = 8;
+    diff = -diff;
+  }
+  if (diff >= step) {
+    code |= 4;
+    diff -= step;
+  }
+  step >>= 1;
+  if (diff >= step) {
+    code |= 2;
+    diff -= step;
+  }
+  step >>= 1;
+  if (diff >= step) {
+    code |= 1;
+  }
+  // NOTE: Track the decoded value (instead of the input) to avoid accumulating errors.
+  adpcm_state_update(state, code);
+  return code;
+}
+
+/**
+ * Estimate a step index for the given sample delta, avoids a slow ramp-up at the start of a sound.
+ */
+static i32 adpcm_step_index_estimate(const i32 delta) {
+  const i32 absDelta = math_abs(delta);
+  i32       index    = 0;
+  while (index != 88 && g_adpcmStepTable[index] < absDelta) {
+    ++index;
+  }
+  return index;
+}
+
+usize adpcm_block_size(const u32 channels) { return adpcm_block_channel_size * channels; }
+
+u32 adpcm_block_count(const u32 frameCount) {
+  return (frameCount + adpcm_block_frames - 1) / adpcm_block_frames;
+}
+
+void adpcm_encode(const i16* samples, const u32 frameCount, const u32 channels, const Mem out) {
+  const u32   blockCount = adpcm_block_count(frameCount);
+  const usize blockSize  = adpcm_block_size(channels);
+  diag_assert(out.size >= blockSize * blockCount);
+
+  u8* outPtr = out.ptr;
+  for (u32 channel = 0; channel != channels; ++channel) {
+    AdpcmState state = {0};
+    if (frameCount > 1) {
+      state.stepIndex = adpcm_step_index_estimate(samples[channels + channel] - samples[channel]);
+    }
+    for (u32 block = 0; block != blockCount; ++block) {
+      const u32 frameBegin = block * adpcm_block_frames;
+      u8*       channelOut = outPtr + blockSize * block + adpcm_block_channel_size * channel;
+
+      state.predictor = samples[frameBegin * channels + channel];
+      channelOut[0]   = (u8)state.predictor;
+      channelOut[1]   = (u8)(state.predictor >> 8);
+      channelOut[2]   = (u8)state.stepIndex;
+      channelOut[3]   = 0;
+
+      u8* codes = channelOut + 4;
+      for (u32 i = 1; i != adpcm_block_frames; ++i) {
+        const u32 frame  = frameBegin + i;
+        const i16 sample = frame < frameCount ? samples[frame * channels + channel] : 0;
+        const u8  code   = adpcm_encode_sample(&state, sample);
+        if (i & 1) {
+          codes[(i - 1) / 2] = code;
+        } else {
+          codes[(i - 1) / 2] |= (u8)(code << 4);
+        }
+      }
+    }
+  }
+}
+
+void adpcm_decode_block(const Mem block, const u32 channels, f32* out) {
+  diag_assert(block.size >= adpcm_block_size(channels));
+  static const f32 g_i16MaxInv = 1.0f / i16_max;
+
+  const u8* blockPtr = block.ptr;
+  for (u32 channel = 0; channel != channels; ++channel) {
+    const u8*  channelData = blockPtr + adpcm_block_channel_size * channel;
+    AdpcmState state       = {
+              .predictor = (i16)(channelData[0] | (channelData[1] << 8)),
+              .stepIndex = math_min(channelData[2], 88),
+    };
+    out[channel] = (f32)state.predictor * g_i16MaxInv;
+
+    const u8* codes = channelData + 4;
+    for (u32 i = 1; i != adpcm_block_frames; ++i) {
+      const u8 byte = codes[(i - 1) / 2];
+      adpcm_state_update(&state, (i & 1) ? (byte & 0x0F) : (byte >> 4));
+      out[i * channels + channel] = (f32)state.predictor * g_i16MaxInv;
+    }
+  }
+}
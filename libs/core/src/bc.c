@@ -5,6 +5,10 @@
 #include "core/float.h"
 #include "core/math.h"
 
+#ifdef VOLO_SIMD
+#include "core/simd.h"
+#endif
+
 /**
  * Texture Block Compression.
  *
@@ -32,6 +36,70 @@ INLINE_HINT static BcVec bc_vec_mul(const BcVec a, const f32 scalar) {
 
 INLINE_HINT static f32 bc_vec_max(const BcVec a) { return math_max(a.x, math_max(a.y, a.z)); }
 
+#ifdef VOLO_SIMD
+/**
+ * Load a single channel of all 16 colors in the block as floats; four colors per vector.
+ */
+INLINE_HINT static void
+bc_simd_block_channel(const Bc0Block* b, const u32 channel, SimdVec out[PARAM_ARRAY_SIZE(4)]) {
+  const SimdVec mask = simd_vec_broadcast_u32(0xFF);
+  for (u32 i = 0; i != 4; ++i) {
+    SimdVec colors = simd_vec_load(&b->colors[i * 4]);
+    switch (channel) {
+    case 1:
+      colors = simd_vec_shift_right(colors, 8);
+      break;
+    case 2:
+      colors = simd_vec_shift_right(colors, 16);
+      break;
+    case 3:
+      colors = simd_vec_shift_right(colors, 24);
+      break;
+    }
+    out[i] = simd_vec_i32_to_f32(simd_vec_and(colors, mask));
+  }
+}
+
+/**
+ * Sum all 16 values; result is broadcast to all components.
+ */
+INLINE_HINT static SimdVec bc_simd_sum(const SimdVec v[PARAM_ARRAY_SIZE(4)]) {
+  const SimdVec sum = simd_vec_add(simd_vec_add(v[0], v[1]), simd_vec_add(v[2], v[3]));
+  return simd_vec_splat(simd_vec_add_comp(sum), 0);
+}
+
+INLINE_HINT static SimdVec bc_simd_min(const SimdVec v[PARAM_ARRAY_SIZE(4)]) {
+  const SimdVec min = simd_vec_min(simd_vec_min(v[0], v[1]), simd_vec_min(v[2], v[3]));
+  return simd_vec_splat(simd_vec_min_comp(min), 0);
+}
+
+INLINE_HINT static SimdVec bc_simd_max(const SimdVec v[PARAM_ARRAY_SIZE(4)]) {
+  const SimdVec max = simd_vec_max(simd_vec_max(v[0], v[1]), simd_vec_max(v[2], v[3]));
+  return simd_vec_splat(simd_vec_max_comp(max), 0);
+}
+
+/**
+ * Find the index of the first of the 16 values that is equal to the given value.
+ */
+INLINE_HINT static u32 bc_simd_find(const SimdVec v[PARAM_ARRAY_SIZE(4)], const SimdVec val) {
+  for (u32 i = 0; i != 4; ++i) {
+    const u32 mask = simd_vec_mask_u32(simd_vec_eq(v[i], val));
+    if (mask) {
+      return i * 4 + bits_ctz_32(mask);
+    }
+  }
+  UNREACHABLE
+}
+
+/**
+ * Pack four small integers (stored as floats) into a single value with the given bits per value.
+ * NOTE: The result has to fit in the float mantissa.
+ */
+INLINE_HINT static u32 bc_simd_pack(const SimdVec v, const SimdVec laneWeights) {
+  return (u32)simd_vec_x(simd_vec_add_comp(simd_vec_mul(v, laneWeights)));
+}
+#endif
+
 INLINE_HINT static u32 bc_color_dist3_sqr(const BcColor8888 a, const BcColor8888 b) {
   const i32 dR = b.r - a.r;
   const i32 dG = b.g - a.g;
@@ -106,6 +174,39 @@ typedef struct {
  * Compute the covariance matrix of the colors in the block.
  */
 INLINE_HINT static void bc_block_cov3(const Bc0Block* b, BcBlockCovariance* out) {
+  static const f32 g_u8MaxInv = 1.0f / u8_max;
+#ifdef VOLO_SIMD
+  SimdVec r[4], g[4], bl[4];
+  bc_simd_block_channel(b, 0, r);
+  bc_simd_block_channel(b, 1, g);
+  bc_simd_block_channel(b, 2, bl);
+
+  // NOTE: Mean is truncated to whole numbers to match the scalar implementation.
+  const SimdVec sixteenInv = simd_vec_broadcast(1.0f / 16);
+  const SimdVec meanR      = simd_vec_round_down(simd_vec_mul(bc_simd_sum(r), sixteenInv));
+  const SimdVec meanG      = simd_vec_round_down(simd_vec_mul(bc_simd_sum(g), sixteenInv));
+  const SimdVec meanB      = simd_vec_round_down(simd_vec_mul(bc_simd_sum(bl), sixteenInv));
+
+  SimdVec cov[6];
+  for (u32 i = 0; i != 6; ++i) {
+    cov[i] = simd_vec_zero();
+  }
+  for (u32 i = 0; i != 4; ++i) {
+    const SimdVec dR = simd_vec_sub(r[i], meanR);
+    const SimdVec dG = simd_vec_sub(g[i], meanG);
+    const SimdVec dB = simd_vec_sub(bl[i], meanB);
+
+    cov[0] = simd_vec_add(cov[0], simd_vec_mul(dR, dR));
+    cov[1] = simd_vec_add(cov[1], simd_vec_mul(dR, dG));
+    cov[2] = simd_vec_add(cov[2], simd_vec_mul(dR, dB));
+    cov[3] = simd_vec_add(cov[3], simd_vec_mul(dG, dG));
+    cov[4] = simd_vec_add(cov[4], simd_vec_mul(dG, dB));
+    cov[5] = simd_vec_add(cov[5], simd_vec_mul(dB, dB));
+  }
+  for (u32 i = 0; i != 6; ++i) {
+    out->mat[i] = simd_vec_x(simd_vec_add_comp(cov[i])) * g_u8MaxInv;
+  }
+#else
   const BcColor8888 mean = bc_block_mean3(b);
 
   i32 cov[6] = {0};
@@ -123,9 +224,9 @@ INLINE_HINT static void bc_block_cov3(const Bc0Block* b, BcBlockCovariance* out)
   }
 
   for (u32 i = 0; i != 6; ++i) {
-    static const f32 g_u8MaxInv = 1.0f / u8_max;
-    out->mat[i]                 = cov[i] * g_u8MaxInv;
+    out->mat[i] = cov[i] * g_u8MaxInv;
   }
+#endif
 }
 
 INLINE_HINT static BcVec bc_block_cov3_mul(const BcBlockCovariance* c, const BcVec a) {
@@ -165,6 +266,24 @@ INLINE_HINT static void bc_block_color_fit(const Bc0Block* b, BcColor565* out0,
    * NOTE: In the future we could consider doing some kind of iterative refinement to find
    * end-points that cause the least error with all the block colors.
    */
+#ifdef VOLO_SIMD
+  SimdVec r[4], g[4], bl[4];
+  bc_simd_block_channel(b, 0, r);
+  bc_simd_block_channel(b, 1, g);
+  bc_simd_block_channel(b, 2, bl);
+
+  const SimdVec axisX = simd_vec_broadcast(principleAxis.x);
+  const SimdVec axisY = simd_vec_broadcast(principleAxis.y);
+  const SimdVec axisZ = simd_vec_broadcast(principleAxis.z);
+
+  SimdVec dots[4];
+  for (u32 i = 0; i != 4; ++i) {
+    const SimdVec dotRG = simd_vec_add(simd_vec_mul(r[i], axisX), simd_vec_mul(g[i], axisY));
+    dots[i]             = simd_vec_add(dotRG, simd_vec_mul(bl[i], axisZ));
+  }
+  const BcColor8888 minColor = b->colors[bc_simd_find(dots, bc_simd_min(dots))];
+  const BcColor8888 maxColor = b->colors[bc_simd_find(dots, bc_simd_max(dots))];
+#else
   BcColor8888 minColor = b->colors[0], maxColor = b->colors[0];
   f32         minDot = bc_color_dot3(b->colors[0], principleAxis);
   f32         maxDot = minDot;
@@ -179,25 +298,28 @@ INLINE_HINT static void bc_block_color_fit(const Bc0Block* b, BcColor565* out0,
       maxColor = b->colors[i];
     }
   }
+#endif
 
   *out0 = bc_color_to_565(maxColor);
   *out1 = bc_color_to_565(minColor);
 }
 
-INLINE_HINT static const u8* bc_block_values_r(const Bc0Block* b) {
-  return bits_ptr_offset(b->colors, offsetof(BcColor8888, r));
-}
-
-INLINE_HINT static u8* bc_block_values_mut_r(Bc0Block* b) {
-  return bits_ptr_offset(b->colors, offsetof(BcColor8888, r));
-}
+/**
+ * Channel indices in a BcColor8888.
+ */
+enum {
+  BcChannel_R = 0,
+  BcChannel_G = 1,
+  BcChannel_B = 2,
+  BcChannel_A = 3,
+};
 
-INLINE_HINT static const u8* bc_block_values_a(const Bc0Block* b) {
-  return bits_ptr_offset(b->colors, offsetof(BcColor8888, a));
+INLINE_HINT static const u8* bc_block_values(const Bc0Block* b, const u32 channel) {
+  return bits_ptr_offset(b->colors, channel);
 }
 
-INLINE_HINT static u8* bc_block_values_mut_a(Bc0Block* b) {
-  return bits_ptr_offset(b->colors, offsetof(BcColor8888, a));
+INLINE_HINT static u8* bc_block_values_mut(Bc0Block* b, const u32 channel) {
+  return bits_ptr_offset(b->colors, channel);
 }
 
 /**
@@ -253,14 +375,45 @@ INLINE_HINT static void bc_line_value_interpolate(u8 line[PARAM_ARRAY_SIZE(8)])
  * For each color pick of one the reference colors and encode the 2-bit index.
  */
 INLINE_HINT static void bc_colors_encode(
-    const BcColor8888 colors[PARAM_ARRAY_SIZE(16)],
-    const BcColor8888 ref[PARAM_ARRAY_SIZE(4)],
-    u32*              outIndices) {
+    const Bc0Block* b, const BcColor8888 ref[PARAM_ARRAY_SIZE(4)], u32* outIndices) {
   *outIndices = 0;
+#ifdef VOLO_SIMD
+  SimdVec r[4], g[4], bl[4];
+  bc_simd_block_channel(b, 0, r);
+  bc_simd_block_channel(b, 1, g);
+  bc_simd_block_channel(b, 2, bl);
+
+  SimdVec refR[4], refG[4], refB[4];
+  for (u32 i = 0; i != 4; ++i) {
+    refR[i] = simd_vec_broadcast(ref[i].r);
+    refG[i] = simd_vec_broadcast(ref[i].g);
+    refB[i] = simd_vec_broadcast(ref[i].b);
+  }
+  const SimdVec laneWeights = simd_vec_set(1, 4, 16, 64); // 2 bit indices.
+  for (u32 i = 0; i != 4; ++i) {
+    SimdVec bestDistSqr, bestIndex = simd_vec_zero();
+    for (u32 refIndex = 0; refIndex != 4; ++refIndex) {
+      const SimdVec dR      = simd_vec_sub(r[i], refR[refIndex]);
+      const SimdVec dG      = simd_vec_sub(g[i], refG[refIndex]);
+      const SimdVec dB      = simd_vec_sub(bl[i], refB[refIndex]);
+      const SimdVec dRG     = simd_vec_add(simd_vec_mul(dR, dR), simd_vec_mul(dG, dG));
+      const SimdVec distSqr = simd_vec_add(dRG, simd_vec_mul(dB, dB));
+      if (!refIndex) {
+        bestDistSqr = distSqr;
+        continue;
+      }
+      const SimdVec closer = simd_vec_less(distSqr, bestDistSqr);
+      bestDistSqr          = simd_vec_min(bestDistSqr, distSqr);
+      bestIndex = simd_vec_select(bestIndex, simd_vec_broadcast((f32)refIndex), closer);
+    }
+    *outIndices |= bc_simd_pack(bestIndex, laneWeights) << (i * 8);
+  }
+#else
   for (u32 i = 0; i != 16; ++i) {
-    const u8 index = bc_color_pick3(ref, colors[i]);
+    const u8 index = bc_color_pick3(ref, b->colors[i]);
     *outIndices |= index << (i * 2);
   }
+#endif
 }
 
 INLINE_HINT static void bc_colors_decode(
@@ -277,15 +430,23 @@ INLINE_HINT static void bc_colors_decode(
  * Compute the endpoints of a line through 1D space that can be used to approximate the values in
  * the given block.
  */
-INLINE_HINT static void bc_value_fit(const u8* values, const u32 valueStride, u8* out0, u8* out1) {
-  u8 min = *values, max = *values;
+INLINE_HINT static void bc_value_fit(const Bc0Block* b, const u32 channel, u8* out0, u8* out1) {
+#ifdef VOLO_SIMD
+  SimdVec values[4];
+  bc_simd_block_channel(b, channel, values);
+  *out0 = (u8)simd_vec_x(bc_simd_max(values));
+  *out1 = (u8)simd_vec_x(bc_simd_min(values));
+#else
+  const u8* values = bc_block_values(b, channel);
+  u8        min = *values, max = *values;
   for (u32 i = 0; i != 15; ++i) {
-    values += valueStride;
+    values += sizeof(BcColor8888);
     min = math_min(min, *values);
     max = math_max(max, *values);
   }
   *out0 = max;
   *out1 = min;
+#endif
 }
 
 /**
@@ -304,11 +465,11 @@ INLINE_HINT static u8 bc_value_index_map(const u8 linearIndex) {
  * NOTE: We only support the 8 value mode and not the 6 value + 0/255 mode at the moment.
  */
 INLINE_HINT static void bc_value_encode(
-    const u8* values,
-    const u32 valueStride,
-    const u8  min,
-    const u8  max,
-    u8        outIndices[PARAM_ARRAY_SIZE(6)]) {
+    const Bc0Block* b,
+    const u32       channel,
+    const u8        min,
+    const u8        max,
+    u8              outIndices[PARAM_ARRAY_SIZE(6)]) {
   /**
    * Pick the exact closest of the 8 values based on the min/max, for details see:
    * https://fgiesen.wordpress.com/2009/12/15/dxt5-alpha-block-index-determination/
@@ -317,9 +478,45 @@ INLINE_HINT static void bc_value_encode(
   const u32 range = max - min;
   const u32 bias  = (range < 8) ? (range - 1) : (range / 2 + 2);
 
+#ifdef VOLO_SIMD
+  /**
+   * NOTE: The index computation is exact in floating point; all intermediate values are small
+   * integers and the truncated division cannot be rounded up to the next integer.
+   */
+  SimdVec values[4];
+  bc_simd_block_channel(b, channel, values);
+
+  const SimdVec vMin        = simd_vec_broadcast(min);
+  const SimdVec vSeven      = simd_vec_broadcast(7.0f);
+  const SimdVec vBias       = simd_vec_broadcast((f32)bias);
+  const SimdVec vRange      = simd_vec_broadcast((f32)range);
+  const SimdVec vZero       = simd_vec_zero();
+  const SimdVec vOne        = simd_vec_broadcast(1.0f);
+  const SimdVec vTwo        = simd_vec_broadcast(2.0f);
+  const SimdVec vEight      = simd_vec_broadcast(8.0f);
+  const SimdVec laneWeights = simd_vec_set(1, 8, 64, 512); // 3 bit indices.
+
+  u64 indexStream = 0;
+  for (u32 i = 0; i != 4; ++i) {
+    const SimdVec scaled = simd_vec_mul(simd_vec_sub(values[i], vMin), vSeven);
+    const SimdVec index  = simd_vec_round_down(simd_vec_div(simd_vec_add(scaled, vBias), vRange));
+
+    // Map the linear index to a Bc value index, see 'bc_value_index_map()'.
+    const SimdVec isZero = simd_vec_eq(index, vZero);
+    SimdVec       mapped = simd_vec_select(simd_vec_sub(vEight, index), vZero, isZero);
+    mapped = simd_vec_select(mapped, simd_vec_sub(vOne, mapped), simd_vec_less(mapped, vTwo));
+
+    indexStream |= (u64)bc_simd_pack(mapped, laneWeights) << (i * 12);
+  }
+  for (u32 i = 0; i != 6; ++i, indexStream >>= 8) {
+    outIndices[i] = (u8)indexStream;
+  }
+#else
+  const u8* values = bc_block_values(b, channel);
+
   u32 indexBuffer = 0, bitCount = 0;
   u8* outPtr = outIndices;
-  for (u32 i = 0; i != 16; ++i, values += valueStride) {
+  for (u32 i = 0; i != 16; ++i, values += sizeof(BcColor8888)) {
     const u8 index = ((*values - min) * 7 + bias) / range;
 
     // Accumulate 3bit indices until we've filled up a byte and then output it.
@@ -330,6 +527,7 @@ INLINE_HINT static void bc_value_encode(
       bitCount -= 8;
     }
   }
+#endif
 }
 
 INLINE_HINT static void bc_value_decode(
@@ -403,7 +601,7 @@ void bc1_encode(const Bc0Block* restrict in, Bc1Block* restrict out) {
   refColors[1] = bc_color_from_565(out->color1);
   bc_line_color3_interpolate(refColors);
 
-  bc_colors_encode(in->colors, refColors, &out->colorIndices);
+  bc_colors_encode(in, refColors, &out->colorIndices);
 }
 
 void bc1_decode(const Bc1Block* restrict in, Bc0Block* restrict out) {
@@ -421,12 +619,12 @@ void bc1_decode(const Bc1Block* restrict in, Bc0Block* restrict out) {
 }
 
 void bc3_encode(const Bc0Block* restrict in, Bc3Block* restrict out) {
-  bc_value_fit(bc_block_values_a(in), 4, &out->alpha0, &out->alpha1);
+  bc_value_fit(in, BcChannel_A, &out->alpha0, &out->alpha1);
 
   if (out->alpha0 == out->alpha1) {
     mem_set(array_mem(out->alphaIndices), 0);
   } else {
-    bc_value_encode(bc_block_values_a(in), 4, out->alpha1, out->alpha0, out->alphaIndices);
+    bc_value_encode(in, BcChannel_A, out->alpha1, out->alpha0, out->alphaIndices);
   }
 
   bc_block_color_fit(in, &out->color0, &out->color1);
@@ -436,7 +634,7 @@ void bc3_encode(const Bc0Block* restrict in, Bc3Block* restrict out) {
   refColors[1] = bc_color_from_565(out->color1);
   bc_line_color3_interpolate(refColors);
 
-  bc_colors_encode(in->colors, refColors, &out->colorIndices);
+  bc_colors_encode(in, refColors, &out->colorIndices);
 }
 
 void bc3_decode(const Bc3Block* restrict in, Bc0Block* restrict out) {
@@ -455,20 +653,20 @@ void bc3_decode(const Bc3Block* restrict in, Bc0Block* restrict out) {
   refAlpha[0] = in->alpha0;
   refAlpha[1] = in->alpha1;
   bc_line_value_interpolate(refAlpha);
-  bc_value_decode(refAlpha, in->alphaIndices, bc_block_values_mut_a(out), 4);
+  bc_value_decode(refAlpha, in->alphaIndices, bc_block_values_mut(out, BcChannel_A), 4);
 }
 
-void bc4_encode(const Bc0Block* restrict in, Bc4Block* restrict out) {
-  bc_value_fit(bc_block_values_r(in), 4, &out->value0, &out->value1);
+static void bc_value_block_encode(const Bc0Block* in, const u32 channel, Bc4Block* out) {
+  bc_value_fit(in, channel, &out->value0, &out->value1);
 
   if (out->value0 == out->value1) {
     mem_set(array_mem(out->valueIndices), 0);
   } else {
-    bc_value_encode(bc_block_values_r(in), 4, out->value1, out->value0, out->valueIndices);
+    bc_value_encode(in, channel, out->value1, out->value0, out->valueIndices);
   }
 }
 
-void bc4_decode(const Bc4Block* restrict in, Bc0Block* restrict out) {
+static void bc_value_block_decode(const Bc4Block* in, const u32 channel, Bc0Block* out) {
   /**
    * NOTE: This only supports the bc4 mode with 6 interpolated implicit values, and thus assumes
    * value0 is always greater then value1. When value0 is equal to value1 then we assume that only
@@ -478,5 +676,371 @@ void bc4_decode(const Bc4Block* restrict in, Bc0Block* restrict out) {
   refValues[0] = in->value0;
   refValues[1] = in->value1;
   bc_line_value_interpolate(refValues);
-  bc_value_decode(refValues, in->valueIndices, bc_block_values_mut_r(out), 4);
+  bc_value_decode(refValues, in->valueIndices, bc_block_values_mut(out, channel), 4);
+}
+
+void bc4_encode(const Bc0Block* restrict in, Bc4Block* restrict out) {
+  bc_value_block_encode(in, BcChannel_R, out);
+}
+
+void bc4_decode(const Bc4Block* restrict in, Bc0Block* restrict out) {
+  bc_value_block_decode(in, BcChannel_R, out);
+}
+
+void bc5_encode(const Bc0Block* restrict in, Bc5Block* restrict out) {
+  bc_value_block_encode(in, BcChannel_R, &out->red);
+  bc_value_block_encode(in, BcChannel_G, &out->green);
+}
+
+void bc5_decode(const Bc5Block* restrict in, Bc0Block* restrict out) {
+  bc_value_block_decode(&in->red, BcChannel_R, out);
+  bc_value_block_decode(&in->green, BcChannel_G, out);
+}
+
+/**
+ * BC7 mode 6 encoding.
+ * Single subset with 7777.1 (rgba + unique p-bit) endpoints and 4 bit indices. Supports a wide
+ * range of content (including alpha) at a high quality, at the cost of a more expensive fit.
+ *
+ * Block layout (128 bits):
+ * - mode:    7 bits (0b1000000)
+ * - r0, r1:  7 bits each
+ * - g0, g1:  7 bits each
+ * - b0, b1:  7 bits each
+ * - a0, a1:  7 bits each
+ * - p0, p1:  1 bit each
+ * - indices: 3 bits for the first (anchor) index (implicit high bit of 0), 4 bits for the others.
+ */
+
+#define bc7_mode6_mode 0x40
+#define bc7_mode6_mode_bits 7
+#define bc7_mode6_endpoint_bits 7
+#define bc7_refine_itrs 1
+
+static const u8 g_bc7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+typedef struct {
+  f32 v[4];
+} BcVec4;
+
+typedef struct {
+  u8 v[4]; // Quantized (8 bit) rgba values; lowest bit is the p-bit.
+} Bc7Endpoint;
+
+typedef struct {
+  Bc7Endpoint e0, e1;
+  u8          indices[16];
+  u32         error;
+} Bc7Fit;
+
+INLINE_HINT static void bc7_bits_write(Bc7Block* b, u32* offset, const u32 bits, const u64 val) {
+  const u32 word = *offset / 64, shift = *offset % 64;
+  b->data[word] |= val << shift;
+  if (shift + bits > 64) {
+    b->data[word + 1] |= val >> (64 - shift);
+  }
+  *offset += bits;
+}
+
+INLINE_HINT static u64 bc7_bits_read(const Bc7Block* b, u32* offset, const u32 bits) {
+  const u32 word = *offset / 64, shift = *offset % 64;
+  u64       res  = b->data[word] >> shift;
+  if (shift + bits > 64) {
+    res |= b->data[word + 1] << (64 - shift);
+  }
+  *offset += bits;
+  return res & ((u64_lit(1) << bits) - 1);
+}
+
+INLINE_HINT static u8 bc7_interpolate(const u8 e0, const u8 e1, const u8 weight) {
+  return (u8)(((64 - weight) * e0 + weight * e1 + 32) >> 6);
+}
+
+static void bc7_palette(
+    const Bc7Endpoint* e0, const Bc7Endpoint* e1, BcColor8888 out[PARAM_ARRAY_SIZE(16)]) {
+  for (u32 i = 0; i != 16; ++i) {
+    const u8 w = g_bc7Weights4[i];
+    out[i]     = (BcColor8888){
+        bc7_interpolate(e0->v[0], e1->v[0], w),
+        bc7_interpolate(e0->v[1], e1->v[1], w),
+        bc7_interpolate(e0->v[2], e1->v[2], w),
+        bc7_interpolate(e0->v[3], e1->v[3], w),
+    };
+  }
+}
+
+/**
+ * Quantize an endpoint to 7 bits per channel plus a shared p-bit; picks the p-bit with the lowest
+ * error.
+ */
+static Bc7Endpoint bc7_endpoint_quantize(const BcVec4 v) {
+  Bc7Endpoint best;
+  f32         bestError = f32_max;
+  for (u32 p = 0; p != 2; ++p) {
+    Bc7Endpoint res;
+    f32         error = 0;
+    for (u32 c = 0; c != 4; ++c) {
+      const f32 q = math_clamp_f32(math_round_nearest_f32((v.v[c] - p) * 0.5f), 0, 127);
+      res.v[c]    = (u8)((u32)q << 1 | p);
+      error += (res.v[c] - v.v[c]) * (res.v[c] - v.v[c]);
+    }
+    if (error < bestError) {
+      bestError = error;
+      best      = res;
+    }
+  }
+  return best;
+}
+
+/**
+ * Pick the closest palette entry for each color in the block, returns the total squared error.
+ */
+static u32 bc7_indices_pick(
+    const Bc0Block* b, const Bc7Endpoint* e0, const Bc7Endpoint* e1, u8 out[PARAM_ARRAY_SIZE(16)]) {
+  BcColor8888 palette[16];
+  bc7_palette(e0, e1, palette);
+#ifdef VOLO_SIMD
+  SimdVec channels[4][4];
+  for (u32 c = 0; c != 4; ++c) {
+    bc_simd_block_channel(b, c, channels[c]);
+  }
+  u32 error = 0;
+  for (u32 i = 0; i != 4; ++i) {
+    SimdVec bestError = simd_vec_broadcast(f32_max), bestIndex = simd_vec_zero();
+    for (u32 p = 0; p != 16; ++p) {
+      const SimdVec dR = simd_vec_sub(channels[0][i], simd_vec_broadcast(palette[p].r));
+      const SimdVec dG = simd_vec_sub(channels[1][i], simd_vec_broadcast(palette[p].g));
+      const SimdVec dB = simd_vec_sub(channels[2][i], simd_vec_broadcast(palette[p].b));
+      const SimdVec dA = simd_vec_sub(channels[3][i], simd_vec_broadcast(palette[p].a));
+
+      const SimdVec errRG  = simd_vec_add(simd_vec_mul(dR, dR), simd_vec_mul(dG, dG));
+      const SimdVec errBA  = simd_vec_add(simd_vec_mul(dB, dB), simd_vec_mul(dA, dA));
+      const SimdVec err    = simd_vec_add(errRG, errBA);
+      const SimdVec closer = simd_vec_less(err, bestError);
+      bestError            = simd_vec_min(bestError, err);
+      bestIndex            = simd_vec_select(bestIndex, simd_vec_broadcast((f32)p), closer);
+    }
+    ALIGNAS(16) f32 indices[4];
+    simd_vec_store(bestIndex, indices);
+    for (u32 j = 0; j != 4; ++j) {
+      out[i * 4 + j] = (u8)indices[j];
+    }
+    error += (u32)simd_vec_x(simd_vec_add_comp(bestError));
+  }
+  return error;
+#else
+  u32 error = 0;
+  for (u32 i = 0; i != 16; ++i) {
+    const BcColor8888 c = b->colors[i];
+    u32               bestError = u32_max;
+    for (u8 p = 0; p != 16; ++p) {
+      const i32 dR  = c.r - palette[p].r;
+      const i32 dG  = c.g - palette[p].g;
+      const i32 dB  = c.b - palette[p].b;
+      const i32 dA  = c.a - palette[p].a;
+      const u32 err = dR * dR + dG * dG + dB * dB + dA * dA;
+      if (err < bestError) {
+        bestError = err;
+        out[i]    = p;
+      }
+    }
+    error += bestError;
+  }
+  return error;
+#endif
+}
+
+/**
+ * Find initial endpoints by projecting the colors onto the principle axis (rgba) of the block.
+ */
+static void bc7_endpoints_fit(const Bc0Block* b, BcVec4* out0, BcVec4* out1) {
+  BcVec4 mean = {0};
+  for (u32 i = 0; i != 16; ++i) {
+    const u8* color = (const u8*)&b->colors[i];
+    for (u32 c = 0; c != 4; ++c) {
+      mean.v[c] += color[c];
+    }
+  }
+  for (u32 c = 0; c != 4; ++c) {
+    mean.v[c] *= 1.0f / 16;
+  }
+
+  // Symmetric 4x4 covariance matrix.
+  f32 cov[4][4] = {0};
+  for (u32 i = 0; i != 16; ++i) {
+    const u8* color = (const u8*)&b->colors[i];
+    for (u32 r = 0; r != 4; ++r) {
+      for (u32 c = r; c != 4; ++c) {
+        cov[r][c] += (color[r] - mean.v[r]) * (color[c] - mean.v[c]);
+      }
+    }
+  }
+  for (u32 r = 0; r != 4; ++r) {
+    for (u32 c = 0; c != r; ++c) {
+      cov[r][c] = cov[c][r];
+    }
+  }
+
+  /**
+   * Power iteration (normalized each iteration) to find the principle axis.
+   * NOTE: Start from the column with the largest variance to avoid starting (close to) orthogonal.
+   */
+  u32 maxVarIndex = 0;
+  for (u32 c = 1; c != 4; ++c) {
+    if (cov[c][c] > cov[maxVarIndex][maxVarIndex]) {
+      maxVarIndex = c;
+    }
+  }
+  BcVec4 axis;
+  for (u32 c = 0; c != 4; ++c) {
+    axis.v[c] = cov[c][maxVarIndex];
+  }
+  for (u32 itr = 0; itr != 8; ++itr) {
+    BcVec4 next   = {0};
+    f32    maxAbs = 0;
+    for (u32 r = 0; r != 4; ++r) {
+      for (u32 c = 0; c != 4; ++c) {
+        next.v[r] += cov[r][c] * axis.v[c];
+      }
+      maxAbs = math_max(maxAbs, math_abs(next.v[r]));
+    }
+    if (maxAbs < f32_epsilon) {
+      axis = (BcVec4){0}; // No variance; all colors are equal.
+      break;
+    }
+    for (u32 c = 0; c != 4; ++c) {
+      axis.v[c] = next.v[c] / maxAbs;
+    }
+  }
+  f32 axisLenSqr = 0;
+  for (u32 c = 0; c != 4; ++c) {
+    axisLenSqr += axis.v[c] * axis.v[c];
+  }
+  const f32 axisLenInv = axisLenSqr > f32_epsilon ? 1.0f / math_sqrt_f32(axisLenSqr) : 0.0f;
+
+  // Project the colors onto the axis.
+  f32 tMin = 0, tMax = 0;
+  for (u32 i = 0; i != 16; ++i) {
+    const u8* color = (const u8*)&b->colors[i];
+    f32       t     = 0;
+    for (u32 c = 0; c != 4; ++c) {
+      t += (color[c] - mean.v[c]) * axis.v[c] * axisLenInv;
+    }
+    tMin = math_min(tMin, t);
+    tMax = math_max(tMax, t);
+  }
+  for (u32 c = 0; c != 4; ++c) {
+    out0->v[c] = math_clamp_f32(mean.v[c] + axis.v[c] * axisLenInv * tMin, 0, 255);
+    out1->v[c] = math_clamp_f32(mean.v[c] + axis.v[c] * axisLenInv * tMax, 0, 255);
+  }
+}
+
+/**
+ * Compute the least-squares optimal endpoints for the given indices.
+ * Returns false if the system is degenerate (for example all colors use the same index).
+ */
+static bool bc7_endpoints_refine(
+    const Bc0Block* b, const u8 indices[PARAM_ARRAY_SIZE(16)], BcVec4* out0, BcVec4* out1) {
+  f32    a = 0, bb = 0, c = 0;
+  BcVec4 rhs0 = {0}, rhs1 = {0};
+  for (u32 i = 0; i != 16; ++i) {
+    const u8* color = (const u8*)&b->colors[i];
+    const f32 t     = g_bc7Weights4[indices[i]] * (1.0f / 64);
+    const f32 tInv  = 1.0f - t;
+    a += tInv * tInv;
+    bb += tInv * t;
+    c += t * t;
+    for (u32 ch = 0; ch != 4; ++ch) {
+      rhs0.v[ch] += tInv * color[ch];
+      rhs1.v[ch] += t * color[ch];
+    }
+  }
+  const f32 det = a * c - bb * bb;
+  if (math_abs(det) < f32_epsilon) {
+    return false;
+  }
+  const f32 detInv = 1.0f / det;
+  for (u32 ch = 0; ch != 4; ++ch) {
+    out0->v[ch] = math_clamp_f32((c * rhs0.v[ch] - bb * rhs1.v[ch]) * detInv, 0, 255);
+    out1->v[ch] = math_clamp_f32((a * rhs1.v[ch] - bb * rhs0.v[ch]) * detInv, 0, 255);
+  }
+  return true;
+}
+
+void bc7_encode(const Bc0Block* restrict in, Bc7Block* restrict out) {
+  BcVec4 ep0, ep1;
+  bc7_endpoints_fit(in, &ep0, &ep1);
+
+  Bc7Fit fit;
+  fit.e0    = bc7_endpoint_quantize(ep0);
+  fit.e1    = bc7_endpoint_quantize(ep1);
+  fit.error = bc7_indices_pick(in, &fit.e0, &fit.e1, fit.indices);
+
+  for (u32 itr = 0; itr != bc7_refine_itrs && fit.error; ++itr) {
+    if (!bc7_endpoints_refine(in, fit.indices, &ep0, &ep1)) {
+      break;
+    }
+    Bc7Fit refined;
+    refined.e0    = bc7_endpoint_quantize(ep0);
+    refined.e1    = bc7_endpoint_quantize(ep1);
+    refined.error = bc7_indices_pick(in, &refined.e0, &refined.e1, refined.indices);
+    if (refined.error >= fit.error) {
+      break;
+    }
+    fit = refined;
+  }
+
+  /**
+   * The high bit of the first (anchor) index is implicitly zero; swap the endpoints if needed.
+   * NOTE: The weights are symmetric so flipping the indices reproduces the same colors.
+   */
+  if (fit.indices[0] & 0b1000) {
+    const Bc7Endpoint tmp = fit.e0;
+    fit.e0                = fit.e1;
+    fit.e1                = tmp;
+    for (u32 i = 0; i != 16; ++i) {
+      fit.indices[i] = 15 - fit.indices[i];
+    }
+  }
+
+  out->data[0] = out->data[1] = 0;
+  u32 offset                  = 0;
+  bc7_bits_write(out, &offset, bc7_mode6_mode_bits, bc7_mode6_mode);
+  for (u32 c = 0; c != 4; ++c) {
+    bc7_bits_write(out, &offset, bc7_mode6_endpoint_bits, fit.e0.v[c] >> 1);
+    bc7_bits_write(out, &offset, bc7_mode6_endpoint_bits, fit.e1.v[c] >> 1);
+  }
+  bc7_bits_write(out, &offset, 1, fit.e0.v[0] & 1);
+  bc7_bits_write(out, &offset, 1, fit.e1.v[0] & 1);
+  bc7_bits_write(out, &offset, 3, fit.indices[0]);
+  for (u32 i = 1; i != 16; ++i) {
+    bc7_bits_write(out, &offset, 4, fit.indices[i]);
+  }
+  diag_assert(offset == 128);
+}
+
+void bc7_decode(const Bc7Block* restrict in, Bc0Block* restrict out) {
+  u32 offset = 0;
+  if (bc7_bits_read(in, &offset, bc7_mode6_mode_bits) != bc7_mode6_mode) {
+    mem_set(mem_var(*out), 0); // Only mode 6 is supported at the moment.
+    return;
+  }
+  Bc7Endpoint e0, e1;
+  for (u32 c = 0; c != 4; ++c) {
+    e0.v[c] = (u8)(bc7_bits_read(in, &offset, bc7_mode6_endpoint_bits) << 1);
+    e1.v[c] = (u8)(bc7_bits_read(in, &offset, bc7_mode6_endpoint_bits) << 1);
+  }
+  const u8 p0 = (u8)bc7_bits_read(in, &offset, 1);
+  const u8 p1 = (u8)bc7_bits_read(in, &offset, 1);
+  for (u32 c = 0; c != 4; ++c) {
+    e0.v[c] |= p0;
+    e1.v[c] |= p1;
+  }
+  BcColor8888 palette[16];
+  bc7_palette(&e0, &e1, palette);
+
+  out->colors[0] = palette[bc7_bits_read(in, &offset, 3)];
+  for (u32 i = 1; i != 16; ++i) {
+    out->colors[i] = palette[bc7_bits_read(in, &offset, 4)];
+  }
 }
@@ -3,8 +3,23 @@
 #include "core/diag.h"
 #include "core/intrinsic.h"
 
+#if defined(VOLO_SIMD) && !defined(VOLO_MSVC)
+#include <cpuid.h>
+#endif
+
+/**
+ * Carry-less multiplication (PCLMULQDQ) is not part of the baseline instruction set we compile for,
+ * the folding routine is compiled for it explicitly and only used when the cpu supports it.
+ */
+#if defined(VOLO_SIMD) && !defined(VOLO_MSVC)
+#define bits_target_clmul __attribute__((target("pclmul,sse4.1")))
+#else
+#define bits_target_clmul
+#endif
+
 static const u32 g_crcPolynomial = 0xEDB88320; // Reversed version of: 0x04C11DB7.
-static u32       g_crcTable[256];
+static u32       g_crcTable[8][256];           // Slice-by-8 tables.
+static bool      g_crcClmulSupport;
 
 static void bits_init_crc(void) {
   /**
@@ -12,7 +27,7 @@ static void bits_init_crc(void) {
    * Based on the gzip spec:
    * https://www.rfc-editor.org/rfc/rfc1952
    */
-  for (u32 i = 0; i != array_elems(g_crcTable); ++i) {
+  for (u32 i = 0; i != array_elems(g_crcTable[0]); ++i) {
     u32 res = i;
     for (u32 k = 0; k != 8; ++k) {
       if (res & 1) {
@@ -21,11 +36,58 @@ static void bits_init_crc(void) {
         res >>= 1;
       }
     }
-    g_crcTable[i] = res;
+    g_crcTable[0][i] = res;
+  }
+  /**
+   * Compute the slice-by-8 tables; table 'n' advances the crc of a byte over 'n' zero bytes.
+   * More info: https://create.stephan-brumme.com/crc32/#slicing-by-8-overview
+   */
+  for (u32 i = 0; i != array_elems(g_crcTable[0]); ++i) {
+    for (u32 slice = 1; slice != array_elems(g_crcTable); ++slice) {
+      const u32 prev       = g_crcTable[slice - 1][i];
+      g_crcTable[slice][i] = (prev >> 8) ^ g_crcTable[0][prev & 0xff];
+    }
   }
 }
 
-void bits_init(void) { bits_init_crc(); }
+/**
+ * Check if the cpu supports the PCLMULQDQ (carry-less multiplication) instruction.
+ */
+static bool bits_cpu_clmul_support(void) {
+#if defined(VOLO_SIMD)
+  /**
+   * Check the pclmulqdq cpu feature flag.
+   * More info: https://en.wikipedia.org/wiki/CPUID#EAX=1:_Processor_Info_and_Feature_Bits
+   */
+  i32 cpuId[4];
+#if defined(VOLO_MSVC)
+  __cpuid(cpuId, 1);
+#else
+  __cpuid(1, cpuId[0], cpuId[1], cpuId[2], cpuId[3]);
+#endif
+  return (cpuId[2] & (1 << 1)) != 0;
+#else
+  return false;
+#endif
+}
+
+void bits_init(void) {
+  bits_init_crc();
+  g_crcClmulSupport = bits_cpu_clmul_support();
+}
+
+INLINE_HINT static u64 bits_load_le_u64(const u8* data) {
+#ifdef VOLO_SIMD
+  return (u64)_mm_cvtsi128_si64(_mm_loadl_epi64((const __m128i*)data)); // Unaligned 64 bit load.
+#else
+  return (u64)data[0] | (u64)data[1] << 8 | (u64)data[2] << 16 | (u64)data[3] << 24 |
+         (u64)data[4] << 32 | (u64)data[5] << 40 | (u64)data[6] << 48 | (u64)data[7] << 56;
+#endif
+}
+
+INLINE_HINT static u64 bits_rotl_64(const u64 val, const u32 amount) {
+  return (val << amount) | (val >> (64 - amount));
+}
 
 u8 bits_popcnt_32(const u32 mask) { return intrinsic_popcnt_32(mask); }
 
@@ -117,33 +179,37 @@ u64 bits_nextpow2_64(const u64 val) {
   return u64_lit(1) << (u64_lit(64) - bits_clz_64(val - u64_lit(1)));
 }
 
-u32 bits_hash_32(const Mem mem) {
+u64 bits_hash_64(const Mem mem) {
   /**
-   * Fowler–Noll–Vo hash function.
-   * Ref: http://www.isthe.com/chongo/tech/comp/fnv/index.html
-   * Ref: https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
-   *
-   * FNV-1a.
-   * 32-bit
-   * prime: 2^24 + 2^8 + 0x93 = 16777619
-   * offset: 2166136261
+   * Word-at-a-time multiply-rotate hash; consumes 8 bytes per round.
+   * Rounds are based on xxHash64 and the result is finalized using SplitMix64.
+   * Ref: https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
    */
+  static const u64 g_prime1 = u64_lit(0x9E3779B185EBCA87);
+  static const u64 g_prime2 = u64_lit(0xC2B2AE3D27D4EB4F);
 
-  const u32 prime = 16777619u;
-  u32       hash  = 2166136261U;
+  const u8* itr = mem_begin(mem);
+  const u8* end = itr + mem.size;
 
-  mem_for_u8(mem, itr) {
-    hash ^= *itr;
-    hash *= prime;
+  u64 hash = g_prime1 ^ ((u64)mem.size * g_prime2);
+  for (; (usize)(end - itr) >= 8; itr += 8) {
+    hash ^= bits_rotl_64(bits_load_le_u64(itr) * g_prime2, 31) * g_prime1;
+    hash = bits_rotl_64(hash, 27) * g_prime1 + g_prime2;
+  }
+  if (itr != end) {
+    u64 tail = 0;
+    for (u32 shift = 0; itr != end; ++itr, shift += 8) {
+      tail |= (u64)*itr << shift;
+    }
+    hash ^= bits_rotl_64(tail * g_prime2, 31) * g_prime1;
   }
 
-  // Finalize the hash (aka 'mixing').
-  hash += hash << 13U;
-  hash ^= hash >> 7U;
-  hash += hash << 3U;
-  hash ^= hash >> 17U;
-  hash += hash << 5U;
-  return hash;
+  return bits_hash_64_val(hash);
+}
+
+u32 bits_hash_32(const Mem mem) {
+  const u64 hash = bits_hash_64(mem);
+  return (u32)hash ^ (u32)(hash >> 32);
 }
 
 u32 bits_hash_32_val(u32 hash) {
@@ -175,14 +241,102 @@ u32 bits_hash_32_combine(const u32 x, const u32 y) {
   return x ^ (y + 0x9e3779b9 + (x << 6) + (x >> 2));
 }
 
+u64 bits_hash_64_combine(const u64 x, const u64 y) {
+  return x ^ (y + u64_lit(0x9e3779b97f4a7c15) + (x << 6) + (x >> 2));
+}
+
+#ifdef VOLO_SIMD
+/**
+ * Fold the input into the crc using carry-less multiplication.
+ * Implementation of: 'Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction'
+ * by Vinodh Gopal, Erdinc Ozturk, Jim Guilford et al. (Intel white paper).
+ * Constants for the reflected 0x04C11DB7 polynomial are taken from the Linux kernel (crc32-pclmul).
+ *
+ * Pre-condition: size >= 64 && size % 16 == 0.
+ * NOTE: Takes and returns the crc without pre and post conditioning.
+ */
+bits_target_clmul static u32 bits_crc_32_clmul(const u32 crc, const u8* data, usize size) {
+  const __m128i k1k2 = _mm_set_epi64x(0x1C6E41596, 0x154442BD4); // Fold by 4 (512 bit).
+  const __m128i k3k4 = _mm_set_epi64x(0x0CCAA009E, 0x1751997D0); // Fold by 1 (128 bit).
+  const __m128i k5   = _mm_set_epi64x(0, 0x163CD6124);           // Fold 64 to 32 bit.
+  const __m128i poly = _mm_set_epi64x(0x1F7011641, 0x1DB710641); // Barrett reduction (u', P').
+  const __m128i mask = _mm_set_epi32(0, 0, 0, -1);
+
+  __m128i x0 = _mm_loadu_si128((const __m128i*)(data + 0));
+  __m128i x1 = _mm_loadu_si128((const __m128i*)(data + 16));
+  __m128i x2 = _mm_loadu_si128((const __m128i*)(data + 32));
+  __m128i x3 = _mm_loadu_si128((const __m128i*)(data + 48));
+  x0         = _mm_xor_si128(x0, _mm_cvtsi32_si128((i32)crc));
+  data += 64;
+  size -= 64;
+
+#define bits_crc_fold(_X_, _K_, _NEXT_)                                                            \
+  _mm_xor_si128(                                                                                   \
+      _mm_xor_si128(_mm_clmulepi64_si128(_X_, _K_, 0x00), _mm_clmulepi64_si128(_X_, _K_, 0x11)),  \
+      _NEXT_)
+
+  // Fold 64 bytes per iteration into four 128 bit accumulators.
+  for (; size >= 64; data += 64, size -= 64) {
+    x0 = bits_crc_fold(x0, k1k2, _mm_loadu_si128((const __m128i*)(data + 0)));
+    x1 = bits_crc_fold(x1, k1k2, _mm_loadu_si128((const __m128i*)(data + 16)));
+    x2 = bits_crc_fold(x2, k1k2, _mm_loadu_si128((const __m128i*)(data + 32)));
+    x3 = bits_crc_fold(x3, k1k2, _mm_loadu_si128((const __m128i*)(data + 48)));
+  }
+
+  // Fold the accumulators into a single 128 bit value.
+  x0 = bits_crc_fold(x0, k3k4, x1);
+  x0 = bits_crc_fold(x0, k3k4, x2);
+  x0 = bits_crc_fold(x0, k3k4, x3);
+
+  // Fold the remaining 16 byte blocks.
+  for (; size >= 16; data += 16, size -= 16) {
+    x0 = bits_crc_fold(x0, k3k4, _mm_loadu_si128((const __m128i*)data));
+  }
+#undef bits_crc_fold
+
+  // Fold 128 to 64 bits.
+  x0 = _mm_xor_si128(_mm_clmulepi64_si128(k3k4, x0, 0x01), _mm_srli_si128(x0, 8));
+
+  // Fold 64 to 32 bits.
+  x0 = _mm_xor_si128(
+      _mm_clmulepi64_si128(_mm_and_si128(x0, mask), k5, 0x00), _mm_srli_si128(x0, 4));
+
+  // Barrett reduction to the final 32 bit crc.
+  __m128i t = _mm_clmulepi64_si128(_mm_and_si128(x0, mask), poly, 0x10);
+  t         = _mm_clmulepi64_si128(_mm_and_si128(t, mask), poly, 0x00);
+  return (u32)_mm_extract_epi32(_mm_xor_si128(x0, t), 1);
+}
+#endif
+
 u32 bits_crc_32(const u32 crc, const Mem mem) {
   /**
    * Compute a CRC32 (ISO 3309) checksum with pre and pose conditioning.
    * Based on the gzip spec:
    * https://www.rfc-editor.org/rfc/rfc1952
    */
-  u32 res = crc ^ 0xffffffff;
-  mem_for_u8(mem, byte) { res = g_crcTable[(res ^ *byte) & 0xff] ^ (res >> 8); }
+  u32       res = crc ^ 0xffffffff;
+  const u8* itr = mem_begin(mem);
+  const u8* end = itr + mem.size;
+
+#ifdef VOLO_SIMD
+  if (g_crcClmulSupport && mem.size >= 64) {
+    const usize clmulSize = mem.size & ~(usize)15;
+    res                   = bits_crc_32_clmul(res, itr, clmulSize);
+    itr += clmulSize;
+  }
+#endif
+
+  // Slice-by-8: process 8 bytes per iteration using the pre-computed slice tables.
+  for (; (usize)(end - itr) >= 8; itr += 8) {
+    const u64 word = bits_load_le_u64(itr) ^ res;
+    res            = g_crcTable[7][word & 0xff] ^ g_crcTable[6][(word >> 8) & 0xff] ^
+          g_crcTable[5][(word >> 16) & 0xff] ^ g_crcTable[4][(word >> 24) & 0xff] ^
+          g_crcTable[3][(word >> 32) & 0xff] ^ g_crcTable[2][(word >> 40) & 0xff] ^
+          g_crcTable[1][(word >> 48) & 0xff] ^ g_crcTable[0][word >> 56];
+  }
+  for (; itr != end; ++itr) {
+    res = g_crcTable[0][(res ^ *itr) & 0xff] ^ (res >> 8);
+  }
   return res ^ 0xffffffff;
 }
 
@@ -72,6 +72,7 @@ static FileInfo fileinfo_from_stat(const struct stat* stat) {
       .type       = fileType,
       .accessTime = time_pal_native_to_real(stat->st_atim),
       .modTime    = time_pal_native_to_real(stat->st_mtim),
+      .id         = (u64)stat->st_ino,
   };
 }
 
@@ -331,6 +332,41 @@ FileResult file_resize_sync(File* file, const usize size) {
   return FileResult_Success;
 }
 
+FileResult file_sync(File* file) {
+  diag_assert(file);
+
+  while (UNLIKELY(fsync(file->handle) < 0)) {
+    if (errno != EINTR) {
+      return fileresult_from_errno();
+    }
+  }
+  return FileResult_Success;
+}
+
+FileResult file_sync_dir(const String path) {
+  // Copy the path on the stack and null-terminate it.
+  if (path.size >= PATH_MAX) {
+    return FileResult_PathTooLong;
+  }
+  Mem pathBuffer = mem_stack(PATH_MAX);
+  mem_cpy(pathBuffer, path);
+  *mem_at_u8(pathBuffer, path.size) = '\0';
+
+  const int handle = open((const char*)pathBuffer.ptr, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (UNLIKELY(handle < 0)) {
+    return fileresult_from_errno();
+  }
+  FileResult res = FileResult_Success;
+  while (UNLIKELY(fsync(handle) < 0)) {
+    if (errno != EINTR) {
+      res = fileresult_from_errno();
+      break;
+    }
+  }
+  close(handle);
+  return res;
+}
+
 FileInfo file_stat_sync(File* file) {
   diag_assert(file);
 
@@ -360,6 +360,23 @@ FileResult file_resize_sync(File* file, const usize size) {
   return FileResult_Success;
 }
 
+FileResult file_sync(File* file) {
+  diag_assert(file);
+
+  if (UNLIKELY(!FlushFileBuffers(file->handle))) {
+    return fileresult_from_lasterror();
+  }
+  return FileResult_Success;
+}
+
+FileResult file_sync_dir(const String path) {
+  /**
+   * Directories cannot be flushed on Windows; NTFS journals the directory (meta-data) changes.
+   */
+  (void)path;
+  return FileResult_Success;
+}
+
 FileInfo file_stat_sync(File* file) {
   diag_assert(file);
 
@@ -377,6 +394,7 @@ FileInfo file_stat_sync(File* file) {
       .type       = file_type_from_attributes(info.dwFileAttributes),
       .accessTime = time_pal_native_to_real(&info.ftLastAccessTime),
       .modTime    = time_pal_native_to_real(&info.ftLastWriteTime),
+      .id         = (u64)info.nFileIndexHigh << 32 | info.nFileIndexLow,
   };
 }
 
@@ -12,6 +12,8 @@
 #include "core/stringtable.h"
 #include "core/time.h"
 
+#include "format_float.h"
+
 #define fmt_txt_len_max (4 * usize_kibibyte)
 #define fmt_txt_scratch_alloc (16 * usize_kibibyte)
 
@@ -277,113 +279,25 @@ void format_write_i64(DynString* str, const i64 val, const FormatOptsInt* opts)
   format_write_u64(str, valAbs, opts);
 }
 
-typedef struct {
-  i16 exp;
-  f64 remaining;
-} FormatF64Exp;
-
-/**
- * Calculate the exponent (for scientific notation) for the given float.
- */
-static FormatF64Exp format_f64_decompose_exp(const f64 val, const FormatOptsFloat* opts) {
-
-  /**
-   * Uses binary jumps in the exponentiation, this is a reasonable compromise between the highly
-   * inaccurate: 'just loop and keep dividing by 10' and the expensive 'log()' calculation.
-   *
-   * More info: https://blog.benoitblanchon.fr/lightweight-float-to-string/
-   */
-
-  static f64 g_binPow10[]           = {1e1, 1e2, 1e4, 1e8, 1e16, 1e32, 1e64, 1e128, 1e256};
-  static f64 g_negBinPow10[]        = {1e-1, 1e-2, 1e-4, 1e-8, 1e-16, 1e-32, 1e-64, 1e-128, 1e-256};
-  static f64 g_negBinPow10PlusOne[] = {1e0, 1e-1, 1e-3, 1e-7, 1e-15, 1e-31, 1e-63, 1e-127, 1e-255};
-
-  FormatF64Exp res = {.exp = 0, .remaining = val};
-
-  i32 i   = array_elems(g_binPow10) - 1;
-  i32 bit = 1 << i;
-
-  if (val >= opts->expThresholdPos) {
-    // Calculate the positive exponent.
-    for (; i >= 0; --i) {
-      if (res.remaining >= g_binPow10[i]) {
-        res.remaining *= g_negBinPow10[i];
-        res.exp = (i16)(res.exp + bit);
-      }
-      bit >>= 1;
-    }
-  } else if (val > 0 && val <= opts->expThresholdNeg) {
-    // Calculate the negative exponent.
-    for (; i >= 0; --i) {
-      if (res.remaining < g_negBinPow10PlusOne[i]) {
-        res.remaining *= g_binPow10[i];
-        res.exp = (i16)(res.exp - bit);
-      }
-      bit >>= 1;
-    }
-  }
-
-  return res;
-}
-
-typedef struct {
-  u64 intPart;
-  u64 decPart;
-  u8  decDigits;
-  i16 expPart;
-} FormatF64Parts;
-
-static FormatF64Parts format_f64_decompose(const f64 val, const FormatOptsFloat* opts) {
-  diag_assert(val >= 0.0); // Negative values should be handled earlier.
-  diag_assert(opts->minDecDigits <= opts->maxDecDigits);
-
-  const FormatF64Exp exp = format_f64_decompose_exp(val, opts);
-
-  FormatF64Parts res;
-  res.expPart   = exp.exp;
-  res.decDigits = math_min(opts->maxDecDigits, 19);
-  res.intPart   = exp.remaining < (f64)u64_max ? (u64)exp.remaining : u64_max;
-
-  const u64 maxDecPart = math_pow10_u64(res.decDigits);
-  f64       remainder  = (exp.remaining - (f64)res.intPart) * (f64)maxDecPart;
-  res.decPart          = (u64)remainder;
-
-  // Apply rounding.
-  remainder -= res.decPart;
-  if (remainder >= 0.5) {
-    ++res.decPart;
-    if (res.decPart >= maxDecPart) {
-      res.decPart = 0;
-      ++res.intPart;
-      if (res.expPart && res.intPart >= 10) {
-        ++res.expPart;
-        res.intPart = 1;
-      }
-    }
-  }
-
-  // Remove trailing zeroes in the decimal part.
-  while (res.decPart % 10 == 0 && res.decDigits > opts->minDecDigits) {
-    res.decPart /= 10;
-    --res.decDigits;
-  }
-
-  return res;
-}
-
 void format_write_f64(DynString* str, f64 val, const FormatOptsFloat* opts) {
   /**
-   * Simple routine for formatting floating-point numbers with reasonable accuracy.
-   * Implementation based on: https://blog.benoitblanchon.fr/lightweight-float-to-string/
+   * Writes the shortest decimal representation that round-trips to the same value; when it has
+   * more decimal digits then allowed it is rounded (half-up) to the maximum amount of digits.
    */
+  diag_assert(opts->minDecDigits <= opts->maxDecDigits);
 
   if (float_isnan(val)) {
     dynstring_append(str, string_lit("nan"));
     return;
   }
-  if (val < 0.0) {
+  /**
+   * NOTE: Check the sign bit instead of comparing to zero, denormal comparisons are unreliable as
+   * denormals-are-zero mode can be active; negative zero is written without a sign.
+   */
+  const u64 valBits = bits_f64_as_u64(val);
+  if ((valBits >> 63) && (valBits << 1)) {
     dynstring_append_char(str, '-');
-    val = -val;
+    val = bits_u64_as_f64(valBits & ~(u64_lit(1) << 63));
   } else if (opts->plusSign) {
     dynstring_append_char(str, '+');
   }
@@ -392,16 +306,73 @@ void format_write_f64(DynString* str, f64 val, const FormatOptsFloat* opts) {
     return;
   }
 
-  const FormatF64Parts parts = format_f64_decompose(val, opts);
+  u64 shortestDigits;
+  i32 shortestExp;
+  format_f64_shortest(val, &shortestDigits, &shortestExp);
+
+  // Digit values (most significant first), the value is equal to '0.{digits} * 10^point'.
+  u8  digitBuffer[20];
+  u8* digits = digitBuffer + array_elems(digitBuffer);
+  i32 count  = 0;
+  for (u64 rem = shortestDigits; rem; rem /= 10, ++count) {
+    *--digits = (u8)(rem % 10);
+  }
+  i32 point = count + shortestExp;
+  i32 exp   = 0;
+  if (count && (val >= opts->expThresholdPos || val <= opts->expThresholdNeg)) {
+    exp   = point - 1; // Scientific notation.
+    point = 1;
+  }
+
+  // Apply rounding to the maximum amount of decimal digits.
+  if (count - point > opts->maxDecDigits) {
+    const i32  keep    = point + opts->maxDecDigits;
+    const bool roundUp = keep >= 0 && digits[keep] >= 5;
+    count              = math_max(keep, 0);
+    if (roundUp) {
+      for (; count && digits[count - 1] == 9; --count)
+        ;
+      if (count) {
+        ++digits[count - 1];
+      } else {
+        // All digits rounded up to a new leading digit.
+        digits    = digitBuffer;
+        digits[0] = 1;
+        count     = 1;
+        if (exp || point == 1) {
+          ++exp;
+        } else {
+          ++point;
+        }
+      }
+    }
+  }
+  // Remove trailing zeroes.
+  for (; count && digits[count - 1] == 0; --count)
+    ;
+
+  // Integer part.
+  const i32 intDigits = math_max(point, 1);
+  for (i32 i = intDigits; i < opts->minIntDigits; ++i) {
+    dynstring_append_char(str, '0');
+  }
+  for (i32 i = 0; i != intDigits; ++i) {
+    dynstring_append_char(str, i < point && i < count ? '0' + digits[i] : '0');
+  }
 
-  format_write_int(str, parts.intPart, .minDigits = opts->minIntDigits);
-  if (parts.decDigits) {
+  // Decimal part.
+  const i32 decDigits = math_max(math_max(count - point, 0), opts->minDecDigits);
+  if (decDigits) {
     dynstring_append_char(str, '.');
-    format_write_int(str, parts.decPart, .minDigits = parts.decDigits);
+    for (i32 i = 0; i != decDigits; ++i) {
+      const i32 pos = point + i;
+      dynstring_append_char(str, pos >= 0 && pos < count ? '0' + digits[pos] : '0');
+    }
   }
-  if (parts.expPart) {
+
+  if (exp) {
     dynstring_append_char(str, 'e');
-    format_write_int(str, parts.expPart);
+    format_write_i64(str, exp, &format_opts_int());
   }
 }
 
@@ -739,7 +710,9 @@ String format_read_i64(String input, i64* output, u8 base) {
 
 String format_read_f64(String input, f64* output) {
   if (UNLIKELY(string_eq(input, string_lit("nan")))) {
-    *output = bits_u32_as_f32(0xFFA00000); // f64_nan.
+    if (output) {
+      *output = bits_u32_as_f32(0xFFA00000); // f64_nan.
+    }
     return string_consume(input, 3);
   }
 
@@ -747,17 +720,22 @@ String format_read_f64(String input, f64* output) {
   input = format_read_sign(input, &sign);
 
   if (UNLIKELY(string_eq(input, string_lit("inf")))) {
-    if (sign == -1) {
-      *output = bits_u32_as_f32(0xFF800000); // -f64_inf.
-    } else {
-      *output = bits_u32_as_f32(0x7F800000); // f64_inf.
+    if (output) {
+      *output = bits_u32_as_f32(sign == -1 ? 0xFF800000 : 0x7F800000); // (-)f64_inf.
     }
     return string_consume(input, 3);
   }
 
-  f64  mantissa       = 0.0;
-  f64  divider        = 1.0;
-  bool passedDecPoint = false;
+  /**
+   * Read up to 19 significant digits into the mantissa, the value of the number is equal to
+   * 'mantissa * 10^exp' unless more digits were present (in which case its marked as truncated).
+   */
+  const String text           = input;
+  u64          mantissa       = 0;
+  u32          mantissaDigits = 0;
+  i64          exp            = 0;
+  bool         truncated      = false;
+  bool         passedDecPoint = false;
 
   while (!string_is_empty(input)) {
     const u8 ch = *string_begin(input);
@@ -769,28 +747,31 @@ String format_read_f64(String input, f64* output) {
     if (!format_ascii_is_digit(ch)) {
       break;
     }
-
-    mantissa = mantissa * 10.0 + ch - '0';
-    if (passedDecPoint) {
-      divider *= 10.0;
+    if (mantissaDigits < 19) {
+      if (mantissa || ch != '0') {
+        mantissa = mantissa * 10 + (ch - '0');
+        ++mantissaDigits; // NOTE: Leading zeroes are not significant.
+      }
+      exp -= passedDecPoint;
+    } else {
+      truncated |= ch != '0';
+      exp += !passedDecPoint;
     }
     format_mem_consume_inplace(&input, 1);
   }
 
   // Optionally read an exponent.
   if (!string_is_empty(input) && (*string_begin(input) == 'e' || *string_begin(input) == 'E')) {
-    i64 exp = 0;
-    input   = format_read_i64(format_mem_consume(input, 1), &exp, 10);
+    i64 numberExp = 0;
+    input         = format_read_i64(format_mem_consume(input, 1), &numberExp, 10);
     // TODO: Consider how to report too big / too small exponents.
-    if (exp >= 0) {
-      divider /= math_pow10_u64(math_min((u8)exp, 19));
-    } else {
-      divider *= math_pow10_u64(math_min((u8)-exp, 19));
-    }
+    exp += math_clamp_i64(numberExp, -100000, 100000);
   }
 
   if (output) {
-    *output = mantissa / divider * (f64)sign;
+    const String numberText = string_slice(text, 0, text.size - input.size);
+    const f64    res        = format_f64_from_decimal(mantissa, exp, truncated, numberText);
+    *output                 = sign == -1 ? -res : res;
   }
   return input;
 }
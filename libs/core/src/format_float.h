@@ -0,0 +1,17 @@
+#pragma once
+#include "core/string.h"
+
+/**
+ * Compute the shortest decimal representation that round-trips to the given value.
+ * The value is equal to 'digits * 10^exp' where digits has no trailing zeroes (zero has digits 0).
+ * Pre-condition: Value is finite and positive (or zero).
+ */
+void format_f64_shortest(f64 val, u64* outDigits, i32* outExp);
+
+/**
+ * Compute the f64 nearest to 'mantissa * 10^exp' (rounding half to even).
+ * 'text' is the full decimal text (digits, optional decimal point and optional exponent) that the
+ * mantissa and exponent were read from; it is only used when the mantissa was truncated or the
+ * nearest value cannot be determined from the 64 bit mantissa alone.
+ */
+f64 format_f64_from_decimal(u64 mantissa, i64 exp, bool truncated, String text);
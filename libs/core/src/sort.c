@@ -1,6 +1,7 @@
 #include "core/array.h"
 #include "core/bits.h"
 #include "core/diag.h"
+#include "core/math.h"
 #include "core/sort.h"
 
 #ifdef VOLO_SIMD
@@ -265,6 +266,248 @@ void sort_bubblesort(u8* begin, u8* end, const u16 stride, CompareFunc compare)
   }
 }
 
+#define sort_mergesort_run_elems 16
+
+/**
+ * Merge the sorted ranges [a, aEnd) and [b, bEnd) into the output.
+ * NOTE: When equal elements are taken from 'a' first to keep the sort stable.
+ */
+static void sort_merge(
+    u8* restrict       out,
+    const u8* restrict a,
+    const u8*          aEnd,
+    const u8* restrict b,
+    const u8*          bEnd,
+    const u16          stride,
+    CompareFunc        compare) {
+  while (a != aEnd && b != bEnd) {
+    if (compare(b, a) < 0) {
+      mem_cpy(mem_create(out, stride), mem_create(b, stride));
+      b += stride;
+    } else {
+      mem_cpy(mem_create(out, stride), mem_create(a, stride));
+      a += stride;
+    }
+    out += stride;
+  }
+  if (a != aEnd) {
+    mem_cpy(mem_create(out, aEnd - a), mem_create(a, aEnd - a));
+  } else if (b != bEnd) {
+    mem_cpy(mem_create(out, bEnd - b), mem_create(b, bEnd - b));
+  }
+}
+
+void sort_mergesort(u8* begin, u8* end, const u16 stride, CompareFunc compare, const Mem scratch) {
+  /**
+   * Bottom-up MergeSort; small runs are first sorted using (stable) insertion sort and then merged
+   * back and forth between the input and the scratch memory.
+   * - https://en.wikipedia.org/wiki/Merge_sort#Bottom-up_implementation
+   */
+  const usize size = end - begin;
+  diag_assert(scratch.size >= size);
+
+  const SortSwapType swapType = sort_swap_type(begin, stride);
+  const usize        runSize  = stride * sort_mergesort_run_elems;
+  for (u8* run = begin; run < end; run += runSize) {
+    sort_insert(run, run + math_min(runSize, (usize)(end - run)), stride, compare, swapType);
+  }
+
+  u8* src = begin;
+  u8* dst = mem_begin(scratch);
+  for (usize width = runSize; width < size; width *= 2) {
+    for (usize offset = 0; offset < size; offset += width * 2) {
+      const usize mid    = math_min(offset + width, size);
+      const usize offEnd = math_min(offset + width * 2, size);
+      sort_merge(dst + offset, src + offset, src + mid, src + mid, src + offEnd, stride, compare);
+    }
+    u8* tmp = src;
+    src     = dst;
+    dst     = tmp;
+  }
+  if (src != begin) {
+    mem_cpy(mem_create(begin, size), mem_create(src, size));
+  }
+}
+
+#define sort_radix_digits_max 8
+
+/**
+ * Fixed-size copy that does not require the pointers to be aligned.
+ * NOTE: The size is a compile-time constant at every call-site, which lets the compiler lower the
+ * loop to (unaligned) register moves without going through the out-of-line 'mem_cpy'.
+ */
+INLINE_HINT static void
+sort_radix_cpy(void* restrict dst, const void* restrict src, const usize size) {
+  u8*       dstBytes = dst;
+  const u8* srcBytes = src;
+  for (usize i = 0; i != size; ++i) {
+    dstBytes[i] = srcBytes[i];
+  }
+}
+
+INLINE_HINT static u64 sort_radix_key(const u8* elem, const u8 keyBytes, const u64 keyMask) {
+  switch (keyBytes) {
+  case 2: {
+    u16 key;
+    sort_radix_cpy(&key, elem, sizeof(u16));
+    return key ^ keyMask;
+  }
+  case 4: {
+    u32 key;
+    sort_radix_cpy(&key, elem, sizeof(u32));
+    return key ^ keyMask;
+  }
+  case 8: {
+    u64 key;
+    sort_radix_cpy(&key, elem, sizeof(u64));
+    return key ^ keyMask;
+  }
+  }
+  UNREACHABLE
+}
+
+INLINE_HINT static void
+sort_radix_copy(u8* restrict dst, const u8* restrict src, const u16 stride) {
+  switch (stride) {
+  case 4:
+    sort_radix_cpy(dst, src, 4);
+    return;
+  case 8:
+    sort_radix_cpy(dst, src, 8);
+    return;
+  case 16:
+    sort_radix_cpy(dst, src, 16);
+    return;
+  default:
+    mem_cpy(mem_create(dst, stride), mem_create(src, stride));
+    return;
+  }
+}
+
+/**
+ * Move all elements from the source to their position in the destination based on a key byte.
+ * NOTE: The switch on the stride is hoisted out of the loop to specialize the element copies.
+ */
+INLINE_HINT static void sort_radix_scatter(
+    u8* restrict       dst,
+    const u8* restrict src,
+    const usize        count,
+    const u16          stride,
+    const u16          keyOffset,
+    const u8           keyBytes,
+    const u64          keyMask,
+    const u32          shift,
+    u32                offsets[PARAM_ARRAY_SIZE(256)]) {
+  for (usize i = 0; i != count; ++i) {
+    const u8* elem  = src + i * stride;
+    const u8  digit = (u8)(sort_radix_key(elem + keyOffset, keyBytes, keyMask) >> shift);
+    sort_radix_copy(dst + (usize)offsets[digit]++ * stride, elem, stride);
+  }
+}
+
+INLINE_HINT static void sort_radix(
+    u8*                  begin,
+    u8*                  end,
+    const u16            stride,
+    const u16            keyOffset,
+    const u8             keyBytes,
+    const SortRadixFlags flags,
+    const Mem            scratch) {
+  /**
+   * Least-significant-digit RadixSort with 8 bit digits.
+   * - https://en.wikipedia.org/wiki/Radix_sort#Least_significant_digit
+   *
+   * The histograms of all the digits are computed in a single pass over the input; for descending
+   * order the keys are inverted.
+   */
+  const usize size  = end - begin;
+  const usize count = size / stride;
+  diag_assert(scratch.size >= size);
+  diag_assert(count <= u32_max);
+  diag_assert(bits_aligned(keyOffset, keyBytes) && bits_aligned(stride, keyBytes));
+  if (count < 2) {
+    return;
+  }
+
+  const u64 keyMask = (flags & SortRadixFlags_Descending) ? u64_max : 0;
+
+  u32 histograms[sort_radix_digits_max][256];
+  mem_set(mem_create(histograms, sizeof(u32) * 256 * keyBytes), 0);
+  for (const u8* elem = begin; elem != end; elem += stride) {
+    const u64 key = sort_radix_key(elem + keyOffset, keyBytes, keyMask);
+    for (u8 digit = 0; digit != keyBytes; ++digit) {
+      ++histograms[digit][(u8)(key >> (digit * 8))];
+    }
+  }
+
+  const u64 firstKey = sort_radix_key(begin + keyOffset, keyBytes, keyMask);
+
+  u8* src = begin;
+  u8* dst = mem_begin(scratch);
+  for (u8 digit = 0; digit != keyBytes; ++digit) {
+    const u32 shift = digit * 8;
+    if (histograms[digit][(u8)(firstKey >> shift)] == count) {
+      continue; // All keys have the same value for this digit; nothing to sort.
+    }
+    u32 offsets[256];
+    u32 offset = 0;
+    for (u32 i = 0; i != 256; ++i) {
+      offsets[i] = offset;
+      offset += histograms[digit][i];
+    }
+    switch (stride) {
+    case 4:
+      sort_radix_scatter(dst, src, count, 4, keyOffset, keyBytes, keyMask, shift, offsets);
+      break;
+    case 8:
+      sort_radix_scatter(dst, src, count, 8, keyOffset, keyBytes, keyMask, shift, offsets);
+      break;
+    case 16:
+      sort_radix_scatter(dst, src, count, 16, keyOffset, keyBytes, keyMask, shift, offsets);
+      break;
+    default:
+      sort_radix_scatter(dst, src, count, stride, keyOffset, keyBytes, keyMask, shift, offsets);
+      break;
+    }
+    u8* tmp = src;
+    src     = dst;
+    dst     = tmp;
+  }
+  if (src != begin) {
+    mem_cpy(mem_create(begin, size), mem_create(src, size));
+  }
+}
+
+void sort_radix_u16(
+    u8*                  begin,
+    u8*                  end,
+    const u16            stride,
+    const u16            keyOffset,
+    const SortRadixFlags flags,
+    const Mem            scratch) {
+  sort_radix(begin, end, stride, keyOffset, sizeof(u16), flags, scratch);
+}
+
+void sort_radix_u32(
+    u8*                  begin,
+    u8*                  end,
+    const u16            stride,
+    const u16            keyOffset,
+    const SortRadixFlags flags,
+    const Mem            scratch) {
+  sort_radix(begin, end, stride, keyOffset, sizeof(u32), flags, scratch);
+}
+
+void sort_radix_u64(
+    u8*                  begin,
+    u8*                  end,
+    const u16            stride,
+    const u16            keyOffset,
+    const SortRadixFlags flags,
+    const Mem            scratch) {
+  sort_radix(begin, end, stride, keyOffset, sizeof(u64), flags, scratch);
+}
+
 /**
  * Select a pivot to partition on.
  * At the moment we always use the center element as the pivot.
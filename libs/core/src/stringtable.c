@@ -9,24 +9,36 @@
 #define stringtable_slots_initial 1024
 #define stringtable_slots_loadfactor 0.75f
 
+ASSERT(sizeof(uptr) == sizeof(u64), "Slots pointer has to be atomically accessible as a u64");
+
 /**
  * Strings are looked up using a simple open-addressing hash table.
  * https://en.wikipedia.org/wiki/Open_addressing
  *
+ * Lookups are lock-free:
+ * - A slot is published by atomically storing its hash after the string has been written, readers
+ *   atomically load the hash and only read the string if the hash matches.
+ * - Growing copies the slots into a new (bigger) array which is then atomically published, old
+ *   arrays are kept alive until the table is destroyed as readers might still be using them.
+ * Inserting new strings is serialized by a spinlock, interning strings that are already in the
+ * table (the common case) never blocks.
+ *
  * NOTE: Strings cannot be removed from the table.
  */
 
-typedef struct {
-  StringHash hash;
-  String     data;
-} StringTableSlot;
+typedef struct sStringTableSlots {
+  struct sStringTableSlots* retired; // Previous (smaller) slots, freed when destroying the table.
+  u32                       count;
+  StringHash*               hashes;  // StringHash[count], 0 indicates an empty slot.
+  String*                   strings; // String[count].
+} StringTableSlots;
 
 struct sStringTable {
-  Allocator*       alloc; // Allocator for string the meta-data.
-  ThreadSpinLock   slotsLock;
-  u32              slotCount, slotCountUsed;
-  StringTableSlot* slots;
-  Allocator*       dataAlloc; // Allocator for the string character data.
+  Allocator*        alloc; // Allocator for string the meta-data.
+  ThreadSpinLock    insertLock;
+  u32               slotCountUsed;
+  StringTableSlots* slots;     // NOTE: Atomically published.
+  Allocator*        dataAlloc; // Allocator for the string character data.
 };
 
 /**
@@ -36,61 +48,133 @@ StringTable* g_stringtable;
 void         stringtable_init(void) { g_stringtable = stringtable_create(g_allocHeap); }
 void         stringtable_teardown(void) { stringtable_destroy(g_stringtable); }
 
-INLINE_HINT static bool stringtable_should_grow(StringTable* table) {
-  return table->slotCountUsed >= (u32)(table->slotCount * stringtable_slots_loadfactor);
+static usize stringtable_slots_size(const u32 slotCount) {
+  return sizeof(StringTableSlots) + (sizeof(StringHash) + sizeof(String)) * slotCount;
 }
 
-static StringTableSlot* stringtable_slots_alloc(Allocator* alloc, const u32 slotCount) {
-  const usize slotsMemSize = sizeof(StringTableSlot) * slotCount;
-  const Mem   slotsMem     = alloc_alloc(alloc, slotsMemSize, alignof(StringTableSlot));
+static StringTableSlots* stringtable_slots_alloc(Allocator* alloc, const u32 slotCount) {
+  diag_assert(bits_ispow2_32(slotCount));
+
+  const Mem slotsMem = alloc_alloc(alloc, stringtable_slots_size(slotCount), alignof(String));
   mem_set(slotsMem, 0);
-  return slotsMem.ptr;
+
+  StringTableSlots* slots = slotsMem.ptr;
+  slots->count            = slotCount;
+  slots->hashes           = bits_ptr_offset(slots, sizeof(StringTableSlots));
+  slots->strings          = bits_ptr_offset(slots->hashes, sizeof(StringHash) * slotCount);
+  return slots;
+}
+
+static void stringtable_slots_free(Allocator* alloc, StringTableSlots* slots) {
+  alloc_free(alloc, mem_create(slots, stringtable_slots_size(slots->count)));
 }
 
-INLINE_HINT static StringTableSlot*
-stringtable_slot(StringTableSlot* slots, const u32 slotCount, const StringHash hash) {
+static StringTableSlots* stringtable_slots_load(const StringTable* table) {
+  return (StringTableSlots*)(uptr)thread_atomic_load_u64((u64*)&table->slots);
+}
+
+static void stringtable_slots_publish(StringTable* table, StringTableSlots* slots) {
+  thread_atomic_store_u64((u64*)&table->slots, (u64)(uptr)slots);
+}
+
+/**
+ * Find the index of the slot that contains the given hash, or the empty slot where it should go.
+ */
+INLINE_HINT static u32 stringtable_slot(const StringTableSlots* slots, const StringHash hash) {
   diag_assert(hash); // Hash of 0 is invalid.
 
-  u32 bucket = hash & (slotCount - 1);
-  for (usize i = 0; i != slotCount; ++i) {
-    StringTableSlot* slot = &slots[bucket];
-    if (LIKELY(!slot->hash || slot->hash == hash)) {
-      return slot; // Slot is either empty or the desired hash.
+  u32 bucket = hash & (slots->count - 1);
+  for (usize i = 0; i != slots->count; ++i) {
+    const StringHash slotHash = thread_atomic_load_u32(&slots->hashes[bucket]);
+    if (LIKELY(!slotHash || slotHash == hash)) {
+      return bucket; // Slot is either empty or the desired hash.
     }
     // Hash collision, jump to a new place in the table (quadratic probing).
-    bucket = (bucket + i + 1) & (slotCount - 1);
+    bucket = (bucket + i + 1) & (slots->count - 1);
   }
   diag_crash_msg("No available StringTable slots");
 }
 
+/**
+ * Grow the slots by copying them into a bigger array.
+ * NOTE: Has to be called while holding the insert lock.
+ */
 NO_INLINE_HINT static void stringtable_grow(StringTable* table) {
-  // Allocate new slots.
-  const u32        newSlotCount = bits_nextpow2_32(table->slotCount + 1);
-  StringTableSlot* newSlots     = stringtable_slots_alloc(table->alloc, newSlotCount);
+  StringTableSlots* oldSlots = table->slots;
+  StringTableSlots* newSlots = stringtable_slots_alloc(table->alloc, oldSlots->count * 2);
 
   // Insert the old data into the new slots.
-  for (StringTableSlot* slot = table->slots; slot != (table->slots + table->slotCount); ++slot) {
-    if (slot->hash) {
-      StringTableSlot* newSlot = stringtable_slot(newSlots, newSlotCount, slot->hash);
-      newSlot->hash            = slot->hash;
-      newSlot->data            = slot->data;
+  for (u32 i = 0; i != oldSlots->count; ++i) {
+    const StringHash hash = oldSlots->hashes[i];
+    if (hash) {
+      const u32 newIndex          = stringtable_slot(newSlots, hash);
+      newSlots->hashes[newIndex]  = hash;
+      newSlots->strings[newIndex] = oldSlots->strings[i];
     }
   }
 
-  // Free the old slots.
-  alloc_free_array_t(table->alloc, table->slots, table->slotCount);
-  table->slots     = newSlots;
-  table->slotCount = newSlotCount;
+  // Publish the new slots; old slots have to stay alive as concurrent readers can still use them.
+  newSlots->retired = oldSlots;
+  stringtable_slots_publish(table, newSlots);
+}
+
+/**
+ * Find or insert the given string.
+ */
+static String stringtable_intern_hash(StringTable* table, const String str, const StringHash hash) {
+  diag_assert_msg(
+      str.size <= stringtable_string_size_max,
+      "String size '{}' exceeds maximum",
+      fmt_size(str.size));
+
+  // Fast path: string already existed in the table.
+  const StringTableSlots* slots = stringtable_slots_load(table);
+  const u32               index = stringtable_slot(slots, hash);
+  if (LIKELY(thread_atomic_load_u32(&slots->hashes[index]))) {
+    diag_assert_msg(string_eq(str, slots->strings[index]), "StringHash collision in StringTable");
+    return slots->strings[index];
+  }
+
+  String result;
+  thread_spinlock_lock(&table->insertLock);
+  {
+    // NOTE: Lookup again as another thread could have inserted it (or grown the table) meanwhile.
+    StringTableSlots* slotsLocked = table->slots;
+    const u32         indexLocked = stringtable_slot(slotsLocked, hash);
+    if (slotsLocked->hashes[indexLocked]) {
+      diag_assert_msg(
+          string_eq(str, slotsLocked->strings[indexLocked]), "StringHash collision in StringTable");
+      result = slotsLocked->strings[indexLocked];
+    } else {
+      /**
+       * New entry in the table.
+       * Copy the string data into the table's data-allocator, then publish the slot by storing the
+       * hash; readers only access the string after observing the hash.
+       */
+      result = string_empty;
+      if (LIKELY(!string_is_empty(str))) {
+        result = string_dup(table->dataAlloc, str);
+        diag_assert_msg(result.ptr, "StringTable allocator ran out of space");
+      }
+      slotsLocked->strings[indexLocked] = result;
+      thread_atomic_store_u32(&slotsLocked->hashes[indexLocked], hash);
+
+      const u32 used = table->slotCountUsed + 1;
+      thread_atomic_store_u32(&table->slotCountUsed, used);
+      if (UNLIKELY(used >= (u32)(slotsLocked->count * stringtable_slots_loadfactor))) {
+        stringtable_grow(table);
+      }
+    }
+  }
+  thread_spinlock_unlock(&table->insertLock);
+  return result;
 }
 
 StringTable* stringtable_create(Allocator* alloc) {
   StringTable* table = alloc_alloc_t(alloc, StringTable);
 
-  diag_assert(bits_ispow2_32(stringtable_slots_initial));
-
   *table = (StringTable){
       .alloc     = alloc,
-      .slotCount = stringtable_slots_initial,
       .slots     = stringtable_slots_alloc(alloc, stringtable_slots_initial),
       .dataAlloc = alloc_chunked_create(g_allocHeap, alloc_bump_create, stringtable_chunk_size),
   };
@@ -98,135 +182,71 @@ StringTable* stringtable_create(Allocator* alloc) {
 }
 
 void stringtable_destroy(StringTable* table) {
-  alloc_free_array_t(table->alloc, table->slots, table->slotCount);
+  for (StringTableSlots* slots = table->slots; slots;) {
+    StringTableSlots* retired = slots->retired;
+    stringtable_slots_free(table->alloc, slots);
+    slots = retired;
+  }
   alloc_chunked_destroy(table->dataAlloc);
   alloc_free_t(table->alloc, table);
 }
 
 void stringtable_reset(StringTable* table) {
-  mem_set(mem_create(table->slots, sizeof(StringTableSlot) * table->slotCount), 0);
+  StringTableSlots* slots = table->slots;
+  for (StringTableSlots* retired = slots->retired; retired;) {
+    StringTableSlots* next = retired->retired;
+    stringtable_slots_free(table->alloc, retired);
+    retired = next;
+  }
+  slots->retired = null;
+  mem_set(mem_create(slots->hashes, sizeof(StringHash) * slots->count), 0);
+  mem_set(mem_create(slots->strings, sizeof(String) * slots->count), 0);
   table->slotCountUsed = 0;
 
   alloc_reset(table->dataAlloc);
 }
 
 u32 stringtable_count(const StringTable* table) {
-  StringTable* tableMutable = (StringTable*)table;
-  u32          res;
-  thread_spinlock_lock(&tableMutable->slotsLock);
-  res = table->slotCountUsed;
-  thread_spinlock_unlock(&tableMutable->slotsLock);
-  return res;
+  return thread_atomic_load_u32(&((StringTable*)table)->slotCountUsed);
 }
 
 String stringtable_lookup(const StringTable* table, const StringHash hash) {
-  StringTable* tableMutable = (StringTable*)table;
-  String       res;
-  thread_spinlock_lock(&tableMutable->slotsLock);
-  res = stringtable_slot(table->slots, table->slotCount, hash)->data;
-  thread_spinlock_unlock(&tableMutable->slotsLock);
-  return res;
+  const StringTableSlots* slots = stringtable_slots_load(table);
+  const u32               index = stringtable_slot(slots, hash);
+  if (thread_atomic_load_u32(&slots->hashes[index])) {
+    return slots->strings[index];
+  }
+  return string_empty;
 }
 
 StringHash stringtable_add(StringTable* table, const String str) {
-  diag_assert_msg(
-      str.size <= stringtable_string_size_max,
-      "String size '{}' exceeds maximum",
-      fmt_size(str.size));
-
   const StringHash hash = string_hash(str);
-
-  thread_spinlock_lock(&table->slotsLock);
-  {
-    StringTableSlot* slot = stringtable_slot(table->slots, table->slotCount, hash);
-    if (slot->hash) {
-      /**
-       * String already existed in the table.
-       */
-      diag_assert_msg(string_eq(str, slot->data), "StringHash collision in StringTable");
-    } else {
-      /**
-       * New entry in the table.
-       * Copy the string data into the table's data-allocator and initialize the values in the slot.
-       */
-      slot->hash = hash;
-      if (LIKELY(!string_is_empty(str))) {
-        slot->data = string_dup(table->dataAlloc, str);
-        diag_assert_msg(slot->data.ptr, "StringTable allocator ran out of space");
-      }
-      ++table->slotCountUsed;
-      if (UNLIKELY(stringtable_should_grow(table))) {
-        stringtable_grow(table);
-      }
-    }
-  }
-  thread_spinlock_unlock(&table->slotsLock);
+  stringtable_intern_hash(table, str, hash);
   return hash;
 }
 
 String stringtable_intern(StringTable* table, const String str) {
-  diag_assert_msg(
-      str.size <= stringtable_string_size_max,
-      "String size '{}' exceeds maximum",
-      fmt_size(str.size));
-
-  const StringHash hash   = string_hash(str);
-  String           result = string_empty;
-
-  thread_spinlock_lock(&table->slotsLock);
-  {
-    StringTableSlot* slot = stringtable_slot(table->slots, table->slotCount, hash);
-    if (slot->hash) {
-      /**
-       * String already existed in the table.
-       */
-      diag_assert_msg(string_eq(str, slot->data), "StringHash collision in StringTable");
-      result = slot->data;
-    } else {
-      /**
-       * New entry in the table.
-       * Copy the string data into the table's data-allocator and initialize the values in the slot.
-       */
-      slot->hash = hash;
-      if (LIKELY(!string_is_empty(str))) {
-        result = string_dup(table->dataAlloc, str);
-        diag_assert_msg(result.ptr, "StringTable allocator ran out of space");
-        slot->data = result;
-      }
-      ++table->slotCountUsed;
-      if (UNLIKELY(stringtable_should_grow(table))) {
-        stringtable_grow(table);
-      }
-    }
-  }
-  thread_spinlock_unlock(&table->slotsLock);
-  return result;
+  return stringtable_intern_hash(table, str, string_hash(str));
 }
 
 StringTableArray stringtable_clone_strings(const StringTable* table, Allocator* alloc) {
   StringTable* tableMutable = (StringTable*)table;
-  u32          count;
-  thread_spinlock_lock(&tableMutable->slotsLock);
-  count = table->slotCountUsed;
-  thread_spinlock_unlock(&tableMutable->slotsLock);
 
-  if (!count) {
-    return (StringTableArray){0};
-  }
+  // NOTE: Block inserts to get a consistent snapshot of the strings.
+  thread_spinlock_lock(&tableMutable->insertLock);
 
-  const StringTableArray res = {
-      .values = alloc_array_t(alloc, String, count),
-      .count  = count,
-  };
+  StringTableArray res = {0};
+  if (table->slotCountUsed) {
+    res.values = alloc_array_t(alloc, String, table->slotCountUsed);
 
-  thread_spinlock_lock(&tableMutable->slotsLock);
-  u32 i = 0;
-  for (StringTableSlot* slot = table->slots; slot != (table->slots + table->slotCount); ++slot) {
-    if (slot->hash && i != count) {
-      res.values[i++] = slot->data;
+    const StringTableSlots* slots = table->slots;
+    for (u32 i = 0; i != slots->count; ++i) {
+      if (slots->hashes[i]) {
+        res.values[res.count++] = slots->strings[i];
+      }
     }
   }
-  thread_spinlock_unlock(&tableMutable->slotsLock);
 
+  thread_spinlock_unlock(&tableMutable->insertLock);
   return res;
 }
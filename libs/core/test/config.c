@@ -1,6 +1,7 @@
 #include "app/check.h"
 
 void app_check_init(CheckDef* check) {
+  register_spec(check, adpcm);
   register_spec(check, alloc_block);
   register_spec(check, alloc_bump);
   register_spec(check, alloc_chunked);
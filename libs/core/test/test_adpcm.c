@@ -0,0 +1,75 @@
+#include "check/spec.h"
+#include "core/adpcm.h"
+#include "core/alloc.h"
+#include "core/math.h"
+
+#define test_adpcm_frames 1000
+
+static i16 test_adpcm_sample(const u32 frame, const u32 channel) {
+  const f32 t = (f32)frame / 44100.0f;
+  const f32 f = channel ? 220.0f : 440.0f;
+  return (i16)(math_sin_f32(t * f * math_pi_f32 * 2.0f) * 16000.0f);
+}
+
+spec(adpcm) {
+
+  it("computes the amount of blocks needed to store frames") {
+    check_eq_int(adpcm_block_count(0), 0);
+    check_eq_int(adpcm_block_count(1), 1);
+    check_eq_int(adpcm_block_count(adpcm_block_frames), 1);
+    check_eq_int(adpcm_block_count(adpcm_block_frames + 1), 2);
+  }
+
+  it("stores four bits per sample") {
+    check_eq_int(adpcm_block_size(1), 4 + adpcm_block_frames / 2);
+    check_eq_int(adpcm_block_size(2), (4 + adpcm_block_frames / 2) * 2);
+  }
+
+  it("can roundtrip silence") {
+    const i16 samples[adpcm_block_frames] = {0};
+    u8        blockData[adpcm_block_channel_size];
+    f32       decoded[adpcm_block_frames];
+
+    const Mem block = mem_var(blockData);
+    adpcm_encode(samples, adpcm_block_frames, 1, block);
+    adpcm_decode_block(block, 1, decoded);
+
+    for (u32 i = 0; i != adpcm_block_frames; ++i) {
+      check_eq_float(decoded[i], 0.0f, 1e-3f);
+    }
+  }
+
+  it("can roundtrip interleaved stereo samples") {
+    const u32 channels = 2;
+    i16*      samples  = alloc_array_t(g_allocHeap, i16, test_adpcm_frames * channels);
+    for (u32 frame = 0; frame != test_adpcm_frames; ++frame) {
+      for (u32 channel = 0; channel != channels; ++channel) {
+        samples[frame * channels + channel] = test_adpcm_sample(frame, channel);
+      }
+    }
+
+    const u32   blockCount = adpcm_block_count(test_adpcm_frames);
+    const usize blockSize  = adpcm_block_size(channels);
+    const Mem   encoded    = alloc_alloc(g_allocHeap, blockSize * blockCount, 1);
+    adpcm_encode(samples, test_adpcm_frames, channels, encoded);
+
+    f32 decoded[adpcm_block_frames * 2];
+    for (u32 block = 0; block != blockCount; ++block) {
+      adpcm_decode_block(mem_slice(encoded, blockSize * block, blockSize), channels, decoded);
+
+      for (u32 i = 0; i != adpcm_block_frames; ++i) {
+        const u32 frame = block * adpcm_block_frames + i;
+        if (frame >= test_adpcm_frames) {
+          break; // Padding.
+        }
+        for (u32 channel = 0; channel != channels; ++channel) {
+          const f32 expected = samples[frame * channels + channel] / (f32)i16_max;
+          check_eq_float(decoded[i * channels + channel], expected, 0.02f);
+        }
+      }
+    }
+
+    alloc_free(g_allocHeap, encoded);
+    alloc_free_array_t(g_allocHeap, samples, test_adpcm_frames * channels);
+  }
+}
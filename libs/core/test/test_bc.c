@@ -2,6 +2,7 @@
 #include "core/array.h"
 #include "core/bc.h"
 #include "core/math.h"
+#include "core/time.h"
 
 #define test_threshold_color8888 15
 
@@ -38,6 +39,118 @@ static void test_color8888_check(
 
 #define check_eq_color8888(_A_, _B_) test_color8888_check(_testCtx, (_A_), (_B_), source_location())
 
+/**
+ * Synthetic 32x32 test image: a diagonal gradient with a bit of (deterministic) noise.
+ */
+static void test_image_block(const u32 blockX, const u32 blockY, Bc0Block* out) {
+  for (u32 y = 0; y != 4; ++y) {
+    for (u32 x = 0; x != 4; ++x) {
+      const u32 px = blockX * 4 + x, py = blockY * 4 + y;
+      const u32 t  = (px + py) * 4;
+      const u32 n  = (px * 7919 + py * 104729) % 5;
+
+      out->colors[y * 4 + x] = (BcColor8888){
+          .r = (u8)(t + n),
+          .g = (u8)(255 - t / 2 + n),
+          .b = (u8)(t / 4 + 64),
+          .a = (u8)(255 - t + n),
+      };
+    }
+  }
+}
+
+typedef void (*TestBcRoundtrip)(const Bc0Block* in, Bc0Block* out);
+
+/**
+ * Compute the peak signal-to-noise ratio (in decibels) of encoding the test image.
+ */
+static f32 test_image_psnr(const TestBcRoundtrip roundtrip, const u32 channels) {
+  f64 errSqr = 0;
+  for (u32 blockY = 0; blockY != 8; ++blockY) {
+    for (u32 blockX = 0; blockX != 8; ++blockX) {
+      Bc0Block org, decoded = {0};
+      test_image_block(blockX, blockY, &org);
+      roundtrip(&org, &decoded);
+
+      for (u32 i = 0; i != 16; ++i) {
+        for (u32 c = 0; c != channels; ++c) {
+          const u8* orgVal = (const u8*)&org.colors[i];
+          const u8* decVal = (const u8*)&decoded.colors[i];
+          const f64 diff   = (f64)orgVal[c] - (f64)decVal[c];
+          errSqr += diff * diff;
+        }
+      }
+    }
+  }
+  const f64 meanErrSqr = errSqr / (32 * 32 * channels);
+  return 10.0f * math_log10_f32((f32)(255.0 * 255.0 / meanErrSqr));
+}
+
+static void test_roundtrip_bc1(const Bc0Block* in, Bc0Block* out) {
+  Bc1Block block;
+  bc1_encode(in, &block);
+  bc1_decode(&block, out);
+}
+
+static void test_roundtrip_bc3(const Bc0Block* in, Bc0Block* out) {
+  Bc3Block block;
+  bc3_encode(in, &block);
+  bc3_decode(&block, out);
+}
+
+static void test_roundtrip_bc4(const Bc0Block* in, Bc0Block* out) {
+  Bc4Block block;
+  bc4_encode(in, &block);
+  bc4_decode(&block, out);
+}
+
+static void test_roundtrip_bc5(const Bc0Block* in, Bc0Block* out) {
+  Bc5Block block;
+  bc5_encode(in, &block);
+  bc5_decode(&block, out);
+}
+
+static void test_roundtrip_bc7(const Bc0Block* in, Bc0Block* out) {
+  Bc7Block block;
+  bc7_encode(in, &block);
+  bc7_decode(&block, out);
+}
+
+typedef void (*TestBcEncode)(const Bc0Block* in, void* out);
+
+static void test_encode_bc1(const Bc0Block* in, void* out) { bc1_encode(in, out); }
+static void test_encode_bc3(const Bc0Block* in, void* out) { bc3_encode(in, out); }
+static void test_encode_bc4(const Bc0Block* in, void* out) { bc4_encode(in, out); }
+static void test_encode_bc5(const Bc0Block* in, void* out) { bc5_encode(in, out); }
+static void test_encode_bc7(const Bc0Block* in, void* out) { bc7_encode(in, out); }
+
+/**
+ * Measure the encoding throughput (in megapixels per second) by repeatedly encoding the test image.
+ * NOTE: The 'bcu' utility reports the throughput on real textures (see its quantize modes).
+ */
+static f64 test_image_throughput(const TestBcEncode encode) {
+  static const TimeDuration g_minDuration = time_milliseconds(10);
+
+  Bc0Block blocks[64];
+  for (u32 i = 0; i != array_elems(blocks); ++i) {
+    test_image_block(i % 8, i / 8, &blocks[i]);
+  }
+  ALIGNAS(16) u8 output[16];
+
+  u64              pixels    = 0;
+  const TimeSteady startTime = time_steady_clock();
+  TimeDuration     duration;
+  do {
+    for (u32 i = 0; i != array_elems(blocks); ++i) {
+      encode(&blocks[i], output);
+    }
+    pixels += array_elems(blocks) * 16;
+    duration = time_steady_duration(startTime, time_steady_clock());
+  } while (duration < g_minDuration);
+
+  return (f64)pixels / ((f64)duration / (f64)time_second) / 1e6;
+}
+
 spec(bc) {
   static const BcColor8888 g_black = {0, 0, 0, 255};
   static const BcColor8888 g_white = {255, 255, 255, 255};
@@ -86,4 +199,71 @@ spec(bc) {
       check_eq_color8888(decodedBlock.colors[i], orgBlock.colors[i]);
     }
   }
+
+  it("can encode a solid bc7 block") {
+    static const BcColor8888 g_color = {42, 137, 201, 99};
+
+    Bc0Block orgBlock;
+    test_bc0_block_fill(&orgBlock, g_color);
+
+    Bc7Block bc7Block;
+    bc7_encode(&orgBlock, &bc7Block);
+
+    Bc0Block decodedBlock;
+    bc7_decode(&bc7Block, &decodedBlock);
+
+    for (u32 i = 0; i != array_elems(decodedBlock.colors); ++i) {
+      check_eq_color8888(decodedBlock.colors[i], g_color);
+    }
+  }
+
+  it("can encode a black and white checker bc7 block") {
+    Bc0Block orgBlock;
+    test_bc0_block_fill_checker(&orgBlock, g_black, g_white);
+
+    Bc7Block bc7Block;
+    bc7_encode(&orgBlock, &bc7Block);
+
+    Bc0Block decodedBlock;
+    bc7_decode(&bc7Block, &decodedBlock);
+
+    for (u32 i = 0; i != array_elems(decodedBlock.colors); ++i) {
+      check_eq_color8888(decodedBlock.colors[i], orgBlock.colors[i]);
+    }
+  }
+
+  it("decodes unsupported bc7 modes to zero") {
+    const Bc7Block bc7Block = {.data = {0x01 /* Mode 0 */, 0}};
+
+    Bc0Block decodedBlock;
+    bc7_decode(&bc7Block, &decodedBlock);
+
+    for (u32 i = 0; i != array_elems(decodedBlock.colors); ++i) {
+      check_eq_color8888(decodedBlock.colors[i], (BcColor8888){0});
+    }
+  }
+
+  it("encodes a gradient image with acceptable quality") {
+    check(test_image_psnr(test_roundtrip_bc1, 3) > 38.0f);
+    check(test_image_psnr(test_roundtrip_bc3, 4) > 39.0f);
+    check(test_image_psnr(test_roundtrip_bc4, 1) > 47.0f);
+    check(test_image_psnr(test_roundtrip_bc5, 2) > 47.0f);
+    check(test_image_psnr(test_roundtrip_bc7, 4) > 43.0f);
+  }
+
+  it("encodes bc7 with a higher quality then bc1") {
+    check(test_image_psnr(test_roundtrip_bc7, 3) > test_image_psnr(test_roundtrip_bc1, 3) + 3.0f);
+  }
+
+  it("encodes with an acceptable throughput") {
+    /**
+     * NOTE: Conservative lower bounds so the check also passes in debug and sanitizer builds; in
+     * optimized builds the encoders are one to two orders of magnitude faster.
+     */
+    check(test_image_throughput(test_encode_bc1) > 1.0);
+    check(test_image_throughput(test_encode_bc3) > 1.0);
+    check(test_image_throughput(test_encode_bc4) > 1.0);
+    check(test_image_throughput(test_encode_bc5) > 1.0);
+    check(test_image_throughput(test_encode_bc7) > 0.5);
+  }
 }
@@ -1,6 +1,18 @@
 #include "check/spec.h"
+#include "core/array.h"
 #include "core/bits.h"
 
+static u32 test_crc_32_reference(const Mem mem) {
+  u32 res = 0xffffffff;
+  mem_for_u8(mem, byte) {
+    res ^= *byte;
+    for (u32 k = 0; k != 8; ++k) {
+      res = (res >> 1) ^ (0xEDB88320 & (0u - (res & 1)));
+    }
+  }
+  return res ^ 0xffffffff;
+}
+
 spec(bits) {
 
   it("can create a mask with a range of set bits") {
@@ -170,6 +182,29 @@ spec(bits) {
       crc     = bits_crc_32(crc, string_lit("World"));
       check_eq_int(crc, 0x4A17B156);
     }
+    check_eq_int(bits_crc_32(0, string_lit("123456789")), 0xCBF43926);
+  }
+
+  it("can compute a crc32 checksum of larger unaligned inputs") {
+    u8 data[1024 + 16];
+    for (u32 i = 0; i != array_elems(data); ++i) {
+      data[i] = (u8)bits_hash_32_val(i);
+    }
+    static const usize g_sizes[] = {7, 8, 15, 16, 63, 64, 65, 127, 128, 200, 512, 1000, 1024};
+    for (u32 i = 0; i != array_elems(g_sizes); ++i) {
+      for (u32 offset = 0; offset != 4; ++offset) {
+        const Mem mem = mem_create(data + offset, g_sizes[i]);
+        check_eq_int(bits_crc_32(0, mem), test_crc_32_reference(mem));
+      }
+    }
+    {
+      // Incremental checksum over chunks that are not multiples of the vector size.
+      u32 crc = 0;
+      crc     = bits_crc_32(crc, mem_create(data, 100));
+      crc     = bits_crc_32(crc, mem_create(data + 100, 300));
+      crc     = bits_crc_32(crc, mem_create(data + 400, 624));
+      check_eq_int(crc, test_crc_32_reference(mem_create(data, 1024)));
+    }
   }
 
   it("can compute a adler32 checksum") {
@@ -254,9 +289,39 @@ spec(bits) {
     check_eq_int(bits_f64_as_u64(bits_u64_as_f64(42)), 42);
   }
 
+  it("can hash data independent of its alignment") {
+    u8 dataA[64], dataB[64 + 3];
+    for (u32 i = 0; i != array_elems(dataA); ++i) {
+      dataA[i] = dataB[i + 3] = (u8)i;
+    }
+    for (u32 size = 0; size != array_elems(dataA); ++size) {
+      const u32 hashA = bits_hash_32(mem_create(dataA, size));
+      const u32 hashB = bits_hash_32(mem_create(dataB + 3, size));
+      check_eq_int(hashA, hashB);
+    }
+  }
+
+  it("can hash data with a different size but equal (zero) contents") {
+    static const u8 g_zeroes[16] = {0};
+    for (u32 size = 1; size != array_elems(g_zeroes); ++size) {
+      const u32 hash     = bits_hash_32(mem_create(g_zeroes, size));
+      const u32 hashPrev = bits_hash_32(mem_create(g_zeroes, size - 1));
+      check(hash != hashPrev);
+    }
+  }
+
   it("can combine a hash starting from zero") {
     u32       hash = 0;
     const u32 res  = bits_hash_32_combine(hash, string_hash_lit("Hello World"));
     check(res != 0);
+
+    const u64 res64 = bits_hash_64_combine(0, bits_hash_64(string_lit("Hello World")));
+    check(res64 != 0);
+  }
+
+  it("can fold a 64 bit hash into a 32 bit hash") {
+    const String str    = string_lit("Hello World");
+    const u64    hash64 = bits_hash_64(str);
+    check_eq_int(bits_hash_32(str), (u32)hash64 ^ (u32)(hash64 >> 32));
   }
 }
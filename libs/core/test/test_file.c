@@ -93,6 +93,16 @@ spec(file) {
     check(time_real_duration(info.modTime, time_real_clock()) < time_minute);
   }
 
+  it("can retrieve a file identifier") {
+    File* otherFile = null;
+    file_temp(g_allocHeap, &otherFile);
+
+    check(file_stat_sync(tmpFile).id != 0);
+    check(file_stat_sync(tmpFile).id != file_stat_sync(otherFile).id);
+
+    file_destroy(otherFile);
+  }
+
   it("can query the current position") {
     usize position;
     check_eq_int(file_position_sync(tmpFile, &position), FileResult_Success);
@@ -283,6 +293,15 @@ spec(file) {
     check_eq_int(file_delete_dir_sync(path), FileResult_Success);
   }
 
+  it("can sync a directory") {
+    const String path = path_build_scratch(
+        g_pathTempDir, path_name_random_scratch(g_rng, string_lit("volo"), string_empty));
+
+    check_eq_int(file_create_dir_sync(path), FileResult_Success);
+    check_eq_int(file_sync_dir(path), FileResult_Success);
+    check_eq_int(file_delete_dir_sync(path), FileResult_Success);
+  }
+
   it("can move a file") {
     const String pathA = path_build_scratch(
         g_pathTempDir, path_name_random_scratch(g_rng, string_lit("volo"), string_empty));
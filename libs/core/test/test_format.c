@@ -1,6 +1,7 @@
 #include "check/spec.h"
 #include "core/alloc.h"
 #include "core/array.h"
+#include "core/bits.h"
 #include "core/dynstring.h"
 #include "core/float.h"
 #include "core/format.h"
@@ -185,13 +186,13 @@ spec(format) {
         {f64_epsilon, format_opts_float(), string_lit("1e-16")},
         {1.7050897056e15,
          format_opts_float(.maxDecDigits = 25),
-         string_lit("1.705089705600000512e15")},
+         string_lit("1.7050897056e15")},
         {42.12345678987654321,
          format_opts_float(.maxDecDigits = 0, .expThresholdPos = 1e20, .expThresholdNeg = 1e-5),
          string_lit("42")},
         {18446744073709551615.0,
          format_opts_float(.maxDecDigits = 10, .expThresholdPos = 1e20, .expThresholdNeg = 1e-5),
-         string_lit("18446744073709551615")},
+         string_lit("18446744073709552000")},
     };
 
     DynString string = dynstring_create_over(mem_stack(128));
@@ -597,8 +598,8 @@ spec(format) {
         {string_lit("1E+6"), 1e+6, string_empty},
         {string_lit("1e-14"), 1e-14, string_empty},
         {string_lit("1E-18"), 1e-18, string_empty},
-        {string_lit("1E-20"), 1e-19, string_empty},
-        {string_lit("1E+20"), 1e+19, string_empty},
+        {string_lit("1E-20"), 1e-20, string_empty},
+        {string_lit("1E+20"), 1e+20, string_empty},
         {string_lit("-1e+7"), -1e+7, string_empty},
         {string_lit("-1e-0"), -1e-0, string_empty},
         {string_lit("-1e+0"), -1e+0, string_empty},
@@ -641,6 +642,39 @@ spec(format) {
     }
   }
 
+  it("can read f64 floating point numbers with correct rounding") {
+    struct {
+      String val;
+      u64    expectedBits;
+    } const data[] = {
+        {string_lit("0.1"), u64_lit(0x3FB999999999999A)},
+        {string_lit("0.3"), u64_lit(0x3FD3333333333333)},
+        {string_lit("9007199254740993"), u64_lit(0x4340000000000000)},
+        {string_lit("9007199254740995"), u64_lit(0x4340000000000002)},
+        {string_lit("1.7976931348623157e308"), u64_lit(0x7FEFFFFFFFFFFFFF)},
+        {string_lit("1e309"), u64_lit(0x7FF0000000000000)},
+        {string_lit("2.2250738585072014e-308"), u64_lit(0x0010000000000000)},
+        {string_lit("2.2250738585072011e-308"), u64_lit(0x000FFFFFFFFFFFFF)},
+        {string_lit("4.9e-324"), u64_lit(0x0000000000000001)},
+        {string_lit("2.4e-324"), u64_lit(0x0000000000000000)},
+        {string_lit("2.5e-324"), u64_lit(0x0000000000000001)},
+        {string_lit("123456789012345678901234567890"), u64_lit(0x45F8EE90FF6C373E)},
+        {string_lit("0.000000000000000000000000000001"), u64_lit(0x39B4484BFEEBC2A0)},
+    };
+
+    for (usize i = 0; i != array_elems(data); ++i) {
+      f64          out;
+      const String rem = format_read_f64(data[i].val, &out);
+      check_eq_string(rem, string_empty);
+      check_msg(
+          bits_f64_as_u64(out) == data[i].expectedBits,
+          "[{}] {} == {}",
+          fmt_text(data[i].val),
+          fmt_int(bits_f64_as_u64(out), .base = 16),
+          fmt_int(data[i].expectedBits, .base = 16));
+    }
+  }
+
   it("can read time durations") {
     struct {
       String       val;
@@ -773,4 +807,29 @@ spec(format) {
       check_eq_string(dynstring_view(&strA), dynstring_view(&strB));
     }
   }
+
+  it("can roundtrip arbitrary f64 bit patterns") {
+    Allocator* allocStack = alloc_bump_create_stack(1024);
+    Rng*       rng        = rng_create_xorwow(allocStack, 42 /* seed */);
+
+    const FormatOptsFloat opts = format_opts_float(.maxDecDigits = u8_max);
+
+    DynString string = dynstring_create_over(mem_stack(128));
+    for (u32 itr = 0; itr != 10 * 1000; ++itr) {
+      const u64 bits = (u64)rng_sample_u32(rng) << 32 | rng_sample_u32(rng);
+      const f64 val  = bits_u64_as_f64(bits);
+      if (float_isnan(val)) {
+        continue;
+      }
+      dynstring_clear(&string);
+      format_write_f64(&string, val, &opts);
+
+      f64 result;
+      format_read_f64(dynstring_view(&string), &result);
+      check_msg(
+          bits_f64_as_u64(result) == bits,
+          "{} roundtrips",
+          fmt_text(dynstring_view(&string)));
+    }
+  }
 }
@@ -1,7 +1,28 @@
 #include "check/spec.h"
+#include "core/alloc.h"
 #include "core/array.h"
+#include "core/rng.h"
 #include "core/sort.h"
 
+typedef struct {
+  u16 payload;
+  u16 key;
+} TestSortElemU16;
+
+typedef struct {
+  u32 key;
+  u32 payload;
+} TestSortElemU32;
+
+typedef struct {
+  u64 payload[2];
+  u64 key;
+} TestSortElemU64;
+
+static i8 test_sort_elem_u16_compare(const void* a, const void* b) {
+  return compare_u16(field_ptr(a, TestSortElemU16, key), field_ptr(b, TestSortElemU16, key));
+}
+
 static i8 test_sort_i32_index_compare(const void* ctx, const usize a, const usize b) {
   const i32* data = ctx;
   return compare_i32(data + a, data + b);
@@ -129,4 +150,100 @@ spec(sort) {
       check(*itr > *prev);
     }
   }
+
+  it("can sort u16 keys with payloads using radix sort") {
+    enum { Count = 1000 };
+    Rng*             rng     = rng_create_xorwow(g_allocHeap, 42);
+    TestSortElemU16* elems   = alloc_array_t(g_allocHeap, TestSortElemU16, Count);
+    const Mem        scratch = alloc_alloc(
+        g_allocHeap, sizeof(TestSortElemU16) * Count, alignof(TestSortElemU16));
+
+    const SortRadixFlags flags[] = {SortRadixFlags_None, SortRadixFlags_Descending};
+    for (u32 f = 0; f != array_elems(flags); ++f) {
+      for (u16 i = 0; i != Count; ++i) {
+        elems[i] = (TestSortElemU16){.payload = i, .key = (u16)(rng_sample_u32(rng) % 100)};
+      }
+      sort_radix_u16_t(elems, elems + Count, TestSortElemU16, key, flags[f], scratch);
+
+      for (u32 i = 1; i != Count; ++i) {
+        const TestSortElemU16* prev = &elems[i - 1];
+        if (prev->key == elems[i].key) {
+          check(prev->payload < elems[i].payload); // Stable; equal keys keep their order.
+        } else if (flags[f] & SortRadixFlags_Descending) {
+          check(prev->key > elems[i].key);
+        } else {
+          check(prev->key < elems[i].key);
+        }
+      }
+    }
+
+    alloc_free(g_allocHeap, scratch);
+    alloc_free_array_t(g_allocHeap, elems, Count);
+    rng_destroy(rng);
+  }
+
+  it("can sort u32 and u64 keys using radix sort") {
+    enum { Count = 1000 };
+    Rng* rng     = rng_create_xorwow(g_allocHeap, 42);
+    Mem  scratch = alloc_alloc(
+        g_allocHeap, sizeof(TestSortElemU64) * Count, alignof(TestSortElemU64));
+
+    TestSortElemU32 elemsU32[Count];
+    for (u32 i = 0; i != Count; ++i) {
+      elemsU32[i] = (TestSortElemU32){.key = rng_sample_u32(rng), .payload = i};
+    }
+    sort_radix_u32_t(elemsU32, elemsU32 + Count, TestSortElemU32, key, 0, scratch);
+    for (u32 i = 1; i != Count; ++i) {
+      check(elemsU32[i - 1].key <= elemsU32[i].key);
+    }
+
+    TestSortElemU64 elemsU64[Count];
+    for (u32 i = 0; i != Count; ++i) {
+      const u64 key = (u64)rng_sample_u32(rng) << 32 | rng_sample_u32(rng);
+      elemsU64[i]   = (TestSortElemU64){.payload = {key, i}, .key = key};
+    }
+    sort_radix_u64_t(elemsU64, elemsU64 + Count, TestSortElemU64, key, 0, scratch);
+    for (u32 i = 1; i != Count; ++i) {
+      check(elemsU64[i - 1].key <= elemsU64[i].key);
+      check_eq_int(elemsU64[i].payload[0], elemsU64[i].key);
+    }
+
+    alloc_free(g_allocHeap, scratch);
+    rng_destroy(rng);
+  }
+
+  it("can sort i32 integers using merge sort") {
+    for (usize i = 0; i != array_elems(i32Data); ++i) {
+      i32 scratch[MaxElemCount];
+      sort_mergesort_t(
+          i32Data[i].values,
+          i32Data[i].values + i32Data[i].size,
+          i32,
+          compare_i32,
+          mem_var(scratch));
+
+      for (u32 j = 0; j != i32Data[i].size; ++j) {
+        check_eq_int(i32Data[i].values[j], i32Data[i].expected[j]);
+      }
+    }
+  }
+
+  it("preserves the order of equal elements in merge sort") {
+    enum { Count = 1000 };
+    Rng*            rng = rng_create_xorwow(g_allocHeap, 42);
+    TestSortElemU16 elems[Count], scratch[Count];
+    for (u16 i = 0; i != Count; ++i) {
+      elems[i] = (TestSortElemU16){.payload = i, .key = (u16)(rng_sample_u32(rng) % 100)};
+    }
+    sort_mergesort_t(
+        elems, elems + Count, TestSortElemU16, test_sort_elem_u16_compare, mem_var(scratch));
+
+    for (u32 i = 1; i != Count; ++i) {
+      check(elems[i - 1].key <= elems[i].key);
+      if (elems[i - 1].key == elems[i].key) {
+        check(elems[i - 1].payload < elems[i].payload);
+      }
+    }
+    rng_destroy(rng);
+  }
 }
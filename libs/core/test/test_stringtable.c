@@ -1,6 +1,30 @@
 #include "check/spec.h"
 #include "core/alloc.h"
 #include "core/stringtable.h"
+#include "core/thread.h"
+
+#define test_stringtable_threads 4
+#define test_stringtable_strings 2000
+
+typedef struct {
+  StringTable* table;
+  u32          seed;
+  i32          failures;
+} TestStringTableCtx;
+
+static void test_stringtable_intern_concurrent(void* data) {
+  TestStringTableCtx* ctx = data;
+  for (u32 i = 0; i != test_stringtable_strings; ++i) {
+    // NOTE: Every thread interns the same strings but in a different order.
+    const u32    index    = (i * 7 + ctx->seed * 13) % test_stringtable_strings;
+    const String str      = fmt_write_scratch("Concurrent String {}", fmt_int(index));
+    const String interned = stringtable_intern(ctx->table, str);
+    const String lookup   = stringtable_lookup(ctx->table, string_hash(str));
+    if (!string_eq(interned, str) || lookup.ptr != interned.ptr) {
+      thread_atomic_add_i32(&ctx->failures, 1);
+    }
+  }
+}
 
 spec(stringtable) {
   StringTable* table;
@@ -44,5 +68,22 @@ spec(stringtable) {
     check(interned.ptr == stringtable_lookup(table, string_hash(str)).ptr);
   }
 
+  it("can intern and lookup strings from multiple threads") {
+    const String         name = string_lit("volo_test");
+    const ThreadPriority prio = ThreadPriority_Normal;
+
+    TestStringTableCtx ctx[test_stringtable_threads];
+    ThreadHandle       threads[test_stringtable_threads];
+    for (u32 i = 0; i != test_stringtable_threads; ++i) {
+      ctx[i]     = (TestStringTableCtx){.table = table, .seed = i};
+      threads[i] = thread_start(test_stringtable_intern_concurrent, &ctx[i], name, prio);
+    }
+    for (u32 i = 0; i != test_stringtable_threads; ++i) {
+      thread_join(threads[i]);
+      check_eq_int(ctx[i].failures, 0);
+    }
+    check_eq_int(stringtable_count(table), test_stringtable_strings);
+  }
+
   teardown() { stringtable_destroy(table); }
 }
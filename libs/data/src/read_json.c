@@ -1,6 +1,7 @@
 #include "core/alloc.h"
 #include "core/base64.h"
 #include "core/bits.h"
+#include "core/bitset.h"
 #include "core/diag.h"
 #include "core/dynstring.h"
 #include "core/float.h"
@@ -23,13 +24,18 @@
     .error = (_ERR_), .errorMsg = fmt_write_scratch(_MSG_FORMAT_LIT_, __VA_ARGS__)                 \
   }
 
+/**
+ * Values are read directly from a streaming json reader (without building a JsonDoc).
+ * The first event of the value is given in 'event', the remaining events of the value (for example
+ * the fields of an object) are read from the reader.
+ */
 typedef struct {
   const DataReadFlags flags;
   const DataReg*      reg;
   Allocator*          alloc;
   DynArray*           allocations;
-  const JsonDoc*      doc;
-  const JsonVal       val;
+  JsonReader*         reader;
+  const JsonEvent*    event;
   const DataMeta      meta;
   Mem                 data;
 } ReadCtx;
@@ -52,13 +58,38 @@ static const DataDeclField* data_field_by_name(const DataDeclStruct* data, const
   return null;
 }
 
+static void data_malformed(const JsonError err, DataReadResult* res) {
+  *res = result_fail(
+      DataReadError_Malformed, "Json parsing failed: {}", fmt_text(json_error_str(err)));
+}
+
+static JsonType data_event_type(const JsonEvent* event) {
+  switch (event->type) {
+  case JsonEventType_ArrayBegin:
+    return JsonType_Array;
+  case JsonEventType_ObjectBegin:
+    return JsonType_Object;
+  case JsonEventType_String:
+    return JsonType_String;
+  case JsonEventType_Number:
+    return JsonType_Number;
+  case JsonEventType_Bool:
+    return JsonType_Bool;
+  case JsonEventType_Null:
+    return JsonType_Null;
+  default:
+    diag_crash_msg("Json event does not start a value");
+  }
+}
+
 static bool data_check_type(const ReadCtx* ctx, const JsonType jsonType, DataReadResult* res) {
-  if (UNLIKELY(jsonType != json_type(ctx->doc, ctx->val))) {
+  const JsonType actualType = data_event_type(ctx->event);
+  if (UNLIKELY(jsonType != actualType)) {
     *res = result_fail(
         DataReadError_MismatchedType,
         "Expected json {} got {}",
         fmt_text(json_type_str(jsonType)),
-        fmt_text(json_type_str(json_type(ctx->doc, ctx->val))));
+        fmt_text(json_type_str(actualType)));
     return false;
   }
   *res = result_success();
@@ -117,7 +148,7 @@ static void data_read_json_number(const ReadCtx* ctx, DataReadResult* res) {
     return;
   }
   const DataDecl* decl   = data_decl(ctx->reg, ctx->meta.type);
-  const f64       number = json_number(ctx->doc, ctx->val);
+  const f64       number = ctx->event->val_number;
 
   const f64 min = data_number_min(decl->kind);
   if (UNLIKELY(number < min)) {
@@ -173,7 +204,7 @@ static void data_read_json_bool(const ReadCtx* ctx, DataReadResult* res) {
   if (UNLIKELY(!data_check_type(ctx, JsonType_Bool, res))) {
     return;
   }
-  *mem_as_t(ctx->data, bool) = json_bool(ctx->doc, ctx->val);
+  *mem_as_t(ctx->data, bool) = ctx->event->val_bool;
   *res                       = result_success();
 }
 
@@ -181,7 +212,7 @@ static void data_read_json_duration(const ReadCtx* ctx, DataReadResult* res) {
   if (UNLIKELY(!data_check_type(ctx, JsonType_Number, res))) {
     return;
   }
-  const f64          seconds = json_number(ctx->doc, ctx->val);
+  const f64          seconds = ctx->event->val_number;
   const TimeDuration dur     = (TimeDuration)time_seconds(seconds);
 
   if (UNLIKELY(ctx->meta.flags & DataFlags_NotEmpty && !dur)) {
@@ -196,7 +227,7 @@ static void data_read_json_angle(const ReadCtx* ctx, DataReadResult* res) {
   if (UNLIKELY(!data_check_type(ctx, JsonType_Number, res))) {
     return;
   }
-  const f64 degrees = json_number(ctx->doc, ctx->val);
+  const f64 degrees = ctx->event->val_number;
   if (UNLIKELY(ctx->meta.flags & DataFlags_NotEmpty && degrees == 0.0)) {
     *res = result_fail(DataReadError_ZeroIsInvalid, "Angle cannot be zero");
   } else {
@@ -209,7 +240,7 @@ static void data_read_json_string(const ReadCtx* ctx, DataReadResult* res) {
   if (UNLIKELY(!data_check_type(ctx, JsonType_String, res))) {
     return;
   }
-  const String jsonStr = json_string(ctx->doc, ctx->val);
+  const String jsonStr = ctx->event->val_string;
 
   if (UNLIKELY(ctx->meta.flags & DataFlags_NotEmpty && string_is_empty(jsonStr))) {
     *res = result_fail(DataReadError_EmptyStringIsInvalid, "Value cannot be an empty string");
@@ -231,10 +262,10 @@ static void data_read_json_string(const ReadCtx* ctx, DataReadResult* res) {
 }
 
 static void data_read_json_string_hash(const ReadCtx* ctx, DataReadResult* res) {
-  const JsonType valType = json_type(ctx->doc, ctx->val);
+  const JsonType valType = data_event_type(ctx->event);
   switch (valType) {
   case JsonType_String: {
-    const String jsonStr = json_string(ctx->doc, ctx->val);
+    const String jsonStr = ctx->event->val_string;
 
     if (UNLIKELY(ctx->meta.flags & DataFlags_NotEmpty && string_is_empty(jsonStr))) {
       *res = result_fail(DataReadError_EmptyStringIsInvalid, "Value cannot be an empty string");
@@ -245,7 +276,7 @@ static void data_read_json_string_hash(const ReadCtx* ctx, DataReadResult* res)
     *res                             = result_success();
   } break;
   case JsonType_Number: {
-    const u32 jsonNum = (u32)json_number(ctx->doc, ctx->val);
+    const u32 jsonNum = (u32)ctx->event->val_number;
 
     if (UNLIKELY(ctx->meta.flags & DataFlags_NotEmpty && !jsonNum)) {
       *res = result_fail(DataReadError_ZeroIsInvalid, "Value cannot be zero");
@@ -273,7 +304,7 @@ static void data_read_json_mem(const ReadCtx* ctx, DataReadResult* res) {
   if (UNLIKELY(!data_check_type(ctx, JsonType_String, res))) {
     return;
   }
-  const String jsonStr = json_string(ctx->doc, ctx->val);
+  const String jsonStr = ctx->event->val_string;
 
   if (UNLIKELY(ctx->meta.flags & DataFlags_NotEmpty && string_is_empty(jsonStr))) {
     *res = result_fail(DataReadError_EmptyStringIsInvalid, "Value cannot be an empty string");
@@ -301,7 +332,70 @@ static void data_read_json_mem(const ReadCtx* ctx, DataReadResult* res) {
   }
 }
 
-static void data_read_json_struct(const ReadCtx* ctx, DataReadResult* res, u32 fieldsRead) {
+/**
+ * Read the next value event from the reader.
+ */
+static bool data_read_json_next(JsonReader* reader, JsonEvent* out, DataReadResult* res) {
+  json_reader_next(reader, out);
+  if (UNLIKELY(out->type == JsonEventType_Error)) {
+    data_malformed(out->val_error, res);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Skip over the next value (including the contents of arrays and objects).
+ */
+static bool data_read_json_skip(JsonReader* reader, DataReadResult* res) {
+  JsonEvent event;
+  json_reader_skip(reader, &event);
+  if (UNLIKELY(event.type == JsonEventType_Error)) {
+    data_malformed(event.val_error, res);
+    return false;
+  }
+  return true;
+}
+
+static void
+data_read_json_union_name(const ReadCtx* ctx, const JsonEvent* nameEvt, DataReadResult* res) {
+  const DataDecl* decl = data_decl(ctx->reg, ctx->meta.type);
+  if (UNLIKELY(nameEvt->type != JsonEventType_String)) {
+    *res = result_fail(DataReadError_UnionInvalidName, "'$name' field has to be a string");
+    return;
+  }
+  const String jsonName = nameEvt->val_string;
+  switch (data_union_name_type(&decl->val_union)) {
+  case DataUnionNameType_None:
+    *res = result_fail(DataReadError_UnionNameNotSupported, "'$name' field unsupported");
+    return;
+  case DataUnionNameType_String:
+    if (!string_is_empty(jsonName)) {
+      const String name = string_dup(ctx->alloc, jsonName);
+      data_register_alloc(ctx, name);
+      *data_union_name_string(&decl->val_union, ctx->data) = name;
+    }
+    break;
+  case DataUnionNameType_StringHash:
+    if (!string_is_empty(jsonName)) {
+      const StringHash nameHash = stringtable_add(g_stringtable, jsonName);
+      *data_union_name_hash(&decl->val_union, ctx->data) = nameHash;
+    }
+    break;
+  }
+  *res = result_success();
+}
+
+/**
+ * Read the fields of a json object into a struct.
+ * Fields are read in the order they appear in the json; unknown fields are reported after all the
+ * fields have been read (so that missing fields take precedence over unknown fields).
+ *
+ * When 'unionCtx' is provided then the struct is inlined in a union object, in that case the union
+ * '$type' field is ignored and the '$name' field is read into the union.
+ */
+static void
+data_read_json_struct(const ReadCtx* ctx, DataReadResult* res, const ReadCtx* unionCtx) {
   const DataDecl* decl = data_decl(ctx->reg, ctx->meta.type);
   if (UNLIKELY(!data_check_type(ctx, JsonType_Object, res))) {
     return;
@@ -313,80 +407,154 @@ static void data_read_json_struct(const ReadCtx* ctx, DataReadResult* res, u32 f
    */
   mem_set(ctx->data, 0);
 
-  dynarray_for_t(&decl->val_struct.fields, DataDeclField, fieldDecl) {
+  const DataDeclField* fieldsBegin = dynarray_begin_t(&decl->val_struct.fields, DataDeclField);
+  const usize          fieldCount  = decl->val_struct.fields.size;
+
+  const BitSet fieldsRead = mem_stack(bits_to_bytes(fieldCount) + 1);
+  bitset_clear_all(fieldsRead);
+
+  JsonReader unknownField; // Position of the first unknown field.
+  bool       unknownFieldFound = false;
+
+  JsonEvent evt;
+  for (;;) {
+    const JsonReader fieldStart = *ctx->reader;
+    if (UNLIKELY(!data_read_json_next(ctx->reader, &evt, res))) {
+      return;
+    }
+    if (evt.type == JsonEventType_ObjectEnd) {
+      break;
+    }
+    const StringHash nameHash = string_hash(evt.val_string);
+    if (unionCtx && nameHash == string_hash_lit("$type")) {
+      if (UNLIKELY(!data_read_json_skip(ctx->reader, res))) {
+        return;
+      }
+      continue;
+    }
+    if (unionCtx && nameHash == string_hash_lit("$name")) {
+      if (UNLIKELY(!data_read_json_next(ctx->reader, &evt, res))) {
+        return;
+      }
+      data_read_json_union_name(unionCtx, &evt, res);
+      if (UNLIKELY(res->error)) {
+        return;
+      }
+      continue;
+    }
+    const DataDeclField* fieldDecl = data_field_by_name(&decl->val_struct, nameHash);
+    if (!fieldDecl) {
+      if (!unknownFieldFound) {
+        unknownField      = fieldStart;
+        unknownFieldFound = true;
+      }
+      if (UNLIKELY(!data_read_json_skip(ctx->reader, res))) {
+        return;
+      }
+      continue;
+    }
+    const usize fieldIndex = (usize)(fieldDecl - fieldsBegin);
+    if (UNLIKELY(bitset_test(fieldsRead, fieldIndex))) {
+      data_malformed(JsonError_DuplicateField, res);
+      return;
+    }
+    bitset_set(fieldsRead, fieldIndex);
+
+    if (UNLIKELY(!data_read_json_next(ctx->reader, &evt, res))) {
+      return;
+    }
     const ReadCtx fieldCtx = {
         .flags       = ctx->flags,
         .reg         = ctx->reg,
         .alloc       = ctx->alloc,
         .allocations = ctx->allocations,
-        .doc         = ctx->doc,
-        .val         = json_field(ctx->doc, ctx->val, fieldDecl->id.hash),
+        .reader      = ctx->reader,
+        .event       = &evt,
         .meta        = fieldDecl->meta,
         .data        = data_field_mem(ctx->reg, fieldDecl, ctx->data),
     };
-    if (sentinel_check(fieldCtx.val)) {
-      if (fieldDecl->meta.flags & DataFlags_Opt) {
-        // NOTE: For optional fields we need to manually invoke the normalization step.
-        data_normalize(&fieldCtx, res);
-        if (UNLIKELY(res->error)) {
-          return;
-        }
-        continue; // Field is optional, skip reading.
-      }
-      *res = result_fail(
-          DataReadError_FieldNotFound, "Field '{}' not found", fmt_text(fieldDecl->id.name));
-      return;
-    }
-
     data_read_json_val(&fieldCtx, res);
     if (UNLIKELY(res->error)) {
-      *res = result_fail(
-          DataReadError_InvalidField,
-          "Invalid field '{}': {}",
-          fmt_text(fieldDecl->id.name),
-          fmt_text(res->errorMsg));
+      if (res->error != DataReadError_Malformed) {
+        *res = result_fail(
+            DataReadError_InvalidField,
+            "Invalid field '{}': {}",
+            fmt_text(fieldDecl->id.name),
+            fmt_text(res->errorMsg));
+      }
       return;
     }
-    ++fieldsRead;
   }
 
-  if (UNLIKELY(fieldsRead != json_field_count(ctx->doc, ctx->val))) {
-    json_for_fields(ctx->doc, ctx->val, field) {
-      const StringHash nameHash = json_string_hash(ctx->doc, field.name);
-      if (!data_field_by_name(&decl->val_struct, nameHash)) {
-        String name = json_string(ctx->doc, field.name);
-        if (string_is_empty(name)) {
-          // Field uses a hash-only name; attempt to retrieve the name from the global string-table.
-          name = stringtable_lookup(g_stringtable, nameHash);
-        }
-        if (string_is_empty(name)) {
-          *res = result_fail(DataReadError_UnknownField, "Unknown field: '{}'", fmt_int(nameHash));
-        } else {
-          *res = result_fail(DataReadError_UnknownField, "Unknown field: '{}'", fmt_text(name));
-        }
+  for (usize fieldIndex = 0; fieldIndex != fieldCount; ++fieldIndex) {
+    if (bitset_test(fieldsRead, fieldIndex)) {
+      continue;
+    }
+    const DataDeclField* fieldDecl = &fieldsBegin[fieldIndex];
+    if (fieldDecl->meta.flags & DataFlags_Opt) {
+      // NOTE: For optional fields we need to manually invoke the normalization step.
+      const ReadCtx fieldCtx = {
+          .flags       = ctx->flags,
+          .reg         = ctx->reg,
+          .alloc       = ctx->alloc,
+          .allocations = ctx->allocations,
+          .reader      = ctx->reader,
+          .meta        = fieldDecl->meta,
+          .data        = data_field_mem(ctx->reg, fieldDecl, ctx->data),
+      };
+      data_normalize(&fieldCtx, res);
+      if (UNLIKELY(res->error)) {
         return;
       }
+      continue; // Field is optional, skip reading.
     }
-    diag_assert_fail("Invalid state");
+    *res = result_fail(
+        DataReadError_FieldNotFound, "Field '{}' not found", fmt_text(fieldDecl->id.name));
+    return;
+  }
+
+  if (UNLIKELY(unknownFieldFound)) {
+    json_reader_next(&unknownField, &evt); // Re-read the name as strings only live in scratch mem.
+    *res = result_fail(DataReadError_UnknownField, "Unknown field: '{}'", fmt_text(evt.val_string));
+    return;
   }
 
   *res = result_success();
 }
 
+/**
+ * Find the union choice by looking ahead for the '$type' field.
+ * NOTE: Does not advance the reader.
+ */
 static const DataDeclChoice* data_read_json_union_choice(const ReadCtx* ctx, DataReadResult* res) {
-  const DataDecl* decl    = data_decl(ctx->reg, ctx->meta.type);
-  const JsonVal   typeVal = json_field_lit(ctx->doc, ctx->val, "$type");
+  const DataDecl* decl      = data_decl(ctx->reg, ctx->meta.type);
+  JsonReader      lookahead = *ctx->reader;
 
-  if (UNLIKELY(sentinel_check(typeVal))) {
-    *res = result_fail(DataReadError_UnionTypeMissing, "Union is missing a '$type' field");
+  JsonEvent evt;
+  for (;;) {
+    if (UNLIKELY(!data_read_json_next(&lookahead, &evt, res))) {
+      return null;
+    }
+    if (UNLIKELY(evt.type == JsonEventType_ObjectEnd)) {
+      *res = result_fail(DataReadError_UnionTypeMissing, "Union is missing a '$type' field");
+      return null;
+    }
+    if (string_eq(evt.val_string, string_lit("$type"))) {
+      break;
+    }
+    if (UNLIKELY(!data_read_json_skip(&lookahead, res))) {
+      return null;
+    }
+  }
+  if (UNLIKELY(!data_read_json_next(&lookahead, &evt, res))) {
     return null;
   }
-  if (UNLIKELY(json_type(ctx->doc, typeVal) != JsonType_String)) {
+  if (UNLIKELY(evt.type != JsonEventType_String)) {
     *res = result_fail(DataReadError_UnionTypeInvalid, "Union '$type' field is invalid");
     return null;
   }
 
-  const StringHash valueHash = json_string_hash(ctx->doc, typeVal);
+  const StringHash valueHash = string_hash(evt.val_string);
   dynarray_for_t(&decl->val_union.choices, DataDeclChoice, choice) {
     if (choice->id.hash == valueHash) {
       *res = result_success();
@@ -397,7 +565,7 @@ static const DataDeclChoice* data_read_json_union_choice(const ReadCtx* ctx, Dat
   *res = result_fail(
       DataReadError_UnionTypeUnsupported,
       "Invalid union type '{}' for union {}",
-      fmt_text(json_string(ctx->doc, typeVal)),
+      fmt_text(evt.val_string),
       fmt_text(decl->id.name));
   return null;
 }
@@ -416,33 +584,6 @@ static void data_read_json_union(const ReadCtx* ctx, DataReadResult* res) {
 
   *data_union_tag(&decl->val_union, ctx->data) = choice->tag;
 
-  const JsonVal nameVal = json_field_lit(ctx->doc, ctx->val, "$name");
-  if (!sentinel_check(nameVal)) {
-    if (UNLIKELY(json_type(ctx->doc, nameVal) != JsonType_String)) {
-      *res = result_fail(DataReadError_UnionInvalidName, "'$name' field has to be a string");
-      return;
-    }
-    const String jsonName = json_string(ctx->doc, nameVal);
-    switch (data_union_name_type(&decl->val_union)) {
-    case DataUnionNameType_None:
-      *res = result_fail(DataReadError_UnionNameNotSupported, "'$name' field unsupported");
-      return;
-    case DataUnionNameType_String:
-      if (!string_is_empty(jsonName)) {
-        const String name = string_dup(ctx->alloc, jsonName);
-        data_register_alloc(ctx, name);
-        *data_union_name_string(&decl->val_union, ctx->data) = name;
-      }
-      break;
-    case DataUnionNameType_StringHash:
-      if (!string_is_empty(jsonName)) {
-        const StringHash nameHash = stringtable_add(g_stringtable, jsonName);
-        *data_union_name_hash(&decl->val_union, ctx->data) = nameHash;
-      }
-      break;
-    }
-  }
-
   const bool emptyChoice = choice->meta.type == 0;
   if (!emptyChoice) {
     const DataDecl* choiceDecl = data_decl(ctx->reg, choice->meta.type);
@@ -455,20 +596,46 @@ static void data_read_json_union(const ReadCtx* ctx, DataReadResult* res) {
           .reg         = ctx->reg,
           .alloc       = ctx->alloc,
           .allocations = ctx->allocations,
-          .doc         = ctx->doc,
-          .val         = ctx->val,
+          .reader      = ctx->reader,
+          .event       = ctx->event,
           .meta        = choice->meta,
           .data        = data_choice_mem(ctx->reg, choice, ctx->data),
       };
-      const u32 fieldsRead = sentinel_check(nameVal) ? 1 : 2;
-      data_read_json_struct(&choiceCtx, res, fieldsRead);
+      data_read_json_struct(&choiceCtx, res, ctx);
       if (LIKELY(!res->error)) {
         data_normalize(&choiceCtx, res);
       }
-    } else {
-      const JsonVal dataVal = json_field_lit(ctx->doc, ctx->val, "$data");
-      if (UNLIKELY(sentinel_check(dataVal))) {
-        *res = result_fail(DataReadError_UnionDataMissing, "Union is missing a '$data' field");
+      return;
+    }
+  }
+
+  bool      dataFound = false, unknownFieldFound = false;
+  JsonEvent evt;
+  for (;;) {
+    if (UNLIKELY(!data_read_json_next(ctx->reader, &evt, res))) {
+      return;
+    }
+    if (evt.type == JsonEventType_ObjectEnd) {
+      break;
+    }
+    const StringHash nameHash = string_hash(evt.val_string);
+    if (nameHash == string_hash_lit("$name")) {
+      if (UNLIKELY(!data_read_json_next(ctx->reader, &evt, res))) {
+        return;
+      }
+      data_read_json_union_name(ctx, &evt, res);
+      if (UNLIKELY(res->error)) {
+        return;
+      }
+      continue;
+    }
+    if (!emptyChoice && nameHash == string_hash_lit("$data")) {
+      if (UNLIKELY(dataFound)) {
+        data_malformed(JsonError_DuplicateField, res);
+        return;
+      }
+      dataFound = true;
+      if (UNLIKELY(!data_read_json_next(ctx->reader, &evt, res))) {
         return;
       }
       const ReadCtx choiceCtx = {
@@ -476,32 +643,46 @@ static void data_read_json_union(const ReadCtx* ctx, DataReadResult* res) {
           .reg         = ctx->reg,
           .alloc       = ctx->alloc,
           .allocations = ctx->allocations,
-          .doc         = ctx->doc,
-          .val         = dataVal,
+          .reader      = ctx->reader,
+          .event       = &evt,
           .meta        = choice->meta,
           .data        = data_choice_mem(ctx->reg, choice, ctx->data),
       };
       data_read_json_val(&choiceCtx, res);
       if (UNLIKELY(res->error)) {
-        *res = result_fail(
-            DataReadError_UnionDataInvalid,
-            "Invalid union data '{}': {}",
-            fmt_text(choice->id.name),
-            fmt_text(res->errorMsg));
-        return;
-      }
-      const u32 expectedFieldCount = sentinel_check(nameVal) ? 2 : 3;
-      if (UNLIKELY(json_field_count(ctx->doc, ctx->val) != expectedFieldCount)) {
-        *res = result_fail(DataReadError_UnionUnknownField, "Unknown field in union");
+        if (res->error != DataReadError_Malformed) {
+          *res = result_fail(
+              DataReadError_UnionDataInvalid,
+              "Invalid union data '{}': {}",
+              fmt_text(choice->id.name),
+              fmt_text(res->errorMsg));
+        }
         return;
       }
+      continue;
+    }
+    if (nameHash != string_hash_lit("$type")) {
+      unknownFieldFound = true;
+    }
+    if (UNLIKELY(!data_read_json_skip(ctx->reader, res))) {
+      return;
     }
   }
+
+  if (UNLIKELY(!emptyChoice && !dataFound)) {
+    *res = result_fail(DataReadError_UnionDataMissing, "Union is missing a '$data' field");
+    return;
+  }
+  if (UNLIKELY(!emptyChoice && unknownFieldFound)) {
+    *res = result_fail(DataReadError_UnionUnknownField, "Unknown field in union");
+    return;
+  }
+  *res = result_success();
 }
 
 static void data_read_json_enum_single_string(const ReadCtx* ctx, DataReadResult* res) {
   const DataDecl*  decl      = data_decl(ctx->reg, ctx->meta.type);
-  const StringHash valueHash = json_string_hash(ctx->doc, ctx->val);
+  const StringHash valueHash = string_hash(ctx->event->val_string);
 
   const DataDeclConst* constDecl = data_const_from_id(&decl->val_enum, valueHash);
   if (constDecl) {
@@ -513,13 +694,13 @@ static void data_read_json_enum_single_string(const ReadCtx* ctx, DataReadResult
   *res = result_fail(
       DataReadError_InvalidEnumEntry,
       "Invalid enum entry '{}' for type {}",
-      fmt_text(json_string(ctx->doc, ctx->val)),
+      fmt_text(ctx->event->val_string),
       fmt_text(decl->id.name));
 }
 
 static void data_read_json_enum_single_number(const ReadCtx* ctx, DataReadResult* res) {
   const DataDecl* decl  = data_decl(ctx->reg, ctx->meta.type);
-  const i32       value = (i32)json_number(ctx->doc, ctx->val);
+  const i32       value = (i32)ctx->event->val_number;
 
   const DataDeclConst* constDecl = data_const_from_val(&decl->val_enum, value);
   if (constDecl) {
@@ -531,19 +712,25 @@ static void data_read_json_enum_single_number(const ReadCtx* ctx, DataReadResult
   *res = result_fail(
       DataReadError_InvalidEnumEntry,
       "Invalid enum entry '{}' for type {}",
-      fmt_float(json_number(ctx->doc, ctx->val)),
+      fmt_float(ctx->event->val_number),
       fmt_text(decl->id.name));
 }
 
 static void data_read_json_enum_multi_array(const ReadCtx* ctx, DataReadResult* res) {
   const DataDecl* decl = data_decl(ctx->reg, ctx->meta.type);
 
-  i32 val = 0;
-  json_for_elems(ctx->doc, ctx->val, elem) {
-    const JsonType elemType = json_type(ctx->doc, elem);
-    switch (elemType) {
-    case JsonType_String: {
-      const StringHash     elemId    = json_string_hash(ctx->doc, elem);
+  i32       val = 0;
+  JsonEvent elem;
+  for (;;) {
+    if (UNLIKELY(!data_read_json_next(ctx->reader, &elem, res))) {
+      return;
+    }
+    if (elem.type == JsonEventType_ArrayEnd) {
+      break;
+    }
+    switch (elem.type) {
+    case JsonEventType_String: {
+      const StringHash     elemId    = string_hash(elem.val_string);
       const DataDeclConst* constDecl = data_const_from_id(&decl->val_enum, elemId);
       if (LIKELY(constDecl)) {
         if (UNLIKELY(val & constDecl->value)) {
@@ -559,13 +746,13 @@ static void data_read_json_enum_multi_array(const ReadCtx* ctx, DataReadResult*
         *res = result_fail(
             DataReadError_InvalidEnumEntry,
             "Invalid enum entry '{}' for type {}",
-            fmt_text(json_string(ctx->doc, elem)),
+            fmt_text(elem.val_string),
             fmt_text(decl->id.name));
         return;
       }
     } break;
-    case JsonType_Number: {
-      const i32            elemVal   = (i32)json_number(ctx->doc, elem);
+    case JsonEventType_Number: {
+      const i32            elemVal   = (i32)elem.val_number;
       const DataDeclConst* constDecl = data_const_from_val(&decl->val_enum, 1 << elemVal);
       if (LIKELY(constDecl)) {
         if (UNLIKELY(val & constDecl->value)) {
@@ -590,7 +777,7 @@ static void data_read_json_enum_multi_array(const ReadCtx* ctx, DataReadResult*
       *res = result_fail(
           DataReadError_MismatchedType,
           "Expected json string or number got {}",
-          fmt_text(json_type_str(elemType)));
+          fmt_text(json_type_str(data_event_type(&elem))));
       return;
     }
   }
@@ -606,7 +793,7 @@ static void data_read_json_enum_multi_array(const ReadCtx* ctx, DataReadResult*
 
 static void data_read_json_enum(const ReadCtx* ctx, DataReadResult* res) {
   const DataDecl* decl    = data_decl(ctx->reg, ctx->meta.type);
-  const JsonType  valType = json_type(ctx->doc, ctx->val);
+  const JsonType  valType = data_event_type(ctx->event);
 
   if (decl->val_enum.multi) {
     if (LIKELY(valType == JsonType_Array)) {
@@ -640,7 +827,7 @@ static void data_read_json_opaque(const ReadCtx* ctx, DataReadResult* res) {
   if (UNLIKELY(!data_check_type(ctx, JsonType_String, res))) {
     return;
   }
-  const String jsonStr     = json_string(ctx->doc, ctx->val);
+  const String jsonStr     = ctx->event->val_string;
   const usize  decodedSize = base64_decoded_size(jsonStr);
 
   if (UNLIKELY(decodedSize != ctx->data.size)) {
@@ -700,16 +887,15 @@ static void data_read_json_val_single(const ReadCtx* ctx, DataReadResult* res) {
           .reg         = ctx->reg,
           .alloc       = ctx->alloc,
           .allocations = ctx->allocations,
-          .doc         = ctx->doc,
-          .val         = ctx->val,
+          .reader      = ctx->reader,
+          .event       = ctx->event,
           .meta        = inlineField->meta,
           .data        = data_field_mem(ctx->reg, inlineField, ctx->data),
       };
       data_read_json_val(&inlineCtx, res);
       return;
     }
-    const u32 fieldsRead = 0;
-    data_read_json_struct(ctx, res, fieldsRead);
+    data_read_json_struct(ctx, res, null);
     goto End;
   }
   case DataKind_Union:
@@ -735,7 +921,7 @@ End:
 }
 
 static void data_read_json_val_pointer(const ReadCtx* ctx, DataReadResult* res) {
-  if (json_type(ctx->doc, ctx->val) == JsonType_Null) {
+  if (ctx->event->type == JsonEventType_Null) {
     if (UNLIKELY(ctx->meta.flags & DataFlags_NotEmpty)) {
       *res = result_fail(DataReadError_NullIsInvalid, "Value cannot be null");
     } else {
@@ -754,8 +940,8 @@ static void data_read_json_val_pointer(const ReadCtx* ctx, DataReadResult* res)
       .reg         = ctx->reg,
       .alloc       = ctx->alloc,
       .allocations = ctx->allocations,
-      .doc         = ctx->doc,
-      .val         = ctx->val,
+      .reader      = ctx->reader,
+      .event       = ctx->event,
       .meta        = data_meta_base(ctx->meta),
       .data        = mem,
   };
@@ -763,18 +949,34 @@ static void data_read_json_val_pointer(const ReadCtx* ctx, DataReadResult* res)
   *mem_as_t(ctx->data, void*) = mem.ptr;
 }
 
-static void data_read_json_val_elems(const ReadCtx* ctx, void* out, DataReadResult* res) {
+/**
+ * Read the elements of the array that was just begun (including the array end).
+ * Pre-condition: Output has space for 'count' elements.
+ */
+static void data_read_json_val_elems(
+    const ReadCtx* ctx, void* out, const usize count, DataReadResult* res) {
   const DataDecl* decl = data_decl(ctx->reg, ctx->meta.type);
 
-  void* outItr = out;
-  json_for_elems(ctx->doc, ctx->val, elem) {
+  void*     outItr = out;
+  JsonEvent elem;
+  for (usize i = 0;; ++i) {
+    if (UNLIKELY(!data_read_json_next(ctx->reader, &elem, res))) {
+      return;
+    }
+    if (elem.type == JsonEventType_ArrayEnd) {
+      break;
+    }
+    if (UNLIKELY(i == count)) {
+      data_malformed(JsonError_UnexpectedToken, res); // Index count was wrong; malformed input.
+      return;
+    }
     const ReadCtx elemCtx = {
         .flags       = ctx->flags,
         .reg         = ctx->reg,
         .alloc       = ctx->alloc,
         .allocations = ctx->allocations,
-        .doc         = ctx->doc,
-        .val         = elem,
+        .reader      = ctx->reader,
+        .event       = &elem,
         .meta        = data_meta_base(ctx->meta),
         .data        = mem_create(outItr, decl->size),
     };
@@ -785,7 +987,7 @@ static void data_read_json_val_elems(const ReadCtx* ctx, void* out, DataReadResu
     outItr = bits_ptr_offset(outItr, decl->size);
   }
 
-  if (ctx->meta.flags & DataFlags_Sort) {
+  if (ctx->meta.flags & DataFlags_Sort && outItr != out) {
     if (UNLIKELY(!decl->compare)) {
       diag_crash_msg("Element type of sorted array does not have a compare function");
     }
@@ -805,7 +1007,7 @@ static void data_read_json_val_inline_array(const ReadCtx* ctx, DataReadResult*
   if (UNLIKELY(!data_check_type(ctx, JsonType_Array, res))) {
     return;
   }
-  const usize count = json_elem_count(ctx->doc, ctx->val);
+  const usize count = json_reader_count(ctx->reader);
   if (UNLIKELY(count > ctx->meta.fixedCount)) {
     *res = result_fail(
         DataReadError_ArrayLimitExceeded,
@@ -821,7 +1023,7 @@ static void data_read_json_val_inline_array(const ReadCtx* ctx, DataReadResult*
     }
     mem_set(ctx->data, 0); // TODO: Only clear the unused entries.
   }
-  data_read_json_val_elems(ctx, ctx->data.ptr, res);
+  data_read_json_val_elems(ctx, ctx->data.ptr, count, res);
 }
 
 static void data_read_json_val_heap_array(const ReadCtx* ctx, DataReadResult* res) {
@@ -829,13 +1031,13 @@ static void data_read_json_val_heap_array(const ReadCtx* ctx, DataReadResult* re
     return;
   }
   const DataDecl* decl  = data_decl(ctx->reg, ctx->meta.type);
-  const usize     count = json_elem_count(ctx->doc, ctx->val);
+  const usize     count = json_reader_count(ctx->reader);
   if (!count) {
     if (UNLIKELY(ctx->meta.flags & DataFlags_NotEmpty)) {
       *res = result_fail(DataReadError_EmptyArrayIsInvalid, "Value cannot be an empty array");
     } else {
       *mem_as_t(ctx->data, HeapArray) = (HeapArray){0};
-      *res                            = result_success();
+      data_read_json_val_elems(ctx, null, 0, res); // Consume the array end.
     }
     return;
   }
@@ -846,7 +1048,7 @@ static void data_read_json_val_heap_array(const ReadCtx* ctx, DataReadResult* re
   void* ptr                       = arrayMem.ptr;
   *mem_as_t(ctx->data, HeapArray) = (HeapArray){.values = arrayMem.ptr, .count = count};
 
-  data_read_json_val_elems(ctx, ptr, res);
+  data_read_json_val_elems(ctx, ptr, count, res);
 }
 
 static void data_read_json_val_dynarray(const ReadCtx* ctx, DataReadResult* res) {
@@ -858,12 +1060,12 @@ static void data_read_json_val_dynarray(const ReadCtx* ctx, DataReadResult* res)
   DynArray* out = mem_as_t(ctx->data, DynArray);
   *out          = dynarray_create(ctx->alloc, (u32)decl->size, (u16)decl->align, 0);
 
-  const usize count = json_elem_count(ctx->doc, ctx->val);
+  const usize count = json_reader_count(ctx->reader);
   if (!count) {
     if (UNLIKELY(ctx->meta.flags & DataFlags_NotEmpty)) {
       *res = result_fail(DataReadError_EmptyArrayIsInvalid, "Value cannot be an empty array");
     } else {
-      *res = result_success();
+      data_read_json_val_elems(ctx, null, 0, res); // Consume the array end.
     }
     return;
   }
@@ -871,7 +1073,7 @@ static void data_read_json_val_dynarray(const ReadCtx* ctx, DataReadResult* res)
   dynarray_resize(out, count);
   data_register_alloc(ctx, out->data);
 
-  data_read_json_val_elems(ctx, out->data.ptr, res);
+  data_read_json_val_elems(ctx, out->data.ptr, count, res);
 }
 
 static void data_read_json_val(const ReadCtx* ctx, DataReadResult* res) {
@@ -904,16 +1106,11 @@ String data_read_json(
     Mem                 data,
     DataReadResult*     res) {
 
-  JsonDoc* doc         = json_create(g_allocHeap, 512);
-  DynArray allocations = dynarray_create_t(g_allocHeap, Mem, 64);
+  DynArray   allocations = dynarray_create_t(g_allocHeap, Mem, 64);
+  JsonReader reader      = json_reader_create(input);
 
-  JsonResult   jsonRes;
-  const String rem = json_read(doc, input, JsonReadFlags_HashOnlyFieldNames, &jsonRes);
-  if (jsonRes.type != JsonResultType_Success) {
-    *res = result_fail(
-        DataReadError_Malformed,
-        "Json parsing failed: {}",
-        fmt_text(json_error_str(jsonRes.error)));
+  JsonEvent evt;
+  if (!data_read_json_next(&reader, &evt, res)) {
     goto Ret;
   }
 
@@ -922,13 +1119,25 @@ String data_read_json(
       .reg         = reg,
       .alloc       = alloc,
       .allocations = &allocations,
-      .doc         = doc,
-      .val         = jsonRes.val,
+      .reader      = &reader,
+      .event       = &evt,
       .meta        = meta,
       .data        = data,
   };
   data_read_json_val(&ctx, res);
 
+  /**
+   * Read the remainder of the json value.
+   * NOTE: Malformed json takes precedence over data errors, this matches reading the whole document
+   * before interpreting it.
+   */
+  do {
+    json_reader_next(&reader, &evt);
+  } while (evt.type != JsonEventType_End && evt.type != JsonEventType_Error);
+  if (evt.type == JsonEventType_Error) {
+    data_malformed(evt.val_error, res);
+  }
+
 Ret:
   if (res->error) {
     /**
@@ -939,6 +1148,5 @@ Ret:
     mem_set(data, 0);
   }
   dynarray_destroy(&allocations);
-  json_destroy(doc);
-  return rem;
+  return json_reader_remaining(&reader);
 }
@@ -50,11 +50,11 @@ spec(jsonschema) {
     X(i8, -128, 127)
     X(i16, -32768, 32767)
     X(i32, -2147483648, 2147483647)
-    X(i64, -9223372036854775808, 9223372036854775808)
+    X(i64, -9223372036854776000, 9223372036854776000)
     X(u8, 0, 255)
     X(u16, 0, 65535)
     X(u32, 0, 4294967295)
-    X(u64, 0, 18446744073709551615)
+    X(u64, 0, 18446744073709552000)
 #undef X
   }
 
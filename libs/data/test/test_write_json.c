@@ -87,7 +87,7 @@ spec(write_json) {
         {.numberMaxDecDigits = 2, .expectedOutput = string_static("42.12")},
         {.numberMaxDecDigits = 3, .expectedOutput = string_static("42.123")},
         {.numberMaxDecDigits = 10, .expectedOutput = string_static("42.1234567899")},
-        {.numberMaxDecDigits = 15, .expectedOutput = string_static("42.123456789876542")},
+        {.numberMaxDecDigits = 15, .expectedOutput = string_static("42.12345678987654")},
     };
 
     Mem       buffer    = mem_stack(1024);
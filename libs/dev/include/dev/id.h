@@ -3,50 +3,50 @@
 
 // clang-format off
 enum {
-  DevId_Dev = 2547616407, // Dev
-  DevId_Debug = 1184290027, // Debug
-  DevId_DevGridScaleDown = 2962200988, // DevGridScaleDown
-  DevId_DevGridScaleUp = 3882419195, // DevGridScaleUp
-  DevId_DevGridShow = 72213415, // DevGridShow
-  DevId_DevInspectorDestroy = 855114851, // DevInspectorDestroy
-  DevId_DevInspectorDrop = 1409428543, // DevInspectorDrop
-  DevId_DevInspectorDuplicate = 768886120, // DevInspectorDuplicate
-  DevId_DevInspectorPickerClose = 600620721, // DevInspectorPickerClose
-  DevId_DevInspectorSelectAll = 1629829770, // DevInspectorSelectAll
-  DevId_DevInspectorToggleNavLayer = 1634233509, // DevInspectorToggleNavLayer
-  DevId_DevInspectorToggleSpace = 2338274085, // DevInspectorToggleSpace
-  DevId_DevInspectorToolRotation = 767109130, // DevInspectorToolRotation
-  DevId_DevInspectorToolScale = 772314741, // DevInspectorToolScale
-  DevId_DevInspectorToolTranslation = 3925386453, // DevInspectorToolTranslation
-  DevId_DevInspectorVisAttack = 1069027844, // DevInspectorVisAttack
-  DevId_DevInspectorVisCollision = 1793676054, // DevInspectorVisCollision
-  DevId_DevInspectorVisHealth = 3895311548, // DevInspectorVisHealth
-  DevId_DevInspectorVisIcon = 1634548357, // DevInspectorVisIcon
-  DevId_DevInspectorVisLight = 3803428553, // DevInspectorVisLight
-  DevId_DevInspectorVisLocomotion = 2458237107, // DevInspectorVisLocomotion
-  DevId_DevInspectorVisMode = 3917645724, // DevInspectorVisMode
-  DevId_DevInspectorVisName = 685338671, // DevInspectorVisName
-  DevId_DevInspectorVisNavigationGrid = 1035447104, // DevInspectorVisNavigationGrid
-  DevId_DevInspectorVisNavigationPath = 698286930, // DevInspectorVisNavigationPath
-  DevId_DevInspectorVisTarget = 3170194590, // DevInspectorVisTarget
-  DevId_DevInspectorVisVision = 1006273319, // DevInspectorVisVision
-  DevId_DevPanelClose = 3611106621, // DevPanelClose
-  DevId_DevPanelEcs = 2791786667, // DevPanelEcs
-  DevId_DevPanelHierarchy = 345095034, // DevPanelHierarchy
-  DevId_DevPanelInspector = 3688163297, // DevPanelInspector
-  DevId_DevPanelLevel = 1279901324, // DevPanelLevel
-  DevId_DevPanelPrefab = 205469752, // DevPanelPrefab
-  DevId_DevPanelRenderer = 2341646233, // DevPanelRenderer
-  DevId_DevPanelScript = 3118876660, // DevPanelScript
-  DevId_DevPanelSkeleton = 3621104430, // DevPanelSkeleton
-  DevId_DevPanelSound = 4051400737, // DevPanelSound
-  DevId_DevPanelTime = 1086967750, // DevPanelTime
-  DevId_DevPanelTrace = 1438144397, // DevPanelTrace
-  DevId_DevTimePauseToggle = 2088614054, // DevTimePauseToggle
-  DevId_DevTimeScaleDown = 4137843889, // DevTimeScaleDown
-  DevId_DevTimeScaleUp = 3973438992, // DevTimeScaleUp
-  DevId_DevTimeStep = 3334101101, // DevTimeStep
-  DevId_DevPrefabCreate = 4132903015, // DevPrefabCreate
-  DevId_DevPrefabCreateCancel = 3047481622, // DevPrefabCreateCancel
+  DevId_Dev = 372164667, // Dev
+  DevId_Debug = 1324745150, // Debug
+  DevId_DevGridScaleDown = 1217877523, // DevGridScaleDown
+  DevId_DevGridScaleUp = 4167170860, // DevGridScaleUp
+  DevId_DevGridShow = 2339410639, // DevGridShow
+  DevId_DevInspectorDestroy = 2765014341, // DevInspectorDestroy
+  DevId_DevInspectorDrop = 520744015, // DevInspectorDrop
+  DevId_DevInspectorDuplicate = 3918620395, // DevInspectorDuplicate
+  DevId_DevInspectorPickerClose = 2665601322, // DevInspectorPickerClose
+  DevId_DevInspectorSelectAll = 2857628493, // DevInspectorSelectAll
+  DevId_DevInspectorToggleNavLayer = 1266638265, // DevInspectorToggleNavLayer
+  DevId_DevInspectorToggleSpace = 1077063588, // DevInspectorToggleSpace
+  DevId_DevInspectorToolRotation = 4099683752, // DevInspectorToolRotation
+  DevId_DevInspectorToolScale = 4266034486, // DevInspectorToolScale
+  DevId_DevInspectorToolTranslation = 3550807180, // DevInspectorToolTranslation
+  DevId_DevInspectorVisAttack = 1404300660, // DevInspectorVisAttack
+  DevId_DevInspectorVisCollision = 2605510356, // DevInspectorVisCollision
+  DevId_DevInspectorVisHealth = 2968211203, // DevInspectorVisHealth
+  DevId_DevInspectorVisIcon = 1707349448, // DevInspectorVisIcon
+  DevId_DevInspectorVisLight = 3947727196, // DevInspectorVisLight
+  DevId_DevInspectorVisLocomotion = 2212572609, // DevInspectorVisLocomotion
+  DevId_DevInspectorVisMode = 375959751, // DevInspectorVisMode
+  DevId_DevInspectorVisName = 3038476222, // DevInspectorVisName
+  DevId_DevInspectorVisNavigationGrid = 599143032, // DevInspectorVisNavigationGrid
+  DevId_DevInspectorVisNavigationPath = 2856614996, // DevInspectorVisNavigationPath
+  DevId_DevInspectorVisTarget = 41874855, // DevInspectorVisTarget
+  DevId_DevInspectorVisVision = 3687107169, // DevInspectorVisVision
+  DevId_DevPanelClose = 1945192252, // DevPanelClose
+  DevId_DevPanelEcs = 3263055946, // DevPanelEcs
+  DevId_DevPanelHierarchy = 2308166459, // DevPanelHierarchy
+  DevId_DevPanelInspector = 760926749, // DevPanelInspector
+  DevId_DevPanelLevel = 3220241887, // DevPanelLevel
+  DevId_DevPanelPrefab = 2981461896, // DevPanelPrefab
+  DevId_DevPanelRenderer = 1634919728, // DevPanelRenderer
+  DevId_DevPanelScript = 793809376, // DevPanelScript
+  DevId_DevPanelSkeleton = 2955874992, // DevPanelSkeleton
+  DevId_DevPanelSound = 3779472656, // DevPanelSound
+  DevId_DevPanelTime = 150428454, // DevPanelTime
+  DevId_DevPanelTrace = 3620564968, // DevPanelTrace
+  DevId_DevTimePauseToggle = 3846977067, // DevTimePauseToggle
+  DevId_DevTimeScaleDown = 2731485649, // DevTimeScaleDown
+  DevId_DevTimeScaleUp = 139594261, // DevTimeScaleUp
+  DevId_DevTimeStep = 1265385566, // DevTimeStep
+  DevId_DevPrefabCreate = 1735801354, // DevPrefabCreate
+  DevId_DevPrefabCreateCancel = 3300834398, // DevPrefabCreateCancel
 };
 // clang-format on
@@ -43,6 +43,7 @@ ASSERT(output_max_message_size < u8_max, "Message length has to be storable in a
 
 static const String g_tooltipOpenScript   = string_static("Open script in external editor.");
 static const String g_tooltipSelectEntity = string_static("Select the entity.");
+static const String g_tooltipEvalFreq     = string_static("Effective evaluations per second.");
 
 typedef enum {
   DevScriptTab_Info,
@@ -220,6 +221,14 @@ static void info_panel_tab_script_draw(
     ui_label(c, string_lit("Duration"));
     ui_table_next_column(c, table);
     ui_label(c, fmt_write_scratch("{}", fmt_duration(stats->executedDur)));
+
+    ui_table_next_row(c, table);
+    ui_label(c, string_lit("Evaluations"));
+    ui_table_next_column(c, table);
+    ui_label(
+        c,
+        fmt_write_scratch("{} / sec", fmt_float(stats->evalFrequency, .maxDecDigits = 1)),
+        .tooltip = g_tooltipEvalFreq);
   }
 
   ui_canvas_id_block_next(c); // End on a stable id.
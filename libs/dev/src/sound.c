@@ -20,7 +20,11 @@
 #include "ui/table.h"
 #include "ui/widget.h"
 
-static const String g_tooltipMixerGain = string_static("Mixer output gain.");
+// clang-format off
+static const String g_tooltipMixerGain   = string_static("Mixer output gain.");
+static const String g_tooltipMixerRender = string_static("Time to render a sound period (average and recent maximum).\n"
+                                                         "Should stay well below the period duration to avoid underruns.");
+// clang-format on
 
 typedef enum {
   DevSoundTab_Mixer,
@@ -276,12 +280,26 @@ static void sound_draw_mixer_stats(UiCanvasComp* c, SndMixerComp* m) {
   ui_label(c, deviceText, .selectable = true);
 
   const u32 objectsPlaying   = snd_mixer_objects_playing(m);
+  const u32 objectsReal      = snd_mixer_objects_real(m);
+  const u32 objectsVirtual   = snd_mixer_objects_virtual(m);
   const u32 objectsAllocated = snd_mixer_objects_allocated(m);
   sound_draw_table_header(c, &table, string_lit("Objects"));
   const String objectsText = fmt_write_scratch(
-      "Playing: {<4} Allocated: {}", fmt_int(objectsPlaying), fmt_int(objectsAllocated));
+      "Playing: {<4} Real: {<4} Virtual: {<4} Allocated: {}",
+      fmt_int(objectsPlaying),
+      fmt_int(objectsReal),
+      fmt_int(objectsVirtual),
+      fmt_int(objectsAllocated));
   ui_label(c, objectsText);
 
+  sound_draw_table_header(c, &table, string_lit("Render"));
+  const String renderText = fmt_write_scratch(
+      "Avg: {<8} Max: {<8} Period: {}",
+      fmt_duration(snd_mixer_render_duration(m)),
+      fmt_duration(snd_mixer_render_duration_max(m)),
+      fmt_duration(snd_mixer_render_budget(m)));
+  ui_label(c, renderText, .tooltip = g_tooltipMixerRender);
+
   ui_layout_container_pop(c);
   ui_layout_pop(c);
 }
@@ -376,6 +394,8 @@ static void sound_objects_draw(UiCanvasComp* c, DevSoundPanelComp* panelComp, Sn
   ui_table_add_column(&table, UiTableColumn_Fixed, 80);
   ui_table_add_column(&table, UiTableColumn_Fixed, 80);
   ui_table_add_column(&table, UiTableColumn_Fixed, 100);
+  ui_table_add_column(&table, UiTableColumn_Fixed, 80);
+  ui_table_add_column(&table, UiTableColumn_Fixed, 80);
   ui_table_add_column(&table, UiTableColumn_Flexible, 0);
 
   ui_table_draw_header(
@@ -387,6 +407,8 @@ static void sound_objects_draw(UiCanvasComp* c, DevSoundPanelComp* panelComp, Sn
           {string_lit("Channels"), string_lit("Amount of channels per frame.")},
           {string_lit("Pitch"), string_lit("Current pitch.")},
           {string_lit("Gain"), string_lit("Current gain (L/R).")},
+          {string_lit("Priority"), string_lit("Higher priority objects are preferred for mixing.")},
+          {string_lit("Voice"), string_lit("Real (mixed) or virtual (only tracked) voice.")},
           {string_lit("Progress"), string_lit("Current progress.")},
       });
 
@@ -444,6 +466,13 @@ static void sound_objects_draw(UiCanvasComp* c, DevSoundPanelComp* panelComp, Sn
     ui_label(c, gainText);
     ui_table_next_column(c, &table);
 
+    ui_label(c, fmt_write_scratch("{}", fmt_int(snd_object_get_priority(m, obj))));
+    ui_table_next_column(c, &table);
+
+    const bool virtual = snd_object_is_virtual(m, obj);
+    ui_label(c, virtual ? string_lit("Virtual") : string_lit("Real"));
+    ui_table_next_column(c, &table);
+
     sound_draw_progress(c, progress);
     if (!snd_object_is_loading(m, obj)) {
       const f32    elapsedSecs  = elapsed / (f32)time_second;
@@ -534,7 +563,7 @@ dev_sound_panel_open(EcsWorld* world, const EcsEntityId window, const DevPanelTy
       world,
       panelEntity,
       DevSoundPanelComp,
-      .panel      = ui_panel(.size = ui_vector(800, 685)),
+      .panel      = ui_panel(.size = ui_vector(960, 685)),
       .scrollview = ui_scrollview(),
       .nameFilter = dynstring_create(g_allocHeap, 32));
 
@@ -849,8 +849,9 @@ static void dev_stats_draw_interface(
   }
   if (stats_draw_section(c, string_lit("VFX"))) {
     for (VfxStat vfxStat = 0; vfxStat != VfxStat_Count; ++vfxStat) {
-      const i32 val = vfx_stats_get(&vfxStats->set, vfxStat);
-      stats_draw_val_entry(c, vfx_stats_name(vfxStat), fmt_write_scratch("{}", fmt_int(val)));
+      const i32       val    = vfx_stats_get(&vfxStats->set, vfxStat);
+      const FormatArg valArg = vfxStat == VfxStat_SimulateNs ? fmt_duration(val) : fmt_int(val);
+      stats_draw_val_entry(c, vfx_stats_name(vfxStat), fmt_write_scratch("{}", valArg));
     }
   }
   if (stats_draw_section(c, string_lit("Navigation"))) {
@@ -873,7 +874,7 @@ static void dev_stats_draw_interface(
   }
   if (stats_draw_section(c, string_lit("Interface"))) {
     stats_draw_val_entry(c, string_lit("Canvas size"), fmt_write_scratch("{}x{}", fmt_float(uiStats->canvasSize.x, .maxDecDigits = 0), fmt_float(uiStats->canvasSize.y, .maxDecDigits = 0)));
-    stats_draw_val_entry(c, string_lit("Canvasses"), fmt_write_scratch("{}", fmt_int(uiStats->canvasCount)));
+    stats_draw_val_entry(c, string_lit("Canvasses"), fmt_write_scratch("{<8} built: {}", fmt_int(uiStats->canvasCount), fmt_int(uiStats->canvasBuildCount)));
     stats_draw_val_entry(c, string_lit("Tracked elements"), fmt_write_scratch("{}", fmt_int(uiStats->trackedElemCount)));
     stats_draw_val_entry(c, string_lit("Persistent elements"), fmt_write_scratch("{}", fmt_int(uiStats->persistElemCount)));
     stats_draw_val_entry(c, string_lit("Atoms"), fmt_write_scratch("{<8} deferred: {}", fmt_int(uiStats->atomCount), fmt_int(uiStats->atomDeferredCount)));
@@ -3,6 +3,7 @@
 #include "core/dynstring.h"
 #include "core/format.h"
 #include "core/stringtable.h"
+#include "core/time.h"
 #include "dev/panel.h"
 #include "dev/vfx.h"
 #include "ecs/entity.h"
@@ -177,6 +178,27 @@ static void vfx_info_query(DevVfxPanelComp* panelComp, EcsWorld* world) {
   }
 }
 
+static String vfx_info_lod_name(const DevVfxInfo* info) {
+  for (VfxStat stat = VfxStat_LodFull; stat <= VfxStat_LodPaused; ++stat) {
+    if (info->stats[stat]) {
+      return vfx_stats_name(stat);
+    }
+  }
+  return string_lit("-");
+}
+
+/**
+ * Compute the amount of particles that were simulated per millisecond.
+ */
+static f64 vfx_info_simulate_rate(const DevVfxPanelComp* panelComp) {
+  i64 particleCount = 0, simulateNs = 0;
+  dynarray_for_t(&panelComp->objects, DevVfxInfo, info) {
+    particleCount += info->stats[VfxStat_SimulateCount];
+    simulateNs += info->stats[VfxStat_SimulateNs];
+  }
+  return simulateNs ? (f64)particleCount * (f64)time_millisecond / (f64)simulateNs : 0.0;
+}
+
 static void vfx_options_draw(UiCanvasComp* canvas, DevVfxPanelComp* panelComp) {
   ui_layout_push(canvas);
   ui_style_push(canvas);
@@ -187,7 +209,7 @@ static void vfx_options_draw(UiCanvasComp* canvas, DevVfxPanelComp* panelComp) {
   ui_table_add_column(&table, UiTableColumn_Fixed, 75);
   ui_table_add_column(&table, UiTableColumn_Fixed, 40);
   ui_table_add_column(&table, UiTableColumn_Fixed, 50);
-  ui_table_add_column(&table, UiTableColumn_Fixed, 125);
+  ui_table_add_column(&table, UiTableColumn_Fixed, 300);
   ui_table_add_column(&table, UiTableColumn_Flexible, 0);
 
   ui_table_next_row(canvas, &table);
@@ -204,8 +226,10 @@ static void vfx_options_draw(UiCanvasComp* canvas, DevVfxPanelComp* panelComp) {
   ui_table_next_column(canvas, &table);
   ui_select(canvas, (i32*)&panelComp->sortMode, g_vfxSortModeNames, VfxSortMode_Count);
 
-  const String stats =
-      fmt_write_scratch("Count: {}", fmt_int(panelComp->objects.size, .minDigits = 4));
+  const String stats = fmt_write_scratch(
+      "Count: {} Simulated: {} / ms",
+      fmt_int(panelComp->objects.size, .minDigits = 4),
+      fmt_float(vfx_info_simulate_rate(panelComp), .maxDecDigits = 0));
 
   ui_table_next_column(canvas, &table);
   ui_style_variation(canvas, UiVariation_Monospace);
@@ -232,6 +256,8 @@ vfx_panel_draw(UiCanvasComp* canvas, DevVfxPanelComp* panelComp, SceneSetEnvComp
   ui_table_add_column(&table, UiTableColumn_Fixed, 100);
   ui_table_add_column(&table, UiTableColumn_Fixed, 100);
   ui_table_add_column(&table, UiTableColumn_Fixed, 100);
+  ui_table_add_column(&table, UiTableColumn_Fixed, 100);
+  ui_table_add_column(&table, UiTableColumn_Fixed, 100);
   ui_table_add_column(&table, UiTableColumn_Flexible, 0);
 
   ui_table_draw_header(
@@ -244,6 +270,8 @@ vfx_panel_draw(UiCanvasComp* canvas, DevVfxPanelComp* panelComp, SceneSetEnvComp
           {string_lit("Sprites"), string_lit("Amount of sprites being drawn.")},
           {string_lit("Lights"), string_lit("Amount of lights being drawn.")},
           {string_lit("Stamps"), string_lit("Amount of stamps (projected sprites) being drawn.")},
+          {string_lit("Sim time"), string_lit("Time spent simulating the particles.")},
+          {string_lit("Lod"), string_lit("Simulation level-of-detail.")},
       });
 
   const u32 numObjects = (u32)panelComp->objects.size;
@@ -287,10 +315,20 @@ vfx_panel_draw(UiCanvasComp* canvas, DevVfxPanelComp* panelComp, SceneSetEnvComp
     }
 
     ui_layout_pop(canvas);
-    for (VfxStat stat = 0; stat != VfxStat_Count; ++stat) {
+    static const VfxStat g_countStats[] = {
+        VfxStat_ParticleCount,
+        VfxStat_SpriteCount,
+        VfxStat_LightCount,
+        VfxStat_StampCount,
+    };
+    array_for_t(g_countStats, VfxStat, stat) {
       ui_table_next_column(canvas, &table);
-      ui_label(canvas, fmt_write_scratch("{}", fmt_int(info->stats[stat])));
+      ui_label(canvas, fmt_write_scratch("{}", fmt_int(info->stats[*stat])));
     }
+    ui_table_next_column(canvas, &table);
+    ui_label(canvas, fmt_write_scratch("{}", fmt_duration(info->stats[VfxStat_SimulateNs])));
+    ui_table_next_column(canvas, &table);
+    ui_label(canvas, vfx_info_lod_name(info));
   }
   ui_canvas_id_block_next(canvas);
 
@@ -350,7 +388,7 @@ EcsEntityId dev_vfx_panel_open(EcsWorld* world, const EcsEntityId window, const
       world,
       panelEntity,
       DevVfxPanelComp,
-      .panel      = ui_panel(.size = ui_vector(850, 500)),
+      .panel      = ui_panel(.size = ui_vector(1050, 500)),
       .scrollview = ui_scrollview(),
       .filter     = dynstring_create(g_allocHeap, 32),
       .objects    = dynarray_create_t(g_allocHeap, DevVfxInfo, 128));
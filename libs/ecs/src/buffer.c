@@ -2,6 +2,7 @@
 #include "core/bits.h"
 #include "core/diag.h"
 #include "core/math.h"
+#include "core/sort.h"
 #include "ecs/entity.h"
 
 #include "buffer.h"
@@ -9,9 +10,11 @@
 #include "def.h"
 
 /**
- * Modifications are stored per entity. Entity data is kept sorted so a binary-search can be
- * performed to find the data. At the time of writing this seems like a reasonable space / time
- * tradeoff, but in the future alternatives like hashed lookups could be explored.
+ * Modifications are stored per entity. Entity data is appended in the order it is first modified
+ * and is looked up using an open-addressing hash table (keyed on the entity serial), this avoids
+ * having to shift the entity data when modifying entities out of order. Before flushing the
+ * entities are sorted once (see 'ecs_buffer_sort') to keep the flush order deterministic.
+ * https://en.wikipedia.org/wiki/Open_addressing
  *
  * Component additions are currently stored in a chunked memory allocator with pointers to the next
  * added component (for that same entity) to form an intrusive linked-list.
@@ -28,6 +31,8 @@
  */
 
 #define ecs_buffer_compdata_chunk_size (256 * usize_kibibyte)
+#define ecs_buffer_slots_initial 512
+#define ecs_buffer_slots_loadfactor 0.75f
 
 typedef u32 EcsBufferMaskId;
 
@@ -43,11 +48,10 @@ typedef struct {
   EcsBufferCompData*   compHead; // Head of the linked-list of added components.
 } EcsBufferEntity;
 
-static i8 ecs_buffer_compare_entity(const void* a, const void* b) {
-  const u32 serialA = ecs_entity_id_serial(((const EcsBufferEntity*)a)->id);
-  const u32 serialB = ecs_entity_id_serial(((const EcsBufferEntity*)b)->id);
-  return serialA < serialB ? -1 : serialA > serialB ? 1 : 0;
-}
+struct sEcsBufferSlot {
+  u32 serial; // Serial of the entity, 0 indicates an empty slot.
+  u32 index;  // Index into the entities array.
+};
 
 /**
  * Store a new component-mask.
@@ -67,15 +71,67 @@ static BitSet ecs_buffer_mask(EcsBuffer* buffer, const EcsBufferMaskId id) {
   return dynarray_at(&buffer->masks, id, 1);
 }
 
+static EcsBufferSlot* ecs_buffer_slots_alloc(Allocator* alloc, const u32 slotCount) {
+  const Mem slotsMem = alloc_alloc(alloc, sizeof(EcsBufferSlot) * slotCount, alignof(EcsBufferSlot));
+  mem_set(slotsMem, 0);
+  return slotsMem.ptr;
+}
+
+INLINE_HINT static EcsBufferSlot*
+ecs_buffer_slot(EcsBufferSlot* slots, const u32 slotCount, const u32 serial) {
+  diag_assert(serial); // Serial of 0 is invalid.
+
+  u32 bucket = bits_hash_32_val(serial) & (slotCount - 1);
+  for (usize i = 0; i != slotCount; ++i) {
+    EcsBufferSlot* slot = &slots[bucket];
+    if (LIKELY(!slot->serial || slot->serial == serial)) {
+      return slot; // Slot is either empty or the desired entity.
+    }
+    // Collision, jump to a new place in the table (quadratic probing).
+    bucket = (bucket + i + 1) & (slotCount - 1);
+  }
+  diag_crash_msg("No available EcsBuffer slots");
+}
+
+static void ecs_buffer_slots_rebuild(EcsBuffer* buffer) {
+  mem_set(mem_create(buffer->slots, sizeof(EcsBufferSlot) * buffer->slotCount), 0);
+
+  const EcsBufferEntity* entities = dynarray_begin_t(&buffer->entities, EcsBufferEntity);
+  for (u32 i = 0; i != (u32)buffer->entities.size; ++i) {
+    const u32      serial = ecs_entity_id_serial(entities[i].id);
+    EcsBufferSlot* slot   = ecs_buffer_slot(buffer->slots, buffer->slotCount, serial);
+    *slot                 = (EcsBufferSlot){.serial = serial, .index = i};
+  }
+}
+
+NO_INLINE_HINT static void ecs_buffer_slots_grow(EcsBuffer* buffer) {
+  alloc_free_array_t(buffer->alloc, buffer->slots, buffer->slotCount);
+  buffer->slotCount = bits_nextpow2_32(buffer->slotCount + 1);
+  buffer->slots     = ecs_buffer_slots_alloc(buffer->alloc, buffer->slotCount);
+  ecs_buffer_slots_rebuild(buffer);
+}
+
 static EcsBufferEntity* ecs_buffer_entity_get(EcsBuffer* buffer, const EcsEntityId id) {
-  EcsBufferEntity* result = dynarray_find_or_insert_sorted(
-      &buffer->entities, ecs_buffer_compare_entity, mem_struct(EcsBufferEntity, .id = id).ptr);
-
-  if (!result->id) {
-    result->id         = id;
-    result->addMask    = ecs_buffer_mask_add(buffer);
-    result->removeMask = ecs_buffer_mask_add(buffer);
-    result->compHead   = null;
+  const u32      serial = ecs_entity_id_serial(id);
+  EcsBufferSlot* slot   = ecs_buffer_slot(buffer->slots, buffer->slotCount, serial);
+  if (slot->serial) {
+    return dynarray_at_t(&buffer->entities, slot->index, EcsBufferEntity);
+  }
+
+  // First modification for this entity; append a new entry.
+  const u32        index  = (u32)buffer->entities.size;
+  EcsBufferEntity* result = dynarray_push_t(&buffer->entities, EcsBufferEntity);
+
+  result->id         = id;
+  result->flags      = EcsBufferEntityFlags_None;
+  result->addMask    = ecs_buffer_mask_add(buffer);
+  result->removeMask = ecs_buffer_mask_add(buffer);
+  result->compHead   = null;
+
+  *slot = (EcsBufferSlot){.serial = serial, .index = index};
+
+  if (UNLIKELY(buffer->entities.size >= (usize)(buffer->slotCount * ecs_buffer_slots_loadfactor))) {
+    ecs_buffer_slots_grow(buffer);
   }
   return result;
 }
@@ -130,8 +186,13 @@ static EcsBufferCompData* ecs_buffer_compdata_add(
 }
 
 EcsBuffer ecs_buffer_create(Allocator* alloc, const EcsDef* def) {
+  diag_assert(bits_ispow2_32(ecs_buffer_slots_initial));
+
   return (EcsBuffer){
-      .def      = def,
+      .def       = def,
+      .alloc     = alloc,
+      .slotCount = ecs_buffer_slots_initial,
+      .slots     = ecs_buffer_slots_alloc(alloc, ecs_buffer_slots_initial),
       .masks    = dynarray_create(alloc, (u16)ecs_comp_mask_size(def), ecs_comp_mask_align, 256),
       .entities = dynarray_create_t(alloc, EcsBufferEntity, 256),
       .compDataAllocator =
@@ -140,17 +201,37 @@ EcsBuffer ecs_buffer_create(Allocator* alloc, const EcsDef* def) {
 }
 
 void ecs_buffer_destroy(EcsBuffer* buffer) {
+  alloc_free_array_t(buffer->alloc, buffer->slots, buffer->slotCount);
   dynarray_destroy(&buffer->masks);
   dynarray_destroy(&buffer->entities);
   alloc_chunked_destroy(buffer->compDataAllocator);
 }
 
 void ecs_buffer_clear(EcsBuffer* buffer) {
+  if (buffer->entities.size) {
+    mem_set(mem_create(buffer->slots, sizeof(EcsBufferSlot) * buffer->slotCount), 0);
+  }
   dynarray_clear(&buffer->masks);
   dynarray_clear(&buffer->entities);
   alloc_reset(buffer->compDataAllocator);
 }
 
+void ecs_buffer_sort(EcsBuffer* buffer) {
+  if (buffer->entities.size <= 1) {
+    return;
+  }
+  EcsBufferEntity* begin = dynarray_begin_t(&buffer->entities, EcsBufferEntity);
+  EcsBufferEntity* end   = dynarray_end_t(&buffer->entities, EcsBufferEntity);
+  const usize size    = (u8*)end - (u8*)begin;
+  const Mem   scratch = alloc_alloc(buffer->alloc, size, alignof(EcsBufferEntity));
+
+  // NOTE: Sorting on the whole id sorts on the serial as that is stored in the upper 32 bits.
+  sort_radix_u64_t(begin, end, EcsBufferEntity, id, SortRadixFlags_None, scratch);
+  alloc_free(buffer->alloc, scratch);
+
+  ecs_buffer_slots_rebuild(buffer); // Entity indices have changed.
+}
+
 void ecs_buffer_queue_finalize_all(EcsBuffer* buffer, EcsFinalizer* finalizer) {
   for (usize i = 0; i != buffer->entities.size; ++i) {
     for (EcsBufferCompData* bufferItr = ecs_buffer_comp_begin(buffer, i); bufferItr;
@@ -15,11 +15,16 @@ typedef enum {
   EcsBufferEntityFlags_Destroy = 1 << 1,
 } EcsBufferEntityFlags;
 
+typedef struct sEcsBufferSlot EcsBufferSlot;
+
 typedef struct {
-  const EcsDef* def;
-  DynArray      masks;    // u8[bits_to_bytes(ecs_def_comp_count(def)) + 1][]
-  DynArray      entities; // EcsBufferEntity[] (Sorted on the .id field).
-  Allocator*    compDataAllocator;
+  const EcsDef*  def;
+  Allocator*     alloc;
+  DynArray       masks;    // u8[bits_to_bytes(ecs_def_comp_count(def)) + 1][]
+  DynArray       entities; // EcsBufferEntity[] (Insertion order, sorted by 'ecs_buffer_sort').
+  u32            slotCount;
+  EcsBufferSlot* slots; // Hash table for looking up entities, EcsBufferSlot[slotCount].
+  Allocator*     compDataAllocator;
 } EcsBuffer;
 
 typedef struct sEcsBufferCompData EcsBufferCompData;
@@ -28,6 +33,13 @@ EcsBuffer ecs_buffer_create(Allocator*, const EcsDef* def);
 void      ecs_buffer_destroy(EcsBuffer*);
 void      ecs_buffer_clear(EcsBuffer*);
 
+/**
+ * Sort the buffered entities on their id, gives a deterministic order regardless of the order in
+ * which the modifications were recorded.
+ * NOTE: Invalidates entity indices.
+ */
+void ecs_buffer_sort(EcsBuffer*);
+
 void ecs_buffer_queue_finalize_all(EcsBuffer*, EcsFinalizer*);
 
 void  ecs_buffer_reset_entity(EcsBuffer*, EcsEntityId);
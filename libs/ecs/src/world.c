@@ -418,6 +418,10 @@ void ecs_world_flush_internal(EcsWorld* world) {
   ecs_storage_flush_new_entities(&world->storage);
   trace_end();
 
+  trace_begin("ecs_flush_sort", TraceColor_White);
+  ecs_buffer_sort(&world->buffer);
+  trace_end();
+
   BitSet      tmpMask     = ecs_comp_mask_stack(world->def);
   const usize bufferCount = ecs_buffer_count(&world->buffer);
 
@@ -161,6 +161,33 @@ spec(world) {
     dynarray_destroy(&entities);
   }
 
+  it("can modify many entities in reverse creation order") {
+    static const usize g_entitiesToCreate = 2345;
+    DynArray           entities           = dynarray_create_t(g_allocHeap, EcsEntityId, 2048);
+
+    for (usize i = 0; i != g_entitiesToCreate; ++i) {
+      *dynarray_push_t(&entities, EcsEntityId) = ecs_world_entity_create(world);
+    }
+
+    for (usize i = g_entitiesToCreate; i-- != 0;) {
+      const EcsEntityId id = *dynarray_at_t(&entities, i, EcsEntityId);
+      ecs_world_add_t(world, id, WorldCompB, .f1 = (u32)i);
+      if (i % 2) {
+        ecs_world_add_empty_t(world, id, WorldCompEmpty);
+      }
+    }
+
+    ecs_world_flush(world);
+
+    for (usize i = 0; i != g_entitiesToCreate; ++i) {
+      const EcsEntityId id = *dynarray_at_t(&entities, i, EcsEntityId);
+      check_eq_int(ecs_world_has_t(world, id, WorldCompEmpty), i % 2 != 0);
+      check_require(ecs_world_has_t(world, id, WorldCompB));
+    }
+
+    dynarray_destroy(&entities);
+  }
+
   it("can add empty components") {
     const EcsEntityId entity = ecs_world_entity_create(world);
 
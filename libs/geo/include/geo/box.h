@@ -136,3 +136,18 @@ bool geo_box_overlap_sphere(const GeoBox*, const GeoSphere*);
  * NOTE: Defines a partial frustum by its four side planes.
  */
 bool geo_box_overlap_frustum4_approx(const GeoBox*, const GeoPlane frustum[4]);
+
+/**
+ * Test four boxes for overlap with a partial frustum given by four side planes.
+ * Returns a mask with a bit set for every overlapping box (bit 0 for the first box).
+ * NOTE: Equivalent to 'geo_box_overlap_frustum4_approx' for each box but tests all boxes at once.
+ */
+u32 geo_box_overlap_frustum4_approx_x4(
+    const GeoBox boxes[PARAM_ARRAY_SIZE(4)], const GeoPlane frustum[4]);
+
+/**
+ * Test if the box is fully contained in a partial frustum given by four side planes.
+ * NOTE: If the given box is inverted its considered to always be contained.
+ * NOTE: Defines a partial frustum by its four side planes.
+ */
+bool geo_box_contained_frustum4(const GeoBox*, const GeoPlane frustum[4]);
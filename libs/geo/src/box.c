@@ -592,3 +592,74 @@ bool geo_box_overlap_frustum4_approx(const GeoBox* box, const GeoPlane frustum[4
   return true;
 #endif
 }
+
+u32 geo_box_overlap_frustum4_approx_x4(const GeoBox boxes[4], const GeoPlane frustum[4]) {
+#ifdef VOLO_SIMD
+  /**
+   * Transpose the boxes so every vector contains a single component of all four boxes, this allows
+   * testing the four boxes against a plane with a handful of (vertical) operations.
+   */
+  const SimdVec min0 = simd_vec_load(boxes[0].min.comps), max0 = simd_vec_load(boxes[0].max.comps);
+  const SimdVec min1 = simd_vec_load(boxes[1].min.comps), max1 = simd_vec_load(boxes[1].max.comps);
+  const SimdVec min2 = simd_vec_load(boxes[2].min.comps), max2 = simd_vec_load(boxes[2].max.comps);
+  const SimdVec min3 = simd_vec_load(boxes[3].min.comps), max3 = simd_vec_load(boxes[3].max.comps);
+
+  const SimdVec minXY01 = simd_vec_interleave_lo(min0, min1);
+  const SimdVec minXY23 = simd_vec_interleave_lo(min2, min3);
+  const SimdVec minZW01 = simd_vec_interleave_hi(min0, min1);
+  const SimdVec minZW23 = simd_vec_interleave_hi(min2, min3);
+  const SimdVec maxXY01 = simd_vec_interleave_lo(max0, max1);
+  const SimdVec maxXY23 = simd_vec_interleave_lo(max2, max3);
+  const SimdVec maxZW01 = simd_vec_interleave_hi(max0, max1);
+  const SimdVec maxZW23 = simd_vec_interleave_hi(max2, max3);
+
+  const SimdVec minX = simd_vec_shuffle(minXY01, minXY23, 1, 0, 1, 0);
+  const SimdVec minY = simd_vec_shuffle(minXY01, minXY23, 3, 2, 3, 2);
+  const SimdVec minZ = simd_vec_shuffle(minZW01, minZW23, 1, 0, 1, 0);
+  const SimdVec maxX = simd_vec_shuffle(maxXY01, maxXY23, 1, 0, 1, 0);
+  const SimdVec maxY = simd_vec_shuffle(maxXY01, maxXY23, 3, 2, 3, 2);
+  const SimdVec maxZ = simd_vec_shuffle(maxZW01, maxZW23, 1, 0, 1, 0);
+
+  const SimdVec inverted = simd_vec_or(
+      simd_vec_or(simd_vec_greater(minX, maxX), simd_vec_greater(minY, maxY)),
+      simd_vec_greater(minZ, maxZ));
+
+  SimdVec outside = simd_vec_zero();
+  for (usize i = 0; i != 4; ++i) {
+    const GeoVector n = frustum[i].normal;
+    const SimdVec   x = simd_vec_mul(simd_vec_broadcast(n.x), n.x > 0 ? maxX : minX);
+    const SimdVec   y = simd_vec_mul(simd_vec_broadcast(n.y), n.y > 0 ? maxY : minY);
+    const SimdVec   z = simd_vec_mul(simd_vec_broadcast(n.z), n.z > 0 ? maxZ : minZ);
+    const SimdVec   dot = simd_vec_add(simd_vec_add(x, y), z);
+    outside = simd_vec_or(outside, simd_vec_less(dot, simd_vec_broadcast(frustum[i].distance)));
+  }
+  const u32 outsideMask  = simd_vec_mask_u32(outside);
+  const u32 invertedMask = simd_vec_mask_u32(inverted);
+  return (~outsideMask | invertedMask) & 0b1111;
+#else
+  u32 result = 0;
+  for (u32 i = 0; i != 4; ++i) {
+    if (geo_box_overlap_frustum4_approx(&boxes[i], frustum)) {
+      result |= 1 << i;
+    }
+  }
+  return result;
+#endif
+}
+
+bool geo_box_contained_frustum4(const GeoBox* box, const GeoPlane frustum[4]) {
+  if (geo_box_is_inverted3(box)) {
+    return true;
+  }
+  for (usize i = 0; i != 4; ++i) {
+    const GeoVector min = {
+        .x = frustum[i].normal.x > 0 ? box->min.x : box->max.x,
+        .y = frustum[i].normal.y > 0 ? box->min.y : box->max.y,
+        .z = frustum[i].normal.z > 0 ? box->min.z : box->max.z,
+    };
+    if (geo_vector_dot(frustum[i].normal, min) < frustum[i].distance) {
+      return false;
+    }
+  }
+  return true;
+}
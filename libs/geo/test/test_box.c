@@ -340,4 +340,53 @@ spec(box) {
     // NOTE: Inverted boxes are considered to always be intersecting.
     check(geo_box_overlap_frustum4_approx(&inverted, frustum));
   }
+
+  it("can test four boxes at once for approximate overlap with 4 frustum planes") {
+    const GeoPlane frustum[4] = {
+        {.normal = geo_right, .distance = -1.0f},
+        {.normal = geo_left, .distance = -2.0f},
+        {.normal = geo_down, .distance = -2.0f},
+        {.normal = geo_up, .distance = -1.0f},
+    };
+    const GeoBox boxes[] = {
+        geo_box_from_sphere(geo_vector(0, 0, 0), 0.5f),  // Inside.
+        geo_box_from_sphere(geo_vector(-2, 0, 0), 0.5f), // Outside left.
+        geo_box_from_sphere(geo_vector(2, 0, 0), 0.5f),  // On right edge.
+        geo_box_from_sphere(geo_vector(0, 3, 0), 0.5f),  // Outside top.
+        geo_box_inverted3(),
+        geo_box_from_sphere(geo_vector(0, -2, 0), 0.5f), // Outside bottom.
+        geo_box_from_sphere(geo_vector(0, 0, -2), 0.5f), // Behind.
+        geo_box_from_sphere(geo_vector(3, 0, 0), 0.5f),  // Outside right.
+    };
+    check_eq_int(geo_box_overlap_frustum4_approx_x4(&boxes[0], frustum), 0b0101);
+    check_eq_int(geo_box_overlap_frustum4_approx_x4(&boxes[4], frustum), 0b0101);
+
+    for (u32 i = 0; i != 5; ++i) {
+      u32 expected = 0;
+      for (u32 j = 0; j != 4; ++j) {
+        expected |= geo_box_overlap_frustum4_approx(&boxes[i + j], frustum) ? (1 << j) : 0;
+      }
+      check_eq_int(geo_box_overlap_frustum4_approx_x4(&boxes[i], frustum), expected);
+    }
+  }
+
+  it("can test if a box is contained in 4 frustum planes") {
+    const GeoPlane frustum[4] = {
+        {.normal = geo_right, .distance = -1.0f},
+        {.normal = geo_left, .distance = -2.0f},
+        {.normal = geo_down, .distance = -2.0f},
+        {.normal = geo_up, .distance = -1.0f},
+    };
+    const GeoBox inside    = geo_box_from_sphere(geo_vector(0, 0, 0), 0.5f);
+    const GeoBox onEdge    = geo_box_from_sphere(geo_vector(2, 0, 0), 0.5f);
+    const GeoBox outside   = geo_box_from_sphere(geo_vector(0, 3, 0), 0.5f);
+    const GeoBox enclosing = geo_box_from_sphere(geo_vector(0, 0, 0), 10.0f);
+    const GeoBox inverted  = geo_box_inverted3();
+
+    check(geo_box_contained_frustum4(&inside, frustum));
+    check(!geo_box_contained_frustum4(&onEdge, frustum));
+    check(!geo_box_contained_frustum4(&outside, frustum));
+    check(!geo_box_contained_frustum4(&enclosing, frustum));
+    check(geo_box_contained_frustum4(&inverted, frustum));
+  }
 }
@@ -0,0 +1,45 @@
+#pragma once
+#include "core/sort.h"
+
+/**
+ * Parallel variants of the 'sort_radix_*' routines that split the work over the job system.
+ *
+ * The elements are first distributed over 256 buckets based on the most significant key byte (in
+ * parallel over chunks of the input), afterwards the buckets are radix sorted in parallel.
+ * NOTE: Falls back to the serial sort when the input is small, when there are no other workers or
+ * when not called from a job worker.
+ *
+ * NOTE: The sort is stable, meaning order of equal elements is preserved.
+ * Pre-condition: scratch.size >= (end - begin).
+ * Pre-condition: (end - begin) / stride <= u32_max.
+ */
+#define jobs_sort_radix_u16_t(_BEGIN_, _END_, _TYPE_, _KEY_FIELD_, _FLAGS_, _SCRATCH_)             \
+  jobs_sort_radix_u16(                                                                             \
+      (u8*)(_BEGIN_),                                                                              \
+      (u8*)(_END_),                                                                                \
+      sizeof(_TYPE_),                                                                              \
+      offsetof(_TYPE_, _KEY_FIELD_),                                                               \
+      (_FLAGS_),                                                                                   \
+      (_SCRATCH_))
+
+#define jobs_sort_radix_u32_t(_BEGIN_, _END_, _TYPE_, _KEY_FIELD_, _FLAGS_, _SCRATCH_)             \
+  jobs_sort_radix_u32(                                                                             \
+      (u8*)(_BEGIN_),                                                                              \
+      (u8*)(_END_),                                                                                \
+      sizeof(_TYPE_),                                                                              \
+      offsetof(_TYPE_, _KEY_FIELD_),                                                               \
+      (_FLAGS_),                                                                                   \
+      (_SCRATCH_))
+
+#define jobs_sort_radix_u64_t(_BEGIN_, _END_, _TYPE_, _KEY_FIELD_, _FLAGS_, _SCRATCH_)             \
+  jobs_sort_radix_u64(                                                                             \
+      (u8*)(_BEGIN_),                                                                              \
+      (u8*)(_END_),                                                                                \
+      sizeof(_TYPE_),                                                                              \
+      offsetof(_TYPE_, _KEY_FIELD_),                                                               \
+      (_FLAGS_),                                                                                   \
+      (_SCRATCH_))
+
+void jobs_sort_radix_u16(u8* begin, u8* end, u16 stride, u16 keyOffset, SortRadixFlags, Mem);
+void jobs_sort_radix_u32(u8* begin, u8* end, u16 stride, u16 keyOffset, SortRadixFlags, Mem);
+void jobs_sort_radix_u64(u8* begin, u8* end, u16 stride, u16 keyOffset, SortRadixFlags, Mem);
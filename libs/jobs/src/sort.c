@@ -0,0 +1,262 @@
+#include "core/alloc.h"
+#include "core/bits.h"
+#include "core/diag.h"
+#include "core/math.h"
+#include "jobs/executor.h"
+#include "jobs/graph.h"
+#include "jobs/scheduler.h"
+#include "jobs/sort.h"
+
+#define jobs_sort_chunk_elems_min 16384
+#define jobs_sort_chunks_per_worker 2
+#define jobs_sort_bucket_tasks_per_worker 4
+#define jobs_sort_buckets 256
+
+typedef u32 JobsSortBuckets[jobs_sort_buckets];
+
+typedef struct {
+  u8*            data;
+  u8*            scratch;
+  usize          count, chunkElems;
+  u32            chunkCount, bucketTaskCount;
+  u16            stride, keyOffset;
+  u8             keyBytes;
+  SortRadixFlags flags;
+  JobsSortBuckets* chunkOffsets; // Per chunk: histogram and later the scatter offsets.
+  u32 bucketOffsets[jobs_sort_buckets + 1];
+  u32 bucketTaskBegin[jobs_sort_buckets + 1]; // First bucket of each bucket task.
+} JobsSortCtx;
+
+typedef struct {
+  JobsSortCtx* ctx;
+  u32          index;
+} JobsSortTask;
+
+/**
+ * Retrieve the most significant byte of the key of the given element.
+ */
+static u8 jobs_sort_digit(const JobsSortCtx* ctx, const u8* elem) {
+  const u8* key = elem + ctx->keyOffset;
+  u8        digit;
+  switch (ctx->keyBytes) {
+  case 2:
+    digit = (u8)(*(const u16*)key >> 8);
+    break;
+  case 4:
+    digit = (u8)(*(const u32*)key >> 24);
+    break;
+  default:
+    digit = (u8)(*(const u64*)key >> 56);
+    break;
+  }
+  return (ctx->flags & SortRadixFlags_Descending) ? (u8)~digit : digit;
+}
+
+static void jobs_sort_chunk_range(const JobsSortCtx* ctx, const u32 chunk, u8** begin, u8** end) {
+  const usize elemBegin = chunk * ctx->chunkElems;
+  const usize elemEnd   = math_min(elemBegin + ctx->chunkElems, ctx->count);
+  *begin                = ctx->data + elemBegin * ctx->stride;
+  *end                  = ctx->data + elemEnd * ctx->stride;
+}
+
+static void jobs_sort_task_histogram(const void* data) {
+  const JobsSortTask* task = data;
+  const JobsSortCtx*  ctx  = task->ctx;
+
+  u32* histogram = ctx->chunkOffsets[task->index];
+  mem_set(mem_create(histogram, sizeof(u32) * jobs_sort_buckets), 0);
+
+  u8 *begin, *end;
+  jobs_sort_chunk_range(ctx, task->index, &begin, &end);
+  for (const u8* elem = begin; elem != end; elem += ctx->stride) {
+    ++histogram[jobs_sort_digit(ctx, elem)];
+  }
+}
+
+/**
+ * Compute the output offsets of every chunk in every bucket.
+ * NOTE: Chunks are placed in order within each bucket which keeps the sort stable.
+ */
+static void jobs_sort_task_offsets(const void* data) {
+  const JobsSortTask* task = data;
+  JobsSortCtx*        ctx  = task->ctx;
+
+  u32 offset = 0;
+  for (u32 bucket = 0; bucket != jobs_sort_buckets; ++bucket) {
+    ctx->bucketOffsets[bucket] = offset;
+    for (u32 chunk = 0; chunk != ctx->chunkCount; ++chunk) {
+      const u32 chunkCount              = ctx->chunkOffsets[chunk][bucket];
+      ctx->chunkOffsets[chunk][bucket]  = offset;
+      offset                           += chunkCount;
+    }
+  }
+  ctx->bucketOffsets[jobs_sort_buckets] = offset;
+}
+
+static void jobs_sort_task_scatter(const void* data) {
+  const JobsSortTask* task    = data;
+  const JobsSortCtx*  ctx     = task->ctx;
+  u32*                offsets = ctx->chunkOffsets[task->index];
+
+  u8 *begin, *end;
+  jobs_sort_chunk_range(ctx, task->index, &begin, &end);
+  for (const u8* elem = begin; elem != end; elem += ctx->stride) {
+    const usize outIndex = offsets[jobs_sort_digit(ctx, elem)]++;
+    mem_cpy(
+        mem_create(ctx->scratch + outIndex * ctx->stride, ctx->stride),
+        mem_create(elem, ctx->stride));
+  }
+}
+
+/**
+ * Divide the buckets over the bucket tasks so that every task sorts roughly the same amount of
+ * elements; a bucket is assigned to the task that contains the bucket's first element.
+ */
+static void jobs_sort_task_partition(const void* data) {
+  const JobsSortTask* task = data;
+  JobsSortCtx*        ctx  = task->ctx;
+
+  u32 bucket = 0;
+  for (u32 i = 0; i != ctx->bucketTaskCount; ++i) {
+    const usize taskElemBegin = ctx->count * i / ctx->bucketTaskCount;
+    while (bucket != jobs_sort_buckets && ctx->bucketOffsets[bucket] < taskElemBegin) {
+      ++bucket;
+    }
+    ctx->bucketTaskBegin[i] = bucket;
+  }
+  ctx->bucketTaskBegin[ctx->bucketTaskCount] = jobs_sort_buckets;
+}
+
+static void jobs_sort_radix_serial(
+    const JobsSortCtx* ctx, u8* begin, u8* end, const SortRadixFlags flags, const Mem scratch) {
+  switch (ctx->keyBytes) {
+  case 2:
+    sort_radix_u16(begin, end, ctx->stride, ctx->keyOffset, flags, scratch);
+    return;
+  case 4:
+    sort_radix_u32(begin, end, ctx->stride, ctx->keyOffset, flags, scratch);
+    return;
+  default:
+    sort_radix_u64(begin, end, ctx->stride, ctx->keyOffset, flags, scratch);
+    return;
+  }
+}
+
+/**
+ * Sort the buckets of this task on the remaining key bytes and copy them back to the output.
+ * NOTE: As all elements in a bucket share the most significant byte its radix pass is skipped.
+ */
+static void jobs_sort_task_buckets(const void* data) {
+  const JobsSortTask* task = data;
+  const JobsSortCtx*  ctx  = task->ctx;
+
+  const u32 bucketBegin = ctx->bucketTaskBegin[task->index];
+  const u32 bucketEnd   = ctx->bucketTaskBegin[task->index + 1];
+
+  const usize offsetBegin = (usize)ctx->bucketOffsets[bucketBegin] * ctx->stride;
+  const usize offsetEnd   = (usize)ctx->bucketOffsets[bucketEnd] * ctx->stride;
+  for (u32 bucket = bucketBegin; bucket != bucketEnd; ++bucket) {
+    u8*       begin = ctx->scratch + (usize)ctx->bucketOffsets[bucket] * ctx->stride;
+    u8*       end   = ctx->scratch + (usize)ctx->bucketOffsets[bucket + 1] * ctx->stride;
+    const Mem tmp   = mem_create(ctx->data + (begin - ctx->scratch), end - begin);
+    jobs_sort_radix_serial(ctx, begin, end, ctx->flags, tmp);
+  }
+  const usize size = offsetEnd - offsetBegin;
+  mem_cpy(mem_create(ctx->data + offsetBegin, size), mem_create(ctx->scratch + offsetBegin, size));
+}
+
+static void jobs_sort_radix(
+    u8*                  begin,
+    u8*                  end,
+    const u16            stride,
+    const u16            keyOffset,
+    const u8             keyBytes,
+    const SortRadixFlags flags,
+    const Mem            scratch) {
+  const usize count = (end - begin) / stride;
+  diag_assert(scratch.size >= (usize)(end - begin));
+  diag_assert(count <= u32_max);
+
+  JobsSortCtx ctx = {
+      .data      = begin,
+      .scratch   = mem_begin(scratch),
+      .count     = count,
+      .stride    = stride,
+      .keyOffset = keyOffset,
+      .keyBytes  = keyBytes,
+      .flags     = flags,
+  };
+
+  const usize chunksMax = (usize)g_jobsWorkerCount * jobs_sort_chunks_per_worker;
+  const usize chunks    = math_min(count / jobs_sort_chunk_elems_min, chunksMax);
+  if (!g_jobsIsWorker || g_jobsWorkerCount <= 1 || chunks <= 1) {
+    jobs_sort_radix_serial(&ctx, begin, end, flags, scratch);
+    return;
+  }
+  ctx.chunkCount      = (u32)chunks;
+  ctx.chunkElems      = (count + chunks - 1) / chunks;
+  ctx.bucketTaskCount = math_min(g_jobsWorkerCount * jobs_sort_bucket_tasks_per_worker, 256);
+  ctx.chunkOffsets    = alloc_array_t(g_allocHeap, JobsSortBuckets, ctx.chunkCount);
+
+  const u32 taskCount = ctx.chunkCount * 2 + 2 + ctx.bucketTaskCount;
+  JobGraph* graph     = jobs_graph_create(g_allocHeap, string_lit("RadixSort"), taskCount);
+
+  const JobTaskFlags taskFlags = JobTaskFlags_BorrowName;
+  const JobsSortTask syncData  = {.ctx = &ctx};
+  const JobTaskId    offsetsTask = jobs_graph_add_task(
+      graph, string_lit("offsets"), jobs_sort_task_offsets, mem_var(syncData), taskFlags);
+  const JobTaskId partitionTask = jobs_graph_add_task(
+      graph, string_lit("partition"), jobs_sort_task_partition, mem_var(syncData), taskFlags);
+
+  for (u32 chunk = 0; chunk != ctx.chunkCount; ++chunk) {
+    const JobsSortTask taskData = {.ctx = &ctx, .index = chunk};
+    const JobTaskId    histTask = jobs_graph_add_task(
+        graph, string_lit("histogram"), jobs_sort_task_histogram, mem_var(taskData), taskFlags);
+    const JobTaskId scatterTask = jobs_graph_add_task(
+        graph, string_lit("scatter"), jobs_sort_task_scatter, mem_var(taskData), taskFlags);
+
+    jobs_graph_task_depend(graph, histTask, offsetsTask);
+    jobs_graph_task_depend(graph, offsetsTask, scatterTask);
+    jobs_graph_task_depend(graph, scatterTask, partitionTask);
+  }
+  for (u32 i = 0; i != ctx.bucketTaskCount; ++i) {
+    const JobsSortTask taskData   = {.ctx = &ctx, .index = i};
+    const JobTaskId    bucketTask = jobs_graph_add_task(
+        graph, string_lit("buckets"), jobs_sort_task_buckets, mem_var(taskData), taskFlags);
+    jobs_graph_task_depend(graph, partitionTask, bucketTask);
+  }
+
+  jobs_scheduler_wait_help(jobs_scheduler_run(graph, g_allocHeap));
+  jobs_graph_destroy(graph);
+  alloc_free_array_t(g_allocHeap, ctx.chunkOffsets, ctx.chunkCount);
+}
+
+void jobs_sort_radix_u16(
+    u8*                  begin,
+    u8*                  end,
+    const u16            stride,
+    const u16            keyOffset,
+    const SortRadixFlags flags,
+    const Mem            scratch) {
+  jobs_sort_radix(begin, end, stride, keyOffset, sizeof(u16), flags, scratch);
+}
+
+void jobs_sort_radix_u32(
+    u8*                  begin,
+    u8*                  end,
+    const u16            stride,
+    const u16            keyOffset,
+    const SortRadixFlags flags,
+    const Mem            scratch) {
+  jobs_sort_radix(begin, end, stride, keyOffset, sizeof(u32), flags, scratch);
+}
+
+void jobs_sort_radix_u64(
+    u8*                  begin,
+    u8*                  end,
+    const u16            stride,
+    const u16            keyOffset,
+    const SortRadixFlags flags,
+    const Mem            scratch) {
+  jobs_sort_radix(begin, end, stride, keyOffset, sizeof(u64), flags, scratch);
+}
@@ -5,6 +5,7 @@ void app_check_init(CheckDef* check) {
   register_spec(check, executor);
   register_spec(check, graph);
   register_spec(check, scheduler);
+  register_spec(check, sort);
 }
 
 void app_check_teardown(void) {}
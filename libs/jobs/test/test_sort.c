@@ -0,0 +1,81 @@
+#include "check/spec.h"
+#include "core/alloc.h"
+#include "core/array.h"
+#include "core/rng.h"
+#include "jobs/sort.h"
+
+typedef struct {
+  u32 payload;
+  u32 key;
+} TestJobsSortElemU32;
+
+typedef struct {
+  u64 key;
+  u32 payload;
+} TestJobsSortElemU64;
+
+spec(sort) {
+
+  Rng* rng = null;
+
+  setup() { rng = rng_create_xorwow(g_allocHeap, 42); }
+
+  it("can sort u32 keys in parallel using radix sort") {
+    enum { Count = 100000 };
+    TestJobsSortElemU32* elems   = alloc_array_t(g_allocHeap, TestJobsSortElemU32, Count);
+    const Mem            scratch = alloc_alloc(
+        g_allocHeap, sizeof(TestJobsSortElemU32) * Count, alignof(TestJobsSortElemU32));
+
+    const SortRadixFlags flags[] = {SortRadixFlags_None, SortRadixFlags_Descending};
+    for (u32 f = 0; f != array_elems(flags); ++f) {
+      for (u32 i = 0; i != Count; ++i) {
+        // NOTE: Limited key range to get many duplicate keys to verify the stability.
+        const u32 key = rng_sample_u32(rng) % 50000;
+        elems[i]      = (TestJobsSortElemU32){.payload = i, .key = key * 86243};
+      }
+      jobs_sort_radix_u32_t(elems, elems + Count, TestJobsSortElemU32, key, flags[f], scratch);
+
+      for (u32 i = 1; i != Count; ++i) {
+        const TestJobsSortElemU32* prev = &elems[i - 1];
+        if (prev->key == elems[i].key) {
+          check(prev->payload < elems[i].payload); // Stable; equal keys keep their order.
+        } else if (flags[f] & SortRadixFlags_Descending) {
+          check(prev->key > elems[i].key);
+        } else {
+          check(prev->key < elems[i].key);
+        }
+      }
+    }
+
+    alloc_free(g_allocHeap, scratch);
+    alloc_free_array_t(g_allocHeap, elems, Count);
+  }
+
+  it("can sort u64 keys with a shared most significant byte in parallel") {
+    enum { Count = 100000 };
+    TestJobsSortElemU64* elems   = alloc_array_t(g_allocHeap, TestJobsSortElemU64, Count);
+    const Mem            scratch = alloc_alloc(
+        g_allocHeap, sizeof(TestJobsSortElemU64) * Count, alignof(TestJobsSortElemU64));
+
+    u64 sum = 0;
+    for (u32 i = 0; i != Count; ++i) {
+      // NOTE: All keys end up in a single bucket; should still produce a sorted output.
+      const u64 key  = (u64)(rng_sample_u32(rng) & 0xFFFFFF) << 32 | rng_sample_u32(rng);
+      elems[i]       = (TestJobsSortElemU64){.key = key, .payload = i};
+      sum           += key;
+    }
+    jobs_sort_radix_u64_t(elems, elems + Count, TestJobsSortElemU64, key, 0, scratch);
+
+    u64 sortedSum = elems[0].key;
+    for (u32 i = 1; i != Count; ++i) {
+      check(elems[i - 1].key <= elems[i].key);
+      sortedSum += elems[i].key;
+    }
+    check_eq_int(sortedSum, sum);
+
+    alloc_free(g_allocHeap, scratch);
+    alloc_free_array_t(g_allocHeap, elems, Count);
+  }
+
+  teardown() { rng_destroy(rng); }
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include "core/string.h"
 #include "json/forward.h"
 
 typedef enum {
@@ -59,3 +60,86 @@ String json_error_str(JsonError);
  * Pre-condition: res != null.
  */
 String json_read(JsonDoc*, String, JsonReadFlags, JsonResult* res);
+
+typedef enum {
+  JsonEventType_ArrayBegin,
+  JsonEventType_ArrayEnd,
+  JsonEventType_ObjectBegin,
+  JsonEventType_ObjectEnd,
+  JsonEventType_Field, // Object field name, followed by the events of the field value.
+  JsonEventType_String,
+  JsonEventType_Number,
+  JsonEventType_Bool,
+  JsonEventType_Null,
+  JsonEventType_End, // The value has been fully read.
+  JsonEventType_Error,
+} JsonEventType;
+
+typedef struct {
+  JsonEventType type;
+  union {
+    String    val_string; // Value of String events and the name of Field events.
+    f64       val_number;
+    bool      val_bool;
+    JsonError val_error;
+  };
+} JsonEvent;
+
+/**
+ * Streaming (pull) json reader.
+ * Produces a flat sequence of events for a single json value without building a JsonDoc.
+ *
+ * Whitespace is skipped using a structural index (positions of the structural characters, string
+ * starts and scalar starts) that is computed lazily for 64 byte blocks of the input. The index also
+ * allows skipping and counting the contents of arrays and objects without tokenizing them.
+ *
+ * NOTE: Readers do not own any memory; a reader can be copied to save (and later restore) its
+ * position, for example to look ahead in the input.
+ * NOTE: Fields are internal, use the 'json_reader_*' api.
+ */
+typedef struct {
+  String    input;
+  usize     pos;                      // Offset of the first unread byte.
+  usize     blockOffset, blockEnd;    // Input range of the current index block.
+  u64       blockTokens;              // Token starts in the current index block.
+  u64       carryString;              // All bits set when the previous block ended inside a string.
+  u8        carryEscape, carryScalar; // Index state carried over from the previous block.
+  u8        state, depth;             // Parser state and the amount of open containers.
+  u64       containerObject[2];       // Stack of open containers, bit is set for objects.
+  JsonError error;
+} JsonReader;
+
+/**
+ * Create a reader for the first json value in the given input.
+ * NOTE: The input has to stay valid while the reader is in use.
+ */
+JsonReader json_reader_create(String input);
+
+/**
+ * Read the next event.
+ * After the value has been fully read 'JsonEventType_End' is returned, after an error the same
+ * 'JsonEventType_Error' event is returned for all subsequent reads.
+ *
+ * NOTE: Strings are allocated in scratch memory, the caller is responsible for copying them if they
+ * wish to persist them.
+ */
+void json_reader_next(JsonReader*, JsonEvent* out);
+
+/**
+ * Read the next event, when it begins an array or object then its contents are skipped as well.
+ * NOTE: The contents of skipped arrays and objects are not validated.
+ */
+void json_reader_skip(JsonReader*, JsonEvent* out);
+
+/**
+ * Count the elements of the array that was just begun (without consuming them).
+ * NOTE: Counts based on the structural index, the elements are not validated.
+ *
+ * Pre-condition: The last read event was a JsonEventType_ArrayBegin.
+ */
+u32 json_reader_count(const JsonReader*);
+
+/**
+ * Return the remaining (unread) input.
+ */
+String json_reader_remaining(const JsonReader*);
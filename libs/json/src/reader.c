@@ -0,0 +1,465 @@
+#include "core/bits.h"
+#include "core/diag.h"
+#include "json/read.h"
+
+#include "lex.h"
+
+#ifdef VOLO_SIMD
+#include "core/simd.h"
+#endif
+
+#define json_reader_depth_max 100
+#define json_reader_block_size 64
+
+ASSERT(json_reader_depth_max <= sizeof(((JsonReader*)0)->containerObject) * 8, "Stack too small");
+
+typedef enum {
+  JsonReaderState_Value,       // Expecting a value.
+  JsonReaderState_ArrayValue,  // Expecting an array element or the end of the array.
+  JsonReaderState_ArraySep,    // Expecting a comma or the end of the array.
+  JsonReaderState_ObjectField, // Expecting a field name or the end of the object.
+  JsonReaderState_ObjectSep,   // Expecting a comma or the end of the object.
+  JsonReaderState_Done,
+  JsonReaderState_Failed,
+} JsonReaderState;
+
+/**
+ * Character class masks for a block of 64 input bytes, bit 'n' represents byte 'n'.
+ */
+typedef struct {
+  u64 quote, backslash, op, whitespace;
+} JsonBlockMasks;
+
+static bool json_is_whitespace(const u8 ch) {
+  return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t';
+}
+
+#ifdef VOLO_SIMD
+static u64 json_block_mask(const SimdVec chars, const SimdVec ref) {
+  return (u64)simd_vec_mask_u8(simd_vec_eq_u8(chars, ref));
+}
+#endif
+
+static JsonBlockMasks json_block_classify(const u8 block[PARAM_ARRAY_SIZE(64)]) {
+  JsonBlockMasks res = {0};
+#ifdef VOLO_SIMD
+  const SimdVec vecQuote     = simd_vec_broadcast_u8('"');
+  const SimdVec vecBackslash = simd_vec_broadcast_u8('\\');
+  const SimdVec vecCaseBit   = simd_vec_broadcast_u8(0x20);
+  const SimdVec vecCurlyOpen = simd_vec_broadcast_u8('{'); // '[' | 0x20 == '{'.
+  const SimdVec vecCurlyEnd  = simd_vec_broadcast_u8('}'); // ']' | 0x20 == '}'.
+  const SimdVec vecComma     = simd_vec_broadcast_u8(',');
+  const SimdVec vecColon     = simd_vec_broadcast_u8(':');
+  const SimdVec vecSpace     = simd_vec_broadcast_u8(' ');
+  const SimdVec vecNewline   = simd_vec_broadcast_u8('\n');
+  const SimdVec vecReturn    = simd_vec_broadcast_u8('\r');
+  const SimdVec vecTab       = simd_vec_broadcast_u8('\t');
+
+  for (u32 i = 0; i != 4; ++i) {
+    const SimdVec chars      = simd_vec_load_unaligned(block + i * 16);
+    const SimdVec charsLower = simd_vec_or(chars, vecCaseBit);
+    const u32     shift      = i * 16;
+
+    res.quote |= json_block_mask(chars, vecQuote) << shift;
+    res.backslash |= json_block_mask(chars, vecBackslash) << shift;
+
+    u64 op = json_block_mask(charsLower, vecCurlyOpen) | json_block_mask(charsLower, vecCurlyEnd);
+    op |= json_block_mask(chars, vecComma) | json_block_mask(chars, vecColon);
+    res.op |= op << shift;
+
+    u64 ws = json_block_mask(chars, vecSpace) | json_block_mask(chars, vecNewline);
+    ws |= json_block_mask(chars, vecReturn) | json_block_mask(chars, vecTab);
+    res.whitespace |= ws << shift;
+  }
+#else
+  for (u32 i = 0; i != json_reader_block_size; ++i) {
+    const u64 bit = u64_lit(1) << i;
+    switch (block[i]) {
+    case '"':
+      res.quote |= bit;
+      break;
+    case '\\':
+      res.backslash |= bit;
+      break;
+    case '[':
+    case ']':
+    case '{':
+    case '}':
+    case ',':
+    case ':':
+      res.op |= bit;
+      break;
+    case ' ':
+    case '\n':
+    case '\r':
+    case '\t':
+      res.whitespace |= bit;
+      break;
+    }
+  }
+#endif
+  return res;
+}
+
+/**
+ * Compute the mask of escaped characters (characters preceded by an unescaped backslash).
+ * NOTE: Backslashes are rare in practice so they are resolved one run at a time.
+ */
+static u64 json_block_escaped(u64 backslash, u8* carry) {
+  u64 escaped = *carry;
+  backslash &= ~escaped;
+  *carry = 0;
+  while (backslash) {
+    const u8 index = bits_ctz_64(backslash);
+    if (index == 63) {
+      *carry = 1; // Escapes the first character of the next block.
+      break;
+    }
+    escaped |= u64_lit(1) << (index + 1);
+    backslash &= ~(u64_lit(3) << index); // An escaped backslash does not escape the next char.
+  }
+  return escaped;
+}
+
+/**
+ * Prefix xor; each output bit is the xor of the input bit and all the lower bits.
+ */
+static u64 json_prefix_xor(u64 bits) {
+  bits ^= bits << 1;
+  bits ^= bits << 2;
+  bits ^= bits << 4;
+  bits ^= bits << 8;
+  bits ^= bits << 16;
+  bits ^= bits << 32;
+  return bits;
+}
+
+/**
+ * Index the next block of the input.
+ * Token starts are the structural characters and the starts of strings and scalars outside of
+ * strings (based on the simdjson stage 1 algorithm: https://arxiv.org/abs/1902.08318).
+ */
+static void json_reader_index_block(JsonReader* r) {
+  r->blockOffset = r->blockEnd;
+  r->blockEnd    = r->blockOffset + json_reader_block_size;
+
+  const usize remaining = r->input.size - r->blockOffset;
+  const u8*   block     = mem_at_u8(r->input, r->blockOffset);
+
+  ALIGNAS(16) u8 padded[json_reader_block_size];
+  if (remaining < json_reader_block_size) {
+    mem_set(mem_var(padded), ' ');
+    mem_cpy(mem_var(padded), mem_create(block, remaining));
+    block = padded;
+  }
+  const JsonBlockMasks masks = json_block_classify(block);
+
+  const u64 escaped  = json_block_escaped(masks.backslash, &r->carryEscape);
+  const u64 quote    = masks.quote & ~escaped;
+  const u64 inString = json_prefix_xor(quote) ^ r->carryString;
+  r->carryString     = (u64)((i64)inString >> 63);
+
+  const u64 scalar         = ~(masks.op | masks.whitespace);
+  const u64 scalarNonQuote = scalar & ~quote;
+  const u64 scalarFollows  = scalarNonQuote << 1 | r->carryScalar;
+  r->carryScalar           = (u8)(scalarNonQuote >> 63);
+
+  const u64 stringTail = inString ^ quote; // String contents and closing quotes.
+  r->blockTokens       = (masks.op | (scalar & ~scalarFollows)) & ~stringTail;
+}
+
+/**
+ * Find the start of the next token at or after the given offset.
+ * Returns the input size when there are no more tokens.
+ */
+static usize json_reader_index_next(JsonReader* r, usize from) {
+  while (true) {
+    if (from < r->blockEnd) {
+      diag_assert(from >= r->blockOffset);
+      const u64 tokens = r->blockTokens & (u64_max << (from - r->blockOffset));
+      if (tokens) {
+        return r->blockOffset + bits_ctz_64(tokens);
+      }
+      from = r->blockEnd;
+    }
+    if (r->blockEnd >= r->input.size) {
+      return r->input.size;
+    }
+    json_reader_index_block(r);
+  }
+}
+
+/**
+ * Find the end of the innermost open container (starting from the current position).
+ * Outputs the offset after the closing token and the amount of elements in the container.
+ * Returns false if the input is truncated.
+ *
+ * NOTE: Iterates the token masks directly instead of looking up the tokens one at a time.
+ */
+static bool json_reader_index_container_end(JsonReader* r, usize* outEnd, u32* outCount) {
+  u32   depth = 1, count = 0;
+  usize from  = r->pos;
+  while (true) {
+    if (from < r->blockEnd) {
+      u64 tokens = r->blockTokens & (u64_max << (from - r->blockOffset));
+      for (; tokens; tokens &= tokens - 1) {
+        const usize offset = r->blockOffset + bits_ctz_64(tokens);
+        switch (*mem_at_u8(r->input, offset)) {
+        case '[':
+        case '{':
+          count += depth == 1;
+          ++depth;
+          break;
+        case ']':
+        case '}':
+          if (!--depth) {
+            *outEnd   = offset + 1;
+            *outCount = count;
+            return true;
+          }
+          break;
+        case ',':
+        case ':':
+          break;
+        default:
+          count += depth == 1; // String or scalar.
+          break;
+        }
+      }
+      from = r->blockEnd;
+    }
+    if (r->blockEnd >= r->input.size) {
+      *outEnd   = r->input.size;
+      *outCount = count;
+      return false;
+    }
+    json_reader_index_block(r);
+  }
+}
+
+static void json_reader_lex(JsonReader* r, JsonToken* out) {
+  usize offset = r->pos;
+  if (offset != r->input.size && json_is_whitespace(*mem_at_u8(r->input, offset))) {
+    offset = json_reader_index_next(r, offset);
+  }
+  const String rem = json_lex(string_consume(r->input, offset), out);
+  r->pos           = r->input.size - rem.size;
+}
+
+static void json_reader_fail(JsonReader* r, const JsonError err, JsonEvent* out) {
+  r->state = JsonReaderState_Failed;
+  r->error = err;
+  *out     = (JsonEvent){.type = JsonEventType_Error, .val_error = err};
+}
+
+static bool json_reader_top_is_object(const JsonReader* r) {
+  const u32 index = r->depth - 1u;
+  return (r->containerObject[index / 64] & (u64_lit(1) << (index % 64))) != 0;
+}
+
+static void json_reader_value_end(JsonReader* r) {
+  if (!r->depth) {
+    r->state = JsonReaderState_Done;
+    return;
+  }
+  r->state = json_reader_top_is_object(r) ? JsonReaderState_ObjectSep : JsonReaderState_ArraySep;
+}
+
+static bool json_reader_push(JsonReader* r, const bool object, JsonEvent* out) {
+  if (UNLIKELY(r->depth == json_reader_depth_max)) {
+    json_reader_fail(r, JsonError_MaximumDepthExceeded, out);
+    return false;
+  }
+  const u32 index = r->depth++;
+  const u64 bit   = u64_lit(1) << (index % 64);
+  if (object) {
+    r->containerObject[index / 64] |= bit;
+  } else {
+    r->containerObject[index / 64] &= ~bit;
+  }
+  return true;
+}
+
+static void json_reader_pop(JsonReader* r, const JsonEventType type, JsonEvent* out) {
+  diag_assert(r->depth);
+  --r->depth;
+  json_reader_value_end(r);
+  out->type = type;
+}
+
+static void json_reader_value(JsonReader* r, const JsonToken* token, JsonEvent* out) {
+  switch (token->type) {
+  case JsonTokenType_BracketOpen:
+    if (json_reader_push(r, false, out)) {
+      r->state  = JsonReaderState_ArrayValue;
+      out->type = JsonEventType_ArrayBegin;
+    }
+    return;
+  case JsonTokenType_CurlyOpen:
+    if (json_reader_push(r, true, out)) {
+      r->state  = JsonReaderState_ObjectField;
+      out->type = JsonEventType_ObjectBegin;
+    }
+    return;
+  case JsonTokenType_BracketClose:
+  case JsonTokenType_CurlyClose:
+  case JsonTokenType_Comma:
+  case JsonTokenType_Colon:
+    json_reader_fail(r, JsonError_UnexpectedToken, out);
+    return;
+  case JsonTokenType_String:
+    *out = (JsonEvent){.type = JsonEventType_String, .val_string = token->val_string};
+    break;
+  case JsonTokenType_Number:
+    *out = (JsonEvent){.type = JsonEventType_Number, .val_number = token->val_number};
+    break;
+  case JsonTokenType_True:
+    *out = (JsonEvent){.type = JsonEventType_Bool, .val_bool = true};
+    break;
+  case JsonTokenType_False:
+    *out = (JsonEvent){.type = JsonEventType_Bool, .val_bool = false};
+    break;
+  case JsonTokenType_Null:
+    *out = (JsonEvent){.type = JsonEventType_Null};
+    break;
+  case JsonTokenType_Error:
+    json_reader_fail(r, token->val_error, out);
+    return;
+  case JsonTokenType_End:
+    json_reader_fail(r, JsonError_Truncated, out);
+    return;
+  }
+  json_reader_value_end(r);
+}
+
+static void json_reader_field(JsonReader* r, const JsonToken* token, JsonEvent* out) {
+  if (token->type != JsonTokenType_String || string_is_empty(token->val_string)) {
+    const bool truncated = token->type == JsonTokenType_End;
+    json_reader_fail(r, truncated ? JsonError_Truncated : JsonError_InvalidFieldName, out);
+    return;
+  }
+  const String name = token->val_string;
+
+  JsonToken sepToken;
+  json_reader_lex(r, &sepToken);
+  if (sepToken.type != JsonTokenType_Colon) {
+    json_reader_fail(r, JsonError_InvalidFieldSeparator, out);
+    return;
+  }
+  r->state = JsonReaderState_Value;
+  *out     = (JsonEvent){.type = JsonEventType_Field, .val_string = name};
+}
+
+static void json_reader_separator(
+    JsonReader*           r,
+    const JsonToken*      token,
+    const JsonTokenType   closeType,
+    const JsonEventType   closeEvent,
+    const JsonReaderState nextState,
+    JsonEvent*            out) {
+  if (token->type == closeType) {
+    json_reader_pop(r, closeEvent, out);
+    return;
+  }
+  switch (token->type) {
+  case JsonTokenType_Comma:
+    r->state = nextState;
+    json_reader_next(r, out);
+    return;
+  case JsonTokenType_End:
+    json_reader_fail(r, JsonError_Truncated, out);
+    return;
+  case JsonTokenType_Error:
+    json_reader_fail(r, token->val_error, out);
+    return;
+  default:
+    json_reader_fail(r, JsonError_UnexpectedToken, out);
+    return;
+  }
+}
+
+JsonReader json_reader_create(const String input) {
+  return (JsonReader){.input = input, .state = JsonReaderState_Value};
+}
+
+void json_reader_next(JsonReader* r, JsonEvent* out) {
+  JsonToken token;
+  switch ((JsonReaderState)r->state) {
+  case JsonReaderState_Value:
+    json_reader_lex(r, &token);
+    json_reader_value(r, &token, out);
+    return;
+  case JsonReaderState_ArrayValue:
+    json_reader_lex(r, &token);
+    if (token.type == JsonTokenType_BracketClose) {
+      // NOTE: Not fully spec compliant but we accept arrays with trailing comma's.
+      json_reader_pop(r, JsonEventType_ArrayEnd, out);
+      return;
+    }
+    json_reader_value(r, &token, out);
+    return;
+  case JsonReaderState_ArraySep:
+    json_reader_lex(r, &token);
+    json_reader_separator(
+        r,
+        &token,
+        JsonTokenType_BracketClose,
+        JsonEventType_ArrayEnd,
+        JsonReaderState_ArrayValue,
+        out);
+    return;
+  case JsonReaderState_ObjectField:
+    json_reader_lex(r, &token);
+    if (token.type == JsonTokenType_CurlyClose) {
+      // NOTE: Not fully spec compliant but we accept objects with trailing comma's.
+      json_reader_pop(r, JsonEventType_ObjectEnd, out);
+      return;
+    }
+    json_reader_field(r, &token, out);
+    return;
+  case JsonReaderState_ObjectSep:
+    json_reader_lex(r, &token);
+    json_reader_separator(
+        r,
+        &token,
+        JsonTokenType_CurlyClose,
+        JsonEventType_ObjectEnd,
+        JsonReaderState_ObjectField,
+        out);
+    return;
+  case JsonReaderState_Done:
+    *out = (JsonEvent){.type = JsonEventType_End};
+    return;
+  case JsonReaderState_Failed:
+    *out = (JsonEvent){.type = JsonEventType_Error, .val_error = r->error};
+    return;
+  }
+  diag_crash();
+}
+
+void json_reader_skip(JsonReader* r, JsonEvent* out) {
+  json_reader_next(r, out);
+  if (out->type != JsonEventType_ArrayBegin && out->type != JsonEventType_ObjectBegin) {
+    return;
+  }
+  // Find the matching closing token using the structural index.
+  u32 count;
+  if (UNLIKELY(!json_reader_index_container_end(r, &r->pos, &count))) {
+    json_reader_fail(r, JsonError_Truncated, out);
+    return;
+  }
+  --r->depth;
+  json_reader_value_end(r);
+}
+
+u32 json_reader_count(const JsonReader* r) {
+  diag_assert(r->depth && !json_reader_top_is_object(r));
+
+  JsonReader tmp = *r; // Counting indexes ahead, use a copy to keep the reader unmodified.
+  usize      end;
+  u32        count;
+  json_reader_index_container_end(&tmp, &end, &count);
+  return count;
+}
+
+String json_reader_remaining(const JsonReader* r) { return string_consume(r->input, r->pos); }
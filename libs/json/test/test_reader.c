@@ -0,0 +1,195 @@
+#include "check/spec.h"
+#include "core/alloc.h"
+#include "core/array.h"
+#include "core/dynstring.h"
+#include "core/format.h"
+#include "json/read.h"
+
+/**
+ * Write a textual representation of the events, for example: '[ 1 {a: true} ]'.
+ * Containers at the given depth are skipped (written as '~'), pass 'u32_max' to skip nothing.
+ */
+static void test_reader_dump(const String input, const u32 skipDepth, DynString* out) {
+  JsonReader reader = json_reader_create(input);
+  JsonEvent  event;
+  u32        depth = 0;
+  for (;;) {
+    if (depth == skipDepth) {
+      json_reader_skip(&reader, &event);
+      if (event.type == JsonEventType_ArrayBegin || event.type == JsonEventType_ObjectBegin) {
+        dynstring_append(out, string_lit("~ "));
+        continue;
+      }
+    } else {
+      json_reader_next(&reader, &event);
+    }
+    switch (event.type) {
+    case JsonEventType_ArrayBegin:
+      ++depth;
+      fmt_write(out, "[{} ", fmt_int(json_reader_count(&reader)));
+      break;
+    case JsonEventType_ObjectBegin:
+      ++depth;
+      dynstring_append(out, string_lit("{ "));
+      break;
+    case JsonEventType_ArrayEnd:
+      --depth;
+      dynstring_append(out, string_lit("] "));
+      break;
+    case JsonEventType_ObjectEnd:
+      --depth;
+      dynstring_append(out, string_lit("} "));
+      break;
+    case JsonEventType_Field:
+      fmt_write(out, "{}: ", fmt_text(event.val_string));
+      break;
+    case JsonEventType_String:
+      fmt_write(out, "'{}' ", fmt_text(event.val_string));
+      break;
+    case JsonEventType_Number:
+      fmt_write(out, "{} ", fmt_float(event.val_number));
+      break;
+    case JsonEventType_Bool:
+      fmt_write(out, "{} ", fmt_bool(event.val_bool));
+      break;
+    case JsonEventType_Null:
+      dynstring_append(out, string_lit("null "));
+      break;
+    case JsonEventType_End:
+      dynstring_append(out, string_lit("end"));
+      return;
+    case JsonEventType_Error:
+      fmt_write(out, "error: {}", fmt_text(json_error_str(event.val_error)));
+      return;
+    }
+  }
+}
+
+spec(reader) {
+
+  DynString buffer;
+
+  setup() { buffer = dynstring_create(g_allocHeap, 256); }
+
+  it("can read values") {
+    static const struct {
+      String input, expected;
+    } g_testData[] = {
+        {string_static("42"), string_static("42 end")},
+        {string_static(" \n\t-1.5 "), string_static("-1.5 end")},
+        {string_static("\"Hello\\tWorld\""), string_static("'Hello\tWorld' end")},
+        {string_static("true"), string_static("true end")},
+        {string_static("null"), string_static("null end")},
+        {string_static("[]"), string_static("[0 ] end")},
+        {string_static("[1, 2, 3,]"), string_static("[3 1 2 3 ] end")},
+        {string_static("{}"), string_static("{ } end")},
+        {string_static("{\"a\": 1, \"b\": [true, {}]}"),
+         string_static("{ a: 1 b: [2 true { } ] } end")},
+        {string_static("[\"],[{\", \"\\\"]\", \"\\\\\"]"),
+         string_static("[3 '],[{' '\"]' '\\' ] end")},
+    };
+
+    for (u32 i = 0; i != array_elems(g_testData); ++i) {
+      dynstring_clear(&buffer);
+      test_reader_dump(g_testData[i].input, u32_max, &buffer);
+      check_eq_string(dynstring_view(&buffer), g_testData[i].expected);
+    }
+  }
+
+  it("can skip arrays and objects") {
+    static const struct {
+      String input;
+      u32    skipDepth;
+      String expected;
+    } g_testData[] = {
+        {string_static("[1, [2, 3], {\"a\": \"]\"}, 4]"), 0, string_static("~ end")},
+        {string_static("[1, [2, 3], {\"a\": \"]\"}, 4]"), 1, string_static("[4 1 ~ ~ 4 ] end")},
+        {string_static("{\"a\": [[]], \"b\": {\"c\": \"\\\"}\"}, \"d\": 1}"),
+         1,
+         string_static("{ a: ~ b: ~ d: 1 } end")},
+    };
+
+    for (u32 i = 0; i != array_elems(g_testData); ++i) {
+      dynstring_clear(&buffer);
+      test_reader_dump(g_testData[i].input, g_testData[i].skipDepth, &buffer);
+      check_eq_string(dynstring_view(&buffer), g_testData[i].expected);
+    }
+  }
+
+  it("can read tokens that cross index blocks") {
+    /**
+     * Shift the input over the 64 byte index blocks to make sure strings, escapes and scalars are
+     * correctly carried over to the next block.
+     */
+    const String value = string_lit("[\"a\\\\\\\"[,\", 123456, \"\\\\\", {\"b\": [\"]\"]}, -1.25]");
+    const String expected = string_lit("[5 'a\\\"[,' 123456 '\\' { b: [1 ']' ] } -1.25 ] end");
+
+    for (u32 offset = 0; offset != 80; ++offset) {
+      DynString input = dynstring_create(g_allocHeap, 256);
+      dynstring_append_chars(&input, ' ', offset);
+      dynstring_append(&input, value);
+
+      dynstring_clear(&buffer);
+      test_reader_dump(dynstring_view(&input), u32_max, &buffer);
+      check_eq_string(dynstring_view(&buffer), expected);
+
+      dynstring_clear(&buffer);
+      test_reader_dump(dynstring_view(&input), 0, &buffer);
+      check_eq_string(dynstring_view(&buffer), string_lit("~ end"));
+
+      dynstring_destroy(&input);
+    }
+  }
+
+  it("returns the remaining input") {
+    JsonReader reader = json_reader_create(string_lit("{\"a\": [1, 2]} [3]"));
+    JsonEvent  event;
+    json_reader_skip(&reader, &event);
+    check_eq_int(event.type, JsonEventType_ObjectBegin);
+
+    json_reader_next(&reader, &event);
+    check_eq_int(event.type, JsonEventType_End);
+    check_eq_string(json_reader_remaining(&reader), string_lit(" [3]"));
+  }
+
+  it("fails on malformed input") {
+    static const struct {
+      String input, expected;
+    } g_testData[] = {
+        {string_static(""), string_static("error: Truncated")},
+        {string_static("[1 2]"), string_static("[2 1 error: UnexpectedToken")},
+        {string_static("[1,"), string_static("[1 1 error: Truncated")},
+        {string_static("{\"a\" 1}"), string_static("{ error: InvalidFieldSeparator")},
+        {string_static("{1: 1}"), string_static("{ error: InvalidFieldName")},
+        {string_static("[}"), string_static("[0 error: UnexpectedToken")},
+        {string_static("[\"abc"), string_static("[1 error: UnterminatedString")},
+    };
+
+    for (u32 i = 0; i != array_elems(g_testData); ++i) {
+      dynstring_clear(&buffer);
+      test_reader_dump(g_testData[i].input, u32_max, &buffer);
+      check_eq_string(dynstring_view(&buffer), g_testData[i].expected);
+    }
+
+    dynstring_clear(&buffer);
+    test_reader_dump(string_lit("[[1, 2"), 1, &buffer);
+    check_eq_string(dynstring_view(&buffer), string_lit("[1 error: Truncated"));
+  }
+
+  it("fails when input contains too deep nesting") {
+    DynString input = dynstring_create_over(mem_stack(256));
+    dynstring_append_chars(&input, '[', 101);
+    dynstring_append_chars(&input, ']', 101);
+
+    JsonReader reader = json_reader_create(dynstring_view(&input));
+    JsonEvent  event;
+    do {
+      json_reader_next(&reader, &event);
+    } while (event.type == JsonEventType_ArrayBegin);
+
+    check_eq_int(event.type, JsonEventType_Error);
+    check_eq_string(json_error_str(event.val_error), string_lit("MaximumDepthExceeded"));
+  }
+
+  teardown() { dynstring_destroy(&buffer); }
+}
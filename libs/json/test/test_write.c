@@ -128,7 +128,7 @@ spec(write) {
     dynstring_clear(&buffer);
 
     json_write(&buffer, doc, val, &json_write_opts(.numberMaxDecDigits = 15));
-    check_eq_string(dynstring_view(&buffer), string_lit("42.123456789876542"));
+    check_eq_string(dynstring_view(&buffer), string_lit("42.12345678987654"));
     dynstring_clear(&buffer);
   }
 
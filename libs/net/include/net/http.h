@@ -33,6 +33,7 @@ typedef struct sNetHttp NetHttp;
 
 /**
  * Establish a Http connection to a remote server.
+ * NOTE: Host can optionally specify a port ('name:port'), otherwise the default port is used.
  * NOTE: Multiple requests can be made serially over the same connection.
  * Should be cleaned up using 'net_http_destroy()'.
  */
@@ -66,6 +67,11 @@ NetResult net_http_head_sync(NetHttp*, String uri, const NetHttpAuth*, NetHttpEt
  */
 NetResult net_http_get_sync(NetHttp*, String uri, const NetHttpAuth*, NetHttpEtag*, DynString* out);
 
+/**
+ * Synchonously perform a 'PUT' request to upload the given body to the resource.
+ */
+NetResult net_http_put_sync(NetHttp*, String uri, const NetHttpAuth*, String body);
+
 /**
  * Synchonously shutdown the Http connection.
  */
@@ -2,12 +2,16 @@
 
 /**
  * Initialize all the network subsystems.
- * Should be called once at application startup.
+ * NOTE: Reference counted; can be called multiple times as long as every call is paired with a call
+ * to 'net_teardown()'.
+ * NOTE: The first initialization has to happen on the main-thread, once initialized additional
+ * calls are allowed from any thread.
  */
 void net_init(void);
 
 /**
  * Teardown all the network subsystems.
- * Should be called once at application shutdown.
+ * NOTE: Subsystems are torn down when the last 'net_init()' call has been paired, which has to
+ * happen on the main-thread.
  */
 void net_teardown(void);
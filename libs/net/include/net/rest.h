@@ -25,6 +25,13 @@ void net_rest_destroy(NetRest*);
  */
 NetRestId net_rest_head(NetRest*, String host, String uri, const NetHttpAuth*, const NetHttpEtag*);
 NetRestId net_rest_get(NetRest*, String host, String uri, const NetHttpAuth*, const NetHttpEtag*);
+NetRestId net_rest_put(NetRest*, String host, String uri, const NetHttpAuth*, String data);
+
+/**
+ * Block until the given request is done or the timeout expires.
+ * Returns true if the request is done.
+ */
+bool net_rest_wait(NetRest*, NetRestId, TimeDuration timeout);
 
 /**
  * Query request status.
@@ -3,7 +3,7 @@
 
 /**
  * Network socket.
- * NOTE: Only TCP client sockets are supported.
+ * NOTE: Only TCP sockets are supported.
  */
 typedef struct sNetSocket NetSocket;
 
@@ -14,6 +14,19 @@ typedef struct sNetSocket NetSocket;
 NetSocket* net_socket_connect_sync(Allocator*, NetEndpoint);
 NetSocket* net_socket_connect_any_sync(Allocator*, const NetEndpoint* endpoints, u32 endpointCount);
 
+/**
+ * Synchonously open a Tcp socket that listens for connections on the given endpoint.
+ * NOTE: Use port zero to let the system pick a free port, query it using 'net_socket_local()'.
+ * Should be cleaned up using 'net_socket_destroy()'.
+ */
+NetSocket* net_socket_listen_sync(Allocator*, NetEndpoint);
+
+/**
+ * Synchonously wait for an incoming connection on the given listening socket.
+ * Should be cleaned up using 'net_socket_destroy()'.
+ */
+NetSocket* net_socket_accept_sync(NetSocket* listener, Allocator*);
+
 /**
  * Destroy the given socket.
  */
@@ -25,8 +38,9 @@ void net_socket_destroy(NetSocket*);
 NetResult net_socket_status(const NetSocket*);
 
 /**
- * Retrieve the remote endpoint of the socket.
+ * Retrieve the local / remote endpoint of the socket.
  */
+const NetEndpoint* net_socket_local(const NetSocket*);
 const NetEndpoint* net_socket_remote(const NetSocket*);
 
 /**
@@ -91,6 +91,28 @@ static NetHttpView http_view_remaining(const NetHttp* http) {
   };
 }
 
+/**
+ * Split a host of the form 'name[:port]' into its name and port.
+ * NOTE: Returns false if the port is malformed.
+ */
+static bool http_host_split(const String host, const NetHttpFlags flags, String* name, u16* port) {
+  *name = host;
+  *port = flags & NetHttpFlags_Tls ? 443 : 80;
+
+  const usize sepPos = string_find_last(host, string_lit(":"));
+  if (sentinel_check(sepPos)) {
+    return true; // No port specified; use the default port.
+  }
+  u64          portVal;
+  const String portRem = format_read_u64(string_consume(host, sepPos + 1), &portVal, 10);
+  if (!string_is_empty(portRem) || !portVal || portVal > u16_max) {
+    return false;
+  }
+  *name = string_slice(host, 0, sepPos);
+  *port = (u16)portVal;
+  return true;
+}
+
 static NetTlsFlags http_tls_flags(const NetHttpFlags flags) {
   if ((flags & NetHttpFlags_TlsNoVerify) == NetHttpFlags_TlsNoVerify) {
     return NetTlsFlags_NoVerify;
@@ -154,6 +176,7 @@ static void http_request_header(
     const String       uri,
     const NetHttpAuth* auth,
     const NetHttpEtag* etag,
+    const usize        contentLength, // Sentinel if the request has no body.
     DynString*         out) {
 
   fmt_write(out, "{} {} HTTP/1.1\r\n", fmt_text(method), fmt_text(uri));
@@ -168,6 +191,10 @@ static void http_request_header(
     const u8 lengthClamp = math_min(etag->length, array_elems(etag->data));
     fmt_write(out, "If-None-Match: \"{}\"\r\n", fmt_text(mem_create(etag->data, lengthClamp)));
   }
+  if (!sentinel_check(contentLength)) {
+    fmt_write(out, "Content-Type: application/octet-stream\r\n");
+    fmt_write(out, "Content-Length: {}\r\n", fmt_int(contentLength));
+  }
   fmt_write(out, "Connection: keep-alive\r\n");
   fmt_write(out, "Accept: */*\r\n");
   fmt_write(out, "Accept-Encoding: gzip, deflate\r\n");
@@ -447,12 +474,20 @@ NetHttp* net_http_connect_sync(Allocator* alloc, const String host, const NetHtt
       .flags      = flags,
   };
 
+  String hostName;
+  u16    hostPort;
+  if (!http_host_split(host, flags, &hostName, &hostPort)) {
+    log_w("Http: Malformed host", log_param("host", fmt_text(host)));
+    http->status = NetResult_InvalidHost;
+    return http;
+  }
+
   const TimeSteady resolveStart = time_steady_clock();
 
   NetAddr hostAddrs[32];
   u32     hostAddrCount = array_elems(hostAddrs);
 
-  http->status = net_resolve_sync(host, hostAddrs, &hostAddrCount);
+  http->status = net_resolve_sync(hostName, hostAddrs, &hostAddrCount);
   if (http->status != NetResult_Success) {
     const TimeDuration resolveDur = time_steady_duration(resolveStart, time_steady_clock());
     log_w(
@@ -476,7 +511,7 @@ NetHttp* net_http_connect_sync(Allocator* alloc, const String host, const NetHtt
   NetEndpoint hostEndpoints[32];
   for (u32 i = 0; i != hostAddrCount; ++i) {
     hostEndpoints[i].addr = hostAddrs[i];
-    hostEndpoints[i].port = flags & NetHttpFlags_Tls ? 443 : 80;
+    hostEndpoints[i].port = hostPort;
   }
 
   http->socket       = net_socket_connect_any_sync(alloc, hostEndpoints, hostAddrCount);
@@ -495,7 +530,7 @@ NetHttp* net_http_connect_sync(Allocator* alloc, const String host, const NetHtt
   }
 
   if (flags & NetHttpFlags_Tls) {
-    http->tls    = net_tls_create(alloc, host, http_tls_flags(flags));
+    http->tls    = net_tls_create(alloc, hostName, http_tls_flags(flags));
     http->status = net_tls_status(http->tls);
     if (http->status != NetResult_Success) {
       log_w(
@@ -542,7 +577,8 @@ net_http_head_sync(NetHttp* http, const String uri, const NetHttpAuth* auth, Net
   const String     uriOrRoot = string_is_empty(uri) ? string_lit("/") : uri;
 
   DynString headerBuffer = dynstring_create(g_allocScratch, 4 * usize_kibibyte);
-  http_request_header(http, string_lit("HEAD"), uriOrRoot, auth, etag, &headerBuffer);
+  http_request_header(
+      http, string_lit("HEAD"), uriOrRoot, auth, etag, sentinel_usize, &headerBuffer);
 
   log_d(
       "Http: Sending HEAD",
@@ -599,7 +635,8 @@ NetResult net_http_get_sync(
   const String     uriOrRoot = string_is_empty(uri) ? string_lit("/") : uri;
 
   DynString headerBuffer = dynstring_create(g_allocScratch, 4 * usize_kibibyte);
-  http_request_header(http, string_lit("GET"), uriOrRoot, auth, etag, &headerBuffer);
+  http_request_header(
+      http, string_lit("GET"), uriOrRoot, auth, etag, sentinel_usize, &headerBuffer);
 
   log_d(
       "Http: Sending GET",
@@ -666,6 +703,59 @@ NetResult net_http_get_sync(
   return http->status ? http->status : http_status_result(resp.status);
 }
 
+NetResult net_http_put_sync(
+    NetHttp* http, const String uri, const NetHttpAuth* auth, const String body) {
+  if (http->status != NetResult_Success) {
+    return http->status;
+  }
+  const TimeSteady startTime = time_steady_clock();
+  const String     uriOrRoot = string_is_empty(uri) ? string_lit("/") : uri;
+
+  DynString headerBuffer = dynstring_create(g_allocScratch, 4 * usize_kibibyte);
+  http_request_header(
+      http, string_lit("PUT"), uriOrRoot, auth, null /* etag */, body.size, &headerBuffer);
+
+  log_d(
+      "Http: Sending PUT",
+      log_param("host", fmt_text(http->host)),
+      log_param("uri", fmt_text(uriOrRoot)),
+      log_param("size", fmt_size(body.size)));
+
+  http_write_sync(http, dynstring_view(&headerBuffer));
+  if (http->status == NetResult_Success && body.size) {
+    http_write_sync(http, body);
+  }
+  if (http->status != NetResult_Success) {
+    return http->status;
+  }
+
+  const NetHttpResponse resp    = http_read_response(http);
+  const TimeDuration    respDur = time_steady_duration(startTime, time_steady_clock());
+  if (http->status != NetResult_Success) {
+    return http->status;
+  }
+
+#ifndef VOLO_RELEASE
+  {
+    const String lReason = http_view_str_trim_or(http, resp.reason, string_lit("unknown"));
+    const String lServer = http_view_str_trim_or(http, resp.server, string_lit("unknown"));
+    log_d(
+        "Http: Received PUT response",
+        log_param("status", fmt_int(resp.status)),
+        log_param("reason", fmt_text(lReason)),
+        log_param("duration", fmt_duration(respDur)),
+        log_param("server", fmt_text(lServer)));
+  }
+#else
+  (void)respDur;
+#endif
+
+  http_read_body(http, &resp); // NOTE: The response body (if any) is ignored.
+
+  http_read_end(http); // Releases reading resources, do not access response data after this.
+  return http->status ? http->status : http_status_result(resp.status);
+}
+
 NetResult net_http_shutdown_sync(NetHttp* http) {
   log_d("Http: Shutdown");
 
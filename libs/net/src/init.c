@@ -5,25 +5,19 @@
 #include "pal.h"
 #include "tls.h"
 
-static bool g_initalized;
+static i32 g_initCount;
 
 void net_init(void) {
-  diag_assert(g_threadTid == g_threadMainTid);
-
-  if (!g_initalized) {
-    g_initalized = true;
-
+  if (thread_atomic_add_i32(&g_initCount, 1) == 0) {
+    diag_assert_msg(g_threadTid == g_threadMainTid, "First net init has to be on the main-thread");
     net_pal_init();
     net_tls_init();
   }
 }
 
 void net_teardown(void) {
-  diag_assert(g_threadTid == g_threadMainTid);
-
-  if (g_initalized) {
-    g_initalized = false;
-
+  if (thread_atomic_sub_i32(&g_initCount, 1) == 1) {
+    diag_assert_msg(g_threadTid == g_threadMainTid, "Last net teardown has to be on main-thread");
     net_pal_teardown();
     net_tls_teardown();
   }
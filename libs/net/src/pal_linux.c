@@ -100,7 +100,7 @@ typedef struct sNetSocket {
   Allocator*  alloc;
   NetResult   status;
   int         handle;
-  NetEndpoint remoteEndpoint;
+  NetEndpoint localEndpoint, remoteEndpoint;
   NetDir      closedMask;
 } NetSocket;
 
@@ -168,6 +168,111 @@ NetSocket* net_socket_connect_sync(Allocator* alloc, const NetEndpoint endpoint)
   UNREACHABLE
 }
 
+static socklen_t net_pal_sockaddr(const NetEndpoint* endpoint, struct sockaddr_storage* out) {
+  switch (endpoint->addr.type) {
+  case NetAddrType_V4: {
+    struct sockaddr_in* sockAddr = (struct sockaddr_in*)out;
+    *sockAddr                    = (struct sockaddr_in){.sin_family = AF_INET};
+    mem_write_be_u16(mem_var(sockAddr->sin_port), endpoint->port);
+    mem_cpy(mem_var(sockAddr->sin_addr), mem_var(endpoint->addr.v4.data));
+    return sizeof(struct sockaddr_in);
+  }
+  case NetAddrType_V6: {
+    struct sockaddr_in6* sockAddr = (struct sockaddr_in6*)out;
+    *sockAddr                     = (struct sockaddr_in6){.sin6_family = AF_INET6};
+    mem_write_be_u16(mem_var(sockAddr->sin6_port), endpoint->port);
+    for (u32 i = 0; i != array_elems(endpoint->addr.v6.groups); ++i) {
+      mem_write_be_u16(mem_var(sockAddr->sin6_addr.s6_addr16[i]), endpoint->addr.v6.groups[i]);
+    }
+    return sizeof(struct sockaddr_in6);
+  }
+  case NetAddrType_Count:
+    break;
+  }
+  diag_crash_msg("Unsupported ip-type");
+}
+
+static NetEndpoint net_pal_endpoint(const struct sockaddr_storage* sockAddr) {
+  NetEndpoint res = {0};
+  if (sockAddr->ss_family == AF_INET6) {
+    const struct sockaddr_in6* sockAddr6 = (const struct sockaddr_in6*)sockAddr;
+    res.addr.type                        = NetAddrType_V6;
+    mem_consume_be_u16(mem_var(sockAddr6->sin6_port), &res.port);
+    for (u32 i = 0; i != array_elems(res.addr.v6.groups); ++i) {
+      mem_consume_be_u16(mem_var(sockAddr6->sin6_addr.s6_addr16[i]), &res.addr.v6.groups[i]);
+    }
+  } else {
+    const struct sockaddr_in* sockAddr4 = (const struct sockaddr_in*)sockAddr;
+    res.addr.type                       = NetAddrType_V4;
+    mem_consume_be_u16(mem_var(sockAddr4->sin_port), &res.port);
+    mem_cpy(mem_var(res.addr.v4.data), mem_var(sockAddr4->sin_addr));
+  }
+  return res;
+}
+
+NetSocket* net_socket_listen_sync(Allocator* alloc, const NetEndpoint endpoint) {
+  if (UNLIKELY(!g_netInitialized)) {
+    diag_crash_msg("Network subsystem not initialized");
+  }
+  NetSocket* s = alloc_alloc_t(alloc, NetSocket);
+
+  *s = (NetSocket){.alloc = alloc, .handle = -1, .localEndpoint = endpoint};
+
+  s->handle = socket(net_pal_socket_domain(endpoint.addr.type), SOCK_STREAM, IPPROTO_TCP);
+  if (s->handle < 0) {
+    s->status = net_pal_socket_error(errno);
+    return s;
+  }
+  int optValTrue = true;
+  if (setsockopt(s->handle, SOL_SOCKET, SO_REUSEADDR, (char*)&optValTrue, sizeof(optValTrue)) < 0) {
+    s->status = NetResult_SystemFailure;
+    return s;
+  }
+  struct sockaddr_storage sockAddr;
+  socklen_t               sockAddrLen = net_pal_sockaddr(&endpoint, &sockAddr);
+  if (bind(s->handle, (struct sockaddr*)&sockAddr, sockAddrLen) || listen(s->handle, SOMAXCONN)) {
+    s->status = net_pal_socket_error(errno);
+    return s;
+  }
+  // Query the bound endpoint; the system picks a port when zero was requested.
+  sockAddrLen = sizeof(sockAddr);
+  if (getsockname(s->handle, (struct sockaddr*)&sockAddr, &sockAddrLen)) {
+    s->status = net_pal_socket_error(errno);
+    return s;
+  }
+  s->localEndpoint = net_pal_endpoint(&sockAddr);
+  return s;
+}
+
+NetSocket* net_socket_accept_sync(NetSocket* listener, Allocator* alloc) {
+  NetSocket* s = alloc_alloc_t(alloc, NetSocket);
+
+  *s = (NetSocket){.alloc = alloc, .handle = -1, .localEndpoint = listener->localEndpoint};
+  if (listener->status != NetResult_Success) {
+    s->status = listener->status;
+    return s;
+  }
+  struct sockaddr_storage sockAddr;
+  for (;;) {
+    socklen_t sockAddrLen = sizeof(sockAddr);
+    s->handle             = accept(listener->handle, (struct sockaddr*)&sockAddr, &sockAddrLen);
+    if (s->handle < 0) {
+      if (errno == EINTR) {
+        continue; // Interrupted during accept; retry.
+      }
+      s->status = net_pal_socket_error(errno);
+      return s;
+    }
+    break;
+  }
+  if (!net_socket_configure(s)) {
+    s->status = NetResult_SystemFailure;
+    return s;
+  }
+  s->remoteEndpoint = net_pal_endpoint(&sockAddr);
+  return s;
+}
+
 void net_socket_destroy(NetSocket* s) {
   if (s->handle >= 0) {
     const int closeRet = close(s->handle);
@@ -184,6 +289,7 @@ NetResult net_socket_status(const NetSocket* s) {
   return s->status;
 }
 
+const NetEndpoint* net_socket_local(const NetSocket* s) { return &s->localEndpoint; }
 const NetEndpoint* net_socket_remote(const NetSocket* s) { return &s->remoteEndpoint; }
 
 NetResult net_socket_write_sync(NetSocket* s, const String data) {
@@ -28,6 +28,10 @@ typedef struct {
   int    (SYS_DECL* closesocket)(SOCKET);
   int    (SYS_DECL* setsockopt)(SOCKET, int level, int optName, const char* optVal, int optLen);
   int    (SYS_DECL* connect)(SOCKET, const void* addr, int addrLen);
+  int    (SYS_DECL* bind)(SOCKET, const void* addr, int addrLen);
+  int    (SYS_DECL* listen)(SOCKET, int backlog);
+  SOCKET (SYS_DECL* accept)(SOCKET, void* addr, int* addrLen);
+  int    (SYS_DECL* getsockname)(SOCKET, void* addr, int* addrLen);
   int    (SYS_DECL* send)(SOCKET, const void* buf, int len, int flags);
   int    (SYS_DECL* recv)(SOCKET, void* buf, int len, int flags);
   int    (SYS_DECL* shutdown)(SOCKET, int how);
@@ -70,6 +74,10 @@ static bool net_ws_init(NetWinSock* ws, Allocator* alloc) {
   WS_LOAD_SYM(closesocket);
   WS_LOAD_SYM(setsockopt);
   WS_LOAD_SYM(connect);
+  WS_LOAD_SYM(bind);
+  WS_LOAD_SYM(listen);
+  WS_LOAD_SYM(accept);
+  WS_LOAD_SYM(getsockname);
   WS_LOAD_SYM(send);
   WS_LOAD_SYM(recv);
   WS_LOAD_SYM(shutdown);
@@ -230,7 +238,7 @@ typedef struct sNetSocket {
   Allocator*  alloc;
   NetResult   status;
   SOCKET      handle;
-  NetEndpoint remoteEndpoint;
+  NetEndpoint localEndpoint, remoteEndpoint;
   NetDir      closedMask;
 } NetSocket;
 
@@ -299,6 +307,110 @@ NetSocket* net_socket_connect_sync(Allocator* alloc, const NetEndpoint endpoint)
   diag_crash_msg("Unsupported ip-type");
 }
 
+static int net_pal_sockaddr(const NetEndpoint* endpoint, SOCKADDR_STORAGE* out) {
+  switch (endpoint->addr.type) {
+  case NetAddrType_V4: {
+    struct sockaddr_in* sockAddr = (struct sockaddr_in*)out;
+    *sockAddr                    = (struct sockaddr_in){.sin_family = AF_INET};
+    mem_write_be_u16(mem_var(sockAddr->sin_port), endpoint->port);
+    mem_cpy(mem_var(sockAddr->sin_addr), mem_var(endpoint->addr.v4.data));
+    return sizeof(struct sockaddr_in);
+  }
+  case NetAddrType_V6: {
+    struct sockaddr_in6* sockAddr = (struct sockaddr_in6*)out;
+    *sockAddr                     = (struct sockaddr_in6){.sin6_family = AF_INET6};
+    mem_write_be_u16(mem_var(sockAddr->sin6_port), endpoint->port);
+    for (u32 i = 0; i != array_elems(endpoint->addr.v6.groups); ++i) {
+      mem_write_be_u16(mem_var(sockAddr->sin6_addr.u.Word[i]), endpoint->addr.v6.groups[i]);
+    }
+    return sizeof(struct sockaddr_in6);
+  }
+  case NetAddrType_Count:
+    break;
+  }
+  diag_crash_msg("Unsupported ip-type");
+}
+
+static NetEndpoint net_pal_endpoint(const SOCKADDR_STORAGE* sockAddr) {
+  NetEndpoint res = {0};
+  if (sockAddr->ss_family == AF_INET6) {
+    const struct sockaddr_in6* sockAddr6 = (const struct sockaddr_in6*)sockAddr;
+    res.addr.type                        = NetAddrType_V6;
+    mem_consume_be_u16(mem_var(sockAddr6->sin6_port), &res.port);
+    for (u32 i = 0; i != array_elems(res.addr.v6.groups); ++i) {
+      mem_consume_be_u16(mem_var(sockAddr6->sin6_addr.u.Word[i]), &res.addr.v6.groups[i]);
+    }
+  } else {
+    const struct sockaddr_in* sockAddr4 = (const struct sockaddr_in*)sockAddr;
+    res.addr.type                       = NetAddrType_V4;
+    mem_consume_be_u16(mem_var(sockAddr4->sin_port), &res.port);
+    mem_cpy(mem_var(res.addr.v4.data), mem_var(sockAddr4->sin_addr));
+  }
+  return res;
+}
+
+NetSocket* net_socket_listen_sync(Allocator* alloc, const NetEndpoint endpoint) {
+  if (UNLIKELY(!g_netInitialized)) {
+    diag_crash_msg("Network subsystem not initialized");
+  }
+  NetSocket* s = alloc_alloc_t(alloc, NetSocket);
+
+  *s = (NetSocket){.alloc = alloc, .handle = INVALID_SOCKET, .localEndpoint = endpoint};
+  if (UNLIKELY(!g_netWsLib.ready)) {
+    s->status = NetResult_SystemFailure;
+    return s;
+  }
+
+  const int domain = net_pal_socket_domain(endpoint.addr.type);
+  s->handle        = g_netWsLib.socket(domain, SOCK_STREAM, IPPROTO_TCP);
+  if (s->handle == INVALID_SOCKET) {
+    s->status = net_pal_socket_error();
+    return s;
+  }
+  SOCKADDR_STORAGE sockAddr;
+  int              sockAddrLen = net_pal_sockaddr(&endpoint, &sockAddr);
+  if (g_netWsLib.bind(s->handle, &sockAddr, sockAddrLen) == SOCKET_ERROR ||
+      g_netWsLib.listen(s->handle, SOMAXCONN) == SOCKET_ERROR) {
+    s->status = net_pal_socket_error();
+    return s;
+  }
+  // Query the bound endpoint; the system picks a port when zero was requested.
+  sockAddrLen = sizeof(sockAddr);
+  if (g_netWsLib.getsockname(s->handle, &sockAddr, &sockAddrLen) == SOCKET_ERROR) {
+    s->status = net_pal_socket_error();
+    return s;
+  }
+  s->localEndpoint = net_pal_endpoint(&sockAddr);
+  return s;
+}
+
+NetSocket* net_socket_accept_sync(NetSocket* listener, Allocator* alloc) {
+  NetSocket* s = alloc_alloc_t(alloc, NetSocket);
+
+  *s = (NetSocket){
+      .alloc         = alloc,
+      .handle        = INVALID_SOCKET,
+      .localEndpoint = listener->localEndpoint,
+  };
+  if (listener->status != NetResult_Success) {
+    s->status = listener->status;
+    return s;
+  }
+  SOCKADDR_STORAGE sockAddr;
+  int              sockAddrLen = sizeof(sockAddr);
+  s->handle = g_netWsLib.accept(listener->handle, &sockAddr, &sockAddrLen);
+  if (s->handle == INVALID_SOCKET) {
+    s->status = net_pal_socket_error();
+    return s;
+  }
+  if (!net_socket_configure(s)) {
+    s->status = NetResult_SystemFailure;
+    return s;
+  }
+  s->remoteEndpoint = net_pal_endpoint(&sockAddr);
+  return s;
+}
+
 void net_socket_destroy(NetSocket* s) {
   if (g_netWsLib.ready && s->handle != INVALID_SOCKET) {
     const int closeRet = g_netWsLib.closesocket(s->handle);
@@ -318,6 +430,7 @@ NetResult net_socket_status(const NetSocket* s) {
   return s->status;
 }
 
+const NetEndpoint* net_socket_local(const NetSocket* s) { return &s->localEndpoint; }
 const NetEndpoint* net_socket_remote(const NetSocket* s) { return &s->remoteEndpoint; }
 
 NetResult net_socket_write_sync(NetSocket* s, const String data) {
@@ -20,6 +20,7 @@ typedef enum {
 typedef enum {
   NetRestType_Head, // Http HEAD request.
   NetRestType_Get,  // Http GET request.
+  NetRestType_Put,  // Http PUT request.
 } NetRestType;
 
 typedef struct {
@@ -30,7 +31,7 @@ typedef struct {
   String       host, uri;
   NetHttpAuth  auth;
   NetHttpEtag  etag;
-  DynString    buffer;
+  DynString    buffer; // Response body, or request body for PUT requests.
 } NetRestRequest;
 
 typedef struct sNetRest {
@@ -39,6 +40,7 @@ typedef struct sNetRest {
 
   ThreadMutex     workerMutex;
   ThreadCondition workerWakeCondition;
+  ThreadCondition finishCondition; // Signaled when a request finishes, uses the worker mutex.
   ThreadHandle*   workerThreads;
   bool            workerShutdown;
   u32             workerCount;
@@ -59,6 +61,12 @@ static void rest_wake_worker_single(NetRest* rest) {
   thread_mutex_unlock(rest->workerMutex);
 }
 
+static void rest_notify_finished(NetRest* rest) {
+  thread_mutex_lock(rest->workerMutex);
+  thread_cond_broadcast(rest->finishCondition);
+  thread_mutex_unlock(rest->workerMutex);
+}
+
 static u16 rest_id_index(const NetRestId id) { return (u16)id; }
 static u16 rest_id_generation(const NetRestId id) { return (u16)(id >> 16); }
 
@@ -215,13 +223,20 @@ static void rest_worker_thread(void* data) {
     case NetRestType_Get:
       req->result = net_http_get_sync(con, req->uri, &req->auth, &req->etag, &req->buffer);
       break;
+    case NetRestType_Put:
+      req->result = net_http_put_sync(con, req->uri, &req->auth, dynstring_view(&req->buffer));
+      break;
     }
 
     if (rest_worker_should_retry(req->result) && reqTryIndex < (MaxTries - 1)) {
       ++reqTryIndex;
       goto Retry;
     }
+    if (req->type == NetRestType_Put) {
+      dynstring_clear(&req->buffer); // Request body is no longer needed.
+    }
     rest_request_state_store(req, NetRestState_Finished);
+    rest_notify_finished(rest);
     continue; // Process the next request.
 
   Sleep:
@@ -262,6 +277,7 @@ net_rest_create(Allocator* alloc, u32 workerCount, u32 requestCount, const NetHt
 
       .workerMutex         = thread_mutex_create(g_allocHeap),
       .workerWakeCondition = thread_cond_create(g_allocHeap),
+      .finishCondition     = thread_cond_create(g_allocHeap),
       .workerThreads       = alloc_array_t(alloc, ThreadHandle, workerCount),
       .workerCount         = workerCount,
 
@@ -299,6 +315,7 @@ void net_rest_destroy(NetRest* rest) {
   // Cleanup worker data.
   thread_mutex_destroy(rest->workerMutex);
   thread_cond_destroy(rest->workerWakeCondition);
+  thread_cond_destroy(rest->finishCondition);
   alloc_free_array_t(rest->alloc, rest->workerThreads, rest->workerCount);
 
   // Cleanup requests.
@@ -368,6 +385,34 @@ NetRestId net_rest_get(
   return id;
 }
 
+NetRestId net_rest_put(
+    NetRest*           rest,
+    const String       host,
+    const String       uri,
+    const NetHttpAuth* auth,
+    const String       data) {
+  diag_assert(!string_is_empty(host));
+
+  const NetRestId id = rest_request_acquire(rest);
+  if (!rest_id_valid(id)) {
+    return id; // No free request slots.
+  }
+  NetRestRequest* req = rest_request_get(rest, id);
+  diag_assert(req);
+
+  req->type = NetRestType_Put;
+  req->host = string_maybe_dup(g_allocHeap, host);
+  req->uri  = string_maybe_dup(g_allocHeap, uri);
+  req->auth = auth ? net_http_auth_clone(auth, g_allocHeap) : (NetHttpAuth){0};
+  req->etag = (NetHttpEtag){0};
+  dynstring_append(&req->buffer, data);
+
+  rest_request_state_store(req, NetRestState_Ready);
+  rest_wake_worker_single(rest);
+
+  return id;
+}
+
 bool net_rest_done(NetRest* rest, const NetRestId id) {
   NetRestRequest* req = rest_request_get(rest, id);
   if (!req) {
@@ -376,6 +421,22 @@ bool net_rest_done(NetRest* rest, const NetRestId id) {
   return rest_request_state_load(req) == NetRestState_Finished;
 }
 
+bool net_rest_wait(NetRest* rest, const NetRestId id, const TimeDuration timeout) {
+  const TimeSteady startTime = time_steady_clock();
+
+  bool done;
+  thread_mutex_lock(rest->workerMutex);
+  while (!(done = net_rest_done(rest, id))) {
+    const TimeDuration elapsed = time_steady_duration(startTime, time_steady_clock());
+    if (elapsed >= timeout) {
+      break;
+    }
+    thread_cond_wait_timeout(rest->finishCondition, rest->workerMutex, timeout - elapsed);
+  }
+  thread_mutex_unlock(rest->workerMutex);
+  return done;
+}
+
 NetResult net_rest_result(NetRest* rest, const NetRestId id) {
   NetRestRequest* req = rest_request_get(rest, id);
   if (!req) {
@@ -70,4 +70,33 @@ spec(socket) {
       net_socket_destroy(socket);
     }
   }
+
+  it("can accept a Tcp connection on the loopback interface") {
+    const String msg = string_lit("Hello World!\n");
+
+    const NetEndpoint listenEndpoint = {.addr = net_addr_loopback(NetAddrType_V4), .port = 0};
+    NetSocket*        listener       = net_socket_listen_sync(g_allocHeap, listenEndpoint);
+    check_eq_int(net_socket_status(listener), NetResult_Success);
+    check(net_socket_local(listener)->port != 0);
+
+    NetSocket* client = net_socket_connect_sync(g_allocHeap, *net_socket_local(listener));
+    check_eq_int(net_socket_status(client), NetResult_Success);
+
+    NetSocket* server = net_socket_accept_sync(listener, g_allocHeap);
+    check_eq_int(net_socket_status(server), NetResult_Success);
+    check(net_is_loopback(net_socket_remote(server)->addr));
+
+    check_eq_int(net_socket_write_sync(client, msg), NetResult_Success);
+
+    DynString readBuffer = dynstring_create(g_allocScratch, usize_kibibyte);
+    check_eq_int(net_socket_read_sync(server, &readBuffer), NetResult_Success);
+    check_eq_string(dynstring_view(&readBuffer), msg);
+
+    check_eq_int(net_socket_shutdown(client, NetDir_Both), NetResult_Success);
+    check_eq_int(net_socket_read_sync(server, &readBuffer), NetResult_ConnectionClosed);
+
+    net_socket_destroy(client);
+    net_socket_destroy(server);
+    net_socket_destroy(listener);
+  }
 }
@@ -10,6 +10,7 @@ typedef enum eRendObjectFlags {
   RendObjectFlags_NoInstanceFiltering = 1 << 2, // NOTE: Does not support sorting.
   RendObjectFlags_SortBackToFront     = 1 << 3,
   RendObjectFlags_SortFrontToBack     = 1 << 4,
+  RendObjectFlags_Persistent          = 1 << 5, // Instances are managed using the slot api.
 
   RendObjectFlags_Sorted = RendObjectFlags_SortBackToFront | RendObjectFlags_SortFrontToBack,
 } RendObjectFlags;
@@ -93,3 +94,16 @@ Mem rend_object_set_data(RendObjectComp*, usize size);
   ((_TYPE_*)rend_object_add_instance((_OBJ_), sizeof(_TYPE_), (_TAGS_), (_AABB_)).ptr)
 
 Mem rend_object_add_instance(RendObjectComp*, usize size, SceneTags, GeoBox aabb);
+
+/**
+ * Persistent instance slots, only supported on objects with the 'RendObjectFlags_Persistent' flag.
+ * Slots keep their data across frames, which avoids rewriting instances that did not change.
+ * NOTE: Slots that are not marked during a frame are released at the start of the next frame.
+ * NOTE: Slot data and filter can be updated in parallel for different slots, but allocating a slot
+ * (which can grow the instance buffers) has to be done exclusively.
+ */
+u32  rend_object_slot_alloc(RendObjectComp*, EcsEntityId owner, usize size);
+bool rend_object_slot_valid(const RendObjectComp*, u32 slot, EcsEntityId owner);
+Mem  rend_object_slot_data(RendObjectComp*, u32 slot);
+void rend_object_slot_set_filter(RendObjectComp*, u32 slot, SceneTags, GeoBox aabb);
+void rend_object_slot_mark(RendObjectComp*, u32 slot);
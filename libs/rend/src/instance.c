@@ -1,4 +1,5 @@
 #include "asset/manager.h"
+#include "core/bits.h"
 #include "core/float.h"
 #include "ecs/view.h"
 #include "ecs/world.h"
@@ -76,6 +77,15 @@ ecs_comp_define(RendInstanceEnvComp) {
 
 ecs_comp_define(RendInstanceObjectComp);
 
+/**
+ * Persistent instance slot of a (non-skinned) renderable in the render object of its graphic.
+ */
+ecs_comp_define(RendInstanceSlotComp) {
+  EcsEntityId object; // Graphic entity that owns the render object.
+  u32         slot;
+  u64         inputHash; // Hash of the inputs that were used to write the slot.
+};
+
 ecs_view_define(FillGlobalView) {
   ecs_access_read(RendInstanceEnvComp);
   ecs_access_read(SceneVisibilityEnvComp);
@@ -142,6 +152,20 @@ ecs_view_define(RenderableView) {
   ecs_access_read(SceneBoundsComp);
   ecs_access_with(SceneSkeletonLoadedComp); // Wait until we know the entity is not skinned.
   ecs_access_without(SceneSkeletonComp);
+  ecs_access_write(RendInstanceSlotComp);
+
+  ecs_access_maybe_read(SceneScaleComp);
+  ecs_access_maybe_read(SceneTagComp);
+  ecs_access_maybe_read(SceneTransformComp);
+  ecs_access_maybe_read(SceneVisibilityComp);
+}
+
+ecs_view_define(RenderableAllocView) {
+  ecs_access_read(SceneRenderableComp);
+  ecs_access_read(SceneBoundsComp);
+  ecs_access_with(SceneSkeletonLoadedComp); // Wait until we know the entity is not skinned.
+  ecs_access_without(SceneSkeletonComp);
+  ecs_access_without(RendInstanceSlotComp);
 
   ecs_access_maybe_read(SceneScaleComp);
   ecs_access_maybe_read(SceneTagComp);
@@ -157,7 +181,8 @@ ecs_view_define(ObjView) {
 
 static void rend_obj_init(
     EcsWorld* w, const RendInstanceEnvComp* instanceEnv, const SceneRenderableComp* renderable) {
-  RendObjectComp* obj = rend_object_create(w, renderable->graphic, RendObjectFlags_None);
+  const RendObjectFlags flags = RendObjectFlags_Persistent;
+  RendObjectComp*       obj   = rend_object_create(w, renderable->graphic, flags);
   rend_object_set_alpha_tex_index(obj, rend_instance_alpha_tex_index);
 
   // clang-format off
@@ -169,7 +194,74 @@ static void rend_obj_init(
   ecs_world_add_empty_t(w, renderable->graphic, RendInstanceObjectComp);
 }
 
-ecs_system_define(RendInstanceFillObjSys) {
+static bool rend_instance_visible(const SceneVisibilityEnvComp* visEnv, EcsIterator* itr) {
+  const SceneRenderableComp* renderable = ecs_view_read_t(itr, SceneRenderableComp);
+  if (renderable->color.a <= f32_epsilon) {
+    return false;
+  }
+  const SceneVisibilityComp* visComp = ecs_view_read_t(itr, SceneVisibilityComp);
+  return !visComp || scene_visible_for_render(visEnv, visComp);
+}
+
+/**
+ * Hash of all the component values that are used to write an instance slot.
+ * NOTE: Cheaper than building the instance data, used to skip writing unchanged instances.
+ */
+static u64 rend_instance_input_hash(EcsIterator* itr) {
+  const SceneRenderableComp* renderable    = ecs_view_read_t(itr, SceneRenderableComp);
+  const SceneBoundsComp*     boundsComp    = ecs_view_read_t(itr, SceneBoundsComp);
+  const SceneTagComp*        tagComp       = ecs_view_read_t(itr, SceneTagComp);
+  const SceneTransformComp*  transformComp = ecs_view_read_t(itr, SceneTransformComp);
+  const SceneScaleComp*      scaleComp     = ecs_view_read_t(itr, SceneScaleComp);
+
+  const GeoVector position = transformComp ? transformComp->position : geo_vector(0);
+  const GeoQuat   rot      = transformComp ? transformComp->rotation : geo_quat_ident;
+  const GeoBox*   bounds   = &boundsComp->local;
+  const GeoColor  color    = renderable->color;
+  const GeoColor  emissive = renderable->emissive;
+
+  const f32 vals[] = {
+      position.x,    position.y,    position.z,    scaleComp ? scaleComp->scale : 1.0f,
+      rot.x,         rot.y,         rot.z,         rot.w,
+      color.r,       color.g,       color.b,       color.a,
+      emissive.r,    emissive.g,    emissive.b,    emissive.a,
+      bounds->min.x, bounds->min.y, bounds->min.z, bounds->max.x,
+      bounds->max.y, bounds->max.z,
+  };
+  const u64 tags = tagComp ? tagComp->tags : SceneTags_Default;
+  return bits_hash_64_combine(bits_hash_64(mem_var(vals)), tags);
+}
+
+static RendInstanceData rend_instance_data(EcsIterator* itr) {
+  const SceneRenderableComp* renderable    = ecs_view_read_t(itr, SceneRenderableComp);
+  const SceneTagComp*        tagComp       = ecs_view_read_t(itr, SceneTagComp);
+  const SceneTransformComp*  transformComp = ecs_view_read_t(itr, SceneTransformComp);
+  const SceneScaleComp*      scaleComp     = ecs_view_read_t(itr, SceneScaleComp);
+
+  const GeoVector position = transformComp ? transformComp->position : geo_vector(0);
+  const f32       scale    = scaleComp ? scaleComp->scale : 1.0f;
+  return (RendInstanceData){
+      .posAndScale = geo_vector(position.x, position.y, position.z, scale),
+      .rot         = transformComp ? transformComp->rotation : geo_quat_ident,
+      .tags        = (u32)rend_tags(tagComp, renderable),
+      .color       = rend_color_pack(renderable->color),
+      .emissive    = rend_color_pack(renderable->emissive),
+  };
+}
+
+static void rend_instance_write(
+    RendObjectComp* obj, const u32 slot, const RendInstanceData* data, EcsIterator* itr) {
+  const SceneTransformComp* transformComp = ecs_view_read_t(itr, SceneTransformComp);
+  const SceneScaleComp*     scaleComp     = ecs_view_read_t(itr, SceneScaleComp);
+  const SceneBoundsComp*    boundsComp    = ecs_view_read_t(itr, SceneBoundsComp);
+
+  const GeoBox aabb = scene_bounds_world(boundsComp, transformComp, scaleComp);
+
+  *(RendInstanceData*)rend_object_slot_data(obj, slot).ptr = *data;
+  rend_object_slot_set_filter(obj, slot, (SceneTags)data->tags, aabb);
+}
+
+ecs_system_define(RendInstanceAllocObjSys) {
   EcsView*     globalView = ecs_world_view_t(world, FillGlobalView);
   EcsIterator* globalItr  = ecs_view_maybe_at(globalView, ecs_world_global(world));
   if (!globalItr) {
@@ -178,49 +270,87 @@ ecs_system_define(RendInstanceFillObjSys) {
   const RendInstanceEnvComp*    instanceEnv = ecs_view_read_t(globalItr, RendInstanceEnvComp);
   const SceneVisibilityEnvComp* visEnv      = ecs_view_read_t(globalItr, SceneVisibilityEnvComp);
 
-  EcsView* renderables = ecs_world_view_t(world, RenderableView);
-  EcsView* ObjView     = ecs_world_view_t(world, ObjView);
+  EcsView* renderables = ecs_world_view_t(world, RenderableAllocView);
+  EcsView* objView     = ecs_world_view_t(world, ObjView);
 
   u32 createdObjects = 0;
 
-  EcsIterator* objItr = ecs_view_itr(ObjView);
+  EcsIterator* objItr = ecs_view_itr(objView);
   for (EcsIterator* itr = ecs_view_itr(renderables); ecs_view_walk(itr);) {
-    const SceneRenderableComp* renderable = ecs_view_read_t(itr, SceneRenderableComp);
-    if (renderable->color.a <= f32_epsilon) {
+    if (!rend_instance_visible(visEnv, itr)) {
       continue;
     }
-    const SceneVisibilityComp* visComp = ecs_view_read_t(itr, SceneVisibilityComp);
-    if (visComp && !scene_visible_for_render(visEnv, visComp)) {
+    const EcsEntityId          entity     = ecs_view_entity(itr);
+    const SceneRenderableComp* renderable = ecs_view_read_t(itr, SceneRenderableComp);
+
+    if (UNLIKELY(!ecs_view_maybe_jump(objItr, renderable->graphic))) {
+      const bool objCreating = ecs_world_has_t(world, renderable->graphic, RendObjectComp);
+      if (!objCreating && ++createdObjects <= rend_instance_max_obj_create_per_task) {
+        rend_obj_init(world, instanceEnv, renderable); // NOTE: Limit new objects per frame.
+      }
       continue;
     }
+    RendObjectComp* obj = ecs_view_write_t(objItr, RendObjectComp);
 
-    const SceneTagComp*       tagComp       = ecs_view_read_t(itr, SceneTagComp);
-    const SceneTransformComp* transformComp = ecs_view_read_t(itr, SceneTransformComp);
-    const SceneScaleComp*     scaleComp     = ecs_view_read_t(itr, SceneScaleComp);
-    const SceneBoundsComp*    boundsComp    = ecs_view_read_t(itr, SceneBoundsComp);
+    const RendInstanceData data = rend_instance_data(itr);
+    const u32              slot = rend_object_slot_alloc(obj, entity, sizeof(RendInstanceData));
+    rend_instance_write(obj, slot, &data, itr);
 
-    if (UNLIKELY(!ecs_world_has_t(world, renderable->graphic, RendObjectComp))) {
-      if (++createdObjects <= rend_instance_max_obj_create_per_task) { // Limit new objs per frame.
-        rend_obj_init(world, instanceEnv, renderable);
-      }
+    ecs_world_add_t(
+        world,
+        entity,
+        RendInstanceSlotComp,
+        .object    = renderable->graphic,
+        .slot      = slot,
+        .inputHash = rend_instance_input_hash(itr));
+  }
+}
+
+ecs_system_define(RendInstanceFillObjSys) {
+  EcsView*     globalView = ecs_world_view_t(world, FillGlobalView);
+  EcsIterator* globalItr  = ecs_view_maybe_at(globalView, ecs_world_global(world));
+  if (!globalItr) {
+    return; // Global dependencies not yet available.
+  }
+  const SceneVisibilityEnvComp* visEnv = ecs_view_read_t(globalItr, SceneVisibilityEnvComp);
+
+  EcsView* renderables = ecs_world_view_t(world, RenderableView);
+  EcsView* objView     = ecs_world_view_t(world, ObjView);
+
+  EcsIterator* objItr = ecs_view_itr(objView);
+  for (EcsIterator* itr = ecs_view_itr_step(renderables, parCount, parIndex); ecs_view_walk(itr);) {
+    const EcsEntityId entity = ecs_view_entity(itr);
+    if (!rend_instance_visible(visEnv, itr)) {
+      /**
+       * Slot is not marked and will be released; remove the slot component so that when the
+       * renderable becomes visible again its new slot is allocated (and written) in the same frame.
+       */
+      ecs_world_remove_t(world, entity, RendInstanceSlotComp);
       continue;
     }
+    const SceneRenderableComp* renderable = ecs_view_read_t(itr, SceneRenderableComp);
+    RendInstanceSlotComp*      slotComp   = ecs_view_write_t(itr, RendInstanceSlotComp);
 
-    ecs_view_jump(objItr, renderable->graphic);
-    RendObjectComp* obj = ecs_view_write_t(objItr, RendObjectComp);
-
-    const SceneTags tags     = rend_tags(tagComp, renderable);
-    const GeoVector position = transformComp ? transformComp->position : geo_vector(0);
-    const GeoQuat   rotation = transformComp ? transformComp->rotation : geo_quat_ident;
-    const f32       scale    = scaleComp ? scaleComp->scale : 1.0f;
-    const GeoBox    aabb     = scene_bounds_world(boundsComp, transformComp, scaleComp);
+    RendObjectComp* obj = null;
+    if (LIKELY(slotComp->object == renderable->graphic)) {
+      if (ecs_view_maybe_jump(objItr, renderable->graphic)) {
+        obj = ecs_view_write_t(objItr, RendObjectComp);
+      }
+    }
+    if (UNLIKELY(!obj || !rend_object_slot_valid(obj, slotComp->slot, entity))) {
+      // Graphic changed or the slot was released; allocate a new slot next frame.
+      ecs_world_remove_t(world, entity, RendInstanceSlotComp);
+      continue;
+    }
+    rend_object_slot_mark(obj, slotComp->slot);
 
-    RendInstanceData* data = rend_object_add_instance_t(obj, RendInstanceData, tags, aabb);
-    data->posAndScale      = geo_vector(position.x, position.y, position.z, scale);
-    data->rot              = rotation;
-    data->tags             = (u32)tags;
-    data->color            = rend_color_pack(renderable->color);
-    data->emissive         = rend_color_pack(renderable->emissive);
+    const u64 inputHash = rend_instance_input_hash(itr);
+    if (inputHash == slotComp->inputHash) {
+      continue; // Instance did not change.
+    }
+    const RendInstanceData data = rend_instance_data(itr);
+    rend_instance_write(obj, slotComp->slot, &data, itr);
+    slotComp->inputHash = inputHash;
   }
 }
 
@@ -346,16 +476,25 @@ ecs_system_define(RendInstanceClearDirtyObjectSys) {
 ecs_module_init(rend_instance_module) {
   ecs_register_comp(RendInstanceEnvComp);
   ecs_register_comp_empty(RendInstanceObjectComp);
+  ecs_register_comp(RendInstanceSlotComp);
 
   ecs_register_view(FillGlobalView);
 
   ecs_register_system(RendInstanceIntEnvSys, ecs_register_view(InitEnvView));
 
+  ecs_register_view(ObjView);
+
+  ecs_register_system(
+      RendInstanceAllocObjSys,
+      ecs_view_id(FillGlobalView),
+      ecs_register_view(RenderableAllocView),
+      ecs_view_id(ObjView));
+
   ecs_register_system(
       RendInstanceFillObjSys,
       ecs_view_id(FillGlobalView),
       ecs_register_view(RenderableView),
-      ecs_register_view(ObjView));
+      ecs_view_id(ObjView));
 
   ecs_register_system(
       RendInstanceSkinnedFillObjSys,
@@ -363,7 +502,9 @@ ecs_module_init(rend_instance_module) {
       ecs_register_view(RenderableSkinnedView),
       ecs_register_view(ObjSkinnedView));
 
+  ecs_order(RendInstanceAllocObjSys, RendOrder_ObjectUpdate - 1);
   ecs_order(RendInstanceFillObjSys, RendOrder_ObjectUpdate);
+  ecs_parallel(RendInstanceFillObjSys, g_jobsWorkerCount);
   ecs_order(RendInstanceSkinnedFillObjSys, RendOrder_ObjectUpdate);
 
   ecs_register_system(RendInstanceClearDirtyObjectSys, ecs_register_view(DirtyObjectView));
@@ -3,6 +3,7 @@
 #include "core/diag.h"
 #include "core/math.h"
 #include "core/sort.h"
+#include "core/thread.h"
 #include "ecs/entity.h"
 #include "ecs/view.h"
 #include "ecs/world.h"
@@ -22,12 +23,46 @@
 
 #define rend_min_align 16
 #define rend_max_res_requests 16
+#define rend_cull_insts_min 256    // Objects with fewer instances are culled linearly.
+#define rend_cull_cell_insts 64    // Targeted average amount of instances per cull cell.
+#define rend_cull_grid_size_max 64 // Maximum amount of cull cells along each axis.
+#define rend_cull_displaced_frac 4 // Rebuild the cells when 1/N of the instances changed cells.
 
 typedef struct {
   u16 instIndex;
   u16 viewDist; // Not linear.
 } RendObjectSortKey;
 
+/**
+ * Group of spatially close instances that can be accepted or rejected at once.
+ */
+typedef struct {
+  GeoBox    bounds;
+  SceneTags tagsAny, tagsAll; // Union and intersection of the instance tags.
+  u32       instBegin, instCount;
+} RendObjectCell;
+
+typedef struct {
+  f32 originX, originZ;
+  f32 cellSizeInvX, cellSizeInvZ;
+  u32 sizeX, sizeZ;
+} RendObjectGrid;
+
+/**
+ * Location of an instance in the cull cells.
+ */
+typedef struct {
+  u32 index;    // Index in the cull instance arrays.
+  u16 cell;     // Cull cell that contains the instance.
+  u16 gridCell; // Grid cell that contains the instance center.
+} RendObjectCullSlot;
+
+typedef enum {
+  RendSlotState_Live   = 1 << 0,
+  RendSlotState_Marked = 1 << 1, // Used this frame, unmarked slots are released on the next sweep.
+  RendSlotState_Stale  = 1 << 2, // Filter changed since the cull cells were updated.
+} RendSlotState;
+
 ecs_comp_define(RendObjectComp) {
   EcsEntityId resources[RendObjectRes_Count];
   EcsEntityId cameraFilter;
@@ -44,6 +79,27 @@ ecs_comp_define(RendObjectComp) {
 
   Mem dataMem;
   Mem instDataMem, instTagsMem, instAabbMem;
+
+  // Persistent objects only.
+  u32 slotFreeCount;
+  Mem slotStateMem; // RendSlotState[instCount], u8 per slot so slots can be marked in parallel.
+  Mem slotOwnerMem; // EcsEntityId[instCount].
+  Mem slotFreeMem;  // u32[slotFreeCount].
+
+  /**
+   * Cull cells, instances binned in a uniform grid on the xz plane (see 'rend_object_cull_build').
+   * NOTE: Instance data is stored in cell order and padded to a multiple of four instances.
+   */
+  i32            cullDirty; // Instances added or removed since the cells were built.
+  i32            cullStale; // Slot filters changed since the last update; modified atomically.
+  u32            cullCellCount;
+  u32            cullDisplaced; // Instances that moved to another grid cell since the build.
+  RendObjectGrid cullGrid;
+  Mem            cullCellMem; // RendObjectCell[cullCellCount].
+  Mem            cullSlotMem; // RendObjectCullSlot[instCount], persistent objects only.
+  Mem            cullInstMem; // u32[], instance indices.
+  Mem            cullTagsMem; // SceneTags[], instance tags.
+  Mem            cullAabbMem; // GeoBox[], instance bounds.
 };
 
 /**
@@ -66,6 +122,14 @@ static void ecs_destruct_object(void* data) {
   alloc_maybe_free(g_allocHeap, comp->instDataMem);
   alloc_maybe_free(g_allocHeap, comp->instTagsMem);
   alloc_maybe_free(g_allocHeap, comp->instAabbMem);
+  alloc_maybe_free(g_allocHeap, comp->slotStateMem);
+  alloc_maybe_free(g_allocHeap, comp->slotOwnerMem);
+  alloc_maybe_free(g_allocHeap, comp->slotFreeMem);
+  alloc_maybe_free(g_allocHeap, comp->cullCellMem);
+  alloc_maybe_free(g_allocHeap, comp->cullSlotMem);
+  alloc_maybe_free(g_allocHeap, comp->cullInstMem);
+  alloc_maybe_free(g_allocHeap, comp->cullTagsMem);
+  alloc_maybe_free(g_allocHeap, comp->cullAabbMem);
 }
 
 static void ecs_combine_object(void* dataA, void* dataB) {
@@ -75,6 +139,9 @@ static void ecs_combine_object(void* dataA, void* dataB) {
   diag_assert_msg(
       objA->instDataSize == objB->instDataSize,
       "Only objects with the same instance-data stride can be combined");
+  diag_assert_msg(
+      !(objA->flags & RendObjectFlags_Persistent) || !objB->instCount,
+      "Persistent objects can only be combined before allocating slots");
 
   for (u32 i = 0; i != objB->instCount; ++i) {
     const Mem data = mem_slice(objB->instDataMem, objB->instDataSize * i, objB->instDataSize);
@@ -117,6 +184,243 @@ static Mem rend_object_inst_data(const RendObjectComp* obj, const u32 instance)
   return mem_create(bits_ptr_offset(obj->instDataMem.ptr, offset), obj->instDataSize);
 }
 
+static u8* rend_object_slot_state(const RendObjectComp* obj, const u32 slot) {
+  return (u8*)obj->slotStateMem.ptr + slot;
+}
+
+static void rend_object_slot_tag_mask_add(RendObjectComp* obj, const SceneTags tags) {
+  ASSERT(sizeof(SceneTags) == sizeof(i32), "Unexpected SceneTags size");
+  i32 expected = thread_atomic_load_i32((i32*)&obj->tagMask);
+  while ((expected | (i32)tags) != expected) {
+    if (thread_atomic_compare_exchange_i32((i32*)&obj->tagMask, &expected, expected | (i32)tags)) {
+      break;
+    }
+  }
+}
+
+/**
+ * Release all slots that were not marked since the last sweep.
+ */
+static void rend_object_slot_sweep(RendObjectComp* obj) {
+  obj->tagMask = 0;
+
+  u32 liveCount = 0;
+  for (u32 slot = 0; slot != obj->instCount; ++slot) {
+    u8* state = rend_object_slot_state(obj, slot);
+    if (*state & RendSlotState_Marked) {
+      *state &= ~RendSlotState_Marked;
+      obj->tagMask |= ((SceneTags*)obj->instTagsMem.ptr)[slot];
+      ++liveCount;
+      continue;
+    }
+    if (*state & RendSlotState_Live) {
+      obj->cullDirty                              = true;
+      *state                                      = 0;
+      ((EcsEntityId*)obj->slotOwnerMem.ptr)[slot] = 0;
+      ((SceneTags*)obj->instTagsMem.ptr)[slot]    = 0;
+      ((GeoBox*)obj->instAabbMem.ptr)[slot]       = geo_box_inverted3();
+
+      buf_ensure(&obj->slotFreeMem, (obj->slotFreeCount + 1) * sizeof(u32), alignof(u32));
+      ((u32*)obj->slotFreeMem.ptr)[obj->slotFreeCount++] = slot;
+    }
+  }
+  if (!liveCount) {
+    obj->instCount     = 0; // All slots released; allows the object resources to be unloaded.
+    obj->slotFreeCount = 0;
+  }
+}
+
+static bool rend_object_inst_live(const RendObjectComp* obj, const u32 instIndex) {
+  return (*rend_object_slot_state(obj, instIndex) & RendSlotState_Live) != 0;
+}
+
+static u32 rend_object_grid_cell(const RendObjectGrid* grid, const GeoBox* aabb) {
+  if (geo_box_is_inverted3(aabb)) {
+    return grid->sizeX * grid->sizeZ; // Unbounded instances are stored in an extra cell.
+  }
+  const GeoVector center = geo_box_center(aabb);
+  const f32       maxX   = (f32)(grid->sizeX - 1);
+  const f32       maxZ   = (f32)(grid->sizeZ - 1);
+  const f32 x = math_clamp_f32((center.x - grid->originX) * grid->cellSizeInvX, 0.0f, maxX);
+  const f32 z = math_clamp_f32((center.z - grid->originZ) * grid->cellSizeInvZ, 0.0f, maxZ);
+  return (u32)z * grid->sizeX + (u32)x;
+}
+
+/**
+ * Bin the instances into cells of a uniform grid on the xz plane so they can be culled per cell.
+ * The grid is sized to contain approximately 'rend_cull_cell_insts' instances per cell on average.
+ * NOTE: Only done for persistent objects as the cells are only rebuilt when slots are allocated or
+ * released; filter changes are applied incrementally by 'rend_object_cull_refresh'.
+ */
+static void rend_object_cull_build(RendObjectComp* obj) {
+  obj->cullDirty     = false;
+  obj->cullStale     = false;
+  obj->cullCellCount = 0;
+  obj->cullDisplaced = 0;
+  if (!(obj->flags & RendObjectFlags_Persistent) || obj->instCount < rend_cull_insts_min) {
+    return;
+  }
+  const SceneTags* instTags  = obj->instTagsMem.ptr;
+  const GeoBox*    instAabbs = obj->instAabbMem.ptr;
+
+  // Compute the bounds of the instance centers.
+  GeoBox centerBounds = geo_box_inverted3();
+  u32    liveCount    = 0;
+  for (u32 i = 0; i != obj->instCount; ++i) {
+    if (!rend_object_inst_live(obj, i)) {
+      continue;
+    }
+    ++liveCount;
+    if (!geo_box_is_inverted3(&instAabbs[i])) {
+      centerBounds = geo_box_encapsulate(&centerBounds, geo_box_center(&instAabbs[i]));
+    }
+  }
+  if (geo_box_is_inverted3(&centerBounds)) {
+    centerBounds = (GeoBox){0}; // No bounded instances.
+  }
+
+  // Choose the grid size.
+  const f32 sizeX       = math_max(centerBounds.max.x - centerBounds.min.x, 1e-3f);
+  const f32 sizeZ       = math_max(centerBounds.max.z - centerBounds.min.z, 1e-3f);
+  const u32 cellsTarget = math_max(liveCount / rend_cull_cell_insts, 1);
+  const f32 cellSize    = math_sqrt_f32(sizeX * sizeZ / (f32)cellsTarget);
+  const u32 gridSizeX   = (u32)math_min(sizeX / cellSize, rend_cull_grid_size_max - 1) + 1;
+  const u32 gridSizeZ   = (u32)math_min(sizeZ / cellSize, rend_cull_grid_size_max - 1) + 1;
+
+  obj->cullGrid = (RendObjectGrid){
+      .originX      = centerBounds.min.x,
+      .originZ      = centerBounds.min.z,
+      .cellSizeInvX = (f32)gridSizeX / sizeX,
+      .cellSizeInvZ = (f32)gridSizeZ / sizeZ,
+      .sizeX        = gridSizeX,
+      .sizeZ        = gridSizeZ,
+  };
+  const RendObjectGrid* grid          = &obj->cullGrid;
+  const u32             gridCellCount = grid->sizeX * grid->sizeZ + 1; // +1 for unbounded insts.
+
+  // Count the instances per grid cell.
+  const usize gridCellsSize = sizeof(u32) * gridCellCount;
+  const usize instCellsSize = sizeof(u16) * obj->instCount;
+  if (gridCellsSize + instCellsSize > alloc_max_size(g_allocScratch)) {
+    return; // Too many instances to build the cells; instances are culled linearly.
+  }
+  u32* gridCells = alloc_array_t(g_allocScratch, u32, gridCellCount);
+  u16* instCells = alloc_array_t(g_allocScratch, u16, obj->instCount);
+  mem_set(mem_create(gridCells, gridCellsSize), 0);
+  for (u32 i = 0; i != obj->instCount; ++i) {
+    if (rend_object_inst_live(obj, i)) {
+      instCells[i] = (u16)rend_object_grid_cell(grid, &instAabbs[i]);
+      ++gridCells[instCells[i]];
+    }
+  }
+
+  // Create a cull cell for every non-empty grid cell; the grid then maps to the cull cell index.
+  buf_ensure(&obj->cullCellMem, gridCellCount * sizeof(RendObjectCell), alignof(RendObjectCell));
+  RendObjectCell* cells     = obj->cullCellMem.ptr;
+  u32             instCount = 0;
+  for (u32 gridCell = 0; gridCell != gridCellCount; ++gridCell) {
+    if (!gridCells[gridCell]) {
+      continue;
+    }
+    cells[obj->cullCellCount] = (RendObjectCell){
+        .bounds    = geo_box_inverted3(),
+        .tagsAll   = ~(SceneTags)0,
+        .instBegin = instCount,
+    };
+    instCount           += gridCells[gridCell];
+    gridCells[gridCell]  = obj->cullCellCount++;
+  }
+
+  // Store the instances in cell order, padded so instances can always be read in groups of four.
+  const u32 instCountPadded = (instCount + 3) & ~3u;
+  buf_ensure(&obj->cullInstMem, instCountPadded * sizeof(u32), alignof(u32));
+  buf_ensure(&obj->cullTagsMem, instCountPadded * sizeof(SceneTags), alignof(SceneTags));
+  buf_ensure(&obj->cullAabbMem, instCountPadded * sizeof(GeoBox), alignof(GeoBox));
+  buf_ensure(
+      &obj->cullSlotMem,
+      obj->instCount * sizeof(RendObjectCullSlot),
+      alignof(RendObjectCullSlot));
+
+  u32*                cullInsts = obj->cullInstMem.ptr;
+  SceneTags*          cullTags  = obj->cullTagsMem.ptr;
+  GeoBox*             cullAabbs = obj->cullAabbMem.ptr;
+  RendObjectCullSlot* cullSlots = obj->cullSlotMem.ptr;
+  for (u32 i = 0; i != obj->instCount; ++i) {
+    if (!rend_object_inst_live(obj, i)) {
+      continue;
+    }
+    *rend_object_slot_state(obj, i) &= ~RendSlotState_Stale;
+
+    RendObjectCell* cell = &cells[gridCells[instCells[i]]];
+    const u32       out  = cell->instBegin + cell->instCount++;
+
+    cullSlots[i] = (RendObjectCullSlot){
+        .index    = out,
+        .cell     = (u16)gridCells[instCells[i]],
+        .gridCell = instCells[i],
+    };
+    cullInsts[out]  = i;
+    cullTags[out]   = instTags[i];
+    cullAabbs[out]  = instAabbs[i];
+    cell->bounds    = geo_box_encapsulate_box(&cell->bounds, &instAabbs[i]);
+    cell->tagsAny  |= instTags[i];
+    cell->tagsAll  &= instTags[i];
+  }
+  for (u32 i = instCount; i != instCountPadded; ++i) {
+    cullInsts[i] = 0;
+    cullTags[i]  = 0;
+    cullAabbs[i] = geo_box_inverted3();
+  }
+}
+
+/**
+ * Update the cull data of the slots whose filter changed since the cells were last updated.
+ * NOTE: Cells are only grown to include the new bounds and tags; instances that moved to another
+ * grid cell make the culling less effective until the cells are rebuilt.
+ */
+static void rend_object_cull_refresh(RendObjectComp* obj) {
+  obj->cullStale = false;
+  if (!obj->cullCellCount) {
+    return; // Instances are culled linearly.
+  }
+  const SceneTags*    instTags      = obj->instTagsMem.ptr;
+  const GeoBox*       instAabbs     = obj->instAabbMem.ptr;
+  SceneTags*          cullTags      = obj->cullTagsMem.ptr;
+  GeoBox*             cullAabbs     = obj->cullAabbMem.ptr;
+  RendObjectCullSlot* cullSlots     = obj->cullSlotMem.ptr;
+  RendObjectCell*     cells         = obj->cullCellMem.ptr;
+  const u32           gridUnbounded = obj->cullGrid.sizeX * obj->cullGrid.sizeZ;
+
+  for (u32 i = 0; i != obj->instCount; ++i) {
+    u8* state = rend_object_slot_state(obj, i);
+    if (!(*state & RendSlotState_Stale)) {
+      continue;
+    }
+    *state &= ~RendSlotState_Stale;
+
+    RendObjectCullSlot* slot     = &cullSlots[i];
+    const u32           gridCell = rend_object_grid_cell(&obj->cullGrid, &instAabbs[i]);
+    if (gridCell != slot->gridCell) {
+      if (gridCell == gridUnbounded || slot->gridCell == gridUnbounded) {
+        rend_object_cull_build(obj); // Unbounded instances are not frustum culled; re-bin.
+        return;
+      }
+      slot->gridCell = (u16)gridCell;
+      if (++obj->cullDisplaced > obj->instCount / rend_cull_displaced_frac) {
+        rend_object_cull_build(obj);
+        return;
+      }
+    }
+    RendObjectCell* cell = &cells[slot->cell];
+
+    cullTags[slot->index]  = instTags[i];
+    cullAabbs[slot->index] = instAabbs[i];
+    cell->bounds           = geo_box_encapsulate_box(&cell->bounds, &instAabbs[i]);
+    cell->tagsAny         |= instTags[i];
+    cell->tagsAll         &= instTags[i];
+  }
+}
+
 static bool rend_resource_asset_valid(EcsWorld* world, const EcsEntityId assetEntity) {
   return ecs_world_exists(world, assetEntity) && ecs_world_has_t(world, assetEntity, AssetComp);
 }
@@ -152,12 +456,26 @@ ecs_system_define(RendClearObjectsSys) {
   EcsView* objView = ecs_world_view_t(world, ObjectWriteView);
   for (EcsIterator* itr = ecs_view_itr(objView); ecs_view_walk(itr);) {
     RendObjectComp* obj = ecs_view_write_t(itr, RendObjectComp);
-    if (!(obj->flags & RendObjectFlags_NoAutoClear)) {
+    if (obj->flags & RendObjectFlags_Persistent) {
+      rend_object_slot_sweep(obj);
+    } else if (!(obj->flags & RendObjectFlags_NoAutoClear)) {
       rend_object_clear(obj);
     }
   }
 }
 
+ecs_system_define(RendObjectCullBuildSys) {
+  EcsView* objView = ecs_world_view_t(world, ObjectWriteView);
+  for (EcsIterator* itr = ecs_view_itr_step(objView, parCount, parIndex); ecs_view_walk(itr);) {
+    RendObjectComp* obj = ecs_view_write_t(itr, RendObjectComp);
+    if (obj->cullDirty) {
+      rend_object_cull_build(obj);
+    } else if (obj->cullStale) {
+      rend_object_cull_refresh(obj);
+    }
+  }
+}
+
 ecs_system_define(RendObjectResourceRequestSys) {
   if (rend_will_reset(world)) {
     return;
@@ -191,11 +509,14 @@ ecs_module_init(rend_object_module) {
   ecs_register_view(ObjectWriteView);
 
   ecs_register_system(RendClearObjectsSys, ecs_view_id(ObjectWriteView));
+  ecs_register_system(RendObjectCullBuildSys, ecs_view_id(ObjectWriteView));
   ecs_register_system(
       RendObjectResourceRequestSys, ecs_view_id(ObjectReadView), ecs_view_id(ResourceView));
 
   ecs_order(RendClearObjectsSys, RendOrder_ObjectClear);
   ecs_order(RendObjectResourceRequestSys, RendOrder_ObjectUpdate + 10);
+  ecs_order(RendObjectCullBuildSys, RendOrder_Draw - 1);
+  ecs_parallel(RendObjectCullBuildSys, g_jobsWorkerCount);
 }
 
 RendObjectComp*
@@ -203,6 +524,8 @@ rend_object_create(EcsWorld* world, const EcsEntityId entity, const RendObjectFl
   MAYBE_UNUSED const bool noFiltering = (flags & RendObjectFlags_NoInstanceFiltering) != 0;
   MAYBE_UNUSED const bool isSorted    = (flags & RendObjectFlags_Sorted) != 0;
   diag_assert_msg(noFiltering ? !isSorted : true, "NoInstanceFiltering incompatible with sorting");
+  MAYBE_UNUSED const bool persistent = (flags & RendObjectFlags_Persistent) != 0;
+  diag_assert_msg(persistent ? !noFiltering : true, "Persistent objects require filtering");
 
   return ecs_world_add_t(
       world, entity, RendObjectComp, .flags = flags, .alphaTexIndex = sentinel_u8);
@@ -220,18 +543,6 @@ u32       rend_object_data_inst_size(const RendObjectComp* obj) { return obj->in
 SceneTags rend_object_tag_mask(const RendObjectComp* obj) { return obj->tagMask; }
 u8        rend_object_alpha_tex_index(const RendObjectComp* obj) { return obj->alphaTexIndex; }
 
-static i8 rend_object_compare_back_to_front(const void* a, const void* b) {
-  const u16 distA = *field_ptr(a, RendObjectSortKey, viewDist);
-  const u16 distB = *field_ptr(b, RendObjectSortKey, viewDist);
-  return distA > distB ? -1 : distA < distB ? 1 : 0;
-}
-
-static i8 rend_object_compare_front_to_back(const void* a, const void* b) {
-  const u16 distA = *field_ptr(a, RendObjectSortKey, viewDist);
-  const u16 distB = *field_ptr(b, RendObjectSortKey, viewDist);
-  return distA < distB ? -1 : distA > distB ? 1 : 0;
-}
-
 static void rend_object_sort(const RendObjectComp* obj, RendObjectSortKey* keys, const u32 count) {
 #ifdef VOLO_TRACE
   const bool trace = count > 1000;
@@ -240,15 +551,18 @@ static void rend_object_sort(const RendObjectComp* obj, RendObjectSortKey* keys,
   }
 #endif
 
-  CompareFunc compareFunc;
+  SortRadixFlags sortFlags;
   if (obj->flags & RendObjectFlags_SortBackToFront) {
-    compareFunc = rend_object_compare_back_to_front;
+    sortFlags = SortRadixFlags_Descending;
   } else if (obj->flags & RendObjectFlags_SortFrontToBack) {
-    compareFunc = rend_object_compare_front_to_back;
+    sortFlags = SortRadixFlags_None;
   } else {
     diag_crash_msg("Unsupported sort mode");
   }
-  sort_quicksort_t(keys, keys + count, RendObjectSortKey, compareFunc);
+  // NOTE: Scratch is at most as big as the keys array which already fits in the scratch allocator.
+  const Mem scratch = alloc_alloc(
+      g_allocScratch, sizeof(RendObjectSortKey) * count, alignof(RendObjectSortKey));
+  sort_radix_u16_t(keys, keys + count, RendObjectSortKey, viewDist, sortFlags, scratch);
 
 #ifdef VOLO_TRACE
   if (trace) {
@@ -303,6 +617,94 @@ NO_INLINE_HINT static void rend_instances_push_sorted(
   }
 }
 
+typedef struct {
+  const RendView*    view;
+  RendObjectSortKey* sortKeys; // Null if not sorted.
+  BitSet             filter;   // Empty if sorted.
+  u32                count;
+} RendObjectCullOutput;
+
+INLINE_HINT static void rend_object_cull_accept(
+    RendObjectCullOutput* out, const u32 instIndex, const GeoBox* instAabb) {
+  const u32 outputIndex = out->count++;
+  if (out->sortKeys) {
+    out->sortKeys[outputIndex] = (RendObjectSortKey){
+        .instIndex = (u16)instIndex,
+        .viewDist  = rend_view_sort_dist(out->view, instAabb),
+    };
+  } else {
+    bitset_set(out->filter, instIndex);
+  }
+}
+
+static void rend_object_cull_linear(
+    const RendObjectComp*   obj,
+    const RendView*         view,
+    const RendSettingsComp* settings,
+    RendObjectCullOutput*   out) {
+  const SceneTags* instTags  = obj->instTagsMem.ptr;
+  const GeoBox*    instAabbs = obj->instAabbMem.ptr;
+
+  u32 i = 0;
+  if (!(obj->flags & RendObjectFlags_Persistent)) {
+    // All instances are live; test them in groups of four.
+    for (; i + 4 <= obj->instCount; i += 4) {
+      u32 visibleMask = rend_view_visible_x4(view, &instTags[i], &instAabbs[i], settings);
+      for (; visibleMask; visibleMask &= visibleMask - 1) {
+        const u32 j = i + bits_ctz_32(visibleMask);
+        rend_object_cull_accept(out, j, &instAabbs[j]);
+      }
+    }
+  }
+  for (; i != obj->instCount; ++i) {
+    if (obj->flags & RendObjectFlags_Persistent && !rend_object_inst_live(obj, i)) {
+      continue; // Unused slot.
+    }
+    if (rend_view_visible(view, instTags[i], &instAabbs[i], settings)) {
+      rend_object_cull_accept(out, i, &instAabbs[i]);
+    }
+  }
+}
+
+/**
+ * Cull the instances per cell, only instances in partially visible cells are tested individually.
+ */
+static void rend_object_cull_cells(
+    const RendObjectComp*   obj,
+    const RendView*         view,
+    const RendSettingsComp* settings,
+    RendObjectCullOutput*   out) {
+  const u32*       cullInsts = obj->cullInstMem.ptr;
+  const SceneTags* cullTags  = obj->cullTagsMem.ptr;
+  const GeoBox*    cullAabbs = obj->cullAabbMem.ptr;
+
+  const RendObjectCell* cells = obj->cullCellMem.ptr;
+  for (u32 c = 0; c != obj->cullCellCount; ++c) {
+    const RendObjectCell* cell = &cells[c];
+    const u32             end  = cell->instBegin + cell->instCount;
+    switch (rend_view_visible_group(view, cell->tagsAny, cell->tagsAll, &cell->bounds, settings)) {
+    case RendViewVisibility_None:
+      break;
+    case RendViewVisibility_Full:
+      for (u32 i = cell->instBegin; i != end; ++i) {
+        rend_object_cull_accept(out, cullInsts[i], &cullAabbs[i]);
+      }
+      break;
+    case RendViewVisibility_Partial:
+      for (u32 i = cell->instBegin; i < end; i += 4) {
+        // NOTE: Instances are padded to a multiple of four; mask out the instances past the cell.
+        const u32 validMask = end - i >= 4 ? 0b1111 : ((1u << (end - i)) - 1);
+        u32 visibleMask = rend_view_visible_x4(view, &cullTags[i], &cullAabbs[i], settings);
+        for (visibleMask &= validMask; visibleMask; visibleMask &= visibleMask - 1) {
+          const u32 j = i + bits_ctz_32(visibleMask);
+          rend_object_cull_accept(out, cullInsts[j], &cullAabbs[j]);
+        }
+      }
+      break;
+    }
+  }
+}
+
 void rend_object_draw(
     const RendObjectComp*   obj,
     const RendView*         view,
@@ -346,23 +748,13 @@ void rend_object_draw(
     bitset_clear_all(filter);
   }
 
-  u32 filteredInstCount = 0;
-  for (u32 i = 0; i != obj->instCount; ++i) {
-    const SceneTags instTags = ((SceneTags*)obj->instTagsMem.ptr)[i];
-    const GeoBox*   instAabb = &((GeoBox*)obj->instAabbMem.ptr)[i];
-    if (!rend_view_visible(view, instTags, instAabb, settings)) {
-      continue;
-    }
-    const u32 outputIndex = filteredInstCount++;
-    if (sortKeys) {
-      sortKeys[outputIndex] = (RendObjectSortKey){
-          .instIndex = (u16)i,
-          .viewDist  = rend_view_sort_dist(view, instAabb),
-      };
-    } else {
-      bitset_set(filter, i);
-    }
+  RendObjectCullOutput out = {.view = view, .sortKeys = sortKeys, .filter = filter};
+  if (obj->cullCellCount && !obj->cullDirty && !obj->cullStale) {
+    rend_object_cull_cells(obj, view, settings, &out);
+  } else {
+    rend_object_cull_linear(obj, view, settings, &out);
   }
+  const u32 filteredInstCount = out.count;
 
   if (filteredInstCount) {
     if (sortKeys) {
@@ -391,9 +783,11 @@ void rend_object_set_alpha_tex_index(RendObjectComp* obj, const u8 alphaTexIndex
 }
 
 void rend_object_clear(RendObjectComp* obj) {
-  obj->instCount    = 0;
-  obj->instDataSize = 0;
-  obj->tagMask      = 0;
+  obj->cullDirty     = true;
+  obj->instCount     = 0;
+  obj->instDataSize  = 0;
+  obj->tagMask       = 0;
+  obj->slotFreeCount = 0;
 }
 
 Mem rend_object_set_data(RendObjectComp* obj, const usize size) {
@@ -415,6 +809,7 @@ Mem rend_object_add_instance(
    */
 
   const u32 instIndex = obj->instCount++;
+  obj->cullDirty      = true;
   buf_ensure(&obj->instDataMem, obj->instCount * obj->instDataSize, rend_min_align);
 
   obj->tagMask |= tags;
@@ -429,3 +824,61 @@ Mem rend_object_add_instance(
 
   return rend_object_inst_data(obj, instIndex);
 }
+
+u32 rend_object_slot_alloc(RendObjectComp* obj, const EcsEntityId owner, const usize size) {
+  diag_assert(obj->flags & RendObjectFlags_Persistent);
+  diag_assert(ecs_entity_valid(owner));
+
+  u32 slot;
+  if (obj->slotFreeCount) {
+    slot = ((u32*)obj->slotFreeMem.ptr)[--obj->slotFreeCount];
+    diag_assert(obj->instDataSize >= size);
+  } else {
+    slot = obj->instCount;
+    rend_object_add_instance(obj, size, 0, geo_box_inverted3());
+    buf_ensure(&obj->slotStateMem, obj->instCount, 1);
+    buf_ensure(&obj->slotOwnerMem, obj->instCount * sizeof(EcsEntityId), alignof(EcsEntityId));
+  }
+  obj->cullDirty                              = true;
+  *rend_object_slot_state(obj, slot)          = RendSlotState_Live | RendSlotState_Marked;
+  ((EcsEntityId*)obj->slotOwnerMem.ptr)[slot] = owner;
+  mem_set(rend_object_inst_data(obj, slot), 0);
+  return slot;
+}
+
+bool rend_object_slot_valid(const RendObjectComp* obj, const u32 slot, const EcsEntityId owner) {
+  if (slot >= obj->instCount) {
+    return false;
+  }
+  return ((const EcsEntityId*)obj->slotOwnerMem.ptr)[slot] == owner;
+}
+
+Mem rend_object_slot_data(RendObjectComp* obj, const u32 slot) {
+  diag_assert(slot < obj->instCount);
+  return rend_object_inst_data(obj, slot);
+}
+
+void rend_object_slot_set_filter(
+    RendObjectComp* obj, const u32 slot, const SceneTags tags, const GeoBox aabb) {
+  diag_assert(slot < obj->instCount);
+  SceneTags* slotTags = (SceneTags*)obj->instTagsMem.ptr + slot;
+  GeoBox*    slotAabb = (GeoBox*)obj->instAabbMem.ptr + slot;
+  if (*slotTags == tags && mem_eq(mem_create(slotAabb, sizeof(GeoBox)), mem_var(aabb))) {
+    return; // Filter unchanged; for example only the instance data (color etc.) was updated.
+  }
+  *slotTags = tags;
+  *slotAabb = aabb;
+  const SceneTags tagMask = (SceneTags)thread_atomic_load_i32((i32*)&obj->tagMask);
+  if (UNLIKELY(tags & ~tagMask)) {
+    rend_object_slot_tag_mask_add(obj, tags); // NOTE: Slots are updated in parallel.
+  }
+  *rend_object_slot_state(obj, slot) |= RendSlotState_Stale;
+  if (!thread_atomic_load_i32(&obj->cullStale)) {
+    thread_atomic_store_i32(&obj->cullStale, true); // NOTE: Slots are updated in parallel.
+  }
+}
+
+void rend_object_slot_mark(RendObjectComp* obj, const u32 slot) {
+  diag_assert(slot < obj->instCount);
+  *rend_object_slot_state(obj, slot) |= RendSlotState_Marked;
+}
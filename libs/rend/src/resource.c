@@ -314,6 +314,7 @@ static bool rend_res_asset_wait(EcsWorld* world, EcsIterator* resourceItr) {
     return false;
   }
   if (!ecs_world_has_t(world, entity, AssetLoadedComp)) {
+    asset_priority_hint(world, entity, AssetPriority_High); // Needed for rendering.
     return false;
   }
   if (ecs_world_has_t(world, entity, AssetChangedComp)) {
@@ -705,6 +706,39 @@ ecs_system_define(RendResUnloadChangedSys) {
   }
 }
 
+ecs_view_define(TextureDirtyView) {
+  ecs_access_read(AssetTextureComp);
+  ecs_access_read(AssetTextureDirtyComp);
+  ecs_access_maybe_write(RendResTextureComp); // Write to avoid racing with the painters.
+  ecs_access_without(RendResUnloadComp);
+}
+
+/**
+ * Upload the modified regions of textures that are already created.
+ * NOTE: Textures that are not created yet will use the latest pixel data when they are created.
+ */
+ecs_system_define(RendResTextureDirtySys) {
+  const RendPlatformComp* plat = rend_res_platform(world);
+  if (!plat) {
+    return;
+  }
+  EcsView* dirtyView = ecs_world_view_t(world, TextureDirtyView);
+  for (EcsIterator* itr = ecs_view_itr(dirtyView); ecs_view_walk(itr);) {
+    const AssetTextureDirtyComp* dirty = ecs_view_read_t(itr, AssetTextureDirtyComp);
+    RendResTextureComp*          res   = ecs_view_write_t(itr, RendResTextureComp);
+    if (res) {
+      /**
+       * NOTE: Mutating the texture is safe as we have write access to the resource component.
+       */
+      RvkTexture*             texture = (RvkTexture*)res->texture;
+      const AssetTextureComp* asset   = ecs_view_read_t(itr, AssetTextureComp);
+      rvk_texture_update(
+          texture, plat->device, asset, dirty->x, dirty->y, dirty->width, dirty->height);
+    }
+    ecs_world_remove_t(world, ecs_view_entity(itr), AssetTextureDirtyComp);
+  }
+}
+
 ecs_view_define(UnloadUpdateView) {
   ecs_access_read(RendResComp);
   ecs_access_read(AssetComp);
@@ -816,6 +850,9 @@ ecs_module_init(rend_resource_module) {
   ecs_register_system(RendResUnloadUnusedSys, ecs_register_view(ResUnloadUnusedView));
   ecs_register_system(RendResUnloadChangedSys, ecs_register_view(UnloadChangedView));
 
+  ecs_register_system(
+      RendResTextureDirtySys, ecs_view_id(PlatReadView), ecs_register_view(TextureDirtyView));
+
   ecs_register_system(
       RendResUnloadUpdateSys,
       ecs_view_id(PlatReadView),
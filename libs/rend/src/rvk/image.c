@@ -546,6 +546,8 @@ void rvk_image_assert_phase(const RvkImage* img, const RvkImagePhase phase) {
 
 void rvk_image_freeze(RvkImage* img) { img->frozen = true; }
 
+void rvk_image_thaw(RvkImage* img) { img->frozen = false; }
+
 void rvk_image_transition(
     RvkDevice* dev, RvkImage* img, const RvkImagePhase phase, VkCommandBuffer vkCmdBuf) {
   if (img->phase == phase) {
@@ -79,6 +79,7 @@ RvkDescKind rvk_image_sampler_kind(const RvkImage*);
 void rvk_image_assert_phase(const RvkImage*, RvkImagePhase);
 
 void rvk_image_freeze(RvkImage*);
+void rvk_image_thaw(RvkImage*); // Allow modifying a frozen image, should be re-frozen afterwards.
 
 typedef struct {
   RvkImage*     img;
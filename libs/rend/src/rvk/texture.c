@@ -1,3 +1,4 @@
+#include "core/alloc.h"
 #include "core/diag.h"
 #include "log/logger.h"
 
@@ -35,6 +36,10 @@ static VkFormat rvk_texture_format(const AssetTextureComp* asset) {
     return srgb ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
   case AssetTextureFormat_Bc4:
     return VK_FORMAT_BC4_UNORM_BLOCK;
+  case AssetTextureFormat_Bc5:
+    return VK_FORMAT_BC5_UNORM_BLOCK;
+  case AssetTextureFormat_Bc7:
+    return srgb ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
   case AssetTextureFormat_Count:
     UNREACHABLE
   }
@@ -111,6 +116,35 @@ RvkDescKind rvk_texture_sampler_kind(const RvkTexture* texture) {
   return rvk_image_sampler_kind(&texture->image);
 }
 
+void rvk_texture_update(
+    RvkTexture*             texture,
+    RvkDevice*              dev,
+    const AssetTextureComp* asset,
+    const u32               x,
+    const u32               y,
+    const u32               width,
+    const u32               height) {
+  diag_assert(asset->width == texture->image.size.width);
+  diag_assert(asset->height == texture->image.size.height);
+
+  const u32 pixelSize = vkFormatByteSize(texture->image.vkFormat);
+  const Mem src       = asset_texture_data(asset);
+  const Mem region    = alloc_alloc(g_allocHeap, (usize)width * height * pixelSize, pixelSize);
+
+  // Gather the rows of the region into a tightly packed buffer.
+  const usize srcStride = (usize)asset->width * pixelSize;
+  const usize rowSize   = (usize)width * pixelSize;
+  for (u32 row = 0; row != height; ++row) {
+    const usize srcOffset = (y + row) * srcStride + (usize)x * pixelSize;
+    mem_cpy(mem_slice(region, row * rowSize, rowSize), mem_slice(src, srcOffset, rowSize));
+  }
+
+  const RvkSize size = rvk_size(width, height);
+  rvk_transfer_image_region(dev->transferer, &texture->image, region, x, y, size);
+
+  alloc_free(g_allocHeap, region);
+}
+
 bool rvk_texture_is_ready(const RvkTexture* texture, const RvkDevice* dev) {
   if (!rvk_transfer_poll(dev->transferer, texture->pixelTransfer)) {
     return false;
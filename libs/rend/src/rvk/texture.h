@@ -15,3 +15,10 @@ RvkTexture* rvk_texture_create(RvkDevice*, const AssetTextureComp*, String dbgNa
 void        rvk_texture_destroy(RvkTexture*, RvkDevice*);
 RvkDescKind rvk_texture_sampler_kind(const RvkTexture*);
 bool        rvk_texture_is_ready(const RvkTexture*, const RvkDevice*);
+
+/**
+ * Upload a modified region of the asset's (mip 0) pixel data.
+ * Pre-condition: Texture is uncompressed and has a single layer and mip level.
+ */
+void rvk_texture_update(
+    RvkTexture*, RvkDevice*, const AssetTextureComp*, u32 x, u32 y, u32 width, u32 height);
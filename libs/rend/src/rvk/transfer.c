@@ -429,6 +429,80 @@ rvk_transfer_image(RvkTransferer* trans, RvkImage* dest, const Mem data, const u
   return id;
 }
 
+RvkTransferId rvk_transfer_image_region(
+    RvkTransferer* trans,
+    RvkImage*      dest,
+    const Mem      data,
+    const u32      x,
+    const u32      y,
+    const RvkSize  size) {
+  diag_assert(!vkFormatCompressed4x4(dest->vkFormat));
+  diag_assert(dest->layers == 1 && dest->mipLevels == 1);
+  diag_assert(x + size.width <= dest->size.width && y + size.height <= dest->size.height);
+  diag_assert(data.size == (usize)size.width * size.height * vkFormatByteSize(dest->vkFormat));
+
+  thread_mutex_lock(trans->mutex);
+
+  u64 reqAlign = vkFormatByteSize(dest->vkFormat);
+  reqAlign = math_max(reqAlign, trans->dev->vkProperties.limits.optimalBufferCopyOffsetAlignment);
+  reqAlign = math_max(reqAlign, 4 /* Minimum requirement for transfer queue */);
+
+  RvkTransferBuffer* buffer = rvk_transfer_get(trans, data.size, reqAlign);
+  if (buffer->state == RvkTransferState_Idle) {
+    rvk_transfer_begin(trans, buffer);
+  }
+  buffer->offset = bits_align(buffer->offset, reqAlign);
+  rvk_buffer_upload(&buffer->hostBuffer, data, buffer->offset);
+
+  /**
+   * The image is already in use by the graphics queue; record the copy on the graphics command
+   * buffer (instead of the dedicated transfer queue) so the barriers order it with prior reads
+   * without needing a queue ownership transfer.
+   */
+  rvk_image_thaw(dest);
+  rvk_image_transition(trans->dev, dest, RvkImagePhase_TransferDest, buffer->vkCmdBufferGraphics);
+
+  const VkBufferImageCopy regions[] = {
+      {
+          .bufferOffset                = buffer->offset,
+          .imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+          .imageSubresource.layerCount = 1,
+          .imageOffset.x               = (i32)x,
+          .imageOffset.y               = (i32)y,
+          .imageExtent.width           = size.width,
+          .imageExtent.height          = size.height,
+          .imageExtent.depth           = 1,
+      },
+  };
+  rvk_call(
+      trans->dev,
+      cmdCopyBufferToImage,
+      buffer->vkCmdBufferGraphics,
+      buffer->hostBuffer.vkBuffer,
+      dest->vkImage,
+      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+      array_elems(regions),
+      regions);
+
+  rvk_image_transition(trans->dev, dest, RvkImagePhase_ShaderRead, buffer->vkCmdBufferGraphics);
+  rvk_image_freeze(dest);
+
+  buffer->offset += data.size;
+  const RvkTransferId id = rvk_transfer_id(trans, buffer);
+
+#if defined(VOLO_RVK_TRANSFER_LOGGING)
+  log_d(
+      "Vulkan transfer queued",
+      log_param("id", fmt_int(id)),
+      log_param("buffer-idx", fmt_int(rvk_transfer_index(id))),
+      log_param("type", fmt_text_lit("image-region")),
+      log_param("size", fmt_size(data.size)));
+#endif
+
+  thread_mutex_unlock(trans->mutex);
+  return id;
+}
+
 RvkTransferStatus rvk_transfer_poll(const RvkTransferer* trans, const RvkTransferId id) {
   thread_mutex_lock(trans->mutex);
 
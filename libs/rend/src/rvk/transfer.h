@@ -1,5 +1,6 @@
 #pragma once
 #include "forward.h"
+#include "types.h"
 #include "vulkan_api.h"
 
 /**
@@ -21,5 +22,12 @@ void           rvk_transferer_destroy(RvkTransferer*);
 RvkTransferId rvk_transfer_buffer(RvkTransferer*, RvkBuffer* dest, Mem data);
 RvkTransferId rvk_transfer_image(RvkTransferer*, RvkImage* dest, Mem data, u32 mips);
 
+/**
+ * Update a region of mip 0 of an image that was previously transferred.
+ * NOTE: Data is the tightly packed pixel data of the region.
+ */
+RvkTransferId
+rvk_transfer_image_region(RvkTransferer*, RvkImage* dest, Mem data, u32 x, u32 y, RvkSize size);
+
 RvkTransferStatus rvk_transfer_poll(const RvkTransferer*, RvkTransferId);
 void              rvk_transfer_flush(RvkTransferer*); // Executes a queueSubmit.
@@ -57,3 +57,45 @@ bool rend_view_visible(
   }
   return geo_box_overlap_frustum4_approx(objAabb, view->frustum);
 }
+
+u32 rend_view_visible_x4(
+    const RendView*         view,
+    const SceneTags         objTags[4],
+    const GeoBox            objAabbs[4],
+    const RendSettingsComp* settings) {
+
+  u32 result = 0;
+  for (u32 i = 0; i != 4; ++i) {
+    result |= rend_view_tag_filter(view->filter, objTags[i]) ? (1 << i) : 0;
+  }
+  if (!result || UNLIKELY(!(settings->flags & RendFlags_FrustumCulling))) {
+    return result;
+  }
+  return result & geo_box_overlap_frustum4_approx_x4(objAabbs, view->frustum);
+}
+
+RendViewVisibility rend_view_visible_group(
+    const RendView*         view,
+    const SceneTags         tagsAny,
+    const SceneTags         tagsAll,
+    const GeoBox*           groupAabb,
+    const RendSettingsComp* settings) {
+
+  const SceneTagFilter filter = view->filter;
+  if ((tagsAny & filter.required) != filter.required || (tagsAll & filter.illegal) != 0) {
+    return RendViewVisibility_None; // None of the objects pass the tag filter.
+  }
+  const bool tagsPassAll = ((tagsAll & filter.required) == filter.required) &&
+                           ((tagsAny & filter.illegal) == 0);
+
+  if (UNLIKELY(!(settings->flags & RendFlags_FrustumCulling))) {
+    return tagsPassAll ? RendViewVisibility_Full : RendViewVisibility_Partial;
+  }
+  if (!geo_box_overlap_frustum4_approx(groupAabb, view->frustum)) {
+    return RendViewVisibility_None;
+  }
+  if (tagsPassAll && geo_box_contained_frustum4(groupAabb, view->frustum)) {
+    return RendViewVisibility_Full;
+  }
+  return RendViewVisibility_Partial;
+}
@@ -4,6 +4,12 @@
 #include "rend/settings.h"
 #include "scene/tag.h"
 
+typedef enum {
+  RendViewVisibility_None,    // None of the objects are visible.
+  RendViewVisibility_Partial, // Objects have to be tested individually.
+  RendViewVisibility_Full,    // All objects are visible.
+} RendViewVisibility;
+
 typedef struct sRendView {
   EcsEntityId    camera;
   GeoVector      origin;
@@ -30,3 +36,25 @@ u16 rend_view_sort_dist(const RendView*, const GeoBox* objAabb);
  */
 bool rend_view_visible(
     const RendView*, SceneTags objTags, const GeoBox* objAabb, const RendSettingsComp*);
+
+/**
+ * Check if four objects are visible in the view.
+ * Returns a mask with a bit set for every visible object (bit 0 for the first object).
+ */
+u32 rend_view_visible_x4(
+    const RendView*,
+    const SceneTags objTags[PARAM_ARRAY_SIZE(4)],
+    const GeoBox    objAabbs[PARAM_ARRAY_SIZE(4)],
+    const RendSettingsComp*);
+
+/**
+ * Check if a group of objects is visible in the view.
+ * NOTE: 'tagsAny' is the union and 'tagsAll' the intersection of the tags of the objects.
+ * NOTE: 'groupAabb' has to encapsulate the bounds of all the objects.
+ */
+RendViewVisibility rend_view_visible_group(
+    const RendView*,
+    SceneTags     tagsAny,
+    SceneTags     tagsAll,
+    const GeoBox* groupAabb,
+    const RendSettingsComp*);
@@ -0,0 +1,5 @@
+#include "app/check.h"
+
+void app_check_init(CheckDef* check) { register_spec(check, view); }
+
+void app_check_teardown(void) {}
@@ -0,0 +1,140 @@
+#include "check/spec.h"
+#include "core/array.h"
+#include "rend/settings.h"
+
+#include "view.h"
+
+/**
+ * View with a partial frustum that contains the box from (-1, -1) to (1, 1) on the xy plane.
+ */
+static RendView test_view_create(const SceneTagFilter filter) {
+  return (RendView){
+      .filter = filter,
+      .frustum =
+          {
+              {.normal = geo_right, .distance = -1.0f},
+              {.normal = geo_left, .distance = -1.0f},
+              {.normal = geo_down, .distance = -1.0f},
+              {.normal = geo_up, .distance = -1.0f},
+          },
+  };
+}
+
+spec(view) {
+
+  static const SceneTagFilter g_filterUnit = {
+      .required = SceneTags_Unit,
+      .illegal  = SceneTags_Debug,
+  };
+
+  RendSettingsComp settings;
+
+  setup() { settings = (RendSettingsComp){.flags = RendFlags_FrustumCulling}; }
+
+  it("rejects groups where none of the objects pass the tag filter") {
+    const RendView view   = test_view_create(g_filterUnit);
+    const GeoBox   inside = geo_box_from_sphere(geo_vector(0, 0, 0), 0.5f);
+
+    // None of the objects have the required tag.
+    const SceneTags anyMissing = SceneTags_Geometry | SceneTags_Emit;
+    check_eq_int(
+        rend_view_visible_group(&view, anyMissing, SceneTags_Geometry, &inside, &settings),
+        RendViewVisibility_None);
+
+    // All of the objects have an illegal tag.
+    const SceneTags allIllegal = SceneTags_Unit | SceneTags_Debug;
+    check_eq_int(
+        rend_view_visible_group(&view, allIllegal, allIllegal, &inside, &settings),
+        RendViewVisibility_None);
+  }
+
+  it("requires individual tests when only some of the objects pass the tag filter") {
+    const RendView view   = test_view_create(g_filterUnit);
+    const GeoBox   inside = geo_box_from_sphere(geo_vector(0, 0, 0), 0.5f);
+
+    // Only some of the objects have the required tag.
+    const SceneTags someRequired = SceneTags_Unit | SceneTags_Geometry;
+    check_eq_int(
+        rend_view_visible_group(&view, someRequired, SceneTags_Geometry, &inside, &settings),
+        RendViewVisibility_Partial);
+
+    // Only some of the objects have an illegal tag.
+    const SceneTags someIllegal = SceneTags_Unit | SceneTags_Debug;
+    check_eq_int(
+        rend_view_visible_group(&view, someIllegal, SceneTags_Unit, &inside, &settings),
+        RendViewVisibility_Partial);
+  }
+
+  it("accepts groups where all of the objects pass the tag filter and are inside the frustum") {
+    const RendView  view   = test_view_create(g_filterUnit);
+    const GeoBox    inside = geo_box_from_sphere(geo_vector(0, 0, 0), 0.5f);
+    const SceneTags tags   = SceneTags_Unit | SceneTags_Geometry;
+
+    check_eq_int(
+        rend_view_visible_group(&view, tags, tags, &inside, &settings), RendViewVisibility_Full);
+  }
+
+  it("culls groups against the frustum") {
+    const RendView  view = test_view_create(g_filterUnit);
+    const SceneTags tags = SceneTags_Unit;
+
+    const GeoBox outside = geo_box_from_sphere(geo_vector(3, 0, 0), 0.5f);
+    check_eq_int(
+        rend_view_visible_group(&view, tags, tags, &outside, &settings), RendViewVisibility_None);
+
+    const GeoBox onEdge = geo_box_from_sphere(geo_vector(1, 0, 0), 0.5f);
+    check_eq_int(
+        rend_view_visible_group(&view, tags, tags, &onEdge, &settings),
+        RendViewVisibility_Partial);
+
+    settings.flags &= ~RendFlags_FrustumCulling;
+    check_eq_int(
+        rend_view_visible_group(&view, tags, tags, &outside, &settings), RendViewVisibility_Full);
+  }
+
+  it("is consistent with the visibility of the individual objects") {
+    static const SceneTags g_tags[] = {
+        SceneTags_Unit,
+        SceneTags_Unit | SceneTags_Geometry,
+        SceneTags_Unit | SceneTags_Debug,
+        SceneTags_Geometry,
+    };
+    static const GeoVector g_positions[] = {
+        {0, 0, 0},
+        {0.5f, -0.5f, 0},
+        {1, 0, 0},
+        {3, 0, 0},
+    };
+    const RendView view     = test_view_create(g_filterUnit);
+    const u32      tagCount = array_elems(g_tags);
+    const u32      objCount = tagCount * array_elems(g_positions);
+
+    // Test every group of two objects with any combination of tags and positions.
+    for (u32 a = 0; a != objCount; ++a) {
+      for (u32 b = 0; b != objCount; ++b) {
+        const SceneTags tags[]  = {g_tags[a % tagCount], g_tags[b % tagCount]};
+        const GeoBox    aabbs[] = {
+            geo_box_from_sphere(g_positions[a / tagCount], 0.25f),
+            geo_box_from_sphere(g_positions[b / tagCount], 0.25f),
+        };
+        const GeoBox bounds = geo_box_encapsulate_box(&aabbs[0], &aabbs[1]);
+
+        const RendViewVisibility vis = rend_view_visible_group(
+            &view, tags[0] | tags[1], tags[0] & tags[1], &bounds, &settings);
+
+        const bool visA = rend_view_visible(&view, tags[0], &aabbs[0], &settings);
+        const bool visB = rend_view_visible(&view, tags[1], &aabbs[1], &settings);
+        switch (vis) {
+        case RendViewVisibility_None:
+          check(!visA && !visB);
+          break;
+        case RendViewVisibility_Full:
+          check(visA && visB);
+          break;
+        case RendViewVisibility_Partial:
+          break;
+        }
+      }
+    }
+  }
+}
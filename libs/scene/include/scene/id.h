@@ -3,16 +3,16 @@
 
 // clang-format off
 enum {
-  SceneId_hit = 2729598185, // hit
-  SceneId_death = 2899093826, // death
-  SceneId_selected = 892713080, // selected
-  SceneId_unit = 541917106, // unit
-  SceneId_EffectBurning = 1512305492, // EffectBurning
-  SceneId_EffectBleeding = 4111375714, // EffectBleeding
-  SceneId_EffectVeteran = 781462266, // EffectVeteran
-  SceneId_STATUS_BURNING = 3417612726, // STATUS_BURNING
-  SceneId_STATUS_BLEEDING = 481228918, // STATUS_BLEEDING
-  SceneId_STATUS_HEALING = 293953976, // STATUS_HEALING
-  SceneId_STATUS_VETERAN = 3162569135, // STATUS_VETERAN
+  SceneId_hit = 3337009862, // hit
+  SceneId_death = 134170855, // death
+  SceneId_selected = 1783397139, // selected
+  SceneId_unit = 4164487315, // unit
+  SceneId_EffectBurning = 493749244, // EffectBurning
+  SceneId_EffectBleeding = 2548701706, // EffectBleeding
+  SceneId_EffectVeteran = 2155982723, // EffectVeteran
+  SceneId_STATUS_BURNING = 2353267225, // STATUS_BURNING
+  SceneId_STATUS_BLEEDING = 166147975, // STATUS_BLEEDING
+  SceneId_STATUS_HEALING = 2688843176, // STATUS_HEALING
+  SceneId_STATUS_VETERAN = 2331741389, // STATUS_VETERAN
 };
 // clang-format on
@@ -13,6 +13,12 @@ void             scene_prop_clear(ScenePropertyComp*);
 const ScriptMem* scene_prop_memory(const ScenePropertyComp*);
 ScriptMem*       scene_prop_memory_mut(ScenePropertyComp*);
 
+/**
+ * Version that is incremented whenever properties are stored or cleared through this api.
+ * NOTE: Writes through 'scene_prop_memory_mut' are not tracked.
+ */
+u32 scene_prop_version(const ScenePropertyComp*);
+
 /**
  * Add a property component to the given entity.
  */
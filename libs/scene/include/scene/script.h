@@ -9,8 +9,9 @@ typedef enum {
 } SceneScriptFlags;
 
 typedef struct {
-  u32          executedOps;
-  TimeDuration executedDur;
+  u32          executedOps;   // Of the last evaluation.
+  TimeDuration executedDur;   // Of the last evaluation.
+  f32          evalFrequency; // Smoothed evaluations per (real) second.
 } SceneScriptStats;
 
 /**
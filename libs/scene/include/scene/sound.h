@@ -4,6 +4,7 @@
 ecs_comp_extern_public(SceneSoundComp) {
   EcsEntityId asset; // Sound asset.
   f32         pitch, gain;
+  u8          priority; // Higher priority sounds are preferred when there are too many sounds.
   bool        looping;
 };
 
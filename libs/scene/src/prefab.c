@@ -461,10 +461,11 @@ static void setup_sound(PrefabSetupContext* ctx, const AssetPrefabTraitSound* t)
         ctx->world,
         ctx->entity,
         SceneSoundComp,
-        .asset   = t->assets[(u32)(count * rng_sample_f32(g_rng))].entity,
-        .gain    = rng_sample_range(g_rng, t->gainMin, t->gainMax),
-        .pitch   = rng_sample_range(g_rng, t->pitchMin, t->pitchMax),
-        .looping = t->looping);
+        .asset    = t->assets[(u32)(count * rng_sample_f32(g_rng))].entity,
+        .gain     = rng_sample_range(g_rng, t->gainMin, t->gainMax),
+        .pitch    = rng_sample_range(g_rng, t->pitchMin, t->pitchMax),
+        .priority = t->priority,
+        .looping  = t->looping);
   }
 }
 
@@ -4,7 +4,10 @@
 #include "script/mem.h"
 #include "script/val.h"
 
-ecs_comp_define(ScenePropertyComp) { ScriptMem memory; };
+ecs_comp_define(ScenePropertyComp) {
+  ScriptMem memory;
+  u32       version; // NOTE: Allowed to wrap around.
+};
 
 static void ecs_destruct_prop_comp(void* data) {
   ScenePropertyComp* comp = data;
@@ -20,6 +23,7 @@ static void ecs_combine_prop_comp(void* dataA, void* dataB) {
   for (ScriptMemItr itr = script_mem_begin(memB); itr.key; itr = script_mem_next(memB, itr)) {
     script_mem_store(memA, itr.key, script_mem_load(memB, itr.key));
   }
+  compA->version += compB->version + 1;
 
   script_mem_destroy(&compB->memory);
 }
@@ -44,9 +48,15 @@ ScriptVal scene_prop_load(const ScenePropertyComp* p, const StringHash key) {
 
 void scene_prop_store(ScenePropertyComp* p, const StringHash key, const ScriptVal value) {
   script_mem_store(&p->memory, key, value);
+  ++p->version;
 }
 
-void scene_prop_clear(ScenePropertyComp* p) { script_mem_clear(&p->memory); }
+void scene_prop_clear(ScenePropertyComp* p) {
+  script_mem_clear(&p->memory);
+  ++p->version;
+}
+
+u32 scene_prop_version(const ScenePropertyComp* p) { return p->version; }
 
 const ScriptMem* scene_prop_memory(const ScenePropertyComp* p) { return &p->memory; }
 
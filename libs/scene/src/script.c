@@ -1,6 +1,7 @@
 #include "asset/manager.h"
 #include "asset/script.h"
 #include "core/alloc.h"
+#include "core/bits.h"
 #include "core/diag.h"
 #include "core/dynstring.h"
 #include "core/float.h"
@@ -51,6 +52,8 @@
 #define scene_script_line_of_sight_max 100.0f
 #define scene_script_query_values_max 512
 #define scene_script_query_max 25
+#define scene_script_sleep_max time_minutes(10)
+#define scene_script_eval_freq_smoothing 0.05f
 
 typedef ScriptVal (*SceneValCombinator)(ScriptVal, ScriptVal);
 
@@ -83,6 +86,12 @@ static const String g_sceneScriptCapabilityNames[] = {
 };
 ASSERT(array_elems(g_sceneScriptCapabilityNames) == SceneScriptCapability_Count, "Missing name");
 
+typedef enum {
+  SceneScriptWake_Damage       = 1 << 0,
+  SceneScriptWake_TargetChange = 1 << 1,
+  SceneScriptWake_Arrival      = 1 << 2,
+} SceneScriptWake;
+
 // clang-format off
 
 static ScriptEnum g_scriptEnumCombinator,
@@ -104,7 +113,8 @@ static ScriptEnum g_scriptEnumCombinator,
                   g_scriptEnumBark,
                   g_scriptEnumHealthStat,
                   g_scriptEnumMarkerType,
-                  g_scriptEnumMissionState;
+                  g_scriptEnumMissionState,
+                  g_scriptEnumWakeEvent;
 
 // clang-format on
 
@@ -279,6 +289,13 @@ static void eval_enum_init_mission_state(void) {
   }
 }
 
+static void eval_enum_init_wake_event(void) {
+  script_enum_push(&g_scriptEnumWakeEvent, string_hash_lit("Damage"), SceneScriptWake_Damage);
+  script_enum_push(
+      &g_scriptEnumWakeEvent, string_hash_lit("TargetChange"), SceneScriptWake_TargetChange);
+  script_enum_push(&g_scriptEnumWakeEvent, string_hash_lit("Arrival"), SceneScriptWake_Arrival);
+}
+
 ecs_view_define(EvalGlobalView) {
   ecs_access_maybe_read(SceneDebugEnvComp);
   ecs_access_maybe_read(SceneTerrainComp);
@@ -384,6 +401,9 @@ typedef struct {
 
   EvalQuery* queries; // EvalQuery[scene_script_query_max]
   u32        usedQueries;
+
+  TimeDuration    sleepDur; // Requested by the script using 'sleep()', zero to run every frame.
+  SceneScriptWake sleepWake;
 } EvalContext;
 
 static bool
@@ -610,6 +630,21 @@ static ScriptVal eval_time(EvalContext* ctx, ScriptBinderCall* call) {
   script_panic_raise(call->panicHandler, (ScriptPanic){ScriptPanic_ArgumentInvalid, .argIndex = 0});
 }
 
+static ScriptVal eval_sleep(EvalContext* ctx, ScriptBinderCall* call) {
+  const TimeDuration dur = script_arg_time(call, 0);
+  if (UNLIKELY(dur < 0 || dur > scene_script_sleep_max)) {
+    script_panic_raise(
+        call->panicHandler, (ScriptPanic){ScriptPanic_ArgumentOutOfRange, .argIndex = 0});
+  }
+  SceneScriptWake wake = 0;
+  for (u16 i = 1; i < call->argCount; ++i) {
+    wake |= (SceneScriptWake)script_arg_enum(call, i, &g_scriptEnumWakeEvent);
+  }
+  ctx->sleepDur  = dur;
+  ctx->sleepWake = wake;
+  return script_null();
+}
+
 static bool eval_set_allowed(EvalContext* ctx, const EcsEntityId e) {
   if (UNLIKELY(ecs_world_exists(ctx->world, e) && ecs_world_has_t(ctx->world, e, AssetComp))) {
     return false; // Adding assets to sets is not allowed (because set entries can be destroyed).
@@ -2223,6 +2258,7 @@ static void eval_binder_init(void) {
     eval_enum_init_health_stat();
     eval_enum_init_marker_type();
     eval_enum_init_mission_state();
+    eval_enum_init_wake_event();
 
     // clang-format off
     eval_bind(b, string_lit("self"),                   eval_self);
@@ -2237,6 +2273,7 @@ static void eval_binder_init(void) {
     eval_bind(b, string_lit("vision"),                 eval_vision);
     eval_bind(b, string_lit("visible"),                eval_visible);
     eval_bind(b, string_lit("time"),                   eval_time);
+    eval_bind(b, string_lit("sleep"),                  eval_sleep);
     eval_bind(b, string_lit("set"),                    eval_set);
     eval_bind(b, string_lit("query_set"),              eval_query_set);
     eval_bind(b, string_lit("query_sphere"),           eval_query_sphere);
@@ -2329,9 +2366,21 @@ typedef enum {
 
 typedef struct {
   u8               resVersion;
+  SceneScriptWake  wakeEvents;
   EcsEntityId      asset;
   SceneScriptStats stats;
   ScriptPanic      panic;
+
+  /**
+   * Sleep state, the script is not evaluated until the wake-time is reached or one of the wake
+   * events occurred. Events are detected by comparing against the state at the time of sleeping.
+   */
+  TimeDuration wakeTime, sleepTime;
+  EcsEntityId  sleepTarget;
+  bool         sleepTraveling;
+  u32          sleepPropVersion;
+
+  ScriptProgBinding memBinding; // Resolved property memory locations of the program.
 } SceneScriptData;
 
 ecs_comp_define(SceneScriptComp) {
@@ -2401,13 +2450,91 @@ ecs_system_define(SceneScriptResourceUpdateSys) {
   }
 }
 
+static void scene_script_sleep(EvalContext* ctx, SceneScriptData* data) {
+  const SceneTimeComp* time = ecs_view_read_t(ctx->globalItr, SceneTimeComp);
+  const TimeDuration   dur  = ctx->sleepDur;
+
+  /**
+   * Round the wake-time onto a grid of the sleep duration with a per entity (and slot) phase shift.
+   * This spreads the evaluations of scripts that use the same interval evenly over the frames.
+   */
+  const u32          seed    = bits_hash_32_val(ecs_entity_id_index(ctx->instigator) + ctx->slot);
+  const TimeDuration phase   = (TimeDuration)((f64)dur * ((f64)seed / (f64)u32_max));
+  const TimeDuration shifted = time->time + phase;
+  data->wakeTime             = shifted - (shifted % dur) + dur - phase;
+  data->wakeEvents           = ctx->sleepWake;
+  data->sleepTime            = time->time;
+  data->sleepPropVersion     = scene_prop_version(ctx->scriptProperties);
+  data->sleepTarget          = 0;
+  data->sleepTraveling       = false;
+
+  if (ctx->sleepWake & SceneScriptWake_TargetChange) {
+    if (ecs_view_maybe_jump(ctx->targetItr, ctx->instigator)) {
+      const SceneTargetFinderComp* finder = ecs_view_read_t(ctx->targetItr, SceneTargetFinderComp);
+      data->sleepTarget                   = scene_target_primary(finder);
+    }
+  }
+  if (ctx->sleepWake & SceneScriptWake_Arrival) {
+    if (ecs_view_maybe_jump(ctx->navAgentItr, ctx->instigator)) {
+      const SceneNavAgentComp* agent = ecs_view_read_t(ctx->navAgentItr, SceneNavAgentComp);
+      data->sleepTraveling           = (agent->flags & SceneNavAgent_Traveling) != 0;
+    }
+  }
+}
+
+static bool scene_script_awake(EvalContext* ctx, const SceneScriptData* data) {
+  if (!data->wakeTime) {
+    return true; // Not sleeping.
+  }
+  const SceneTimeComp* time = ecs_view_read_t(ctx->globalItr, SceneTimeComp);
+  if (time->time >= data->wakeTime) {
+    return true;
+  }
+  if (scene_prop_version(ctx->scriptProperties) != data->sleepPropVersion) {
+    return true; // Properties were modified externally.
+  }
+  if (data->wakeEvents & SceneScriptWake_Damage) {
+    if (ecs_view_maybe_jump(ctx->healthItr, ctx->instigator)) {
+      const SceneHealthComp* health = ecs_view_read_t(ctx->healthItr, SceneHealthComp);
+      // NOTE: Health is updated after scripts, damage in the frame we went to sleep is also new.
+      if (health->lastDamagedTime >= data->sleepTime) {
+        return true;
+      }
+    }
+  }
+  if (data->wakeEvents & SceneScriptWake_TargetChange) {
+    EcsEntityId target = 0;
+    if (ecs_view_maybe_jump(ctx->targetItr, ctx->instigator)) {
+      target = scene_target_primary(ecs_view_read_t(ctx->targetItr, SceneTargetFinderComp));
+    }
+    if (target != data->sleepTarget) {
+      return true;
+    }
+  }
+  if (data->wakeEvents & SceneScriptWake_Arrival && data->sleepTraveling) {
+    bool traveling = false;
+    if (ecs_view_maybe_jump(ctx->navAgentItr, ctx->instigator)) {
+      const SceneNavAgentComp* agent = ecs_view_read_t(ctx->navAgentItr, SceneNavAgentComp);
+      traveling                      = (agent->flags & SceneNavAgent_Traveling) != 0;
+    }
+    if (!traveling) {
+      return true;
+    }
+  }
+  return false;
+}
+
 static void scene_script_eval(EvalContext* ctx) {
   SceneScriptData* data = &ctx->scriptInstance->slots[ctx->slot];
   ScriptMem*       mem  = scene_prop_memory_mut(ctx->scriptProperties);
 
+  ctx->sleepDur  = 0;
+  ctx->sleepWake = 0;
+
   // Eval.
   const TimeSteady       startTime = time_steady_clock();
-  const ScriptProgResult evalRes   = script_prog_eval(ctx->scriptProgram, mem, g_scriptBinder, ctx);
+  const ScriptProgResult evalRes =
+      script_prog_eval(ctx->scriptProgram, mem, &data->memBinding, g_scriptBinder, ctx);
 
   // Handle panics.
   if (UNLIKELY(evalRes.panic.kind)) {
@@ -2432,6 +2559,14 @@ static void scene_script_eval(EvalContext* ctx) {
     data->panic = (ScriptPanic){0};
   }
 
+  // Schedule the next evaluation.
+  if (ctx->sleepDur && !evalRes.panic.kind) {
+    scene_script_sleep(ctx, data);
+  } else {
+    data->wakeTime   = 0;
+    data->wakeEvents = 0;
+  }
+
   // Update stats.
   data->stats.executedOps = evalRes.executedOps;
   data->stats.executedDur = time_steady_duration(startTime, time_steady_clock());
@@ -2444,6 +2579,8 @@ ecs_system_define(SceneScriptUpdateSys) {
     return; // Global dependency not yet initialized.
   }
   const SceneDebugEnvComp* debugEnv = ecs_view_read_t(globalItr, SceneDebugEnvComp);
+  const SceneTimeComp*     time     = ecs_view_read_t(globalItr, SceneTimeComp);
+  const f32                deltaSec = scene_real_delta_seconds(time);
 
   EcsView* scriptView        = ecs_world_view_t(world, ScriptUpdateView);
   EcsView* resourceAssetView = ecs_world_view_t(world, ResourceAssetView);
@@ -2511,9 +2648,19 @@ ecs_system_define(SceneScriptUpdateSys) {
         if (UNLIKELY(data->resVersion != version)) {
           ctx.scriptInstance->flags &= ~SceneScriptFlags_DidPanic;
           data->resVersion = version;
+          data->wakeTime   = 0; // Evaluate reloaded scripts immediately.
+          data->memBinding = (ScriptProgBinding){0}; // Program can be reloaded in-place.
         }
         if (ctx.scriptInstance->flags & SceneScriptFlags_Enabled) {
-          scene_script_eval(&ctx);
+          const bool awake = scene_script_awake(&ctx, data);
+          if (awake) {
+            scene_script_eval(&ctx);
+          }
+          if (deltaSec > f32_epsilon) {
+            const f32 freq            = awake ? (1.0f / deltaSec) : 0.0f;
+            const f32 smoothing       = scene_script_eval_freq_smoothing;
+            data->stats.evalFrequency = math_lerp(data->stats.evalFrequency, freq, smoothing);
+          }
         } else {
           data->stats = (SceneScriptStats){0};
           data->panic = (ScriptPanic){0};
@@ -2624,7 +2771,7 @@ SceneScriptComp* scene_script_add(
   script->slots     = alloc_array_t(g_allocHeap, SceneScriptData, scriptAssetCount);
   for (u32 i = 0; i != scriptAssetCount; ++i) {
     diag_assert(ecs_world_exists(world, scriptAssets[i]));
-    script->slots[i].asset = scriptAssets[i];
+    script->slots[i] = (SceneScriptData){.asset = scriptAssets[i]};
   }
 
   scene_action_queue_add(world, entity);
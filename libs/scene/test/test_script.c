@@ -19,6 +19,10 @@ static const AssetMemRecord g_testScriptAssets[] = {
         .id   = string_static("scene/set_property.script"),
         .data = string_static("$test = 42"),
     },
+    {
+        .id   = string_static("scene/sleep.script"),
+        .data = string_static("$count = ($count ?? 0) + 1; sleep(600)"),
+    },
 };
 
 static void scene_test_wait(EcsRunner* runner) {
@@ -106,6 +110,41 @@ spec(script) {
     }
   }
 
+  it("skips evaluation while sleeping and wakes on property changes") {
+    EcsEntityId scriptAssets[1];
+    {
+      AssetManagerComp* manager = ecs_utils_write_first_t(world, ManagerView, AssetManagerComp);
+      scriptAssets[0]           = asset_lookup(world, manager, string_lit("scene/sleep.script"));
+    }
+
+    const EcsEntityId e = ecs_world_entity_create(world);
+    {
+      SceneScriptComp* script = scene_script_add(world, e, scriptAssets, array_elems(scriptAssets));
+      scene_script_flags_set(script, SceneScriptFlags_Enabled);
+      scene_prop_add(world, e);
+    }
+
+    scene_test_wait(runner);
+    scene_test_wait(runner);
+
+    const StringHash countKey = string_hash_lit("count");
+    {
+      const ScenePropertyComp* propComp = ecs_utils_read_t(world, ScriptView, e, ScenePropertyComp);
+      check(script_val_equal(scene_prop_load(propComp, countKey), script_num(1)));
+    }
+    {
+      ScenePropertyComp* propComp = ecs_utils_write_t(world, ScriptView, e, ScenePropertyComp);
+      scene_prop_store(propComp, string_hash_lit("wake"), script_bool(true));
+    }
+
+    scene_test_wait(runner);
+
+    {
+      const ScenePropertyComp* propComp = ecs_utils_read_t(world, ScriptView, e, ScenePropertyComp);
+      check(script_val_equal(scene_prop_load(propComp, countKey), script_num(2)));
+    }
+  }
+
   teardown() {
     ecs_runner_destroy(runner);
     ecs_world_destroy(world);
@@ -3,14 +3,14 @@
 
 // clang-format off
 enum {
-  ScriptId_any = 119688326, // any
-  ScriptId_if = 3180054279, // if
-  ScriptId_else = 1760833515, // else
-  ScriptId_var = 172593793, // var
-  ScriptId_while = 1492262353, // while
-  ScriptId_continue = 1788505286, // continue
-  ScriptId_break = 1725904472, // break
-  ScriptId_for = 327857603, // for
-  ScriptId_return = 3227182607, // return
+  ScriptId_any = 546949450, // any
+  ScriptId_if = 3075611574, // if
+  ScriptId_else = 1824745159, // else
+  ScriptId_var = 2979119965, // var
+  ScriptId_while = 2068487557, // while
+  ScriptId_continue = 4107021203, // continue
+  ScriptId_break = 2907736770, // break
+  ScriptId_for = 6827195, // for
+  ScriptId_return = 524380818, // return
 };
 // clang-format on
@@ -6,7 +6,8 @@
  */
 typedef struct sScriptMem {
   u32   slotCount, slotCountUsed;
-  void* slotData;
+  u32   generation; // Incremented when slots are invalidated (on grow or clear).
+  void* slotData;   // ScriptVal[slotCount] followed by StringHash[slotCount].
 } ScriptMem;
 
 /**
@@ -32,6 +33,15 @@ void script_mem_clear(ScriptMem*);
 ScriptVal script_mem_load(const ScriptMem*, StringHash key);
 void      script_mem_store(ScriptMem*, StringHash key, ScriptVal);
 
+/**
+ * Slot based access; allows resolving a key once and then accessing its value directly.
+ * NOTE: Slots are invalidated whenever the memory generation changes.
+ */
+u32 script_mem_slot_find(const ScriptMem*, StringHash key); // Returns sentinel_u32 if not present.
+u32 script_mem_slot_insert(ScriptMem*, StringHash key);
+
+#define script_mem_slot_val(_MEM_, _SLOT_) (((ScriptVal*)(_MEM_)->slotData)[_SLOT_])
+
 /**
  * Iterator for iterating memory keys.
  * NOTE: Iterator is invalidated when new entries are inserted / the memory is cleared.
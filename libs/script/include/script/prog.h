@@ -4,6 +4,7 @@
 #include "script/panic.h"
 
 #define script_prog_regs 32
+#define script_prog_mem_slots_max 64
 
 // clang-format off
 
@@ -24,7 +25,12 @@
  * - boolean         1 byte(s).
  * - small-int       1 byte(s).
  * - memory-key:     4 byte(s).
+ * - memory-slot:    1 byte(s).
  *
+ * NOTE: Ops with a type suffix (for example 'AddNum') skip the runtime type dispatch, the compiler
+ *       only emits them when the operand types are statically known.
+ * NOTE: Memory-slots are dense per-program indices into the program's memory keys, the vm resolves
+ *       them to memory locations lazily; keys beyond 'script_prog_mem_slots_max' use 'MemLoad'.
  * NOTE: Multi-byte operation data is encoded as little-endian.
  * NOTE: There is no alignment requirement for operation data.
  * NOTE: Instruction values are 2 byte offsets from the start of the code memory.
@@ -98,6 +104,18 @@ typedef enum eScriptOp {
   ScriptOp_Min               = 65, // [x,y    ] (x,y    ) -> (x) Store the minimum value of 'x' and 'y' in register 'x'.
   ScriptOp_Max               = 66, // [x,y    ] (x,y    ) -> (x) Store the maximum value of 'x' and 'y' in register 'x'.
   ScriptOp_Perlin3           = 67, // [d      ] (       ) -> (d) Compute a 3d perlin noise in register 'd'.
+  ScriptOp_AddNum            = 68, // [d,s    ] (d,s    ) -> (d) Add num register 's' to num register 'd'.
+  ScriptOp_SubNum            = 69, // [d,s    ] (d,s    ) -> (d) Subtract num register 's' from num register 'd'.
+  ScriptOp_MulNum            = 70, // [d,s    ] (d,s    ) -> (d) Multiply num register 'd' by num register 's'.
+  ScriptOp_DivNum            = 71, // [d,s    ] (d,s    ) -> (d) Divide num register 'd' by num register 's'.
+  ScriptOp_LessNum           = 72, // [d,s    ] (d,s    ) -> (d) Compare num registers 'd' and 's' and store result in register 'd'.
+  ScriptOp_GreaterNum        = 73, // [d,s    ] (d,s    ) -> (d) Compare num registers 'd' and 's' and store result in register 'd'.
+  ScriptOp_AddVec3           = 74, // [d,s    ] (d,s    ) -> (d) Add vec3 register 's' to vec3 register 'd'.
+  ScriptOp_SubVec3           = 75, // [d,s    ] (d,s    ) -> (d) Subtract vec3 register 's' from vec3 register 'd'.
+  ScriptOp_MulVec3Num        = 76, // [d,s    ] (d,s    ) -> (d) Multiply vec3 register 'd' by num register 's'.
+  ScriptOp_DistanceVec3      = 77, // [d,s    ] (d,s    ) -> (d) Compute the distance between vec3 registers 'd' and 's' and store result in register 'd'.
+  ScriptOp_MemLoadSlot       = 78, // [d,m    ] (       ) -> (d) Load from memory at memory-slot 'm' into register 'd'.
+  ScriptOp_MemStoreSlot      = 79, // [s,m    ] (s      ) -> ( ) Store to memory at memory-slot 'm' from register 's'.
 } ScriptOp;
 
 // clang-format on
@@ -115,6 +133,7 @@ typedef struct sScriptProgram {
   } code; // Instruction stream (struct layout compatible with DataMem).
   ScriptBinderHash binderHash;
   HeapArray_t(ScriptVal) literals;
+  HeapArray_t(StringHash) memKeys; // Memory keys indexed by memory-slot.
   HeapArray_t(ScriptProgramLoc) locations; // Sorted on instruction.
 } ScriptProgram;
 
@@ -124,15 +143,29 @@ typedef struct {
   ScriptVal   val;
 } ScriptProgResult;
 
+/**
+ * Resolved memory locations of a program's memory-slots.
+ * Allows repeated evaluations of a program against the same memory to skip the key lookups.
+ * NOTE: Zero initialize before the first use; locations are re-resolved when the program, the
+ *       memory or the memory generation changes. Reset when the program is reloaded in-place.
+ */
+typedef struct {
+  const ScriptProgram* prog;
+  const ScriptMem*     mem;
+  u32                  generation;
+  u32                  locations[script_prog_mem_slots_max]; // Memory location, or sentinel_u32.
+} ScriptProgBinding;
+
 void script_prog_destroy(ScriptProgram*, Allocator*);
 void script_prog_clear(ScriptProgram*, Allocator*);
 
 /**
  * Evaluate the program.
+ * NOTE: Optionally provide a binding to reuse the resolved memory locations across evaluations.
  * Pre-condition: script_prog_validate(program, binder).
  */
-ScriptProgResult
-script_prog_eval(const ScriptProgram*, ScriptMem*, const ScriptBinder*, void* bindCtx);
+ScriptProgResult script_prog_eval(
+    const ScriptProgram*, ScriptMem*, ScriptProgBinding*, const ScriptBinder*, void* bindCtx);
 
 /**
  * Validate the given program.
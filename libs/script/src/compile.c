@@ -57,6 +57,7 @@ typedef struct {
   const ScriptLookup* lookup;
   DynString           outCode;
   DynArray            outLiterals;  // ScriptVal[].
+  DynArray            outMemKeys;   // StringHash[], indexed by memory-slot.
   DynArray            outLocations; // ScriptProgramLoc[].
   ScriptOp            lastOp;
 
@@ -65,6 +66,8 @@ typedef struct {
 
   LabelId loopLabelIncrement, loopLabelEnd;
 
+  ScriptMask* exprTypes; // Memoized result of 'expr_types', indexed by ScriptExpr.
+
   DynArray labels;       // Label[].
   DynArray labelPatches; // LabelPatch[].
 } Context;
@@ -240,8 +243,32 @@ static void emit_quaternary(
   dynstring_append_char(&ctx->outCode, src3);
 }
 
+/**
+ * Lookup or assign the memory-slot for the given key.
+ * Returns sentinel_u32 when the program's memory-slots are exhausted.
+ */
+static u32 mem_slot(Context* ctx, const StringHash key) {
+  for (u32 memSlot = 0; memSlot != ctx->outMemKeys.size; ++memSlot) {
+    if (*dynarray_at_t(&ctx->outMemKeys, memSlot, StringHash) == key) {
+      return memSlot;
+    }
+  }
+  if (ctx->outMemKeys.size >= script_prog_mem_slots_max) {
+    return sentinel_u32;
+  }
+  *dynarray_push_t(&ctx->outMemKeys, StringHash) = key;
+  return (u32)(ctx->outMemKeys.size - 1);
+}
+
 static void emit_mem_op(Context* ctx, const ScriptOp op, const RegId dst, const StringHash key) {
   diag_assert((op == ScriptOp_MemLoad || op == ScriptOp_MemStore) && dst < script_prog_regs);
+  const u32 memSlot = mem_slot(ctx, key);
+  if (LIKELY(!sentinel_check(memSlot))) {
+    emit_op(ctx, op == ScriptOp_MemLoad ? ScriptOp_MemLoadSlot : ScriptOp_MemStoreSlot);
+    dynstring_append_char(&ctx->outCode, dst);
+    dynstring_append_char(&ctx->outCode, (u8)memSlot);
+    return;
+  }
   emit_op(ctx, op);
   dynstring_append_char(&ctx->outCode, dst);
   mem_write_le_u32(dynstring_push(&ctx->outCode, 4), key);
@@ -320,6 +347,165 @@ static bool expr_is_intrinsic(Context* ctx, const ScriptExpr e, const ScriptIntr
 
 static ScriptCompileError compile_expr(Context*, Target, ScriptExpr);
 
+static ScriptMask expr_types(Context*, ScriptExpr);
+
+static ScriptMask expr_types_compute(Context* ctx, const ScriptExpr e) {
+  switch (expr_kind(ctx->doc, e)) {
+  case ScriptExprKind_Value: {
+    const ScriptExprValue* data = &expr_data(ctx->doc, e)->value;
+    return script_mask(script_type(*dynarray_at_t(&ctx->doc->values, data->valId, ScriptVal)));
+  }
+  case ScriptExprKind_VarStore:
+    return expr_types(ctx, expr_data(ctx->doc, e)->var_store.val);
+  case ScriptExprKind_MemStore:
+    return expr_types(ctx, expr_data(ctx->doc, e)->mem_store.val);
+  case ScriptExprKind_Block: {
+    const ScriptExprBlock* data  = &expr_data(ctx->doc, e)->block;
+    const ScriptExpr*      exprs = expr_set_data(ctx->doc, data->exprSet);
+    return expr_types(ctx, exprs[data->exprCount - 1]);
+  }
+  case ScriptExprKind_Intrinsic:
+    break;
+  default:
+    return script_mask_any; // Variables, memory and externs can contain any type.
+  }
+  const ScriptExprIntrinsic* data = &expr_data(ctx->doc, e)->intrinsic;
+  const ScriptExpr*          args = expr_set_data(ctx->doc, data->argSet);
+  switch (data->intrinsic) {
+  case ScriptIntrinsic_Equal:
+  case ScriptIntrinsic_NotEqual:
+  case ScriptIntrinsic_Less:
+  case ScriptIntrinsic_LessOrEqual:
+  case ScriptIntrinsic_Greater:
+  case ScriptIntrinsic_GreaterOrEqual:
+  case ScriptIntrinsic_Invert:
+  case ScriptIntrinsic_LogicAnd:
+  case ScriptIntrinsic_LogicOr:
+    return script_mask_bool;
+  case ScriptIntrinsic_Select:
+    return expr_types(ctx, args[1]) | expr_types(ctx, args[2]);
+  case ScriptIntrinsic_Random:
+    return script_mask_num;
+  case ScriptIntrinsic_RandomSphere:
+  case ScriptIntrinsic_RandomCircleXZ:
+    return script_mask_vec3;
+  case ScriptIntrinsic_Add:
+  case ScriptIntrinsic_Sub:
+  case ScriptIntrinsic_Mul:
+  case ScriptIntrinsic_Div: {
+    const ScriptMask a = expr_types(ctx, args[0]), b = expr_types(ctx, args[1]);
+    if (a == script_mask_num && b == script_mask_num) {
+      return script_mask_num;
+    }
+    if (a == script_mask_vec3 && b == script_mask_vec3) {
+      return script_mask_vec3;
+    }
+    const bool isMulDiv =
+        data->intrinsic == ScriptIntrinsic_Mul || data->intrinsic == ScriptIntrinsic_Div;
+    if (isMulDiv && a == script_mask_vec3 && b == script_mask_num) {
+      return script_mask_vec3;
+    }
+    return script_mask_any;
+  }
+  case ScriptIntrinsic_Negate: {
+    const ScriptMask a = expr_types(ctx, args[0]);
+    return (a == script_mask_num || a == script_mask_vec3) ? a : script_mask_any;
+  }
+  case ScriptIntrinsic_Sin:
+  case ScriptIntrinsic_Cos:
+  case ScriptIntrinsic_Tan:
+  case ScriptIntrinsic_Sqrt:
+    return expr_types(ctx, args[0]) == script_mask_num ? script_mask_num : script_mask_any;
+  case ScriptIntrinsic_Magnitude: {
+    const ScriptMask a = expr_types(ctx, args[0]);
+    return (a == script_mask_num || a == script_mask_vec3) ? script_mask_num : script_mask_any;
+  }
+  case ScriptIntrinsic_Distance: {
+    const ScriptMask a = expr_types(ctx, args[0]), b = expr_types(ctx, args[1]);
+    const bool       isVecOrNum = a == script_mask_num || a == script_mask_vec3;
+    return isVecOrNum && a == b ? script_mask_num : script_mask_any;
+  }
+  case ScriptIntrinsic_VecX:
+  case ScriptIntrinsic_VecY:
+  case ScriptIntrinsic_VecZ:
+    return expr_types(ctx, args[0]) == script_mask_vec3 ? script_mask_num : script_mask_any;
+  case ScriptIntrinsic_Vec3Compose: {
+    const bool allNum = expr_types(ctx, args[0]) == script_mask_num &&
+                        expr_types(ctx, args[1]) == script_mask_num &&
+                        expr_types(ctx, args[2]) == script_mask_num;
+    return allNum ? script_mask_vec3 : script_mask_any;
+  }
+  default:
+    return script_mask_any;
+  }
+}
+
+/**
+ * Compute the mask of types the given expression can produce.
+ * NOTE: Conservative; returns 'script_mask_any' when the type cannot be statically determined.
+ * NOTE: Memoized per expression; without it specializing nested operations is quadratic.
+ */
+static ScriptMask expr_types(Context* ctx, const ScriptExpr e) {
+  if (sentinel_check(ctx->exprTypes[e])) {
+    ctx->exprTypes[e] = expr_types_compute(ctx, e);
+  }
+  return ctx->exprTypes[e];
+}
+
+/**
+ * Select a type specialized variant of the given binary operation (if any).
+ * Specialized operations skip the runtime type dispatch.
+ */
+static ScriptOp compile_op_specialize(Context* ctx, const ScriptOp op, const ScriptExpr* args) {
+  switch (op) {
+  case ScriptOp_Add:
+  case ScriptOp_Sub:
+  case ScriptOp_Mul:
+  case ScriptOp_Div:
+  case ScriptOp_Less:
+  case ScriptOp_Greater:
+  case ScriptOp_Distance:
+    break;
+  default:
+    return op;
+  }
+  const ScriptMask a = expr_types(ctx, args[0]), b = expr_types(ctx, args[1]);
+  if (a == script_mask_num && b == script_mask_num) {
+    switch (op) {
+    case ScriptOp_Add:
+      return ScriptOp_AddNum;
+    case ScriptOp_Sub:
+      return ScriptOp_SubNum;
+    case ScriptOp_Mul:
+      return ScriptOp_MulNum;
+    case ScriptOp_Div:
+      return ScriptOp_DivNum;
+    case ScriptOp_Less:
+      return ScriptOp_LessNum;
+    case ScriptOp_Greater:
+      return ScriptOp_GreaterNum;
+    default:
+      return op;
+    }
+  }
+  if (a == script_mask_vec3 && b == script_mask_vec3) {
+    switch (op) {
+    case ScriptOp_Add:
+      return ScriptOp_AddVec3;
+    case ScriptOp_Sub:
+      return ScriptOp_SubVec3;
+    case ScriptOp_Distance:
+      return ScriptOp_DistanceVec3;
+    default:
+      return op;
+    }
+  }
+  if (a == script_mask_vec3 && b == script_mask_num && op == ScriptOp_Mul) {
+    return ScriptOp_MulVec3Num;
+  }
+  return op;
+}
+
 static ScriptCompileError compile_value(Context* ctx, const Target tgt, const ScriptExpr e) {
   if (tgt.optional) {
     return ScriptCompileError_None;
@@ -444,7 +630,8 @@ compile_intr_unary(Context* ctx, const Target tgt, const ScriptOp op, const Scri
 }
 
 static ScriptCompileError
-compile_intr_binary(Context* ctx, const Target tgt, const ScriptOp op, const ScriptExpr* args) {
+compile_intr_binary(Context* ctx, const Target tgt, ScriptOp op, const ScriptExpr* args) {
+  op                     = compile_op_specialize(ctx, op, args);
   ScriptCompileError err = ScriptCompileError_None;
   if ((err = compile_expr(ctx, target_reg(tgt.reg), args[0]))) {
     return err;
@@ -1016,6 +1203,7 @@ ScriptCompileError script_compile(
       .lookup             = lookup,
       .outCode            = dynstring_create(g_allocHeap, 64),
       .outLiterals        = dynarray_create_t(g_allocHeap, ScriptVal, 0),
+      .outMemKeys         = dynarray_create_t(g_allocHeap, StringHash, 0),
       .outLocations       = dynarray_create_t(g_allocHeap, ScriptProgramLoc, 16),
       .labels             = dynarray_create_t(g_allocHeap, Label, 0),
       .labelPatches       = dynarray_create_t(g_allocHeap, LabelPatch, 0),
@@ -1024,6 +1212,12 @@ ScriptCompileError script_compile(
   };
   mem_set(array_mem(ctx.varRegisters), 0xFF);
 
+  const usize exprCount = doc->exprData.size;
+  const Mem   exprTypesMem =
+      alloc_alloc(g_allocHeap, sizeof(ScriptMask) * math_max(exprCount, 1), alignof(ScriptMask));
+  mem_set(exprTypesMem, 0xFF); // Initialize to sentinel (not yet computed).
+  ctx.exprTypes = exprTypesMem.ptr;
+
   reg_free_all(&ctx);
   diag_assert(reg_available(&ctx) == script_prog_regs);
 
@@ -1061,6 +1255,8 @@ ScriptCompileError script_compile(
       .binderHash       = doc->binderHash,
       .literals.values  = dynarray_copy_as_new(&ctx.outLiterals, outAlloc),
       .literals.count   = ctx.outLiterals.size,
+      .memKeys.values   = dynarray_copy_as_new(&ctx.outMemKeys, outAlloc),
+      .memKeys.count    = ctx.outMemKeys.size,
       .locations.values = dynarray_copy_as_new(&ctx.outLocations, outAlloc),
       .locations.count  = ctx.outLocations.size,
   };
@@ -1068,8 +1264,10 @@ ScriptCompileError script_compile(
 Ret:
   dynstring_destroy(&ctx.outCode);
   dynarray_destroy(&ctx.outLiterals);
+  dynarray_destroy(&ctx.outMemKeys);
   dynarray_destroy(&ctx.outLocations);
   dynarray_destroy(&ctx.labels);
   dynarray_destroy(&ctx.labelPatches);
+  alloc_free(g_allocHeap, exprTypesMem);
   return err;
 }
@@ -1,3 +1,4 @@
+#include "core/alloc.h"
 #include "core/array.h"
 #include "core/bits.h"
 #include "core/diag.h"
@@ -133,10 +134,10 @@ static u8 script_peek(const String str, const u32 ahead) {
 }
 
 static String script_lex_number_positive(String str, ScriptToken* out) {
-  f64  mantissa       = 0.0;
-  f64  divider        = 1.0;
-  bool passedDecPoint = false;
-  bool invalidChar    = false;
+  const String start          = str;
+  bool         passedDecPoint = false;
+  bool         anySeparator   = false;
+  bool         invalidChar    = false;
 
   u8 lastChar = '\0';
   while (!string_is_empty(str)) {
@@ -160,12 +161,9 @@ static String script_lex_number_positive(String str, ScriptToken* out) {
     case '7':
     case '8':
     case '9':
-      mantissa = mantissa * 10.0 + (ch - '0');
-      if (passedDecPoint) {
-        divider *= 10.0;
-      }
       break;
     case '_':
+      anySeparator = true;
       break; // Ignore underscores as legal digit separators.
     default:
       if (script_is_word_separator(ch)) {
@@ -188,8 +186,20 @@ NumberEnd:
   if (UNLIKELY(lastChar == '_')) {
     return *out = script_token_diag(ScriptDiag_NumberEndsWithSeparator), str;
   }
-  out->kind       = ScriptTokenKind_Number;
-  out->val_number = mantissa / divider;
+  String text = string_slice(start, 0, start.size - str.size);
+  if (anySeparator) {
+    // Strip the separators before parsing.
+    const Mem buffer = alloc_alloc(g_allocScratch, text.size, 1);
+    usize     size   = 0;
+    mem_for_u8(text, itr) {
+      if (*itr != '_') {
+        *mem_at_u8(buffer, size++) = *itr;
+      }
+    }
+    text = mem_slice(buffer, 0, size);
+  }
+  out->kind = ScriptTokenKind_Number;
+  format_read_f64(text, &out->val_number);
   return str;
 }
 
@@ -85,6 +85,7 @@ static void slot_data_grow(ScriptMem* mem) {
   slot_data_free(mem->slotData, mem->slotCount);
   mem->slotData  = newSlotData;
   mem->slotCount = newSlotCount;
+  ++mem->generation;
 }
 
 NO_INLINE_HINT static u32 slot_data_grow_and_query(ScriptMem* mem, const StringHash key) {
@@ -122,6 +123,7 @@ void script_mem_destroy(ScriptMem* mem) { slot_data_free(mem->slotData, mem->slo
 void script_mem_clear(ScriptMem* mem) {
   slot_data_reset(mem->slotData, mem->slotCount);
   mem->slotCountUsed = 0;
+  ++mem->generation;
 }
 
 ScriptVal script_mem_load(const ScriptMem* mem, const StringHash key) {
@@ -134,6 +136,13 @@ void script_mem_store(ScriptMem* mem, const StringHash key, const ScriptVal valu
   slot_data_values(mem->slotData)[slotIndex] = value;
 }
 
+u32 script_mem_slot_find(const ScriptMem* mem, const StringHash key) {
+  const u32 slotIndex = slot_index(mem->slotData, mem->slotCount, key);
+  return slot_data_keys(mem->slotData, mem->slotCount)[slotIndex] ? slotIndex : sentinel_u32;
+}
+
+u32 script_mem_slot_insert(ScriptMem* mem, const StringHash key) { return slot_insert(mem, key); }
+
 ScriptMemItr script_mem_begin(const ScriptMem* mem) {
   return script_mem_next(mem, (ScriptMemItr){0});
 }
@@ -1,6 +1,7 @@
 #include "core/alloc.h"
 #include "core/diag.h"
 #include "core/dynstring.h"
+#include "core/math.h"
 #include "core/search.h"
 #include "core/stringtable.h"
 #include "script/binder.h"
@@ -63,9 +64,64 @@
   VM_OP_SIMPLE_TERNARY(     Lerp,               script_val_lerp                 )\
   VM_OP_SIMPLE_BINARY(      Min,                script_val_min                  )\
   VM_OP_SIMPLE_BINARY(      Max,                script_val_max                  )\
-  VM_OP_SIMPLE_UNARY(       Perlin3,            script_val_perlin3              )
+  VM_OP_SIMPLE_UNARY(       Perlin3,            script_val_perlin3              )\
+  VM_OP_SIMPLE_BINARY(      AddNum,             prog_add_num                    )\
+  VM_OP_SIMPLE_BINARY(      SubNum,             prog_sub_num                    )\
+  VM_OP_SIMPLE_BINARY(      MulNum,             prog_mul_num                    )\
+  VM_OP_SIMPLE_BINARY(      DivNum,             prog_div_num                    )\
+  VM_OP_SIMPLE_BINARY(      LessNum,            prog_less_num                   )\
+  VM_OP_SIMPLE_BINARY(      GreaterNum,         prog_greater_num                )\
+  VM_OP_SIMPLE_BINARY(      AddVec3,            prog_add_vec3                   )\
+  VM_OP_SIMPLE_BINARY(      SubVec3,            prog_sub_vec3                   )\
+  VM_OP_SIMPLE_BINARY(      MulVec3Num,         prog_mul_vec3_num               )\
+  VM_OP_SIMPLE_BINARY(      DistanceVec3,       prog_distance_vec3              )
 // clang-format on
 
+/**
+ * Type specialized operations.
+ * NOTE: Operand types are guaranteed by the compiler, no runtime type checks are performed.
+ */
+
+INLINE_HINT static ScriptVal prog_add_num(const ScriptVal a, const ScriptVal b) {
+  return val_num(val_as_num(a) + val_as_num(b));
+}
+
+INLINE_HINT static ScriptVal prog_sub_num(const ScriptVal a, const ScriptVal b) {
+  return val_num(val_as_num(a) - val_as_num(b));
+}
+
+INLINE_HINT static ScriptVal prog_mul_num(const ScriptVal a, const ScriptVal b) {
+  return val_num(val_as_num(a) * val_as_num(b));
+}
+
+INLINE_HINT static ScriptVal prog_div_num(const ScriptVal a, const ScriptVal b) {
+  return val_num(val_as_num(a) / val_as_num(b));
+}
+
+INLINE_HINT static ScriptVal prog_less_num(const ScriptVal a, const ScriptVal b) {
+  return val_bool(val_as_num(a) < val_as_num(b));
+}
+
+INLINE_HINT static ScriptVal prog_greater_num(const ScriptVal a, const ScriptVal b) {
+  return val_bool(val_as_num(a) > val_as_num(b));
+}
+
+INLINE_HINT static ScriptVal prog_add_vec3(const ScriptVal a, const ScriptVal b) {
+  return val_vec3(geo_vector_add(val_as_vec3_dirty_w(a), val_as_vec3_dirty_w(b)));
+}
+
+INLINE_HINT static ScriptVal prog_sub_vec3(const ScriptVal a, const ScriptVal b) {
+  return val_vec3(geo_vector_sub(val_as_vec3_dirty_w(a), val_as_vec3_dirty_w(b)));
+}
+
+INLINE_HINT static ScriptVal prog_mul_vec3_num(const ScriptVal a, const ScriptVal b) {
+  return val_vec3(geo_vector_mul(val_as_vec3_dirty_w(a), (f32)val_as_num(b)));
+}
+
+INLINE_HINT static ScriptVal prog_distance_vec3(const ScriptVal a, const ScriptVal b) {
+  return val_num(geo_vector_mag(geo_vector_sub(val_as_vec3_dirty_w(a), val_as_vec3_dirty_w(b))));
+}
+
 INLINE_HINT static bool prog_reg_valid(const u8 regId) { return regId < script_prog_regs; }
 
 INLINE_HINT static bool prog_reg_set_valid(const u8 regId, const u8 regCount) {
@@ -76,6 +132,10 @@ INLINE_HINT static bool prog_val_valid(const ScriptProgram* prog, const u8 valId
   return valId < prog->literals.count;
 }
 
+INLINE_HINT static bool prog_mem_slot_valid(const ScriptProgram* prog, const u8 memSlot) {
+  return memSlot < prog->memKeys.count && memSlot < script_prog_mem_slots_max;
+}
+
 INLINE_HINT static u16 prog_read_u16(const u8 data[]) {
   // NOTE: Input data is not required to be aligned to 16 bit.
   return (u16)data[0] | (u16)data[1] << 8;
@@ -103,6 +163,51 @@ static i8 prog_compare_loc(const void* a, const void* b) {
   return compare_u16(&posA->instruction, &posB->instruction);
 }
 
+static void
+prog_mem_bind_reset(const ScriptProgram* prog, const ScriptMem* m, ScriptProgBinding* b) {
+  const u32 slotCount = math_min(prog->memKeys.count, script_prog_mem_slots_max);
+  mem_set(mem_create(b->locations, sizeof(u32) * slotCount), 0xFF);
+  b->prog       = prog;
+  b->mem        = m;
+  b->generation = m->generation;
+}
+
+INLINE_HINT static ScriptVal prog_mem_load_slot(
+    const ScriptProgram* prog, const ScriptMem* m, ScriptProgBinding* b, const u8 memSlot) {
+  if (UNLIKELY(b->generation != m->generation)) {
+    prog_mem_bind_reset(prog, m, b);
+  }
+  u32 location = b->locations[memSlot];
+  if (UNLIKELY(sentinel_check(location))) {
+    location = script_mem_slot_find(m, prog->memKeys.values[memSlot]);
+    if (sentinel_check(location)) {
+      return val_null(); // NOTE: Missing keys are not cached as they can be inserted later.
+    }
+    b->locations[memSlot] = location;
+  }
+  return script_mem_slot_val(m, location);
+}
+
+INLINE_HINT static void prog_mem_store_slot(
+    const ScriptProgram* prog,
+    ScriptMem*           m,
+    ScriptProgBinding*   b,
+    const u8             memSlot,
+    const ScriptVal      val) {
+  if (UNLIKELY(b->generation != m->generation)) {
+    prog_mem_bind_reset(prog, m, b);
+  }
+  u32 location = b->locations[memSlot];
+  if (UNLIKELY(sentinel_check(location))) {
+    location = script_mem_slot_insert(m, prog->memKeys.values[memSlot]);
+    if (UNLIKELY(b->generation != m->generation)) {
+      prog_mem_bind_reset(prog, m, b); // Inserting grew the memory; all locations are invalidated.
+    }
+    b->locations[memSlot] = location;
+  }
+  script_mem_slot_val(m, location) = val;
+}
+
 static ScriptRangeLineCol prog_loc(const ScriptProgram* prog, const u16 instruction) {
 
   const ScriptProgramLoc* r = search_binary_t(
@@ -126,6 +231,9 @@ void script_prog_destroy(ScriptProgram* prog, Allocator* alloc) {
   if (prog->literals.count) {
     alloc_free_array_t(alloc, prog->literals.values, prog->literals.count);
   }
+  if (prog->memKeys.count) {
+    alloc_free_array_t(alloc, prog->memKeys.values, prog->memKeys.count);
+  }
   if (prog->locations.count) {
     alloc_free_array_t(alloc, prog->locations.values, prog->locations.count);
   }
@@ -144,6 +252,11 @@ void script_prog_clear(ScriptProgram* prog, Allocator* alloc) {
     prog->literals.values = null;
     prog->literals.count  = 0;
   }
+  if (prog->memKeys.count) {
+    alloc_free_array_t(alloc, prog->memKeys.values, prog->memKeys.count);
+    prog->memKeys.values = null;
+    prog->memKeys.count  = 0;
+  }
   if (prog->locations.count) {
     alloc_free_array_t(alloc, prog->locations.values, prog->locations.count);
     prog->locations.values = null;
@@ -152,7 +265,11 @@ void script_prog_clear(ScriptProgram* prog, Allocator* alloc) {
 }
 
 ScriptProgResult script_prog_eval(
-    const ScriptProgram* prog, ScriptMem* m, const ScriptBinder* binder, void* bindCtx) {
+    const ScriptProgram* prog,
+    ScriptMem*           m,
+    ScriptProgBinding*   memBinding,
+    const ScriptBinder*  binder,
+    void*                bindCtx) {
 
   diag_assert(prog->binderHash == (binder ? script_binder_hash(binder) : 0));
 
@@ -164,6 +281,15 @@ ScriptProgResult script_prog_eval(
   register u32       counter                = 0;
   register const u8* ip                     = ipBegin;
   ScriptVal          regs[script_prog_regs] = {0};
+  ScriptProgBinding  memBindingLocal;
+  if (prog->memKeys.count) {
+    if (!memBinding) {
+      memBinding = &memBindingLocal; // No binding provided; resolve the locations for this eval.
+      prog_mem_bind_reset(prog, m, memBinding);
+    } else if (memBinding->prog != prog || memBinding->mem != m) {
+      prog_mem_bind_reset(prog, m, memBinding);
+    }
+  }
 
   // clang-format off
 
@@ -236,6 +362,12 @@ Dispatch:
   case ScriptOp_MemStore:
     script_mem_store(m, prog_read_u32(&ip[2]), regs[ip[1]]);
     VM_NEXT(6);
+  case ScriptOp_MemLoadSlot:
+    regs[ip[1]] = prog_mem_load_slot(prog, m, memBinding, ip[2]);
+    VM_NEXT(3);
+  case ScriptOp_MemStoreSlot:
+    prog_mem_store_slot(prog, m, memBinding, ip[2], regs[ip[1]]);
+    VM_NEXT(3);
   case ScriptOp_MemLoadDyn:
     if(val_type(regs[ip[1]]) == ScriptType_Str) {
       regs[ip[1]] = script_mem_load(m, val_as_str(regs[ip[1]]));
@@ -391,6 +523,12 @@ bool script_prog_validate(const ScriptProgram* prog, const ScriptBinder* binder)
       if (UNLIKELY((ip += 6) > ipEnd)) return false;
       if (UNLIKELY(!prog_reg_valid(ip[-5]))) return false;
       continue;
+    case ScriptOp_MemLoadSlot:
+    case ScriptOp_MemStoreSlot:
+      if (UNLIKELY((ip += 3) > ipEnd)) return false;
+      if (UNLIKELY(!prog_reg_valid(ip[-2]))) return false;
+      if (UNLIKELY(!prog_mem_slot_valid(prog, ip[-1]))) return false;
+      continue;
     case ScriptOp_MemLoadDyn:
       if (UNLIKELY((ip += 2) > ipEnd)) return false;
       if (UNLIKELY(!prog_reg_valid(ip[-1]))) return false;
@@ -539,6 +677,20 @@ void script_prog_write(const ScriptProgram* prog, DynString* out) {
       }
       dynstring_append_char(out, '\n');
     } break;
+    case ScriptOp_MemLoadSlot:
+    case ScriptOp_MemStoreSlot: {
+      if (UNLIKELY((ip += 3) > ipEnd)) return;
+      const bool   isLoad  = ip[-3] == ScriptOp_MemLoadSlot;
+      const u8     memSlot = ip[-1];
+      const String keyName = memSlot < prog->memKeys.count
+          ? stringtable_lookup(g_stringtable, prog->memKeys.values[memSlot])
+          : string_empty;
+      fmt_write(out, "{} r{} m{}", fmt_text(isLoad ? string_lit("MemLoadSlot") : string_lit("MemStoreSlot")), fmt_int(ip[-2]), fmt_int(memSlot));
+      if (!string_is_empty(keyName)) {
+        fmt_write(out, " '{}'", fmt_text(keyName));
+      }
+      dynstring_append_char(out, '\n');
+    } break;
     case ScriptOp_MemLoadDyn:
       if (UNLIKELY((ip += 2) > ipEnd)) return;
       fmt_write(out, "MemLoadDyn r{}\n", fmt_int(ip[-1]));
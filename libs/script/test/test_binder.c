@@ -41,11 +41,11 @@ spec(binder) {
     script_binder_declare(binder, string_lit("e"), doc, nullSig, null);
     script_binder_finalize(binder);
 
-    check_eq_int(script_binder_slot_lookup(binder, string_hash_lit("b")), 0);
+    check_eq_int(script_binder_slot_lookup(binder, string_hash_lit("e")), 0);
     check_eq_int(script_binder_slot_lookup(binder, string_hash_lit("c")), 1);
     check_eq_int(script_binder_slot_lookup(binder, string_hash_lit("d")), 2);
-    check_eq_int(script_binder_slot_lookup(binder, string_hash_lit("e")), 3);
-    check_eq_int(script_binder_slot_lookup(binder, string_hash_lit("a")), 4);
+    check_eq_int(script_binder_slot_lookup(binder, string_hash_lit("a")), 3);
+    check_eq_int(script_binder_slot_lookup(binder, string_hash_lit("b")), 4);
   }
 
   it("can execute bound functions") {
@@ -36,7 +36,7 @@ spec(doc) {
 
   it("can create load expressions") {
     check_expr_str_lit(
-        doc, script_add_anon_mem_load(doc, string_hash_lit("Hello")), "[mem-load: $938478706]");
+        doc, script_add_anon_mem_load(doc, string_hash_lit("Hello")), "[mem-load: $1836816938]");
   }
 
   it("can create store expressions") {
@@ -44,7 +44,7 @@ spec(doc) {
         doc,
         script_add_anon_mem_store(
             doc, string_hash_lit("Hello"), script_add_anon_value(doc, script_num(42))),
-        "[mem-store: $938478706]\n"
+        "[mem-store: $1836816938]\n"
         "  [value: 42]");
   }
 
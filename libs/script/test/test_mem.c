@@ -100,5 +100,29 @@ spec(mem) {
     check_eq_int(bitset_count(seenVals), KeyCount);
   }
 
+  it("can access values through slots") {
+    const StringHash key = string_hash_lit("test");
+    check(sentinel_check(script_mem_slot_find(&m, key)));
+
+    const u32 slot                = script_mem_slot_insert(&m, key);
+    script_mem_slot_val(&m, slot) = script_num(42);
+
+    check_eq_int(script_mem_slot_find(&m, key), slot);
+    check_eq_val(script_mem_load(&m, key), script_num(42));
+  }
+
+  it("invalidates slots when growing or clearing") {
+    const u32 generation = m.generation;
+    for (u32 i = 0; i != 100; ++i) {
+      const String key = fmt_write_scratch("test_{}", fmt_int(i));
+      script_mem_store(&m, string_hash(key), script_num(i));
+    }
+    check(m.generation != generation);
+
+    const u32 generationPreClear = m.generation;
+    script_mem_clear(&m);
+    check(m.generation != generationPreClear);
+  }
+
   teardown() { script_mem_destroy(&m); }
 }
@@ -15,24 +15,24 @@ spec(optimize) {
         {string_static("1 + 2"), string_static("[value: 3]")},
         {string_static("1 + 2 * 3 + 4"), string_static("[value: 11]")},
         {string_static("vec3(1,2,3)"), string_static("[value: 1, 2, 3]")},
-        {string_static("true ? $a : $b"), string_static("[mem-load: $3645546703]")},
-        {string_static("false ? $a : $b"), string_static("[mem-load: $1612769824]")},
-        {string_static("null ?? $a"), string_static("[mem-load: $3645546703]")},
+        {string_static("true ? $a : $b"), string_static("[mem-load: $3367662820]")},
+        {string_static("false ? $a : $b"), string_static("[mem-load: $4053868413]")},
+        {string_static("null ?? $a"), string_static("[mem-load: $3367662820]")},
         {string_static("1 ?? $a"), string_static("[value: 1]")},
 
         // Null-coalescing memory stores.
         {
             string_static("$a = $a ?? 42"),
             string_static("[intrinsic: null-coalescing]\n"
-                          "  [mem-load: $3645546703]\n"
-                          "  [mem-store: $3645546703]\n"
+                          "  [mem-load: $3367662820]\n"
+                          "  [mem-store: $3367662820]\n"
                           "    [value: 42]"),
         },
         {
             string_static("$a ?\?= 42"),
             string_static("[intrinsic: null-coalescing]\n"
-                          "  [mem-load: $3645546703]\n"
-                          "  [mem-store: $3645546703]\n"
+                          "  [mem-load: $3367662820]\n"
+                          "  [mem-store: $3367662820]\n"
                           "    [value: 42]"),
         },
 
@@ -45,13 +45,13 @@ spec(optimize) {
         // Static key in dynamic mem-load.
         {
             string_static("mem_load(\"a\")"),
-            string_static("[mem-load: $3645546703]"),
+            string_static("[mem-load: $3367662820]"),
         },
 
         // Static key in dynamic mem-store.
         {
             string_static("mem_store(\"a\", 42)"),
-            string_static("[mem-store: $3645546703]\n"
+            string_static("[mem-store: $3367662820]\n"
                           "  [value: 42]"),
         },
 
@@ -67,7 +67,7 @@ spec(optimize) {
         {
             string_static("0; $a = 1; 2"),
             string_static("[block]\n"
-                          "  [mem-store: $3645546703]\n"
+                          "  [mem-store: $3367662820]\n"
                           "    [value: 1]\n"
                           "  [value: 2]"),
         },
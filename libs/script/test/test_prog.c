@@ -1,6 +1,8 @@
 #include "check/spec.h"
 #include "core/alloc.h"
 #include "core/array.h"
+#include "core/dynstring.h"
+#include "core/format.h"
 #include "core/math.h"
 #include "geo/color.h"
 #include "geo/quat.h"
@@ -23,14 +25,15 @@ static ScriptVal test_return_first(void* ctx, ScriptBinderCall* call) {
 }
 
 spec(prog) {
-  ScriptMem      mem;
-  ScriptDoc*     doc             = null;
-  ScriptProgram  prog            = {0};
-  ScriptBinder*  binder          = null;
-  void*          bindCtxNull     = null;
-  StringTable*   stringtableNull = null;
-  ScriptDiagBag* diagsNull       = null;
-  ScriptSymBag*  symsNull        = null;
+  ScriptMem          mem;
+  ScriptDoc*         doc             = null;
+  ScriptProgram      prog            = {0};
+  ScriptBinder*      binder          = null;
+  ScriptProgBinding* memBindingNull  = null;
+  void*              bindCtxNull     = null;
+  StringTable*       stringtableNull = null;
+  ScriptDiagBag*     diagsNull       = null;
+  ScriptSymBag*      symsNull        = null;
 
   setup() {
     mem = script_mem_create();
@@ -330,7 +333,8 @@ spec(prog) {
       check_require_msg(!err, "Compile failed ({})", fmt_text(testData[i].input));
 
       check_require(script_prog_validate(&prog, binder));
-      const ScriptProgResult res = script_prog_eval(&prog, &mem, binder, bindCtxNull);
+      const ScriptProgResult res =
+          script_prog_eval(&prog, &mem, memBindingNull, binder, bindCtxNull);
       check_msg(!res.panic.kind, "!panic ({})", fmt_text(testData[i].input));
       check_msg(
           script_val_equal(res.val, testData[i].expected),
@@ -341,6 +345,110 @@ spec(prog) {
     }
   }
 
+  it("emits type specialized operations for statically known types") {
+    const struct {
+      String input;
+      String expectedOp;
+    } testData[] = {
+        {string_static("1 + 2"), string_static("AddNum")},
+        {string_static("1 - random()"), string_static("SubNum")},
+        {string_static("random() * 2"), string_static("MulNum")},
+        {string_static("1 / (2 + 3)"), string_static("DivNum")},
+        {string_static("1 < 2"), string_static("LessNum")},
+        {string_static("1 >= 2"), string_static("LessNum")},
+        {string_static("1 > 2"), string_static("GreaterNum")},
+        {string_static("up + vec3(1, 2, 3)"), string_static("AddVec3")},
+        {string_static("up - random_sphere()"), string_static("SubVec3")},
+        {string_static("up * 2"), string_static("MulVec3Num")},
+        {string_static("distance(up, down)"), string_static("DistanceVec3")},
+        {string_static("$v2 + 1"), string_static("Add ")},
+        {string_static("up + 1"), string_static("Add ")},
+        {string_static("var i = 1; i + 1"), string_static("Add ")},
+    };
+
+    for (u32 i = 0; i != array_elems(testData); ++i) {
+      const ScriptExpr expr =
+          script_read(doc, binder, testData[i].input, stringtableNull, diagsNull, symsNull);
+      check_require_msg(!sentinel_check(expr), "Read failed ({})", fmt_text(testData[i].input));
+
+      script_prog_clear(&prog, g_allocHeap);
+      const ScriptCompileError err = script_compile(doc, null, expr, g_allocHeap, &prog);
+      check_require_msg(!err, "Compile failed ({})", fmt_text(testData[i].input));
+
+      const String disasm = script_prog_write_scratch(&prog);
+      check_msg(
+          !sentinel_check(string_find_first(disasm, testData[i].expectedOp)),
+          "Missing '{}' op ({})",
+          fmt_text(testData[i].expectedOp),
+          fmt_text(testData[i].input));
+    }
+  }
+
+  it("can access memory keys beyond the memory-slot limit") {
+    enum { KeyCount = script_prog_mem_slots_max + 16 }; // NOTE: Limited by the max block size.
+
+    DynString input = dynstring_create(g_allocHeap, 1024);
+    for (u32 i = 0; i != KeyCount; ++i) {
+      fmt_write(&input, "$key_{} = {};", fmt_int(i), fmt_int(i));
+    }
+    dynstring_append(&input, string_lit("var sum = 0;"));
+    for (u32 i = 0; i != KeyCount; i += 2) {
+      fmt_write(&input, "sum += $key_{} + $key_{};", fmt_int(i), fmt_int(i + 1));
+    }
+    dynstring_append(&input, string_lit("sum"));
+
+    const String     inputStr = dynstring_view(&input);
+    const ScriptExpr expr =
+        script_read(doc, binder, inputStr, stringtableNull, diagsNull, symsNull);
+    check_require(!sentinel_check(expr));
+    check_require(!script_compile(doc, null, expr, g_allocHeap, &prog));
+    check_require(script_prog_validate(&prog, binder));
+    check_eq_int(prog.memKeys.count, script_prog_mem_slots_max);
+
+    const String disasm = script_prog_write_scratch(&prog);
+    check(!sentinel_check(string_find_first(disasm, string_lit("MemStoreSlot"))));
+    check(!sentinel_check(string_find_first(disasm, string_lit("MemLoadSlot"))));
+    check(!sentinel_check(string_find_first(disasm, string_lit("MemLoad "))));
+
+    const ScriptProgResult res =
+        script_prog_eval(&prog, &mem, memBindingNull, binder, bindCtxNull);
+    check(!res.panic.kind);
+    check(script_val_equal(res.val, script_num((KeyCount - 1) * KeyCount / 2)));
+
+    dynstring_destroy(&input);
+  }
+
+  it("reuses the resolved memory locations across evaluations") {
+    const ScriptExpr expr =
+        script_read(doc, binder, string_lit("$v1"), stringtableNull, diagsNull, symsNull);
+    check_require(!sentinel_check(expr));
+    check_require(!script_compile(doc, null, expr, g_allocHeap, &prog));
+    check_require(script_prog_validate(&prog, binder));
+    check_require(prog.memKeys.count == 1);
+
+    ScriptProgBinding memBinding = {0};
+    ScriptProgResult  res = script_prog_eval(&prog, &mem, &memBinding, binder, bindCtxNull);
+    check(script_val_equal(res.val, script_bool(true)));
+    check_eq_int(memBinding.locations[0], script_mem_slot_find(&mem, string_hash_lit("v1")));
+
+    /**
+     * Point the resolved location to a different key; as a repeated evaluation does not lookup the
+     * key again it observes the value of the other key.
+     */
+    memBinding.locations[0] = script_mem_slot_find(&mem, string_hash_lit("v2"));
+    res = script_prog_eval(&prog, &mem, &memBinding, binder, bindCtxNull);
+    check(script_val_equal(res.val, script_num(1337)));
+
+    // Growing the memory changes the generation, which re-resolves the locations.
+    for (u32 i = 0; i != 64; ++i) {
+      script_mem_store(&mem, string_hash(fmt_write_scratch("grow_{}", fmt_int(i))), script_num(i));
+    }
+    check(memBinding.generation != mem.generation);
+    res = script_prog_eval(&prog, &mem, &memBinding, binder, bindCtxNull);
+    check(script_val_equal(res.val, script_bool(true)));
+    check_eq_int(memBinding.generation, mem.generation);
+  }
+
   teardown() {
     script_destroy(doc);
     script_prog_destroy(&prog, g_allocHeap);
@@ -39,20 +39,20 @@ spec(read) {
         {string_static("null"), string_static("[value: null]")},
         {string_static("42.1337"), string_static("[value: 42.1337]")},
         {string_static("true"), string_static("[value: true]")},
-        {string_static("$hello"), string_static("[mem-load: $3944927369]")},
+        {string_static("$hello"), string_static("[mem-load: $1261314649]")},
         {string_static("\"Hello World\""), string_static("[value: Hello World]")},
         {string_static("pi"), string_static("[value: 3.1415927]")},
         {string_static("deg_to_rad"), string_static("[value: 0.0174533]")},
         {string_static("rad_to_deg"), string_static("[value: 57.2957802]")},
         {
             string_static("$hello = 42"),
-            string_static("[mem-store: $3944927369]\n"
+            string_static("[mem-store: $1261314649]\n"
                           "  [value: 42]"),
         },
         {
             string_static("$hello = $world"),
-            string_static("[mem-store: $3944927369]\n"
-                          "  [mem-load: $4293346878]"),
+            string_static("[mem-store: $1261314649]\n"
+                          "  [mem-load: $1940735083]"),
         },
         {
             string_static("distance(1,2)"),
@@ -190,9 +190,9 @@ spec(read) {
 
         // Parenthesized expressions.
         {string_static("(42.1337)"), string_static("[value: 42.1337]")},
-        {string_static("($hello)"), string_static("[mem-load: $3944927369]")},
+        {string_static("($hello)"), string_static("[mem-load: $1261314649]")},
         {string_static("((42.1337))"), string_static("[value: 42.1337]")},
-        {string_static("(($hello))"), string_static("[mem-load: $3944927369]")},
+        {string_static("(($hello))"), string_static("[mem-load: $1261314649]")},
 
         // If expressions.
         {
@@ -483,7 +483,7 @@ spec(read) {
         {
             string_static("$hello != null"),
             string_static("[intrinsic: not-equal]\n"
-                          "  [mem-load: $3944927369]\n"
+                          "  [mem-load: $1261314649]\n"
                           "  [value: null]"),
         },
         {
@@ -662,44 +662,44 @@ spec(read) {
         // Memory modify expressions.
         {
             string_static("$hello += 42"),
-            string_static("[mem-store: $3944927369]\n"
+            string_static("[mem-store: $1261314649]\n"
                           "  [intrinsic: add]\n"
-                          "    [mem-load: $3944927369]\n"
+                          "    [mem-load: $1261314649]\n"
                           "    [value: 42]"),
         },
         {
             string_static("$hello -= 42"),
-            string_static("[mem-store: $3944927369]\n"
+            string_static("[mem-store: $1261314649]\n"
                           "  [intrinsic: sub]\n"
-                          "    [mem-load: $3944927369]\n"
+                          "    [mem-load: $1261314649]\n"
                           "    [value: 42]"),
         },
         {
             string_static("$hello *= 42"),
-            string_static("[mem-store: $3944927369]\n"
+            string_static("[mem-store: $1261314649]\n"
                           "  [intrinsic: mul]\n"
-                          "    [mem-load: $3944927369]\n"
+                          "    [mem-load: $1261314649]\n"
                           "    [value: 42]"),
         },
         {
             string_static("$hello /= 42"),
-            string_static("[mem-store: $3944927369]\n"
+            string_static("[mem-store: $1261314649]\n"
                           "  [intrinsic: div]\n"
-                          "    [mem-load: $3944927369]\n"
+                          "    [mem-load: $1261314649]\n"
                           "    [value: 42]"),
         },
         {
             string_static("$hello %= 42"),
-            string_static("[mem-store: $3944927369]\n"
+            string_static("[mem-store: $1261314649]\n"
                           "  [intrinsic: mod]\n"
-                          "    [mem-load: $3944927369]\n"
+                          "    [mem-load: $1261314649]\n"
                           "    [value: 42]"),
         },
         {
             string_static("$hello ?\?= 42"),
-            string_static("[mem-store: $3944927369]\n"
+            string_static("[mem-store: $1261314649]\n"
                           "  [intrinsic: null-coalescing]\n"
-                          "    [mem-load: $3944927369]\n"
+                          "    [mem-load: $1261314649]\n"
                           "    [value: 42]"),
         },
 
@@ -777,7 +777,7 @@ spec(read) {
         },
         {
             string_static("$hello = 1 + 2"),
-            string_static("[mem-store: $3944927369]\n"
+            string_static("[mem-store: $1261314649]\n"
                           "  [intrinsic: add]\n"
                           "    [value: 1]\n"
                           "    [value: 2]"),
@@ -794,8 +794,8 @@ spec(read) {
         },
         {
             string_static("$hello = $world = 1 + 2"),
-            string_static("[mem-store: $3944927369]\n"
-                          "  [mem-store: $4293346878]\n"
+            string_static("[mem-store: $1261314649]\n"
+                          "  [mem-store: $1940735083]\n"
                           "    [intrinsic: add]\n"
                           "      [value: 1]\n"
                           "      [value: 2]"),
@@ -806,10 +806,10 @@ spec(read) {
                           "  [intrinsic: logic-or]\n"
                           "    [value: true]\n"
                           "    [block]\n"
-                          "      [mem-store: $3645546703]\n"
+                          "      [mem-store: $3367662820]\n"
                           "        [value: 1]\n"
                           "      [value: false]\n"
-                          "  [mem-load: $3645546703]"),
+                          "  [mem-load: $3367662820]"),
         },
 
         // Group expressions.
@@ -843,11 +843,11 @@ spec(read) {
         {
             string_static("$a = 1; $b = 2; $c = 3"),
             string_static("[block]\n"
-                          "  [mem-store: $3645546703]\n"
+                          "  [mem-store: $3367662820]\n"
                           "    [value: 1]\n"
-                          "  [mem-store: $1612769824]\n"
+                          "  [mem-store: $4053868413]\n"
                           "    [value: 2]\n"
-                          "  [mem-store: $1857025631]\n"
+                          "  [mem-store: $2011564974]\n"
                           "    [value: 3]"),
         },
         {
@@ -10,6 +10,14 @@ ecs_comp_extern(SndMixerComp);
 
 typedef u32 SndObjectId;
 
+/**
+ * Common object priorities.
+ */
+enum {
+  SndPriority_Interface = 200,    // Interface feedback sounds, should always be audible.
+  SndPriority_Music     = u8_max, // Music should never be virtualized.
+};
+
 /**
  * Initialize the sound mixer.
  */
@@ -17,8 +25,14 @@ SndMixerComp* snd_mixer_init(EcsWorld*);
 
 /**
  * Object apis.
+ *
+ * Objects with a higher priority are preferred when selecting which objects to mix, lower priority
+ * and inaudible objects become virtual (only their cursor is tracked). When no objects are free a
+ * new object can take over the object of a lower priority (non-looping) sound; virtual and silent
+ * objects are taken over immediately, audible objects are faded out first (and the request fails).
+ * NOTE: Zero is the lowest priority.
  */
-SndResult snd_object_new(SndMixerComp*, SndObjectId* outId);
+SndResult snd_object_new(SndMixerComp*, u8 priority, SndObjectId* outId);
 SndResult snd_object_stop(SndMixerComp*, SndObjectId);
 bool      snd_object_is_active(const SndMixerComp*, SndObjectId);
 bool      snd_object_is_loading(const SndMixerComp*, SndObjectId);
@@ -28,6 +42,8 @@ u32       snd_object_get_frame_count(const SndMixerComp*, SndObjectId);
 u32       snd_object_get_frame_rate(const SndMixerComp*, SndObjectId);
 u8        snd_object_get_frame_channels(const SndMixerComp*, SndObjectId);
 f64       snd_object_get_cursor(const SndMixerComp*, SndObjectId);
+u8        snd_object_get_priority(const SndMixerComp*, SndObjectId);
+bool      snd_object_is_virtual(const SndMixerComp*, SndObjectId);
 f32       snd_object_get_pitch(const SndMixerComp*, SndObjectId);
 f32       snd_object_get_gain(const SndMixerComp*, SndObjectId, SndChannel);
 SndResult snd_object_set_asset(SndMixerComp*, SndObjectId, EcsEntityId asset);
@@ -63,6 +79,11 @@ String        snd_mixer_device_id(const SndMixerComp*);
 String        snd_mixer_device_backend(const SndMixerComp*);
 String        snd_mixer_device_state(const SndMixerComp*);
 u64           snd_mixer_device_underruns(const SndMixerComp*);
+TimeDuration  snd_mixer_render_duration(const SndMixerComp*);     // Average period render time.
+TimeDuration  snd_mixer_render_duration_max(const SndMixerComp*); // Recent maximum render time.
+TimeDuration  snd_mixer_render_budget(const SndMixerComp*);       // Duration of a sound period.
 u32           snd_mixer_objects_playing(const SndMixerComp*);
+u32           snd_mixer_objects_real(const SndMixerComp*);    // Playing objects that are mixed.
+u32           snd_mixer_objects_virtual(const SndMixerComp*); // Playing objects that are not mixed.
 u32           snd_mixer_objects_allocated(const SndMixerComp*);
 SndBufferView snd_mixer_history(const SndMixerComp*);
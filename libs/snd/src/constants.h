@@ -5,3 +5,5 @@
 #define snd_frame_sample_alignment 16
 #define snd_frame_count_alignment 4
 #define snd_frame_count_max (2048 * 3)
+#define snd_mixer_gain_adjust_per_frame 0.00025f
+#define snd_mixer_pitch_adjust_per_frame 0.00025f
@@ -0,0 +1,267 @@
+#include "core/adpcm.h"
+#include "core/bits.h"
+#include "core/diag.h"
+#include "core/math.h"
+
+#include "constants.h"
+#include "mix.h"
+
+#ifdef VOLO_SIMD
+#include "core/simd.h"
+#endif
+
+ASSERT(SndChannel_Count == 2, "Only stereo sound is supported at the moment");
+ASSERT(bits_aligned(snd_mix_block_frames, 4), "Block size needs to be a multiple of 4");
+ASSERT((snd_mix_ring_frames & (snd_mix_ring_frames - 1)) == 0, "Ring size has to be a power of 2");
+ASSERT(bits_aligned(snd_mix_ring_frames, adpcm_block_frames), "Ring has to fit whole blocks");
+ASSERT(snd_mix_ring_frames >= adpcm_block_frames * 2, "Ring has to fit at least two blocks");
+
+usize snd_mix_ring_size(const u8 frameChannels) {
+  return sizeof(f32) * snd_mix_ring_frames * frameChannels;
+}
+
+/**
+ * Compute the parameter value for each frame in the block while moving it towards the target.
+ * The change per frame is limited to 'deltaMax', which results in a linear ramp that is clamped to
+ * the target. Returns the value at the last frame.
+ * NOTE: Writes the output rounded up to a multiple of 4 frames.
+ */
+static f32 snd_mix_ramp(
+    const f32 actual, const f32 target, const f32 deltaMax, f32* restrict out, const u32 count) {
+  const f32 diff = target - actual;
+#ifdef VOLO_SIMD
+  const SimdVec actualVec = simd_vec_broadcast(actual);
+  const SimdVec diffVec   = simd_vec_broadcast(diff);
+  const SimdVec stepVec   = simd_vec_broadcast(deltaMax * 4.0f);
+  SimdVec       limitVec  = simd_vec_mul(simd_vec_set(1, 2, 3, 4), simd_vec_broadcast(deltaMax));
+  for (u32 i = 0; i < count; i += 4) {
+    const SimdVec clamped = simd_vec_max(simd_vec_min(diffVec, limitVec), simd_vec_neg(limitVec));
+    simd_vec_store(simd_vec_add(actualVec, clamped), out + i);
+    limitVec = simd_vec_add(limitVec, stepVec);
+  }
+#else
+  for (u32 i = 0; i != count; ++i) {
+    const f32 limit = deltaMax * (f32)(i + 1);
+    out[i]          = actual + math_clamp_f32(diff, -limit, limit);
+  }
+#endif
+  const f32 limit = deltaMax * (f32)count;
+  return actual + math_clamp_f32(diff, -limit, limit);
+}
+
+/**
+ * Linearly interpolate between the a and b values.
+ * NOTE: Writes the output rounded up to a multiple of 4 frames.
+ */
+static void snd_mix_lerp(
+    const f32* restrict a,
+    const f32* restrict b,
+    const f32* restrict frac,
+    f32* restrict out,
+    const u32 count) {
+#ifdef VOLO_SIMD
+  for (u32 i = 0; i < count; i += 4) {
+    const SimdVec valA = simd_vec_load(a + i);
+    const SimdVec valB = simd_vec_load(b + i);
+    const SimdVec t    = simd_vec_load(frac + i);
+    simd_vec_store(simd_vec_add(valA, simd_vec_mul(simd_vec_sub(valB, valA), t)), out + i);
+  }
+#else
+  for (u32 i = 0; i != count; ++i) {
+    out[i] = math_lerp(a[i], b[i], frac[i]);
+  }
+#endif
+}
+
+/**
+ * Make sure the given frame and its successor are decoded in the ring buffer.
+ * Decoding continues from the end of the ring, on a seek (or loop) decoding restarts at the block
+ * that contains the frame.
+ */
+static void snd_mix_ring_fetch(const SndMixVoice* v, const u32 frame) {
+  SndMixRing* ring = v->ring;
+  if (frame < ring->begin || frame > ring->end) {
+    ring->begin = ring->end = frame / adpcm_block_frames * adpcm_block_frames;
+  }
+  const usize blockSize = adpcm_block_size(v->frameChannels);
+  const u8*   data      = v->data;
+  while (ring->end <= frame + 1) {
+    const u32 block = ring->end / adpcm_block_frames;
+    const Mem src   = mem_create(data + blockSize * block, blockSize);
+    f32*      dst   = ring->samples + (ring->end & (snd_mix_ring_frames - 1)) * v->frameChannels;
+    adpcm_decode_block(src, v->frameChannels, dst);
+
+    ring->end += adpcm_block_frames;
+    if (ring->end - ring->begin > snd_mix_ring_frames) {
+      ring->begin = ring->end - snd_mix_ring_frames;
+    }
+  }
+}
+
+/**
+ * Gather the samples at (A) and after (B) the given edges for both channels.
+ * NOTE: The right channel is only written for stereo voices.
+ */
+static void snd_mix_gather(
+    const SndMixVoice* v,
+    const u32* restrict edges,
+    f32* restrict leftA,
+    f32* restrict leftB,
+    f32* restrict rightA,
+    f32* restrict rightB,
+    const u32 count) {
+  static const f32 g_i16MaxInv = 1.0f / i16_max;
+
+  const u32  stride = v->frameChannels;
+  const bool stereo = stride > 1;
+  switch (v->format) {
+  case SndMixFormat_i16: {
+    const i16* samples = v->data;
+    for (u32 i = 0; i != count; ++i) {
+      const u32 index = edges[i] * stride;
+      leftA[i]        = samples[index] * g_i16MaxInv;
+      leftB[i]        = samples[index + stride] * g_i16MaxInv;
+      if (stereo) {
+        rightA[i] = samples[index + 1] * g_i16MaxInv;
+        rightB[i] = samples[index + stride + 1] * g_i16MaxInv;
+      }
+    }
+    return;
+  }
+  case SndMixFormat_Adpcm: {
+    const SndMixRing* ring = v->ring;
+    for (u32 i = 0; i != count; ++i) {
+      const u32 edge = edges[i];
+      if (UNLIKELY(edge < ring->begin || edge + 1 >= ring->end)) {
+        snd_mix_ring_fetch(v, edge);
+      }
+      const f32* a = ring->samples + (edge & (snd_mix_ring_frames - 1)) * stride;
+      const f32* b = ring->samples + ((edge + 1) & (snd_mix_ring_frames - 1)) * stride;
+      leftA[i]     = a[0];
+      leftB[i]     = b[0];
+      if (stereo) {
+        rightA[i] = a[1];
+        rightB[i] = b[1];
+      }
+    }
+    return;
+  }
+  }
+  UNREACHABLE
+}
+
+/**
+ * Resample the voice at the given positions.
+ *
+ * Naive sampling using linear interpolation between the two closest samples.
+ * This works reasonably for up-sampling (even though we should consider methods that preserve the
+ * curve better, like Hermite interpolation), but for down-sampling this ignores the aliasing that
+ * occurs with frequencies that we cannot represent.
+ *
+ * NOTE: The right channel is only written for stereo voices.
+ */
+static void snd_mix_resample(
+    const SndMixVoice* v,
+    const u32* restrict edges,
+    const f32* restrict fracs,
+    f32* restrict outLeft,
+    f32* restrict outRight,
+    const u32 count) {
+  ALIGNAS(16) f32 leftA[snd_mix_block_frames];
+  ALIGNAS(16) f32 leftB[snd_mix_block_frames];
+  ALIGNAS(16) f32 rightA[snd_mix_block_frames];
+  ALIGNAS(16) f32 rightB[snd_mix_block_frames];
+
+  snd_mix_gather(v, edges, leftA, leftB, rightA, rightB, count);
+
+  snd_mix_lerp(leftA, leftB, fracs, outLeft, count);
+  if (v->frameChannels > 1) {
+    snd_mix_lerp(rightA, rightB, fracs, outRight, count);
+  }
+}
+
+/**
+ * Multiply the samples by the gains and add them to the interleaved output frames.
+ */
+static void snd_mix_accumulate(
+    SndBufferFrame* restrict out,
+    const f32* restrict left,
+    const f32* restrict right,
+    const f32* restrict gainLeft,
+    const f32* restrict gainRight,
+    const u32 count) {
+  u32 i = 0;
+#ifdef VOLO_SIMD
+  for (; i + 4 <= count; i += 4) {
+    const SimdVec valLeft  = simd_vec_mul(simd_vec_load(left + i), simd_vec_load(gainLeft + i));
+    const SimdVec valRight = simd_vec_mul(simd_vec_load(right + i), simd_vec_load(gainRight + i));
+
+    f32* dst = out[i].samples; // 4 frames; LRLR LRLR.
+    const SimdVec lo = simd_vec_interleave_lo(valLeft, valRight);
+    const SimdVec hi = simd_vec_interleave_hi(valLeft, valRight);
+    simd_vec_store_unaligned(simd_vec_add(simd_vec_load_unaligned(dst), lo), dst);
+    simd_vec_store_unaligned(simd_vec_add(simd_vec_load_unaligned(dst + 4), hi), dst + 4);
+  }
+#endif
+  for (; i != count; ++i) {
+    out[i].samples[SndChannel_Left] += left[i] * gainLeft[i];
+    out[i].samples[SndChannel_Right] += right[i] * gainRight[i];
+  }
+}
+
+bool snd_mix_render(SndMixVoice* v, const SndBuffer out) {
+  diag_assert(v->frameCount >= 2);
+  diag_assert(v->format != SndMixFormat_Adpcm || v->ring);
+
+  const f64 advancePerFrame = v->frameRate / (f64)out.frameRate;
+
+  ALIGNAS(16) f32 pitch[snd_mix_block_frames];
+  ALIGNAS(16) f32 gainLeft[snd_mix_block_frames];
+  ALIGNAS(16) f32 gainRight[snd_mix_block_frames];
+  ALIGNAS(16) f32 fracs[snd_mix_block_frames];
+  ALIGNAS(16) f32 left[snd_mix_block_frames];
+  ALIGNAS(16) f32 right[snd_mix_block_frames];
+  u32             edges[snd_mix_block_frames];
+
+  for (u32 blockStart = 0; blockStart < out.frameCount; blockStart += snd_mix_block_frames) {
+    u32 frames = math_min(snd_mix_block_frames, out.frameCount - blockStart);
+
+    // Compute the parameter ramps for the block.
+    const f32 pitchDelta = snd_mixer_pitch_adjust_per_frame;
+    const f32 gainDelta  = snd_mixer_gain_adjust_per_frame;
+    v->pitch     = snd_mix_ramp(v->pitch, v->pitchTarget, pitchDelta, pitch, frames);
+    v->gainLeft  = snd_mix_ramp(v->gainLeft, v->gainLeftTarget, gainDelta, gainLeft, frames);
+    v->gainRight = snd_mix_ramp(v->gainRight, v->gainRightTarget, gainDelta, gainRight, frames);
+
+    // Compute the sample positions for the block.
+    bool finished = false;
+    for (u32 i = 0; i != frames; ++i) {
+      const u32 edge = math_min(v->frameCount - 2, (u32)v->cursor);
+      edges[i]       = edge;
+      fracs[i]       = (f32)(v->cursor - edge);
+
+      v->cursor += advancePerFrame * (f64)pitch[i];
+      if (UNLIKELY(v->cursor >= v->frameCount)) {
+        if (v->looping) {
+          v->cursor -= v->frameCount;
+        } else {
+          frames   = i + 1; // Finished playing; only render the block up to this frame.
+          finished = true;
+          break;
+        }
+      }
+    }
+
+    // Resample and accumulate the block.
+    snd_mix_resample(v, edges, fracs, left, right, frames);
+    // Mono sounds use the same samples for both channels.
+    const f32*      rightSamples = v->frameChannels > 1 ? right : left;
+    SndBufferFrame* blockOut     = out.frames + blockStart;
+    snd_mix_accumulate(blockOut, left, rightSamples, gainLeft, gainRight, frames);
+
+    if (finished) {
+      return false;
+    }
+  }
+  return true;
+}
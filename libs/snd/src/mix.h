@@ -0,0 +1,59 @@
+#pragma once
+#include "snd/buffer.h"
+
+/**
+ * Amount of frames that are rendered per block; parameter ramps and sample positions are computed
+ * for a whole block before the samples are resampled and accumulated.
+ */
+#define snd_mix_block_frames 64
+
+/**
+ * Amount of decoded frames that are kept for voices that are decoded on the fly.
+ * NOTE: Needs to be a power-of-two and a multiple of the adpcm block size.
+ */
+#define snd_mix_ring_frames 1024
+
+typedef enum {
+  SndMixFormat_i16,   // i16[frameCount * frameChannels], Interleaved (LRLRLR).
+  SndMixFormat_Adpcm, // Ima adpcm blocks, see 'core/adpcm.h'.
+} SndMixFormat;
+
+/**
+ * Ring buffer of decoded frames, used to stream compressed sounds.
+ * Contains the frames in the [begin, end) range, frame 'i' is stored at slot 'i % ringFrames'.
+ * NOTE: Blocks are decoded lazily as the cursor moves through the sound, this means only the parts
+ * of the (possibly memory-mapped) source data that are being played have to be resident.
+ */
+typedef struct {
+  u32  begin, end;
+  f32* samples; // f32[snd_mix_ring_frames * frameChannels], Interleaved (LRLRLR).
+} SndMixRing;
+
+/**
+ * Single sound source that is being mixed into an output buffer.
+ */
+typedef struct {
+  SndMixFormat format;
+  const void*  data;
+  SndMixRing*  ring; // Only needed for the adpcm format.
+  u32          frameCount, frameRate;
+  u8           frameChannels;
+  bool         looping;
+  f64          cursor; // In frames.
+  f32          pitch, gainLeft, gainRight;
+  f32          pitchTarget, gainLeftTarget, gainRightTarget;
+} SndMixVoice;
+
+/**
+ * Size (in bytes) of the ring buffer samples for a voice with the given amount of channels.
+ */
+usize snd_mix_ring_size(u8 frameChannels);
+
+/**
+ * Render the voice additively into the given buffer.
+ * Parameters ramp towards their targets with at most the per-frame adjust limit.
+ * NOTE: Returns false if the voice finished playing (never happens for looping voices).
+ *
+ * Pre-condition: voice->frameCount >= 2.
+ */
+bool snd_mix_render(SndMixVoice*, SndBuffer out);
@@ -7,6 +7,7 @@
 #include "core/float.h"
 #include "core/math.h"
 #include "core/rng.h"
+#include "core/sort.h"
 #include "ecs/entity.h"
 #include "ecs/view.h"
 #include "ecs/world.h"
@@ -17,6 +18,7 @@
 
 #include "constants.h"
 #include "device.h"
+#include "mix.h"
 
 #ifdef VOLO_SIMD
 #include "core/simd.h"
@@ -32,13 +34,14 @@ ASSERT(
     "Sound buffers should be cache-line aligned");
 
 #define snd_mixer_buffer_count 3
-#define snd_mixer_gain_adjust_per_frame 0.00025f
-#define snd_mixer_pitch_adjust_per_frame 0.00025f
 #define snd_mixer_pitch_min 0.1f
 #define snd_mixer_limiter_release_per_frame 0.000025f
 #define snd_mimer_limiter_closed_frames 1024
 #define snd_mixer_limiter_max 0.75f
 #define snd_mixer_warmup_ticks 16
+#define snd_mixer_render_stats_window 64 // In periods.
+#define snd_mixer_voices_real_max 128
+#define snd_mixer_audible_threshold 0.001f // Objects with a lower gain are always virtual.
 
 typedef enum {
   SndObjectPhase_Idle,
@@ -53,6 +56,8 @@ typedef enum {
   SndObjectFlags_Looping      = 1 << 1,
   SndObjectFlags_RandomCursor = 1 << 2,
   SndObjectFlags_DelayedSetup = 1 << 3,
+  SndObjectFlags_Virtual      = 1 << 4, // Only the cursor is tracked; not being mixed.
+  SndObjectFlags_Demoting     = 1 << 5, // Fading out before becoming virtual; still being mixed.
 } SndObjectFlags;
 
 typedef enum {
@@ -70,10 +75,13 @@ typedef struct {
   SndObjectPhase phase : 8;
   SndObjectFlags flags : 8;
   u8             frameChannels;
+  u8             priority;
   u16            generation; // NOTE: Expected to wrap when the object is reused often.
+  SndMixFormat   format : 8;
   u32            frameCount, frameRate;
-  const f32*     samples; // f32[frameCount * frameChannels], Interleaved (LRLRLR).
-  f64            cursor;  // In frames.
+  const void*    data;   // Encoded samples, layout depends on the format.
+  f64            cursor; // In frames.
+  SndMixRing     ring;   // Decoded frames, only used for compressed formats.
   ALIGNAS(16) f32 paramActual[SndObjectParam_Count];
   ALIGNAS(16) f32 paramSetting[SndObjectParam_Count];
 } SndObject;
@@ -89,6 +97,18 @@ ecs_comp_define(SndMixerComp) {
   u16          deviceRenderedFrames;  // How many frames are rendered in the buffer.
   TimeDuration deviceTimeHead;        // Timestamp of last rendered sound.
 
+  /**
+   * Render duration stats, used to verify that rendering stays well within the period duration.
+   */
+  TimeSteady   renderStart;      // Timestamp at which rendering of the current period started.
+  TimeDuration renderDurAvg;     // Moving average of the time it took to render a period.
+  TimeDuration renderDurMax;     // Maximum render time in the last completed stats window.
+  TimeDuration renderDurPeak;    // Maximum render time in the current stats window.
+  TimeDuration renderPeriodDur;  // Duration of the sound in the last rendered period.
+  u32          renderWindowLeft; // Amount of periods left in the current stats window.
+
+  u16 objectsReal, objectsVirtual; // Result of the last virtualization pass.
+
   SndObject*   objects;        // SndObject[snd_mixer_objects_max]
   String*      objectNames;    // String[snd_mixer_objects_max]
   EcsEntityId* objectAssets;   // EcsEntityId[snd_mixer_objects_max]
@@ -102,18 +122,41 @@ ecs_comp_define(SndMixerComp) {
   DynArray persistentAssets;          // EcsEntityId[], sorted on the id using 'ecs_compare_entity'.
   DynArray persistentAssetsToAcquire; // EcsEntityId[], array of new persistent assets to acquire.
 
+  DynArray assetsToRelease; // EcsEntityId[], assets of objects that were taken over.
+
   /**
    * Float sample buffers to accumulate into before outputting to the device.
    */
   SndBufferFrame* bufferFrames; // SndBufferFrame[snd_frame_count_max][snd_mixer_buffer_count].
 };
 
+static SndMixFormat snd_object_format(const AssetSoundFormat format) {
+  switch (format) {
+  case AssetSoundFormat_i16:
+    return SndMixFormat_i16;
+  case AssetSoundFormat_Adpcm:
+    return SndMixFormat_Adpcm;
+  }
+  diag_crash();
+}
+
+static void snd_object_ring_free(SndObject* obj) {
+  if (obj->ring.samples) {
+    const usize ringSize = snd_mix_ring_size(obj->frameChannels);
+    alloc_free(g_allocHeap, mem_create(obj->ring.samples, ringSize));
+    obj->ring = (SndMixRing){0};
+  }
+}
+
 static void ecs_destruct_mixer_comp(void* data) {
   SndMixerComp* m = data;
   if (m->device) {
     snd_device_destroy(m->device);
   }
 
+  for (u32 i = 0; i != snd_mixer_objects_max; ++i) {
+    snd_object_ring_free(&m->objects[i]);
+  }
   alloc_free_array_t(g_allocHeap, m->objects, snd_mixer_objects_max);
   alloc_free_array_t(g_allocHeap, m->objectNames, snd_mixer_objects_max);
   alloc_free_array_t(g_allocHeap, m->objectAssets, snd_mixer_objects_max);
@@ -122,6 +165,7 @@ static void ecs_destruct_mixer_comp(void* data) {
 
   dynarray_destroy(&m->persistentAssets);
   dynarray_destroy(&m->persistentAssetsToAcquire);
+  dynarray_destroy(&m->assetsToRelease);
 
   alloc_free_array_t(g_allocHeap, m->bufferFrames, snd_frame_count_max * snd_mixer_buffer_count);
 }
@@ -166,6 +210,135 @@ static void snd_object_release(SndMixerComp* m, const SndObject* obj) {
   bitset_set(m->objectFreeSet, index);
 }
 
+static void snd_object_cleanup(SndMixerComp* m, SndObject* obj) {
+  const u16 index = (u16)(obj - m->objects);
+  snd_object_release(m, obj);
+  snd_object_ring_free(obj);
+  *obj                     = (SndObject){.generation = obj->generation};
+  m->objectNames[index]    = string_empty;
+  m->objectAssets[index]   = 0;
+  m->objectUserData[index] = sentinel_u64;
+}
+
+static bool snd_object_is_silent(const SndObject* obj) {
+  if (obj->paramActual[SndObjectParam_GainLeft] > f32_epsilon) {
+    return false;
+  }
+  if (obj->paramActual[SndObjectParam_GainRight] > f32_epsilon) {
+    return false;
+  }
+  return true;
+}
+
+typedef struct {
+  u8  priority;
+  f32 audibility;
+  u16 index;
+} SndObjectRank;
+
+/**
+ * Audibility of the object based on its gain settings.
+ * NOTE: Uses the settings instead of the actual (ramping) gains, otherwise promoted objects that are
+ * fading in would rank below the real objects they are competing with.
+ */
+static f32 snd_object_audibility(const SndObject* obj) {
+  const bool pitchTooLow  = obj->paramSetting[SndObjectParam_Pitch] <= snd_mixer_pitch_min;
+  const f32  gainMult     = pitchTooLow ? 0.0f : 1.0f;
+  const f32  settingLeft  = obj->paramSetting[SndObjectParam_GainLeft] * gainMult;
+  const f32  settingRight = obj->paramSetting[SndObjectParam_GainRight] * gainMult;
+  return math_max(settingLeft, settingRight);
+}
+
+static SndObjectRank snd_object_rank(const SndMixerComp* m, const SndObject* obj) {
+  return (SndObjectRank){
+      .priority   = obj->priority,
+      .audibility = snd_object_audibility(obj),
+      .index      = (u16)(obj - m->objects),
+  };
+}
+
+/**
+ * Compare object ranks, higher priority first and for equal priorities the most audible first.
+ */
+static i8 snd_object_rank_compare(const void* a, const void* b) {
+  const SndObjectRank* rankA = a;
+  const SndObjectRank* rankB = b;
+
+  const i8 order = compare_u8_reverse(&rankA->priority, &rankB->priority);
+  return order ? order : compare_f32_reverse(&rankA->audibility, &rankB->audibility);
+}
+
+/**
+ * Promote or demote the object.
+ * Demoted objects keep being mixed while their gain ramps to zero (to avoid clicks), they become
+ * virtual once they are silent. Promoted objects fade-in from zero to avoid starting mid-waveform.
+ */
+static void snd_object_virtual_set(SndObject* obj, const bool virtual) {
+  if (virtual) {
+    if (obj->flags & SndObjectFlags_Virtual) {
+      return; // Already virtual.
+    }
+    if (snd_object_is_silent(obj)) {
+      obj->flags &= ~SndObjectFlags_Demoting;
+      obj->flags |= SndObjectFlags_Virtual;
+    } else {
+      obj->flags |= SndObjectFlags_Demoting;
+    }
+    return;
+  }
+  obj->flags &= ~SndObjectFlags_Demoting; // Still mixed; ramps back to its gain setting.
+  if (obj->flags & SndObjectFlags_Virtual) {
+    obj->paramActual[SndObjectParam_GainLeft]  = 0.0f;
+    obj->paramActual[SndObjectParam_GainRight] = 0.0f;
+    obj->flags &= ~SndObjectFlags_Virtual;
+  }
+}
+
+/**
+ * Make room for a new object by stopping the lowest ranked (preferably virtual) object that has a
+ * lower priority. Returns true if the object was released immediately; objects that are not being
+ * mixed (virtual or silent) can be released without an audible click, others are faded out first.
+ * NOTE: Looping objects are never stolen as their owners expect them to keep playing.
+ */
+static bool snd_object_steal(SndMixerComp* m, const u8 priority) {
+  SndObject*    victim        = null;
+  SndObjectRank victimRank    = {0};
+  bool          victimVirtual = false;
+  for (u32 i = 0; i != snd_mixer_objects_max; ++i) {
+    SndObject* obj = &m->objects[i];
+    if (obj->phase != SndObjectPhase_Playing || obj->priority >= priority) {
+      continue;
+    }
+    if (obj->flags & (SndObjectFlags_Stop | SndObjectFlags_Looping)) {
+      continue;
+    }
+    const SndObjectRank rank    = snd_object_rank(m, obj);
+    const bool          virtual = (obj->flags & SndObjectFlags_Virtual) != 0;
+    if (victim && victimVirtual && !virtual) {
+      continue; // Prefer stealing virtual objects.
+    }
+    if (victim && victimVirtual == virtual && snd_object_rank_compare(&rank, &victimRank) <= 0) {
+      continue; // Current victim is ranked lower.
+    }
+    victim        = obj;
+    victimRank    = rank;
+    victimVirtual = virtual;
+  }
+  if (!victim) {
+    return false;
+  }
+  if (victimVirtual || snd_object_is_silent(victim)) {
+    // NOTE: The asset is released during the next update as that requires access to the world.
+    *dynarray_push_t(&m->assetsToRelease, EcsEntityId) = m->objectAssets[victimRank.index];
+    snd_object_cleanup(m, victim);
+    return true;
+  }
+  victim->flags |= SndObjectFlags_Stop;
+  victim->paramSetting[SndObjectParam_GainLeft]  = 0.0f;
+  victim->paramSetting[SndObjectParam_GainRight] = 0.0f;
+  return false;
+}
+
 static u32 snd_object_count_in_phase(const SndMixerComp* m, const SndObjectPhase phase) {
   u32 count = 0;
   for (u32 i = 0; i != snd_mixer_objects_max; ++i) {
@@ -230,6 +403,16 @@ ecs_system_define(SndMixerUpdateSys) {
   dynarray_for_t(&m->persistentAssetsToAcquire, EcsEntityId, a) { asset_acquire(world, *a); }
   dynarray_clear(&m->persistentAssetsToAcquire);
 
+  /**
+   * Release the assets of objects that were taken over.
+   */
+  dynarray_for_t(&m->assetsToRelease, EcsEntityId, a) {
+    if (snd_asset_valid(world, *a)) {
+      asset_release(world, *a);
+    }
+  }
+  dynarray_clear(&m->assetsToRelease);
+
   /**
    * Update sound objects.
    */
@@ -279,12 +462,18 @@ ecs_system_define(SndMixerUpdateSys) {
         m->objectNames[i] = asset_id(asset);
 
         const AssetSoundComp* soundAsset = ecs_view_read_t(assetItr, AssetSoundComp);
+        obj->format                      = snd_object_format(soundAsset->format);
         obj->frameChannels               = soundAsset->frameChannels;
         obj->frameCount                  = soundAsset->frameCount;
         obj->frameRate                   = soundAsset->frameRate;
-        obj->samples                     = soundAsset->sampleData.ptr;
+        obj->data                        = soundAsset->sampleData.ptr;
         obj->phase                       = SndObjectPhase_Playing;
 
+        if (obj->format == SndMixFormat_Adpcm) {
+          const usize ringSize = snd_mix_ring_size(obj->frameChannels);
+          obj->ring.samples    = alloc_alloc(g_allocHeap, ringSize, alignof(f32)).ptr;
+        }
+
         if (obj->flags & SndObjectFlags_RandomCursor) {
           obj->cursor = rng_sample_range(g_rng, 0.0, (f64)obj->frameCount);
         }
@@ -311,48 +500,13 @@ ecs_system_define(SndMixerUpdateSys) {
       if (LIKELY(m->objectAssets[i] && snd_asset_valid(world, m->objectAssets[i]))) {
         asset_release(world, m->objectAssets[i]);
       }
-      snd_object_release(m, obj);
-      *obj                 = (SndObject){.generation = obj->generation};
-      m->objectNames[i]    = string_empty;
-      m->objectAssets[i]   = 0;
-      m->objectUserData[i] = sentinel_u64;
+      snd_object_cleanup(m, obj);
       continue;
     }
     UNREACHABLE
   }
 }
 
-INLINE_HINT static void snd_object_sample(
-    const SndObject* obj, const f64 frame, f32 out[PARAM_ARRAY_SIZE(SndChannel_Count)]) {
-  /**
-   * Naive sampling using linear interpolation between the two closest samples.
-   * This works reasonably for up-sampling (even though we should consider methods that preserve the
-   * curve better, like Hermite interpolation), but for down-sampling this ignores the aliasing that
-   * occurs with frequencies that we cannot represent.
-   */
-  const u32 edgeA  = math_min(obj->frameCount - 2, (u32)frame);
-  const u32 edgeB  = edgeA + 1;
-  const f32 frac   = (f32)(frame - edgeA);
-  const u32 indexA = edgeA * obj->frameChannels;
-  const u32 indexB = edgeB * obj->frameChannels;
-
-  // Left channel.
-  {
-    const f32 valA = obj->samples[indexA + SndChannel_Left];
-    const f32 valB = obj->samples[indexB + SndChannel_Left];
-    out[0]         = math_lerp(valA, valB, frac);
-  }
-
-  // Right channel.
-  if (obj->frameChannels > 1) {
-    const f32 valA = obj->samples[indexA + SndChannel_Right];
-    const f32 valB = obj->samples[indexB + SndChannel_Right];
-    out[1]         = math_lerp(valA, valB, frac);
-  } else {
-    out[1] = out[0];
-  }
-}
-
 #ifdef VOLO_SIMD
 INLINE_HINT static SimdVec snd_object_param_blend(
     const SimdVec actual, const SimdVec target, const SimdVec deltaMin, const SimdVec deltaMax) {
@@ -365,77 +519,33 @@ INLINE_HINT static SimdVec snd_object_param_blend(
 static bool snd_object_render(SndObject* obj, SndBuffer out) {
   diag_assert(obj->phase == SndObjectPhase_Playing);
 
-  const f64  advancePerFrame = obj->frameRate / (f64)out.frameRate;
-  const bool pitchTooLow     = obj->paramSetting[SndObjectParam_Pitch] <= snd_mixer_pitch_min;
-
-  ALIGNAS(16)
-  static const f32 g_paramDeltaMaxValues[SndObjectParam_Count] = {
-      [SndObjectParam_Pitch]     = snd_mixer_pitch_adjust_per_frame,
-      [SndObjectParam_GainLeft]  = snd_mixer_gain_adjust_per_frame,
-      [SndObjectParam_GainRight] = snd_mixer_gain_adjust_per_frame,
-  };
-
-  ALIGNAS(16)
-  const f32 paramMultValues[SndObjectParam_Count] = {
-      [SndObjectParam_Pitch]     = 1.0f,
-      [SndObjectParam_GainLeft]  = pitchTooLow ? 0.0f : 1.0f,
-      [SndObjectParam_GainRight] = pitchTooLow ? 0.0f : 1.0f,
+  const bool pitchTooLow = obj->paramSetting[SndObjectParam_Pitch] <= snd_mixer_pitch_min;
+  const bool demoting    = (obj->flags & SndObjectFlags_Demoting) != 0;
+  const f32  gainMult    = (pitchTooLow || demoting) ? 0.0f : 1.0f;
+
+  SndMixVoice voice = {
+      .format          = obj->format,
+      .data            = obj->data,
+      .ring            = &obj->ring,
+      .frameCount      = obj->frameCount,
+      .frameRate       = obj->frameRate,
+      .frameChannels   = obj->frameChannels,
+      .looping         = (obj->flags & SndObjectFlags_Looping) != 0,
+      .cursor          = obj->cursor,
+      .pitch           = obj->paramActual[SndObjectParam_Pitch],
+      .gainLeft        = obj->paramActual[SndObjectParam_GainLeft],
+      .gainRight       = obj->paramActual[SndObjectParam_GainRight],
+      .pitchTarget     = obj->paramSetting[SndObjectParam_Pitch],
+      .gainLeftTarget  = obj->paramSetting[SndObjectParam_GainLeft] * gainMult,
+      .gainRightTarget = obj->paramSetting[SndObjectParam_GainRight] * gainMult,
   };
+  const bool playing = snd_mix_render(&voice, out);
 
-#ifdef VOLO_SIMD
-  const SimdVec paramDeltaMax = simd_vec_load(g_paramDeltaMaxValues);
-  const SimdVec paramDeltaMin = simd_vec_mul(paramDeltaMax, simd_vec_broadcast(-1.0f));
-  const SimdVec paramMult     = simd_vec_load(paramMultValues);
-  const SimdVec paramTarget   = simd_vec_mul(simd_vec_load(obj->paramSetting), paramMult);
-  SimdVec       paramActual   = simd_vec_load(obj->paramActual);
-#endif
-
-  for (u32 frame = 0; frame != out.frameCount; ++frame) {
-    f32 samples[SndChannel_Count];
-    snd_object_sample(obj, obj->cursor, samples);
-
-#ifdef VOLO_SIMD
-    paramActual = snd_object_param_blend(paramActual, paramTarget, paramDeltaMin, paramDeltaMax);
-
-    const f32 gainLeft = simd_vec_x(simd_vec_splat(paramActual, SndObjectParam_GainLeft));
-    out.frames[frame].samples[SndChannel_Left] += samples[SndChannel_Left] * gainLeft;
-
-    const f32 gainRight = simd_vec_x(simd_vec_splat(paramActual, SndObjectParam_GainRight));
-    out.frames[frame].samples[SndChannel_Right] += samples[SndChannel_Right] * gainRight;
-
-    ASSERT(SndObjectParam_Pitch == 0, "Expected pitch to be the first parameter");
-    obj->cursor += advancePerFrame * (f64)simd_vec_x(paramActual);
-#else
-    for (u32 i = 0; i != SndObjectParam_Count; ++i) {
-      const f32 deltaMax = g_paramDeltaMaxValues[i];
-      const f32 deltaMin = deltaMax * -1.0f;
-      const f32 target   = obj->paramSetting[i] * paramMultValues[i];
-      obj->paramActual[i] += math_clamp_f32(target - obj->paramActual[i], deltaMin, deltaMax);
-    }
-
-    const f32 gainLeft = obj->paramActual[SndObjectParam_GainLeft];
-    out.frames[frame].samples[SndChannel_Left] += samples[SndChannel_Left] * gainLeft;
-
-    const f32 gainRight = obj->paramActual[SndObjectParam_GainRight];
-    out.frames[frame].samples[SndChannel_Right] += samples[SndChannel_Right] * gainRight;
-
-    obj->cursor += advancePerFrame * (f64)obj->paramActual[SndObjectParam_Pitch];
-#endif
-
-    if (UNLIKELY(obj->cursor >= obj->frameCount)) {
-      if (obj->flags & SndObjectFlags_Looping) {
-        obj->cursor -= obj->frameCount;
-      } else {
-        return false; // Finished playing.
-      }
-    }
-  }
-
-#ifdef VOLO_SIMD
-  simd_vec_store(paramActual, obj->paramActual);
-#endif
-
-  return true; // Still playing.
+  obj->cursor                                = voice.cursor;
+  obj->paramActual[SndObjectParam_Pitch]     = voice.pitch;
+  obj->paramActual[SndObjectParam_GainLeft]  = voice.gainLeft;
+  obj->paramActual[SndObjectParam_GainRight] = voice.gainRight;
+  return playing;
 }
 
 static bool snd_object_skip(SndObject* obj, const TimeDuration dur) {
@@ -504,16 +614,6 @@ static bool snd_object_is_muted(const SndObject* obj) {
   return true;
 }
 
-static bool snd_object_is_silent(const SndObject* obj) {
-  if (obj->paramActual[SndObjectParam_GainLeft] > f32_epsilon) {
-    return false;
-  }
-  if (obj->paramActual[SndObjectParam_GainRight] > f32_epsilon) {
-    return false;
-  }
-  return true;
-}
-
 /**
  * Merge other buffers onto buffer 0 additively, two frames (with two channels each) at a time.
  */
@@ -585,6 +685,39 @@ static void snd_mixer_write_to_device(
   }
 }
 
+/**
+ * Select which of the playing objects are mixed (real) and which are only tracked by their cursor
+ * (virtual). Objects are ranked on priority first and audibility second; only the highest ranked
+ * audible objects are real.
+ * NOTE: Demoted objects are counted as virtual but are mixed until they have faded out.
+ */
+static void snd_mixer_virtualize(SndMixerComp* m) {
+  SndObjectRank ranks[snd_mixer_objects_max];
+  u32           rankCount    = 0;
+  u32           virtualCount = 0;
+  for (u32 i = 0; i != snd_mixer_objects_max; ++i) {
+    SndObject* obj = &m->objects[i];
+    if (obj->phase != SndObjectPhase_Playing) {
+      continue;
+    }
+    const SndObjectRank rank = snd_object_rank(m, obj);
+    if (rank.audibility < snd_mixer_audible_threshold) {
+      snd_object_virtual_set(obj, true);
+      ++virtualCount;
+      continue;
+    }
+    ranks[rankCount++] = rank;
+  }
+  sort_quicksort_t(ranks, ranks + rankCount, SndObjectRank, snd_object_rank_compare);
+
+  for (u32 i = 0; i != rankCount; ++i) {
+    snd_object_virtual_set(&m->objects[ranks[i].index], i >= snd_mixer_voices_real_max);
+  }
+  const u32 realCount = math_min(rankCount, snd_mixer_voices_real_max);
+  m->objectsReal      = (u16)realCount;
+  m->objectsVirtual   = (u16)(virtualCount + rankCount - realCount);
+}
+
 ecs_system_define(SndMixerRenderBeginSys) {
   SndMixerComp* m = snd_mixer_get(world);
   if (!m) {
@@ -624,6 +757,7 @@ ecs_system_define(SndMixerRenderBeginSys) {
 
   const SndDevicePeriod devicePeriod = snd_device_period(m->device);
   m->deviceRequestedFrames           = devicePeriod.frameCount;
+  m->renderStart                     = time_steady_clock();
 
   /**
    * Skip sounds forward if there's a gap between the end of the last rendered sound and the new
@@ -641,6 +775,8 @@ ecs_system_define(SndMixerRenderBeginSys) {
     }
   }
 
+  snd_mixer_virtualize(m);
+
   /**
    * Clear all the sound buffers.
    * NOTE: Clear all buffers here as the amount of parallelism of the filling stage could vary.
@@ -684,12 +820,13 @@ ecs_system_define(SndMixerRenderFillSys) {
     if (obj->phase != SndObjectPhase_Playing) {
       continue;
     }
-    const bool muted  = snd_object_is_muted(obj);
-    const bool silent = snd_object_is_silent(obj);
+    const bool muted   = snd_object_is_muted(obj);
+    const bool silent  = snd_object_is_silent(obj);
+    const bool virtual = (obj->flags & SndObjectFlags_Virtual) != 0;
 
-    if (muted && silent) {
+    if ((muted && silent) || virtual) {
       if (obj->flags & SndObjectFlags_Stop) {
-        goto FinishedPlaying; // Stopped and finished fading out.
+        goto FinishedPlaying; // Stopped and finished fading out (or not audible at all).
       }
       if (!snd_object_skip(obj, soundBufferDur)) {
         goto FinishedPlaying;
@@ -698,6 +835,10 @@ ecs_system_define(SndMixerRenderFillSys) {
       if (!snd_object_render(obj, soundBuffer)) {
         goto FinishedPlaying;
       }
+      if ((obj->flags & SndObjectFlags_Demoting) && snd_object_is_silent(obj)) {
+        obj->flags &= ~SndObjectFlags_Demoting;
+        obj->flags |= SndObjectFlags_Virtual; // Finished fading out; stop mixing.
+      }
     }
     continue;
 
@@ -707,6 +848,21 @@ ecs_system_define(SndMixerRenderFillSys) {
   }
 }
 
+static void snd_mixer_render_stats_update(SndMixerComp* m, const TimeDuration periodDur) {
+  const TimeDuration renderDur = time_steady_duration(m->renderStart, time_steady_clock());
+
+  static const f64 g_avgWeight = 0.05;
+  m->renderDurAvg = (TimeDuration)math_lerp((f64)m->renderDurAvg, (f64)renderDur, g_avgWeight);
+  m->renderDurPeak   = math_max(m->renderDurPeak, renderDur);
+  m->renderPeriodDur = periodDur;
+
+  if (m->renderWindowLeft-- == 0) {
+    m->renderDurMax     = m->renderDurPeak;
+    m->renderDurPeak    = 0;
+    m->renderWindowLeft = snd_mixer_render_stats_window;
+  }
+}
+
 ecs_system_define(SndMixerRenderEndSys) {
   SndMixerComp* m = snd_mixer_get(world);
   if (!m || !m->deviceRequestedFrames) {
@@ -722,6 +878,8 @@ ecs_system_define(SndMixerRenderEndSys) {
 
   m->deviceTimeHead       = devicePeriod.timeBegin + resultDur;
   m->deviceRenderedFrames = m->deviceRequestedFrames;
+
+  snd_mixer_render_stats_update(m, resultDur);
 }
 
 ecs_module_init(snd_mixer_module) {
@@ -771,17 +929,22 @@ SndMixerComp* snd_mixer_init(EcsWorld* world) {
 
   m->persistentAssets          = dynarray_create_t(g_allocHeap, EcsEntityId, 64);
   m->persistentAssetsToAcquire = dynarray_create_t(g_allocHeap, EcsEntityId, 8);
+  m->assetsToRelease           = dynarray_create_t(g_allocHeap, EcsEntityId, 8);
 
   return m;
 }
 
-SndResult snd_object_new(SndMixerComp* m, SndObjectId* outId) {
-  const SndObjectId id  = snd_object_acquire(m);
-  SndObject*        obj = snd_object_get(m, id);
+SndResult snd_object_new(SndMixerComp* m, const u8 priority, SndObjectId* outId) {
+  SndObjectId id = snd_object_acquire(m);
+  if (UNLIKELY(!snd_object_get(m, id)) && snd_object_steal(m, priority)) {
+    id = snd_object_acquire(m); // Victim was released immediately.
+  }
+  SndObject* obj = snd_object_get(m, id);
   if (UNLIKELY(!obj)) {
-    return SndResult_FailedToAcquireObject;
+    return SndResult_FailedToAcquireObject; // Victim (if any) is fading out; retry later.
   }
   obj->phase                                  = SndObjectPhase_Setup;
+  obj->priority                               = priority;
   obj->paramActual[SndObjectParam_Pitch]      = 1.0f;
   obj->paramSetting[SndObjectParam_Pitch]     = 1.0f;
   obj->paramSetting[SndObjectParam_GainLeft]  = 1.0f;
@@ -842,6 +1005,16 @@ f64 snd_object_get_cursor(const SndMixerComp* m, const SndObjectId id) {
   return obj ? obj->cursor : 0.0;
 }
 
+u8 snd_object_get_priority(const SndMixerComp* m, const SndObjectId id) {
+  const SndObject* obj = snd_object_get_readonly(m, id);
+  return obj ? obj->priority : 0;
+}
+
+bool snd_object_is_virtual(const SndMixerComp* m, const SndObjectId id) {
+  const SndObject* obj = snd_object_get_readonly(m, id);
+  return obj && (obj->flags & SndObjectFlags_Virtual) != 0;
+}
+
 f32 snd_object_get_pitch(const SndMixerComp* m, const SndObjectId id) {
   const SndObject* obj = snd_object_get_readonly(m, id);
   return obj ? obj->paramActual[SndObjectParam_Pitch] : 0.0f;
@@ -976,10 +1149,17 @@ u64 snd_mixer_device_underruns(const SndMixerComp* m) {
   return m->device ? snd_device_underruns(m->device) : 0;
 }
 
+TimeDuration snd_mixer_render_duration(const SndMixerComp* m) { return m->renderDurAvg; }
+TimeDuration snd_mixer_render_duration_max(const SndMixerComp* m) { return m->renderDurMax; }
+TimeDuration snd_mixer_render_budget(const SndMixerComp* m) { return m->renderPeriodDur; }
+
 u32 snd_mixer_objects_playing(const SndMixerComp* m) {
   return snd_object_count_in_phase(m, SndObjectPhase_Playing);
 }
 
+u32 snd_mixer_objects_real(const SndMixerComp* m) { return m->objectsReal; }
+u32 snd_mixer_objects_virtual(const SndMixerComp* m) { return m->objectsVirtual; }
+
 u32 snd_mixer_objects_allocated(const SndMixerComp* m) {
   const usize freeObjects = bitset_count(m->objectFreeSet);
   return snd_mixer_objects_max - (u32)freeObjects;
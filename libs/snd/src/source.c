@@ -246,7 +246,7 @@ ecs_system_define(SndSourceUpdateSys) {
         continue; // Too far away; retry next tick.
       }
       SndObjectId id;
-      if (snd_object_new(m, &id) == SndResult_Success) {
+      if (snd_object_new(m, soundComp->priority, &id) == SndResult_Success) {
         snd_object_set_asset(m, id, soundComp->asset);
         snd_object_set_user_data(m, id, (u64)ecs_view_entity(itr));
         if (soundComp->looping) {
@@ -4,7 +4,7 @@
 
 ecs_comp_extern_public(UiStatsComp) {
   UiVector canvasSize;
-  u32      canvasCount;
+  u32      canvasCount, canvasBuildCount; // Build count excludes canvasses that were reused.
   u32      trackedElemCount, persistElemCount;
   u32      atomCount, atomDeferredCount;
   u32      clipRectCount;
@@ -49,7 +49,7 @@ typedef struct {
   u32                     styleStackCount;
   UiBuildContainer        containerStack[ui_build_container_stack_max];
   u32                     containerStackCount;
-  UiBuildHover            hover;
+  bool                    inputDependent;
 } UiBuildState;
 
 static UiRect* ui_build_rect_current(UiBuildState* state) {
@@ -108,6 +108,7 @@ static UiVector ui_resolve_origin(UiBuildState* state, const UiBase origin) {
   case UiBase_Canvas:
     return ui_vector(0, 0);
   case UiBase_Input: {
+    state->inputDependent = true;
     return state->ctx->inputPos;
   }
   }
@@ -323,13 +324,26 @@ static UiRect ui_build_clip(const UiBuildContainer container, const UiRect rect)
   };
 }
 
-static bool ui_build_is_hovered(
-    UiBuildState* state, const UiBuildContainer container, const UiRect rect, const UiLayer layer) {
-  if (!sentinel_check(state->hover.id) && state->hover.layer > layer) {
-    return false; // Something is already hovered on a higher layer.
+static void ui_build_hoverable(
+    UiBuildState*          state,
+    const UiBuildContainer container,
+    const UiRect           rect,
+    const UiLayer          layer,
+    const UiId             id,
+    const UiFlags          flags) {
+  const bool debugAllInteract = state->ctx->settings->inspectorMode == UiInspectorMode_DebugAll;
+  if (!(flags & UiFlags_Interactable) && !debugAllInteract) {
+    return; // Not hoverable.
   }
-  return ui_rect_contains(rect, state->ctx->inputPos) &&
-         ui_rect_contains(container.clipRect, state->ctx->inputPos);
+  state->ctx->outputHoverable(
+      state->ctx->userCtx,
+      &(UiBuildHoverable){
+          .id       = id,
+          .layer    = layer,
+          .flags    = flags,
+          .rect     = rect,
+          .clipRect = container.clipRect,
+      });
 }
 
 static void ui_build_draw_text(UiBuildState* state, const UiDrawText* cmd) {
@@ -341,7 +355,12 @@ static void ui_build_draw_text(UiBuildState* state, const UiDrawText* cmd) {
     return;
   }
 
+  if (cmd->flags & UiFlags_TrackTextInfo) {
+    state->inputDependent = true; // The hovered character depends on the input position.
+  }
+
   const UiTextBuildResult result = ui_text_build(
+      state->ctx->textCache,
       state->atlasFont,
       cmd->flags,
       rect,
@@ -364,16 +383,7 @@ static void ui_build_draw_text(UiBuildState* state, const UiDrawText* cmd) {
     rect = result.rect;
   }
 
-  const bool debugAllInteract = state->ctx->settings->inspectorMode == UiInspectorMode_DebugAll;
-  const bool hoverable        = cmd->flags & UiFlags_Interactable || debugAllInteract;
-
-  if (hoverable && ui_build_is_hovered(state, container, rect, style.layer)) {
-    state->hover = (UiBuildHover){
-        .id    = cmd->id,
-        .layer = style.layer,
-        .flags = cmd->flags,
-    };
-  }
+  ui_build_hoverable(state, container, rect, style.layer, cmd->id, cmd->flags);
 
   if (cmd->flags & UiFlags_TrackRect) {
     state->ctx->outputRect(state->ctx->userCtx, cmd->id, result.rect);
@@ -400,17 +410,8 @@ static void ui_build_draw_glyph(UiBuildState* state, const UiDrawGlyph* cmd) {
   if (!rotated && ui_build_cull(container, rect, style)) {
     return;
   }
-  const bool debugAllInteract = state->ctx->settings->inspectorMode == UiInspectorMode_DebugAll;
-  const bool hoverable        = cmd->flags & UiFlags_Interactable || debugAllInteract;
-
-  if (hoverable && ui_build_is_hovered(state, container, rect, style.layer)) {
-    // TODO: Implement proper hovering for rotated glyphs.
-    state->hover = (UiBuildHover){
-        .id    = cmd->id,
-        .layer = style.layer,
-        .flags = cmd->flags,
-    };
-  }
+  // TODO: Implement proper hovering for rotated glyphs.
+  ui_build_hoverable(state, container, rect, style.layer, cmd->id, cmd->flags);
 
   ui_build_atom_glyph(state, cmd->cp, rect, style, cmd->maxCorner, cmd->angleRad, container.clipId);
 
@@ -431,17 +432,8 @@ static void ui_build_draw_image(UiBuildState* state, const UiDrawImage* cmd) {
   if (!rotated && ui_build_cull(container, rect, style)) {
     return;
   }
-  const bool debugAllInteract = state->ctx->settings->inspectorMode == UiInspectorMode_DebugAll;
-  const bool hoverable        = cmd->flags & UiFlags_Interactable || debugAllInteract;
-
-  if (hoverable && ui_build_is_hovered(state, container, rect, style.layer)) {
-    // TODO: Implement proper hovering for rotated images.
-    state->hover = (UiBuildHover){
-        .id    = cmd->id,
-        .layer = style.layer,
-        .flags = cmd->flags,
-    };
-  }
+  // TODO: Implement proper hovering for rotated images.
+  ui_build_hoverable(state, container, rect, style.layer, cmd->id, cmd->flags);
 
   if (style.outline) {
     /**
@@ -532,6 +524,7 @@ static void ui_build_debug_inspector(
       .size = {textSize, textSize},
   };
   ui_text_build(
+      state->ctx->textCache,
       state->atlasFont,
       UiFlags_None,
       textRect,
@@ -705,7 +698,6 @@ UiBuildResult ui_build(const UiCmdBuffer* cmdBuffer, const UiBuildCtx* ctx) {
               .clipLayer      = UiLayer_Normal,
           },
       .containerStackCount = 1,
-      .hover               = {.id = sentinel_u64},
   };
 
   UiCmd* cmd = null;
@@ -714,7 +706,21 @@ UiBuildResult ui_build(const UiCmdBuffer* cmdBuffer, const UiBuildCtx* ctx) {
   }
 
   return (UiBuildResult){
-      .commandCount = ui_cmdbuffer_count(cmdBuffer),
-      .hover        = state.hover,
+      .commandCount   = ui_cmdbuffer_count(cmdBuffer),
+      .inputDependent = state.inputDependent,
   };
 }
+
+UiBuildHover ui_build_hover(
+    const UiBuildHoverable* begin, const UiBuildHoverable* end, const UiVector inputPos) {
+  UiBuildHover res = {.id = sentinel_u64};
+  for (const UiBuildHoverable* itr = begin; itr != end; ++itr) {
+    if (!sentinel_check(res.id) && res.layer > itr->layer) {
+      continue; // Something is already hovered on a higher layer.
+    }
+    if (ui_rect_contains(itr->rect, inputPos) && ui_rect_contains(itr->clipRect, inputPos)) {
+      res = (UiBuildHover){.id = itr->id, .layer = itr->layer, .flags = itr->flags};
+    }
+  }
+  return res;
+}
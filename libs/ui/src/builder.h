@@ -42,10 +42,28 @@ typedef struct {
   usize hoveredCharIndex;
 } UiBuildTextInfo;
 
+typedef struct {
+  UiId    id;
+  UiLayer layer;
+  UiFlags flags;
+} UiBuildHover;
+
+/**
+ * Element that can be hovered, the hovered element can be resolved for any input position using
+ * 'ui_build_hover()' without needing to rebuild the commands.
+ */
+typedef struct {
+  UiId    id;
+  UiLayer layer : 8;
+  UiFlags flags : 16;
+  UiRect  rect, clipRect;
+} UiBuildHoverable;
+
 typedef u8 (*UiOutputClipRectFunc)(void* userCtx, UiRect);
 typedef void (*UiOutputAtomFunc)(void* userCtx, UiAtomData, UiLayer);
 typedef void (*UiOutputRect)(void* userCtx, UiId, UiRect);
 typedef void (*UiOutputTextInfo)(void* userCtx, UiId, UiBuildTextInfo);
+typedef void (*UiOutputHoverable)(void* userCtx, const UiBuildHoverable*);
 
 typedef struct {
   const UiSettingsGlobalComp* settings;
@@ -53,22 +71,29 @@ typedef struct {
   const AssetAtlasComp*       atlasImage;
   UiId                        debugElem;
   UiVector                    canvasRes, inputPos;
+  UiTextCache*                textCache; // [Optional].
   void*                       userCtx;
   UiOutputClipRectFunc        outputClipRect;
   UiOutputAtomFunc            outputAtom;
   UiOutputRect                outputRect;
   UiOutputTextInfo            outputTextInfo;
+  UiOutputHoverable           outputHoverable;
 } UiBuildCtx;
 
 typedef struct {
-  UiId    id;
-  UiLayer layer;
-  UiFlags flags;
-} UiBuildHover;
+  u32 commandCount;
 
-typedef struct {
-  u32          commandCount;
-  UiBuildHover hover;
+  /**
+   * Indicates that the output depends on the input position (apart from the hoverables), for
+   * example elements that are positioned relative to the input.
+   */
+  bool inputDependent;
 } UiBuildResult;
 
 UiBuildResult ui_build(const UiCmdBuffer*, const UiBuildCtx*);
+
+/**
+ * Resolve the hovered element at the given input position.
+ * NOTE: Hoverables have to be provided in the order they were output by the builder.
+ */
+UiBuildHover ui_build_hover(const UiBuildHoverable* begin, const UiBuildHoverable* end, UiVector);
@@ -23,6 +23,7 @@
 #include "cmd.h"
 #include "editor.h"
 #include "resource.h"
+#include "text.h"
 
 #define ui_canvas_clip_rects_max 50
 #define ui_canvas_canvasses_max 100
@@ -38,7 +39,7 @@ typedef const UiCanvasComp* UiCanvasConstPtr;
 
 /**
  * Element information that is tracked during ui build / render and can be queried next frame.
- * NOTE: Cleared at the start of every ui-build.
+ * NOTE: Cleared at the start of every ui-build (retained when the previous build is reused).
  */
 typedef struct {
   UiId            id;
@@ -55,6 +56,25 @@ typedef struct {
   UiScrollview      scrollView;
 } UiPersistentElem;
 
+/**
+ * Output of the last build of a canvas.
+ * The output is reused as long as the hash of the build inputs (the commands, the resolution, the
+ * atlases etc) does not change, this avoids rebuilding (mostly) static canvases every frame.
+ * NOTE: To avoid reusing the output on a hash collision the command count and the text size have to
+ * match as well.
+ * NOTE: Clip-ids of the atoms are local to the canvas, 0 is the root clip-rect and 1 is the first
+ * rect in 'clipRects'; they are remapped when the atoms are added to the window's render object.
+ */
+typedef struct {
+  u64      hash;
+  u32      commandCount;
+  usize    textSize;
+  bool     valid, rebuilt, inputDependent;
+  DynArray atoms[UiLayer_Count]; // UiAtomData[][]
+  DynArray clipRects;            // UiRect[]
+  DynArray hoverables;           // UiBuildHoverable[]
+} UiCanvasOutput;
+
 typedef enum {
   UiCanvasFlags_InputAny     = 1 << 0,
   UiCanvasFlags_InputControl = 1 << 1,
@@ -73,6 +93,8 @@ ecs_comp_define(UiCanvasComp) {
   EcsEntityId    window;
   UiCmdBuffer*   cmdBuffer;
   UiEditor*      textEditor;
+  UiTextCache*   textCache;
+  UiCanvasOutput output;
   UiId           nextId;
   DynArray       trackedElems;    // UiTrackedElem[]
   DynArray       persistentElems; // UiPersistentElem[]
@@ -98,10 +120,25 @@ static void ecs_destruct_canvas(void* data) {
   UiCanvasComp* comp = data;
   ui_cmdbuffer_destroy(comp->cmdBuffer);
   ui_editor_destroy(comp->textEditor);
+  ui_text_cache_destroy(comp->textCache);
+  array_for_t(comp->output.atoms, DynArray, atoms) { dynarray_destroy(atoms); }
+  dynarray_destroy(&comp->output.clipRects);
+  dynarray_destroy(&comp->output.hoverables);
   dynarray_destroy(&comp->trackedElems);
   dynarray_destroy(&comp->persistentElems);
 }
 
+static UiCanvasOutput ui_canvas_output_create(void) {
+  UiCanvasOutput res = {
+      .clipRects  = dynarray_create_t(g_allocHeap, UiRect, 8),
+      .hoverables = dynarray_create_t(g_allocHeap, UiBuildHoverable, 32),
+  };
+  array_for_t(res.atoms, DynArray, atoms) {
+    *atoms = dynarray_create_t(g_allocHeap, UiAtomData, 64);
+  }
+  return res;
+}
+
 static i8 ui_canvas_ptr_compare(const void* a, const void* b) {
   const UiCanvasConstPtr* canvasPtrA = a;
   const UiCanvasConstPtr* canvasPtrB = b;
@@ -136,14 +173,11 @@ typedef struct {
 ASSERT(sizeof(UiDrawMetaData) == 848, "Size needs to match the size defined in glsl");
 
 typedef struct {
-  const UiSettingsGlobalComp* settings;
-  const AssetFontTexComp*     atlasFont;
-  const AssetAtlasComp*       atlasImage;
-  UiRendererComp*             renderer;
-  RendObjectComp*             rendObj;
-  UiCanvasComp*               canvas;
-  UiRect                      clipRects[ui_canvas_clip_rects_max];
-  u32                         clipRectCount;
+  UiRendererComp* renderer;
+  RendObjectComp* rendObj;
+  UiCanvasComp*   canvas;
+  UiRect          clipRects[ui_canvas_clip_rects_max];
+  u32             clipRectCount;
 } UiRenderState;
 
 static UiAtlasData ui_atlas_metadata_font(const AssetFontTexComp* font) {
@@ -210,30 +244,30 @@ static f32 ui_window_scale(const GapWindowComp* window, const UiSettingsGlobalCo
 }
 
 static u8 ui_canvas_output_clip_rect(void* userCtx, const UiRect rect) {
-  UiRenderState* state = userCtx;
-  diag_assert(state->clipRectCount < ui_canvas_clip_rects_max);
-  const u8 id          = state->clipRectCount++;
-  state->clipRects[id] = rect;
-  return id;
+  UiCanvasComp* canvas = userCtx;
+  diag_assert(canvas->output.clipRects.size < ui_canvas_clip_rects_max - 1);
+  *dynarray_push_t(&canvas->output.clipRects, UiRect) = rect;
+  return (u8)canvas->output.clipRects.size; // NOTE: Local id 0 is the root clip-rect.
 }
 
 static void ui_canvas_output_atom(void* userCtx, const UiAtomData data, const UiLayer layer) {
-  UiRenderState* state = userCtx;
-  if (layer == UiLayer_Normal) {
-    *rend_object_add_instance_t(state->rendObj, UiAtomData, 0, geo_box_inverted3()) = data;
-    return;
-  }
-  *dynarray_push_t(&state->renderer->deferredAtoms[layer - 1], UiAtomData) = data;
+  UiCanvasComp* canvas                                       = userCtx;
+  *dynarray_push_t(&canvas->output.atoms[layer], UiAtomData) = data;
 }
 
 static void ui_canvas_output_rect(void* userCtx, const UiId id, const UiRect rect) {
-  UiRenderState* state                       = userCtx;
-  ui_canvas_tracked(state->canvas, id)->rect = rect;
+  UiCanvasComp* canvas                = userCtx;
+  ui_canvas_tracked(canvas, id)->rect = rect;
 }
 
 static void ui_canvas_output_text_info(void* userCtx, const UiId id, const UiBuildTextInfo info) {
-  UiRenderState* state                           = userCtx;
-  ui_canvas_tracked(state->canvas, id)->textInfo = info;
+  UiCanvasComp* canvas                    = userCtx;
+  ui_canvas_tracked(canvas, id)->textInfo = info;
+}
+
+static void ui_canvas_output_hoverable(void* userCtx, const UiBuildHoverable* hoverable) {
+  UiCanvasComp* canvas                                           = userCtx;
+  *dynarray_push_t(&canvas->output.hoverables, UiBuildHoverable) = *hoverable;
 }
 
 static void ui_canvas_set_active(UiCanvasComp* canvas, const UiId id, const UiStatus status) {
@@ -303,26 +337,137 @@ static void ui_canvas_update_interaction(
   canvas->activeElemFlags = hoveredFlags;
 }
 
-static UiBuildResult ui_canvas_build(UiRenderState* state, const UiId debugElem) {
-  dynarray_clear(&state->canvas->trackedElems);
+static UiId ui_canvas_debug_elem(UiCanvasComp* canvas, const UiSettingsGlobalComp* settings) {
+  if (UNLIKELY(settings->inspectorMode != UiInspectorMode_None)) {
+    return canvas->activeId;
+  }
+  return sentinel_u64;
+}
+
+/**
+ * Hash of all the inputs that affect the output of a canvas build.
+ */
+static u64 ui_canvas_build_hash(
+    const UiCanvasComp*         canvas,
+    const UiSettingsGlobalComp* settings,
+    const AssetFontTexComp*     atlasFont,
+    const AssetAtlasComp*       atlasImage,
+    const UiId                  debugElem) {
+  const u64 vals[] = {
+      debugElem,
+      (uptr)atlasFont,
+      (uptr)atlasFont->characters.values,
+      atlasFont->characters.count,
+      asset_fonttex_generation(atlasFont),
+      (uptr)atlasImage,
+      (uptr)atlasImage->entries.values,
+      atlasImage->entries.count,
+      settings->inspectorMode,
+      settings->defaultColor.data,
+      (u64)settings->defaultOutline << 16 | (u64)settings->defaultVariation << 8,
+      settings->defaultWeight,
+  };
+  const f32 dims[] = {canvas->resolution.x, canvas->resolution.y};
+
+  u64 hash = ui_cmdbuffer_hash(canvas->cmdBuffer);
+  hash     = bits_hash_64_combine(hash, bits_hash_64(mem_var(vals)));
+  hash     = bits_hash_64_combine(hash, bits_hash_64(mem_var(dims)));
+  return hash;
+}
+
+static u64 ui_canvas_build_hash_input(const UiCanvasComp* canvas, const u64 hash) {
+  const f32 inputPos[] = {canvas->inputPos.x, canvas->inputPos.y};
+  return bits_hash_64_combine(hash, bits_hash_64(mem_var(inputPos)));
+}
+
+static void ui_canvas_build(
+    UiCanvasComp*               canvas,
+    const UiSettingsGlobalComp* settings,
+    const AssetFontTexComp*     atlasFont,
+    const AssetAtlasComp*       atlasImage) {
+  UiCanvasOutput* output    = &canvas->output;
+  const UiId      debugElem = ui_canvas_debug_elem(canvas, settings);
+
+  u64 hash = ui_canvas_build_hash(canvas, settings, atlasFont, atlasImage, debugElem);
+  if (output->inputDependent) {
+    hash = ui_canvas_build_hash_input(canvas, hash);
+  }
+  const u32   commandCount = ui_cmdbuffer_count(canvas->cmdBuffer);
+  const usize textSize     = ui_cmdbuffer_text_size(canvas->cmdBuffer);
+  if (output->valid && output->hash == hash && output->commandCount == commandCount &&
+      output->textSize == textSize) {
+    output->rebuilt = false;
+    return; // Nothing changed since the last build; reuse the previous output.
+  }
+
+  array_for_t(output->atoms, DynArray, atoms) { dynarray_clear(atoms); }
+  dynarray_clear(&output->clipRects);
+  dynarray_clear(&output->hoverables);
+  dynarray_clear(&canvas->trackedElems);
 
   const UiBuildCtx buildCtx = {
-      .settings       = state->settings,
-      .atlasFont      = state->atlasFont,
-      .atlasImage     = state->atlasImage,
-      .debugElem      = debugElem,
-      .canvasRes      = state->canvas->resolution,
-      .inputPos       = state->canvas->inputPos,
-      .userCtx        = state,
-      .outputClipRect = &ui_canvas_output_clip_rect,
-      .outputAtom     = &ui_canvas_output_atom,
-      .outputRect     = &ui_canvas_output_rect,
-      .outputTextInfo = &ui_canvas_output_text_info,
+      .settings        = settings,
+      .atlasFont       = atlasFont,
+      .atlasImage      = atlasImage,
+      .debugElem       = debugElem,
+      .canvasRes       = canvas->resolution,
+      .inputPos        = canvas->inputPos,
+      .textCache       = canvas->textCache,
+      .userCtx         = canvas,
+      .outputClipRect  = &ui_canvas_output_clip_rect,
+      .outputAtom      = &ui_canvas_output_atom,
+      .outputRect      = &ui_canvas_output_rect,
+      .outputTextInfo  = &ui_canvas_output_text_info,
+      .outputHoverable = &ui_canvas_output_hoverable,
   };
-  return ui_build(state->canvas->cmdBuffer, &buildCtx);
+  const UiBuildResult result = ui_build(canvas->cmdBuffer, &buildCtx);
+  ui_text_cache_flush(canvas->textCache);
+
+  if (result.inputDependent && !output->inputDependent) {
+    hash = ui_canvas_build_hash_input(canvas, hash);
+  }
+  output->hash           = hash;
+  output->commandCount   = commandCount;
+  output->textSize       = textSize;
+  output->valid          = true;
+  output->rebuilt        = true;
+  output->inputDependent = result.inputDependent;
+}
+
+/**
+ * Add the output of the given canvas to the window's render object.
+ * NOTE: Atoms on the non-normal layers are deferred so they are drawn on top of all canvasses.
+ */
+static void ui_canvas_output_submit(UiRenderState* state, const UiCanvasComp* canvas) {
+  const UiCanvasOutput* output = &canvas->output;
+  diag_assert(state->clipRectCount + output->clipRects.size <= ui_canvas_clip_rects_max);
+
+  const u32 clipIdOffset = state->clipRectCount - 1; // Local id 1 maps to the first added rect.
+  dynarray_for_t(&output->clipRects, UiRect, rect) {
+    state->clipRects[state->clipRectCount++] = *rect;
+  }
+
+  for (UiLayer layer = 0; layer != UiLayer_Count; ++layer) {
+    dynarray_for_t(&output->atoms[layer], UiAtomData, atom) {
+      UiAtomData* res;
+      if (layer == UiLayer_Normal) {
+        res = rend_object_add_instance_t(state->rendObj, UiAtomData, 0, geo_box_inverted3());
+      } else {
+        res = dynarray_push_t(&state->renderer->deferredAtoms[layer - 1], UiAtomData);
+      }
+      *res = *atom;
+      if (atom->clipId) {
+        res->clipId = (u8)(atom->clipId + clipIdOffset);
+      }
+    }
+  }
 }
 
 ecs_view_define(InputGlobalView) { ecs_access_read(UiSettingsGlobalComp); }
+ecs_view_define(BuildGlobalView) {
+  ecs_access_read(UiGlobalResourcesComp);
+  ecs_access_read(UiSettingsGlobalComp);
+}
 ecs_view_define(RenderGlobalView) {
   ecs_access_read(UiGlobalResourcesComp);
   ecs_access_maybe_write(InputManagerComp);
@@ -339,6 +484,7 @@ ecs_view_define(WindowView) {
   ecs_access_maybe_write(UiRendererComp);
   ecs_access_maybe_write(UiStatsComp);
 }
+ecs_view_define(BuildWindowView) { ecs_access_read(GapWindowComp); }
 ecs_view_define(CanvasView) { ecs_access_write(UiCanvasComp); }
 
 ecs_view_define(RendObjView) {
@@ -411,6 +557,42 @@ ecs_system_define(UiCanvasInputSys) {
   }
 }
 
+/**
+ * Build the canvasses into their (retained) output, canvasses are built in parallel as they only
+ * write to their own output.
+ */
+ecs_system_define(UiCanvasBuildSys) {
+  EcsView*     globalView = ecs_world_view_t(world, BuildGlobalView);
+  EcsIterator* globalItr  = ecs_view_maybe_at(globalView, ecs_world_global(world));
+  if (!globalItr) {
+    return; // Global dependencies not initialized yet.
+  }
+  const UiGlobalResourcesComp* globalRes = ecs_view_read_t(globalItr, UiGlobalResourcesComp);
+  const UiSettingsGlobalComp*  settings  = ecs_view_read_t(globalItr, UiSettingsGlobalComp);
+
+  const AssetFontTexComp* atlasFont  = ui_atlas_font_get(world, globalRes);
+  const AssetAtlasComp*   atlasImage = ui_atlas_get(world, globalRes, UiAtlasRes_Image);
+  if (!atlasFont || !atlasImage) {
+    return; // Global atlases not loaded yet.
+  }
+
+  EcsView*     canvasView = ecs_world_view_t(world, CanvasView);
+  EcsIterator* windowItr  = ecs_view_itr(ecs_world_view_t(world, BuildWindowView));
+
+  for (EcsIterator* itr = ecs_view_itr_step(canvasView, parCount, parIndex); ecs_view_walk(itr);) {
+    UiCanvasComp* canvas = ecs_view_write_t(itr, UiCanvasComp);
+    if (!ecs_view_maybe_jump(windowItr, canvas->window)) {
+      continue;
+    }
+    const GapWindowComp* window  = ecs_view_read_t(windowItr, GapWindowComp);
+    const GapVector      winSize = gap_window_param(window, GapParam_WindowSize);
+    if (!winSize.x || !winSize.y) {
+      continue; // Window is zero sized; No need to build the Ui.
+    }
+    ui_canvas_build(canvas, settings, atlasFont, atlasImage);
+  }
+}
+
 static void ui_canvas_cursor_update(GapWindowComp* window, const UiInteractType interact) {
   static const GapCursor g_interactCursor[UiInteractType_Count] = {
       [UiInteractType_Text]           = GapCursor_Text,
@@ -442,13 +624,6 @@ static void ui_renderer_create(EcsWorld* world, const EcsEntityId window) {
   ecs_world_add_t(world, window, UiStatsComp);
 }
 
-static UiId ui_canvas_debug_elem(UiCanvasComp* canvas, const UiSettingsGlobalComp* settings) {
-  if (UNLIKELY(settings->inspectorMode != UiInspectorMode_None)) {
-    return canvas->activeId;
-  }
-  return sentinel_u64;
-}
-
 static u32 ui_canvas_query_for_window(
     EcsWorld*         world,
     const EcsEntityId window,
@@ -507,6 +682,7 @@ ecs_system_define(UiRenderSys) {
     stats->trackedElemCount = 0;
     stats->persistElemCount = 0;
     stats->commandCount     = 0;
+    stats->canvasBuildCount = 0;
 
     const GapVector winSize = gap_window_param(window, GapParam_WindowSize);
     if (!winSize.x || !winSize.y) {
@@ -528,9 +704,6 @@ ecs_system_define(UiRenderSys) {
     const f32      scale       = ui_window_scale(window, settings);
     const UiVector canvasSize  = ui_vector(winSize.x / scale, winSize.y / scale);
     UiRenderState  renderState = {
-         .settings      = settings,
-         .atlasFont     = atlasFont,
-         .atlasImage    = atlasImage,
          .renderer      = renderer,
          .rendObj       = rendObj,
          .clipRects[0]  = {.size = canvasSize},
@@ -550,16 +723,25 @@ ecs_system_define(UiRenderSys) {
       canvas->order        = i;
       renderState.canvas   = canvas;
 
-      const UiId          debugElem = ui_canvas_debug_elem(canvas, settings);
-      const UiBuildResult result    = ui_canvas_build(&renderState, debugElem);
-      if (!sentinel_check(result.hover.id) && result.hover.layer >= hover.layer) {
+      if (UNLIKELY(!canvas->output.valid)) {
+        continue; // Canvas has not been built yet.
+      }
+      ui_canvas_output_submit(&renderState, canvas);
+
+      const DynArray*    hoverables  = &canvas->output.hoverables;
+      const UiBuildHover canvasHover = ui_build_hover(
+          dynarray_begin_t(hoverables, UiBuildHoverable),
+          dynarray_end_t(hoverables, UiBuildHoverable),
+          canvas->inputPos);
+      if (!sentinel_check(canvasHover.id) && canvasHover.layer >= hover.layer) {
         hoveredCanvasIndex = i;
-        hover              = result.hover;
+        hover              = canvasHover;
       }
       interactType         = math_max(interactType, canvas->interactType);
       canvas->interactType = UiInteractType_None; // Interact type does not persist across frames.
 
-      stats->commandCount += result.commandCount;
+      stats->commandCount += canvas->output.commandCount;
+      stats->canvasBuildCount += canvas->output.rebuilt;
     }
     if (input && input_cursor_mode(input) == InputCursorMode_Locked) {
       // When the cursor is locked its be considered to not be 'hovering' over ui.
@@ -659,7 +841,7 @@ ecs_system_define(UiSoundSys) {
   for (UiSoundType type = 0; type != UiSoundType_Count; ++type) {
     if (soundRequests & (1 << type)) {
       SndObjectId id;
-      if (snd_object_new(mixer, &id) == SndResult_Success) {
+      if (snd_object_new(mixer, SndPriority_Interface, &id) == SndResult_Success) {
         snd_object_set_asset(mixer, id, soundAssetPerType[type]);
         for (SndChannel chan = 0; chan != SndChannel_Count; ++chan) {
           snd_object_set_gain(mixer, id, chan, soundGainPerType[type]);
@@ -676,6 +858,8 @@ ecs_module_init(ui_canvas_module) {
   ecs_register_view(CanvasView);
   ecs_register_view(RendObjView);
   ecs_register_view(InputGlobalView);
+  ecs_register_view(BuildGlobalView);
+  ecs_register_view(BuildWindowView);
   ecs_register_view(RenderGlobalView);
   ecs_register_view(SoundGlobalView);
   ecs_register_view(AtlasFontView);
@@ -688,6 +872,14 @@ ecs_module_init(ui_canvas_module) {
       ecs_view_id(CanvasView),
       ecs_view_id(WindowView));
 
+  ecs_register_system(
+      UiCanvasBuildSys,
+      ecs_view_id(BuildGlobalView),
+      ecs_view_id(AtlasFontView),
+      ecs_view_id(AtlasView),
+      ecs_view_id(BuildWindowView),
+      ecs_view_id(CanvasView));
+
   ecs_register_system(
       UiRenderSys,
       ecs_view_id(RenderGlobalView),
@@ -699,7 +891,10 @@ ecs_module_init(ui_canvas_module) {
 
   ecs_register_system(UiSoundSys, ecs_view_id(SoundGlobalView), ecs_view_id(CanvasView));
 
+  ecs_parallel(UiCanvasBuildSys, g_jobsWorkerCount);
+
   ecs_order(UiCanvasInputSys, UiOrder_Input);
+  ecs_order(UiCanvasBuildSys, UiOrder_Render - 1);
   ecs_order(UiRenderSys, UiOrder_Render);
   ecs_order(UiSoundSys, UiOrder_Render);
 }
@@ -714,6 +909,8 @@ ui_canvas_create(EcsWorld* world, const EcsEntityId window, const UiCanvasCreate
       .window          = window,
       .cmdBuffer       = ui_cmdbuffer_create(g_allocHeap),
       .textEditor      = ui_editor_create(g_allocHeap),
+      .textCache       = ui_text_cache_create(g_allocHeap),
+      .output          = ui_canvas_output_create(),
       .trackedElems    = dynarray_create_t(g_allocHeap, UiTrackedElem, 16),
       .persistentElems = dynarray_create_t(g_allocHeap, UiPersistentElem, 16));
 
@@ -1,3 +1,4 @@
+#include "core/bits.h"
 #include "core/dynarray.h"
 #include "log/logger.h"
 
@@ -272,3 +273,115 @@ UiCmd* ui_cmd_next(const UiCmdBuffer* buffer, UiCmd* prev) {
   UiCmd* next = ++prev;
   return next == dynarray_end_t(&buffer->commands, UiCmd) ? null : next;
 }
+
+INLINE_HINT static u64 ui_cmd_hash_u64(const u64 hash, const u64 val) {
+  return bits_hash_64_combine(hash, val);
+}
+
+INLINE_HINT static u64 ui_cmd_hash_f32(const u64 hash, const f32 val) {
+  const union {
+    f32 f;
+    u32 u;
+  } conv = {.f = val};
+  return ui_cmd_hash_u64(hash, conv.u);
+}
+
+INLINE_HINT static u64 ui_cmd_hash_vec(const u64 hash, const UiVector val) {
+  return ui_cmd_hash_f32(ui_cmd_hash_f32(hash, val.x), val.y);
+}
+
+INLINE_HINT static u64 ui_cmd_hash_text(const UiDrawText cmd) {
+  return bits_hash_64(mem_create(cmd.textPtr, cmd.textSize));
+}
+
+u64 ui_cmdbuffer_hash(const UiCmdBuffer* buffer) {
+  /**
+   * NOTE: Hashes the individual fields as the padding and unused union bytes are not initialized.
+   */
+  u64 h = bits_hash_64_val(buffer->commands.size);
+  dynarray_for_t(&buffer->commands, UiCmd, cmd) {
+    h = ui_cmd_hash_u64(h, cmd->type);
+    switch (cmd->type) {
+    case UiCmd_RectPush:
+    case UiCmd_RectPop:
+    case UiCmd_ContainerPop:
+    case UiCmd_StylePush:
+    case UiCmd_StylePop:
+      break;
+    case UiCmd_RectPos:
+      h = ui_cmd_hash_u64(
+          h, cmd->rectPos.origin | cmd->rectPos.units << 8 | cmd->rectPos.axis << 16);
+      h = ui_cmd_hash_vec(h, cmd->rectPos.offset);
+      break;
+    case UiCmd_RectSize:
+      h = ui_cmd_hash_u64(h, cmd->rectSize.units | cmd->rectSize.axis << 8);
+      h = ui_cmd_hash_vec(h, cmd->rectSize.size);
+      break;
+    case UiCmd_RectSizeTo:
+      h = ui_cmd_hash_u64(
+          h, cmd->rectSizeTo.origin | cmd->rectSizeTo.units << 8 | cmd->rectSizeTo.axis << 16);
+      h = ui_cmd_hash_vec(h, cmd->rectSizeTo.offset);
+      break;
+    case UiCmd_RectSizeGrow:
+      h = ui_cmd_hash_u64(h, cmd->rectSizeGrow.units | cmd->rectSizeGrow.axis << 8);
+      h = ui_cmd_hash_vec(h, cmd->rectSizeGrow.delta);
+      break;
+    case UiCmd_ContainerPush:
+      h = ui_cmd_hash_u64(h, cmd->containerPush.clip | cmd->containerPush.layer << 8);
+      break;
+    case UiCmd_StyleColor:
+      h = ui_cmd_hash_u64(h, cmd->styleColor.value.data);
+      break;
+    case UiCmd_StyleColorMult:
+      h = ui_cmd_hash_f32(h, cmd->styleColorMult.value);
+      break;
+    case UiCmd_StyleOutline:
+      h = ui_cmd_hash_u64(h, cmd->styleOutline.value);
+      break;
+    case UiCmd_StyleLayer:
+      h = ui_cmd_hash_u64(h, cmd->styleLayer.value);
+      break;
+    case UiCmd_StyleMode:
+      h = ui_cmd_hash_u64(h, cmd->styleMode.value);
+      break;
+    case UiCmd_StyleVariation:
+      h = ui_cmd_hash_u64(h, cmd->styleVariation.value);
+      break;
+    case UiCmd_StyleWeight:
+      h = ui_cmd_hash_u64(h, cmd->styleWeight.value);
+      break;
+    case UiCmd_StyleTransform:
+      h = ui_cmd_hash_u64(h, cmd->styleTransform.value);
+      break;
+    case UiCmd_DrawText:
+      h = ui_cmd_hash_u64(h, cmd->drawText.id);
+      h = ui_cmd_hash_u64(h, cmd->drawText.fontSize | (u32)cmd->drawText.flags << 16);
+      h = ui_cmd_hash_u64(h, cmd->drawText.align);
+      h = ui_cmd_hash_u64(h, ui_cmd_hash_text(cmd->drawText));
+      break;
+    case UiCmd_DrawGlyph:
+      h = ui_cmd_hash_u64(h, cmd->drawGlyph.id);
+      h = ui_cmd_hash_u64(h, cmd->drawGlyph.cp);
+      h = ui_cmd_hash_f32(h, cmd->drawGlyph.angleRad);
+      h = ui_cmd_hash_u64(h, cmd->drawGlyph.maxCorner | (u32)cmd->drawGlyph.flags << 16);
+      break;
+    case UiCmd_DrawImage:
+      h = ui_cmd_hash_u64(h, cmd->drawImage.id);
+      h = ui_cmd_hash_u64(h, cmd->drawImage.img);
+      h = ui_cmd_hash_f32(h, cmd->drawImage.angleRad);
+      h = ui_cmd_hash_u64(h, cmd->drawImage.maxCorner | (u32)cmd->drawImage.flags << 16);
+      break;
+    }
+  }
+  return h;
+}
+
+usize ui_cmdbuffer_text_size(const UiCmdBuffer* buffer) {
+  usize res = 0;
+  dynarray_for_t(&buffer->commands, UiCmd, cmd) {
+    if (cmd->type == UiCmd_DrawText) {
+      res += cmd->drawText.textSize;
+    }
+  }
+  return res;
+}
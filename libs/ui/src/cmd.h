@@ -145,6 +145,17 @@ void         ui_cmdbuffer_destroy(UiCmdBuffer*);
 void         ui_cmdbuffer_clear(UiCmdBuffer*);
 u32          ui_cmdbuffer_count(const UiCmdBuffer*);
 
+/**
+ * Compute a hash of all the commands (including the text contents) in the buffer.
+ * NOTE: Can be used to detect if the buffer contents changed compared to a previous frame.
+ */
+u64 ui_cmdbuffer_hash(const UiCmdBuffer*);
+
+/**
+ * Total size (in bytes) of the text contents of all the commands in the buffer.
+ */
+usize ui_cmdbuffer_text_size(const UiCmdBuffer*);
+
 void ui_cmd_push_rect_push(UiCmdBuffer*);
 void ui_cmd_push_rect_pop(UiCmdBuffer*);
 void ui_cmd_push_rect_pos(UiCmdBuffer*, UiBase origin, UiVector offset, UiBase units, UiAxis);
@@ -6,3 +6,4 @@
  */
 
 typedef struct sUiCmdBuffer UiCmdBuffer;
+typedef struct sUiTextCache UiTextCache;
@@ -1,4 +1,7 @@
+#include "core/alloc.h"
+#include "core/bits.h"
 #include "core/diag.h"
+#include "core/dynarray.h"
 #include "core/math.h"
 #include "core/unicode.h"
 #include "core/utf8.h"
@@ -50,6 +53,187 @@ typedef struct {
   u32              count, active;
 } UiTextBackgroundCollector;
 
+typedef struct {
+  u32 lineCount;
+  u32 maxLineCharWidth;
+  f32 totalWidth, totalHeight;
+} UiTextLayout;
+
+typedef struct {
+  u32      textOffset, textSize;
+  UiVector size;
+  f32      posY;
+} UiTextCacheLine;
+
+typedef struct {
+  u32     lineIndex;
+  UiColor color;
+  f32     start, end;
+} UiTextCacheBackground;
+
+typedef struct {
+  u64          key; // NOTE: 64 bit to make collisions between different texts unlikely.
+  u32          textSize;
+  bool         used;
+  u32          backgroundCount;
+  UiTextLayout layout;
+  Mem          data; // UiTextCacheLine[lineCount] + UiTextCacheBackground[backgroundCount].
+} UiTextCacheEntry;
+
+struct sUiTextCache {
+  Allocator* alloc;
+  DynArray   entries; // UiTextCacheEntry[], sorted on the key and text size.
+};
+
+static i8 ui_text_cache_compare_entry(const void* a, const void* b) {
+  const UiTextCacheEntry* entryA = a;
+  const UiTextCacheEntry* entryB = b;
+  const i8                order  = compare_u64(&entryA->key, &entryB->key);
+  return order ? order : compare_u32(&entryA->textSize, &entryB->textSize);
+}
+
+static u64 ui_text_cache_key(
+    const AssetFontTexComp* font,
+    const UiFlags           flags,
+    const UiRect            totalRect,
+    const String            text,
+    const f32               fontSize,
+    const u8                fontVariation,
+    const UiTransform       fontTransform) {
+  static const UiFlags g_layoutFlags =
+      UiFlags_AllowWordBreak | UiFlags_VerticalOverflow | UiFlags_SingleLine | UiFlags_NoLineBreaks;
+
+  const bool overflowVert = (flags & UiFlags_VerticalOverflow) != 0;
+  const f32  layoutDims[] = {fontSize, totalRect.width, overflowVert ? 0 : totalRect.height};
+  const u32  layoutVals[] = {
+      (u32)(flags & g_layoutFlags),
+      fontVariation,
+      fontTransform,
+      asset_fonttex_generation(font),
+      (u32)(uptr)font,
+      (u32)((u64)(uptr)font >> 32),
+  };
+  u64 key = bits_hash_64(text);
+  key     = bits_hash_64_combine(key, bits_hash_64(mem_var(layoutDims)));
+  key     = bits_hash_64_combine(key, bits_hash_64(mem_var(layoutVals)));
+  return key;
+}
+
+static bool ui_text_cache_get(
+    UiTextCache*               cache,
+    const u64                  key,
+    const String               text,
+    UiTextLine                 outLines[PARAM_ARRAY_SIZE(ui_text_max_lines)],
+    UiTextBackgroundCollector* outBackgrounds,
+    UiTextLayout*              outLayout) {
+  const UiTextCacheEntry tgt = {.key = key, .textSize = (u32)text.size};
+  UiTextCacheEntry*      entry =
+      dynarray_search_binary(&cache->entries, ui_text_cache_compare_entry, &tgt);
+  if (!entry) {
+    return false;
+  }
+  entry->used = true;
+
+  const UiTextCacheLine*       lines = entry->data.ptr;
+  const UiTextCacheBackground* bgs   = (const void*)(lines + entry->layout.lineCount);
+  for (u32 i = 0; i != entry->layout.lineCount; ++i) {
+    outLines[i] = (UiTextLine){
+        .text = string_slice(text, lines[i].textOffset, lines[i].textSize),
+        .size = lines[i].size,
+        .posY = lines[i].posY,
+    };
+  }
+  for (u32 i = 0; i != entry->backgroundCount; ++i) {
+    outBackgrounds->values[i] = (UiTextBackground){
+        .line  = &outLines[bgs[i].lineIndex],
+        .color = bgs[i].color,
+        .start = bgs[i].start,
+        .end   = bgs[i].end,
+    };
+  }
+  outBackgrounds->count = entry->backgroundCount;
+  *outLayout            = entry->layout;
+  return true;
+}
+
+static void ui_text_cache_put(
+    UiTextCache*                     cache,
+    const u64                        key,
+    const String                     text,
+    const UiTextLine                 lines[PARAM_ARRAY_SIZE(ui_text_max_lines)],
+    const UiTextBackgroundCollector* backgrounds,
+    const UiTextLayout*              layout) {
+  if (!layout->lineCount) {
+    return; // Nothing to cache.
+  }
+  const usize linesSize = sizeof(UiTextCacheLine) * layout->lineCount;
+  const usize bgsSize   = sizeof(UiTextCacheBackground) * backgrounds->count;
+  const Mem   data      = alloc_alloc(cache->alloc, linesSize + bgsSize, alignof(UiTextCacheLine));
+
+  UiTextCacheLine*       outLines = data.ptr;
+  UiTextCacheBackground* outBgs   = (void*)(outLines + layout->lineCount);
+  for (u32 i = 0; i != layout->lineCount; ++i) {
+    outLines[i] = (UiTextCacheLine){
+        .textOffset = lines[i].text.size ? (u32)((u8*)lines[i].text.ptr - (u8*)text.ptr) : 0,
+        .textSize   = (u32)lines[i].text.size,
+        .size       = lines[i].size,
+        .posY       = lines[i].posY,
+    };
+  }
+  for (u32 i = 0; i != backgrounds->count; ++i) {
+    outBgs[i] = (UiTextCacheBackground){
+        .lineIndex = (u32)(backgrounds->values[i].line - lines),
+        .color     = backgrounds->values[i].color,
+        .start     = backgrounds->values[i].start,
+        .end       = backgrounds->values[i].end,
+    };
+  }
+
+  const UiTextCacheEntry entry = {
+      .key             = key,
+      .textSize        = (u32)text.size,
+      .used            = true,
+      .backgroundCount = backgrounds->count,
+      .layout          = *layout,
+      .data            = data,
+  };
+  UiTextCacheEntry* slot = dynarray_insert_sorted_t(
+      &cache->entries, UiTextCacheEntry, ui_text_cache_compare_entry, &entry);
+  *slot = entry;
+}
+
+UiTextCache* ui_text_cache_create(Allocator* alloc) {
+  UiTextCache* cache = alloc_alloc_t(alloc, UiTextCache);
+
+  *cache = (UiTextCache){
+      .alloc   = alloc,
+      .entries = dynarray_create_t(alloc, UiTextCacheEntry, 64),
+  };
+  return cache;
+}
+
+void ui_text_cache_destroy(UiTextCache* cache) {
+  dynarray_for_t(&cache->entries, UiTextCacheEntry, entry) {
+    alloc_free(cache->alloc, entry->data);
+  }
+  dynarray_destroy(&cache->entries);
+  alloc_free_t(cache->alloc, cache);
+}
+
+void ui_text_cache_flush(UiTextCache* cache) {
+  for (usize i = cache->entries.size; i-- != 0;) {
+    UiTextCacheEntry* entry = dynarray_at_t(&cache->entries, i, UiTextCacheEntry);
+    if (entry->used) {
+      entry->used = false;
+      continue;
+    }
+    alloc_free(cache->alloc, entry->data);
+    dynarray_remove(&cache->entries, i, 1);
+  }
+}
+
+u32 ui_text_cache_count(const UiTextCache* cache) { return (u32)cache->entries.size; }
+
 static Unicode ui_text_apply_transform(Unicode cp, const UiTransform transform) {
   if (UNLIKELY(transform == UiTransform_ToUpper && cp >= 'a' && cp <= 'z')) {
     cp ^= 0x20;
@@ -224,6 +408,65 @@ End:
   return string_consume(text, cursorConsumed.charIndex);
 }
 
+/**
+ * Compute all the lines (and their backgrounds) that fit in the given rectangle.
+ */
+static void ui_text_layout(
+    const AssetFontTexComp*    font,
+    const UiFlags              flags,
+    const UiRect               totalRect,
+    const String               text,
+    const f32                  fontSize,
+    const u8                   fontVariation,
+    const UiTransform          fontTransform,
+    UiTextLine                 lines[PARAM_ARRAY_SIZE(ui_text_max_lines)],
+    UiTextBackgroundCollector* bgCollector,
+    UiTextLayout*              out) {
+  const bool overflowVert     = (flags & UiFlags_VerticalOverflow) != 0;
+  u32        lineCount        = 0;
+  f32        lineY            = 0;
+  f32        totalWidth       = 0;
+  u32        maxLineCharWidth = 0;
+  String     remText          = text;
+  while (!string_is_empty(remText)) {
+    const f32 lineHeight = lineCount ? (1 + font->lineSpacing) * fontSize : fontSize;
+    if (!overflowVert && lineY + lineHeight >= totalRect.height - font->lineSpacing * fontSize) {
+      break; // Not enough space remaining for this line.
+    }
+    lineY += lineHeight;
+
+    if (lineCount + 1 >= ui_text_max_lines) {
+      log_w("Ui text line count exceeds maximum", log_param("limit", fmt_int(ui_text_max_lines)));
+      break;
+    }
+    const usize lineIndex = lineCount++;
+    remText               = ui_text_line(
+        font,
+        flags,
+        remText,
+        totalRect.width,
+        fontSize,
+        fontVariation,
+        fontTransform,
+        bgCollector,
+        &lines[lineIndex]);
+
+    lines[lineIndex].posY = lineY;
+    totalWidth            = math_max(totalWidth, lines[lineIndex].size.width);
+    maxLineCharWidth      = math_max(maxLineCharWidth, (u32)lines[lineIndex].text.size);
+
+    if (flags & UiFlags_SingleLine) {
+      break;
+    }
+  }
+  *out = (UiTextLayout){
+      .lineCount        = lineCount,
+      .maxLineCharWidth = maxLineCharWidth,
+      .totalWidth       = totalWidth,
+      .totalHeight      = lineY,
+  };
+}
+
 static UiRect ui_text_inner_rect(const UiRect rect, const UiVector size, const UiAlign align) {
   const f32 centerX = rect.x + (rect.width - size.width) * 0.5f;
   const f32 centerY = rect.y + (rect.height - size.height) * 0.5f;
@@ -452,6 +695,7 @@ static void ui_text_build_background(UiTextBuildState* state, const UiTextBackgr
 }
 
 UiTextBuildResult ui_text_build(
+    UiTextCache*                    cache,
     const AssetFontTexComp*         font,
     const UiFlags                   flags,
     const UiRect                    totalRect,
@@ -473,47 +717,33 @@ UiTextBuildResult ui_text_build(
   /**
    * Compute all lines and backgrounds.
    */
-  const bool                overflowVert = (flags & UiFlags_VerticalOverflow) != 0;
-  UiTextBackgroundCollector bgCollector  = {.active = sentinel_u32};
+  UiTextBackgroundCollector bgCollector = {.active = sentinel_u32};
   UiTextLine                lines[ui_text_max_lines];
-  u32                       lineCount        = 0;
-  f32                       lineY            = 0;
-  f32                       totalWidth       = 0;
-  u32                       maxLineCharWidth = 0;
-  String                    remText          = text;
-  while (!string_is_empty(remText)) {
-    const f32 lineHeight = lineCount ? (1 + font->lineSpacing) * fontSize : fontSize;
-    if (!overflowVert && lineY + lineHeight >= totalRect.height - font->lineSpacing * fontSize) {
-      break; // Not enough space remaining for this line.
-    }
-    lineY += lineHeight;
+  UiTextLayout              layout;
 
-    if (lineCount + 1 >= ui_text_max_lines) {
-      log_w("Ui text line count exceeds maximum", log_param("limit", fmt_int(ui_text_max_lines)));
-      break;
-    }
-    const usize lineIndex = lineCount++;
-    remText               = ui_text_line(
+  const u64 cacheKey =
+      cache ? ui_text_cache_key(font, flags, totalRect, text, fontSize, fontVariation, fontTransform)
+            : 0;
+  if (!cache || !ui_text_cache_get(cache, cacheKey, text, lines, &bgCollector, &layout)) {
+    ui_text_layout(
         font,
         flags,
-        remText,
-        totalRect.width,
+        totalRect,
+        text,
         fontSize,
         fontVariation,
         fontTransform,
+        lines,
         &bgCollector,
-        &lines[lineIndex]);
-
-    lines[lineIndex].posY = lineY;
-    totalWidth            = math_max(totalWidth, lines[lineIndex].size.width);
-    maxLineCharWidth      = math_max(maxLineCharWidth, (u32)lines[lineIndex].text.size);
-
-    if (flags & UiFlags_SingleLine) {
-      break;
+        &layout);
+    if (cache) {
+      ui_text_cache_put(cache, cacheKey, text, lines, &bgCollector, &layout);
     }
   }
-  const UiVector size = ui_vector(totalWidth, lineY + font->baseline * fontSize);
-  const UiRect   rect = ui_text_inner_rect(totalRect, size, align);
+  const u32 lineCount = layout.lineCount;
+  const f32      height = layout.totalHeight + font->baseline * fontSize;
+  const UiVector size   = ui_vector(layout.totalWidth, height);
+  const UiRect   rect   = ui_text_inner_rect(totalRect, size, align);
 
   UiTextBuildState state = {
       .font               = font,
@@ -557,7 +787,7 @@ UiTextBuildResult ui_text_build(
   return (UiTextBuildResult){
       .rect             = rect,
       .lineCount        = lineCount,
-      .maxLineCharWidth = maxLineCharWidth,
+      .maxLineCharWidth = layout.maxLineCharWidth,
       .hoveredCharIndex = state.hoveredCharIndex,
   };
 }
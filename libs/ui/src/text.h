@@ -36,7 +36,28 @@ typedef struct {
   usize hoveredCharIndex;
 } UiTextBuildResult;
 
+/**
+ * Cache of text layouts (line breaks and backgrounds), keyed on the text, font, font-size and the
+ * size of the rectangle. Avoids re-computing the layout of text that did not change between builds.
+ * NOTE: Not thread-safe, should only be used by a single builder at a time.
+ */
+typedef struct sUiTextCache UiTextCache;
+
+UiTextCache* ui_text_cache_create(Allocator*);
+void         ui_text_cache_destroy(UiTextCache*);
+
+/**
+ * Evict all layouts that have not been used since the last flush.
+ */
+void ui_text_cache_flush(UiTextCache*);
+u32  ui_text_cache_count(const UiTextCache*);
+
+/**
+ * Build the atoms for the given text.
+ * NOTE: Optionally a cache can be provided to reuse the layouts of previous builds.
+ */
 UiTextBuildResult ui_text_build(
+    UiTextCache*, // [Optional].
     const AssetFontTexComp*,
     UiFlags     flags,
     UiRect      totalRect,
@@ -6,6 +6,12 @@ typedef enum {
   VfxStat_SpriteCount,
   VfxStat_LightCount,
   VfxStat_StampCount,
+  VfxStat_SimulateCount, // Particles simulated, excludes skipped ticks due to a reduced lod.
+  VfxStat_SimulateNs,    // Time spent simulating particles, in nanoseconds.
+  VfxStat_LodFull,
+  VfxStat_LodReduced,
+  VfxStat_LodFar,
+  VfxStat_LodPaused,
 
   VfxStat_Count,
 } VfxStat;
@@ -21,5 +27,6 @@ ecs_comp_extern_public(VfxStatsGlobalComp) { VfxStatSet set; };
 String vfx_stats_name(VfxStat);
 i32    vfx_stats_get(const VfxStatSet*, VfxStat);
 void   vfx_stats_report(VfxStatSet*, VfxStat);
+void   vfx_stats_report_n(VfxStatSet*, VfxStat, i32 amount);
 void   vfx_stats_clear(VfxStatSet*);
 void   vfx_stats_combine(VfxStatSet*, const VfxStatSet*);
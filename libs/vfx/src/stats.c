@@ -75,6 +75,12 @@ String vfx_stats_name(const VfxStat stat) {
       [VfxStat_SpriteCount]   = string_static("Sprites"),
       [VfxStat_LightCount]    = string_static("Lights"),
       [VfxStat_StampCount]    = string_static("Stamps"),
+      [VfxStat_SimulateCount] = string_static("Simulated"),
+      [VfxStat_SimulateNs]    = string_static("Simulate time"),
+      [VfxStat_LodFull]       = string_static("Lod full"),
+      [VfxStat_LodReduced]    = string_static("Lod reduced"),
+      [VfxStat_LodFar]        = string_static("Lod far"),
+      [VfxStat_LodPaused]     = string_static("Lod paused"),
   };
   return g_names[stat];
 }
@@ -83,6 +89,10 @@ i32 vfx_stats_get(const VfxStatSet* set, const VfxStat stat) { return set->value
 
 void vfx_stats_report(VfxStatSet* set, const VfxStat stat) { ++set->valuesAccum[stat]; }
 
+void vfx_stats_report_n(VfxStatSet* set, const VfxStat stat, const i32 amount) {
+  set->valuesAccum[stat] += amount;
+}
+
 void vfx_stats_clear(VfxStatSet* set) {
   mem_set(mem_var(set->valuesAccum), 0);
   mem_set(mem_var(set->valuesLast), 0);
@@ -2,12 +2,14 @@
 #include "asset/manager.h"
 #include "asset/vfx.h"
 #include "core/alloc.h"
+#include "core/array.h"
+#include "core/bits.h"
 #include "core/diag.h"
-#include "core/dynarray.h"
 #include "core/float.h"
 #include "core/math.h"
 #include "core/noise.h"
 #include "core/rng.h"
+#include "core/time.h"
 #include "ecs/entity.h"
 #include "ecs/utils.h"
 #include "ecs/view.h"
@@ -15,6 +17,7 @@
 #include "log/logger.h"
 #include "rend/light.h"
 #include "scene/lifetime.h"
+#include "scene/camera.h"
 #include "scene/light.h"
 #include "scene/tag.h"
 #include "scene/time.h"
@@ -28,15 +31,49 @@
 #include "rend.h"
 #include "sprite.h"
 
+#ifdef VOLO_SIMD
+#include "core/simd.h"
+#endif
+
 #define vfx_system_max_asset_requests 4
 #define vfx_system_track_stats 1
 #define vfx_system_warn_inst_count 512
+#define vfx_system_particle_align 16
+#define vfx_system_particle_min_capacity 4
+#define vfx_system_max_cameras 4
+#define vfx_system_lod_dist_reduced 50.0f
+#define vfx_system_lod_dist_far 150.0f
+
+/**
+ * Simulation level-of-detail, based on the visibility and the distance to the closest camera.
+ * NOTE: Systems that are not simulated every frame accumulate the skipped time and simulate it in
+ * a single (larger) step on their next tick; this keeps the result deterministic and allows for
+ * catching up immediately when the lod improves.
+ */
+typedef enum {
+  VfxSystemLod_Full,    // Simulated every frame.
+  VfxSystemLod_Reduced, // Simulated at a reduced tick rate.
+  VfxSystemLod_Far,     // Simulated at a low tick rate.
+  VfxSystemLod_Paused,  // Not visible; emission is paused and simulated at a low tick rate.
+
+  VfxSystemLod_Count,
+} VfxSystemLod;
+
+static const TimeDuration g_vfxSystemLodInterval[VfxSystemLod_Count] = {
+    [VfxSystemLod_Full]    = 0,
+    [VfxSystemLod_Reduced] = time_milliseconds(50),
+    [VfxSystemLod_Far]     = time_milliseconds(200),
+    [VfxSystemLod_Paused]  = time_milliseconds(200),
+};
 
 typedef enum {
   VfxLoad_Acquired  = 1 << 0,
   VfxLoad_Unloading = 1 << 1,
 } VfxLoadFlags;
 
+/**
+ * View of a single particle, gathered from (or scattered into) the emitter particle streams.
+ */
 typedef struct {
   u8        emitter;
   u8        alpha; // Normalized.
@@ -48,17 +85,34 @@ typedef struct {
   GeoVector velo;
 } VfxSystemInstance;
 
-ASSERT(sizeof(VfxSystemInstance) <= 64, "Instance should fit in a single cacheline on x86");
+/**
+ * Structure-of-arrays particle storage.
+ * NOTE: The capacity is a multiple of 4 and all streams are 16 byte aligned; this allows the
+ * simulation kernels to process the particles 4 at a time without a scalar tail.
+ */
+typedef struct {
+  u32      count, capacity;
+  Mem      mem;
+  GeoQuat* rot;
+  f32 *    posX, *posY, *posZ;
+  f32 *    veloX, *veloY, *veloZ;
+  f32*     scale;
+  f32 *    ageSec, *lifetimeSec;
+  u16*     spriteAtlasBaseIndex;
+  u8*      alpha; // Normalized.
+} VfxParticles;
 
 typedef struct {
-  u64 spawnCount;
+  u64          spawnCount;
+  VfxParticles particles;
 } VfxEmitterState;
 
 ecs_comp_define(VfxSystemStateComp) {
   TimeDuration    age, emitAge;
+  TimeDuration    lodDelta; // Time that has not been simulated yet due to a reduced tick rate.
   u16             assetVersion;
+  VfxSystemLod    lod;
   VfxEmitterState emitters[asset_vfx_max_emitters];
-  DynArray        instances; // VfxSystemInstance[].
 };
 
 ecs_comp_define(VfxSystemAssetComp) {
@@ -68,9 +122,130 @@ ecs_comp_define(VfxSystemAssetComp) {
 
 ecs_comp_define(VfxSystemStatsComp);
 
+static usize vfx_particles_mem_size(const u32 capacity) {
+  static const usize g_bytesPerParticle =
+      sizeof(GeoQuat) + sizeof(f32) * 9 + sizeof(u16) + sizeof(u8);
+  return bits_align(g_bytesPerParticle * capacity, vfx_system_particle_align);
+}
+
+static void vfx_particles_bind(VfxParticles* p, const Mem mem, const u32 capacity) {
+  u8* itr = mem.ptr;
+  // clang-format off
+  p->rot                  = (GeoQuat*)itr; itr += sizeof(GeoQuat) * capacity;
+  p->posX                 = (f32*)itr;     itr += sizeof(f32) * capacity;
+  p->posY                 = (f32*)itr;     itr += sizeof(f32) * capacity;
+  p->posZ                 = (f32*)itr;     itr += sizeof(f32) * capacity;
+  p->veloX                = (f32*)itr;     itr += sizeof(f32) * capacity;
+  p->veloY                = (f32*)itr;     itr += sizeof(f32) * capacity;
+  p->veloZ                = (f32*)itr;     itr += sizeof(f32) * capacity;
+  p->scale                = (f32*)itr;     itr += sizeof(f32) * capacity;
+  p->ageSec               = (f32*)itr;     itr += sizeof(f32) * capacity;
+  p->lifetimeSec          = (f32*)itr;     itr += sizeof(f32) * capacity;
+  p->spriteAtlasBaseIndex = (u16*)itr;     itr += sizeof(u16) * capacity;
+  p->alpha                = (u8*)itr;
+  // clang-format on
+  p->mem      = mem;
+  p->capacity = capacity;
+}
+
+static void vfx_particles_destroy(VfxParticles* p) {
+  if (mem_valid(p->mem)) {
+    alloc_free(g_allocHeap, p->mem);
+  }
+  *p = (VfxParticles){0};
+}
+
+static void vfx_particles_grow(VfxParticles* p) {
+  const u32 newCapacity = p->capacity ? p->capacity * 2 : vfx_system_particle_min_capacity;
+  const usize memSize   = vfx_particles_mem_size(newCapacity);
+  const Mem   newMem    = alloc_alloc(g_allocHeap, memSize, vfx_system_particle_align);
+  mem_set(newMem, 0); // Zero the padding lanes to avoid simulating garbage (or denormal) values.
+
+  VfxParticles res = {.count = p->count};
+  vfx_particles_bind(&res, newMem, newCapacity);
+
+  const u32 n = p->count;
+  mem_cpy(mem_create(res.rot, sizeof(GeoQuat) * n), mem_create(p->rot, sizeof(GeoQuat) * n));
+  mem_cpy(mem_create(res.posX, sizeof(f32) * n), mem_create(p->posX, sizeof(f32) * n));
+  mem_cpy(mem_create(res.posY, sizeof(f32) * n), mem_create(p->posY, sizeof(f32) * n));
+  mem_cpy(mem_create(res.posZ, sizeof(f32) * n), mem_create(p->posZ, sizeof(f32) * n));
+  mem_cpy(mem_create(res.veloX, sizeof(f32) * n), mem_create(p->veloX, sizeof(f32) * n));
+  mem_cpy(mem_create(res.veloY, sizeof(f32) * n), mem_create(p->veloY, sizeof(f32) * n));
+  mem_cpy(mem_create(res.veloZ, sizeof(f32) * n), mem_create(p->veloZ, sizeof(f32) * n));
+  mem_cpy(mem_create(res.scale, sizeof(f32) * n), mem_create(p->scale, sizeof(f32) * n));
+  mem_cpy(mem_create(res.ageSec, sizeof(f32) * n), mem_create(p->ageSec, sizeof(f32) * n));
+  mem_cpy(
+      mem_create(res.lifetimeSec, sizeof(f32) * n), mem_create(p->lifetimeSec, sizeof(f32) * n));
+  mem_cpy(
+      mem_create(res.spriteAtlasBaseIndex, sizeof(u16) * n),
+      mem_create(p->spriteAtlasBaseIndex, sizeof(u16) * n));
+  mem_cpy(mem_create(res.alpha, n), mem_create(p->alpha, n));
+
+  vfx_particles_destroy(p);
+  *p = res;
+}
+
+static void vfx_particles_push(VfxParticles* p, const VfxSystemInstance* inst) {
+  if (UNLIKELY(p->count == p->capacity)) {
+    vfx_particles_grow(p);
+  }
+  const u32 i                = p->count++;
+  p->rot[i]                  = inst->rot;
+  p->posX[i]                 = inst->pos.x;
+  p->posY[i]                 = inst->pos.y;
+  p->posZ[i]                 = inst->pos.z;
+  p->veloX[i]                = inst->velo.x;
+  p->veloY[i]                = inst->velo.y;
+  p->veloZ[i]                = inst->velo.z;
+  p->scale[i]                = inst->scale;
+  p->ageSec[i]               = inst->ageSec;
+  p->lifetimeSec[i]          = inst->lifetimeSec;
+  p->spriteAtlasBaseIndex[i] = inst->spriteAtlasBaseIndex;
+  p->alpha[i]                = inst->alpha;
+}
+
+static VfxSystemInstance vfx_particles_get(const VfxParticles* p, const u8 emitter, const u32 i) {
+  diag_assert(i < p->count);
+  return (VfxSystemInstance){
+      .emitter              = emitter,
+      .alpha                = p->alpha[i],
+      .spriteAtlasBaseIndex = p->spriteAtlasBaseIndex[i],
+      .lifetimeSec          = p->lifetimeSec[i],
+      .ageSec               = p->ageSec[i],
+      .scale                = p->scale[i],
+      .pos                  = geo_vector(p->posX[i], p->posY[i], p->posZ[i]),
+      .rot                  = p->rot[i],
+      .velo                 = geo_vector(p->veloX[i], p->veloY[i], p->veloZ[i]),
+  };
+}
+
+/**
+ * Remove the particle at the given index by moving the last particle into its place.
+ */
+static void vfx_particles_remove(VfxParticles* p, const u32 i) {
+  diag_assert(i < p->count);
+  const u32 last = --p->count;
+  if (i != last) {
+    p->rot[i]                  = p->rot[last];
+    p->posX[i]                 = p->posX[last];
+    p->posY[i]                 = p->posY[last];
+    p->posZ[i]                 = p->posZ[last];
+    p->veloX[i]                = p->veloX[last];
+    p->veloY[i]                = p->veloY[last];
+    p->veloZ[i]                = p->veloZ[last];
+    p->scale[i]                = p->scale[last];
+    p->ageSec[i]               = p->ageSec[last];
+    p->lifetimeSec[i]          = p->lifetimeSec[last];
+    p->spriteAtlasBaseIndex[i] = p->spriteAtlasBaseIndex[last];
+    p->alpha[i]                = p->alpha[last];
+  }
+}
+
 static void ecs_destruct_system_state_comp(void* data) {
   VfxSystemStateComp* comp = data;
-  dynarray_destroy(&comp->instances);
+  array_for_t(comp->emitters, VfxEmitterState, emitter) {
+    vfx_particles_destroy(&emitter->particles);
+  }
 }
 
 static void ecs_combine_system_asset(void* dataA, void* dataB) {
@@ -174,11 +349,7 @@ ecs_system_define(VfxSystemStateInitSys) {
   EcsView* initView = ecs_world_view_t(world, InitView);
   for (EcsIterator* itr = ecs_view_itr(initView); ecs_view_walk(itr);) {
     const EcsEntityId e = ecs_view_entity(itr);
-    ecs_world_add_t(
-        world,
-        e,
-        VfxSystemStateComp,
-        .instances = dynarray_create_t(g_allocHeap, VfxSystemInstance, 4));
+    ecs_world_add_t(world, e, VfxSystemStateComp);
 
 #if vfx_system_track_stats
     ecs_world_add_empty_t(world, e, VfxStatsAnyComp);
@@ -363,16 +534,19 @@ static void vfx_system_spawn(
     spawnAlpha *= sysCfg->alpha;
   }
 
-  *dynarray_push_t(&state->instances, VfxSystemInstance) = (VfxSystemInstance){
-      .emitter              = emitter,
-      .alpha                = (u8)(math_clamp_f32(spawnAlpha, 0.0f, 1.0f) * u8_max),
-      .spriteAtlasBaseIndex = spriteAtlasEntryIndex,
-      .lifetimeSec = vfx_time_to_seconds(vfx_sample_range_duration(&emitterAsset->lifetime)),
-      .scale       = spawnScale,
-      .pos         = geo_vector_add(spawnPos, vfx_random_in_sphere(spawnRadius)),
-      .rot         = vfx_sample_range_rotation(&emitterAsset->rotation),
-      .velo        = geo_vector_mul(spawnDir, spawnSpeed),
-  };
+  VfxParticles* particles = &state->emitters[emitter].particles;
+  vfx_particles_push(
+      particles,
+      &(VfxSystemInstance){
+          .emitter              = emitter,
+          .alpha                = (u8)(math_clamp_f32(spawnAlpha, 0.0f, 1.0f) * u8_max),
+          .spriteAtlasBaseIndex = spriteAtlasEntryIndex,
+          .lifetimeSec = vfx_time_to_seconds(vfx_sample_range_duration(&emitterAsset->lifetime)),
+          .scale       = spawnScale,
+          .pos         = geo_vector_add(spawnPos, vfx_random_in_sphere(spawnRadius)),
+          .rot         = vfx_sample_range_rotation(&emitterAsset->rotation),
+          .velo        = geo_vector_mul(spawnDir, spawnSpeed),
+      });
 }
 
 static u64 vfx_emitter_count(const AssetVfxEmitter* emitterAsset, const TimeDuration age) {
@@ -396,12 +570,94 @@ static void vfx_system_reset(VfxSystemStateComp* state) {
    * system with fast dying particles (for example fire) its less intrusive to simply let those old
    * instances die on their own.
    */
-  for (u32 i = (u32)state->instances.size; i-- != 0;) {
-    const VfxSystemInstance* instance = dynarray_at_t(&state->instances, i, VfxSystemInstance);
-    if (instance->lifetimeSec > 60.0f) {
-      dynarray_remove_unordered(&state->instances, i, 1);
+  array_for_t(state->emitters, VfxEmitterState, emitter) {
+    VfxParticles* particles = &emitter->particles;
+    for (u32 i = particles->count; i-- != 0;) {
+      if (particles->lifetimeSec[i] > 60.0f) {
+        vfx_particles_remove(particles, i);
+      }
+    }
+  }
+}
+
+/**
+ * Integrate the particle motion (force, friction, expansion and movement) and advance their age.
+ */
+static void vfx_particles_integrate(
+    VfxParticles* p, const AssetVfxEmitter* emitterAsset, const f32 deltaSec) {
+  const f32 frictionMul = vfx_pow_approx(emitterAsset->friction, deltaSec);
+  const f32 expandDelta = emitterAsset->expandForce * deltaSec;
+#ifdef VOLO_SIMD
+  const SimdVec deltaVec    = simd_vec_broadcast(deltaSec);
+  const SimdVec forceXVec   = simd_vec_broadcast(emitterAsset->force.x * deltaSec);
+  const SimdVec forceYVec   = simd_vec_broadcast(emitterAsset->force.y * deltaSec);
+  const SimdVec forceZVec   = simd_vec_broadcast(emitterAsset->force.z * deltaSec);
+  const SimdVec frictionVec = simd_vec_broadcast(frictionMul);
+  const SimdVec expandVec   = simd_vec_broadcast(expandDelta);
+  for (u32 i = 0; i < p->count; i += 4) {
+    SimdVec veloX = simd_vec_add(simd_vec_load(p->veloX + i), forceXVec);
+    SimdVec veloY = simd_vec_add(simd_vec_load(p->veloY + i), forceYVec);
+    SimdVec veloZ = simd_vec_add(simd_vec_load(p->veloZ + i), forceZVec);
+    veloX         = simd_vec_mul(veloX, frictionVec);
+    veloY         = simd_vec_mul(veloY, frictionVec);
+    veloZ         = simd_vec_mul(veloZ, frictionVec);
+    simd_vec_store(veloX, p->veloX + i);
+    simd_vec_store(veloY, p->veloY + i);
+    simd_vec_store(veloZ, p->veloZ + i);
+
+    const SimdVec posX = simd_vec_add(simd_vec_load(p->posX + i), simd_vec_mul(veloX, deltaVec));
+    const SimdVec posY = simd_vec_add(simd_vec_load(p->posY + i), simd_vec_mul(veloY, deltaVec));
+    const SimdVec posZ = simd_vec_add(simd_vec_load(p->posZ + i), simd_vec_mul(veloZ, deltaVec));
+    simd_vec_store(posX, p->posX + i);
+    simd_vec_store(posY, p->posY + i);
+    simd_vec_store(posZ, p->posZ + i);
+
+    simd_vec_store(simd_vec_add(simd_vec_load(p->scale + i), expandVec), p->scale + i);
+    simd_vec_store(simd_vec_add(simd_vec_load(p->ageSec + i), deltaVec), p->ageSec + i);
+  }
+#else
+  const GeoVector force = geo_vector_mul(emitterAsset->force, deltaSec);
+  for (u32 i = 0; i != p->count; ++i) {
+    p->veloX[i] = (p->veloX[i] + force.x) * frictionMul;
+    p->veloY[i] = (p->veloY[i] + force.y) * frictionMul;
+    p->veloZ[i] = (p->veloZ[i] + force.z) * frictionMul;
+    p->posX[i] += p->veloX[i] * deltaSec;
+    p->posY[i] += p->veloY[i] * deltaSec;
+    p->posZ[i] += p->veloZ[i] * deltaSec;
+    p->scale[i] += expandDelta;
+    p->ageSec[i] += deltaSec;
+  }
+#endif
+}
+
+/**
+ * Destroy all particles that have exceeded their lifetime.
+ * NOTE: Iterates backwards so that the particles that are swapped into the removed slots have
+ * already been checked.
+ */
+static void vfx_particles_kill(VfxParticles* p) {
+#ifdef VOLO_SIMD
+  for (u32 block = bits_align_32(p->count, 4); block != 0;) {
+    block -= 4;
+    const SimdVec ageVec      = simd_vec_load(p->ageSec + block);
+    const SimdVec lifetimeVec = simd_vec_load(p->lifetimeSec + block);
+    u32           deadMask    = simd_vec_mask_u32(simd_vec_greater(ageVec, lifetimeVec));
+    if (p->count - block < 4) {
+      deadMask &= (1u << (p->count - block)) - 1; // Ignore the padding lanes.
+    }
+    while (deadMask) {
+      const u32 lane = 31 - bits_clz_32(deadMask);
+      vfx_particles_remove(p, block + lane);
+      deadMask &= ~(1u << lane);
+    }
+  }
+#else
+  for (u32 i = p->count; i-- != 0;) {
+    if (p->ageSec[i] > p->lifetimeSec[i]) {
+      vfx_particles_remove(p, i);
     }
   }
+#endif
 }
 
 static void vfx_system_simulate(
@@ -409,18 +665,18 @@ static void vfx_system_simulate(
     VfxSystemStateComp*       state,
     const AssetVfxComp*       asset,
     const AssetAtlasComp*     atlas,
-    const SceneTimeComp*      time,
+    const TimeDuration        delta,
     const SceneTags           sysTags,
     const SceneVfxSystemComp* sysCfg,
     const VfxTrans*           sysTrans,
     const EcsEntityId         sysEntity) {
   (void)sysEntity;
-  const f32 deltaSec = vfx_time_to_seconds(time->delta);
+  const f32 deltaSec = vfx_time_to_seconds(delta);
 
   // Update shared state.
-  state->age += time->delta;
+  state->age += delta;
   if (sysTags & SceneTags_Emit) {
-    state->emitAge += (TimeDuration)(time->delta * sysCfg->emitMultiplier);
+    state->emitAge += (TimeDuration)(delta * sysCfg->emitMultiplier);
   }
 
   // Update emitters.
@@ -434,61 +690,117 @@ static void vfx_system_simulate(
        * NOTE: Avoid spawning instances if they would be destroyed in this same frame, addresses the
        * issue of spawning a large amount of instances when there was a frame-time spike.
        */
-      if (time->delta < emitterAsset->lifetime.max) {
+      if (delta < emitterAsset->lifetime.max) {
         vfx_system_spawn(state, asset, atlas, emitter, sysCfg, sysTrans);
       }
     }
   }
 
-  if (UNLIKELY(state->instances.size > vfx_system_warn_inst_count)) {
+  u32 particleCount = 0;
+  for (u32 emitter = 0; emitter != asset_vfx_max_emitters; ++emitter) {
+    VfxParticles* particles = &state->emitters[emitter].particles;
+    if (UNLIKELY(emitter >= asset->emitters.count)) {
+      particles->count = 0; // Emitter was removed from the asset (can happen when hot-loading).
+    }
+    particleCount += particles->count;
+  }
+
+  if (UNLIKELY(particleCount > vfx_system_warn_inst_count)) {
     log_w(
         "Vfx system particle count very high",
-        log_param("count", fmt_int(state->instances.size)),
+        log_param("count", fmt_int(particleCount)),
         log_param("entity", ecs_entity_fmt(sysEntity)));
   }
 
-  // Update instances.
-  VfxSystemInstance* instances = dynarray_begin_t(&state->instances, VfxSystemInstance);
-  for (u32 i = (u32)state->instances.size; i-- != 0;) {
-    VfxSystemInstance*     inst         = instances + i;
-    const AssetVfxEmitter* emitterAsset = &asset->emitters.values[inst->emitter];
-
-    // Apply force.
-    inst->velo = geo_vector_add(inst->velo, geo_vector_mul(emitterAsset->force, deltaSec));
-
-    // Apply friction.
-    inst->velo = geo_vector_mul(inst->velo, vfx_pow_approx(emitterAsset->friction, deltaSec));
-
-    // Apply expanding.
-    inst->scale += emitterAsset->expandForce * deltaSec;
+  // Update particles.
+  const TimeSteady simStart = stats ? time_steady_clock() : 0;
+  for (u32 emitter = 0; emitter != asset->emitters.count; ++emitter) {
+    VfxParticles* particles = &state->emitters[emitter].particles;
+    vfx_particles_integrate(particles, &asset->emitters.values[emitter], deltaSec);
+    vfx_particles_kill(particles);
+  }
 
-    // Apply movement.
-    inst->pos = geo_vector_add(inst->pos, geo_vector_mul(inst->velo, deltaSec));
+  if (stats) {
+    const TimeDuration simDur = time_steady_duration(simStart, time_steady_clock());
+    vfx_stats_report_n(&stats->set, VfxStat_SimulateCount, (i32)particleCount);
+    vfx_stats_report_n(&stats->set, VfxStat_SimulateNs, (i32)simDur);
+  }
+}
 
-    if (stats) {
-      vfx_stats_report(&stats->set, VfxStat_ParticleCount);
+typedef struct {
+  GeoVector positions[vfx_system_max_cameras];
+  u32       count;
+} VfxCameraSet;
+
+static VfxCameraSet vfx_camera_set_query(EcsView* cameraView) {
+  VfxCameraSet res = {0};
+  for (EcsIterator* itr = ecs_view_itr(cameraView); ecs_view_walk(itr);) {
+    if (res.count == vfx_system_max_cameras) {
+      break;
     }
+    const SceneTransformComp* trans = ecs_view_read_t(itr, SceneTransformComp);
+    res.positions[res.count++]      = trans ? trans->position : geo_vector(0);
+  }
+  return res;
+}
 
-    // Update age and destruct if too old.
-    if ((inst->ageSec += deltaSec) > inst->lifetimeSec) {
-      goto Destruct;
-    }
-    continue;
+/**
+ * Time between simulation ticks for the given lod.
+ * NOTE: Limited by the shortest particle lifetime to avoid particles never being spawned.
+ */
+static TimeDuration vfx_system_lod_interval(const AssetVfxComp* asset, const VfxSystemLod lod) {
+  TimeDuration res = g_vfxSystemLodInterval[lod];
+  for (u32 emitter = 0; emitter != asset->emitters.count; ++emitter) {
+    res = math_min(res, asset->emitters.values[emitter].lifetime.min / 2);
+  }
+  return res;
+}
 
-  Destruct:
-    dynarray_remove_unordered(&state->instances, i, 1);
+static VfxSystemLod vfx_system_lod(
+    const SceneVisibilityEnvComp* visEnv,
+    const SceneVisibilityComp*    sysVis,
+    const VfxCameraSet*           cameras,
+    const GeoVector               sysPos) {
+  if (sysVis && !scene_visible_for_render(visEnv, sysVis)) {
+    return VfxSystemLod_Paused;
+  }
+  if (!cameras->count) {
+    return VfxSystemLod_Full; // No camera to base the lod on.
   }
+  f32 distSqr = f32_max;
+  for (u32 i = 0; i != cameras->count; ++i) {
+    distSqr = math_min(distSqr, geo_vector_mag_sqr(geo_vector_sub(sysPos, cameras->positions[i])));
+  }
+  static const f32 g_distReducedSqr = vfx_system_lod_dist_reduced * vfx_system_lod_dist_reduced;
+  static const f32 g_distFarSqr     = vfx_system_lod_dist_far * vfx_system_lod_dist_far;
+  if (distSqr < g_distReducedSqr) {
+    return VfxSystemLod_Full;
+  }
+  return distSqr < g_distFarSqr ? VfxSystemLod_Reduced : VfxSystemLod_Far;
+}
+
+static u32 vfx_system_particle_count(const VfxSystemStateComp* state) {
+  u32 res = 0;
+  array_for_t(state->emitters, VfxEmitterState, emitter) { res += emitter->particles.count; }
+  return res;
 }
 
 ecs_view_define(SimulateGlobalView) {
   ecs_access_read(SceneTimeComp);
+  ecs_access_read(SceneVisibilityEnvComp);
   ecs_access_read(VfxAtlasManagerComp);
 }
 
+ecs_view_define(CameraView) {
+  ecs_access_with(SceneCameraComp);
+  ecs_access_maybe_read(SceneTransformComp);
+}
+
 ecs_view_define(SimulateView) {
   ecs_access_maybe_read(SceneScaleComp);
   ecs_access_maybe_read(SceneTagComp);
   ecs_access_maybe_read(SceneTransformComp);
+  ecs_access_maybe_read(SceneVisibilityComp);
   ecs_access_maybe_write(VfxSystemStatsComp);
   ecs_access_read(SceneVfxSystemComp);
   ecs_access_write(VfxSystemStateComp);
@@ -500,8 +812,9 @@ ecs_system_define(VfxSystemSimulateSys) {
   if (!globalItr) {
     return;
   }
-  const SceneTimeComp*       time         = ecs_view_read_t(globalItr, SceneTimeComp);
-  const VfxAtlasManagerComp* atlasManager = ecs_view_read_t(globalItr, VfxAtlasManagerComp);
+  const SceneTimeComp*          time         = ecs_view_read_t(globalItr, SceneTimeComp);
+  const SceneVisibilityEnvComp* visEnv       = ecs_view_read_t(globalItr, SceneVisibilityEnvComp);
+  const VfxAtlasManagerComp*    atlasManager = ecs_view_read_t(globalItr, VfxAtlasManagerComp);
 
   const AssetAtlasComp* spriteAtlas = vfx_atlas_sprite(world, atlasManager);
   if (!spriteAtlas) {
@@ -511,17 +824,20 @@ ecs_system_define(VfxSystemSimulateSys) {
   EcsIterator* assetItr         = ecs_view_itr(ecs_world_view_t(world, AssetView));
   u32          numAssetRequests = 0;
 
+  const VfxCameraSet cameras = vfx_camera_set_query(ecs_world_view_t(world, CameraView));
+
   EcsView* simView = ecs_world_view_t(world, SimulateView);
   for (EcsIterator* itr = ecs_view_itr_step(simView, parCount, parIndex); ecs_view_walk(itr);) {
-    const EcsEntityId         e       = ecs_view_entity(itr);
-    const SceneScaleComp*     scale   = ecs_view_read_t(itr, SceneScaleComp);
-    const SceneTransformComp* trans   = ecs_view_read_t(itr, SceneTransformComp);
-    const SceneVfxSystemComp* sysCfg  = ecs_view_read_t(itr, SceneVfxSystemComp);
-    const SceneTagComp*       tagComp = ecs_view_read_t(itr, SceneTagComp);
-    VfxSystemStateComp*       state   = ecs_view_write_t(itr, VfxSystemStateComp);
-    VfxSystemStatsComp*       stats   = ecs_view_write_t(itr, VfxSystemStatsComp);
+    const EcsEntityId          e       = ecs_view_entity(itr);
+    const SceneScaleComp*      scale   = ecs_view_read_t(itr, SceneScaleComp);
+    const SceneTransformComp*  trans   = ecs_view_read_t(itr, SceneTransformComp);
+    const SceneVfxSystemComp*  sysCfg  = ecs_view_read_t(itr, SceneVfxSystemComp);
+    const SceneTagComp*        tagComp = ecs_view_read_t(itr, SceneTagComp);
+    const SceneVisibilityComp* sysVis  = ecs_view_read_t(itr, SceneVisibilityComp);
+    VfxSystemStateComp*        state   = ecs_view_write_t(itr, VfxSystemStateComp);
+    VfxSystemStatsComp*        stats   = ecs_view_write_t(itr, VfxSystemStatsComp);
 
-    const SceneTags sysTags = tagComp ? tagComp->tags : SceneTags_Default;
+    SceneTags sysTags = tagComp ? tagComp->tags : SceneTags_Default;
 
     diag_assert_msg(ecs_entity_valid(sysCfg->asset), "Vfx system is missing an asset");
     if (!ecs_view_maybe_jump(assetItr, sysCfg->asset)) {
@@ -551,7 +867,24 @@ ecs_system_define(VfxSystemSimulateSys) {
     }
 
     const VfxTrans sysTrans = vfx_trans_init(trans, scale, asset);
-    vfx_system_simulate(stats, state, asset, spriteAtlas, time, sysTags, sysCfg, &sysTrans, e);
+
+    state->lod = vfx_system_lod(visEnv, sysVis, &cameras, sysTrans.pos);
+    state->lodDelta += time->delta;
+    if (stats) {
+      vfx_stats_report(&stats->set, VfxStat_LodFull + state->lod);
+    }
+    if (state->lodDelta >= vfx_system_lod_interval(asset, state->lod)) {
+      if (state->lod == VfxSystemLod_Paused) {
+        sysTags &= ~SceneTags_Emit; // Pause emission while not visible.
+      }
+      const TimeDuration delta = state->lodDelta;
+      state->lodDelta          = 0;
+      vfx_system_simulate(stats, state, asset, spriteAtlas, delta, sysTags, sysCfg, &sysTrans, e);
+    }
+    if (stats) {
+      const u32 particleCount = vfx_system_particle_count(state);
+      vfx_stats_report_n(&stats->set, VfxStat_ParticleCount, (i32)particleCount);
+    }
   }
 }
 
@@ -745,18 +1078,23 @@ ecs_system_define(VfxSystemRenderSys) {
     const f32       sysTimeRemSec = lifetime ? vfx_time_to_seconds(lifetime->duration) : f32_max;
     const SceneTags sysTags       = tagComp ? tagComp->tags : SceneTags_Default;
 
-    dynarray_for_t(&state->instances, VfxSystemInstance, inst) {
-      vfx_instance_output_sprite(
-          stats,
-          inst,
-          rendObjects,
-          asset,
-          sysTags,
-          sysCfg,
-          &sysTrans,
-          sysTimeRemSec,
-          lightRadiance);
-      vfx_instance_output_light(stats, e, inst, light, asset, sysCfg, &sysTrans, sysTimeRemSec);
+    for (u32 emitter = 0; emitter != asset->emitters.count; ++emitter) {
+      const VfxParticles* particles = &state->emitters[emitter].particles;
+      for (u32 i = 0; i != particles->count; ++i) {
+        const VfxSystemInstance inst = vfx_particles_get(particles, (u8)emitter, i);
+        vfx_instance_output_sprite(
+            stats,
+            &inst,
+            rendObjects,
+            asset,
+            sysTags,
+            sysCfg,
+            &sysTrans,
+            sysTimeRemSec,
+            lightRadiance);
+        vfx_instance_output_light(
+            stats, e, &inst, light, asset, sysCfg, &sysTrans, sysTimeRemSec);
+      }
     }
   }
 }
@@ -780,6 +1118,7 @@ ecs_module_init(vfx_system_module) {
       VfxSystemSimulateSys,
       ecs_register_view(SimulateGlobalView),
       ecs_register_view(SimulateView),
+      ecs_register_view(CameraView),
       ecs_view_id(AssetView),
       ecs_view_id(AtlasView));
 
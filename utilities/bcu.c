@@ -26,6 +26,8 @@ typedef enum {
   BcuMode_QuantizeBc1,
   BcuMode_QuantizeBc3,
   BcuMode_QuantizeBc4,
+  BcuMode_QuantizeBc5,
+  BcuMode_QuantizeBc7,
 
   BcuMode_Count,
   BcuMode_Default = BcuMode_QuantizeBc1
@@ -35,6 +37,8 @@ static const String g_modeStrs[] = {
     string_static("quantize-bc1"),
     string_static("quantize-bc3"),
     string_static("quantize-bc4"),
+    string_static("quantize-bc5"),
+    string_static("quantize-bc7"),
 };
 ASSERT(array_elems(g_modeStrs) == BcuMode_Count, "Incorrect number of mode strings");
 
@@ -315,6 +319,11 @@ static void bcu_blocks_scanout(const BcuSize size, const Bc0Block* inPtr, BcColo
       log_param("duration", fmt_duration(dur)));
 }
 
+static f64 bcu_mega_pixels_per_sec(const u32 blockCount, const TimeDuration dur) {
+  const f64 megaPixels = blockCount * 16 / 1e6;
+  return dur ? megaPixels / (dur / (f64)time_second) : 0.0;
+}
+
 static void bcu_blocks_quantize_bc1(Bc0Block* blocks, const u32 blockCount) {
   const TimeSteady startTime = time_steady_clock();
 
@@ -328,7 +337,8 @@ static void bcu_blocks_quantize_bc1(Bc0Block* blocks, const u32 blockCount) {
   log_i(
       "Quantized to bc1",
       log_param("bc1-size", fmt_size(blockCount * sizeof(Bc1Block))),
-      log_param("duration", fmt_duration(dur)));
+      log_param("duration", fmt_duration(dur)),
+      log_param("mp-per-sec", fmt_float(bcu_mega_pixels_per_sec(blockCount, dur))));
 }
 
 static void bcu_blocks_quantize_bc3(Bc0Block* blocks, const u32 blockCount) {
@@ -344,7 +354,8 @@ static void bcu_blocks_quantize_bc3(Bc0Block* blocks, const u32 blockCount) {
   log_i(
       "Quantized to bc3",
       log_param("bc3-size", fmt_size(blockCount * sizeof(Bc3Block))),
-      log_param("duration", fmt_duration(dur)));
+      log_param("duration", fmt_duration(dur)),
+      log_param("mp-per-sec", fmt_float(bcu_mega_pixels_per_sec(blockCount, dur))));
 }
 
 static void bcu_blocks_quantize_bc4(Bc0Block* blocks, const u32 blockCount) {
@@ -359,8 +370,43 @@ static void bcu_blocks_quantize_bc4(Bc0Block* blocks, const u32 blockCount) {
   const TimeDuration dur = time_steady_duration(startTime, time_steady_clock());
   log_i(
       "Quantized to bc4",
-      log_param("bc4-size", fmt_size(blockCount * sizeof(Bc3Block))),
-      log_param("duration", fmt_duration(dur)));
+      log_param("bc4-size", fmt_size(blockCount * sizeof(Bc4Block))),
+      log_param("duration", fmt_duration(dur)),
+      log_param("mp-per-sec", fmt_float(bcu_mega_pixels_per_sec(blockCount, dur))));
+}
+
+static void bcu_blocks_quantize_bc5(Bc0Block* blocks, const u32 blockCount) {
+  const TimeSteady startTime = time_steady_clock();
+
+  Bc5Block encodedBlock;
+  for (u32 i = 0; i != blockCount; ++i) {
+    bc5_encode(blocks + i, &encodedBlock);
+    bc5_decode(&encodedBlock, blocks + i);
+  }
+
+  const TimeDuration dur = time_steady_duration(startTime, time_steady_clock());
+  log_i(
+      "Quantized to bc5",
+      log_param("bc5-size", fmt_size(blockCount * sizeof(Bc5Block))),
+      log_param("duration", fmt_duration(dur)),
+      log_param("mp-per-sec", fmt_float(bcu_mega_pixels_per_sec(blockCount, dur))));
+}
+
+static void bcu_blocks_quantize_bc7(Bc0Block* blocks, const u32 blockCount) {
+  const TimeSteady startTime = time_steady_clock();
+
+  Bc7Block encodedBlock;
+  for (u32 i = 0; i != blockCount; ++i) {
+    bc7_encode(blocks + i, &encodedBlock);
+    bc7_decode(&encodedBlock, blocks + i);
+  }
+
+  const TimeDuration dur = time_steady_duration(startTime, time_steady_clock());
+  log_i(
+      "Quantized to bc7",
+      log_param("bc7-size", fmt_size(blockCount * sizeof(Bc7Block))),
+      log_param("duration", fmt_duration(dur)),
+      log_param("mp-per-sec", fmt_float(bcu_mega_pixels_per_sec(blockCount, dur))));
 }
 
 static BcuResult bcu_run(const BcuMode mode, const BcuImage* input, const String outputPath) {
@@ -382,6 +428,12 @@ static BcuResult bcu_run(const BcuMode mode, const BcuImage* input, const String
   case BcuMode_QuantizeBc4:
     bcu_blocks_quantize_bc4(blocks, blockCount);
     break;
+  case BcuMode_QuantizeBc5:
+    bcu_blocks_quantize_bc5(blocks, blockCount);
+    break;
+  case BcuMode_QuantizeBc7:
+    bcu_blocks_quantize_bc7(blocks, blockCount);
+    break;
   default:
     diag_crash_msg("Unsupported mode");
     break;
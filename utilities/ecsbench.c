@@ -0,0 +1,127 @@
+#include "app/cli.h"
+#include "cli/app.h"
+#include "cli/parse.h"
+#include "cli/read.h"
+#include "core/alloc.h"
+#include "core/array.h"
+#include "core/file.h"
+#include "core/format.h"
+#include "core/math.h"
+#include "core/rng.h"
+#include "core/time.h"
+#include "ecs/def.h"
+#include "ecs/module.h"
+#include "ecs/world.h"
+#include "log/logger.h"
+#include "log/sink_pretty.h"
+#include "trace/init.h"
+
+/**
+ * EcsBenchmark - Utility to measure the throughput of buffered entity modifications.
+ *
+ * Adds a component to every entity (buffered until the next flush) and reports the amount of
+ * buffered adds per second, followed by the duration of the flush that applies them:
+ * - 'in-order': Entities are modified in creation order.
+ * - 'shuffled': Entities are modified in a random order.
+ */
+
+ecs_comp_define(EcsBenchCompA) { u32 value; };
+ecs_comp_define(EcsBenchCompB) { f32 values[4]; };
+
+ecs_module_init(ecs_bench_module) {
+  ecs_register_comp(EcsBenchCompA);
+  ecs_register_comp(EcsBenchCompB);
+}
+
+typedef struct {
+  String name;
+  bool   shuffle;
+} EcsBenchCase;
+
+static const EcsBenchCase g_cases[] = {
+    {.name = string_static("in-order"), .shuffle = false},
+    {.name = string_static("shuffled"), .shuffle = true},
+};
+
+static const u32 g_counts[] = {1000, 10000, 100000};
+
+static void ecsbench_shuffle(EcsEntityId* entities, const u32 count) {
+  Rng* rng = rng_create_xorwow(g_allocHeap, 42);
+  for (u32 i = count - 1; i > 0; --i) {
+    const u32         j   = rng_sample_u32(rng) % (i + 1);
+    const EcsEntityId tmp = entities[i];
+    entities[i]           = entities[j];
+    entities[j]           = tmp;
+  }
+  rng_destroy(rng);
+}
+
+static void ecsbench_run(const EcsDef* def, const u32 count, const u32 iterations) {
+  EcsEntityId* entities = alloc_array_t(g_allocHeap, EcsEntityId, count);
+
+  array_for_t(g_cases, EcsBenchCase, c) {
+    TimeDuration addDur = 0, flushDur = 0;
+    for (u32 itr = 0; itr != iterations; ++itr) {
+      EcsWorld* world = ecs_world_create(g_allocHeap, def);
+      for (u32 i = 0; i != count; ++i) {
+        entities[i] = ecs_world_entity_create(world);
+      }
+      ecs_world_flush(world);
+      if (c->shuffle) {
+        ecsbench_shuffle(entities, count);
+      }
+
+      const TimeSteady addStart = time_steady_clock();
+      for (u32 i = 0; i != count; ++i) {
+        ecs_world_add_t(world, entities[i], EcsBenchCompA, .value = i);
+        ecs_world_add_t(world, entities[i], EcsBenchCompB, .values = {(f32)i});
+      }
+      const TimeSteady flushStart = time_steady_clock();
+      ecs_world_flush(world);
+      const TimeSteady flushEnd = time_steady_clock();
+
+      addDur   += time_steady_duration(addStart, flushStart);
+      flushDur += time_steady_duration(flushStart, flushEnd);
+      ecs_world_destroy(world);
+    }
+
+    const f64 adds = (f64)count * 2 * iterations;
+    log_i(
+        "Ecs buffer benchmark",
+        log_param("case", fmt_text(c->name)),
+        log_param("entities", fmt_int(count)),
+        log_param("add-duration", fmt_duration(addDur / iterations)),
+        log_param("flush-duration", fmt_duration(flushDur / iterations)),
+        log_param("madds-per-sec", fmt_float(adds / (addDur / (f64)time_second) / 1e6)));
+  }
+
+  alloc_free_array_t(g_allocHeap, entities, count);
+}
+
+static CliId g_optIterations;
+
+AppType app_cli_configure(CliApp* app) {
+  cli_app_register_desc(app, string_lit("Ecs buffered modification benchmark utility."));
+
+  g_optIterations = cli_register_flag(app, 'i', string_lit("iterations"), CliOptionFlags_Value);
+  cli_register_desc(app, g_optIterations, string_lit("Iterations per entity count (default: 10)."));
+
+  return AppType_Console;
+}
+
+i32 app_cli_run(MAYBE_UNUSED const CliApp* app, const CliInvocation* invoc) {
+  log_add_sink(g_logger, log_sink_pretty_default(g_allocHeap, g_fileStdOut, ~LogMask_Debug));
+
+  const u32 iterations = math_max((u32)cli_read_u64(invoc, g_optIterations, 10), 1);
+
+  trace_init();
+
+  EcsDef* def = ecs_def_create(g_allocHeap);
+  ecs_register_module(def, ecs_bench_module);
+
+  array_for_t(g_counts, u32, count) { ecsbench_run(def, *count, iterations); }
+
+  ecs_def_destroy(def);
+  trace_teardown();
+  return 0;
+}
@@ -0,0 +1,128 @@
+#include "app/cli.h"
+#include "cli/app.h"
+#include "cli/parse.h"
+#include "cli/read.h"
+#include "core/alloc.h"
+#include "core/array.h"
+#include "core/bits.h"
+#include "core/file.h"
+#include "core/format.h"
+#include "core/math.h"
+#include "core/time.h"
+#include "log/logger.h"
+#include "log/sink_pretty.h"
+
+/**
+ * HashBenchmark - Utility to measure the throughput of the checksum and hash routines.
+ *
+ * Reports the throughput in GiB per second for various input sizes. The byte-at-a-time reference
+ * implementations are included to compare against.
+ */
+
+typedef u32 (*HashBenchFunc)(Mem);
+
+static u32 g_crcTableRef[256];
+
+static void hashbench_crc_ref_init(void) {
+  for (u32 i = 0; i != array_elems(g_crcTableRef); ++i) {
+    u32 res = i;
+    for (u32 k = 0; k != 8; ++k) {
+      res = (res >> 1) ^ (0xEDB88320 & (0u - (res & 1)));
+    }
+    g_crcTableRef[i] = res;
+  }
+}
+
+static u32 hashbench_crc_32(const Mem mem) { return bits_crc_32(0, mem); }
+
+static u32 hashbench_crc_32_ref(const Mem mem) {
+  u32 res = 0xffffffff;
+  mem_for_u8(mem, byte) { res = g_crcTableRef[(res ^ *byte) & 0xff] ^ (res >> 8); }
+  return res ^ 0xffffffff;
+}
+
+static u32 hashbench_hash_32(const Mem mem) { return bits_hash_32(mem); }
+
+static u32 hashbench_hash_32_ref(const Mem mem) {
+  u32 hash = 2166136261U; // FNV-1a.
+  mem_for_u8(mem, itr) {
+    hash ^= *itr;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+typedef struct {
+  String        name;
+  HashBenchFunc func;
+} HashBenchCase;
+
+static const HashBenchCase g_cases[] = {
+    {.name = string_static("crc32"), .func = hashbench_crc_32},
+    {.name = string_static("crc32-bytewise"), .func = hashbench_crc_32_ref},
+    {.name = string_static("hash32"), .func = hashbench_hash_32},
+    {.name = string_static("hash32-fnv1a"), .func = hashbench_hash_32_ref},
+};
+
+static const usize g_sizes[] = {16, 64, 1024, 64 * usize_kibibyte, 4 * usize_mebibyte};
+
+static void hashbench_run(const usize totalSize) {
+  const usize maxSize = g_sizes[array_elems(g_sizes) - 1];
+  const Mem   data    = alloc_alloc(g_allocHeap, maxSize, 64);
+  for (usize i = 0; i != maxSize; ++i) {
+    *mem_at_u8(data, i) = (u8)bits_hash_32_val((u32)i);
+  }
+
+  array_for_t(g_cases, HashBenchCase, c) {
+    for (u32 i = 0; i != array_elems(g_sizes); ++i) {
+      const usize size       = g_sizes[i];
+      const usize iterations = math_max(totalSize / size, 1);
+      const Mem   input      = mem_slice(data, 0, size);
+
+      u32              checksum  = 0; // Prevents the calls from being optimized out.
+      const TimeSteady startTime = time_steady_clock();
+      for (usize itr = 0; itr != iterations; ++itr) {
+        checksum ^= c->func(input);
+      }
+      const TimeDuration dur = time_steady_duration(startTime, time_steady_clock());
+
+      const f64 bytes = (f64)size * (f64)iterations;
+      const f64 gibPs = bytes / (dur / (f64)time_second) / (f64)usize_gibibyte;
+      log_i(
+          "Hash benchmark",
+          log_param("case", fmt_text(c->name)),
+          log_param("size", fmt_size(size)),
+          log_param("duration", fmt_duration(dur)),
+          log_param("gib-per-sec", fmt_float(gibPs, .maxDecDigits = 2)),
+          log_param("checksum", fmt_int(checksum, .base = 16, .minDigits = 8)));
+    }
+  }
+
+  alloc_free(g_allocHeap, data);
+}
+
+static CliId g_optSize;
+
+AppType app_cli_configure(CliApp* app) {
+  cli_app_register_desc(app, string_lit("Checksum and hash throughput benchmark utility."));
+
+  g_optSize = cli_register_flag(app, 's', string_lit("size"), CliOptionFlags_Value);
+  cli_register_desc(
+      app, g_optSize, string_lit("Amount of mebibytes to process per case (default: 256)."));
+
+  return AppType_Console;
+}
+
+i32 app_cli_run(MAYBE_UNUSED const CliApp* app, const CliInvocation* invoc) {
+  log_add_sink(g_logger, log_sink_pretty_default(g_allocHeap, g_fileStdOut, ~LogMask_Debug));
+
+  const u64 sizeMib = cli_read_u64(invoc, g_optSize, 256);
+  if (!sizeMib) {
+    log_e("Invalid size");
+    return 1;
+  }
+
+  hashbench_crc_ref_init();
+  hashbench_run((usize)sizeMib * usize_mebibyte);
+  return 0;
+}
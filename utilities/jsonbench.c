@@ -0,0 +1,143 @@
+#include "app/cli.h"
+#include "cli/app.h"
+#include "cli/parse.h"
+#include "cli/read.h"
+#include "cli/validate.h"
+#include "core/alloc.h"
+#include "core/array.h"
+#include "core/file.h"
+#include "core/format.h"
+#include "core/math.h"
+#include "core/path.h"
+#include "core/time.h"
+#include "json/doc.h"
+#include "json/read.h"
+#include "log/logger.h"
+#include "log/sink_pretty.h"
+
+/**
+ * JsonBenchmark - Utility to measure the json parsing throughput.
+ *
+ * Parses the given files repeatedly and reports the throughput in mebibytes per second:
+ * - 'doc':    Build a JsonDoc (json_read).
+ * - 'events': Read all events using the streaming reader (json_reader_next).
+ * - 'skip':   Skip the whole value using the structural index of the streaming reader.
+ */
+
+typedef enum {
+  JsonBenchKind_Doc,
+  JsonBenchKind_Events,
+  JsonBenchKind_Skip,
+} JsonBenchKind;
+
+typedef struct {
+  String        name;
+  JsonBenchKind kind;
+} JsonBenchCase;
+
+static const JsonBenchCase g_cases[] = {
+    {.name = string_static("doc"), .kind = JsonBenchKind_Doc},
+    {.name = string_static("events"), .kind = JsonBenchKind_Events},
+    {.name = string_static("skip"), .kind = JsonBenchKind_Skip},
+};
+
+/**
+ * Parse the input once, returns the amount of values (or events) as a checksum.
+ */
+static u64 jsonbench_parse(const JsonBenchKind kind, JsonDoc* doc, const String input) {
+  switch (kind) {
+  case JsonBenchKind_Doc: {
+    json_clear(doc);
+    JsonResult res;
+    json_read(doc, input, JsonReadFlags_HashOnlyFieldNames, &res);
+    return res.type == JsonResultType_Success ? res.val : 0;
+  }
+  case JsonBenchKind_Events: {
+    JsonReader reader = json_reader_create(input);
+    JsonEvent  event;
+    u64        count = 0;
+    do {
+      json_reader_next(&reader, &event);
+      ++count;
+    } while (event.type != JsonEventType_End && event.type != JsonEventType_Error);
+    return count;
+  }
+  case JsonBenchKind_Skip: {
+    JsonReader reader = json_reader_create(input);
+    JsonEvent  event;
+    json_reader_skip(&reader, &event);
+    return json_reader_remaining(&reader).size;
+  }
+  }
+  UNREACHABLE
+}
+
+static i32 jsonbench_run(const String path, const u32 iterations) {
+  File*      file = null;
+  FileResult fileRes;
+  String     input;
+  if ((fileRes = file_create(g_allocHeap, path, FileMode_Open, FileAccess_Read, &file)) ||
+      (fileRes = file_map(file, 0, 0, FileHints_Prefetch, &input))) {
+    log_e(
+        "Failed to read input file",
+        log_param("path", fmt_path(path)),
+        log_param("error", fmt_text(file_result_str(fileRes))));
+    if (file) {
+      file_destroy(file);
+    }
+    return 1;
+  }
+
+  JsonDoc* doc = json_create(g_allocHeap, 4096);
+  array_for_t(g_cases, JsonBenchCase, c) {
+    u64              checksum  = 0; // Prevents the parsing from being optimized out.
+    const TimeSteady startTime = time_steady_clock();
+    for (u32 i = 0; i != iterations; ++i) {
+      checksum += jsonbench_parse(c->kind, doc, input);
+    }
+    const TimeDuration dur = time_steady_duration(startTime, time_steady_clock());
+
+    const f64 bytes = (f64)input.size * (f64)iterations;
+    const f64 mibPs = bytes / (dur / (f64)time_second) / (f64)usize_mebibyte;
+    log_i(
+        "Json benchmark",
+        log_param("file", fmt_text(path_filename(path))),
+        log_param("case", fmt_text(c->name)),
+        log_param("size", fmt_size(input.size)),
+        log_param("duration", fmt_duration(dur)),
+        log_param("mib-per-sec", fmt_float(mibPs, .maxDecDigits = 1)),
+        log_param("checksum", fmt_int(checksum)));
+  }
+  json_destroy(doc);
+  file_destroy(file);
+  return 0;
+}
+
+static CliId g_optFiles, g_optIterations;
+
+AppType app_cli_configure(CliApp* app) {
+  cli_app_register_desc(app, string_lit("Json parsing throughput benchmark utility."));
+
+  g_optFiles = cli_register_arg(app, string_lit("files"), CliOptionFlags_RequiredMultiValue);
+  cli_register_desc(app, g_optFiles, string_lit("Json files to parse."));
+  cli_register_validator(app, g_optFiles, cli_validate_file_regular);
+
+  g_optIterations = cli_register_flag(app, 'n', string_lit("iterations"), CliOptionFlags_Value);
+  cli_register_desc(app, g_optIterations, string_lit("Parses per file per case (default: 100)."));
+
+  return AppType_Console;
+}
+
+i32 app_cli_run(MAYBE_UNUSED const CliApp* app, const CliInvocation* invoc) {
+  log_add_sink(g_logger, log_sink_pretty_default(g_allocHeap, g_fileStdOut, ~LogMask_Debug));
+
+  const u64            iterations = cli_read_u64(invoc, g_optIterations, 100);
+  const CliParseValues files      = cli_parse_values(invoc, g_optFiles);
+  for (usize i = 0; i != files.count; ++i) {
+    const i32 res = jsonbench_run(files.values[i], (u32)math_max(iterations, 1));
+    if (res) {
+      return res;
+    }
+  }
+  return 0;
+}
@@ -414,7 +414,7 @@ static void repl_exec(
     goto Ret;
   }
   if (flags & ReplFlags_Compile) {
-    const ScriptProgResult progRes = script_prog_eval(&prog, mem, binder, null);
+    const ScriptProgResult progRes = script_prog_eval(&prog, mem, null, binder, null);
     if (progRes.panic.kind) {
       repl_output_panic(flags, &progRes.panic, id);
     } else {
@@ -0,0 +1,246 @@
+#include "app/cli.h"
+#include "cli/app.h"
+#include "cli/parse.h"
+#include "cli/read.h"
+#include "cli/validate.h"
+#include "core/alloc.h"
+#include "core/file.h"
+#include "core/format.h"
+#include "core/math.h"
+#include "core/path.h"
+#include "core/stringtable.h"
+#include "core/time.h"
+#include "log/logger.h"
+#include "log/sink_pretty.h"
+#include "script/binder.h"
+#include "script/compile.h"
+#include "script/diag.h"
+#include "script/doc.h"
+#include "script/mem.h"
+#include "script/optimize.h"
+#include "script/pos.h"
+#include "script/prog.h"
+#include "script/read.h"
+#include "script/sig.h"
+#include "script/val.h"
+
+/**
+ * ScriptBenchmark - Utility to measure the script compiler and virtual machine throughput.
+ *
+ * Compiles the given script files using the given binder schema and evaluates the programs
+ * repeatedly, reports the compilation duration and the executed operations per second.
+ *
+ * NOTE: Bound functions are replaced by stubs that return a constant value of the first non-null
+ * type in their return signature, this keeps the scripts running without an actual scene.
+ */
+
+static ScriptVal scriptbench_stub_null(void* ctx, ScriptBinderCall* call) {
+  (void)ctx;
+  (void)call;
+  return script_null();
+}
+
+static ScriptVal scriptbench_stub_num(void* ctx, ScriptBinderCall* call) {
+  (void)ctx;
+  (void)call;
+  return script_num(1.0);
+}
+
+static ScriptVal scriptbench_stub_bool(void* ctx, ScriptBinderCall* call) {
+  (void)ctx;
+  (void)call;
+  return script_bool(true);
+}
+
+static ScriptVal scriptbench_stub_vec3(void* ctx, ScriptBinderCall* call) {
+  (void)ctx;
+  (void)call;
+  return script_vec3_lit(1, 0, 1);
+}
+
+static ScriptVal scriptbench_stub_entity(void* ctx, ScriptBinderCall* call) {
+  (void)ctx;
+  (void)call;
+  return script_entity(u64_lit(1) << 32 /* Fake entity with serial 1. */);
+}
+
+static ScriptVal scriptbench_stub_str(void* ctx, ScriptBinderCall* call) {
+  (void)ctx;
+  (void)call;
+  return script_str(string_hash_lit("Bench"));
+}
+
+static ScriptBinderFunc scriptbench_stub(const ScriptMask retMask) {
+  if (retMask & script_mask_num) {
+    return scriptbench_stub_num;
+  }
+  if (retMask & script_mask_bool) {
+    return scriptbench_stub_bool;
+  }
+  if (retMask & script_mask_vec3) {
+    return scriptbench_stub_vec3;
+  }
+  if (retMask & script_mask_entity) {
+    return scriptbench_stub_entity;
+  }
+  if (retMask & script_mask_str) {
+    return scriptbench_stub_str;
+  }
+  return scriptbench_stub_null;
+}
+
+/**
+ * Create a binder with the same declarations as the given schema but with stub functions.
+ */
+static ScriptBinder* scriptbench_binder_create(const ScriptBinder* schema) {
+  const String     name = script_binder_name(schema);
+  ScriptBinder*    res  = script_binder_create(g_allocHeap, name, script_binder_flags(schema));
+  ScriptBinderSlot slot = script_binder_first(schema);
+  for (; !sentinel_check(slot); slot = script_binder_next(schema, slot)) {
+    const ScriptSig* sig  = script_binder_slot_sig(schema, slot);
+    const String     doc  = script_binder_slot_doc(schema, slot);
+    const ScriptMask ret  = sig ? script_sig_ret(sig) : script_mask_null;
+    const String     func = script_binder_slot_name(schema, slot);
+    script_binder_declare(res, func, doc, sig, scriptbench_stub(ret));
+  }
+  script_binder_finalize(res);
+  return res;
+}
+
+static ScriptBinder* scriptbench_binder_read(const String path) {
+  File*         file = null;
+  ScriptBinder* res  = null;
+  String        data;
+  if (file_create(g_allocHeap, path, FileMode_Open, FileAccess_Read, &file) ||
+      file_map(file, 0, 0, FileHints_Prefetch, &data)) {
+    log_e("Failed to read binder file", log_param("path", fmt_path(path)));
+    goto Ret;
+  }
+  ScriptBinder* schema = script_binder_read(g_allocHeap, data);
+  if (!schema) {
+    log_e("Invalid binder file", log_param("path", fmt_path(path)));
+    goto Ret;
+  }
+  res = scriptbench_binder_create(schema);
+  script_binder_destroy(schema);
+Ret:
+  if (file) {
+    file_destroy(file);
+  }
+  return res;
+}
+
+static i32 scriptbench_run(const ScriptBinder* binder, const String path, const u32 iterations) {
+  File*      file = null;
+  FileResult fileRes;
+  String     input;
+  if ((fileRes = file_create(g_allocHeap, path, FileMode_Open, FileAccess_Read, &file)) ||
+      (fileRes = file_map(file, 0, 0, FileHints_Prefetch, &input))) {
+    log_e(
+        "Failed to read input file",
+        log_param("path", fmt_path(path)),
+        log_param("error", fmt_text(file_result_str(fileRes))));
+    if (file) {
+      file_destroy(file);
+    }
+    return 1;
+  }
+
+  i32            res    = 0;
+  ScriptProgram  prog   = {0};
+  ScriptDoc*     doc    = script_create(g_allocHeap);
+  ScriptDiagBag* diags  = script_diag_bag_create(g_allocHeap, ScriptDiagFilter_Error);
+  ScriptLookup*  lookup = script_lookup_create(g_allocHeap);
+  ScriptMem      mem    = script_mem_create();
+  script_lookup_update(lookup, input);
+
+  const TimeSteady compileStart = time_steady_clock();
+
+  ScriptExpr expr = script_read(doc, binder, input, g_stringtable, diags, null);
+  if (sentinel_check(expr) || script_diag_count(diags, ScriptDiagFilter_Error)) {
+    log_e("Failed to read script", log_param("path", fmt_path(path)));
+    res = 1;
+    goto Ret;
+  }
+  expr = script_optimize(doc, expr);
+
+  const ScriptCompileError compileErr = script_compile(doc, lookup, expr, g_allocHeap, &prog);
+  if (compileErr) {
+    log_e(
+        "Failed to compile script",
+        log_param("path", fmt_path(path)),
+        log_param("error", fmt_text(script_compile_error_str(compileErr))));
+    res = 1;
+    goto Ret;
+  }
+  const TimeDuration compileDur = time_steady_duration(compileStart, time_steady_clock());
+
+  u64               executedOps = 0;
+  u32               panics      = 0;
+  ScriptProgBinding memBinding  = {0};
+  const TimeSteady  evalStart   = time_steady_clock();
+  for (u32 i = 0; i != iterations; ++i) {
+    const ScriptProgResult evalRes = script_prog_eval(&prog, &mem, &memBinding, binder, null);
+    executedOps += evalRes.executedOps;
+    panics += evalRes.panic.kind != ScriptPanic_None;
+  }
+  const TimeDuration evalDur = time_steady_duration(evalStart, time_steady_clock());
+
+  const f64 mopsPs = (f64)executedOps / (evalDur / (f64)time_second) / 1e6;
+  log_i(
+      "Script benchmark",
+      log_param("file", fmt_text(path_filename(path))),
+      log_param("compile-duration", fmt_duration(compileDur)),
+      log_param("code-size", fmt_size(prog.code.size)),
+      log_param("ops", fmt_int(executedOps)),
+      log_param("duration", fmt_duration(evalDur)),
+      log_param("mops-per-sec", fmt_float(mopsPs, .maxDecDigits = 1)),
+      log_param("panics", fmt_int(panics)));
+
+Ret:
+  script_mem_destroy(&mem);
+  script_lookup_destroy(lookup);
+  script_diag_bag_destroy(diags);
+  script_destroy(doc);
+  script_prog_destroy(&prog, g_allocHeap);
+  file_destroy(file);
+  return res;
+}
+
+static CliId g_optFiles, g_optBinder, g_optIterations;
+
+AppType app_cli_configure(CliApp* app) {
+  cli_app_register_desc(app, string_lit("Script compiler and vm throughput benchmark utility."));
+
+  g_optFiles = cli_register_arg(app, string_lit("files"), CliOptionFlags_RequiredMultiValue);
+  cli_register_desc(app, g_optFiles, string_lit("Script files to evaluate."));
+  cli_register_validator(app, g_optFiles, cli_validate_file_regular);
+
+  g_optBinder = cli_register_flag(app, 'b', string_lit("binder"), CliOptionFlags_Required);
+  cli_register_desc(app, g_optBinder, string_lit("Script binder schema to use."));
+  cli_register_validator(app, g_optBinder, cli_validate_file_regular);
+
+  g_optIterations = cli_register_flag(app, 'n', string_lit("iterations"), CliOptionFlags_Value);
+  cli_register_desc(app, g_optIterations, string_lit("Evaluations per file (default: 10000)."));
+
+  return AppType_Console;
+}
+
+i32 app_cli_run(MAYBE_UNUSED const CliApp* app, const CliInvocation* invoc) {
+  log_add_sink(g_logger, log_sink_pretty_default(g_allocHeap, g_fileStdOut, ~LogMask_Debug));
+
+  const String  binderPath = cli_read_string(invoc, g_optBinder, string_empty);
+  ScriptBinder* binder     = scriptbench_binder_read(binderPath);
+  if (!binder) {
+    return 1;
+  }
+
+  i32                  res        = 0;
+  const u64            iterations = cli_read_u64(invoc, g_optIterations, 10000);
+  const CliParseValues files      = cli_parse_values(invoc, g_optFiles);
+  for (usize i = 0; i != files.count && !res; ++i) {
+    res = scriptbench_run(binder, files.values[i], (u32)math_max(iterations, 1));
+  }
+  script_binder_destroy(binder);
+  return res;
+}
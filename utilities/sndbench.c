@@ -0,0 +1,166 @@
+#include "app/cli.h"
+#include "cli/app.h"
+#include "cli/parse.h"
+#include "cli/read.h"
+#include "core/adpcm.h"
+#include "core/alloc.h"
+#include "core/array.h"
+#include "core/file.h"
+#include "core/math.h"
+#include "core/rng.h"
+#include "core/time.h"
+#include "log/logger.h"
+#include "log/sink_pretty.h"
+
+#include "mix.h"
+
+/**
+ * SoundBenchmark - Utility to measure the sound mixer throughput.
+ *
+ * Mixes a set of voices (with varying pitch and gain) into a stereo 48 kHz buffer on a single
+ * thread and reports how many voices a single core can mix in real-time.
+ * Both the 16 bit pcm and the (decoded on the fly) adpcm sample formats are measured.
+ */
+
+#define sndbench_frame_rate 48000
+#define sndbench_period_frames 1024
+#define sndbench_source_frames 44100
+
+typedef struct {
+  String       name;
+  SndMixFormat format;
+  u8           channels;
+  f32          pitchMin, pitchMax;
+} SndBenchCase;
+
+// clang-format off
+static const SndBenchCase g_cases[] = {
+    {string_static("mono"),                 SndMixFormat_i16,   1, 1.0f, 1.0f},
+    {string_static("stereo"),               SndMixFormat_i16,   2, 1.0f, 1.0f},
+    {string_static("mono-pitched"),         SndMixFormat_i16,   1, 0.5f, 2.0f},
+    {string_static("stereo-pitched"),       SndMixFormat_i16,   2, 0.5f, 2.0f},
+    {string_static("adpcm-mono"),           SndMixFormat_Adpcm, 1, 1.0f, 1.0f},
+    {string_static("adpcm-stereo"),         SndMixFormat_Adpcm, 2, 1.0f, 1.0f},
+    {string_static("adpcm-stereo-pitched"), SndMixFormat_Adpcm, 2, 0.5f, 2.0f},
+};
+// clang-format on
+
+static Mem sndbench_source(Rng* rng, const SndMixFormat format, const u8 channels) {
+  const usize sampleCount = sndbench_source_frames * channels;
+  i16*        samples     = alloc_array_t(g_allocHeap, i16, sampleCount);
+  for (usize i = 0; i != sampleCount; ++i) {
+    samples[i] = (i16)rng_sample_range(rng, i16_min, i16_max);
+  }
+  const Mem pcm = mem_create(samples, sizeof(i16) * sampleCount);
+  if (format == SndMixFormat_i16) {
+    return pcm;
+  }
+  const usize size = adpcm_block_size(channels) * adpcm_block_count(sndbench_source_frames);
+  const Mem   res  = alloc_alloc(g_allocHeap, size, 1);
+  adpcm_encode(samples, sndbench_source_frames, channels, res);
+  alloc_free(g_allocHeap, pcm);
+  return res;
+}
+
+static void sndbench_run(const u32 voiceCount, const f32 seconds) {
+  Rng* rng = rng_create_xorwow(g_allocHeap, 42);
+
+  SndBufferFrame* frames = alloc_array_t(g_allocHeap, SndBufferFrame, sndbench_period_frames);
+  SndMixVoice*    voices = alloc_array_t(g_allocHeap, SndMixVoice, voiceCount);
+  SndMixRing*     rings  = alloc_array_t(g_allocHeap, SndMixRing, voiceCount);
+
+  const SndBuffer buffer = {
+      .frames     = frames,
+      .frameCount = sndbench_period_frames,
+      .frameRate  = sndbench_frame_rate,
+  };
+  const f32 periods     = seconds * sndbench_frame_rate / sndbench_period_frames;
+  const u32 periodCount = math_max(1, (u32)periods);
+
+  array_for_t(g_cases, SndBenchCase, c) {
+    const Mem   source   = sndbench_source(rng, c->format, c->channels);
+    const usize ringSize = snd_mix_ring_size(c->channels);
+    for (u32 i = 0; i != voiceCount; ++i) {
+      rings[i] = (SndMixRing){0};
+      if (c->format == SndMixFormat_Adpcm) {
+        rings[i].samples = alloc_alloc(g_allocHeap, ringSize, alignof(f32)).ptr;
+      }
+      const f32 pitch = rng_sample_range(rng, c->pitchMin, c->pitchMax);
+      voices[i]       = (SndMixVoice){
+          .format          = c->format,
+          .data            = source.ptr,
+          .ring            = &rings[i],
+          .frameCount      = sndbench_source_frames,
+          .frameRate       = 44100,
+          .frameChannels   = c->channels,
+          .looping         = true,
+          .cursor          = rng_sample_range(rng, 0, sndbench_source_frames),
+          .pitch           = pitch,
+          .gainLeft        = 0.0f, // Start silent to include the gain ramps.
+          .gainRight       = 0.0f,
+          .pitchTarget     = pitch,
+          .gainLeftTarget  = rng_sample_f32(rng),
+          .gainRightTarget = rng_sample_f32(rng),
+      };
+    }
+
+    const TimeSteady startTime = time_steady_clock();
+    for (u32 period = 0; period != periodCount; ++period) {
+      snd_buffer_clear(buffer);
+      for (u32 i = 0; i != voiceCount; ++i) {
+        snd_mix_render(&voices[i], buffer);
+      }
+    }
+    const TimeDuration dur = time_steady_duration(startTime, time_steady_clock());
+
+    const f64 audioSeconds  = (f64)periodCount * sndbench_period_frames / sndbench_frame_rate;
+    const f64 cpuSeconds    = dur / (f64)time_second;
+    const f64 voicesPerCore = voiceCount * audioSeconds / cpuSeconds;
+    log_i(
+        "Mixed voices",
+        log_param("case", fmt_text(c->name)),
+        log_param("voices", fmt_int(voiceCount)),
+        log_param("duration", fmt_duration(dur)),
+        log_param("voices-per-core", fmt_float(voicesPerCore, .maxDecDigits = 0)));
+
+    for (u32 i = 0; i != voiceCount; ++i) {
+      if (rings[i].samples) {
+        alloc_free(g_allocHeap, mem_create(rings[i].samples, ringSize));
+      }
+    }
+    alloc_free(g_allocHeap, source);
+  }
+
+  alloc_free_array_t(g_allocHeap, rings, voiceCount);
+  alloc_free_array_t(g_allocHeap, voices, voiceCount);
+  alloc_free_array_t(g_allocHeap, frames, sndbench_period_frames);
+  rng_destroy(rng);
+}
+
+static CliId g_optVoices, g_optSeconds;
+
+AppType app_cli_configure(CliApp* app) {
+  cli_app_register_desc(app, string_lit("Sound mixer benchmark utility."));
+
+  g_optVoices = cli_register_flag(app, 'n', string_lit("voices"), CliOptionFlags_Value);
+  cli_register_desc(app, g_optVoices, string_lit("Amount of voices to mix (default: 256)."));
+
+  g_optSeconds = cli_register_flag(app, 's', string_lit("seconds"), CliOptionFlags_Value);
+  cli_register_desc(app, g_optSeconds, string_lit("Seconds of audio to mix (default: 10)."));
+
+  return AppType_Console;
+}
+
+i32 app_cli_run(MAYBE_UNUSED const CliApp* app, const CliInvocation* invoc) {
+  log_add_sink(g_logger, log_sink_pretty_default(g_allocHeap, g_fileStdOut, ~LogMask_Debug));
+
+  const u32 voices  = math_max((u32)cli_read_u64(invoc, g_optVoices, 256), 1);
+  const f32 seconds = (f32)cli_read_f64(invoc, g_optSeconds, 10.0);
+  if (seconds <= 0.0f) {
+    log_e("Seconds has to be positive");
+    return 1;
+  }
+
+  sndbench_run(voices, seconds);
+  return 0;
+}
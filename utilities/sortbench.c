@@ -0,0 +1,147 @@
+#include "app/cli.h"
+#include "cli/app.h"
+#include "cli/parse.h"
+#include "cli/read.h"
+#include "core/alloc.h"
+#include "core/array.h"
+#include "core/file.h"
+#include "core/format.h"
+#include "core/math.h"
+#include "core/rng.h"
+#include "core/sort.h"
+#include "core/time.h"
+#include "jobs/executor.h"
+#include "jobs/init.h"
+#include "jobs/sort.h"
+#include "log/logger.h"
+#include "log/sink_pretty.h"
+#include "trace/init.h"
+
+/**
+ * SortBenchmark - Utility to measure the sorting throughput.
+ *
+ * Sorts random 32 bit keys (with a 32 bit payload) using the different sorting algorithms and
+ * reports the throughput in millions of elements per second:
+ * - 'quicksort':      Comparison based (unstable) sort (sort_quicksort).
+ * - 'mergesort':      Comparison based stable sort (sort_mergesort).
+ * - 'radix':          Least-significant-digit radix sort (sort_radix_u32).
+ * - 'radix-parallel': Radix sort split over the job workers (jobs_sort_radix_u32).
+ */
+
+typedef struct {
+  u32 key;
+  u32 payload;
+} SortBenchElem;
+
+typedef enum {
+  SortBenchKind_Quicksort,
+  SortBenchKind_Mergesort,
+  SortBenchKind_Radix,
+  SortBenchKind_RadixParallel,
+} SortBenchKind;
+
+typedef struct {
+  String        name;
+  SortBenchKind kind;
+} SortBenchCase;
+
+static const SortBenchCase g_cases[] = {
+    {.name = string_static("quicksort"), .kind = SortBenchKind_Quicksort},
+    {.name = string_static("mergesort"), .kind = SortBenchKind_Mergesort},
+    {.name = string_static("radix"), .kind = SortBenchKind_Radix},
+    {.name = string_static("radix-parallel"), .kind = SortBenchKind_RadixParallel},
+};
+
+static const u32 g_counts[] = {1000, 10000, 100000, 1000000};
+
+static i8 sortbench_compare(const void* a, const void* b) {
+  return compare_u32(field_ptr(a, SortBenchElem, key), field_ptr(b, SortBenchElem, key));
+}
+
+static void sortbench_sort(
+    const SortBenchKind kind, SortBenchElem* begin, SortBenchElem* end, const Mem scratch) {
+  switch (kind) {
+  case SortBenchKind_Quicksort:
+    sort_quicksort_t(begin, end, SortBenchElem, sortbench_compare);
+    return;
+  case SortBenchKind_Mergesort:
+    sort_mergesort_t(begin, end, SortBenchElem, sortbench_compare, scratch);
+    return;
+  case SortBenchKind_Radix:
+    sort_radix_u32_t(begin, end, SortBenchElem, key, SortRadixFlags_None, scratch);
+    return;
+  case SortBenchKind_RadixParallel:
+    jobs_sort_radix_u32_t(begin, end, SortBenchElem, key, SortRadixFlags_None, scratch);
+    return;
+  }
+  UNREACHABLE
+}
+
+static void sortbench_run(const u32 count, const u64 elemsPerCase) {
+  const usize    size    = sizeof(SortBenchElem) * count;
+  SortBenchElem* input   = alloc_array_t(g_allocHeap, SortBenchElem, count);
+  SortBenchElem* elems   = alloc_array_t(g_allocHeap, SortBenchElem, count);
+  const Mem      scratch = alloc_alloc(g_allocHeap, size, alignof(SortBenchElem));
+
+  Rng* rng = rng_create_xorwow(g_allocHeap, 42);
+  for (u32 i = 0; i != count; ++i) {
+    input[i] = (SortBenchElem){.key = rng_sample_u32(rng), .payload = i};
+  }
+  rng_destroy(rng);
+
+  const u32 iterations = (u32)math_max(elemsPerCase / count, 1);
+  array_for_t(g_cases, SortBenchCase, c) {
+    TimeDuration dur = 0;
+    for (u32 i = 0; i != iterations; ++i) {
+      mem_cpy(mem_create(elems, size), mem_create(input, size));
+
+      const TimeSteady startTime = time_steady_clock();
+      sortbench_sort(c->kind, elems, elems + count, scratch);
+      dur += time_steady_duration(startTime, time_steady_clock());
+    }
+
+    const f64 megaElems = (f64)count * iterations / 1e6;
+    log_i(
+        "Sort benchmark",
+        log_param("case", fmt_text(c->name)),
+        log_param("workers", fmt_int(g_jobsWorkerCount)),
+        log_param("count", fmt_int(count)),
+        log_param("duration", fmt_duration(dur / iterations)),
+        log_param("melem-per-sec", fmt_float(megaElems / (dur / (f64)time_second))));
+  }
+
+  alloc_free(g_allocHeap, scratch);
+  alloc_free_array_t(g_allocHeap, elems, count);
+  alloc_free_array_t(g_allocHeap, input, count);
+}
+
+static CliId g_optWorkers, g_optElems;
+
+AppType app_cli_configure(CliApp* app) {
+  cli_app_register_desc(app, string_lit("Sorting throughput benchmark utility."));
+
+  g_optWorkers = cli_register_flag(app, 'w', string_lit("workers"), CliOptionFlags_Value);
+  cli_register_desc(app, g_optWorkers, string_lit("Amount of job workers (default: cores)."));
+
+  g_optElems = cli_register_flag(app, 'e', string_lit("elements"), CliOptionFlags_Value);
+  cli_register_desc(
+      app, g_optElems, string_lit("Elements to sort per case per count (default: 10000000)."));
+
+  return AppType_Console;
+}
+
+i32 app_cli_run(MAYBE_UNUSED const CliApp* app, const CliInvocation* invoc) {
+  log_add_sink(g_logger, log_sink_pretty_default(g_allocHeap, g_fileStdOut, ~LogMask_Debug));
+
+  const u16 workers      = (u16)cli_read_u64(invoc, g_optWorkers, 0);
+  const u64 elemsPerCase = cli_read_u64(invoc, g_optElems, 10000000);
+
+  trace_init();
+  jobs_init(&(JobsConfig){.workerCount = workers});
+
+  array_for_t(g_counts, u32, count) { sortbench_run(*count, elemsPerCase); }
+
+  jobs_teardown();
+  trace_teardown();
+  return 0;
+}
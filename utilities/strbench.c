@@ -0,0 +1,192 @@
+#include "app/cli.h"
+#include "cli/app.h"
+#include "cli/parse.h"
+#include "cli/read.h"
+#include "core/alloc.h"
+#include "core/array.h"
+#include "core/file.h"
+#include "core/format.h"
+#include "core/math.h"
+#include "core/stringtable.h"
+#include "core/thread.h"
+#include "core/time.h"
+#include "log/logger.h"
+#include "log/sink_pretty.h"
+
+/**
+ * StringBenchmark - Utility to measure the StringTable throughput under contention.
+ *
+ * Runs lookups and interns from multiple threads at the same time and reports the throughput in
+ * mega-operations per second. The 'lookup-locked' case wraps every lookup in a single spinlock to
+ * show the cost of contention on a lock that every lookup has to take.
+ */
+
+#define strbench_threads_max 64
+
+typedef enum {
+  StrBenchKind_Lookup,
+  StrBenchKind_LookupLocked,
+  StrBenchKind_Intern,
+  StrBenchKind_InternNew,
+} StrBenchKind;
+
+typedef struct {
+  String       name;
+  StrBenchKind kind;
+} StrBenchCase;
+
+static const StrBenchCase g_cases[] = {
+    {.name = string_static("lookup"), .kind = StrBenchKind_Lookup},
+    {.name = string_static("lookup-locked"), .kind = StrBenchKind_LookupLocked},
+    {.name = string_static("intern"), .kind = StrBenchKind_Intern},
+    {.name = string_static("intern-new"), .kind = StrBenchKind_InternNew},
+};
+
+typedef struct {
+  StrBenchKind    kind;
+  StringTable*    table;
+  ThreadSpinLock* lock;
+  const String*   strings; // Strings that are already in the table.
+  const String*   newStrings;
+  u32             stringCount, ops, seed;
+  u64             checksum; // Prevents the lookups from being optimized out.
+} StrBenchWorker;
+
+static void strbench_worker(void* data) {
+  StrBenchWorker* w     = data;
+  u32             index = w->seed;
+  for (u32 i = 0; i != w->ops; ++i) {
+    index = (index * 1103515245u + 12345u) % w->stringCount;
+    switch (w->kind) {
+    case StrBenchKind_Lookup:
+      w->checksum += stringtable_lookup(w->table, string_hash(w->strings[index])).size;
+      break;
+    case StrBenchKind_LookupLocked:
+      thread_spinlock_lock(w->lock);
+      w->checksum += stringtable_lookup(w->table, string_hash(w->strings[index])).size;
+      thread_spinlock_unlock(w->lock);
+      break;
+    case StrBenchKind_Intern:
+      w->checksum += stringtable_intern(w->table, w->strings[index]).size;
+      break;
+    case StrBenchKind_InternNew:
+      w->checksum += stringtable_intern(w->table, w->newStrings[i]).size;
+      break;
+    }
+  }
+}
+
+static String* strbench_strings(const u32 count, const String prefix) {
+  String* res = alloc_array_t(g_allocHeap, String, count);
+  for (u32 i = 0; i != count; ++i) {
+    res[i] = string_dup(g_allocHeap, fmt_write_scratch("{}_{}", fmt_text(prefix), fmt_int(i)));
+  }
+  return res;
+}
+
+static void strbench_strings_free(String* strings, const u32 count) {
+  for (u32 i = 0; i != count; ++i) {
+    string_free(g_allocHeap, strings[i]);
+  }
+  alloc_free_array_t(g_allocHeap, strings, count);
+}
+
+static void strbench_run(const u32 threadCount, const u32 stringCount, const u32 ops) {
+  String* strings = strbench_strings(stringCount, string_lit("benchmark/asset/string"));
+  String* newStrings[strbench_threads_max];
+  for (u32 t = 0; t != threadCount; ++t) {
+    const String prefix = string_dup(g_allocHeap, fmt_write_scratch("thread{}", fmt_int(t)));
+    newStrings[t]       = strbench_strings(stringCount, prefix);
+    string_free(g_allocHeap, prefix);
+  }
+
+  array_for_t(g_cases, StrBenchCase, c) {
+    StringTable*   table = stringtable_create(g_allocHeap);
+    ThreadSpinLock lock  = 0;
+    for (u32 i = 0; i != stringCount; ++i) {
+      stringtable_add(table, strings[i]);
+    }
+
+    // NOTE: Every new string can only be inserted once, so the amount of operations is limited.
+    const u32 workerOps = c->kind == StrBenchKind_InternNew ? stringCount : ops;
+
+    StrBenchWorker workers[strbench_threads_max];
+    ThreadHandle   threads[strbench_threads_max];
+
+    const TimeSteady startTime = time_steady_clock();
+    for (u32 t = 0; t != threadCount; ++t) {
+      workers[t] = (StrBenchWorker){
+          .kind        = c->kind,
+          .table       = table,
+          .lock        = &lock,
+          .strings     = strings,
+          .newStrings  = newStrings[t],
+          .stringCount = stringCount,
+          .ops         = workerOps,
+          .seed        = t * 7919,
+      };
+      const String threadName = fmt_write_scratch("strbench_{}", fmt_int(t));
+      threads[t] = thread_start(strbench_worker, &workers[t], threadName, ThreadPriority_Normal);
+    }
+    u64 checksum = 0;
+    for (u32 t = 0; t != threadCount; ++t) {
+      thread_join(threads[t]);
+      checksum += workers[t].checksum;
+    }
+    const TimeDuration dur = time_steady_duration(startTime, time_steady_clock());
+
+    const f64 totalOps = (f64)workerOps * threadCount;
+    const f64 mops     = totalOps / (dur / (f64)time_second) / 1e6;
+    log_i(
+        "StringTable benchmark",
+        log_param("case", fmt_text(c->name)),
+        log_param("threads", fmt_int(threadCount)),
+        log_param("operations", fmt_int((u64)totalOps)),
+        log_param("duration", fmt_duration(dur)),
+        log_param("mops", fmt_float(mops, .maxDecDigits = 2)),
+        log_param("checksum", fmt_int(checksum)));
+
+    stringtable_destroy(table);
+  }
+
+  for (u32 t = 0; t != threadCount; ++t) {
+    strbench_strings_free(newStrings[t], stringCount);
+  }
+  strbench_strings_free(strings, stringCount);
+}
+
+static CliId g_optThreads, g_optStrings, g_optOps;
+
+AppType app_cli_configure(CliApp* app) {
+  cli_app_register_desc(app, string_lit("StringTable contention benchmark utility."));
+
+  g_optThreads = cli_register_flag(app, 't', string_lit("threads"), CliOptionFlags_Value);
+  cli_register_desc(app, g_optThreads, string_lit("Amount of threads (default: core count)."));
+
+  g_optStrings = cli_register_flag(app, 's', string_lit("strings"), CliOptionFlags_Value);
+  cli_register_desc(app, g_optStrings, string_lit("Amount of strings (default: 4096)."));
+
+  g_optOps = cli_register_flag(app, 'n', string_lit("ops"), CliOptionFlags_Value);
+  cli_register_desc(app, g_optOps, string_lit("Operations per thread (default: 1000000)."));
+
+  return AppType_Console;
+}
+
+i32 app_cli_run(MAYBE_UNUSED const CliApp* app, const CliInvocation* invoc) {
+  log_add_sink(g_logger, log_sink_pretty_default(g_allocHeap, g_fileStdOut, ~LogMask_Debug));
+
+  const u64 threads = cli_read_u64(invoc, g_optThreads, g_threadCoreCount);
+  const u64 strings = cli_read_u64(invoc, g_optStrings, 4096);
+  const u64 ops     = cli_read_u64(invoc, g_optOps, 1000000);
+  if (!threads || threads > strbench_threads_max) {
+    log_e("Invalid thread count", log_param("max", fmt_int(strbench_threads_max)));
+    return 1;
+  }
+  if (!strings || strings > u16_max) {
+    log_e("Invalid string count", log_param("max", fmt_int(u16_max)));
+    return 1;
+  }
+
+  strbench_run((u32)threads, (u32)strings, (u32)math_max(ops, 1));
+  return 0;
+}
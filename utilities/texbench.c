@@ -0,0 +1,148 @@
+#include "app/cli.h"
+#include "cli/app.h"
+#include "cli/parse.h"
+#include "cli/read.h"
+#include "core/alloc.h"
+#include "core/array.h"
+#include "core/bits.h"
+#include "core/file.h"
+#include "core/format.h"
+#include "core/math.h"
+#include "core/path.h"
+#include "core/process.h"
+#include "core/rng.h"
+#include "core/thread.h"
+#include "core/time.h"
+#include "jobs/executor.h"
+#include "jobs/init.h"
+#include "log/logger.h"
+#include "log/sink_pretty.h"
+#include "trace/init.h"
+
+#include "loader_texture.h"
+
+/**
+ * TextureBenchmark - Utility to measure the texture block-compression throughput.
+ *
+ * Compresses (and generates mips for) a noise texture to Bc1, Bc3, Bc4, Bc5 and Bc7 and reports
+ * the throughput in mega-pixels per second. When no worker count is given the benchmark is
+ * repeated (in a child process) for every worker count from 1 up to the amount of cores.
+ */
+
+typedef struct {
+  String            name;
+  u32               channels;
+  AssetTextureFlags flags;
+} TexBenchCase;
+
+static const TexBenchCase g_cases[] = {
+    {.name = string_static("bc1"), .channels = 3, .flags = AssetTextureFlags_GenerateMips},
+    {.name = string_static("bc3"), .channels = 4, .flags = AssetTextureFlags_GenerateMips},
+    {.name = string_static("bc4"), .channels = 1, .flags = AssetTextureFlags_GenerateMips},
+    {.name = string_static("bc5"), .channels = 2, .flags = AssetTextureFlags_GenerateMips},
+    {
+        .name     = string_static("bc7"),
+        .channels = 4,
+        .flags    = AssetTextureFlags_GenerateMips | AssetTextureFlags_HighQuality,
+    },
+};
+
+static Mem texbench_noise(const u32 size, const u32 channels) {
+  const Mem mem = alloc_alloc(g_allocHeap, size * size * channels, 1);
+  Rng*      rng = rng_create_xorwow(g_allocHeap, 42);
+  for (usize i = 0; i != mem.size; ++i) {
+    ((u8*)mem.ptr)[i] = (u8)rng_sample_range(rng, 0, 256);
+  }
+  rng_destroy(rng);
+  return mem;
+}
+
+static void texbench_run(const u32 size, const u32 iterations) {
+  array_for_t(g_cases, TexBenchCase, c) {
+    const Mem pixels = texbench_noise(size, c->channels);
+
+    const TimeSteady startTime = time_steady_clock();
+    for (u32 i = 0; i != iterations; ++i) {
+      AssetTextureComp tex = asset_texture_create(
+          pixels, size, size, c->channels, 1, 1, 0, AssetTextureType_u8, c->flags);
+      alloc_free(g_allocHeap, asset_texture_data(&tex));
+    }
+    const TimeDuration dur = time_steady_duration(startTime, time_steady_clock());
+
+    const f64 megaPixels = (f64)size * size * iterations / 1e6;
+    log_i(
+        "Compressed texture",
+        log_param("format", fmt_text(c->name)),
+        log_param("workers", fmt_int(g_jobsWorkerCount)),
+        log_param("size", fmt_int(size)),
+        log_param("duration", fmt_duration(dur / iterations)),
+        log_param("mp-per-sec", fmt_float(megaPixels / (dur / (f64)time_second))));
+
+    alloc_free(g_allocHeap, pixels);
+  }
+}
+
+static i32 texbench_sweep(const u32 size, const u32 iterations) {
+  const u16 workersMax = math_max(g_threadCoreCount, 1);
+  for (u16 workers = 1; workers <= workersMax; ++workers) {
+    const String args[] = {
+        string_lit("--workers"),
+        fmt_write_scratch("{}", fmt_int(workers)),
+        string_lit("--size"),
+        fmt_write_scratch("{}", fmt_int(size)),
+        string_lit("--iterations"),
+        fmt_write_scratch("{}", fmt_int(iterations)),
+    };
+    Process* child = process_create(
+        g_allocHeap, g_pathExecutable, args, array_elems(args), ProcessFlags_None);
+    const ProcessExitCode exitCode = process_block(child);
+    process_destroy(child);
+    if (exitCode != 0) {
+      log_e("Benchmark failed", log_param("workers", fmt_int(workers)));
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static CliId g_optWorkers, g_optSize, g_optIterations;
+
+AppType app_cli_configure(CliApp* app) {
+  cli_app_register_desc(app, string_lit("Texture block-compression benchmark utility."));
+
+  g_optWorkers = cli_register_flag(app, 'w', string_lit("workers"), CliOptionFlags_Value);
+  cli_register_desc(app, g_optWorkers, string_lit("Amount of job workers (default: sweep)."));
+
+  g_optSize = cli_register_flag(app, 's', string_lit("size"), CliOptionFlags_Value);
+  cli_register_desc(app, g_optSize, string_lit("Texture size in pixels (default: 2048)."));
+
+  g_optIterations = cli_register_flag(app, 'i', string_lit("iterations"), CliOptionFlags_Value);
+  cli_register_desc(app, g_optIterations, string_lit("Iterations per format (default: 4)."));
+
+  return AppType_Console;
+}
+
+i32 app_cli_run(MAYBE_UNUSED const CliApp* app, const CliInvocation* invoc) {
+  log_add_sink(g_logger, log_sink_pretty_default(g_allocHeap, g_fileStdOut, ~LogMask_Debug));
+
+  const u32 size       = (u32)cli_read_u64(invoc, g_optSize, 2048);
+  const u32 iterations = math_max((u32)cli_read_u64(invoc, g_optIterations, 4), 1);
+  if (!bits_ispow2(size) || size < 4) {
+    log_e("Texture size has to be a power-of-two of at least 4");
+    return 1;
+  }
+
+  const u16 workers = (u16)cli_read_u64(invoc, g_optWorkers, 0);
+  if (!workers) {
+    return texbench_sweep(size, iterations);
+  }
+
+  trace_init();
+  jobs_init(&(JobsConfig){.workerCount = workers});
+
+  texbench_run(size, iterations);
+
+  jobs_teardown();
+  trace_teardown();
+  return 0;
+}